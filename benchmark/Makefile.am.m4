@@ -97,12 +97,26 @@ DEFS = \
 
 noinst_LTLIBRARIES = libbenchmark.la
 noinst_PROGRAMS = benchmarklist
+BENCHMARKS = benchmarklist
+
+if HDF5
+  noinst_PROGRAMS += grid_checkpoint_BENCHMARK
+  BENCHMARKS += grid_checkpoint_BENCHMARK
+  grid_checkpoint_BENCHMARK_SOURCES = grid_checkpoint_BENCHMARK.cc
+  grid_checkpoint_BENCHMARK_LDADD = \
+	libbenchmark.la \
+	$(top_builddir)/honei/la/libhoneila.la \
+	$(top_builddir)/honei/swe/libhoneiswe.la \
+	$(top_builddir)/honei/lbm/libhoneilbm.la \
+	$(top_builddir)/honei/util/libhoneiutil.la \
+	$(BACKEND_LIBS) \
+	$(DYNAMIC_LD_LIBS)
+  grid_checkpoint_BENCHMARK_CXXFLAGS = -I$(top_srcdir) $(AM_CXXFLAGS)
+endif
 
 libbenchmark_la_SOURCES = \
 	benchmark.cc benchmark.hh
 
-BENCHMARKS = benchmarklist
-
 .PHONY: benchmark
 benchmark: $(BENCHMARKS)
 	@failed=0; \
@@ -28,6 +28,7 @@ add(`grid_packer',                               `bench')
 add(`grid_partitioner',                          `bench')
 add(`ir',                                        `bench')
 add(`jacobi',                                    `bench')
+add(`ludecomposition',                           `bench')
 add(`matrix_io',                                 `bench')
 add(`memory_arbiter',                            `bench')
 add(`mg',                                        `bench')
@@ -68,8 +69,10 @@ add(`poisson_pcg_double_dense',                  `bench')
 add(`poisson_pcg_float_banded',                  `bench')
 add(`poisson_pcg_fixed_ell',                     `bench')
 add(`position',                                  `bench')
+add(`preconditioner_setup',                      `bench')
 add(`product',                                   `bench')
 add(`product_ell_file',                          `bench')
+add(`product_ell_mixed',                         `bench')
 add(`product_ellt',                              `bench')
 add(`reduction',                                 `bench')
 add(`relax_solver',                              `bench')
@@ -0,0 +1,163 @@
+/* vim: set number sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the HONEI C++ library. HONEI is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * HONEI is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ALLBENCH
+#include <benchmark/benchmark.cc>
+
+#include <string>
+#endif
+
+#include <honei/lbm/solver_lbm_grid.hh>
+#include <honei/lbm/grid_checkpoint.hh>
+#include <honei/lbm/grid.hh>
+#include <honei/lbm/grid_packer.hh>
+#include <honei/swe/volume.hh>
+#include <cstdio>
+#include <iostream>
+
+using namespace std;
+using namespace honei;
+
+namespace
+{
+    namespace checkpoint_modes
+    {
+        /// No checkpoints at all, the reference.
+        struct NONE;
+
+        /// Checkpoints are written by the solver thread itself.
+        struct SYNCHRONOUS;
+
+        /// Checkpoints are written by an HDF5CheckpointWriter.
+        struct ASYNCHRONOUS;
+    }
+}
+
+template <typename Tag_, typename DataType_, typename Mode_>
+class LBMGCheckpointBench :
+    public Benchmark
+{
+    private:
+        unsigned long _size;
+        unsigned long _interval;
+        int _count;
+
+        template <typename Solver_>
+        void _solve(Solver_ & solver, PackedGridInfo<D2Q9> & info, PackedGridData<D2Q9, DataType_> & data,
+                HDF5CheckpointWriter &, HDF5Checkpoint &, checkpoint_modes::NONE *)
+        {
+            for (unsigned long j(0) ; j < 100 ; ++j)
+            {
+                solver.solve();
+            }
+        }
+
+        template <typename Solver_>
+        void _solve(Solver_ & solver, PackedGridInfo<D2Q9> & info, PackedGridData<D2Q9, DataType_> & data,
+                HDF5CheckpointWriter &, HDF5Checkpoint & checkpoint, checkpoint_modes::SYNCHRONOUS *)
+        {
+            for (unsigned long j(0) ; j < 100 ; ++j)
+            {
+                solver.solve();
+                if ((j + 1) % _interval == 0)
+                {
+                    GridCheckpoint<D2Q9, DataType_>::save(checkpoint, info, data, solver.time());
+                    checkpoint.write("grid_checkpoint_BENCHMARK.h5");
+                }
+            }
+        }
+
+        template <typename Solver_>
+        void _solve(Solver_ & solver, PackedGridInfo<D2Q9> & info, PackedGridData<D2Q9, DataType_> & data,
+                HDF5CheckpointWriter & writer, HDF5Checkpoint &, checkpoint_modes::ASYNCHRONOUS *)
+        {
+            for (unsigned long j(0) ; j < 100 ; ++j)
+            {
+                solver.solve();
+                if ((j + 1) % _interval == 0)
+                {
+                    GridCheckpoint<D2Q9, DataType_>::save(writer.acquire(), info, data, solver.time());
+                    writer.commit("grid_checkpoint_BENCHMARK.h5");
+                }
+            }
+            writer.wait();
+        }
+
+    public:
+        LBMGCheckpointBench(const std::string & id, unsigned long size, unsigned long interval, int count) :
+            Benchmark(id)
+        {
+            register_tag(Tag_::name);
+            _size = size;
+            _interval = interval;
+            _count = count;
+        }
+
+        virtual void run()
+        {
+            unsigned long g_h(_size);
+            unsigned long g_w(_size);
+
+            DenseMatrix<DataType_> h(g_h, g_w, DataType_(0.05));
+            Cylinder<DataType_> c1(h, DataType_(0.02), 25, 25);
+            c1.value();
+
+            Grid<D2Q9, DataType_> grid;
+            grid.obstacles = new DenseMatrix<bool>(g_h, g_w, false);
+            grid.h = new DenseMatrix<DataType_>(h);
+            grid.u = new DenseMatrix<DataType_>(g_h, g_w, DataType_(0.));
+            grid.v = new DenseMatrix<DataType_>(g_h, g_w, DataType_(0.));
+            grid.b = new DenseMatrix<DataType_>(g_h, g_w, DataType_(0.));
+            PackedGridData<D2Q9, DataType_>  data;
+            PackedGridInfo<D2Q9> info;
+
+            GridPacker<D2Q9, NOSLIP, DataType_>::pack(grid, info, data);
+
+            SolverLBMGrid<Tag_, lbm_applications::LABSWE, DataType_, lbm_force::NONE, lbm_source_schemes::NONE, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, lbm_modes::DRY> solver(&info, &data, 0.01, 0.01, 0.01, 1.1);
+
+            solver.do_preprocessing();
+
+            HDF5CheckpointWriter writer;
+            HDF5Checkpoint checkpoint;
+            for(int i = 0; i < _count; ++i)
+            {
+                BENCHMARK(
+                        _solve(solver, info, data, writer, checkpoint, static_cast<Mode_ *>(0));
+                        );
+            }
+            LBMBenchmarkInfo benchinfo(SolverLBMGrid<tags::CPU, lbm_applications::LABSWE, DataType_, lbm_force::NONE, lbm_source_schemes::NONE, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, lbm_modes::DRY>::get_benchmark_info(&grid, &info, &data));
+            evaluate(benchinfo * 100);
+
+            std::remove("grid_checkpoint_BENCHMARK.h5");
+            data.destroy();
+            info.destroy();
+            grid.destroy();
+        }
+};
+
+LBMGCheckpointBench<tags::CPU, float, checkpoint_modes::NONE> checkpoint_bench_float_none("LBM Grid checkpoint Benchmark - size: 500, no checkpoints, float", 500, 25, 5);
+LBMGCheckpointBench<tags::CPU, float, checkpoint_modes::SYNCHRONOUS> checkpoint_bench_float_sync("LBM Grid checkpoint Benchmark - size: 500, synchronous checkpoint every 25 steps, float", 500, 25, 5);
+LBMGCheckpointBench<tags::CPU, float, checkpoint_modes::ASYNCHRONOUS> checkpoint_bench_float_async("LBM Grid checkpoint Benchmark - size: 500, asynchronous checkpoint every 25 steps, float", 500, 25, 5);
+#ifdef HONEI_SSE
+LBMGCheckpointBench<tags::CPU::SSE, float, checkpoint_modes::NONE> sse_checkpoint_bench_float_none("SSE LBM Grid checkpoint Benchmark - size: 500, no checkpoints, float", 500, 25, 5);
+LBMGCheckpointBench<tags::CPU::SSE, float, checkpoint_modes::SYNCHRONOUS> sse_checkpoint_bench_float_sync("SSE LBM Grid checkpoint Benchmark - size: 500, synchronous checkpoint every 25 steps, float", 500, 25, 5);
+LBMGCheckpointBench<tags::CPU::SSE, float, checkpoint_modes::ASYNCHRONOUS> sse_checkpoint_bench_float_async("SSE LBM Grid checkpoint Benchmark - size: 500, asynchronous checkpoint every 25 steps, float", 500, 25, 5);
+LBMGCheckpointBench<tags::CPU::SSE, double, checkpoint_modes::NONE> sse_checkpoint_bench_double_none("SSE LBM Grid checkpoint Benchmark - size: 500, no checkpoints, double", 500, 25, 5);
+LBMGCheckpointBench<tags::CPU::SSE, double, checkpoint_modes::ASYNCHRONOUS> sse_checkpoint_bench_double_async("SSE LBM Grid checkpoint Benchmark - size: 500, asynchronous checkpoint every 25 steps, double", 500, 25, 5);
+#endif
@@ -0,0 +1,70 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#ifndef ALLBENCH
+#include <benchmark/benchmark.cc>
+
+#include <string>
+#endif
+
+#include <honei/math/ludecomposition.hh>
+#include <iostream>
+//using namespace std;
+using namespace honei;
+
+template <typename Tag_, typename DataType_>
+class DenseLUBench :
+    public Benchmark
+{
+    private:
+        unsigned long _size;
+        unsigned long _rhs;
+        unsigned long _count;
+    public:
+        DenseLUBench(const std::string & id, unsigned long size, unsigned long rhs, unsigned long count) :
+            Benchmark(id)
+        {
+            register_tag(Tag_::name);
+            _size = size;
+            _rhs = rhs;
+            _count = count;
+        }
+
+        virtual void run()
+        {
+            DenseMatrix<DataType_> a(_size, _size);
+            for (unsigned long i(0) ; i < _size ; ++i)
+                for (unsigned long j(0) ; j < _size ; ++j)
+                    a(i, j) = DataType_((i * 7 + j * 13) % 23) / DataType_(23) + (i == j ? DataType_(_size) : DataType_(0));
+            DenseMatrix<DataType_> b(_size, _rhs, DataType_(1));
+            DenseMatrix<DataType_> x(_size, _rhs);
+            DenseVector<unsigned long> pivots(_size);
+
+            for (unsigned long i(0) ; i < _count ; ++i)
+            {
+                DenseMatrix<DataType_> lu(a.copy());
+                BENCHMARK(LUDecomposition<Tag_>::factor(lu, pivots));
+            }
+            BenchmarkInfo info;
+            info.flops = 2 * _size * _size * _size / 3;
+            info.load = _size * _size * sizeof(DataType_);
+            info.store = _size * _size * sizeof(DataType_);
+            evaluate(info);
+
+            _benchlist.clear();
+            DenseMatrix<DataType_> lu(a.copy());
+            LUDecomposition<Tag_>::factor(lu, pivots);
+            for (unsigned long i(0) ; i < _count ; ++i)
+            {
+                BENCHMARK(LUDecomposition<Tag_>::solve(lu, pivots, b, x));
+            }
+            std::cout << "Solve for " << _rhs << " right hand sides:" << std::endl;
+            evaluate();
+        }
+};
+DenseLUBench<tags::CPU, double> LUBenchDouble("LU Benchmark dense - matrix size: 1024x1024, 16 rhs, double", 1024, 16, 5);
+DenseLUBench<tags::CPU::MultiCore, double> MCLUBenchDouble("MC LU Benchmark dense - matrix size: 1024x1024, 16 rhs, double", 1024, 16, 5);
+#ifdef HONEI_SSE
+DenseLUBench<tags::CPU::SSE, float> SSELUBenchFloat("SSE LU Benchmark dense - matrix size: 1024x1024, 16 rhs, float", 1024, 16, 5);
+DenseLUBench<tags::CPU::SSE, double> SSELUBenchDouble("SSE LU Benchmark dense - matrix size: 1024x1024, 16 rhs, double", 1024, 16, 5);
+DenseLUBench<tags::CPU::MultiCore::SSE, double> MCSSELUBenchDouble("MC SSE LU Benchmark dense - matrix size: 1024x1024, 16 rhs, double", 1024, 16, 5);
+#endif
@@ -19,7 +19,9 @@
 
 //#define SOLVER_VERBOSE 1
 #include <honei/math/mg.hh>
+#include <honei/math/amg.hh>
 #include <honei/math/bicgstab.hh>
+#include <honei/math/superlu.hh>
 #include <honei/math/methods.hh>
 #include <honei/math/restriction.hh>
 #include <honei/math/prolongation.hh>
@@ -146,6 +148,186 @@ class MGBench:
         }
 };
 
+
+/// SuperLU coarse grid solver which factorises the coarse grid matrix anew in every cycle.
+struct SuperLUUncached
+{
+    template<typename DT_, typename MatrixType_, typename VectorType_, typename PreconContType_>
+    static inline VectorType_ & value(MatrixType_ & A,
+                PreconContType_ & /*P*/,
+                VectorType_ & b,
+                VectorType_ & x,
+                unsigned long /*max_iters*/,
+                unsigned long & used_iters,
+                DT_ /*eps_relative*/)
+    {
+        SparseMatrixELL<DT_> in_matrix(A);
+        SuperLU::value(in_matrix, b, x);
+        used_iters = 1;
+        return x;
+    }
+};
+
+template <typename Tag_, typename CoarseGridSolverType_>
+class MGSuperLUCoarseBench:
+    public Benchmark
+{
+    private:
+        unsigned long _sorting;
+        unsigned long _levels;
+        unsigned long _min_level;
+
+    public:
+        MGSuperLUCoarseBench(const std::string & tag, unsigned long s, unsigned long l, unsigned long min_level) :
+            Benchmark(tag)
+        {
+            register_tag(Tag_::name);
+            _sorting = s;
+            _levels = l;
+            _min_level = min_level;
+        }
+
+        virtual void run()
+        {
+            std::string file(HONEI_SOURCEDIR);
+            file += "/honei/math/testdata/poisson_advanced2/sort_";
+            file += stringify(_sorting);
+            file += "/";
+
+            MGData<SparseMatrixELL<double>, DenseVector<double>, SparseMatrixELL<double>, DenseVector<double>, double >  data(MGUtil<Tag_,
+                    SparseMatrixELL<double>,
+                    DenseVector<double>,
+                    SparseMatrixELL<double>,
+                    DenseVector<double>,
+                    MatrixIO<io_formats::ELL>,
+                    VectorIO<io_formats::EXP>,
+                    double>::load_data(file, _levels, 0.7, "jac"));
+            MGUtil<Tag_,
+                SparseMatrixELL<double>,
+                DenseVector<double>,
+                SparseMatrixELL<double>,
+                DenseVector<double>,
+                MatrixIO<io_formats::ELL>,
+                VectorIO<io_formats::EXP>,
+                double>::configure(data, 100, 10, 4, 4, _min_level, double(1e-8));
+
+            OperatorList ol(
+                    MGCycleCreation<Tag_,
+                    methods::CYCLE::V::STATIC,
+                    CoarseGridSolverType_,
+                    RISmoother<Tag_>,
+                    Restriction<Tag_, methods::PROLMAT>,
+                    Prolongation<Tag_, methods::PROLMAT>,
+                    double>::value(data)
+                    );
+
+            unsigned long cycles(0);
+            BENCHMARK(
+                    (MGSolver<Tag_, Norm<vnt_l_two, true, Tag_> >::value(data, ol));
+                    cycles += data.used_iters;
+                    );
+
+            evaluate();
+
+            double total(0);
+            for (std::list<double>::iterator i(_benchlist.begin()) ; i != _benchlist.end() ; ++i)
+                total += *i;
+            std::cout << data.used_iters << " iterations used, " << total / cycles << " sec per cycle." << std::endl;
+        }
+};
+
+template <typename Tag_>
+class AMGBench:
+    public Benchmark
+{
+    private:
+        unsigned long _sorting;
+        unsigned long _levels;
+        unsigned long _coarse_size;
+
+    public:
+        AMGBench(const std::string & tag, unsigned long s, unsigned long l, unsigned long coarse_size) :
+            Benchmark(tag)
+        {
+            register_tag(Tag_::name);
+            _sorting = s;
+            _levels = l;
+            _coarse_size = coarse_size;
+        }
+
+        virtual void run()
+        {
+            std::string file(HONEI_SOURCEDIR);
+            file += "/honei/math/testdata/poisson_advanced2/sort_";
+            file += stringify(_sorting);
+            file += "/";
+
+            SparseMatrixELL<double> A(MatrixIO<io_formats::ELL>::read_matrix(file + "A_" + stringify(_levels) + ".ell", double(0)));
+            DenseVector<double> b(VectorIO<io_formats::EXP>::read_vector(file + "rhs_" + stringify(_levels), double(0)));
+            DenseVector<double> x(VectorIO<io_formats::EXP>::read_vector(file + "init_" + stringify(_levels), double(0)));
+
+            // setup: aggregation, prolongations, Galerkin products and smoother preconditioners
+            for (unsigned long i(0) ; i < 5 ; ++i)
+            {
+                BENCHMARK(
+                        (AMGUtil<Tag_,
+                         SparseMatrixELL<double>,
+                         DenseVector<double>,
+                         SparseMatrixELL<double>,
+                         DenseVector<double>,
+                         double>::value(A, b, x, 20, _coarse_size, 0.7, "jac"));
+                        );
+            }
+            std::cout << "Setup:" << std::endl;
+            evaluate();
+            _benchlist.clear();
+
+            MGData<SparseMatrixELL<double>, DenseVector<double>, SparseMatrixELL<double>, DenseVector<double>, double> data(AMGUtil<Tag_,
+                    SparseMatrixELL<double>,
+                    DenseVector<double>,
+                    SparseMatrixELL<double>,
+                    DenseVector<double>,
+                    double>::value(A, b, x, 20, _coarse_size, 0.7, "jac"));
+            MGUtil<Tag_,
+                SparseMatrixELL<double>,
+                DenseVector<double>,
+                SparseMatrixELL<double>,
+                DenseVector<double>,
+                MatrixIO<io_formats::ELL>,
+                VectorIO<io_formats::EXP>,
+                double>::configure(data, 100, 1000, 4, 4, 1, double(1e-6));
+
+            OperatorList ol(
+                    MGCycleCreation<Tag_,
+                    methods::CYCLE::V::STATIC,
+                    CGSolver<Tag_, methods::NONE>,
+                    RISmoother<Tag_>,
+                    Restriction<Tag_, methods::PROLMAT>,
+                    Prolongation<Tag_, methods::PROLMAT>,
+                    double>::value(data)
+                    );
+
+            BENCHMARK(
+                    (MGSolver<Tag_, Norm<vnt_l_two, true, Tag_> >::value(data, ol));
+                    );
+            std::cout << "Solve, " << data.A.size() << " levels, " << data.used_iters << " iterations:" << std::endl;
+            evaluate();
+        }
+};
+
+AMGBench<tags::CPU> amg_q1_sort0_l6("AMGBench cpu | q1 | sort 0 | L6 | setup vs. solve", 0, 6, 100);
+AMGBench<tags::CPU::MultiCore> mc_amg_q1_sort0_l6("AMGBench mc | q1 | sort 0 | L6 | setup vs. solve", 0, 6, 100);
+#ifdef HONEI_SSE
+AMGBench<tags::CPU::MultiCore::SSE> mcsse_amg_q1_sort0_l6("AMGBench mcsse | q1 | sort 0 | L6 | setup vs. solve", 0, 6, 100);
+#endif
+
+#ifdef HONEI_SSE
+MGSuperLUCoarseBench<tags::CPU::SSE, SuperLUUncached> sse_q1_sort0_l6_c3_superlu_uncached("MGBench sse | q1 | sort 0 | L6 | coarse L3 SuperLU, factorised per cycle | V", 0, 6, 3);
+MGSuperLUCoarseBench<tags::CPU::SSE, SuperLU> sse_q1_sort0_l6_c3_superlu("MGBench sse | q1 | sort 0 | L6 | coarse L3 SuperLU, factorised once | V", 0, 6, 3);
+MGSuperLUCoarseBench<tags::CPU::SSE, SuperLUUncached> sse_q1_sort0_l6_c4_superlu_uncached("MGBench sse | q1 | sort 0 | L6 | coarse L4 SuperLU, factorised per cycle | V", 0, 6, 4);
+MGSuperLUCoarseBench<tags::CPU::SSE, SuperLU> sse_q1_sort0_l6_c4_superlu("MGBench sse | q1 | sort 0 | L6 | coarse L4 SuperLU, factorised once | V", 0, 6, 4);
+#endif
+
 #ifdef HONEI_SSE
 //JAC
 //q1
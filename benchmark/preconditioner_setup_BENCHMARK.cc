@@ -0,0 +1,120 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2011 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the Math C++ library. LibMath is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LibMath is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <honei/math/sainv.hh>
+#include <honei/math/spai2.hh>
+#include <honei/math/matrix_io.hh>
+#include <benchmark/benchmark.hh>
+#include <honei/util/stringify.hh>
+#include <iostream>
+
+using namespace honei;
+using namespace std;
+
+/**
+ * Construction time of the SAINV preconditioner for a testdata matrix.
+ */
+template <typename Tag_, typename DT_>
+class SAINVSetupBenchmark:
+    public Benchmark
+{
+    private:
+        std::string _file_name;
+        unsigned long _count;
+
+    public:
+        SAINVSetupBenchmark(const std::string & tag, std::string filename, unsigned long count) :
+            Benchmark(tag)
+        {
+            register_tag(Tag_::name);
+            _file_name = filename;
+            _count = count;
+        }
+
+        virtual void run()
+        {
+            std::string filebase(HONEI_SOURCEDIR);
+            filebase += "/honei/math/";
+            SparseMatrixELL<DT_> smell(MatrixIO<io_formats::ELL>::read_matrix(filebase + _file_name, DT_(0)));
+            SparseMatrix<DT_> sm(smell);
+            unsigned long used_elements(0);
+
+            for (unsigned long i(0) ; i < _count ; i++)
+            {
+                BENCHMARK(
+                        SparseMatrix<DT_> m(SAINV<Tag_>::value(sm));
+                        used_elements = m.used_elements();
+                        );
+            }
+            evaluate();
+            std::cout << "Non Zero Elements of A: " << sm.used_elements() << ", of M: " << used_elements << std::endl;
+        }
+};
+SAINVSetupBenchmark<tags::CPU, double> sainv_setup_5_double_q1_0("SAINV setup double L5, q1 sort 0", "testdata/poisson_advanced/sort_0/A_5.ell", 5);
+SAINVSetupBenchmark<tags::CPU, double> sainv_setup_6_double_q1_0("SAINV setup double L6, q1 sort 0", "testdata/poisson_advanced/sort_0/A_6.ell", 5);
+SAINVSetupBenchmark<tags::CPU::MultiCore, double> mc_sainv_setup_5_double_q1_0("SAINV setup double mc L5, q1 sort 0", "testdata/poisson_advanced/sort_0/A_5.ell", 5);
+SAINVSetupBenchmark<tags::CPU::MultiCore, double> mc_sainv_setup_6_double_q1_0("SAINV setup double mc L6, q1 sort 0", "testdata/poisson_advanced/sort_0/A_6.ell", 5);
+SAINVSetupBenchmark<tags::CPU, double> sainv_setup_4_double_q2_0("SAINV setup double L4, q2 sort 0", "testdata/poisson_advanced/q2_sort_0/A_4.ell", 5);
+SAINVSetupBenchmark<tags::CPU::MultiCore, double> mc_sainv_setup_4_double_q2_0("SAINV setup double mc L4, q2 sort 0", "testdata/poisson_advanced/q2_sort_0/A_4.ell", 5);
+
+/**
+ * Construction time of the SPAI2 preconditioner for a testdata matrix.
+ */
+template <typename Tag_, typename DT_>
+class SPAI2SetupBenchmark:
+    public Benchmark
+{
+    private:
+        std::string _file_name;
+        unsigned long _count;
+
+    public:
+        SPAI2SetupBenchmark(const std::string & tag, std::string filename, unsigned long count) :
+            Benchmark(tag)
+        {
+            register_tag(Tag_::name);
+            _file_name = filename;
+            _count = count;
+        }
+
+        virtual void run()
+        {
+            std::string filebase(HONEI_SOURCEDIR);
+            filebase += "/honei/math/";
+            SparseMatrixELL<DT_> smell(MatrixIO<io_formats::ELL>::read_matrix(filebase + _file_name, DT_(0)));
+            SparseMatrix<DT_> sm(smell);
+
+            for (unsigned long i(0) ; i < _count ; i++)
+            {
+                SparseMatrix<DT_> m(sm.copy());
+                BENCHMARK(
+                        SPAI2<Tag_>::value(m, sm);
+                        );
+            }
+            evaluate();
+            std::cout << "Non Zero Elements of A: " << sm.used_elements() << std::endl;
+        }
+};
+#ifdef HONEI_SSE
+SPAI2SetupBenchmark<tags::CPU::SSE, double> sse_spai2_setup_6_double_q1_0("SPAI2 setup double sse L6, q1 sort 0", "testdata/poisson_advanced/sort_0/A_6.ell", 5);
+SPAI2SetupBenchmark<tags::CPU::MultiCore::SSE, double> mcsse_spai2_setup_6_double_q1_0("SPAI2 setup double mcsse L6, q1 sort 0", "testdata/poisson_advanced/sort_0/A_6.ell", 5);
+SPAI2SetupBenchmark<tags::CPU::SSE, double> sse_spai2_setup_4_double_q2_0("SPAI2 setup double sse L4, q2 sort 0", "testdata/poisson_advanced/q2_sort_0/A_4.ell", 5);
+SPAI2SetupBenchmark<tags::CPU::MultiCore::SSE, double> mcsse_spai2_setup_4_double_q2_0("SPAI2 setup double mcsse L4, q2 sort 0", "testdata/poisson_advanced/q2_sort_0/A_4.ell", 5);
+#endif
+SPAI2SetupBenchmark<tags::CPU::MultiCore, double> mc_spai2_setup_6_double_q1_0("SPAI2 setup double mc L6, q1 sort 0", "testdata/poisson_advanced/sort_0/A_6.ell", 5);
@@ -12,7 +12,9 @@
 #include <honei/backends/cuda/operations.hh>
 #include <honei/backends/cuda/gpu_pool.hh>
 #include <iostream>
+#include <fstream>
 #include <cmath>
+#include <cstdlib>
 #ifdef HONEI_OPENCL
 #include <honei/backends/opencl/opencl_backend.hh>
 #endif
@@ -322,6 +324,31 @@ class DenseMatrixProductBench :
             }
             BenchmarkInfo info(Product<>::get_benchmark_info(dm0, dm1));
             evaluate(info);
+
+            // Peak: one packed add and one packed mul per cycle and core.
+            double mhz(Configuration::instance()->get_value("benchmark::cpu_mhz", 0));
+            if (mhz <= 0)
+            {
+                std::ifstream cpuinfo("/proc/cpuinfo");
+                std::string line;
+                while (std::getline(cpuinfo, line))
+                {
+                    if (line.compare(0, 7, "cpu MHz") == 0 && line.find(':') != std::string::npos)
+                    {
+                        mhz = std::atof(line.substr(line.find(':') + 1).c_str());
+                        break;
+                    }
+                }
+            }
+            unsigned long cores(1);
+            if (Tag_::name.compare(0, 2, "mc") == 0)
+                cores = mc::ThreadPool::instance()->num_threads();
+            const double gflops(2.0 * _size * _size * _size / _median / 1e9);
+            const double peak(2.0 * (16 / sizeof(DataType_)) * mhz * cores / 1e3);
+            std::cout << gflops << " GFLOP/s (median, 2n^3 flops)";
+            if (peak > 0)
+                std::cout << ", " << 100 * gflops / peak << "% of " << peak << " GFLOP/s peak";
+            std::cout << std::endl;
         }
 };
 DenseMatrixProductBench<tags::CPU, float> DMPBenchfloat2("Matrix Product Benchmark dense/dense - matrix size: 256x256, float", 256, 10);
@@ -21,6 +21,8 @@
 #include <honei/la/product.hh>
 #include <honei/math/matrix_io.hh>
 #include <honei/math/vector_io.hh>
+#include <honei/math/reordering.hh>
+#include <honei/math/permutation.hh>
 #include <benchmark/benchmark.hh>
 #include <honei/util/stringify.hh>
 #include <iostream>
@@ -352,3 +354,86 @@ ProductELLFileBenchmark<tags::OpenCL::GPU, double> opencl_gpu_pareng_8_double_q2
 ProductELLFileBenchmark<tags::OpenCL::GPU, double> opencl_gpu_pareng_9_double_q2_4("ELL  Product double opencl_gpu L9, q2 sort 4", "testdata/poisson_advanced/q2_sort_4/A_9.ell", 10);
 #endif
 #endif
+
+/**
+ * Product of a testdata matrix after renumbering its unknowns by OrderType_, to compare file ordering
+ * (methods::NATURAL) with bandwidth and locality reducing orderings.
+ */
+template <typename Tag_, typename DT_, typename OrderType_>
+class ProductELLFileReorderedBenchmark:
+    public Benchmark
+{
+    private:
+        std::string _file_name;
+        unsigned long _count;
+
+    public:
+        ProductELLFileReorderedBenchmark(const std::string & tag, std::string filename, unsigned long count) :
+            Benchmark(tag)
+        {
+            register_tag(Tag_::name);
+            _file_name = filename;
+            _count = count;
+        }
+
+        virtual void run()
+        {
+            std::string filebase(HONEI_SOURCEDIR);
+            filebase += "/honei/math/";
+            _file_name = filebase + _file_name;
+            SparseMatrix<DT_> file_matrix(MatrixIO<io_formats::ELL>::read_matrix(_file_name, DT_(1)));
+            DenseVector<unsigned long> permutation(file_matrix.rows());
+            Reordering<tags::CPU, OrderType_>::value(permutation, file_matrix);
+            SparseMatrix<DT_> reordered(Permutation<tags::CPU>::value(file_matrix, permutation));
+            SparseMatrixELL<DT_> smatrix(reordered);
+
+            DenseVector<DT_> x(smatrix.rows());
+            DenseVector<DT_> y(smatrix.rows());
+            for (unsigned long i(0) ; i < x.size() ; ++i)
+            {
+                x[i] = DT_(i) / 1.234;
+            }
+
+            for (unsigned long i(0) ; i < _count ; i++)
+            {
+                BENCHMARK(
+                        for (unsigned long j(0) ; j < 10 ; ++j)
+                        {
+                            Product<Tag_>::value(y, smatrix, x);
+                        }
+                        );
+            }
+            {
+            BenchmarkInfo info;
+            info.flops = smatrix.used_elements() * 2;
+            info.load = smatrix.used_elements() * 3 * sizeof(DT_);
+            info.store = smatrix.used_elements() * 1 * sizeof(DT_);
+            evaluate(info * 10);
+            }
+
+            unsigned long bandwidth(0);
+            for (unsigned long row(0) ; row < reordered.rows() ; ++row)
+                for (unsigned long i(0) ; i < reordered[row].used_elements() ; ++i)
+                {
+                    const unsigned long column(reordered[row].indices()[i]);
+                    bandwidth = std::max(bandwidth, column > row ? column - row : row - column);
+                }
+            std::cout<<"Non Zero Elements: "<<smatrix.used_elements()<<", bandwidth: "<<bandwidth<<std::endl;
+        }
+};
+#ifdef HONEI_SSE
+ProductELLFileReorderedBenchmark<tags::CPU::SSE, double, methods::NATURAL> sse_file_order_9_double_q1_4("ELL  Product double sse L9, q1 sort 4, file order", "testdata/poisson_advanced/sort_4/A_9.ell", 10);
+ProductELLFileReorderedBenchmark<tags::CPU::SSE, double, methods::RCM> sse_rcm_9_double_q1_4("ELL  Product double sse L9, q1 sort 4, rcm", "testdata/poisson_advanced/sort_4/A_9.ell", 10);
+ProductELLFileReorderedBenchmark<tags::CPU::SSE, double, methods::NESTED_DISSECTION> sse_nd_9_double_q1_4("ELL  Product double sse L9, q1 sort 4, nested dissection", "testdata/poisson_advanced/sort_4/A_9.ell", 10);
+
+ProductELLFileReorderedBenchmark<tags::CPU::SSE, double, methods::NATURAL> sse_file_order_8_double_q2_4("ELL  Product double sse L8, q2 sort 4, file order", "testdata/poisson_advanced/q2_sort_4/A_8.ell", 10);
+ProductELLFileReorderedBenchmark<tags::CPU::SSE, double, methods::RCM> sse_rcm_8_double_q2_4("ELL  Product double sse L8, q2 sort 4, rcm", "testdata/poisson_advanced/q2_sort_4/A_8.ell", 10);
+ProductELLFileReorderedBenchmark<tags::CPU::SSE, double, methods::NESTED_DISSECTION> sse_nd_8_double_q2_4("ELL  Product double sse L8, q2 sort 4, nested dissection", "testdata/poisson_advanced/q2_sort_4/A_8.ell", 10);
+
+ProductELLFileReorderedBenchmark<tags::CPU::MultiCore::SSE, double, methods::NATURAL> mcsse_file_order_9_double_q1_4("ELL  Product double mcsse L9, q1 sort 4, file order", "testdata/poisson_advanced/sort_4/A_9.ell", 10);
+ProductELLFileReorderedBenchmark<tags::CPU::MultiCore::SSE, double, methods::RCM> mcsse_rcm_9_double_q1_4("ELL  Product double mcsse L9, q1 sort 4, rcm", "testdata/poisson_advanced/sort_4/A_9.ell", 10);
+ProductELLFileReorderedBenchmark<tags::CPU::MultiCore::SSE, double, methods::NESTED_DISSECTION> mcsse_nd_9_double_q1_4("ELL  Product double mcsse L9, q1 sort 4, nested dissection", "testdata/poisson_advanced/sort_4/A_9.ell", 10);
+#endif
+ProductELLFileReorderedBenchmark<tags::CPU, double, methods::NATURAL> file_order_9_double_q1_4("ELL  Product double L9, q1 sort 4, file order", "testdata/poisson_advanced/sort_4/A_9.ell", 10);
+ProductELLFileReorderedBenchmark<tags::CPU, double, methods::RCM> rcm_9_double_q1_4("ELL  Product double L9, q1 sort 4, rcm", "testdata/poisson_advanced/sort_4/A_9.ell", 10);
+ProductELLFileReorderedBenchmark<tags::CPU, double, methods::NESTED_DISSECTION> nd_9_double_q1_4("ELL  Product double L9, q1 sort 4, nested dissection", "testdata/poisson_advanced/sort_4/A_9.ell", 10);
@@ -0,0 +1,108 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2011 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the Math C++ library. LibMath is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LibMath is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <honei/la/product.hh>
+#include <honei/la/norm.hh>
+#include <honei/math/cg.hh>
+#include <honei/math/defect.hh>
+#include <honei/math/matrix_io.hh>
+#include <honei/math/vector_io.hh>
+#include <benchmark/benchmark.hh>
+#include <honei/util/stringify.hh>
+#include <iostream>
+
+using namespace honei;
+using namespace std;
+
+/**
+ * SpMV throughput and CG convergence of a testdata matrix whose values are stored in MT_ while all
+ * vectors stay in double.
+ */
+template <typename Tag_, typename MT_>
+class ProductELLMixedBenchmark:
+    public Benchmark
+{
+    private:
+        std::string _file_base;
+        unsigned long _level;
+        unsigned long _count;
+
+    public:
+        ProductELLMixedBenchmark(const std::string & tag, std::string file_base, unsigned long level, unsigned long count) :
+            Benchmark(tag)
+        {
+            register_tag(Tag_::name);
+            _file_base = file_base;
+            _level = level;
+            _count = count;
+        }
+
+        virtual void run()
+        {
+            std::string filebase(HONEI_SOURCEDIR);
+            filebase += "/honei/math/" + _file_base;
+            SparseMatrixELL<double> reference(MatrixIO<io_formats::ELL>::read_matrix(filebase + "A_" + stringify(_level) + ".ell", double(0)));
+            SparseMatrixELL<MT_> smatrix(MatrixIO<io_formats::ELL>::read_matrix(filebase + "A_" + stringify(_level) + ".ell", MT_(0)));
+            DenseVector<double> x(smatrix.columns());
+            DenseVector<double> y(smatrix.rows());
+            for (unsigned long i(0) ; i < x.size() ; ++i)
+            {
+                x[i] = double(i) / 1.234;
+            }
+
+            for (unsigned long i(0) ; i < _count ; i++)
+            {
+                BENCHMARK(
+                        for (unsigned long j(0) ; j < 10 ; ++j)
+                        {
+                            Product<Tag_>::value(y, smatrix, x);
+                        }
+                        );
+            }
+            {
+            const unsigned long index_bytes(smatrix.index_width() == 0 ? sizeof(unsigned long) : smatrix.index_width() / 8);
+            BenchmarkInfo info;
+            info.flops = smatrix.used_elements() * 2;
+            info.load = smatrix.used_elements() * (sizeof(MT_) + index_bytes + sizeof(double));
+            info.store = smatrix.rows() * sizeof(double);
+            evaluate(info * 10);
+            }
+
+            // convergence impact: cg with the stored operator, residual measured with the double operator
+            DenseVector<double> rhs(VectorIO<io_formats::EXP>::read_vector(filebase + "rhs_" + stringify(_level), double(0)));
+            DenseVector<double> result(VectorIO<io_formats::EXP>::read_vector(filebase + "init_" + stringify(_level), double(0)));
+            unsigned long used_iters(0);
+            CGSolver<Tag_, methods::NONE>::value(smatrix, rhs, rhs, result, 10000ul, used_iters, double(1e-8));
+            DenseVector<double> defect(rhs.size());
+            Defect<Tag_>::value(defect, rhs, reference, result);
+            std::cout << "Non Zero Elements: " << smatrix.used_elements() << ", index width: " << smatrix.index_width() << std::endl;
+            std::cout << "CG iterations: " << used_iters << ", true relative defect: "
+                << Norm<vnt_l_two, true, Tag_>::value(defect) / Norm<vnt_l_two, true, Tag_>::value(rhs) << std::endl;
+        }
+};
+#ifdef HONEI_SSE
+ProductELLMixedBenchmark<tags::CPU::SSE, double> sse_mixed_5_double_q2_0("ELL Product double/double sse L5, q2 sort 0", "testdata/poisson_advanced/q2_sort_0/", 5, 10);
+ProductELLMixedBenchmark<tags::CPU::SSE, float> sse_mixed_5_float_q2_0("ELL Product double/float sse L5, q2 sort 0", "testdata/poisson_advanced/q2_sort_0/", 5, 10);
+ProductELLMixedBenchmark<tags::CPU::SSE, double> sse_mixed_9_double_q1_0("ELL Product double/double sse L9, q1 sort 0", "testdata/poisson_advanced/sort_0/", 9, 10);
+ProductELLMixedBenchmark<tags::CPU::SSE, float> sse_mixed_9_float_q1_0("ELL Product double/float sse L9, q1 sort 0", "testdata/poisson_advanced/sort_0/", 9, 10);
+ProductELLMixedBenchmark<tags::CPU::MultiCore::SSE, double> mcsse_mixed_9_double_q1_0("ELL Product double/double mc-sse L9, q1 sort 0", "testdata/poisson_advanced/sort_0/", 9, 10);
+ProductELLMixedBenchmark<tags::CPU::MultiCore::SSE, float> mcsse_mixed_9_float_q1_0("ELL Product double/float mc-sse L9, q1 sort 0", "testdata/poisson_advanced/sort_0/", 9, 10);
+#endif
+ProductELLMixedBenchmark<tags::CPU, double> mixed_5_double_q2_0("ELL Product double/double L5, q2 sort 0", "testdata/poisson_advanced/q2_sort_0/", 5, 10);
+ProductELLMixedBenchmark<tags::CPU, float> mixed_5_float_q2_0("ELL Product double/float L5, q2 sort 0", "testdata/poisson_advanced/q2_sort_0/", 5, 10);
@@ -44,13 +44,15 @@ class ScanConversionFSIBench :
     private:
         unsigned long _size;
         int _count;
+        bool _incremental;
     public:
-        ScanConversionFSIBench(const std::string & id, unsigned long size, int count) :
+        ScanConversionFSIBench(const std::string & id, unsigned long size, int count, bool incremental = false) :
             Benchmark(id)
         {
             register_tag(Tag_::name);
             _size = size;
             _count = count;
+            _incremental = incremental;
         }
 
         virtual void run()
@@ -94,6 +96,10 @@ class ScanConversionFSIBench :
 
             ScanConversionFSI<tags::CPU>::value(grid, info, data, solids, tri_0, true);
 
+            SolidFootprint footprint;
+            if (_incremental)
+                ScanConversionFSI<tags::CPU>::value(grid, info, data, solids, tri_0, true, footprint);
+
             solids.current_u = DataType_(1./2.* grid.d_x);
             solids.current_v = DataType_(0.);
             solver.do_preprocessing();
@@ -114,7 +120,10 @@ class ScanConversionFSIBench :
                     BENCHMARK(
                             for (unsigned long j(0) ; j < 5 ; ++j)
                             {
-                            ScanConversionFSI<tags::CPU>::value(grid, info, data, solids, tri_i, true);
+                            if (_incremental)
+                                ScanConversionFSI<tags::CPU>::value(grid, info, data, solids, tri_i, true, footprint);
+                            else
+                                ScanConversionFSI<tags::CPU>::value(grid, info, data, solids, tri_i, true);
                             }
                             if (Tag_::tag_value == tags::tv_gpu_cuda)
                             cuda_thread_synchronize();
@@ -130,3 +139,5 @@ class ScanConversionFSIBench :
 
 ScanConversionFSIBench<tags::CPU, float> collide_stream_grid_bench_float("ScanConversionFSIBenchmark - size: 129, float", 129, 10);
 ScanConversionFSIBench<tags::CPU, double> collide_stream_grid_bench_double("ScanConversionFSIBenchmark - size: 129, double", 129, 10);
+ScanConversionFSIBench<tags::CPU, float> incremental_bench_float("ScanConversionFSIBenchmark incremental - size: 1025, float", 1025, 10, true);
+ScanConversionFSIBench<tags::CPU, float> full_bench_float("ScanConversionFSIBenchmark - size: 1025, float", 1025, 10);
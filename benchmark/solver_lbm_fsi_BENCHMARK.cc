@@ -133,8 +133,38 @@ class SolverLBMFSIFSIBench :
         }
 };
 
+template <typename Tag_, typename DataType_>
+class SolverLBMFSIScalingBench :
+    public SolverLBMFSIFSIBench<Tag_, DataType_>
+{
+    private:
+        unsigned long _max_parts;
+    public:
+        SolverLBMFSIScalingBench(const std::string & id, unsigned long size, int count, unsigned long max_parts) :
+            SolverLBMFSIFSIBench<Tag_, DataType_>(id, size, count),
+            _max_parts(max_parts)
+        {
+        }
+
+        virtual void run()
+        {
+            // increasing number of patches, one evaluation per patch count
+            int temp(Configuration::instance()->get_value("mc::SolverLBMFSI::patch_count", 4));
+            for (unsigned long parts(1) ; parts <= _max_parts ; parts *= 2)
+            {
+                Configuration::instance()->set_value("mc::SolverLBMFSI::patch_count", parts);
+                std::cout << "Patches: " << parts << std::endl;
+                this->_benchlist.clear();
+                SolverLBMFSIFSIBench<Tag_, DataType_>::run();
+            }
+            Configuration::instance()->set_value("mc::SolverLBMFSI::patch_count", temp);
+        }
+};
+
 SolverLBMFSIFSIBench<tags::CPU, float> collide_stream_grid_bench_float("SolverLBMFSIFSIBenchmark - size: 129, float", 129, 100);
 SolverLBMFSIFSIBench<tags::CPU, double> collide_stream_grid_bench_double("SolverLBMFSIFSIBenchmark - size: 129, double", 129, 100);
+SolverLBMFSIScalingBench<tags::CPU::MultiCore, float> mc_solver_lbm_fsi_scaling_bench_float("MC SolverLBMFSIScalingBenchmark - size: 513, float", 513, 100, 16);
+SolverLBMFSIScalingBench<tags::CPU::MultiCore, double> mc_solver_lbm_fsi_scaling_bench_double("MC SolverLBMFSIScalingBenchmark - size: 513, double", 513, 100, 16);
 #ifdef HONEI_CUDA
 SolverLBMFSIFSIBench<tags::GPU::CUDA, float> collide_stream_grid_bench_float_cuda("SolverLBMFSIFSIBenchmark CUDA - size: 450*2, float", 450*2, 100);
 #endif
@@ -25,6 +25,10 @@
 #endif
 
 #include <honei/lbm/solver_lbm_grid.hh>
+#include <honei/lbm/solver_lbm_grid_aa.hh>
+#include <honei/lbm/solver_lbm_grid_active.hh>
+#include <honei/lbm/solver_lbm_grid_mixed.hh>
+#include <honei/lbm/grid_ensemble.hh>
 #include <honei/swe/volume.hh>
 #include <iostream>
 #include <honei/swe/volume.hh>
@@ -209,6 +213,152 @@ LBMGSimpleSolverBench<tags::CPU::SSE, double> sse_solver_simple_bench_double_1("
 LBMGSimpleSolverBench<tags::CPU::MultiCore::SSE, float> mcsse_solver_simple_bench_float_1("MC SSE LBM Simple Grid solver Benchmark - size: 1000, float", 1000, 5);
 LBMGSimpleSolverBench<tags::CPU::MultiCore::SSE, double> mcsse_solver_simple_bench_double_1("MC SSE LBM Simple Grid solver Benchmark - size: 1000, double", 1000, 5);
 #endif
+template <typename Tag_, typename DataType_>
+class LBMGAASolverBench :
+    public Benchmark
+{
+    private:
+        unsigned long _size;
+        int _count;
+    public:
+        LBMGAASolverBench(const std::string & id, unsigned long size, int count) :
+            Benchmark(id)
+        {
+            register_tag(Tag_::name);
+            _size = size;
+            _count = count;
+        }
+
+        virtual void run()
+        {
+            unsigned long g_h(_size);
+            unsigned long g_w(_size);
+
+            DenseMatrix<DataType_> h(g_h, g_w, DataType_(0.05));
+            Cylinder<DataType_> c1(h, DataType_(0.02), 25, 25);
+            c1.value();
+
+            DenseMatrix<DataType_> u(g_h, g_w, DataType_(0.));
+            DenseMatrix<DataType_> v(g_h, g_w, DataType_(0.));
+            DenseMatrix<DataType_> b(g_h, g_w, DataType_(0.));
+
+            Cylinder<DataType_> b1(b, DataType_(0.04), 15, 15);
+            b1.value();
+
+            Grid<D2Q9, DataType_> grid;
+            DenseMatrix<bool> obstacles(g_h, g_w, false);
+            Cuboid<bool> q2(obstacles, 15, 5, 1, 10, 0);
+            q2.value();
+            Cuboid<bool> q3(obstacles, 40, 5, 1, 10, 30);
+            q3.value();
+            grid.obstacles = new DenseMatrix<bool>(obstacles);
+            grid.h = new DenseMatrix<DataType_>(h);
+            grid.u = new DenseMatrix<DataType_>(u);
+            grid.v = new DenseMatrix<DataType_>(v);
+            grid.b = new DenseMatrix<DataType_>(b);
+            PackedGridData<D2Q9, DataType_>  data;
+            PackedGridInfo<D2Q9> info;
+
+            GridPacker<D2Q9, NOSLIP, DataType_>::pack(grid, info, data, false);
+
+            SolverLBMGridAA<Tag_, lbm_applications::LABSWE,  DataType_,lbm_force::NONE, lbm_source_schemes::NONE, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, lbm_modes::WET> solver(&info, &data, 1., 1., 1., 1.5);
+
+            solver.do_preprocessing();
+
+            for(int i = 0; i < _count; ++i)
+            {
+                BENCHMARK(
+                        for (unsigned long j(0) ; j < 25 ; ++j)
+                        {
+                            solver.solve();
+                        }
+                        );
+            }
+            LBMBenchmarkInfo benchinfo(SolverLBMGridAA<tags::CPU, lbm_applications::LABSWE, DataType_,lbm_force::NONE, lbm_source_schemes::NONE, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, lbm_modes::WET>::get_benchmark_info(&grid, &info, &data));
+            evaluate(benchinfo * 25);
+            grid.destroy();
+            info.destroy();
+            data.destroy();
+        }
+};
+
+LBMGAASolverBench<tags::CPU, float> solver_aa_bench_float_1("LBM in-place Grid solver Benchmark - size: 1000, float", 1000, 5);
+LBMGAASolverBench<tags::CPU, double> solver_aa_bench_double_1("LBM in-place Grid solver Benchmark - size: 1000, double", 1000, 5);
+
+template <typename Tag_>
+class LBMGMixedSolverBench :
+    public Benchmark
+{
+    private:
+        unsigned long _size;
+        int _count;
+    public:
+        LBMGMixedSolverBench(const std::string & id, unsigned long size, int count) :
+            Benchmark(id)
+        {
+            register_tag(Tag_::name);
+            _size = size;
+            _count = count;
+        }
+
+        virtual void run()
+        {
+            unsigned long g_h(_size);
+            unsigned long g_w(_size);
+
+            DenseMatrix<double> h(g_h, g_w, double(0.05));
+            Cylinder<double> c1(h, double(0.02), 25, 25);
+            c1.value();
+
+            DenseMatrix<double> u(g_h, g_w, double(0.));
+            DenseMatrix<double> v(g_h, g_w, double(0.));
+            DenseMatrix<double> b(g_h, g_w, double(0.));
+
+            Cylinder<double> b1(b, double(0.04), 15, 15);
+            b1.value();
+
+            Grid<D2Q9, double> grid;
+            DenseMatrix<bool> obstacles(g_h, g_w, false);
+            Cuboid<bool> q2(obstacles, 15, 5, 1, 10, 0);
+            q2.value();
+            Cuboid<bool> q3(obstacles, 40, 5, 1, 10, 30);
+            q3.value();
+            grid.obstacles = new DenseMatrix<bool>(obstacles);
+            grid.h = new DenseMatrix<double>(h);
+            grid.u = new DenseMatrix<double>(u);
+            grid.v = new DenseMatrix<double>(v);
+            grid.b = new DenseMatrix<double>(b);
+            PackedGridData<D2Q9, double>  data;
+            PackedGridInfo<D2Q9> info;
+
+            GridPacker<D2Q9, NOSLIP, double>::pack(grid, info, data, false);
+
+            SolverLBMGridMixed<Tag_, lbm_applications::LABSWE, lbm_force::CENTRED, lbm_source_schemes::BED_FULL, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, lbm_modes::DRY> solver(&info, &data, 1., 1., 1., 1.5);
+
+            solver.do_preprocessing();
+
+            for(int i = 0; i < _count; ++i)
+            {
+                BENCHMARK(
+                        for (unsigned long j(0) ; j < 25 ; ++j)
+                        {
+                            solver.solve();
+                        }
+                        );
+            }
+            LBMBenchmarkInfo benchinfo(SolverLBMGridMixed<tags::CPU, lbm_applications::LABSWE, lbm_force::CENTRED, lbm_source_schemes::BED_FULL, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, lbm_modes::DRY>::get_benchmark_info(&grid, &info, &solver.lattice()));
+            evaluate(benchinfo * 25);
+            grid.destroy();
+            info.destroy();
+            data.destroy();
+        }
+};
+
+LBMGMixedSolverBench<tags::CPU::Generic> solver_mixed_bench_1("Generic LBM mixed precision Grid solver Benchmark - size: 500, float/double", 500, 5);
+#ifdef HONEI_SSE
+LBMGMixedSolverBench<tags::CPU::SSE> sse_solver_mixed_bench_1("SSE LBM mixed precision Grid solver Benchmark - size: 500, float/double", 500, 5);
+#endif
+
 /*#ifdef HONEI_CUDA
 LBMGSimpleSolverBench<tags::GPU::CUDA, float> cuda_solver_simple_bench_float_1("CUDA LBM Simple Grid solver Benchmark - size: 250x250, float", 250, 25);
 #endif
@@ -264,3 +414,149 @@ LBMGSimpleSolverBench<tags::GPU::MultiCore::CUDA, float> mc_cuda_solver_simple_b
 LBMGSimpleSolverBench<tags::CPU::Itanium, float> sse_solver_simple_bench_float_1("Itanium LBM Simple Grid solver Benchmark - size: 1500, float", 1500, 25);
 LBMGSimpleSolverBench<tags::CPU::Itanium, double> sse_solver_simple_bench_double_1("Itanium LBM Simple Grid solver Benchmark - size: 1500, double", 1500, 25);
 #endif
+
+
+template <typename Tag_, typename DataType_, typename Solver_>
+class LBMGDryBasinSolverBench :
+    public Benchmark
+{
+    private:
+        unsigned long _size;
+        int _count;
+    public:
+        LBMGDryBasinSolverBench(const std::string & id, unsigned long size, int count) :
+            Benchmark(id)
+        {
+            register_tag(Tag_::name);
+            _size = size;
+            _count = count;
+        }
+
+        virtual void run()
+        {
+            unsigned long g_h(_size);
+            unsigned long g_w(_size);
+
+            // a small reservoir in a mostly dry basin
+            DenseMatrix<DataType_> h(g_h, g_w, DataType_(0.));
+            Cuboid<DataType_> reservoir(h, 40, 40, DataType_(0.05), 20, 20);
+            reservoir.value();
+
+            Grid<D2Q9, DataType_> grid;
+            grid.obstacles = new DenseMatrix<bool>(g_h, g_w, false);
+            grid.h = new DenseMatrix<DataType_>(h);
+            grid.u = new DenseMatrix<DataType_>(g_h, g_w, DataType_(0.));
+            grid.v = new DenseMatrix<DataType_>(g_h, g_w, DataType_(0.));
+            grid.b = new DenseMatrix<DataType_>(g_h, g_w, DataType_(0.));
+            PackedGridData<D2Q9, DataType_>  data;
+            PackedGridInfo<D2Q9> info;
+
+            GridPacker<D2Q9, NOSLIP, DataType_>::pack(grid, info, data);
+
+            Solver_ solver(&info, &data, 0.01, 0.01, 0.01, 1.1);
+
+            solver.do_preprocessing();
+
+            for(int i = 0; i < _count; ++i)
+            {
+                BENCHMARK(
+                        for (unsigned long j(0) ; j < 25 ; ++j)
+                        {
+                            solver.solve();
+                        }
+                        );
+            }
+            LBMBenchmarkInfo benchinfo(SolverLBMGrid<tags::CPU, lbm_applications::LABSWE, DataType_,lbm_force::NONE, lbm_source_schemes::NONE, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, lbm_modes::DRY>::get_benchmark_info(&grid, &info, &data));
+            evaluate(benchinfo * 25);
+            grid.destroy();
+            info.destroy();
+            data.destroy();
+        }
+};
+
+LBMGDryBasinSolverBench<tags::CPU::Generic, float, SolverLBMGrid<tags::CPU::Generic, lbm_applications::LABSWE, float, lbm_force::NONE, lbm_source_schemes::NONE, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, lbm_modes::DRY> >
+    dry_solver_bench_float("Generic LBM Grid solver Benchmark, dry basin - size: 1000, float", 1000, 5);
+LBMGDryBasinSolverBench<tags::CPU::Generic, float, SolverLBMGridActive<tags::CPU::Generic, lbm_applications::LABSWE, float, lbm_force::NONE, lbm_source_schemes::NONE, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, lbm_modes::DRY> >
+    dry_active_solver_bench_float("Generic LBM Grid active set solver Benchmark, dry basin - size: 1000, float", 1000, 5);
+
+template <typename Tag_, typename DataType_>
+class LBMGEnsembleSolverBench :
+    public Benchmark
+{
+    private:
+        unsigned long _size;
+        unsigned long _members;
+        int _count;
+    public:
+        LBMGEnsembleSolverBench(const std::string & id, unsigned long size, unsigned long members, int count) :
+            Benchmark(id)
+        {
+            register_tag(Tag_::name);
+            _size = size;
+            _members = members;
+            _count = count;
+        }
+
+        virtual void run()
+        {
+            unsigned long g_h(_size);
+            unsigned long g_w(_size);
+
+            std::vector<Grid<D2Q9, DataType_> > grids(_members);
+            std::vector<PackedGridInfo<D2Q9> > infos(_members);
+            std::vector<PackedGridData<D2Q9, DataType_> > datas(_members);
+            std::vector<PackedGridData<D2Q9, DataType_> *> members;
+            for (unsigned long m(0) ; m < _members ; ++m)
+            {
+                // the members differ in the height of the initial dam
+                DenseMatrix<DataType_> h(g_h, g_w, DataType_(0.05));
+                Cuboid<DataType_> reservoir(h, g_h / 5, g_w / 5, DataType_(0.02) * DataType_(m + 1), g_h / 5, g_w / 5);
+                reservoir.value();
+
+                grids[m].obstacles = new DenseMatrix<bool>(g_h, g_w, false);
+                grids[m].h = new DenseMatrix<DataType_>(h);
+                grids[m].u = new DenseMatrix<DataType_>(g_h, g_w, DataType_(0.));
+                grids[m].v = new DenseMatrix<DataType_>(g_h, g_w, DataType_(0.));
+                grids[m].b = new DenseMatrix<DataType_>(g_h, g_w, DataType_(0.));
+                GridPacker<D2Q9, NOSLIP, DataType_>::pack(grids[m], infos[m], datas[m]);
+                members.push_back(&datas[m]);
+            }
+
+            PackedGridInfo<D2Q9> info;
+            PackedGridData<D2Q9, DataType_> data;
+            GridEnsemble<D2Q9, DataType_>::pack(infos[0], members, info, data);
+
+            SolverLBMGrid<Tag_, lbm_applications::LABSWE, DataType_,lbm_force::NONE, lbm_source_schemes::NONE, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, lbm_modes::DRY> solver(&info, &data, 0.01, 0.01, 0.01, 1.1);
+
+            solver.do_preprocessing();
+
+            for(int i = 0; i < _count; ++i)
+            {
+                BENCHMARK(
+                        for (unsigned long j(0) ; j < 25 ; ++j)
+                        {
+                            solver.solve();
+                        }
+                        );
+            }
+            LBMBenchmarkInfo benchinfo(SolverLBMGrid<tags::CPU, lbm_applications::LABSWE, DataType_,lbm_force::NONE, lbm_source_schemes::NONE, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, lbm_modes::DRY>::get_benchmark_info(&grids[0], &info, &data));
+            evaluate(benchinfo * 25);
+            for (unsigned long m(0) ; m < _members ; ++m)
+            {
+                grids[m].destroy();
+                infos[m].destroy();
+                datas[m].destroy();
+            }
+            info.destroy();
+            data.destroy();
+        }
+};
+
+LBMGEnsembleSolverBench<tags::CPU, float> ensemble_solver_bench_float_1("LBM Grid ensemble solver Benchmark - size: 250, members: 1, float", 250, 1, 5);
+LBMGEnsembleSolverBench<tags::CPU, float> ensemble_solver_bench_float_4("LBM Grid ensemble solver Benchmark - size: 250, members: 4, float", 250, 4, 5);
+LBMGEnsembleSolverBench<tags::CPU, float> ensemble_solver_bench_float_8("LBM Grid ensemble solver Benchmark - size: 250, members: 8, float", 250, 8, 5);
+#ifdef HONEI_SSE
+LBMGEnsembleSolverBench<tags::CPU::SSE, float> sse_ensemble_solver_bench_float_1("SSE LBM Grid ensemble solver Benchmark - size: 250, members: 1, float", 250, 1, 5);
+LBMGEnsembleSolverBench<tags::CPU::SSE, float> sse_ensemble_solver_bench_float_4("SSE LBM Grid ensemble solver Benchmark - size: 250, members: 4, float", 250, 4, 5);
+LBMGEnsembleSolverBench<tags::CPU::SSE, float> sse_ensemble_solver_bench_float_8("SSE LBM Grid ensemble solver Benchmark - size: 250, members: 8, float", 250, 8, 5);
+#endif
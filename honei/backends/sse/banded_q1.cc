@@ -0,0 +1,283 @@
+/* vim: set sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2011 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the HONEI C++ library. HONEI is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * HONEI is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <honei/backends/sse/operations.hh>
+#include <honei/la/band_type.hh>
+#include <honei/util/attributes.hh>
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+
+namespace honei
+{
+    namespace sse
+    {
+        namespace
+        {
+            template <typename DT_> struct BandedPacket;
+
+            template <> struct BandedPacket<float>
+            {
+                typedef __m128 Type;
+                static const unsigned long width = 4;
+                static inline Type load(const float * x) { return _mm_loadu_ps(x); }
+                static inline void store(float * x, Type a) { _mm_storeu_ps(x, a); }
+                static inline Type add(Type a, Type b) { return _mm_add_ps(a, b); }
+                static inline Type sub(Type a, Type b) { return _mm_sub_ps(a, b); }
+                static inline Type mul(Type a, Type b) { return _mm_mul_ps(a, b); }
+                static inline Type mask(Type a, Type b) { return _mm_and_ps(a, b); }
+                /// Selects the lanes 0 and 2, i.e. every second grid point.
+                static inline Type even() { return _mm_castsi128_ps(_mm_set_epi32(0, -1, 0, -1)); }
+            };
+
+            template <> struct BandedPacket<double>
+            {
+                typedef __m128d Type;
+                static const unsigned long width = 2;
+                static inline Type load(const double * x) { return _mm_loadu_pd(x); }
+                static inline void store(double * x, Type a) { _mm_storeu_pd(x, a); }
+                static inline Type add(Type a, Type b) { return _mm_add_pd(a, b); }
+                static inline Type sub(Type a, Type b) { return _mm_sub_pd(a, b); }
+                static inline Type mul(Type a, Type b) { return _mm_mul_pd(a, b); }
+                static inline Type mask(Type a, Type b) { return _mm_and_pd(a, b); }
+                /// Selects the lane 0, i.e. every second grid point.
+                static inline Type even() { return _mm_castsi128_pd(_mm_set_epi32(0, 0, -1, -1)); }
+            };
+
+            /// Distance in bytes the three rows of b are prefetched ahead.
+            const unsigned long prefetch_distance(512);
+
+            /**
+             * Computes a single row near the first or last grid line, where some bands
+             * point outside of b.
+             */
+            template <typename DT_>
+            inline DT_ banded_sum(const DT_ * const * band, const DT_ * b, unsigned long size, unsigned long m, unsigned long i)
+            {
+                const signed long index(i), root(m), n(size);
+
+                DT_ sum(band[DD][i] * b[i]);
+                if (index - root - 1 >= 0)
+                    sum += band[LL][i] * b[i - m - 1];
+                if (index - root >= 0)
+                    sum += band[LD][i] * b[i - m];
+                if (index - root + 1 >= 0)
+                    sum += band[LU][i] * b[i - m + 1];
+                if (index - 1 >= 0)
+                    sum += band[DL][i] * b[i - 1];
+                if (index + 1 < n)
+                    sum += band[DU][i] * b[i + 1];
+                if (index + root - 1 < n)
+                    sum += band[UL][i] * b[i + m - 1];
+                if (index + root < n)
+                    sum += band[UD][i] * b[i + m];
+                if (index + root + 1 < n)
+                    sum += band[UU][i] * b[i + m + 1];
+
+                return sum;
+            }
+
+            template <typename DT_, bool defect_>
+            inline void banded_row(DT_ * result, const DT_ * rhs, const DT_ * const * band, const DT_ * b,
+                    unsigned long size, unsigned long m, unsigned long i)
+            {
+                const DT_ sum(banded_sum(band, b, size, m, i));
+                result[i] = defect_ ? rhs[i] - sum : sum;
+            }
+
+            /**
+             * Accumulates all nine bands for the rows [i, i + width); all neighbours have to lie
+             * inside of b.
+             */
+            template <typename DT_>
+            inline typename BandedPacket<DT_>::Type banded_packet(const DT_ * const * band, const DT_ * b,
+                    unsigned long m, unsigned long i)
+            {
+                typedef BandedPacket<DT_> P_;
+                typedef typename P_::Type PT_;
+
+                const DT_ * bl(b - m);
+                const DT_ * bu(b + m);
+
+                PT_ sum(P_::mul(P_::load(band[DD] + i), P_::load(b + i)));
+                sum = P_::add(sum, P_::mul(P_::load(band[LL] + i), P_::load(bl + i - 1)));
+                sum = P_::add(sum, P_::mul(P_::load(band[LD] + i), P_::load(bl + i)));
+                sum = P_::add(sum, P_::mul(P_::load(band[LU] + i), P_::load(bl + i + 1)));
+                sum = P_::add(sum, P_::mul(P_::load(band[DL] + i), P_::load(b + i - 1)));
+                sum = P_::add(sum, P_::mul(P_::load(band[DU] + i), P_::load(b + i + 1)));
+                sum = P_::add(sum, P_::mul(P_::load(band[UL] + i), P_::load(bu + i - 1)));
+                sum = P_::add(sum, P_::mul(P_::load(band[UD] + i), P_::load(bu + i)));
+                sum = P_::add(sum, P_::mul(P_::load(band[UU] + i), P_::load(bu + i + 1)));
+
+                return sum;
+            }
+
+            /**
+             * Computes the rows [row_start, row_end) in one sweep: every element of result is
+             * written once, all nine bands are accumulated in registers.
+             */
+            template <typename DT_, bool defect_>
+            inline void banded_q1(DT_ * result, const DT_ * rhs, const DT_ * const * band, const DT_ * b,
+                    unsigned long size, unsigned long m, unsigned long row_start, unsigned long row_end)
+            {
+                typedef BandedPacket<DT_> P_;
+                typedef typename P_::Type PT_;
+
+                const unsigned long inner_start(m + 1);
+                const unsigned long inner_end(size > m + 1 ? size - m - 1 : 0);
+                const unsigned long ahead(prefetch_distance / sizeof(DT_));
+
+                const DT_ * ll(band[LL]), * ld(band[LD]), * lu(band[LU]);
+                const DT_ * dl(band[DL]), * dd(band[DD]), * du(band[DU]);
+                const DT_ * ul(band[UL]), * ud(band[UD]), * uu(band[UU]);
+                const DT_ * bl(b - m);
+                const DT_ * bu(b + m);
+
+                unsigned long i(row_start);
+                for ( ; i < row_end && i < inner_start ; ++i)
+                    banded_row<DT_, defect_>(result, rhs, band, b, size, m, i);
+
+                const unsigned long end(row_end < inner_end ? row_end : inner_end);
+                for ( ; i + P_::width <= end ; i += P_::width)
+                {
+                    if (i + ahead + m < size)
+                    {
+                        _mm_prefetch((const char *)(bl + i + ahead), _MM_HINT_T0);
+                        _mm_prefetch((const char *)(b + i + ahead), _MM_HINT_T0);
+                        _mm_prefetch((const char *)(bu + i + ahead), _MM_HINT_T0);
+                    }
+
+                    PT_ sum(banded_packet(band, b, m, i));
+
+                    if (defect_)
+                        P_::store(result + i, P_::sub(P_::load(rhs + i), sum));
+                    else
+                        P_::store(result + i, sum);
+                }
+
+                for ( ; i < end ; ++i)
+                {
+                    DT_ sum(dd[i] * b[i]
+                            + ll[i] * bl[i - 1] + ld[i] * bl[i] + lu[i] * bl[i + 1]
+                            + dl[i] * b[i - 1] + du[i] * b[i + 1]
+                            + ul[i] * bu[i - 1] + ud[i] * bu[i] + uu[i] * bu[i + 1]);
+                    result[i] = defect_ ? rhs[i] - sum : sum;
+                }
+
+                for ( ; i < row_end ; ++i)
+                    banded_row<DT_, defect_>(result, rhs, band, b, size, m, i);
+            }
+
+            /**
+             * Relaxes all points of one colour (x % 2, y % 2) of the grid lines
+             * colour / 2 + 2 * line_start, ... , colour / 2 + 2 * (line_end - 1) in place.
+             * Whole packets are computed, but only every second lane is written back, so
+             * the neighbours of the other colours stay untouched.
+             */
+            template <typename DT_>
+            inline void banded_q1_sor(DT_ * x, const DT_ * rhs, const DT_ * p, const DT_ * const * band,
+                    unsigned long size, unsigned long m, unsigned long colour, unsigned long line_start, unsigned long line_end)
+            {
+                typedef BandedPacket<DT_> P_;
+                typedef typename P_::Type PT_;
+
+                const PT_ even(P_::even());
+
+                for (unsigned long line(line_start) ; line < line_end ; ++line)
+                {
+                    const unsigned long first((colour / 2 + 2 * line) * m);
+                    const unsigned long last(first + m);
+
+                    unsigned long i(first + colour % 2);
+                    for ( ; i < last && i < m + 1 ; i += 2)
+                        x[i] += p[i] * (rhs[i] - banded_sum(band, x, size, m, i));
+
+                    for ( ; i + P_::width <= last && i + P_::width + m < size ; i += P_::width)
+                    {
+                        PT_ update(P_::mul(P_::load(p + i), P_::sub(P_::load(rhs + i), banded_packet(band, x, m, i))));
+                        P_::store(x + i, P_::add(P_::load(x + i), P_::mask(update, even)));
+                    }
+
+                    for ( ; i < last ; i += 2)
+                        x[i] += p[i] * (rhs[i] - banded_sum(band, x, size, m, i));
+                }
+            }
+        }
+
+        void product_bmdv_q1(const float * ll, const float * ld, const float * lu,
+                const float * dl, const float * dd, const float * du,
+                const float * ul, const float * ud, const float * uu,
+                const float * b, float * result,
+                unsigned long size, unsigned long m, unsigned long row_start, unsigned long row_end)
+        {
+            const float * band[9] = { ll, ld, lu, dl, dd, du, ul, ud, uu };
+            banded_q1<float, false>(result, 0, band, b, size, m, row_start, row_end);
+        }
+
+        void product_bmdv_q1(const double * ll, const double * ld, const double * lu,
+                const double * dl, const double * dd, const double * du,
+                const double * ul, const double * ud, const double * uu,
+                const double * b, double * result,
+                unsigned long size, unsigned long m, unsigned long row_start, unsigned long row_end)
+        {
+            const double * band[9] = { ll, ld, lu, dl, dd, du, ul, ud, uu };
+            banded_q1<double, false>(result, 0, band, b, size, m, row_start, row_end);
+        }
+
+        void defect_bmdv_q1(const float * ll, const float * ld, const float * lu,
+                const float * dl, const float * dd, const float * du,
+                const float * ul, const float * ud, const float * uu,
+                const float * rhs, const float * b, float * result,
+                unsigned long size, unsigned long m, unsigned long row_start, unsigned long row_end)
+        {
+            const float * band[9] = { ll, ld, lu, dl, dd, du, ul, ud, uu };
+            banded_q1<float, true>(result, rhs, band, b, size, m, row_start, row_end);
+        }
+
+        void defect_bmdv_q1(const double * ll, const double * ld, const double * lu,
+                const double * dl, const double * dd, const double * du,
+                const double * ul, const double * ud, const double * uu,
+                const double * rhs, const double * b, double * result,
+                unsigned long size, unsigned long m, unsigned long row_start, unsigned long row_end)
+        {
+            const double * band[9] = { ll, ld, lu, dl, dd, du, ul, ud, uu };
+            banded_q1<double, true>(result, rhs, band, b, size, m, row_start, row_end);
+        }
+
+        void sor_bmdv_q1(const float * ll, const float * ld, const float * lu,
+                const float * dl, const float * dd, const float * du,
+                const float * ul, const float * ud, const float * uu,
+                const float * rhs, const float * p, float * x,
+                unsigned long size, unsigned long m, unsigned long colour, unsigned long line_start, unsigned long line_end)
+        {
+            const float * band[9] = { ll, ld, lu, dl, dd, du, ul, ud, uu };
+            banded_q1_sor<float>(x, rhs, p, band, size, m, colour, line_start, line_end);
+        }
+
+        void sor_bmdv_q1(const double * ll, const double * ld, const double * lu,
+                const double * dl, const double * dd, const double * du,
+                const double * ul, const double * ud, const double * uu,
+                const double * rhs, const double * p, double * x,
+                unsigned long size, unsigned long m, unsigned long colour, unsigned long line_start, unsigned long line_end)
+        {
+            const double * band[9] = { ll, ld, lu, dl, dd, du, ul, ud, uu };
+            banded_q1_sor<double>(x, rhs, p, band, size, m, colour, line_start, line_end);
+        }
+    }
+}
@@ -0,0 +1,136 @@
+/* vim: set sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the HONEI C++ library. HONEI is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * HONEI is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <honei/util/attributes.hh>
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+
+namespace honei
+{
+    namespace sse
+    {
+        void collide_stream(float * result, const float * dist, const float * eq_dist,
+                const float * s_x, const float * s_y,
+                float e_x, float e_y, float tau, unsigned long size)
+        {
+            unsigned long x_address((unsigned long)dist);
+            unsigned long x_offset(x_address % 16);
+
+            unsigned long z_offset(x_offset / 4);
+            z_offset = (4 - z_offset) % 4;
+
+            unsigned long quad_start(z_offset);
+            unsigned long quad_end(size - ((size - quad_start) % 4));
+
+            if (size < 16)
+            {
+                quad_end = 0;
+                quad_start = 0;
+            }
+
+            for (unsigned long index(0) ; index < quad_start ; ++index)
+            {
+                result[index] = dist[index] - (dist[index] - eq_dist[index])/tau + float(1./6.) * (e_x * s_x[index] + e_y * s_y[index]);
+            }
+            for (unsigned long index(quad_end) ; index < size ; ++index)
+            {
+                result[index] = dist[index] - (dist[index] - eq_dist[index])/tau + float(1./6.) * (e_x * s_x[index] + e_y * s_y[index]);
+            }
+
+            __m128 tauv = _mm_set1_ps(tau);
+            __m128 e_xv = _mm_set1_ps(e_x);
+            __m128 e_yv = _mm_set1_ps(e_y);
+            __m128 sixth = _mm_set1_ps(float(1./6.));
+            __m128 m1, m2, m3, m4;
+
+            for (unsigned long index(quad_start) ; index < quad_end ; index += 4)
+            {
+                m1 = _mm_load_ps(dist + index);
+                m2 = _mm_loadu_ps(eq_dist + index);
+                m2 = _mm_sub_ps(m1, m2);
+                m2 = _mm_div_ps(m2, tauv);
+                m1 = _mm_sub_ps(m1, m2);
+
+                m3 = _mm_loadu_ps(s_x + index);
+                m3 = _mm_mul_ps(e_xv, m3);
+                m4 = _mm_loadu_ps(s_y + index);
+                m4 = _mm_mul_ps(e_yv, m4);
+                m3 = _mm_add_ps(m3, m4);
+                m3 = _mm_mul_ps(sixth, m3);
+
+                m1 = _mm_add_ps(m1, m3);
+                _mm_storeu_ps(result + index, m1);
+            }
+        }
+
+        void collide_stream(double * result, const double * dist, const double * eq_dist,
+                const double * s_x, const double * s_y,
+                double e_x, double e_y, double tau, unsigned long size)
+        {
+            unsigned long x_address((unsigned long)dist);
+            unsigned long x_offset(x_address % 16);
+
+            unsigned long z_offset(x_offset / 8);
+
+            unsigned long quad_start(z_offset);
+            unsigned long quad_end(size - ((size - quad_start) % 2));
+
+            if (size < 16)
+            {
+                quad_end = 0;
+                quad_start = 0;
+            }
+
+            for (unsigned long index(0) ; index < quad_start ; ++index)
+            {
+                result[index] = dist[index] - (dist[index] - eq_dist[index])/tau + double(1./6.) * (e_x * s_x[index] + e_y * s_y[index]);
+            }
+            for (unsigned long index(quad_end) ; index < size ; ++index)
+            {
+                result[index] = dist[index] - (dist[index] - eq_dist[index])/tau + double(1./6.) * (e_x * s_x[index] + e_y * s_y[index]);
+            }
+
+            __m128d tauv = _mm_set1_pd(tau);
+            __m128d e_xv = _mm_set1_pd(e_x);
+            __m128d e_yv = _mm_set1_pd(e_y);
+            __m128d sixth = _mm_set1_pd(double(1./6.));
+            __m128d m1, m2, m3, m4;
+
+            for (unsigned long index(quad_start) ; index < quad_end ; index += 2)
+            {
+                m1 = _mm_load_pd(dist + index);
+                m2 = _mm_loadu_pd(eq_dist + index);
+                m2 = _mm_sub_pd(m1, m2);
+                m2 = _mm_div_pd(m2, tauv);
+                m1 = _mm_sub_pd(m1, m2);
+
+                m3 = _mm_loadu_pd(s_x + index);
+                m3 = _mm_mul_pd(e_xv, m3);
+                m4 = _mm_loadu_pd(s_y + index);
+                m4 = _mm_mul_pd(e_yv, m4);
+                m3 = _mm_add_pd(m3, m4);
+                m3 = _mm_mul_pd(sixth, m3);
+
+                m1 = _mm_add_pd(m1, m3);
+                _mm_storeu_pd(result + index, m1);
+            }
+        }
+    }
+}
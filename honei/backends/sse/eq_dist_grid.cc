@@ -657,5 +657,130 @@ namespace honei
                 _mm_store_pd(f_eq + index, m1);
             }
         }
+
+        namespace
+        {
+            /// Mixed precision equilibrium of one non-resting direction, computed in double, stored in float.
+            inline void eq_dist_grid_dir_mixed(unsigned long begin, unsigned long end,
+                    double g, double d1, double d2, double d3,
+                    const double * h, const double * u, const double * v,
+                    double dx, double dy,
+                    float * f_eq)
+            {
+                unsigned long pair_end(begin + ((end - begin) & ~1ul));
+
+                __m128d gv = _mm_set1_pd(g);
+                __m128d d1v = _mm_set1_pd(d1);
+                __m128d d2v = _mm_set1_pd(d2);
+                __m128d d3v = _mm_set1_pd(d3);
+                __m128d dxv = _mm_set1_pd(dx);
+                __m128d dyv = _mm_set1_pd(dy);
+                __m128d twov = _mm_set1_pd(double(2.));
+                __m128d hv, uv, vv, dxu, dyv2, t1, t2, t3, t4, m1;
+
+                for (unsigned long index(begin) ; index < pair_end ; index += 2)
+                {
+                    hv = _mm_loadu_pd(h + index);
+                    uv = _mm_loadu_pd(u + index);
+                    vv = _mm_loadu_pd(v + index);
+
+                    dxu = _mm_mul_pd(dxv, uv);
+                    dyv2 = _mm_mul_pd(dyv, vv);
+
+                    t1 = _mm_div_pd(_mm_mul_pd(gv, hv), d1v);
+                    t2 = _mm_div_pd(_mm_add_pd(dxu, dyv2), d2v);
+                    m1 = _mm_add_pd(_mm_mul_pd(dxu, dxu), _mm_mul_pd(_mm_mul_pd(twov, dxu), dyv2));
+                    m1 = _mm_add_pd(m1, _mm_mul_pd(dyv2, dyv2));
+                    t3 = _mm_div_pd(m1, d3v);
+                    t4 = _mm_div_pd(_mm_add_pd(_mm_mul_pd(uv, uv), _mm_mul_pd(vv, vv)), d1v);
+
+                    m1 = _mm_sub_pd(_mm_add_pd(_mm_add_pd(t1, t2), t3), t4);
+                    m1 = _mm_mul_pd(hv, m1);
+                    _mm_storel_pi((__m64 *)(f_eq + index), _mm_cvtpd_ps(m1));
+                }
+
+                for (unsigned long index(pair_end) ; index < end ; ++index)
+                {
+                    double u2(u[index] * u[index]);
+                    double v2(v[index] * v[index]);
+                    double gh(g * h[index]);
+
+                    double dxu(dx * u[index]);
+                    double dyv(dy * v[index]);
+                    double t1((gh) / d1);
+                    double t2((dxu + dyv) / d2);
+                    double t3((dxu * dxu + double(2.) * dxu * dyv + dyv * dyv) / d3);
+                    double t4((u2 + v2) / d1);
+                    f_eq[index] = float(h[index] * (t1 + t2 + t3 - t4));
+                }
+            }
+        }
+
+        void eq_dist_grid_dir_0(unsigned long begin, unsigned long end,
+                double g, double e,
+                double * h, double * u, double * v,
+                float * f_eq_0)
+        {
+            unsigned long pair_end(begin + ((end - begin) & ~1ul));
+
+            double e2(e);
+            double e23(double(3.) * e2);
+            double e26(double(6.) * e2);
+
+            __m128d gv = _mm_set1_pd(g);
+            __m128d fivev = _mm_set1_pd(double(5.));
+            __m128d e26v = _mm_set1_pd(e26);
+            __m128d t2v = _mm_set1_pd(double(2.) / e23);
+            __m128d onev = _mm_set1_pd(double(1.));
+            __m128d hv, uv, vv, t1, t2, m1;
+
+            for (unsigned long index(begin) ; index < pair_end ; index += 2)
+            {
+                hv = _mm_loadu_pd(h + index);
+                uv = _mm_loadu_pd(u + index);
+                vv = _mm_loadu_pd(v + index);
+
+                t1 = _mm_div_pd(_mm_mul_pd(fivev, _mm_mul_pd(gv, hv)), e26v);
+                t2 = _mm_mul_pd(t2v, _mm_add_pd(_mm_mul_pd(uv, uv), _mm_mul_pd(vv, vv)));
+                m1 = _mm_sub_pd(_mm_sub_pd(onev, t1), t2);
+                m1 = _mm_mul_pd(hv, m1);
+                _mm_storel_pi((__m64 *)(f_eq_0 + index), _mm_cvtpd_ps(m1));
+            }
+
+            for (unsigned long index(pair_end) ; index < end ; ++index)
+            {
+                double u2(u[index] * u[index]);
+                double v2(v[index] * v[index]);
+                double gh(g * h[index]);
+
+                double t1((double(5.) * gh) / e26);
+                double t2(double(2.) / e23 * (u2 + v2));
+                f_eq_0[index] = float(h[index] * (double(1) - t1 - t2));
+            }
+        }
+
+        void eq_dist_grid_dir_odd(unsigned long begin, unsigned long end,
+                double g, double e,
+                double * h, double * u, double * v,
+                double * distribution_x, double * distribution_y,
+                float * f_eq,
+                unsigned long dir)
+        {
+            double e2(e);
+            eq_dist_grid_dir_mixed(begin, end, g, double(6.) * e2, double(3.) * e2, double(2.) * e2 * e2,
+                    h, u, v, distribution_x[dir], distribution_y[dir], f_eq);
+        }
+
+        void eq_dist_grid_dir_even(unsigned long begin, unsigned long end,
+                double g, double e,
+                double * h, double * u, double * v,
+                double * distribution_x, double * distribution_y,
+                float * f_eq,
+                unsigned long dir)
+        {
+            double e2(e);
+            eq_dist_grid_dir_mixed(begin, end, g, double(24.) * e2, double(12.) * e2, double(8.) * e2 * e2,
+                    h, u, v, distribution_x[dir], distribution_y[dir], f_eq);
+        }
     }
 }
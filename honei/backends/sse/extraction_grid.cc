@@ -602,5 +602,92 @@ namespace honei
                   _mm_store_pd(v + index, m3);
             }
         }
+
+        void extraction_grid_dry(unsigned long begin, unsigned long end,
+                double * distribution_x, double * distribution_y,
+                double * h, double * u, double * v,
+                float * h_f, float * u_f, float * v_f,
+                float * f_0, float * f_1, float * f_2,
+                float * f_3, float * f_4, float * f_5,
+                float * f_6, float * f_7, float * f_8, double epsilon)
+        {
+            const float * const f[9] = { f_0, f_1, f_2, f_3, f_4, f_5, f_6, f_7, f_8 };
+
+            unsigned long pair_end(begin + ((end - begin) & ~1ul));
+
+            double lax_upper(epsilon);
+            double lax_lower(-lax_upper);
+
+            __m128d dx[9], dy[9];
+            for (unsigned long dir(0) ; dir < 9 ; ++dir)
+            {
+                dx[dir] = _mm_set1_pd(distribution_x[dir]);
+                dy[dir] = _mm_set1_pd(distribution_y[dir]);
+            }
+            __m128d upper = _mm_set1_pd(lax_upper);
+            __m128d lower = _mm_set1_pd(lax_lower);
+            __m128d zero = _mm_setzero_pd();
+            __m128d one = _mm_set1_pd(double(1));
+            __m128d th, tu, tv, m1, mask;
+
+            for (unsigned long index(begin) ; index < pair_end ; index += 2)
+            {
+                th = zero;
+                tu = zero;
+                tv = zero;
+                for (unsigned long dir(0) ; dir < 9 ; ++dir)
+                {
+                    m1 = _mm_cvtps_pd(_mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)(f[dir] + index)));
+                    th = _mm_add_pd(th, m1);
+                    tu = _mm_add_pd(tu, _mm_mul_pd(dx[dir], m1));
+                    tv = _mm_add_pd(tv, _mm_mul_pd(dy[dir], m1));
+                }
+
+                mask = _mm_or_pd(_mm_cmplt_pd(th, lower), _mm_cmpgt_pd(th, upper));
+                tu = _mm_and_pd(mask, _mm_div_pd(tu, th));
+                tv = _mm_and_pd(mask, _mm_div_pd(tv, th));
+                th = _mm_and_pd(mask, th);
+                th = _mm_max_pd(zero, _mm_min_pd(one, th));
+
+                _mm_storeu_pd(h + index, th);
+                _mm_storeu_pd(u + index, tu);
+                _mm_storeu_pd(v + index, tv);
+                _mm_storel_pi((__m64 *)(h_f + index), _mm_cvtpd_ps(th));
+                _mm_storel_pi((__m64 *)(u_f + index), _mm_cvtpd_ps(tu));
+                _mm_storel_pi((__m64 *)(v_f + index), _mm_cvtpd_ps(tv));
+            }
+
+            for (unsigned long index(pair_end) ; index < end ; ++index)
+            {
+                double sh(0), su(0), sv(0);
+                for (unsigned long dir(0) ; dir < 9 ; ++dir)
+                {
+                    double t(f[dir][index]);
+                    sh += t;
+                    su += distribution_x[dir] * t;
+                    sv += distribution_y[dir] * t;
+                }
+
+                if(sh < lax_lower || sh > lax_upper)
+                {
+                    su /= sh;
+                    sv /= sh;
+                }
+                else
+                {
+                    sh = 0;
+                    su = 0;
+                    sv = 0;
+                }
+                sh = std::max(double(0), std::min(double(1), sh));
+
+                h[index] = sh;
+                u[index] = su;
+                v[index] = sv;
+                h_f[index] = float(sh);
+                u_f[index] = float(su);
+                v_f[index] = float(sv);
+            }
+        }
     }
 }
@@ -36,6 +36,20 @@ namespace honei
             unsigned long blocksize, unsigned long row_start, unsigned long row_end);
         void defect_csr_dv(double * result, const double * rhs, const unsigned long * Aj, const double * Ax, const unsigned long * Ar, const double * b,
             unsigned long blocksize, unsigned long row_start, unsigned long row_end);
+        void defect_bmdv_q1(const float * ll, const float * ld, const float * lu,
+                const float * dl, const float * dd, const float * du,
+                const float * ul, const float * ud, const float * uu,
+                const float * rhs, const float * b, float * result,
+                unsigned long size, unsigned long m, unsigned long row_start, unsigned long row_end);
+        void defect_bmdv_q1(const double * ll, const double * ld, const double * lu,
+                const double * dl, const double * dd, const double * du,
+                const double * ul, const double * ud, const double * uu,
+                const double * rhs, const double * b, double * result,
+                unsigned long size, unsigned long m, unsigned long row_start, unsigned long row_end);
+        void defect_smdv_q1(float * result, const float * rhs, const float * stencil, const float * b,
+            unsigned long m, unsigned long row_start, unsigned long row_end);
+        void defect_smdv_q1(double * result, const double * rhs, const double * stencil, const double * b,
+            unsigned long m, unsigned long row_start, unsigned long row_end);
 
         void difference(float * a, const float * b, unsigned long size);
         void difference(double * a, const double * b, unsigned long size);
@@ -60,18 +74,99 @@ namespace honei
         void product_dm(double * x, double * y, double b, unsigned long size);
         void product_dm_nx2(float * result, const float * a, const float * b, unsigned long size);
         void product_dm_nx2(double * result, const double * a, const double * b, unsigned long size);
+        /// r += a * b; a_pack and b_pack are aligned buffers of (mc + 8) * kc and kc * (nc + 8) elements.
+        void product_dm_packed(float * r, const float * a, const float * b, unsigned long rows, unsigned long columns, unsigned long depth,
+                unsigned long ldr, unsigned long lda, unsigned long ldb, float * a_pack, float * b_pack,
+                unsigned long mc, unsigned long kc, unsigned long nc);
+        void product_dm_packed(double * r, const double * a, const double * b, unsigned long rows, unsigned long columns, unsigned long depth,
+                unsigned long ldr, unsigned long lda, unsigned long ldb, double * a_pack, double * b_pack,
+                unsigned long mc, unsigned long kc, unsigned long nc);
         void product_bmdv(float * x, const float * y, const float * z, unsigned long size);
         void product_bmdv(double * x, const double * y, const double * z, unsigned long size);
-        void product_bmdv_q1(float * ll, float * ld, float * lu,
-                float * dl, float * dd, float * du,
-                float * ul, float * ud, float * uu,
-                float * b, float * result,
-                unsigned long, unsigned long m);
-        void product_bmdv_q1(double * ll, double * ld, double * lu,
-                double * dl, double * dd, double * du,
-                double * ul, double * ud, double * uu,
-                double * b, double * result,
-                unsigned long, unsigned long m);
+        void product_bmdv_q1(const float * ll, const float * ld, const float * lu,
+                const float * dl, const float * dd, const float * du,
+                const float * ul, const float * ud, const float * uu,
+                const float * b, float * result,
+                unsigned long size, unsigned long m, unsigned long row_start, unsigned long row_end);
+        void product_bmdv_q1(const double * ll, const double * ld, const double * lu,
+                const double * dl, const double * dd, const double * du,
+                const double * ul, const double * ud, const double * uu,
+                const double * b, double * result,
+                unsigned long size, unsigned long m, unsigned long row_start, unsigned long row_end);
+        void product_smdv_q1(float * result, const float * stencil, const float * b,
+            unsigned long m, unsigned long row_start, unsigned long row_end);
+        void product_smdv_q1(double * result, const double * stencil, const double * b,
+            unsigned long m, unsigned long row_start, unsigned long row_end);
+        /// ELL and CSR products and defects with row relative 16 or 32 bit column indices (column = row + Ajd[i]).
+        void product_smell_dv(float * result, const short * Ajd, const float * Ax, const unsigned long * Arl, const float * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads);
+        void defect_smell_dv(float * result, const float * rhs, const short * Ajd, const float * Ax, const unsigned long * Arl, const float * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads);
+        void product_csr_dv(float * result, const short * Ajd, const float * Ax, const unsigned long * Ar, const float * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end);
+        void defect_csr_dv(float * result, const float * rhs, const short * Ajd, const float * Ax, const unsigned long * Ar, const float * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end);
+        void product_smell_dv(double * result, const short * Ajd, const double * Ax, const unsigned long * Arl, const double * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads);
+        void defect_smell_dv(double * result, const double * rhs, const short * Ajd, const double * Ax, const unsigned long * Arl, const double * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads);
+        void product_csr_dv(double * result, const short * Ajd, const double * Ax, const unsigned long * Ar, const double * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end);
+        void defect_csr_dv(double * result, const double * rhs, const short * Ajd, const double * Ax, const unsigned long * Ar, const double * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end);
+        void product_smell_dv(float * result, const int * Ajd, const float * Ax, const unsigned long * Arl, const float * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads);
+        void defect_smell_dv(float * result, const float * rhs, const int * Ajd, const float * Ax, const unsigned long * Arl, const float * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads);
+        void product_csr_dv(float * result, const int * Ajd, const float * Ax, const unsigned long * Ar, const float * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end);
+        void defect_csr_dv(float * result, const float * rhs, const int * Ajd, const float * Ax, const unsigned long * Ar, const float * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end);
+        void product_smell_dv(double * result, const int * Ajd, const double * Ax, const unsigned long * Arl, const double * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads);
+        void defect_smell_dv(double * result, const double * rhs, const int * Ajd, const double * Ax, const unsigned long * Arl, const double * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads);
+        void product_csr_dv(double * result, const int * Ajd, const double * Ax, const unsigned long * Ar, const double * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end);
+        void defect_csr_dv(double * result, const double * rhs, const int * Ajd, const double * Ax, const unsigned long * Ar, const double * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end);
+
+        /// Mixed precision ELL and CSR products and defects, float matrix values with double vectors.
+        void product_smell_dv(double * result, const unsigned long * Aj, const float * Ax, const unsigned long * Arl, const double * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads);
+        void defect_smell_dv(double * result, const double * rhs, const unsigned long * Aj, const float * Ax, const unsigned long * Arl, const double * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads);
+        void product_csr_dv(double * result, const unsigned long * Aj, const float * Ax, const unsigned long * Ar, const double * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end);
+        void defect_csr_dv(double * result, const double * rhs, const unsigned long * Aj, const float * Ax, const unsigned long * Ar, const double * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end);
+        void product_smell_dv(double * result, const short * Aj, const float * Ax, const unsigned long * Arl, const double * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads);
+        void defect_smell_dv(double * result, const double * rhs, const short * Aj, const float * Ax, const unsigned long * Arl, const double * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads);
+        void product_csr_dv(double * result, const short * Aj, const float * Ax, const unsigned long * Ar, const double * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end);
+        void defect_csr_dv(double * result, const double * rhs, const short * Aj, const float * Ax, const unsigned long * Ar, const double * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end);
+        void product_smell_dv(double * result, const int * Aj, const float * Ax, const unsigned long * Arl, const double * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads);
+        void defect_smell_dv(double * result, const double * rhs, const int * Aj, const float * Ax, const unsigned long * Arl, const double * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads);
+        void product_csr_dv(double * result, const int * Aj, const float * Ax, const unsigned long * Ar, const double * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end);
+        void defect_csr_dv(double * result, const double * rhs, const int * Aj, const float * Ax, const unsigned long * Ar, const double * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end);
+
+        /// BSR products and defects over the block rows [block_row_start, block_row_end), unrolled for blocks of size 2, 3 and 4.
+        void product_bsr_dv(float * result, const unsigned long * Ar, const unsigned long * Aj, const float * Ax, const float * b,
+                unsigned long block_size, unsigned long block_row_start, unsigned long block_row_end);
+        void defect_bsr_dv(float * result, const float * rhs, const unsigned long * Ar, const unsigned long * Aj, const float * Ax, const float * b,
+                unsigned long block_size, unsigned long block_row_start, unsigned long block_row_end);
+        void product_bsr_dv(double * result, const unsigned long * Ar, const unsigned long * Aj, const double * Ax, const double * b,
+                unsigned long block_size, unsigned long block_row_start, unsigned long block_row_end);
+        void defect_bsr_dv(double * result, const double * rhs, const unsigned long * Ar, const unsigned long * Aj, const double * Ax, const double * b,
+                unsigned long block_size, unsigned long block_row_start, unsigned long block_row_end);
+
         void product_smell_dv(float * result, const unsigned long * Aj, const float * Ax, const unsigned long * Arl, const float * b,
             unsigned long stride, unsigned long rows, unsigned long num_cols_per_row,
             unsigned long row_start, unsigned long row_end, const unsigned long threads);
@@ -96,6 +191,17 @@ namespace honei
         void scale(const float a, float * x, unsigned long size);
         void scale(const double a, double * x, unsigned long size);
 
+        void sor_bmdv_q1(const float * ll, const float * ld, const float * lu,
+                const float * dl, const float * dd, const float * du,
+                const float * ul, const float * ud, const float * uu,
+                const float * rhs, const float * p, float * x,
+                unsigned long size, unsigned long m, unsigned long colour, unsigned long line_start, unsigned long line_end);
+        void sor_bmdv_q1(const double * ll, const double * ld, const double * lu,
+                const double * dl, const double * dd, const double * du,
+                const double * ul, const double * ud, const double * uu,
+                const double * rhs, const double * p, double * x,
+                unsigned long size, unsigned long m, unsigned long colour, unsigned long line_start, unsigned long line_end);
+
         void sum(float * a, const float * b, unsigned long size);
         void sum(double * a, const double * b, unsigned long size);
         void sum(const float a, float * x, unsigned long size);
@@ -140,6 +246,33 @@ namespace honei
                 double * f_eq,
                 unsigned long dir);
 
+        void eq_dist_grid_dir_0(unsigned long begin, unsigned long end,
+                double g, double e,
+                double * h, double * u, double * v,
+                float * f_eq_0);
+
+        void eq_dist_grid_dir_odd(unsigned long begin, unsigned long end,
+                double g, double e,
+                double * h, double * u, double * v,
+                double * distribution_x, double * distribution_y,
+                float * f_eq,
+                unsigned long dir);
+
+        void eq_dist_grid_dir_even(unsigned long begin, unsigned long end,
+                double g, double e,
+                double * h, double * u, double * v,
+                double * distribution_x, double * distribution_y,
+                float * f_eq,
+                unsigned long dir);
+
+        void collide_stream(float * result, const float * dist, const float * eq_dist,
+                const float * s_x, const float * s_y,
+                float e_x, float e_y, float tau, unsigned long size);
+
+        void collide_stream(double * result, const double * dist, const double * eq_dist,
+                const double * s_x, const double * s_y,
+                double e_x, double e_y, double tau, unsigned long size);
+
         void collide_stream_grid_dir_0(unsigned long begin, unsigned long end, float tau,
                 float * f_temp_0, float * f_0, float * f_eq_0);
 
@@ -168,6 +301,14 @@ namespace honei
                 double * f_3, double * f_4, double * f_5,
                 double * f_6, double * f_7, double * f_8, double epsilon);
 
+        void extraction_grid_dry(unsigned long begin, unsigned long end,
+                double * distribution_x, double * distribution_y,
+                double * h, double * u, double * v,
+                float * h_f, float * u_f, float * v_f,
+                float * f_0, float * f_1, float * f_2,
+                float * f_3, float * f_4, float * f_5,
+                float * f_6, float * f_7, float * f_8, double epsilon);
+
         void extraction_grid_wet(unsigned long begin, unsigned long end,
                 float * distribution_x, float * distribution_y,
                 float * h, float * u, float * v,
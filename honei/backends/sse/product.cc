@@ -21,6 +21,7 @@
 
 #include <xmmintrin.h>
 #include <emmintrin.h>
+#include <algorithm>
 
 namespace honei
 {
@@ -277,6 +278,209 @@ namespace honei
             result[1] = result2;
         }
 
+        namespace
+        {
+            template <typename DT_> struct GemmPacket;
+
+            template <> struct GemmPacket<float>
+            {
+                typedef __m128 Type;
+                static const unsigned long width = 4;
+                static inline Type zero() { return _mm_setzero_ps(); }
+                static inline Type load(const float * x) { return _mm_load_ps(x); }
+                static inline Type loadu(const float * x) { return _mm_loadu_ps(x); }
+                static inline void storeu(float * x, Type a) { _mm_storeu_ps(x, a); }
+                static inline Type broadcast(const float * x) { return _mm_load1_ps(x); }
+                static inline Type add(Type a, Type b) { return _mm_add_ps(a, b); }
+                static inline Type mul(Type a, Type b) { return _mm_mul_ps(a, b); }
+            };
+
+            template <> struct GemmPacket<double>
+            {
+                typedef __m128d Type;
+                static const unsigned long width = 2;
+                static inline Type zero() { return _mm_setzero_pd(); }
+                static inline Type load(const double * x) { return _mm_load_pd(x); }
+                static inline Type loadu(const double * x) { return _mm_loadu_pd(x); }
+                static inline void storeu(double * x, Type a) { _mm_storeu_pd(x, a); }
+                static inline Type broadcast(const double * x) { return _mm_load1_pd(x); }
+                static inline Type add(Type a, Type b) { return _mm_add_pd(a, b); }
+                static inline Type mul(Type a, Type b) { return _mm_mul_pd(a, b); }
+            };
+
+            /// Register block of the micro kernel: gemm_mr rows times two packets of columns.
+            const unsigned long gemm_mr(4);
+
+            template <typename DT_> inline unsigned long gemm_nr()
+            {
+                return 2 * GemmPacket<DT_>::width;
+            }
+
+            /**
+             * Packs the rows x depth block of a into slivers of gemm_mr rows, stored column after column.
+             * Missing rows of the last sliver are zero padded.
+             */
+            template <typename DT_>
+            void pack_a(DT_ * target, const DT_ * a, unsigned long lda, unsigned long rows, unsigned long depth)
+            {
+                for (unsigned long i(0) ; i < rows ; i += gemm_mr)
+                {
+                    const unsigned long mr(std::min(gemm_mr, rows - i));
+                    for (unsigned long p(0) ; p < depth ; ++p)
+                    {
+                        unsigned long ii(0);
+                        for ( ; ii < mr ; ++ii)
+                            target[ii] = a[(i + ii) * lda + p];
+                        for ( ; ii < gemm_mr ; ++ii)
+                            target[ii] = DT_(0);
+                        target += gemm_mr;
+                    }
+                }
+            }
+
+            /**
+             * Packs the depth x columns block of b into slivers of gemm_nr columns, stored row after row.
+             * Missing columns of the last sliver are zero padded.
+             */
+            template <typename DT_>
+            void pack_b(DT_ * target, const DT_ * b, unsigned long ldb, unsigned long depth, unsigned long columns)
+            {
+                const unsigned long nr_max(gemm_nr<DT_>());
+                for (unsigned long j(0) ; j < columns ; j += nr_max)
+                {
+                    const unsigned long nr(std::min(nr_max, columns - j));
+                    for (unsigned long p(0) ; p < depth ; ++p)
+                    {
+                        const DT_ * source(b + p * ldb + j);
+                        unsigned long jj(0);
+                        for ( ; jj < nr ; ++jj)
+                            target[jj] = source[jj];
+                        for ( ; jj < nr_max ; ++jj)
+                            target[jj] = DT_(0);
+                        target += nr_max;
+                    }
+                }
+            }
+
+            /**
+             * Computes r += a * b for one gemm_mr x gemm_nr block from packed slivers of a and b.
+             * Only the leading rows x columns part of the block is read and written back.  The
+             * accumulators start from r, so each element is summed in the same order as a plain
+             * row times column loop.
+             */
+            template <typename DT_>
+            inline void gemm_micro_kernel(DT_ * r, unsigned long ldr, const DT_ * a, const DT_ * b, unsigned long depth,
+                    unsigned long rows, unsigned long columns)
+            {
+                typedef GemmPacket<DT_> P_;
+                typedef typename P_::Type PT_;
+                const unsigned long w(P_::width);
+                const bool full(rows == gemm_mr && columns == 2 * w);
+
+                DT_ HONEI_ALIGNED(16) block[gemm_mr * 2 * (16 / sizeof(DT_))];
+                DT_ * c(r);
+                unsigned long ldc(ldr);
+                if (! full)
+                {
+                    for (unsigned long i(0) ; i < gemm_mr ; ++i)
+                        for (unsigned long j(0) ; j < 2 * w ; ++j)
+                            block[i * 2 * w + j] = (i < rows && j < columns) ? r[i * ldr + j] : DT_(0);
+                    c = block;
+                    ldc = 2 * w;
+                }
+
+                PT_ c00(P_::loadu(c)), c01(P_::loadu(c + w));
+                PT_ c10(P_::loadu(c + ldc)), c11(P_::loadu(c + ldc + w));
+                PT_ c20(P_::loadu(c + 2 * ldc)), c21(P_::loadu(c + 2 * ldc + w));
+                PT_ c30(P_::loadu(c + 3 * ldc)), c31(P_::loadu(c + 3 * ldc + w));
+
+                for (unsigned long p(0) ; p < depth ; ++p)
+                {
+                    const PT_ b0(P_::load(b)), b1(P_::load(b + w));
+                    PT_ ai(P_::broadcast(a));
+                    c00 = P_::add(c00, P_::mul(ai, b0));
+                    c01 = P_::add(c01, P_::mul(ai, b1));
+                    ai = P_::broadcast(a + 1);
+                    c10 = P_::add(c10, P_::mul(ai, b0));
+                    c11 = P_::add(c11, P_::mul(ai, b1));
+                    ai = P_::broadcast(a + 2);
+                    c20 = P_::add(c20, P_::mul(ai, b0));
+                    c21 = P_::add(c21, P_::mul(ai, b1));
+                    ai = P_::broadcast(a + 3);
+                    c30 = P_::add(c30, P_::mul(ai, b0));
+                    c31 = P_::add(c31, P_::mul(ai, b1));
+                    a += gemm_mr;
+                    b += 2 * w;
+                }
+
+                P_::storeu(c, c00);
+                P_::storeu(c + w, c01);
+                P_::storeu(c + ldc, c10);
+                P_::storeu(c + ldc + w, c11);
+                P_::storeu(c + 2 * ldc, c20);
+                P_::storeu(c + 2 * ldc + w, c21);
+                P_::storeu(c + 3 * ldc, c30);
+                P_::storeu(c + 3 * ldc + w, c31);
+
+                if (! full)
+                {
+                    for (unsigned long i(0) ; i < rows ; ++i)
+                        for (unsigned long j(0) ; j < columns ; ++j)
+                            r[i * ldr + j] = block[i * 2 * w + j];
+                }
+            }
+
+            template <typename DT_>
+            void gemm(DT_ * r, const DT_ * a, const DT_ * b, unsigned long rows, unsigned long columns, unsigned long depth,
+                    unsigned long ldr, unsigned long lda, unsigned long ldb, DT_ * a_pack, DT_ * b_pack,
+                    unsigned long mc, unsigned long kc, unsigned long nc)
+            {
+                const unsigned long nr(gemm_nr<DT_>());
+                mc = std::max(gemm_mr, mc - mc % gemm_mr);
+                nc = std::max(nr, nc - nc % nr);
+                kc = std::max(1ul, kc);
+
+                for (unsigned long jc(0) ; jc < columns ; jc += nc)
+                {
+                    const unsigned long nb(std::min(nc, columns - jc));
+                    for (unsigned long pc(0) ; pc < depth ; pc += kc)
+                    {
+                        const unsigned long kb(std::min(kc, depth - pc));
+                        pack_b(b_pack, b + pc * ldb + jc, ldb, kb, nb);
+
+                        for (unsigned long ic(0) ; ic < rows ; ic += mc)
+                        {
+                            const unsigned long mb(std::min(mc, rows - ic));
+                            pack_a(a_pack, a + ic * lda + pc, lda, mb, kb);
+
+                            for (unsigned long jr(0) ; jr < nb ; jr += nr)
+                            {
+                                for (unsigned long ir(0) ; ir < mb ; ir += gemm_mr)
+                                {
+                                    gemm_micro_kernel(r + (ic + ir) * ldr + jc + jr, ldr, a_pack + ir * kb, b_pack + jr * kb, kb,
+                                            std::min(gemm_mr, mb - ir), std::min(nr, nb - jr));
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        void product_dm_packed(float * r, const float * a, const float * b, unsigned long rows, unsigned long columns, unsigned long depth,
+                unsigned long ldr, unsigned long lda, unsigned long ldb, float * a_pack, float * b_pack,
+                unsigned long mc, unsigned long kc, unsigned long nc)
+        {
+            gemm(r, a, b, rows, columns, depth, ldr, lda, ldb, a_pack, b_pack, mc, kc, nc);
+        }
+
+        void product_dm_packed(double * r, const double * a, const double * b, unsigned long rows, unsigned long columns, unsigned long depth,
+                unsigned long ldr, unsigned long lda, unsigned long ldb, double * a_pack, double * b_pack,
+                unsigned long mc, unsigned long kc, unsigned long nc)
+        {
+            gemm(r, a, b, rows, columns, depth, ldr, lda, ldb, a_pack, b_pack, mc, kc, nc);
+        }
+
         void product_bmdv(float * x, const float * y, const float * z, unsigned long size)
         {
             __m128 m1, m2, m3, m4, m5, m6;
@@ -426,582 +630,6 @@ namespace honei
             }
         }
 
-        void product_bmdv_q1(float * ll, float * ld, float * lu,
-                float * dl, float * dd, float * du,
-                float * ul, float * ud, float * uu,
-                float * b, float * result,
-                unsigned long size, unsigned long m)
-        {
-            __m128 m1, m2, m3;
-
-            unsigned long index(0);
-
-            //index 0
-            result[index] = dd[index] * b[index]
-                + du[index] * b[index + 1]
-                + ul[index] * b[index + m - 1]
-                + ud[index] * b[index + m]
-                + uu[index] * b[index + m + 1];
-
-            //index in [1, root_n -1[
-            index = 1;
-            unsigned long quad_start(index + 4 - (index % 4));
-            unsigned long quad_end(m - 1 - ((m - 1 - quad_start) % 4));
-
-            for (unsigned long si(index) ; si < quad_start ; ++si)
-            {
-                result[si] = dd[si] * b[si]
-                    + dl[si] * b[si - 1]
-                    + du[si] * b[si + 1]
-                    + ul[si] * b[si + m - 1]
-                    + ud[si] * b[si + m]
-                    + uu[si] * b[si + m + 1];
-            }
-
-            for (unsigned long si(quad_start) ; si < quad_end ; si+=4)
-            {
-                //result[si] = dd[si] * b[si]
-                m2 = _mm_loadu_ps(b + si);
-                m3 = _mm_load_ps(dd + si);
-                m1 = _mm_mul_ps(m3, m2);
-
-                //+ dl[si] * b[si - 1]
-                m2 = _mm_loadu_ps(b + si - 1);
-                m3 = _mm_load_ps(dl + si);
-                m3 = _mm_mul_ps(m3, m2);
-                m1 = _mm_add_ps(m1, m3);
-
-                //+ du[si] * b[si + 1]
-                m2 = _mm_loadu_ps(b + si + 1);
-                m3 = _mm_load_ps(du + si);
-                m3 = _mm_mul_ps(m3, m2);
-                m1 = _mm_add_ps(m1, m3);
-
-                //+ ul[si] * b[si + m - 1]
-                m2 = _mm_loadu_ps(b + si + m - 1);
-                m3 = _mm_load_ps(ul + si);
-                m3 = _mm_mul_ps(m3, m2);
-                m1 = _mm_add_ps(m1, m3);
-
-                //+ ud[si] * b[si + m]
-                m2 = _mm_loadu_ps(b + si + m);
-                m3 = _mm_load_ps(ud + si);
-                m3 = _mm_mul_ps(m3, m2);
-                m1 = _mm_add_ps(m1, m3);
-
-                //+ uu[si] * b[si + m + 1];
-                m2 = _mm_loadu_ps(b + si + m + 1);
-                m3 = _mm_load_ps(uu + si);
-                m3 = _mm_mul_ps(m3, m2);
-                m1 = _mm_add_ps(m1, m3);
-
-                _mm_store_ps(result + si, m1);
-            }
-
-            for (unsigned long si(quad_end) ; si < m - 1 ; ++si)
-            {
-                result[si] = dd[si] * b[si]
-                    + dl[si] * b[si - 1]
-                    + du[si] * b[si + 1]
-                    + ul[si] * b[si + m - 1]
-                    + ud[si] * b[si + m]
-                    + uu[si] * b[si + m + 1];
-            }
-
-
-            //index root_n -1
-            index = m - 1;
-            result[index] = dd[index] * b[index]
-                + lu[index] * b[index - m + 1]
-                + dl[index] * b[index - 1]
-                + du[index] * b[index + 1]
-                + ul[index] * b[index + m - 1]
-                + ud[index] * b[index + m]
-                + uu[index] * b[index + m + 1];
-
-            //index root_n
-            index = m;
-            result[index] = dd[index] * b[index]
-                + lu[index] * b[index - m + 1]
-                + ld[index] * b[index - m]
-                + dl[index] * b[index - 1]
-                + du[index] * b[index + 1]
-                + ul[index] * b[index + m - 1]
-                + ud[index] * b[index + m]
-                + uu[index] * b[index + m + 1];
-
-            //index in [root_n + 1, n - (root_n + 1)[
-            index = m + 1;
-            quad_start = index + 4 - (index % 4);
-            quad_end = size - m - 1 - ((size - m - 1 - quad_start) % 4);
-
-            for (unsigned long si(index) ; si < quad_start ; ++si)
-            {
-                result[si] = dd[si] * b[si]
-                    + ll[si] * b[si - m - 1]
-                    + lu[si] * b[si - m + 1]
-                    + ld[si] * b[si - m]
-                    + dl[si] * b[si - 1]
-                    + du[si] * b[si + 1]
-                    + ul[si] * b[si + m - 1]
-                    + ud[si] * b[si + m]
-                    + uu[si] * b[si + m + 1];
-            }
-
-            for (unsigned long si(quad_start) ; si < quad_end ; si+=4)
-            {
-                //result[si] = dd[si] * b[si]
-                m2 = _mm_loadu_ps(b + si);
-                m3 = _mm_load_ps(dd + si);
-                m1 = _mm_mul_ps(m3, m2);
-
-                //+ ll[si] * b[si - m - 1]
-                m2 = _mm_loadu_ps(b + si -m - 1);
-                m3 = _mm_load_ps(ll + si);
-                m3 = _mm_mul_ps(m3, m2);
-                m1 = _mm_add_ps(m1, m3);
-
-                //+ lu[si] * b[si - m + 1]
-                m2 = _mm_loadu_ps(b + si - m + 1);
-                m3 = _mm_load_ps(lu + si);
-                m3 = _mm_mul_ps(m3, m2);
-                m1 = _mm_add_ps(m1, m3);
-
-                //+ ld[si] * b[si - m]
-                m2 = _mm_loadu_ps(b + si - m);
-                m3 = _mm_load_ps(ld + si);
-                m3 = _mm_mul_ps(m3, m2);
-                m1 = _mm_add_ps(m1, m3);
-
-                //+ dl[si] * b[si - 1]
-                m2 = _mm_loadu_ps(b + si - 1);
-                m3 = _mm_load_ps(dl + si);
-                m3 = _mm_mul_ps(m3, m2);
-                m1 = _mm_add_ps(m1, m3);
-
-                //+ du[si] * b[si + 1]
-                m2 = _mm_loadu_ps(b + si + 1);
-                m3 = _mm_load_ps(du + si);
-                m3 = _mm_mul_ps(m3, m2);
-                m1 = _mm_add_ps(m1, m3);
-
-                //+ ul[si] * b[si + m - 1]
-                m2 = _mm_loadu_ps(b + si + m - 1);
-                m3 = _mm_load_ps(ul + si);
-                m3 = _mm_mul_ps(m3, m2);
-                m1 = _mm_add_ps(m1, m3);
-
-                //+ ud[si] * b[si + m]
-                m2 = _mm_loadu_ps(b + si + m);
-                m3 = _mm_load_ps(ud + si);
-                m3 = _mm_mul_ps(m3, m2);
-                m1 = _mm_add_ps(m1, m3);
-
-                //+ uu[si] * b[si + m + 1];
-                m2 = _mm_loadu_ps(b + si + m + 1);
-                m3 = _mm_load_ps(uu + si);
-                m3 = _mm_mul_ps(m3, m2);
-                m1 = _mm_add_ps(m1, m3);
-
-                _mm_store_ps(result + si, m1);
-            }
-
-            for (unsigned long si(quad_end) ; si < size - m - 1 ; ++si)
-            {
-                result[si] = dd[si] * b[si]
-                    + ll[si] * b[si - m - 1]
-                    + lu[si] * b[si - m + 1]
-                    + ld[si] * b[si - m]
-                    + dl[si] * b[si - 1]
-                    + du[si] * b[si + 1]
-                    + ul[si] * b[si + m - 1]
-                    + ud[si] * b[si + m]
-                    + uu[si] * b[si + m + 1];
-            }
-
-            //index n - (root_n + 1)
-            index = size - m - 1;
-            result[index] = dd[index] * b[index]
-                + ll[index] * b[index - m - 1]
-                + lu[index] * b[index - m + 1]
-                + ld[index] * b[index - m]
-                + dl[index] * b[index - 1]
-                + du[index] * b[index + 1]
-                + ul[index] * b[index + m - 1]
-                + ud[index] * b[index + m];
-
-            //index n - root_n
-            index = size - m;
-            result[index] = dd[index] * b[index]
-                + ll[index] * b[index - m - 1]
-                + lu[index] * b[index - m + 1]
-                + ld[index] * b[index - m]
-                + dl[index] * b[index - 1]
-                + du[index] * b[index + 1]
-                + ul[index] * b[index + m - 1];
-
-            //index in [n - root_n + 1, n -1[
-            index = size - m + 1;
-            quad_start = index + 4 - (index % 4);
-            quad_end = size - 1 - ((size - 1 - quad_start) % 4);
-
-            for (unsigned long si(index) ; si < quad_start ; ++si)
-            {
-                result[si] = dd[si] * b[si]
-                    + ll[si] * b[si - m - 1]
-                    + lu[si] * b[si - m + 1]
-                    + ld[si] * b[si - m]
-                    + dl[si] * b[si - 1]
-                    + du[si] * b[si + 1];
-            }
-
-            for (unsigned long si(quad_start) ; si < quad_end ; si+=4)
-            {
-                //result[si] = dd[si] * b[si]
-                m2 = _mm_loadu_ps(b + si);
-                m3 = _mm_load_ps(dd + si);
-                m1 = _mm_mul_ps(m3, m2);
-
-                //+ ll[si] * b[si - m - 1]
-                m2 = _mm_loadu_ps(b + si -m - 1);
-                m3 = _mm_load_ps(ll + si);
-                m3 = _mm_mul_ps(m3, m2);
-                m1 = _mm_add_ps(m1, m3);
-
-                //+ lu[si] * b[si - m + 1]
-                m2 = _mm_loadu_ps(b + si - m + 1);
-                m3 = _mm_load_ps(lu + si);
-                m3 = _mm_mul_ps(m3, m2);
-                m1 = _mm_add_ps(m1, m3);
-
-                //+ ld[si] * b[si - m]
-                m2 = _mm_loadu_ps(b + si - m);
-                m3 = _mm_load_ps(ld + si);
-                m3 = _mm_mul_ps(m3, m2);
-                m1 = _mm_add_ps(m1, m3);
-
-                //+ dl[si] * b[si - 1]
-                m2 = _mm_loadu_ps(b + si - 1);
-                m3 = _mm_load_ps(dl + si);
-                m3 = _mm_mul_ps(m3, m2);
-                m1 = _mm_add_ps(m1, m3);
-
-                //+ du[si] * b[si + 1]
-                m2 = _mm_loadu_ps(b + si + 1);
-                m3 = _mm_load_ps(du + si);
-                m3 = _mm_mul_ps(m3, m2);
-                m1 = _mm_add_ps(m1, m3);
-
-                _mm_store_ps(result + si, m1);
-            }
-
-            for (unsigned long si(quad_end) ; si < size - m - 1 ; ++si)
-            {
-                result[si] = dd[si] * b[si]
-                    + ll[si] * b[si - m - 1]
-                    + lu[si] * b[si - m + 1]
-                    + ld[si] * b[si - m]
-                    + dl[si] * b[si - 1]
-                    + du[si] * b[si + 1];
-            }
-
-            //index n - 1
-            index = size - 1;
-            result[index] = dd[index] * b[index]
-                + ll[index] * b[index - m - 1]
-                + lu[index] * b[index - m + 1]
-                + ld[index] * b[index - m]
-                + dl[index] * b[index - 1];
-        }
-
-        void product_bmdv_q1(double * ll, double * ld, double * lu,
-                double * dl, double * dd, double * du,
-                double * ul, double * ud, double * uu,
-                double * b, double * result,
-                unsigned long size, unsigned long m)
-        {
-            __m128d m1, m2, m3;
-
-            unsigned long index(0);
-
-            //index 0
-            result[index] = dd[index] * b[index]
-                + du[index] * b[index + 1]
-                + ul[index] * b[index + m - 1]
-                + ud[index] * b[index + m]
-                + uu[index] * b[index + m + 1];
-
-            //index in [1, root_n -1[
-            index = 1;
-            unsigned long quad_start(index + (index % 2));
-            unsigned long quad_end(m - 1 - ((m - 1 - quad_start) % 2));
-
-            for (unsigned long si(index) ; si < quad_start ; ++si)
-            {
-                result[si] = dd[si] * b[si]
-                    + dl[si] * b[si - 1]
-                    + du[si] * b[si + 1]
-                    + ul[si] * b[si + m - 1]
-                    + ud[si] * b[si + m]
-                    + uu[si] * b[si + m + 1];
-            }
-
-            for (unsigned long si(quad_start) ; si < quad_end ; si+=2)
-            {
-                //result[si] = dd[si] * b[si]
-                m2 = _mm_loadu_pd(b + si);
-                m3 = _mm_load_pd(dd + si);
-                m1 = _mm_mul_pd(m3, m2);
-
-                //+ dl[si] * b[si - 1]
-                m2 = _mm_loadu_pd(b + si - 1);
-                m3 = _mm_load_pd(dl + si);
-                m3 = _mm_mul_pd(m3, m2);
-                m1 = _mm_add_pd(m1, m3);
-
-                //+ du[si] * b[si + 1]
-                m2 = _mm_loadu_pd(b + si + 1);
-                m3 = _mm_load_pd(du + si);
-                m3 = _mm_mul_pd(m3, m2);
-                m1 = _mm_add_pd(m1, m3);
-
-                //+ ul[si] * b[si + m - 1]
-                m2 = _mm_loadu_pd(b + si + m - 1);
-                m3 = _mm_load_pd(ul + si);
-                m3 = _mm_mul_pd(m3, m2);
-                m1 = _mm_add_pd(m1, m3);
-
-                //+ ud[si] * b[si + m]
-                m2 = _mm_loadu_pd(b + si + m);
-                m3 = _mm_load_pd(ud + si);
-                m3 = _mm_mul_pd(m3, m2);
-                m1 = _mm_add_pd(m1, m3);
-
-                //+ uu[si] * b[si + m + 1];
-                m2 = _mm_loadu_pd(b + si + m + 1);
-                m3 = _mm_load_pd(uu + si);
-                m3 = _mm_mul_pd(m3, m2);
-                m1 = _mm_add_pd(m1, m3);
-
-                _mm_store_pd(result + si, m1);
-            }
-
-            for (unsigned long si(quad_end) ; si < m - 1 ; ++si)
-            {
-                result[si] = dd[si] * b[si]
-                    + dl[si] * b[si - 1]
-                    + du[si] * b[si + 1]
-                    + ul[si] * b[si + m - 1]
-                    + ud[si] * b[si + m]
-                    + uu[si] * b[si + m + 1];
-            }
-
-
-            //index root_n -1
-            index = m - 1;
-            result[index] = dd[index] * b[index]
-                + lu[index] * b[index - m + 1]
-                + dl[index] * b[index - 1]
-                + du[index] * b[index + 1]
-                + ul[index] * b[index + m - 1]
-                + ud[index] * b[index + m]
-                + uu[index] * b[index + m + 1];
-
-            //index root_n
-            index = m;
-            result[index] = dd[index] * b[index]
-                + lu[index] * b[index - m + 1]
-                + ld[index] * b[index - m]
-                + dl[index] * b[index - 1]
-                + du[index] * b[index + 1]
-                + ul[index] * b[index + m - 1]
-                + ud[index] * b[index + m]
-                + uu[index] * b[index + m + 1];
-
-            //index in [root_n + 1, n - (root_n + 1)[
-            index = m + 1;
-            quad_start = index + (index % 2);
-            quad_end = size - m - 1 - ((size - m - 1 - quad_start) % 2);
-
-            for (unsigned long si(index) ; si < quad_start ; ++si)
-            {
-                result[si] = dd[si] * b[si]
-                    + ll[si] * b[si - m - 1]
-                    + lu[si] * b[si - m + 1]
-                    + ld[si] * b[si - m]
-                    + dl[si] * b[si - 1]
-                    + du[si] * b[si + 1]
-                    + ul[si] * b[si + m - 1]
-                    + ud[si] * b[si + m]
-                    + uu[si] * b[si + m + 1];
-            }
-
-            for (unsigned long si(quad_start) ; si < quad_end ; si+=2)
-            {
-                //result[si] = dd[si] * b[si]
-                m2 = _mm_loadu_pd(b + si);
-                m3 = _mm_load_pd(dd + si);
-                m1 = _mm_mul_pd(m3, m2);
-
-                //+ ll[si] * b[si - m - 1]
-                m2 = _mm_loadu_pd(b + si -m - 1);
-                m3 = _mm_load_pd(ll + si);
-                m3 = _mm_mul_pd(m3, m2);
-                m1 = _mm_add_pd(m1, m3);
-
-                //+ lu[si] * b[si - m + 1]
-                m2 = _mm_loadu_pd(b + si - m + 1);
-                m3 = _mm_load_pd(lu + si);
-                m3 = _mm_mul_pd(m3, m2);
-                m1 = _mm_add_pd(m1, m3);
-
-                //+ ld[si] * b[si - m]
-                m2 = _mm_loadu_pd(b + si - m);
-                m3 = _mm_load_pd(ld + si);
-                m3 = _mm_mul_pd(m3, m2);
-                m1 = _mm_add_pd(m1, m3);
-
-                //+ dl[si] * b[si - 1]
-                m2 = _mm_loadu_pd(b + si - 1);
-                m3 = _mm_load_pd(dl + si);
-                m3 = _mm_mul_pd(m3, m2);
-                m1 = _mm_add_pd(m1, m3);
-
-                //+ du[si] * b[si + 1]
-                m2 = _mm_loadu_pd(b + si + 1);
-                m3 = _mm_load_pd(du + si);
-                m3 = _mm_mul_pd(m3, m2);
-                m1 = _mm_add_pd(m1, m3);
-
-                //+ ul[si] * b[si + m - 1]
-                m2 = _mm_loadu_pd(b + si + m - 1);
-                m3 = _mm_load_pd(ul + si);
-                m3 = _mm_mul_pd(m3, m2);
-                m1 = _mm_add_pd(m1, m3);
-
-                //+ ud[si] * b[si + m]
-                m2 = _mm_loadu_pd(b + si + m);
-                m3 = _mm_load_pd(ud + si);
-                m3 = _mm_mul_pd(m3, m2);
-                m1 = _mm_add_pd(m1, m3);
-
-                //+ uu[si] * b[si + m + 1];
-                m2 = _mm_loadu_pd(b + si + m + 1);
-                m3 = _mm_load_pd(uu + si);
-                m3 = _mm_mul_pd(m3, m2);
-                m1 = _mm_add_pd(m1, m3);
-
-                _mm_store_pd(result + si, m1);
-            }
-
-            for (unsigned long si(quad_end) ; si < size - m - 1 ; ++si)
-            {
-                result[si] = dd[si] * b[si]
-                    + ll[si] * b[si - m - 1]
-                    + lu[si] * b[si - m + 1]
-                    + ld[si] * b[si - m]
-                    + dl[si] * b[si - 1]
-                    + du[si] * b[si + 1]
-                    + ul[si] * b[si + m - 1]
-                    + ud[si] * b[si + m]
-                    + uu[si] * b[si + m + 1];
-            }
-
-            //index n - (root_n + 1)
-            index = size - m - 1;
-            result[index] = dd[index] * b[index]
-                + ll[index] * b[index - m - 1]
-                + lu[index] * b[index - m + 1]
-                + ld[index] * b[index - m]
-                + dl[index] * b[index - 1]
-                + du[index] * b[index + 1]
-                + ul[index] * b[index + m - 1]
-                + ud[index] * b[index + m];
-
-            //index n - root_n
-            index = size - m;
-            result[index] = dd[index] * b[index]
-                + ll[index] * b[index - m - 1]
-                + lu[index] * b[index - m + 1]
-                + ld[index] * b[index - m]
-                + dl[index] * b[index - 1]
-                + du[index] * b[index + 1]
-                + ul[index] * b[index + m - 1];
-
-            //index in [n - root_n + 1, n -1[
-            index = size - m + 1;
-            quad_start = index + (index % 2);
-            quad_end = size - 1 - ((size - 1 - quad_start) % 2);
-
-            for (unsigned long si(index) ; si < quad_start ; ++si)
-            {
-                result[si] = dd[si] * b[si]
-                    + ll[si] * b[si - m - 1]
-                    + lu[si] * b[si - m + 1]
-                    + ld[si] * b[si - m]
-                    + dl[si] * b[si - 1]
-                    + du[si] * b[si + 1];
-            }
-
-            for (unsigned long si(quad_start) ; si < quad_end ; si+=2)
-            {
-                //result[si] = dd[si] * b[si]
-                m2 = _mm_loadu_pd(b + si);
-                m3 = _mm_load_pd(dd + si);
-                m1 = _mm_mul_pd(m3, m2);
-
-                //+ ll[si] * b[si - m - 1]
-                m2 = _mm_loadu_pd(b + si -m - 1);
-                m3 = _mm_load_pd(ll + si);
-                m3 = _mm_mul_pd(m3, m2);
-                m1 = _mm_add_pd(m1, m3);
-
-                //+ lu[si] * b[si - m + 1]
-                m2 = _mm_loadu_pd(b + si - m + 1);
-                m3 = _mm_load_pd(lu + si);
-                m3 = _mm_mul_pd(m3, m2);
-                m1 = _mm_add_pd(m1, m3);
-
-                //+ ld[si] * b[si - m]
-                m2 = _mm_loadu_pd(b + si - m);
-                m3 = _mm_load_pd(ld + si);
-                m3 = _mm_mul_pd(m3, m2);
-                m1 = _mm_add_pd(m1, m3);
-
-                //+ dl[si] * b[si - 1]
-                m2 = _mm_loadu_pd(b + si - 1);
-                m3 = _mm_load_pd(dl + si);
-                m3 = _mm_mul_pd(m3, m2);
-                m1 = _mm_add_pd(m1, m3);
-
-                //+ du[si] * b[si + 1]
-                m2 = _mm_loadu_pd(b + si + 1);
-                m3 = _mm_load_pd(du + si);
-                m3 = _mm_mul_pd(m3, m2);
-                m1 = _mm_add_pd(m1, m3);
-
-                _mm_store_pd(result + si, m1);
-            }
-
-            for (unsigned long si(quad_end) ; si < size - m - 1 ; ++si)
-            {
-                result[si] = dd[si] * b[si]
-                    + ll[si] * b[si - m - 1]
-                    + lu[si] * b[si - m + 1]
-                    + ld[si] * b[si - m]
-                    + dl[si] * b[si - 1]
-                    + du[si] * b[si + 1];
-            }
-
-            //index n - 1
-            index = size - 1;
-            result[index] = dd[index] * b[index]
-                + ll[index] * b[index - m - 1]
-                + lu[index] * b[index - m + 1]
-                + ld[index] * b[index - m]
-                + dl[index] * b[index - 1];
-        }
-
         void product_smell_dv(float * result, const unsigned long * Aj, const float * Ax, const unsigned long * Arl, const float * b,
                 unsigned long stride, unsigned long /*rows*/, unsigned long /*num_cols_per_row*/,
                 unsigned long row_start, unsigned long row_end, const unsigned long threads)
@@ -0,0 +1,177 @@
+/* vim: set sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2011 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the HONEI C++ library. HONEI is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * HONEI is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <honei/util/attributes.hh>
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+
+namespace honei
+{
+    namespace sse
+    {
+        namespace
+        {
+            template <typename DT_> struct BlockPacket;
+
+            template <> struct BlockPacket<float>
+            {
+                typedef __m128 Type;
+                static const unsigned long width = 4;
+                static inline Type zero() { return _mm_setzero_ps(); }
+                static inline Type loadu(const float * x) { return _mm_loadu_ps(x); }
+                static inline void store(float * x, Type a) { _mm_store_ps(x, a); }
+                static inline Type add(Type a, Type b) { return _mm_add_ps(a, b); }
+                static inline Type mul(Type a, Type b) { return _mm_mul_ps(a, b); }
+
+                /// Returns the x values matching the column major block elements [offset, offset + 4).
+                template <unsigned long R_>
+                static inline Type expand(const float * x, unsigned long offset)
+                {
+                    return _mm_set_ps(x[(offset + 3) / R_], x[(offset + 2) / R_], x[(offset + 1) / R_], x[offset / R_]);
+                }
+            };
+
+            template <> struct BlockPacket<double>
+            {
+                typedef __m128d Type;
+                static const unsigned long width = 2;
+                static inline Type zero() { return _mm_setzero_pd(); }
+                static inline Type loadu(const double * x) { return _mm_loadu_pd(x); }
+                static inline void store(double * x, Type a) { _mm_store_pd(x, a); }
+                static inline Type add(Type a, Type b) { return _mm_add_pd(a, b); }
+                static inline Type mul(Type a, Type b) { return _mm_mul_pd(a, b); }
+
+                /// Returns the x values matching the column major block elements [offset, offset + 2).
+                template <unsigned long R_>
+                static inline Type expand(const double * x, unsigned long offset)
+                {
+                    return _mm_set_pd(x[(offset + 1) / R_], x[offset / R_]);
+                }
+            };
+
+            /**
+             * BSR product with R_ x R_ blocks; computes rhs - A * b instead if rhs is given.
+             *
+             * Every block is multiplied element wise with the matching x values in packets over its
+             * column major storage, so all R_ * R_ products of a block stay in registers. The partial
+             * sums are folded into the R_ results of the block row once per block row.
+             */
+            template <typename DT_, unsigned long R_>
+            void bsr_dv(DT_ * result, const DT_ * rhs, const unsigned long * Ar, const unsigned long * Aj, const DT_ * Ax, const DT_ * b,
+                    unsigned long block_row_start, unsigned long block_row_end)
+            {
+                typedef BlockPacket<DT_> P_;
+                const unsigned long size(R_ * R_);
+                const unsigned long packets(size / P_::width);
+                const unsigned long rest(size % P_::width);
+
+                for (unsigned long block_row(block_row_start) ; block_row < block_row_end ; ++block_row)
+                {
+                    typename P_::Type sum_v[packets];
+                    DT_ sum_r[rest + 1];
+                    for (unsigned long k(0) ; k < packets ; ++k)
+                        sum_v[k] = P_::zero();
+                    for (unsigned long k(0) ; k < rest ; ++k)
+                        sum_r[k] = DT_(0);
+
+                    for (unsigned long i(Ar[block_row]) ; i < Ar[block_row + 1] ; ++i)
+                    {
+                        const DT_ * block(Ax + i * size);
+                        const DT_ * x(b + Aj[i] * R_);
+                        for (unsigned long k(0) ; k < packets ; ++k)
+                            sum_v[k] = P_::add(P_::mul(P_::loadu(block + k * P_::width), P_::template expand<R_>(x, k * P_::width)), sum_v[k]);
+                        for (unsigned long k(0) ; k < rest ; ++k)
+                            sum_r[k] += block[packets * P_::width + k] * x[(packets * P_::width + k) / R_];
+                    }
+
+                    DT_ HONEI_ALIGNED(16) flat[size + P_::width];
+                    for (unsigned long k(0) ; k < packets ; ++k)
+                        P_::store(flat + k * P_::width, sum_v[k]);
+                    for (unsigned long k(0) ; k < rest ; ++k)
+                        flat[packets * P_::width + k] = sum_r[k];
+
+                    DT_ * y(result + block_row * R_);
+                    for (unsigned long r(0) ; r < R_ ; ++r)
+                    {
+                        DT_ sum(0);
+                        for (unsigned long c(0) ; c < R_ ; ++c)
+                            sum += flat[c * R_ + r];
+                        y[r] = rhs == 0 ? sum : rhs[block_row * R_ + r] - sum;
+                    }
+                }
+            }
+
+            template <typename DT_>
+            void bsr_dv(DT_ * result, const DT_ * rhs, const unsigned long * Ar, const unsigned long * Aj, const DT_ * Ax, const DT_ * b,
+                    unsigned long block_size, unsigned long block_row_start, unsigned long block_row_end)
+            {
+                switch (block_size)
+                {
+                    case 2:
+                        bsr_dv<DT_, 2>(result, rhs, Ar, Aj, Ax, b, block_row_start, block_row_end);
+                        break;
+                    case 3:
+                        bsr_dv<DT_, 3>(result, rhs, Ar, Aj, Ax, b, block_row_start, block_row_end);
+                        break;
+                    case 4:
+                        bsr_dv<DT_, 4>(result, rhs, Ar, Aj, Ax, b, block_row_start, block_row_end);
+                        break;
+                    default:
+                        for (unsigned long block_row(block_row_start) ; block_row < block_row_end ; ++block_row)
+                        {
+                            for (unsigned long r(0) ; r < block_size ; ++r)
+                            {
+                                DT_ sum(0);
+                                for (unsigned long i(Ar[block_row]) ; i < Ar[block_row + 1] ; ++i)
+                                    for (unsigned long c(0) ; c < block_size ; ++c)
+                                        sum += Ax[(i * block_size + c) * block_size + r] * b[Aj[i] * block_size + c];
+                                const unsigned long row(block_row * block_size + r);
+                                result[row] = rhs == 0 ? sum : rhs[row] - sum;
+                            }
+                        }
+                }
+            }
+        }
+
+        void product_bsr_dv(float * result, const unsigned long * Ar, const unsigned long * Aj, const float * Ax, const float * b,
+                unsigned long block_size, unsigned long block_row_start, unsigned long block_row_end)
+        {
+            bsr_dv(result, (const float *)0, Ar, Aj, Ax, b, block_size, block_row_start, block_row_end);
+        }
+
+        void defect_bsr_dv(float * result, const float * rhs, const unsigned long * Ar, const unsigned long * Aj, const float * Ax, const float * b,
+                unsigned long block_size, unsigned long block_row_start, unsigned long block_row_end)
+        {
+            bsr_dv(result, rhs, Ar, Aj, Ax, b, block_size, block_row_start, block_row_end);
+        }
+
+        void product_bsr_dv(double * result, const unsigned long * Ar, const unsigned long * Aj, const double * Ax, const double * b,
+                unsigned long block_size, unsigned long block_row_start, unsigned long block_row_end)
+        {
+            bsr_dv(result, (const double *)0, Ar, Aj, Ax, b, block_size, block_row_start, block_row_end);
+        }
+
+        void defect_bsr_dv(double * result, const double * rhs, const unsigned long * Ar, const unsigned long * Aj, const double * Ax, const double * b,
+                unsigned long block_size, unsigned long block_row_start, unsigned long block_row_end)
+        {
+            bsr_dv(result, rhs, Ar, Aj, Ax, b, block_size, block_row_start, block_row_end);
+        }
+    }
+}
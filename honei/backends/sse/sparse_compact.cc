@@ -0,0 +1,348 @@
+/* vim: set sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2011 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the HONEI C++ library. HONEI is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * HONEI is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <honei/util/attributes.hh>
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+
+namespace honei
+{
+    namespace sse
+    {
+        namespace
+        {
+            template <typename DT_> struct SparsePacket;
+
+            template <> struct SparsePacket<float>
+            {
+                typedef __m128 Type;
+                static const unsigned long width = 4;
+                static inline Type zero() { return _mm_setzero_ps(); }
+                static inline Type load(const float * x) { return _mm_load_ps(x); }
+                static inline Type loadu(const float * x) { return _mm_loadu_ps(x); }
+                static inline Type add(Type a, Type b) { return _mm_add_ps(a, b); }
+                static inline Type mul(Type a, Type b) { return _mm_mul_ps(a, b); }
+
+                template <typename IT_>
+                static inline Type gather(const float * b, long row, const IT_ * j)
+                {
+                    return _mm_set_ps(b[row + j[3]], b[row + j[2]], b[row + j[1]], b[row + j[0]]);
+                }
+
+                static inline float sum(Type a)
+                {
+                    float HONEI_ALIGNED(16) f[4];
+                    _mm_store_ps(f, a);
+                    return f[0] + f[1] + f[2] + f[3];
+                }
+            };
+
+            template <> struct SparsePacket<double>
+            {
+                typedef __m128d Type;
+                static const unsigned long width = 2;
+                static inline Type zero() { return _mm_setzero_pd(); }
+                static inline Type load(const double * x) { return _mm_load_pd(x); }
+                static inline Type loadu(const double * x) { return _mm_loadu_pd(x); }
+                // widen two float values in register, no alignment is needed for the 8 byte load
+                static inline Type load(const float * x) { return _mm_cvtps_pd(_mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double *>(x)))); }
+                static inline Type loadu(const float * x) { return load(x); }
+                static inline Type add(Type a, Type b) { return _mm_add_pd(a, b); }
+                static inline Type mul(Type a, Type b) { return _mm_mul_pd(a, b); }
+
+                template <typename IT_>
+                static inline Type gather(const double * b, long row, const IT_ * j)
+                {
+                    return _mm_set_pd(b[row + j[1]], b[row + j[0]]);
+                }
+
+                static inline double sum(Type a)
+                {
+                    double HONEI_ALIGNED(16) d[2];
+                    _mm_store_pd(d, a);
+                    return d[0] + d[1];
+                }
+            };
+
+            /// Row relative indices are offset by the row, absolute ones are not.
+            template <typename IT_> struct IndexBase
+            {
+                static inline long value(unsigned long row) { return long(row); }
+            };
+
+            template <> struct IndexBase<unsigned long>
+            {
+                static inline long value(unsigned long) { return 0; }
+            };
+
+            /**
+             * ELL product with row relative column indices; computes rhs - A * b instead if rhs is given.
+             * The matrix values may be stored in a narrower type than the vectors.
+             */
+            template <typename DT_, typename MT_, typename IT_>
+            void smell_dv(DT_ * result, const DT_ * rhs, const IT_ * Ajd, const MT_ * Ax, const unsigned long * Arl, const DT_ * b,
+                    unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads)
+            {
+                typedef SparsePacket<DT_> P_;
+
+                for (unsigned long row(row_start) ; row < row_end ; ++row)
+                {
+                    const IT_ * tAj(Ajd + row * threads);
+                    const MT_ * tAx(Ax + row * threads);
+                    const long base(IndexBase<IT_>::value(row));
+                    const unsigned long max(Arl[row]);
+                    DT_ sum(0);
+
+                    if (threads % P_::width != 0)
+                    {
+                        for (unsigned long n(0) ; n < max ; ++n)
+                        {
+                            for (unsigned long thread(0) ; thread < threads ; ++thread)
+                                sum += DT_(tAx[thread]) * b[base + tAj[thread]];
+
+                            tAj += stride;
+                            tAx += stride;
+                        }
+                    }
+                    else
+                    {
+                        typename P_::Type sum_v(P_::zero());
+                        for (unsigned long n(0) ; n < max ; ++n)
+                        {
+                            for (unsigned long thread(0) ; thread < threads ; thread += P_::width)
+                                sum_v = P_::add(P_::mul(P_::load(tAx + thread), P_::gather(b, base, tAj + thread)), sum_v);
+
+                            tAj += stride;
+                            tAx += stride;
+                        }
+                        sum = P_::sum(sum_v);
+                    }
+
+                    result[row] = rhs == 0 ? sum : rhs[row] - sum;
+                }
+            }
+
+            /**
+             * CSR product with row relative column indices; computes rhs - A * b instead if rhs is given.
+             * The matrix values may be stored in a narrower type than the vectors.
+             */
+            template <typename DT_, typename MT_, typename IT_>
+            void csr_dv(DT_ * result, const DT_ * rhs, const IT_ * Ajd, const MT_ * Ax, const unsigned long * Ar, const DT_ * b,
+                    unsigned long blocksize, unsigned long row_start, unsigned long row_end)
+            {
+                typedef SparsePacket<DT_> P_;
+
+                for (unsigned long row(row_start) ; row < row_end ; ++row)
+                {
+                    const unsigned long end(Ar[row + 1]);
+                    const long base(IndexBase<IT_>::value(row));
+                    DT_ sum(0);
+
+                    if (blocksize != P_::width)
+                    {
+                        for (unsigned long i(Ar[row]) ; i < end ; ++i)
+                        {
+                            const DT_ * const tb(b + base + Ajd[i]);
+                            for (unsigned long blocki(0) ; blocki < blocksize ; ++blocki)
+                                sum += DT_(Ax[(i * blocksize) + blocki]) * tb[blocki];
+                        }
+                    }
+                    else
+                    {
+                        typename P_::Type sum_v(P_::zero());
+                        for (unsigned long i(Ar[row]) ; i < end ; ++i)
+                            sum_v = P_::add(P_::mul(P_::loadu(Ax + i * blocksize), P_::loadu(b + base + Ajd[i])), sum_v);
+                        sum = P_::sum(sum_v);
+                    }
+
+                    result[row] = rhs == 0 ? sum : rhs[row] - sum;
+                }
+            }
+        }
+
+        void product_smell_dv(float * result, const short * Ajd, const float * Ax, const unsigned long * Arl, const float * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads)
+        {
+            smell_dv(result, (const float *)0, Ajd, Ax, Arl, b, stride, row_start, row_end, threads);
+        }
+
+        void defect_smell_dv(float * result, const float * rhs, const short * Ajd, const float * Ax, const unsigned long * Arl, const float * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads)
+        {
+            smell_dv(result, rhs, Ajd, Ax, Arl, b, stride, row_start, row_end, threads);
+        }
+
+        void product_csr_dv(float * result, const short * Ajd, const float * Ax, const unsigned long * Ar, const float * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end)
+        {
+            csr_dv(result, (const float *)0, Ajd, Ax, Ar, b, blocksize, row_start, row_end);
+        }
+
+        void defect_csr_dv(float * result, const float * rhs, const short * Ajd, const float * Ax, const unsigned long * Ar, const float * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end)
+        {
+            csr_dv(result, rhs, Ajd, Ax, Ar, b, blocksize, row_start, row_end);
+        }
+
+        void product_smell_dv(double * result, const short * Ajd, const double * Ax, const unsigned long * Arl, const double * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads)
+        {
+            smell_dv(result, (const double *)0, Ajd, Ax, Arl, b, stride, row_start, row_end, threads);
+        }
+
+        void defect_smell_dv(double * result, const double * rhs, const short * Ajd, const double * Ax, const unsigned long * Arl, const double * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads)
+        {
+            smell_dv(result, rhs, Ajd, Ax, Arl, b, stride, row_start, row_end, threads);
+        }
+
+        void product_csr_dv(double * result, const short * Ajd, const double * Ax, const unsigned long * Ar, const double * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end)
+        {
+            csr_dv(result, (const double *)0, Ajd, Ax, Ar, b, blocksize, row_start, row_end);
+        }
+
+        void defect_csr_dv(double * result, const double * rhs, const short * Ajd, const double * Ax, const unsigned long * Ar, const double * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end)
+        {
+            csr_dv(result, rhs, Ajd, Ax, Ar, b, blocksize, row_start, row_end);
+        }
+
+        void product_smell_dv(float * result, const int * Ajd, const float * Ax, const unsigned long * Arl, const float * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads)
+        {
+            smell_dv(result, (const float *)0, Ajd, Ax, Arl, b, stride, row_start, row_end, threads);
+        }
+
+        void defect_smell_dv(float * result, const float * rhs, const int * Ajd, const float * Ax, const unsigned long * Arl, const float * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads)
+        {
+            smell_dv(result, rhs, Ajd, Ax, Arl, b, stride, row_start, row_end, threads);
+        }
+
+        void product_csr_dv(float * result, const int * Ajd, const float * Ax, const unsigned long * Ar, const float * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end)
+        {
+            csr_dv(result, (const float *)0, Ajd, Ax, Ar, b, blocksize, row_start, row_end);
+        }
+
+        void defect_csr_dv(float * result, const float * rhs, const int * Ajd, const float * Ax, const unsigned long * Ar, const float * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end)
+        {
+            csr_dv(result, rhs, Ajd, Ax, Ar, b, blocksize, row_start, row_end);
+        }
+
+        void product_smell_dv(double * result, const int * Ajd, const double * Ax, const unsigned long * Arl, const double * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads)
+        {
+            smell_dv(result, (const double *)0, Ajd, Ax, Arl, b, stride, row_start, row_end, threads);
+        }
+
+        void defect_smell_dv(double * result, const double * rhs, const int * Ajd, const double * Ax, const unsigned long * Arl, const double * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads)
+        {
+            smell_dv(result, rhs, Ajd, Ax, Arl, b, stride, row_start, row_end, threads);
+        }
+
+        void product_csr_dv(double * result, const int * Ajd, const double * Ax, const unsigned long * Ar, const double * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end)
+        {
+            csr_dv(result, (const double *)0, Ajd, Ax, Ar, b, blocksize, row_start, row_end);
+        }
+
+        void defect_csr_dv(double * result, const double * rhs, const int * Ajd, const double * Ax, const unsigned long * Ar, const double * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end)
+        {
+            csr_dv(result, rhs, Ajd, Ax, Ar, b, blocksize, row_start, row_end);
+        }
+
+        void product_smell_dv(double * result, const unsigned long * Aj, const float * Ax, const unsigned long * Arl, const double * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads)
+        {
+            smell_dv(result, (const double *)0, Aj, Ax, Arl, b, stride, row_start, row_end, threads);
+        }
+
+        void defect_smell_dv(double * result, const double * rhs, const unsigned long * Aj, const float * Ax, const unsigned long * Arl, const double * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads)
+        {
+            smell_dv(result, rhs, Aj, Ax, Arl, b, stride, row_start, row_end, threads);
+        }
+
+        void product_csr_dv(double * result, const unsigned long * Aj, const float * Ax, const unsigned long * Ar, const double * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end)
+        {
+            csr_dv(result, (const double *)0, Aj, Ax, Ar, b, blocksize, row_start, row_end);
+        }
+
+        void defect_csr_dv(double * result, const double * rhs, const unsigned long * Aj, const float * Ax, const unsigned long * Ar, const double * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end)
+        {
+            csr_dv(result, rhs, Aj, Ax, Ar, b, blocksize, row_start, row_end);
+        }
+
+        void product_smell_dv(double * result, const short * Aj, const float * Ax, const unsigned long * Arl, const double * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads)
+        {
+            smell_dv(result, (const double *)0, Aj, Ax, Arl, b, stride, row_start, row_end, threads);
+        }
+
+        void defect_smell_dv(double * result, const double * rhs, const short * Aj, const float * Ax, const unsigned long * Arl, const double * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads)
+        {
+            smell_dv(result, rhs, Aj, Ax, Arl, b, stride, row_start, row_end, threads);
+        }
+
+        void product_csr_dv(double * result, const short * Aj, const float * Ax, const unsigned long * Ar, const double * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end)
+        {
+            csr_dv(result, (const double *)0, Aj, Ax, Ar, b, blocksize, row_start, row_end);
+        }
+
+        void defect_csr_dv(double * result, const double * rhs, const short * Aj, const float * Ax, const unsigned long * Ar, const double * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end)
+        {
+            csr_dv(result, rhs, Aj, Ax, Ar, b, blocksize, row_start, row_end);
+        }
+
+        void product_smell_dv(double * result, const int * Aj, const float * Ax, const unsigned long * Arl, const double * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads)
+        {
+            smell_dv(result, (const double *)0, Aj, Ax, Arl, b, stride, row_start, row_end, threads);
+        }
+
+        void defect_smell_dv(double * result, const double * rhs, const int * Aj, const float * Ax, const unsigned long * Arl, const double * b,
+                unsigned long stride, unsigned long row_start, unsigned long row_end, unsigned long threads)
+        {
+            smell_dv(result, rhs, Aj, Ax, Arl, b, stride, row_start, row_end, threads);
+        }
+
+        void product_csr_dv(double * result, const int * Aj, const float * Ax, const unsigned long * Ar, const double * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end)
+        {
+            csr_dv(result, (const double *)0, Aj, Ax, Ar, b, blocksize, row_start, row_end);
+        }
+
+        void defect_csr_dv(double * result, const double * rhs, const int * Aj, const float * Ax, const unsigned long * Ar, const double * b,
+                unsigned long blocksize, unsigned long row_start, unsigned long row_end)
+        {
+            csr_dv(result, rhs, Aj, Ax, Ar, b, blocksize, row_start, row_end);
+        }
+    }
+}
@@ -0,0 +1,160 @@
+/* vim: set sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2011 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the HONEI C++ library. HONEI is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * HONEI is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <honei/backends/sse/operations.hh>
+#include <honei/util/attributes.hh>
+
+#include <xmmintrin.h>
+#include <emmintrin.h>
+
+namespace honei
+{
+    namespace sse
+    {
+        namespace
+        {
+            template <typename DT_> struct StencilPacket;
+
+            template <> struct StencilPacket<float>
+            {
+                typedef __m128 Type;
+                static const unsigned long width = 4;
+                static inline Type load(const float * x) { return _mm_loadu_ps(x); }
+                static inline void store(float * x, Type a) { _mm_storeu_ps(x, a); }
+                static inline Type set(float a) { return _mm_set1_ps(a); }
+                static inline Type add(Type a, Type b) { return _mm_add_ps(a, b); }
+                static inline Type sub(Type a, Type b) { return _mm_sub_ps(a, b); }
+                static inline Type mul(Type a, Type b) { return _mm_mul_ps(a, b); }
+            };
+
+            template <> struct StencilPacket<double>
+            {
+                typedef __m128d Type;
+                static const unsigned long width = 2;
+                static inline Type load(const double * x) { return _mm_loadu_pd(x); }
+                static inline void store(double * x, Type a) { _mm_storeu_pd(x, a); }
+                static inline Type set(double a) { return _mm_set1_pd(a); }
+                static inline Type add(Type a, Type b) { return _mm_add_pd(a, b); }
+                static inline Type sub(Type a, Type b) { return _mm_sub_pd(a, b); }
+                static inline Type mul(Type a, Type b) { return _mm_mul_pd(a, b); }
+            };
+
+            /**
+             * Applies the stencil to the inner grid points [begin, end) of one grid row.
+             * With rhs != 0 the defect rhs - A * b is computed instead of the product.
+             */
+            template <typename DT_, bool defect_>
+            inline void stencil_row(DT_ * result, const DT_ * rhs, const DT_ * s, const DT_ * b,
+                    unsigned long m, unsigned long begin, unsigned long end)
+            {
+                typedef StencilPacket<DT_> P_;
+                typedef typename P_::Type PT_;
+
+                const PT_ ll(P_::set(s[0])), ld(P_::set(s[1])), lu(P_::set(s[2]));
+                const PT_ dl(P_::set(s[3])), dd(P_::set(s[4])), du(P_::set(s[5]));
+                const PT_ ul(P_::set(s[6])), ud(P_::set(s[7])), uu(P_::set(s[8]));
+
+                const DT_ * bl(b - m);
+                const DT_ * bu(b + m);
+
+                unsigned long i(begin);
+                for ( ; i + P_::width <= end ; i += P_::width)
+                {
+                    PT_ sum(P_::mul(dd, P_::load(b + i)));
+                    sum = P_::add(sum, P_::mul(dl, P_::load(b + i - 1)));
+                    sum = P_::add(sum, P_::mul(du, P_::load(b + i + 1)));
+                    sum = P_::add(sum, P_::mul(ll, P_::load(bl + i - 1)));
+                    sum = P_::add(sum, P_::mul(ld, P_::load(bl + i)));
+                    sum = P_::add(sum, P_::mul(lu, P_::load(bl + i + 1)));
+                    sum = P_::add(sum, P_::mul(ul, P_::load(bu + i - 1)));
+                    sum = P_::add(sum, P_::mul(ud, P_::load(bu + i)));
+                    sum = P_::add(sum, P_::mul(uu, P_::load(bu + i + 1)));
+
+                    if (defect_)
+                        P_::store(result + i, P_::sub(P_::load(rhs + i), sum));
+                    else
+                        P_::store(result + i, sum);
+                }
+
+                for ( ; i < end ; ++i)
+                {
+                    DT_ sum(s[4] * b[i] + s[3] * b[i - 1] + s[5] * b[i + 1]
+                            + s[0] * bl[i - 1] + s[1] * bl[i] + s[2] * bl[i + 1]
+                            + s[6] * bu[i - 1] + s[7] * bu[i] + s[8] * bu[i + 1]);
+                    result[i] = defect_ ? rhs[i] - sum : sum;
+                }
+            }
+
+            template <typename DT_, bool defect_>
+            inline void stencil_q1(DT_ * result, const DT_ * rhs, const DT_ * s, const DT_ * b,
+                    unsigned long m, unsigned long row_start, unsigned long row_end)
+            {
+                for (unsigned long i(row_start) ; i < row_end ; )
+                {
+                    const unsigned long y(i / m);
+                    const unsigned long line_end((y + 1) * m < row_end ? (y + 1) * m : row_end);
+
+                    if (y != 0 && y != m - 1)
+                    {
+                        if (i % m == 0)
+                        {
+                            result[i] = defect_ ? rhs[i] - b[i] : b[i];
+                            ++i;
+                        }
+
+                        const unsigned long inner_end(y * m + m - 1 < line_end ? y * m + m - 1 : line_end);
+                        if (i < inner_end)
+                        {
+                            stencil_row<DT_, defect_>(result, rhs, s, b, m, i, inner_end);
+                            i = inner_end;
+                        }
+                    }
+
+                    // Dirichlet unit rows
+                    for ( ; i < line_end ; ++i)
+                        result[i] = defect_ ? rhs[i] - b[i] : b[i];
+                }
+            }
+        }
+
+        void product_smdv_q1(float * result, const float * stencil, const float * b,
+                unsigned long m, unsigned long row_start, unsigned long row_end)
+        {
+            stencil_q1<float, false>(result, 0, stencil, b, m, row_start, row_end);
+        }
+
+        void product_smdv_q1(double * result, const double * stencil, const double * b,
+                unsigned long m, unsigned long row_start, unsigned long row_end)
+        {
+            stencil_q1<double, false>(result, 0, stencil, b, m, row_start, row_end);
+        }
+
+        void defect_smdv_q1(float * result, const float * rhs, const float * stencil, const float * b,
+                unsigned long m, unsigned long row_start, unsigned long row_end)
+        {
+            stencil_q1<float, true>(result, rhs, stencil, b, m, row_start, row_end);
+        }
+
+        void defect_smdv_q1(double * result, const double * rhs, const double * stencil, const double * b,
+                unsigned long m, unsigned long row_start, unsigned long row_end)
+        {
+            stencil_q1<double, true>(result, rhs, stencil, b, m, row_start, row_end);
+        }
+    }
+}
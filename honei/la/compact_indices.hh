@@ -0,0 +1,90 @@
+/* vim: set sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2011 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ *
+ * This file is part of the HONEI C++ library. HONEI is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * HONEI is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#pragma once
+#ifndef LIBLA_GUARD_COMPACT_INDICES_HH
+#define LIBLA_GUARD_COMPACT_INDICES_HH 1
+
+#include <honei/la/dense_vector.hh>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+namespace honei
+{
+    namespace intern
+    {
+        /**
+         * \brief CompactIndices stores row relative column indices (column - row) in 16 or 32 bit.
+         *
+         * Banded FEM matrices keep their non zero entries close to the diagonal, so the offsets fit into
+         * far fewer bits than the absolute 64 bit column indices.
+         */
+        struct CompactIndices
+        {
+            /**
+             * Stores deltas in the narrowest of 16 and 32 bit that is allowed by max_width and fits all
+             * of them.
+             *
+             * \param deltas The row relative column indices.
+             * \param max_width The widest allowed width in bits; 0 disables compact indices.
+             * \param ajd16 Will hold the 16 bit indices if they are used.
+             * \param ajd32 Will hold the 32 bit indices if they are used.
+             *
+             * \retval The used width in bits, 0 if the deltas do not fit or compact indices are disabled.
+             */
+            static unsigned long value(const std::vector<long> & deltas, unsigned long max_width,
+                    DenseVector<short> & ajd16, DenseVector<int> & ajd32)
+            {
+                if (max_width == 0 || deltas.empty())
+                    return 0;
+
+                long min(0), max(0);
+                for (std::vector<long>::const_iterator i(deltas.begin()), i_end(deltas.end()) ; i != i_end ; ++i)
+                {
+                    min = std::min(min, *i);
+                    max = std::max(max, *i);
+                }
+
+                if (max_width <= 16 && min >= std::numeric_limits<short>::min() && max <= std::numeric_limits<short>::max())
+                {
+                    DenseVector<short> result(deltas.size());
+                    for (unsigned long i(0) ; i < deltas.size() ; ++i)
+                        result[i] = short(deltas[i]);
+                    ajd16 = result;
+                    return 16;
+                }
+
+                if (min >= std::numeric_limits<int>::min() && max <= std::numeric_limits<int>::max())
+                {
+                    DenseVector<int> result(deltas.size());
+                    for (unsigned long i(0) ; i < deltas.size() ; ++i)
+                        result[i] = int(deltas[i]);
+                    ajd32 = result;
+                    return 32;
+                }
+
+                return 0;
+            }
+        };
+    }
+}
+#endif
@@ -62,6 +62,22 @@ namespace honei
 
     template std::ostream & operator<< (std::ostream & lhs, const DenseVector<unsigned long> & vector);
 
+    template class ConstElementIterator<storage::Dense, container::Vector, int>;
+
+    template class DenseVector<int>;
+
+    template class ElementIterator<storage::Dense, container::Vector, int>;
+
+    template std::ostream & operator<< (std::ostream & lhs, const DenseVector<int> & vector);
+
+    template class ConstElementIterator<storage::Dense, container::Vector, short>;
+
+    template class DenseVector<short>;
+
+    template class ElementIterator<storage::Dense, container::Vector, short>;
+
+    template std::ostream & operator<< (std::ostream & lhs, const DenseVector<short> & vector);
+
     template class ConstElementIterator<storage::Dense, container::Vector, bool>;
 
     template class DenseVector<bool>;
@@ -248,6 +248,14 @@ namespace honei
 
     extern template std::ostream & operator<< (std::ostream & lhs, const DenseVector<unsigned long> & vector);
 
+    extern template class DenseVector<int>;
+
+    extern template std::ostream & operator<< (std::ostream & lhs, const DenseVector<int> & vector);
+
+    extern template class DenseVector<short>;
+
+    extern template std::ostream & operator<< (std::ostream & lhs, const DenseVector<short> & vector);
+
 #ifdef HONEI_GMP
     extern template class DenseVector<mpf_class>;
 
@@ -46,6 +46,14 @@ namespace honei
 
     template std::ostream & operator<< (std::ostream & lhs, const DenseVectorRange<unsigned long> & vector);
 
+    template class DenseVectorRange<int>;
+
+    template std::ostream & operator<< (std::ostream & lhs, const DenseVectorRange<int> & vector);
+
+    template class DenseVectorRange<short>;
+
+    template std::ostream & operator<< (std::ostream & lhs, const DenseVectorRange<short> & vector);
+
     template class DenseVectorRange<bool>;
 
     template bool operator== (const DenseVectorRange<bool> & a, const DenseVectorRange<bool> & b);
@@ -212,6 +212,14 @@ namespace honei
 
     extern template std::ostream & operator<< (std::ostream & lhs, const DenseVectorRange<unsigned long> & vector);
 
+    extern template class DenseVectorRange<int>;
+
+    extern template std::ostream & operator<< (std::ostream & lhs, const DenseVectorRange<int> & vector);
+
+    extern template class DenseVectorRange<short>;
+
+    extern template std::ostream & operator<< (std::ostream & lhs, const DenseVectorRange<short> & vector);
+
     extern template class DenseVectorRange<bool>;
 
     extern template bool operator== (const DenseVectorRange<bool> & a, const DenseVectorRange<bool> & b);
@@ -875,7 +875,7 @@ namespace honei
                     throw MatrixRowsDoNotMatch(b.rows(), a.rows());
                 }
 
-                return honei::ElementProduct<tags::CPU>::value(a, b);
+                return honei::ElementProduct<typename Tag_::DelegateTo>::value(a, b);
             }
 
             // Dummy
@@ -0,0 +1,766 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2011 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LA C++ library. LibLa is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LibLa is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#pragma once
+#ifndef LIBLA_GUARD_EXPRESSION_HH
+#define LIBLA_GUARD_EXPRESSION_HH 1
+
+#include <honei/la/dense_vector.hh>
+#include <honei/la/dense_vector_range.hh>
+#include <honei/la/vector_error.hh>
+#include <honei/util/attributes.hh>
+#include <honei/util/configuration.hh>
+#include <honei/util/partitioner.hh>
+#include <honei/util/profiler.hh>
+#include <honei/util/tags.hh>
+#include <honei/backends/multicore/thread_pool.hh>
+
+#include <honei/util/tr1_boost.hh>
+
+#include <vector>
+
+#if defined (HONEI_SSE)
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#endif
+
+/**
+ * \file
+ *
+ * Lazy evaluated BLAS-1 expressions over DenseVectorContinuousBase.
+ *
+ * An expression like
+ * \code
+ *   Evaluate<Tag_>::value(p, lazy(r) + beta * (lazy(p) - omega * lazy(v)));
+ * \endcode
+ * only builds a (stack allocated) expression tree. All operands are read and the result is
+ * written in one single loop over the vectors when the expression is handed to Evaluate<Tag_>.
+ * Evaluate can additionally compute a norm or dot product of the assigned values in the same pass.
+ *
+ * \ingroup grplaoperations
+ * \ingroup grplavectoroperations
+ */
+
+namespace honei
+{
+    namespace intern
+    {
+#if defined (HONEI_SSE)
+        template <typename DT_> struct Packet;
+
+        template <> struct Packet<float>
+        {
+            typedef __m128 Type;
+            static const unsigned long width = 4;
+
+            static inline Type load(const float * x) { return _mm_loadu_ps(x); }
+            static inline void store(float * x, Type a) { _mm_storeu_ps(x, a); }
+            static inline Type set(float a) { return _mm_set1_ps(a); }
+            static inline Type zero() { return _mm_setzero_ps(); }
+            static inline Type add(Type a, Type b) { return _mm_add_ps(a, b); }
+            static inline Type sub(Type a, Type b) { return _mm_sub_ps(a, b); }
+            static inline Type mul(Type a, Type b) { return _mm_mul_ps(a, b); }
+
+            static inline float sum(Type a)
+            {
+                float HONEI_ALIGNED(16) temp[4];
+                _mm_store_ps(temp, a);
+                return (temp[0] + temp[1]) + (temp[2] + temp[3]);
+            }
+        };
+
+        template <> struct Packet<double>
+        {
+            typedef __m128d Type;
+            static const unsigned long width = 2;
+
+            static inline Type load(const double * x) { return _mm_loadu_pd(x); }
+            static inline void store(double * x, Type a) { _mm_storeu_pd(x, a); }
+            static inline Type set(double a) { return _mm_set1_pd(a); }
+            static inline Type zero() { return _mm_setzero_pd(); }
+            static inline Type add(Type a, Type b) { return _mm_add_pd(a, b); }
+            static inline Type sub(Type a, Type b) { return _mm_sub_pd(a, b); }
+            static inline Type mul(Type a, Type b) { return _mm_mul_pd(a, b); }
+
+            static inline double sum(Type a)
+            {
+                double HONEI_ALIGNED(16) temp[2];
+                _mm_store_pd(temp, a);
+                return temp[0] + temp[1];
+            }
+        };
+#endif
+
+        /// Elementwise binary operations used inside expression trees.
+        struct ExpressionSum
+        {
+            template <typename DT_> static inline DT_ apply(DT_ a, DT_ b) { return a + b; }
+#if defined (HONEI_SSE)
+            template <typename DT_> static inline typename Packet<DT_>::Type apply_packet(typename Packet<DT_>::Type a, typename Packet<DT_>::Type b)
+            {
+                return Packet<DT_>::add(a, b);
+            }
+#endif
+        };
+
+        struct ExpressionDifference
+        {
+            template <typename DT_> static inline DT_ apply(DT_ a, DT_ b) { return a - b; }
+#if defined (HONEI_SSE)
+            template <typename DT_> static inline typename Packet<DT_>::Type apply_packet(typename Packet<DT_>::Type a, typename Packet<DT_>::Type b)
+            {
+                return Packet<DT_>::sub(a, b);
+            }
+#endif
+        };
+
+        struct ExpressionElementProduct
+        {
+            template <typename DT_> static inline DT_ apply(DT_ a, DT_ b) { return a * b; }
+#if defined (HONEI_SSE)
+            template <typename DT_> static inline typename Packet<DT_>::Type apply_packet(typename Packet<DT_>::Type a, typename Packet<DT_>::Type b)
+            {
+                return Packet<DT_>::mul(a, b);
+            }
+#endif
+        };
+
+        /// Leaf of an expression tree, referencing the elements of a dense vector.
+        template <typename DT_> class ExpressionTerminal
+        {
+            private:
+                const DT_ * _elements;
+                unsigned long _size;
+
+            public:
+                typedef DT_ DataType;
+
+                ExpressionTerminal(const DenseVectorContinuousBase<DT_> & x) :
+                    _elements(x.elements()),
+                    _size(x.size())
+                {
+                }
+
+                unsigned long size() const
+                {
+                    return _size;
+                }
+
+                DT_ operator[] (unsigned long i) const
+                {
+                    return _elements[i];
+                }
+
+#if defined (HONEI_SSE)
+                typename Packet<DT_>::Type packet(unsigned long i) const
+                {
+                    return Packet<DT_>::load(_elements + i);
+                }
+#endif
+        };
+
+        /// Expression scaled by a scalar.
+        template <typename E_> class ExpressionScaled
+        {
+            public:
+                typedef typename E_::DataType DataType;
+
+            private:
+                DataType _a;
+                E_ _e;
+
+            public:
+                ExpressionScaled(DataType a, const E_ & e) :
+                    _a(a),
+                    _e(e)
+                {
+                }
+
+                unsigned long size() const
+                {
+                    return _e.size();
+                }
+
+                DataType operator[] (unsigned long i) const
+                {
+                    return _a * _e[i];
+                }
+
+#if defined (HONEI_SSE)
+                typename Packet<DataType>::Type packet(unsigned long i) const
+                {
+                    return Packet<DataType>::mul(Packet<DataType>::set(_a), _e.packet(i));
+                }
+#endif
+        };
+
+        /// Elementwise combination of two expressions.
+        template <typename L_, typename R_, typename Op_> class ExpressionBinary
+        {
+            public:
+                typedef typename L_::DataType DataType;
+
+            private:
+                L_ _l;
+                R_ _r;
+
+            public:
+                ExpressionBinary(const L_ & l, const R_ & r) :
+                    _l(l),
+                    _r(r)
+                {
+                    if (l.size() != r.size())
+                        throw VectorSizeDoesNotMatch(r.size(), l.size());
+                }
+
+                unsigned long size() const
+                {
+                    return _l.size();
+                }
+
+                DataType operator[] (unsigned long i) const
+                {
+                    return Op_::template apply<DataType>(_l[i], _r[i]);
+                }
+
+#if defined (HONEI_SSE)
+                typename Packet<DataType>::Type packet(unsigned long i) const
+                {
+                    return Op_::template apply_packet<DataType>(_l.packet(i), _r.packet(i));
+                }
+#endif
+        };
+    }
+
+    /**
+     * \brief Lazy evaluated vector expression.
+     *
+     * VectorExpression wraps the nodes of an expression tree so that the arithmetic operators
+     * only apply to expressions. Use lazy() to turn a dense vector into an expression.
+     */
+    template <typename E_> class VectorExpression
+    {
+        private:
+            E_ _e;
+
+        public:
+            typedef typename E_::DataType DataType;
+
+            explicit VectorExpression(const E_ & e) :
+                _e(e)
+            {
+            }
+
+            unsigned long size() const
+            {
+                return _e.size();
+            }
+
+            DataType operator[] (unsigned long i) const
+            {
+                return _e[i];
+            }
+
+#if defined (HONEI_SSE)
+            typename intern::Packet<DataType>::Type packet(unsigned long i) const
+            {
+                return _e.packet(i);
+            }
+#endif
+
+            const E_ & expression() const
+            {
+                return _e;
+            }
+    };
+
+    /// Returns an expression referencing the elements of x.
+    template <typename DT_>
+    inline VectorExpression<intern::ExpressionTerminal<DT_> > lazy(const DenseVectorContinuousBase<DT_> & x)
+    {
+        return VectorExpression<intern::ExpressionTerminal<DT_> >(intern::ExpressionTerminal<DT_>(x));
+    }
+
+    template <typename L_, typename R_>
+    inline VectorExpression<intern::ExpressionBinary<L_, R_, intern::ExpressionSum> >
+    operator+ (const VectorExpression<L_> & l, const VectorExpression<R_> & r)
+    {
+        return VectorExpression<intern::ExpressionBinary<L_, R_, intern::ExpressionSum> >(
+                intern::ExpressionBinary<L_, R_, intern::ExpressionSum>(l.expression(), r.expression()));
+    }
+
+    template <typename L_, typename R_>
+    inline VectorExpression<intern::ExpressionBinary<L_, R_, intern::ExpressionDifference> >
+    operator- (const VectorExpression<L_> & l, const VectorExpression<R_> & r)
+    {
+        return VectorExpression<intern::ExpressionBinary<L_, R_, intern::ExpressionDifference> >(
+                intern::ExpressionBinary<L_, R_, intern::ExpressionDifference>(l.expression(), r.expression()));
+    }
+
+    /// Elementwise product of two expressions.
+    template <typename L_, typename R_>
+    inline VectorExpression<intern::ExpressionBinary<L_, R_, intern::ExpressionElementProduct> >
+    operator* (const VectorExpression<L_> & l, const VectorExpression<R_> & r)
+    {
+        return VectorExpression<intern::ExpressionBinary<L_, R_, intern::ExpressionElementProduct> >(
+                intern::ExpressionBinary<L_, R_, intern::ExpressionElementProduct>(l.expression(), r.expression()));
+    }
+
+    template <typename E_>
+    inline VectorExpression<intern::ExpressionScaled<E_> >
+    operator* (typename E_::DataType a, const VectorExpression<E_> & e)
+    {
+        return VectorExpression<intern::ExpressionScaled<E_> >(intern::ExpressionScaled<E_>(a, e.expression()));
+    }
+
+    template <typename E_>
+    inline VectorExpression<intern::ExpressionScaled<E_> >
+    operator* (const VectorExpression<E_> & e, typename E_::DataType a)
+    {
+        return VectorExpression<intern::ExpressionScaled<E_> >(intern::ExpressionScaled<E_>(a, e.expression()));
+    }
+
+    namespace intern
+    {
+        /**
+         * Single threaded evaluation kernels, working on the index range [begin, end).
+         *
+         * Reductions are stored in the result pointers so that the kernels can be enqueued
+         * into the thread pool directly.
+         */
+        template <typename Tag_> struct ExpressionKernel;
+
+        template <> struct ExpressionKernel<tags::CPU>
+        {
+            template <typename DT_, typename E_>
+            static void value(DT_ * x, const VectorExpression<E_> & e, unsigned long begin, unsigned long end)
+            {
+                for (unsigned long i(begin) ; i < end ; ++i)
+                    x[i] = e[i];
+            }
+
+            template <typename DT_, typename E_>
+            static void norm_l2_false(DT_ * x, const VectorExpression<E_> & e, unsigned long begin, unsigned long end, DT_ * result)
+            {
+                DT_ norm(0);
+                for (unsigned long i(begin) ; i < end ; ++i)
+                {
+                    const DT_ t(e[i]);
+                    x[i] = t;
+                    norm += t * t;
+                }
+                *result = norm;
+            }
+
+            template <typename DT_, typename E_, typename F_>
+            static void dot_product(DT_ * x, const VectorExpression<E_> & e, const VectorExpression<F_> & y,
+                    unsigned long begin, unsigned long end, DT_ * result)
+            {
+                DT_ dot(0);
+                for (unsigned long i(begin) ; i < end ; ++i)
+                {
+                    const DT_ t(e[i]);
+                    x[i] = t;
+                    dot += t * y[i];
+                }
+                *result = dot;
+            }
+
+            template <typename DT_, typename E_, typename F_, typename G_, typename H_>
+            static void dot_products(const VectorExpression<E_> & a, const VectorExpression<F_> & b,
+                    const VectorExpression<G_> & c, const VectorExpression<H_> & d,
+                    unsigned long begin, unsigned long end, DT_ * result)
+            {
+                DT_ ab(0), cd(0);
+                for (unsigned long i(begin) ; i < end ; ++i)
+                {
+                    ab += a[i] * b[i];
+                    cd += c[i] * d[i];
+                }
+                result[0] = ab;
+                result[1] = cd;
+            }
+        };
+
+        template <> struct ExpressionKernel<tags::CPU::Generic> :
+            public ExpressionKernel<tags::CPU>
+        {
+        };
+
+#if defined (HONEI_SSE)
+        template <> struct ExpressionKernel<tags::CPU::SSE>
+        {
+            template <typename DT_, typename E_>
+            static void value(DT_ * x, const VectorExpression<E_> & e, unsigned long begin, unsigned long end)
+            {
+                const unsigned long width(Packet<DT_>::width);
+                unsigned long i(begin);
+                for ( ; i + 2 * width <= end ; i += 2 * width)
+                {
+                    Packet<DT_>::store(x + i, e.packet(i));
+                    Packet<DT_>::store(x + i + width, e.packet(i + width));
+                }
+                for ( ; i < end ; ++i)
+                    x[i] = e[i];
+            }
+
+            template <typename DT_, typename E_>
+            static void norm_l2_false(DT_ * x, const VectorExpression<E_> & e, unsigned long begin, unsigned long end, DT_ * result)
+            {
+                typedef typename Packet<DT_>::Type PT_;
+                const unsigned long width(Packet<DT_>::width);
+                PT_ n1(Packet<DT_>::zero()), n2(Packet<DT_>::zero());
+                unsigned long i(begin);
+                for ( ; i + 2 * width <= end ; i += 2 * width)
+                {
+                    PT_ t1(e.packet(i));
+                    PT_ t2(e.packet(i + width));
+                    Packet<DT_>::store(x + i, t1);
+                    Packet<DT_>::store(x + i + width, t2);
+                    n1 = Packet<DT_>::add(n1, Packet<DT_>::mul(t1, t1));
+                    n2 = Packet<DT_>::add(n2, Packet<DT_>::mul(t2, t2));
+                }
+                DT_ norm(Packet<DT_>::sum(Packet<DT_>::add(n1, n2)));
+                for ( ; i < end ; ++i)
+                {
+                    const DT_ t(e[i]);
+                    x[i] = t;
+                    norm += t * t;
+                }
+                *result = norm;
+            }
+
+            template <typename DT_, typename E_, typename F_>
+            static void dot_product(DT_ * x, const VectorExpression<E_> & e, const VectorExpression<F_> & y,
+                    unsigned long begin, unsigned long end, DT_ * result)
+            {
+                typedef typename Packet<DT_>::Type PT_;
+                const unsigned long width(Packet<DT_>::width);
+                PT_ d1(Packet<DT_>::zero()), d2(Packet<DT_>::zero());
+                unsigned long i(begin);
+                for ( ; i + 2 * width <= end ; i += 2 * width)
+                {
+                    PT_ t1(e.packet(i));
+                    PT_ t2(e.packet(i + width));
+                    Packet<DT_>::store(x + i, t1);
+                    Packet<DT_>::store(x + i + width, t2);
+                    d1 = Packet<DT_>::add(d1, Packet<DT_>::mul(t1, y.packet(i)));
+                    d2 = Packet<DT_>::add(d2, Packet<DT_>::mul(t2, y.packet(i + width)));
+                }
+                DT_ dot(Packet<DT_>::sum(Packet<DT_>::add(d1, d2)));
+                for ( ; i < end ; ++i)
+                {
+                    const DT_ t(e[i]);
+                    x[i] = t;
+                    dot += t * y[i];
+                }
+                *result = dot;
+            }
+
+            template <typename DT_, typename E_, typename F_, typename G_, typename H_>
+            static void dot_products(const VectorExpression<E_> & a, const VectorExpression<F_> & b,
+                    const VectorExpression<G_> & c, const VectorExpression<H_> & d,
+                    unsigned long begin, unsigned long end, DT_ * result)
+            {
+                typedef typename Packet<DT_>::Type PT_;
+                const unsigned long width(Packet<DT_>::width);
+                PT_ ab(Packet<DT_>::zero()), cd(Packet<DT_>::zero());
+                unsigned long i(begin);
+                for ( ; i + width <= end ; i += width)
+                {
+                    ab = Packet<DT_>::add(ab, Packet<DT_>::mul(a.packet(i), b.packet(i)));
+                    cd = Packet<DT_>::add(cd, Packet<DT_>::mul(c.packet(i), d.packet(i)));
+                }
+                result[0] = Packet<DT_>::sum(ab);
+                result[1] = Packet<DT_>::sum(cd);
+                for ( ; i < end ; ++i)
+                {
+                    result[0] += a[i] * b[i];
+                    result[1] += c[i] * d[i];
+                }
+            }
+        };
+#endif
+    }
+
+    /**
+     * \brief Evaluation of lazy vector expressions.
+     *
+     * Evaluate is the class template for the operation
+     * \f[
+     *     \texttt{Evaluate}(x, e): \quad x \leftarrow e,
+     * \f]
+     * which computes all elements of the expression e in one single pass and stores them in x.
+     * The additional members compute a reduction of the assigned values in the same pass.
+     *
+     * \ingroup grplaoperations
+     * \ingroup grplavectoroperations
+     */
+    template <typename Tag_> struct Evaluate
+    {
+        /**
+         * Assigns an expression to a vector.
+         *
+         * \param x The vector that shall receive the values of e.
+         * \param e The expression that shall be evaluated. e may reference x.
+         *
+         * \exception VectorSizeDoesNotMatch is thrown if x and e don't have the same size.
+         */
+        template <typename DT_, typename E_>
+        static DenseVectorContinuousBase<DT_> & value(DenseVectorContinuousBase<DT_> & x, const VectorExpression<E_> & e)
+        {
+            CONTEXT("When evaluating expression (DenseVectorContinuousBase):");
+            PROFILER_START("Evaluate DVCB " + Tag_::name);
+
+            if (x.size() != e.size())
+                throw VectorSizeDoesNotMatch(e.size(), x.size());
+
+            intern::ExpressionKernel<Tag_>::value(x.elements(), e, 0, x.size());
+
+            PROFILER_STOP("Evaluate DVCB " + Tag_::name);
+            return x;
+        }
+
+        /**
+         * Assigns an expression to a vector and returns the squared L2 norm of the result,
+         * see Norm<vnt_l_two, false>.
+         */
+        template <typename DT_, typename E_>
+        static DT_ norm_l2_false(DenseVectorContinuousBase<DT_> & x, const VectorExpression<E_> & e)
+        {
+            CONTEXT("When evaluating expression and norm (DenseVectorContinuousBase):");
+            PROFILER_START("Evaluate DVCB norm " + Tag_::name);
+
+            if (x.size() != e.size())
+                throw VectorSizeDoesNotMatch(e.size(), x.size());
+
+            DT_ result(0);
+            intern::ExpressionKernel<Tag_>::norm_l2_false(x.elements(), e, 0, x.size(), &result);
+
+            PROFILER_STOP("Evaluate DVCB norm " + Tag_::name);
+            return result;
+        }
+
+        /**
+         * Assigns an expression to a vector and returns the dot product of the result with y.
+         */
+        template <typename DT_, typename E_, typename F_>
+        static DT_ dot_product(DenseVectorContinuousBase<DT_> & x, const VectorExpression<E_> & e, const VectorExpression<F_> & y)
+        {
+            CONTEXT("When evaluating expression and dot product (DenseVectorContinuousBase):");
+            PROFILER_START("Evaluate DVCB dot " + Tag_::name);
+
+            if (x.size() != e.size())
+                throw VectorSizeDoesNotMatch(e.size(), x.size());
+            if (x.size() != y.size())
+                throw VectorSizeDoesNotMatch(y.size(), x.size());
+
+            DT_ result(0);
+            intern::ExpressionKernel<Tag_>::dot_product(x.elements(), e, y, 0, x.size(), &result);
+
+            PROFILER_STOP("Evaluate DVCB dot " + Tag_::name);
+            return result;
+        }
+
+        /**
+         * Computes the dot products a * b and c * d in one pass.
+         */
+        template <typename DT_, typename E_, typename F_, typename G_, typename H_>
+        static void dot_products(const VectorExpression<E_> & a, const VectorExpression<F_> & b,
+                const VectorExpression<G_> & c, const VectorExpression<H_> & d, DT_ & ab, DT_ & cd)
+        {
+            CONTEXT("When evaluating two dot products (DenseVectorContinuousBase):");
+
+            if (a.size() != b.size())
+                throw VectorSizeDoesNotMatch(b.size(), a.size());
+            if (a.size() != c.size())
+                throw VectorSizeDoesNotMatch(c.size(), a.size());
+            if (a.size() != d.size())
+                throw VectorSizeDoesNotMatch(d.size(), a.size());
+
+            DT_ result[2];
+            intern::ExpressionKernel<Tag_>::dot_products(a, b, c, d, 0, a.size(), result);
+            ab = result[0];
+            cd = result[1];
+        }
+    };
+
+    namespace mc
+    {
+        /**
+         * Multicore evaluation of lazy vector expressions. The index range is split by the
+         * partitioner and every part is evaluated by the kernel of Tag_::DelegateTo.
+         */
+        template <typename Tag_> struct Evaluate
+        {
+            private:
+                typedef intern::ExpressionKernel<typename Tag_::DelegateTo> Kernel;
+
+                static void _partition(unsigned long size, PartitionList & partitions)
+                {
+                    unsigned long min_part_size(Configuration::instance()->get_value("mc::Evaluate::min_part_size", 1024));
+                    unsigned long max_count(Configuration::instance()->get_value("mc::Evaluate::max_count",
+                                mc::ThreadPool::instance()->num_threads()));
+
+                    Partitioner<tags::CPU::MultiCore> partitioner(max_count, min_part_size, 16, size, PartitionList::Filler(partitions));
+                }
+
+            public:
+                template <typename DT_, typename E_>
+                static DenseVectorContinuousBase<DT_> & value(DenseVectorContinuousBase<DT_> & x, const VectorExpression<E_> & e)
+                {
+                    CONTEXT("When evaluating expression (DenseVectorContinuousBase) using backend : " + Tag_::name);
+
+                    if (x.size() != e.size())
+                        throw VectorSizeDoesNotMatch(e.size(), x.size());
+
+                    PartitionList partitions;
+                    _partition(x.size(), partitions);
+
+                    TicketVector tickets;
+                    PartitionList::ConstIterator p(partitions.begin());
+                    for (PartitionList::ConstIterator p_last(partitions.last()) ; p != p_last ; ++p)
+                    {
+                        tickets.push_back(mc::ThreadPool::instance()->enqueue(
+                                    bind(&Kernel::template value<DT_, E_>, x.elements(), e, p->start, p->start + p->size)));
+                    }
+                    Kernel::value(x.elements(), e, p->start, p->start + p->size);
+                    tickets.wait();
+
+                    return x;
+                }
+
+                template <typename DT_, typename E_>
+                static DT_ norm_l2_false(DenseVectorContinuousBase<DT_> & x, const VectorExpression<E_> & e)
+                {
+                    CONTEXT("When evaluating expression and norm (DenseVectorContinuousBase) using backend : " + Tag_::name);
+
+                    if (x.size() != e.size())
+                        throw VectorSizeDoesNotMatch(e.size(), x.size());
+
+                    PartitionList partitions;
+                    _partition(x.size(), partitions);
+                    std::vector<DT_> partial(partitions.size(), DT_(0));
+
+                    TicketVector tickets;
+                    unsigned long i(0);
+                    PartitionList::ConstIterator p(partitions.begin());
+                    for (PartitionList::ConstIterator p_last(partitions.last()) ; p != p_last ; ++p, ++i)
+                    {
+                        tickets.push_back(mc::ThreadPool::instance()->enqueue(
+                                    bind(&Kernel::template norm_l2_false<DT_, E_>, x.elements(), e, p->start, p->start + p->size, &partial[i])));
+                    }
+                    Kernel::norm_l2_false(x.elements(), e, p->start, p->start + p->size, &partial[i]);
+                    tickets.wait();
+
+                    DT_ result(0);
+                    for (i = 0 ; i < partial.size() ; ++i)
+                        result += partial[i];
+                    return result;
+                }
+
+                template <typename DT_, typename E_, typename F_>
+                static DT_ dot_product(DenseVectorContinuousBase<DT_> & x, const VectorExpression<E_> & e, const VectorExpression<F_> & y)
+                {
+                    CONTEXT("When evaluating expression and dot product (DenseVectorContinuousBase) using backend : " + Tag_::name);
+
+                    if (x.size() != e.size())
+                        throw VectorSizeDoesNotMatch(e.size(), x.size());
+                    if (x.size() != y.size())
+                        throw VectorSizeDoesNotMatch(y.size(), x.size());
+
+                    PartitionList partitions;
+                    _partition(x.size(), partitions);
+                    std::vector<DT_> partial(partitions.size(), DT_(0));
+
+                    TicketVector tickets;
+                    unsigned long i(0);
+                    PartitionList::ConstIterator p(partitions.begin());
+                    for (PartitionList::ConstIterator p_last(partitions.last()) ; p != p_last ; ++p, ++i)
+                    {
+                        tickets.push_back(mc::ThreadPool::instance()->enqueue(
+                                    bind(&Kernel::template dot_product<DT_, E_, F_>, x.elements(), e, y, p->start, p->start + p->size, &partial[i])));
+                    }
+                    Kernel::dot_product(x.elements(), e, y, p->start, p->start + p->size, &partial[i]);
+                    tickets.wait();
+
+                    DT_ result(0);
+                    for (i = 0 ; i < partial.size() ; ++i)
+                        result += partial[i];
+                    return result;
+                }
+
+                template <typename DT_, typename E_, typename F_, typename G_, typename H_>
+                static void dot_products(const VectorExpression<E_> & a, const VectorExpression<F_> & b,
+                        const VectorExpression<G_> & c, const VectorExpression<H_> & d, DT_ & ab, DT_ & cd)
+                {
+                    CONTEXT("When evaluating two dot products (DenseVectorContinuousBase) using backend : " + Tag_::name);
+
+                    if (a.size() != b.size())
+                        throw VectorSizeDoesNotMatch(b.size(), a.size());
+                    if (a.size() != c.size())
+                        throw VectorSizeDoesNotMatch(c.size(), a.size());
+                    if (a.size() != d.size())
+                        throw VectorSizeDoesNotMatch(d.size(), a.size());
+
+                    PartitionList partitions;
+                    _partition(a.size(), partitions);
+                    std::vector<DT_> partial(2 * partitions.size(), DT_(0));
+
+                    TicketVector tickets;
+                    unsigned long i(0);
+                    PartitionList::ConstIterator p(partitions.begin());
+                    for (PartitionList::ConstIterator p_last(partitions.last()) ; p != p_last ; ++p, i += 2)
+                    {
+                        tickets.push_back(mc::ThreadPool::instance()->enqueue(
+                                    bind(&Kernel::template dot_products<DT_, E_, F_, G_, H_>, a, b, c, d, p->start, p->start + p->size, &partial[i])));
+                    }
+                    Kernel::dot_products(a, b, c, d, p->start, p->start + p->size, &partial[i]);
+                    tickets.wait();
+
+                    ab = DT_(0);
+                    cd = DT_(0);
+                    for (i = 0 ; i < partial.size() ; i += 2)
+                    {
+                        ab += partial[i];
+                        cd += partial[i + 1];
+                    }
+                }
+        };
+    }
+
+    template <> struct Evaluate<tags::CPU::MultiCore> :
+        public mc::Evaluate<tags::CPU::MultiCore>
+    {
+    };
+
+    template <> struct Evaluate<tags::CPU::MultiCore::Generic> :
+        public mc::Evaluate<tags::CPU::MultiCore::Generic>
+    {
+    };
+
+#if defined (HONEI_SSE)
+    template <> struct Evaluate<tags::CPU::MultiCore::SSE> :
+        public mc::Evaluate<tags::CPU::MultiCore::SSE>
+    {
+    };
+#endif
+}
+
+#endif
@@ -0,0 +1,100 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2011 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LA C++ library. LibLa is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LibLa is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <honei/la/expression.hh>
+#include <honei/la/dense_vector.hh>
+#include <honei/la/dot_product.hh>
+#include <honei/la/norm.hh>
+#include <honei/util/unittest.hh>
+
+#include <cmath>
+#include <limits>
+
+using namespace honei;
+using namespace tests;
+
+template <typename Tag_, typename DataType_>
+class ExpressionTest :
+    public QuickTest
+{
+    public:
+        ExpressionTest(const std::string & type) :
+            QuickTest("expression_quick_test<" + type + ">")
+        {
+            register_tag(Tag_::name);
+        }
+
+        virtual void run() const
+        {
+            for (unsigned long size(1) ; size < (1 << 14) ; size = 3 * size + 1)
+            {
+                DenseVector<DataType_> r(size), p(size), v(size), x(size);
+                for (unsigned long i(0) ; i < size ; ++i)
+                {
+                    r[i] = DataType_(i % 7) / DataType_(3);
+                    p[i] = DataType_(1) - DataType_(i % 5) / DataType_(4);
+                    v[i] = DataType_(i % 11) / DataType_(10);
+                }
+                DataType_ alpha(0.5), beta(-1.25);
+
+                DenseVector<DataType_> ref(size);
+                for (unsigned long i(0) ; i < size ; ++i)
+                    ref[i] = r[i] + beta * (p[i] - alpha * v[i]);
+
+                Evaluate<Tag_>::value(x, lazy(r) + beta * (lazy(p) - alpha * lazy(v)));
+                for (unsigned long i(0) ; i < size ; ++i)
+                    TEST_CHECK_EQUAL_WITHIN_EPS(x[i], ref[i], std::numeric_limits<DataType_>::epsilon() * 10);
+
+                // aliasing: the result is one of the operands
+                DenseVector<DataType_> y(p.copy());
+                Evaluate<Tag_>::value(y, lazy(r) + beta * (lazy(y) - alpha * lazy(v)));
+                for (unsigned long i(0) ; i < size ; ++i)
+                    TEST_CHECK_EQUAL_WITHIN_EPS(y[i], ref[i], std::numeric_limits<DataType_>::epsilon() * 10);
+
+                DataType_ eps(std::numeric_limits<DataType_>::epsilon() * 10 * size);
+                DataType_ norm(Evaluate<Tag_>::norm_l2_false(x, lazy(r) - alpha * lazy(v)));
+                DataType_ norm_ref(Norm<vnt_l_two, false, tags::CPU>::value(x));
+                TEST_CHECK_EQUAL_WITHIN_EPS(norm, norm_ref, eps * norm_ref);
+
+                DataType_ dot(Evaluate<Tag_>::dot_product(x, lazy(p) * lazy(v), lazy(r)));
+                DataType_ dot_ref(DotProduct<tags::CPU>::value(x, r));
+                TEST_CHECK_EQUAL_WITHIN_EPS(dot, dot_ref, eps * (std::abs(dot_ref) + 1));
+
+                DataType_ pp, pv;
+                Evaluate<Tag_>::dot_products(lazy(p), lazy(p), lazy(p), lazy(v), pp, pv);
+                TEST_CHECK_EQUAL_WITHIN_EPS(pp, DotProduct<tags::CPU>::value(p, p), eps * (pp + 1));
+                TEST_CHECK_EQUAL_WITHIN_EPS(pv, DotProduct<tags::CPU>::value(p, v), eps * (std::abs(pv) + 1));
+            }
+
+            DenseVector<DataType_> dv00(1, DataType_(1));
+            DenseVector<DataType_> dv01(2, DataType_(1));
+            TEST_CHECK_THROWS(Evaluate<Tag_>::value(dv00, lazy(dv01) + lazy(dv01)), VectorSizeDoesNotMatch);
+            TEST_CHECK_THROWS(Evaluate<Tag_>::value(dv00, lazy(dv00) + lazy(dv01)), VectorSizeDoesNotMatch);
+        }
+};
+ExpressionTest<tags::CPU, float> expression_test_float("float");
+ExpressionTest<tags::CPU, double> expression_test_double("double");
+ExpressionTest<tags::CPU::MultiCore, float> mc_expression_test_float("MC float");
+ExpressionTest<tags::CPU::MultiCore, double> mc_expression_test_double("MC double");
+#ifdef HONEI_SSE
+ExpressionTest<tags::CPU::SSE, float> sse_expression_test_float("SSE float");
+ExpressionTest<tags::CPU::SSE, double> sse_expression_test_double("SSE double");
+ExpressionTest<tags::CPU::MultiCore::SSE, float> mc_sse_expression_test_float("MC SSE float");
+ExpressionTest<tags::CPU::MultiCore::SSE, double> mc_sse_expression_test_double("MC SSE double");
+#endif
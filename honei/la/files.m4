@@ -14,6 +14,7 @@ add(`band_iterator',                 `hh')
 add(`band_type',                     `hh')
 add(`banded_matrix',                 `fwd', `hh', `impl', `cc', `test')
 add(`banded_matrix_qx',              `hh', `impl', `cc', `test')
+add(`compact_indices',               `hh')
 add(`const_vector',                  `fwd', `hh', `cc', `impl', `test')
 add(`dense_matrix',                  `fwd', `hh', `impl', `cc', `test')
 add(`dense_matrix_tile',             `fwd', `hh', `cc', `test')
@@ -26,6 +27,7 @@ add(`dot_product',                   `hh', `sse', `cell', `cuda', `opencl', `tes
 add(`element_inverse',               `hh', `sse', `cell', `cuda', `test')
 add(`element_iterator',              `hh', `test')
 add(`element_product',               `hh', `sse', `cell', `cuda', `opencl', `test')
+add(`expression',                    `hh', `test')
 add(`matrix_error',                  `hh', `cc')
 add(`norm',                          `hh', `fwd', `sse', `cell', `cuda', `opencl', `test')
 add(`product',                       `hh', `sse', `cell', `cuda', `opencl', `test')
@@ -34,9 +36,12 @@ add(`residual',                      `hh', `test')
 add(`scale',                         `hh', `sse', `cell', `cuda', `opencl', `test')
 add(`scaled_sum',                    `hh', `sse', `cell', `cuda', `opencl', `itanium', `test')
 add(`sparse_matrix',                 `fwd', `hh', `cc', `test')
+add(`sparse_matrix_bsr',             `hh', `test')
 add(`sparse_matrix_csr',             `hh', `impl', `cc', `test')
+add(`sparse_matrix_csr_symmetric',   `hh', `test')
 add(`sparse_matrix_ell',             `hh', `impl', `cc', `test')
 add(`sparse_vector',                 `fwd', `hh', `impl', `cc', `test')
+add(`stencil_matrix_q1',             `hh', `test')
 add(`sum',                           `hh', `sse', `cell', `cuda', `opencl', `test')
 add(`trace',                         `hh', `test')
 add(`vector_iterator',               `test')
@@ -21,8 +21,11 @@
 #include <honei/la/product.hh>
 #include <honei/backends/sse/operations.hh>
 #include <honei/la/dense_matrix_tile.hh>
+#include <honei/util/configuration.hh>
 #include <honei/util/profiler.hh>
 
+#include <algorithm>
+
 namespace honei
 {
     namespace sse
@@ -142,6 +145,33 @@ namespace honei
                 }
             }
         }
+
+        /**
+         * Adds the rows [row_start, row_end) of a * b to result, using the packed panel kernel with the
+         * block sizes from the sse::Product(DM,DM)::{mc,kc,nc} configuration keys.
+         */
+        template <typename DT_>
+        void packed_dm_product(DenseMatrix<DT_> & result, const DenseMatrix<DT_> & a, const DenseMatrix<DT_> & b,
+                unsigned long row_start, unsigned long row_end)
+        {
+            if (row_end <= row_start || b.columns() == 0 || a.columns() == 0)
+                return;
+
+            const unsigned long rows(row_end - row_start);
+            unsigned long mc(Configuration::instance()->get_value("sse::Product(DM,DM)::mc", 96));
+            unsigned long kc(Configuration::instance()->get_value("sse::Product(DM,DM)::kc", 256));
+            unsigned long nc(Configuration::instance()->get_value("sse::Product(DM,DM)::nc", 2048));
+            mc = std::max(1ul, std::min(mc, rows));
+            kc = std::max(1ul, std::min(kc, a.columns()));
+            nc = std::max(1ul, std::min(nc, b.columns()));
+
+            DenseVector<DT_> a_pack((mc + 8) * kc);
+            DenseVector<DT_> b_pack(kc * (nc + 8));
+
+            honei::sse::product_dm_packed(result.elements() + row_start * result.columns(), a.elements() + row_start * a.columns(),
+                    b.elements(), rows, b.columns(), a.columns(), result.columns(), a.columns(), b.columns(),
+                    a_pack.elements(), b_pack.elements(), mc, kc, nc);
+        }
     }
 }
 
@@ -224,11 +254,7 @@ DenseVector<float> Product<tags::CPU::SSE>::value(const BandedMatrixQx<Q1Type, f
     }
 
     DenseVector<float> result(a.rows());
-
-    honei::sse::product_bmdv_q1(a.band(LL).elements(), a.band(LD).elements(), a.band(LU).elements(),
-            a.band(DL).elements(), a.band(DD).elements(), a.band(DU).elements(),
-            a.band(UL).elements(), a.band(UD).elements(), a.band(UU).elements(),
-            b.elements(), result.elements(), a.size(), a.root());
+    Product<tags::CPU::SSE>::value(result, a, b);
 
     return result;
 }
@@ -243,49 +269,178 @@ DenseVector<double> Product<tags::CPU::SSE>::value(const BandedMatrixQx<Q1Type,
     }
 
     DenseVector<double> result(a.rows());
-
-    honei::sse::product_bmdv_q1(a.band(LL).elements(), a.band(LD).elements(), a.band(LU).elements(),
-            a.band(DL).elements(), a.band(DD).elements(), a.band(DU).elements(),
-            a.band(UL).elements(), a.band(UD).elements(), a.band(UU).elements(),
-            b.elements(), result.elements(), a.size(), a.root());
+    Product<tags::CPU::SSE>::value(result, a, b);
 
     return result;
 }
 
-DenseVector<float> & Product<tags::CPU::SSE>::value(DenseVector<float> & result, const BandedMatrixQx<Q1Type, float> & a, const DenseVectorContinuousBase<float> & b)
+DenseVector<float> & Product<tags::CPU::SSE>::value(DenseVector<float> & result, const BandedMatrixQx<Q1Type, float> & a, const DenseVectorContinuousBase<float> & b,
+        unsigned long row_start, unsigned long row_end)
 {
     CONTEXT("When multiplying BandedMatrix<float> with DenseVectorContinuousBase<float> (SSE):");
+    PROFILER_START("Product BMQ1 float tags::CPU::SSE");
 
     if (b.size() != a.columns())
     {
         throw VectorSizeDoesNotMatch(b.size(), a.columns());
     }
+    if (a.rows() != result.size())
+    {
+        throw VectorSizeDoesNotMatch(a.rows(), result.size());
+    }
+
+    if (row_end == 0)
+        row_end = a.rows();
 
     honei::sse::product_bmdv_q1(a.band(LL).elements(), a.band(LD).elements(), a.band(LU).elements(),
             a.band(DL).elements(), a.band(DD).elements(), a.band(DU).elements(),
             a.band(UL).elements(), a.band(UD).elements(), a.band(UU).elements(),
-            b.elements(), result.elements(), a.size(), a.root());
+            b.elements(), result.elements(), a.size(), a.root(), row_start, row_end);
 
+    PROFILER_STOP("Product BMQ1 float tags::CPU::SSE");
     return result;
 }
 
-DenseVector<double> & Product<tags::CPU::SSE>::value(DenseVector<double> & result, const BandedMatrixQx<Q1Type, double> & a, const DenseVectorContinuousBase<double> & b)
+DenseVector<double> & Product<tags::CPU::SSE>::value(DenseVector<double> & result, const BandedMatrixQx<Q1Type, double> & a, const DenseVectorContinuousBase<double> & b,
+        unsigned long row_start, unsigned long row_end)
 {
     CONTEXT("When multiplying BandedMatrix<double> with DenseVectorContinuousBase<double> (SSE):");
+    PROFILER_START("Product BMQ1 double tags::CPU::SSE");
 
     if (b.size() != a.columns())
     {
         throw VectorSizeDoesNotMatch(b.size(), a.columns());
     }
+    if (a.rows() != result.size())
+    {
+        throw VectorSizeDoesNotMatch(a.rows(), result.size());
+    }
+
+    if (row_end == 0)
+        row_end = a.rows();
 
     honei::sse::product_bmdv_q1(a.band(LL).elements(), a.band(LD).elements(), a.band(LU).elements(),
             a.band(DL).elements(), a.band(DD).elements(), a.band(DU).elements(),
             a.band(UL).elements(), a.band(UD).elements(), a.band(UU).elements(),
-            b.elements(), result.elements(), a.size(), a.root());
+            b.elements(), result.elements(), a.size(), a.root(), row_start, row_end);
+
+    PROFILER_STOP("Product BMQ1 double tags::CPU::SSE");
+    return result;
+}
+
+DenseVector<float> & Product<tags::CPU::SSE>::value(DenseVector<float> & result, const StencilMatrixQ1<float> & a, const DenseVector<float> & b,
+         unsigned long row_start, unsigned long row_end)
+{
+    CONTEXT("When multiplying StencilMatrixQ1<float> with DenseVector<float> (SSE):");
+    PROFILER_START("Product SMQ1 float tags::CPU::SSE");
+
+    if (b.size() != a.columns())
+    {
+        throw VectorSizeDoesNotMatch(b.size(), a.columns());
+    }
+    if (result.size() != a.rows())
+    {
+        throw VectorSizeDoesNotMatch(result.size(), a.rows());
+    }
+
+    if (row_end == 0)
+        row_end = a.rows();
+
+    honei::sse::product_smdv_q1(result.elements(), a.stencil(), b.elements(), a.root(), row_start, row_end);
+
+    PROFILER_STOP("Product SMQ1 float tags::CPU::SSE");
+    return result;
+}
+
+DenseVector<double> & Product<tags::CPU::SSE>::value(DenseVector<double> & result, const StencilMatrixQ1<double> & a, const DenseVector<double> & b,
+         unsigned long row_start, unsigned long row_end)
+{
+    CONTEXT("When multiplying StencilMatrixQ1<double> with DenseVector<double> (SSE):");
+    PROFILER_START("Product SMQ1 double tags::CPU::SSE");
+
+    if (b.size() != a.columns())
+    {
+        throw VectorSizeDoesNotMatch(b.size(), a.columns());
+    }
+    if (result.size() != a.rows())
+    {
+        throw VectorSizeDoesNotMatch(result.size(), a.rows());
+    }
+
+    if (row_end == 0)
+        row_end = a.rows();
+
+    honei::sse::product_smdv_q1(result.elements(), a.stencil(), b.elements(), a.root(), row_start, row_end);
+
+    PROFILER_STOP("Product SMQ1 double tags::CPU::SSE");
+    return result;
+}
+
+template <unsigned long R_>
+DenseVector<float> & Product<tags::CPU::SSE>::value(DenseVector<float> & result, const SparseMatrixBSR<float, R_> & a, const DenseVector<float> & b,
+         unsigned long row_start, unsigned long row_end)
+{
+    CONTEXT("When multiplying SparseMatrixBSR<float> with DenseVector<float> (SSE):");
+    PROFILER_START("Product SMBSR float tags::CPU::SSE");
+
+    if (b.size() != a.columns())
+    {
+        throw VectorSizeDoesNotMatch(b.size(), a.columns());
+    }
+    if (result.size() != a.rows())
+    {
+        throw VectorSizeDoesNotMatch(result.size(), a.rows());
+    }
+
+    if (row_end == 0)
+        row_end = a.block_rows();
 
+    honei::sse::product_bsr_dv(result.elements(), a.Ar().elements(), a.Aj().elements(), a.Ax().elements(), b.elements(),
+            R_, row_start, row_end);
+
+    PROFILER_STOP("Product SMBSR float tags::CPU::SSE");
     return result;
 }
 
+template <unsigned long R_>
+DenseVector<double> & Product<tags::CPU::SSE>::value(DenseVector<double> & result, const SparseMatrixBSR<double, R_> & a, const DenseVector<double> & b,
+         unsigned long row_start, unsigned long row_end)
+{
+    CONTEXT("When multiplying SparseMatrixBSR<double> with DenseVector<double> (SSE):");
+    PROFILER_START("Product SMBSR double tags::CPU::SSE");
+
+    if (b.size() != a.columns())
+    {
+        throw VectorSizeDoesNotMatch(b.size(), a.columns());
+    }
+    if (result.size() != a.rows())
+    {
+        throw VectorSizeDoesNotMatch(result.size(), a.rows());
+    }
+
+    if (row_end == 0)
+        row_end = a.block_rows();
+
+    honei::sse::product_bsr_dv(result.elements(), a.Ar().elements(), a.Aj().elements(), a.Ax().elements(), b.elements(),
+            R_, row_start, row_end);
+
+    PROFILER_STOP("Product SMBSR double tags::CPU::SSE");
+    return result;
+}
+
+template DenseVector<float> & Product<tags::CPU::SSE>::value<2>(DenseVector<float> &, const SparseMatrixBSR<float, 2> &, const DenseVector<float> &,
+         unsigned long, unsigned long);
+template DenseVector<float> & Product<tags::CPU::SSE>::value<3>(DenseVector<float> &, const SparseMatrixBSR<float, 3> &, const DenseVector<float> &,
+         unsigned long, unsigned long);
+template DenseVector<float> & Product<tags::CPU::SSE>::value<4>(DenseVector<float> &, const SparseMatrixBSR<float, 4> &, const DenseVector<float> &,
+         unsigned long, unsigned long);
+template DenseVector<double> & Product<tags::CPU::SSE>::value<2>(DenseVector<double> &, const SparseMatrixBSR<double, 2> &, const DenseVector<double> &,
+         unsigned long, unsigned long);
+template DenseVector<double> & Product<tags::CPU::SSE>::value<3>(DenseVector<double> &, const SparseMatrixBSR<double, 3> &, const DenseVector<double> &,
+         unsigned long, unsigned long);
+template DenseVector<double> & Product<tags::CPU::SSE>::value<4>(DenseVector<double> &, const SparseMatrixBSR<double, 4> &, const DenseVector<double> &,
+         unsigned long, unsigned long);
+
 DenseVector<float> & Product<tags::CPU::SSE>::value(DenseVector<float> & result, const SparseMatrixELL<float> & a, const DenseVector<float> & b,
          unsigned long row_start, unsigned long row_end)
 {
@@ -305,8 +460,20 @@ DenseVector<float> & Product<tags::CPU::SSE>::value(DenseVector<float> & result,
     if (row_end == 0)
         row_end = a.rows();
 
-    honei::sse::product_smell_dv(result.elements(), a.Aj().elements(), a.Ax().elements(), a.Arl().elements(), b.elements(),
-            a.stride(), a.rows(), a.num_cols_per_row(), row_start, row_end, a.threads());
+    switch (a.index_width())
+    {
+        case 16:
+            honei::sse::product_smell_dv(result.elements(), a.Ajd16().elements(), a.Ax().elements(), a.Arl().elements(), b.elements(),
+                    a.stride(), row_start, row_end, a.threads());
+            break;
+        case 32:
+            honei::sse::product_smell_dv(result.elements(), a.Ajd32().elements(), a.Ax().elements(), a.Arl().elements(), b.elements(),
+                    a.stride(), row_start, row_end, a.threads());
+            break;
+        default:
+            honei::sse::product_smell_dv(result.elements(), a.Aj().elements(), a.Ax().elements(), a.Arl().elements(), b.elements(),
+                    a.stride(), a.rows(), a.num_cols_per_row(), row_start, row_end, a.threads());
+    }
 
     PROFILER_STOP("Product SMELL float tags::CPU::SSE");
     return result;
@@ -330,8 +497,20 @@ DenseVector<double> & Product<tags::CPU::SSE>::value(DenseVector<double> & resul
     if (row_end == 0)
         row_end = a.rows();
 
-    honei::sse::product_smell_dv(result.elements(), a.Aj().elements(), a.Ax().elements(), a.Arl().elements(), b.elements(),
-            a.stride(), a.rows(), a.num_cols_per_row(), row_start, row_end, a.threads());
+    switch (a.index_width())
+    {
+        case 16:
+            honei::sse::product_smell_dv(result.elements(), a.Ajd16().elements(), a.Ax().elements(), a.Arl().elements(), b.elements(),
+                    a.stride(), row_start, row_end, a.threads());
+            break;
+        case 32:
+            honei::sse::product_smell_dv(result.elements(), a.Ajd32().elements(), a.Ax().elements(), a.Arl().elements(), b.elements(),
+                    a.stride(), row_start, row_end, a.threads());
+            break;
+        default:
+            honei::sse::product_smell_dv(result.elements(), a.Aj().elements(), a.Ax().elements(), a.Arl().elements(), b.elements(),
+                    a.stride(), a.rows(), a.num_cols_per_row(), row_start, row_end, a.threads());
+    }
 
     PROFILER_STOP("Product SMELL double tags::CPU::SSE");
     return result;
@@ -356,8 +535,20 @@ DenseVector<float> & Product<tags::CPU::SSE>::value(DenseVector<float> & result,
     if (row_end == 0)
         row_end = a.rows();
 
-    honei::sse::product_csr_dv(result.elements(), a.Aj().elements(), a.Ax().elements(), a.Ar().elements(), b.elements(),
-            a.blocksize(), row_start, row_end);
+    switch (a.index_width())
+    {
+        case 16:
+            honei::sse::product_csr_dv(result.elements(), a.Ajd16().elements(), a.Ax().elements(), a.Ar().elements(), b.elements(),
+                    a.blocksize(), row_start, row_end);
+            break;
+        case 32:
+            honei::sse::product_csr_dv(result.elements(), a.Ajd32().elements(), a.Ax().elements(), a.Ar().elements(), b.elements(),
+                    a.blocksize(), row_start, row_end);
+            break;
+        default:
+            honei::sse::product_csr_dv(result.elements(), a.Aj().elements(), a.Ax().elements(), a.Ar().elements(), b.elements(),
+                    a.blocksize(), row_start, row_end);
+    }
 
     PROFILER_STOP("Product SMCSR float tags::CPU::SSE");
     return result;
@@ -382,13 +573,99 @@ DenseVector<double> & Product<tags::CPU::SSE>::value(DenseVector<double> & resul
     if (row_end == 0)
         row_end = a.rows();
 
-    honei::sse::product_csr_dv(result.elements(), a.Aj().elements(), a.Ax().elements(), a.Ar().elements(), b.elements(),
-            a.blocksize(), row_start, row_end);
+    switch (a.index_width())
+    {
+        case 16:
+            honei::sse::product_csr_dv(result.elements(), a.Ajd16().elements(), a.Ax().elements(), a.Ar().elements(), b.elements(),
+                    a.blocksize(), row_start, row_end);
+            break;
+        case 32:
+            honei::sse::product_csr_dv(result.elements(), a.Ajd32().elements(), a.Ax().elements(), a.Ar().elements(), b.elements(),
+                    a.blocksize(), row_start, row_end);
+            break;
+        default:
+            honei::sse::product_csr_dv(result.elements(), a.Aj().elements(), a.Ax().elements(), a.Ar().elements(), b.elements(),
+                    a.blocksize(), row_start, row_end);
+    }
 
     PROFILER_STOP("Product SMCSR double tags::CPU::SSE");
     return result;
 }
 
+DenseVector<double> & Product<tags::CPU::SSE>::value(DenseVector<double> & result, const SparseMatrixELL<float> & a, const DenseVector<double> & b,
+         unsigned long row_start, unsigned long row_end)
+{
+    CONTEXT("When multiplying SparseMatrixELL<float> with DenseVector<double> (SSE):");
+    PROFILER_START("Product SMELL float double tags::CPU::SSE");
+
+    if (b.size() != a.columns())
+    {
+        throw VectorSizeDoesNotMatch(b.size(), a.columns());
+    }
+    if (result.size() != a.rows())
+    {
+        throw VectorSizeDoesNotMatch(result.size(), a.columns());
+    }
+
+    if (row_end == 0)
+        row_end = a.rows();
+
+    switch (a.index_width())
+    {
+        case 16:
+            honei::sse::product_smell_dv(result.elements(), a.Ajd16().elements(), a.Ax().elements(), a.Arl().elements(), b.elements(),
+                    a.stride(), row_start, row_end, a.threads());
+            break;
+        case 32:
+            honei::sse::product_smell_dv(result.elements(), a.Ajd32().elements(), a.Ax().elements(), a.Arl().elements(), b.elements(),
+                    a.stride(), row_start, row_end, a.threads());
+            break;
+        default:
+            honei::sse::product_smell_dv(result.elements(), a.Aj().elements(), a.Ax().elements(), a.Arl().elements(), b.elements(),
+                    a.stride(), row_start, row_end, a.threads());
+    }
+
+    PROFILER_STOP("Product SMELL float double tags::CPU::SSE");
+    return result;
+}
+
+DenseVector<double> & Product<tags::CPU::SSE>::value(DenseVector<double> & result, const SparseMatrixCSR<float> & a, const DenseVector<double> & b,
+         unsigned long row_start, unsigned long row_end)
+{
+    CONTEXT("When multiplying SparseMatrixCSR<float> with DenseVector<double> (SSE):");
+    PROFILER_START("Product SMCSR float double tags::CPU::SSE");
+
+    if (b.size() != a.columns())
+    {
+        throw VectorSizeDoesNotMatch(b.size(), a.columns());
+    }
+    if (result.size() != a.rows())
+    {
+        throw VectorSizeDoesNotMatch(result.size(), a.columns());
+    }
+
+    if (row_end == 0)
+        row_end = a.rows();
+
+    switch (a.index_width())
+    {
+        case 16:
+            honei::sse::product_csr_dv(result.elements(), a.Ajd16().elements(), a.Ax().elements(), a.Ar().elements(), b.elements(),
+                    a.blocksize(), row_start, row_end);
+            break;
+        case 32:
+            honei::sse::product_csr_dv(result.elements(), a.Ajd32().elements(), a.Ax().elements(), a.Ar().elements(), b.elements(),
+                    a.blocksize(), row_start, row_end);
+            break;
+        default:
+            honei::sse::product_csr_dv(result.elements(), a.Aj().elements(), a.Ax().elements(), a.Ar().elements(), b.elements(),
+                    a.blocksize(), row_start, row_end);
+    }
+
+    PROFILER_STOP("Product SMCSR float double tags::CPU::SSE");
+    return result;
+}
+
 DenseVector<float> Product<tags::CPU::SSE>::value(const DenseMatrix<float> & a, const DenseVectorContinuousBase<float> & b)
 {
     CONTEXT("When multiplying DenseMatrix<float> with DenseVectorContinuousBase<float> (SSE):");
@@ -437,21 +714,24 @@ DenseMatrix<float> Product<tags::CPU::SSE>::value(const DenseMatrix<float> & a,
         throw MatrixRowsDoNotMatch(b.rows(), a.columns());
 
     DenseMatrix<float> result(a.rows(), b.columns(), float(0));
+    honei::sse::packed_dm_product(result, a, b, 0, a.rows());
 
-    /*if (a.columns() == a.rows() && b.columns() == 2)
-    {
-        for (unsigned long i(0) ; i < a.rows() ; ++i)
-        {
-            honei::sse::product_dm_nx2(result[i].elements(), a[i].elements(), b.elements(), b.rows());
-        }
-    }
-    else
-    {*/
-        DenseMatrixTile<float> a_tile(a, a.rows(), a.columns(), 0, 0);
-        DenseMatrixTile<float> b_tile(b, b.rows(), b.columns(), 0, 0);
-        DenseMatrixTile<float> r_tile(result, result.rows(), result.columns(), 0, 0);
-        honei::sse::rec_dm_product(r_tile, a_tile, b_tile);
-    //}
+    return result;
+}
+
+DenseMatrix<float> & Product<tags::CPU::SSE>::value(DenseMatrix<float> & result, const DenseMatrix<float> & a, const DenseMatrix<float> & b,
+        unsigned long row_start, unsigned long row_end)
+{
+    CONTEXT("When adding rows of DenseMatrix<float> times DenseMatrix<float> (SSE):");
+
+    if (a.columns() != b.rows())
+        throw MatrixRowsDoNotMatch(b.rows(), a.columns());
+    if (result.rows() != a.rows())
+        throw MatrixRowsDoNotMatch(a.rows(), result.rows());
+    if (result.columns() != b.columns())
+        throw MatrixColumnsDoNotMatch(b.columns(), result.columns());
+
+    honei::sse::packed_dm_product(result, a, b, row_start, row_end);
 
     return result;
 }
@@ -464,21 +744,24 @@ DenseMatrix<double> Product<tags::CPU::SSE>::value(const DenseMatrix<double> & a
         throw MatrixRowsDoNotMatch(b.rows(), a.columns());
 
     DenseMatrix<double> result(a.rows(), b.columns(), double(0));
+    honei::sse::packed_dm_product(result, a, b, 0, a.rows());
 
-    /*if (a.columns() == a.rows() && b.columns() == 2)
-    {
-        for (unsigned long i(0) ; i < a.rows() ; ++i)
-        {
-            honei::sse::product_dm_nx2(result[i].elements(), a[i].elements(), b.elements(), b.rows());
-        }
-    }
-    else
-    {*/
-        DenseMatrixTile<double> a_tile(a, a.rows(), a.columns(), 0, 0);
-        DenseMatrixTile<double> b_tile(b, b.rows(), b.columns(), 0, 0);
-        DenseMatrixTile<double> r_tile(result, result.rows(), result.columns(), 0, 0);
-        honei::sse::rec_dm_product(r_tile, a_tile, b_tile);
-    //}
+    return result;
+}
+
+DenseMatrix<double> & Product<tags::CPU::SSE>::value(DenseMatrix<double> & result, const DenseMatrix<double> & a, const DenseMatrix<double> & b,
+        unsigned long row_start, unsigned long row_end)
+{
+    CONTEXT("When adding rows of DenseMatrix<double> times DenseMatrix<double> (SSE):");
+
+    if (a.columns() != b.rows())
+        throw MatrixRowsDoNotMatch(b.rows(), a.columns());
+    if (result.rows() != a.rows())
+        throw MatrixRowsDoNotMatch(a.rows(), result.rows());
+    if (result.columns() != b.columns())
+        throw MatrixColumnsDoNotMatch(b.columns(), result.columns());
+
+    honei::sse::packed_dm_product(result, a, b, row_start, row_end);
 
     return result;
 }
@@ -36,7 +36,10 @@
 #include <honei/la/scaled_sum.hh>
 #include <honei/la/sparse_matrix.hh>
 #include <honei/la/sparse_matrix_ell.hh>
+#include <honei/la/sparse_matrix_bsr.hh>
+#include <honei/la/sparse_matrix_csr_symmetric.hh>
 #include <honei/la/sparse_vector.hh>
+#include <honei/la/stencil_matrix_q1.hh>
 #include <honei/la/sum.hh>
 #include <honei/util/benchmark_info.hh>
 #include <honei/util/tags.hh>
@@ -47,9 +50,93 @@
 #include <honei/mpi/sparse_matrix_csr_mpi-fwd.hh>
 
 #include <cmath>
+#include <vector>
 
 namespace honei
 {
+    namespace intern
+    {
+        /**
+         * Computes a single row of a BandedMatrixQx<Q1Type> times b near the first or last grid
+         * line, where some bands point outside of b.
+         */
+        template <typename DT_, typename VT_>
+        inline DT_ banded_q1_sum(const DT_ * const * band, const VT_ & b, unsigned long size, unsigned long m, unsigned long i)
+        {
+            const signed long index(i), root(m), n(size);
+
+            DT_ sum(band[DD][i] * b[i]);
+            if (index - root - 1 >= 0)
+                sum += band[LL][i] * b[i - m - 1];
+            if (index - root >= 0)
+                sum += band[LD][i] * b[i - m];
+            if (index - root + 1 >= 0)
+                sum += band[LU][i] * b[i - m + 1];
+            if (index - 1 >= 0)
+                sum += band[DL][i] * b[i - 1];
+            if (index + 1 < n)
+                sum += band[DU][i] * b[i + 1];
+            if (index + root - 1 < n)
+                sum += band[UL][i] * b[i + m - 1];
+            if (index + root < n)
+                sum += band[UD][i] * b[i + m];
+            if (index + root + 1 < n)
+                sum += band[UU][i] * b[i + m + 1];
+
+            return sum;
+        }
+
+        template <typename DT_, bool defect_>
+        inline void banded_q1_row(DT_ * result, const DT_ * rhs, const DT_ * const * band, const DT_ * b,
+                unsigned long size, unsigned long m, unsigned long i)
+        {
+            const DT_ sum(banded_q1_sum(band, b, size, m, i));
+            result[i] = defect_ ? rhs[i] - sum : sum;
+        }
+
+        /**
+         * Multiplies the rows [row_start, row_end) of a BandedMatrixQx<Q1Type> with b in one sweep.
+         * Every element of result is written once, all nine bands are accumulated in a register.
+         * With defect_ set, rhs - A * b is computed instead of A * b.
+         */
+        template <typename DT_, bool defect_>
+        void banded_q1(DT_ * result, const DT_ * rhs, const DT_ * const * band, const DT_ * b,
+                unsigned long size, unsigned long m, unsigned long row_start, unsigned long row_end)
+        {
+            const unsigned long inner_start(m + 1);
+            const unsigned long inner_end(size > m + 1 ? size - m - 1 : 0);
+
+            const DT_ * ll(band[LL]), * ld(band[LD]), * lu(band[LU]);
+            const DT_ * dl(band[DL]), * dd(band[DD]), * du(band[DU]);
+            const DT_ * ul(band[UL]), * ud(band[UD]), * uu(band[UU]);
+
+            unsigned long i(row_start);
+            for ( ; i < row_end && i < inner_start ; ++i)
+                banded_q1_row<DT_, defect_>(result, rhs, band, b, size, m, i);
+
+            const unsigned long end(row_end < inner_end ? row_end : inner_end);
+            for ( ; i < end ; ++i)
+            {
+                DT_ sum(dd[i] * b[i]
+                        + ll[i] * b[i - m - 1] + ld[i] * b[i - m] + lu[i] * b[i - m + 1]
+                        + dl[i] * b[i - 1] + du[i] * b[i + 1]
+                        + ul[i] * b[i + m - 1] + ud[i] * b[i + m] + uu[i] * b[i + m + 1]);
+                result[i] = defect_ ? rhs[i] - sum : sum;
+            }
+
+            for ( ; i < row_end ; ++i)
+                banded_q1_row<DT_, defect_>(result, rhs, band, b, size, m, i);
+        }
+
+        /// Collects the band pointers of a BandedMatrixQx<Q1Type>, indexed by Q1BandIndex.
+        template <typename DT_>
+        void banded_q1_bands(const DT_ ** band, const BandedMatrixQx<Q1Type, DT_> & a)
+        {
+            for (unsigned long i(0) ; i < 9 ; ++i)
+                band[i] = a.band(i).elements();
+        }
+    }
+
     /**
      * \brief Product of two entities.
      *
@@ -244,6 +331,87 @@ namespace honei
             return rv;
         }
 
+        /**
+         * \name Mixed precision sparse matrix products
+         *
+         * The matrix stores its values in float, the vectors and the accumulation stay in double.
+         */
+        /// \{
+        static DenseVector<double> & value(DenseVector<double> & result, const SparseMatrixELL<float> & a, const DenseVector<double> & b,
+                unsigned long row_start = 0, unsigned long row_end = 0)
+        {
+            CONTEXT("When multiplying SparseMatrixELL<float> with DenseVector<double>:");
+
+            if (b.size() != a.columns())
+            {
+                throw VectorSizeDoesNotMatch(b.size(), a.columns());
+            }
+            if (a.rows() != result.size())
+            {
+                throw VectorSizeDoesNotMatch(a.rows(), result.size());
+            }
+
+            if (row_end == 0)
+                row_end = a.rows();
+
+            const unsigned long stride(a.stride());
+            const double * bx(b.elements());
+            const float * aax(a.Ax().elements());
+            const unsigned long * aaj(a.Aj().elements());
+            const unsigned long * aarl(a.Arl().elements());
+            for (unsigned long row(row_start) ; row < row_end ; ++row)
+            {
+                double sum(0);
+                for (unsigned long col(0), j(row * a.threads()) ; col < aarl[row] ; ++col, j+=stride)
+                {
+                    for (unsigned long thread(0) ; thread < a.threads() ; ++thread)
+                        sum += double(aax[j + thread]) * bx[aaj[j + thread]];
+                }
+                result.elements()[row] = sum;
+            }
+
+            return result;
+        }
+
+        static DenseVector<double> & value(DenseVector<double> & rv, const SparseMatrixCSR<float> & a, const DenseVector<double> & bv,
+                unsigned long row_start = 0, unsigned long row_end = 0)
+        {
+            CONTEXT("When multiplying SparseMatrixCSR<float> with DenseVector<double>:");
+
+            if (bv.size() != a.columns())
+            {
+                throw VectorSizeDoesNotMatch(bv.size(), a.columns());
+            }
+            if (row_end == 0)
+                row_end = a.rows();
+
+            const unsigned long * const Ar(a.Ar().elements());
+            const unsigned long * const Aj(a.Aj().elements());
+            const float * const Ax(a.Ax().elements());
+            const double * const b(bv.elements());
+            double * r(rv.elements());
+            const unsigned long blocksize(a.blocksize());
+            const unsigned long bsize(bv.size());
+
+            for (unsigned long row(row_start) ; row < row_end ; ++row)
+            {
+                double sum(0);
+                const unsigned long end(Ar[row+1]);
+                for (unsigned long i(Ar[row]) ; i < end ; ++i)
+                {
+                    for (unsigned long blocki(0) ; blocki < blocksize ; ++blocki)
+                    {
+                        if (Aj[i]+blocki < bsize)
+                            sum += double(Ax[(i*blocksize)+blocki]) * b[Aj[i] + blocki];
+                    }
+                }
+                r[row] = sum;
+            }
+
+            return rv;
+        }
+        /// \}
+
         template <typename DT1_, typename DT2_>
         static SparseVector<DT1_> value(const SparseMatrix<DT1_> & a, const SparseVector<DT2_> & b)
         {
@@ -331,6 +499,45 @@ namespace honei
             return result;
         }
 
+        template <typename DT_>
+        static DenseVector<DT_> value(const BandedMatrixQx<Q1Type, DT_> & a, const DenseVectorContinuousBase<DT_> & b)
+        {
+            CONTEXT("When multiplying BandedMatrixQ1 with DenseVectorContinuousBase:");
+            if (b.size() != a.columns())
+            {
+                throw VectorSizeDoesNotMatch(b.size(), a.columns());
+            }
+
+            DenseVector<DT_> result(a.rows());
+            value(result, a, b);
+
+            return result;
+        }
+
+        template <typename DT_>
+        static DenseVector<DT_> & value(DenseVector<DT_> & result, const BandedMatrixQx<Q1Type, DT_> & a, const DenseVectorContinuousBase<DT_> & b,
+                unsigned long row_start = 0, unsigned long row_end = 0)
+        {
+            CONTEXT("When multiplying BandedMatrixQ1 with DenseVectorContinuousBase:");
+            if (b.size() != a.columns())
+            {
+                throw VectorSizeDoesNotMatch(b.size(), a.columns());
+            }
+            if (a.rows() != result.size())
+            {
+                throw VectorSizeDoesNotMatch(a.rows(), result.size());
+            }
+
+            if (row_end == 0)
+                row_end = a.rows();
+
+            const DT_ * band[9];
+            intern::banded_q1_bands(band, a);
+            intern::banded_q1<DT_, false>(result.elements(), 0, band, b.elements(), a.size(), a.root(), row_start, row_end);
+
+            return result;
+        }
+
         template <typename DT1_, typename DT2_>
         static DenseVector<DT1_> value(const BandedMatrixQx<Q1Type, DT1_> & a, const DenseVectorBase<DT2_> & b)
         {
@@ -341,32 +548,12 @@ namespace honei
             }
 
             DenseVector<DT1_> result(a.rows());
-            long root(a.root());
-
-            for (long index(0) ; index < (long)b.size() ; ++index)
-            {
-                result[index] = a.band(DD)[index] * b[index];
-                if ((index - root - 1) >= 0)
-                    result[index] += a.band(LL)[index] * b[index - root - 1];
-                if ((index - root) >= 0)
-                    result[index] += a.band(LD)[index] * b[index - root];
-                if ((index - root + 1) >= 0)
-                    result[index] += a.band(LU)[index] * b[index - root + 1];
-                if ((index - 1) >= 0)
-                    result[index] += a.band(DL)[index] * b[index - 1];
-                if ((index + 1) < (long)b.size())
-                    result[index] += a.band(DU)[index] * b[index + 1];
-                if ((index + root - 1) < (long)b.size())
-                    result[index] += a.band(UL)[index] * b[index + root - 1];
-                if ((index + root) < (long)b.size())
-                    result[index] += a.band(UD)[index] * b[index + root];
-                if ((index + root + 1) < (long)b.size())
-                    result[index] += a.band(UU)[index] * b[index + root + 1];
-            }
+            value(result, a, b);
 
             return result;
         }
 
+        /// Slices and vectors of another precision go through the checked single row path.
         template <typename DT1_, typename DT2_>
         static DenseVector<DT1_> & value(DenseVector<DT1_> & result, const BandedMatrixQx<Q1Type, DT1_> & a, const DenseVectorBase<DT2_> & b)
         {
@@ -375,29 +562,86 @@ namespace honei
             {
                 throw VectorSizeDoesNotMatch(b.size(), a.columns());
             }
+            if (a.rows() != result.size())
+            {
+                throw VectorSizeDoesNotMatch(a.rows(), result.size());
+            }
+
+            const DT1_ * band[9];
+            intern::banded_q1_bands(band, a);
+            DT1_ * r(result.elements());
+            for (unsigned long i(0) ; i < a.rows() ; ++i)
+                r[i] = intern::banded_q1_sum(band, b, a.size(), a.root(), i);
 
-            long root(a.root());
+            return result;
+        }
 
-            for (long index(0) ; index < (long)b.size() ; ++index)
+        template <typename DT_>
+        static DenseVector<DT_> & value(DenseVector<DT_> & result, const StencilMatrixQ1<DT_> & a, const DenseVector<DT_> & b,
+                unsigned long row_start = 0, unsigned long row_end = 0)
+        {
+            CONTEXT("When multiplying StencilMatrixQ1 with DenseVector:");
+            if (b.size() != a.columns())
             {
-                result[index] = a.band(DD)[index] * b[index];
-                if ((index - root - 1) >= 0)
-                    result[index] += a.band(LL)[index] * b[index - root - 1];
-                if ((index - root) >= 0)
-                    result[index] += a.band(LD)[index] * b[index - root];
-                if ((index - root + 1) >= 0)
-                    result[index] += a.band(LU)[index] * b[index - root + 1];
-                if ((index - 1) >= 0)
-                    result[index] += a.band(DL)[index] * b[index - 1];
-                if ((index + 1) < (long)b.size())
-                    result[index] += a.band(DU)[index] * b[index + 1];
-                if ((index + root - 1) < (long)b.size())
-                    result[index] += a.band(UL)[index] * b[index + root - 1];
-                if ((index + root) < (long)b.size())
-                    result[index] += a.band(UD)[index] * b[index + root];
-                if ((index + root + 1) < (long)b.size())
-                    result[index] += a.band(UU)[index] * b[index + root + 1];
+                throw VectorSizeDoesNotMatch(b.size(), a.columns());
             }
+            if (a.rows() != result.size())
+            {
+                throw VectorSizeDoesNotMatch(a.rows(), result.size());
+            }
+
+            if (row_end == 0)
+                row_end = a.rows();
+
+            intern::stencil_q1<DT_, false>(result.elements(), 0, a.stencil(), b.elements(), a.root(), row_start, row_end);
+
+            return result;
+        }
+
+        /**
+         * Multiplies the block rows [row_start, row_end) of a SparseMatrixBSR with a DenseVector.
+         */
+        template <typename DT_, unsigned long R_>
+        static DenseVector<DT_> & value(DenseVector<DT_> & result, const SparseMatrixBSR<DT_, R_> & a, const DenseVector<DT_> & b,
+                unsigned long row_start = 0, unsigned long row_end = 0)
+        {
+            CONTEXT("When multiplying SparseMatrixBSR with DenseVector:");
+            if (b.size() != a.columns())
+            {
+                throw VectorSizeDoesNotMatch(b.size(), a.columns());
+            }
+            if (a.rows() != result.size())
+            {
+                throw VectorSizeDoesNotMatch(a.rows(), result.size());
+            }
+
+            if (row_end == 0)
+                row_end = a.block_rows();
+
+            intern::bsr<DT_, R_>(result.elements(), 0, a.Ar().elements(), a.Aj().elements(), a.Ax().elements(), b.elements(), row_start, row_end);
+
+            return result;
+        }
+
+        template <typename DT_>
+        static DenseVector<DT_> & value(DenseVector<DT_> & result, const SparseMatrixCSRSymmetric<DT_> & a, const DenseVector<DT_> & b)
+        {
+            CONTEXT("When multiplying SparseMatrixCSRSymmetric with DenseVector:");
+            if (b.size() != a.columns())
+            {
+                throw VectorSizeDoesNotMatch(b.size(), a.columns());
+            }
+            if (a.rows() != result.size())
+            {
+                throw VectorSizeDoesNotMatch(a.rows(), result.size());
+            }
+
+            // the transposed upper triangle scatters into rows below the current one, so clear all of them first
+            DT_ * r(result.elements());
+            for (unsigned long i(0) ; i < result.size() ; ++i)
+                r[i] = DT_(0);
+            intern::csr_symmetric<DT_, false>(r, r, 0, a.diagonal().elements(), a.Ar().elements(), a.Aj().elements(),
+                    a.Ax().elements(), b.elements(), 0, a.rows());
 
             return result;
         }
@@ -584,6 +828,39 @@ namespace honei
             return result;
         }
 
+        /**
+         * Adds the rows [row_start, row_end) of a * b to result.
+         */
+        template <typename DT_>
+        static DenseMatrix<DT_> & value(DenseMatrix<DT_> & result, const DenseMatrix<DT_> & a, const DenseMatrix<DT_> & b,
+                unsigned long row_start, unsigned long row_end)
+        {
+            CONTEXT("When adding rows of DenseMatrix times DenseMatrix:");
+
+            if (a.columns() != b.rows())
+                throw MatrixRowsDoNotMatch(b.rows(), a.columns());
+            if (result.rows() != a.rows())
+                throw MatrixRowsDoNotMatch(a.rows(), result.rows());
+            if (result.columns() != b.columns())
+                throw MatrixColumnsDoNotMatch(b.columns(), result.columns());
+
+            const unsigned long columns(b.columns());
+            for (unsigned long row(row_start) ; row < row_end ; ++row)
+            {
+                DT_ * const r_e(result.elements() + row * columns);
+                const DT_ * const a_e(a.elements() + row * a.columns());
+                for (unsigned long k(0) ; k < a.columns() ; ++k)
+                {
+                    const DT_ a_rk(a_e[k]);
+                    const DT_ * const b_e(b.elements() + k * columns);
+                    for (unsigned long column(0) ; column < columns ; ++column)
+                        r_e[column] += a_rk * b_e[column];
+                }
+            }
+
+            return result;
+        }
+
         template <typename DT1_, typename DT2_>
         static DenseMatrixTile<DT1_> & value(DenseMatrixTile<DT1_> & r, const DenseMatrixTile<DT1_> & a, const DenseMatrixTile<DT2_> & b)
         {
@@ -1398,6 +1675,58 @@ namespace honei
 
     template <> struct Product<tags::CPU::Generic>
     {
+        template <typename DT_>
+        static DenseMatrix<DT_> & value(DenseMatrix<DT_> & result, const DenseMatrix<DT_> & a, const DenseMatrix<DT_> & b,
+                unsigned long row_start, unsigned long row_end)
+        {
+            return Product<tags::CPU>::value(result, a, b, row_start, row_end);
+        }
+
+        template <typename DT_>
+        static DenseVector<DT_> value(const BandedMatrixQx<Q1Type, DT_> & a, const DenseVectorContinuousBase<DT_> & b)
+        {
+            return Product<tags::CPU>::value(a, b);
+        }
+
+        template <typename DT_>
+        static DenseVector<DT_> & value(DenseVector<DT_> & result, const BandedMatrixQx<Q1Type, DT_> & a, const DenseVectorContinuousBase<DT_> & b,
+                unsigned long row_start = 0, unsigned long row_end = 0)
+        {
+            return Product<tags::CPU>::value(result, a, b, row_start, row_end);
+        }
+
+        template <typename DT1_, typename DT2_>
+        static DenseVector<DT1_> value(const BandedMatrixQx<Q1Type, DT1_> & a, const DenseVectorBase<DT2_> & b)
+        {
+            return Product<tags::CPU>::value(a, b);
+        }
+
+        template <typename DT1_, typename DT2_>
+        static DenseVector<DT1_> & value(DenseVector<DT1_> & result, const BandedMatrixQx<Q1Type, DT1_> & a, const DenseVectorBase<DT2_> & b)
+        {
+            return Product<tags::CPU>::value(result, a, b);
+        }
+
+        template <typename DT_>
+        static DenseVector<DT_> & value(DenseVector<DT_> & result, const StencilMatrixQ1<DT_> & a, const DenseVector<DT_> & b,
+                unsigned long row_start = 0, unsigned long row_end = 0)
+        {
+            return Product<tags::CPU>::value(result, a, b, row_start, row_end);
+        }
+
+        template <typename DT_, unsigned long R_>
+        static DenseVector<DT_> & value(DenseVector<DT_> & result, const SparseMatrixBSR<DT_, R_> & a, const DenseVector<DT_> & b,
+                unsigned long row_start = 0, unsigned long row_end = 0)
+        {
+            return Product<tags::CPU>::value(result, a, b, row_start, row_end);
+        }
+
+        template <typename DT_>
+        static DenseVector<DT_> & value(DenseVector<DT_> & result, const SparseMatrixCSRSymmetric<DT_> & a, const DenseVector<DT_> & b)
+        {
+            return Product<tags::CPU>::value(result, a, b);
+        }
+
         template <typename DT_>
         static DenseVector<DT_> & value(DenseVector<DT_> & r, const SparseMatrix<DT_> & a, const DenseVector<DT_> & b,
                 unsigned long row_start = 0, unsigned long row_end = 0)
@@ -1871,9 +2200,17 @@ namespace honei
 
         static DenseVector<double> value(const BandedMatrixQx<Q1Type, double> & a, const DenseVectorContinuousBase<double> & b);
 
-        static DenseVector<float> & value(DenseVector<float> & result, const BandedMatrixQx<Q1Type, float> & a, const DenseVectorContinuousBase<float> & b);
+        static DenseVector<float> & value(DenseVector<float> & result, const BandedMatrixQx<Q1Type, float> & a, const DenseVectorContinuousBase<float> & b,
+                unsigned long row_start = 0, unsigned long row_end = 0);
 
-        static DenseVector<double> & value(DenseVector<double> & result, const BandedMatrixQx<Q1Type, double> & a, const DenseVectorContinuousBase<double> & b);
+        static DenseVector<double> & value(DenseVector<double> & result, const BandedMatrixQx<Q1Type, double> & a, const DenseVectorContinuousBase<double> & b,
+                unsigned long row_start = 0, unsigned long row_end = 0);
+
+        static DenseVector<float> & value(DenseVector<float> & result, const StencilMatrixQ1<float> & a, const DenseVector<float> & b,
+                unsigned long row_start = 0, unsigned long row_end = 0);
+
+        static DenseVector<double> & value(DenseVector<double> & result, const StencilMatrixQ1<double> & a, const DenseVector<double> & b,
+                unsigned long row_start = 0, unsigned long row_end = 0);
 
         static DenseVector<float> value(const DenseMatrix<float> & a, const DenseVectorContinuousBase<float> & b);
 
@@ -1883,6 +2220,18 @@ namespace honei
 
         static DenseMatrix<double> value(const DenseMatrix<double> &a, const DenseMatrix<double> & b);
 
+        /**
+         * \brief Adds the rows [row_start, row_end) of a * b to result.
+         *
+         * Blocks of a and panels of b are packed and multiplied by a register blocked kernel, the
+         * block sizes are read from the sse::Product(DM,DM)::{mc,kc,nc} configuration keys.
+         */
+        static DenseMatrix<float> & value(DenseMatrix<float> & result, const DenseMatrix<float> & a, const DenseMatrix<float> & b,
+                unsigned long row_start, unsigned long row_end);
+
+        static DenseMatrix<double> & value(DenseMatrix<double> & result, const DenseMatrix<double> & a, const DenseMatrix<double> & b,
+                unsigned long row_start, unsigned long row_end);
+
         static DenseMatrix<float> value(const SparseMatrix<float> &a, const DenseMatrix<float> & b);
 
         static DenseMatrix<double> value(const SparseMatrix<double> &a, const DenseMatrix<double> & b);
@@ -1903,6 +2252,15 @@ namespace honei
         static DenseVector<double> & value(DenseVector<double> & result, const SparseMatrixCSR<double> & a, const DenseVector<double> & b,
                 unsigned long row_start = 0, unsigned long row_end = 0);
 
+        /**
+         * \brief Mixed precision products, the float matrix values are widened to double in register.
+         */
+        static DenseVector<double> & value(DenseVector<double> & result, const SparseMatrixELL<float> & a, const DenseVector<double> & b,
+                unsigned long row_start = 0, unsigned long row_end = 0);
+
+        static DenseVector<double> & value(DenseVector<double> & result, const SparseMatrixCSR<float> & a, const DenseVector<double> & b,
+                unsigned long row_start = 0, unsigned long row_end = 0);
+
         template<typename DT1_, typename DT2_>
         static DenseVectorContinuousBase<DT1_> & value(DenseVectorContinuousBase<DT1_> & y, const DenseVectorContinuousBase<DT1_> & a, const DenseVectorContinuousBase<DT2_> & b)
         {
@@ -1910,6 +2268,21 @@ namespace honei
             return y;
         }
 
+        /// Multiplies the block rows [row_start, row_end), instantiated for blocks of size 2, 3 and 4.
+        template <unsigned long R_>
+        static DenseVector<float> & value(DenseVector<float> & result, const SparseMatrixBSR<float, R_> & a, const DenseVector<float> & b,
+                unsigned long row_start = 0, unsigned long row_end = 0);
+
+        template <unsigned long R_>
+        static DenseVector<double> & value(DenseVector<double> & result, const SparseMatrixBSR<double, R_> & a, const DenseVector<double> & b,
+                unsigned long row_start = 0, unsigned long row_end = 0);
+
+        template <typename DT_>
+        static DenseVector<DT_> & value(DenseVector<DT_> & result, const SparseMatrixCSRSymmetric<DT_> & a, const DenseVector<DT_> & b)
+        {
+            return Product<tags::CPU>::value(result, a, b);
+        }
+
         template <typename DT_>
         static inline DenseVectorMPI<DT_> & value(DenseVectorMPI<DT_> & r, const SparseMatrixELLMPI<DT_> & a, const DenseVectorMPI<DT_> & b)
         {
@@ -1967,108 +2340,49 @@ namespace honei
                 return y;
             }
 
-            template <typename DT1_, typename DT2_>
-                static DenseVector<DT1_> value(const BandedMatrixQx<Q1Type, DT1_> & a, const DenseVectorContinuousBase<DT2_> & b)
+            template <typename DT_>
+            static DenseVector<DT_> value(const BandedMatrixQx<Q1Type, DT_> & a, const DenseVectorContinuousBase<DT_> & b)
             {
-                CONTEXT("When multiplying BandedMatrixQ1 with DenseVectorContinuousBase using backend : " + Tag_::name);
-                if (b.size() != a.columns())
-                {
-                    throw VectorSizeDoesNotMatch(b.size(), a.columns());
-                }
-
-                signed long root(a.root());
-                const unsigned long size(b.size());
-                DenseVector<DT1_> result(size, DT1_(0));
-
-                const DenseVectorRange<DT1_> ll_band(a.band_range(LL));
-                const DenseVectorRange<DT1_> ld_band(a.band_range(LD));
-                const DenseVectorRange<DT1_> lu_band(a.band_range(LU));
-                const DenseVectorRange<DT1_> dl_band(a.band_range(DL));
-                const DenseVectorRange<DT1_> du_band(a.band_range(DU));
-                const DenseVectorRange<DT1_> ud_band(a.band_range(UD));
-                const DenseVectorRange<DT1_> uu_band(a.band_range(UU));
-                const DenseVectorRange<DT1_> ul_band(a.band_range(UL));
-
-                DenseVectorRange<DT1_> res_ll(result.range(size - root - 1, root + 1));
-                DenseVectorRange<DT1_> res_ld(result.range(size - root, root));
-                DenseVectorRange<DT1_> res_lu(result.range(size - root + 1, root - 1));
-                DenseVectorRange<DT1_> res_dl(result.range(size - 1, 1));
-                DenseVectorRange<DT1_> res_du(result.range(size - 1, 0));
-                DenseVectorRange<DT1_> res_ud(result.range(size - root, 0));
-                DenseVectorRange<DT1_> res_uu(result.range(size - root - 1, 0));
-                DenseVectorRange<DT1_> res_ul(result.range(size - root + 1, 0));
-
-                const DenseVectorRange<DT1_> b_ll(b.range(size - root - 1, 0));
-                const DenseVectorRange<DT1_> b_ld(b.range(size - root, 0));
-                const DenseVectorRange<DT1_> b_lu(b.range(size - root + 1, 0));
-                const DenseVectorRange<DT1_> b_dl(b.range(size - 1, 0));
-                const DenseVectorRange<DT1_> b_du(b.range(size - 1, 1));
-                const DenseVectorRange<DT1_> b_ud(b.range(size - root, root));
-                const DenseVectorRange<DT1_> b_uu(b.range(size - root - 1, root + 1));
-                const DenseVectorRange<DT1_> b_ul(b.range(size - root + 1, root - 1));
-
-                honei::ScaledSum<Tag_>::value(res_ll, ll_band, b_ll);
-                honei::ScaledSum<Tag_>::value(res_ld, ld_band, b_ld);
-                honei::ScaledSum<Tag_>::value(res_lu, lu_band, b_lu);
-                honei::ScaledSum<Tag_>::value(res_dl, dl_band, b_dl);
-                honei::ScaledSum<Tag_>::value(result, const_cast<const DenseVector<DT1_> &>(a.band(DD)), b);
-                honei::ScaledSum<Tag_>::value(res_du, du_band, b_du);
-                honei::ScaledSum<Tag_>::value(res_ud, ud_band, b_ud);
-                honei::ScaledSum<Tag_>::value(res_uu, uu_band, b_uu);
-                honei::ScaledSum<Tag_>::value(res_ul, ul_band, b_ul);
+                DenseVector<DT_> result(a.rows());
+                value(result, a, b);
 
                 return result;
             }
 
-            template <typename DT1_, typename DT2_>
-            static DenseVector<DT1_> & value(DenseVector<DT1_> & result, const BandedMatrixQx<Q1Type, DT1_> & a, const DenseVectorContinuousBase<DT2_> & b)
+            template <typename DT_>
+            static DenseVector<DT_> & value(DenseVector<DT_> & result, const BandedMatrixQx<Q1Type, DT_> & a, const DenseVectorContinuousBase<DT_> & b)
             {
                 CONTEXT("When multiplying BandedMatrixQ1 with DenseVectorContinuousBase using backend : " + Tag_::name);
                 if (b.size() != a.columns())
                 {
                     throw VectorSizeDoesNotMatch(b.size(), a.columns());
                 }
+                if (a.rows() != result.size())
+                {
+                    throw VectorSizeDoesNotMatch(a.rows(), result.size());
+                }
 
-                signed long root(a.root());
-                const unsigned long size(b.size());
-                fill<Tag_>(result, DT1_(0));
-
-                const DenseVectorRange<DT1_> ll_band(a.band_range(LL));
-                const DenseVectorRange<DT1_> ld_band(a.band_range(LD));
-                const DenseVectorRange<DT1_> lu_band(a.band_range(LU));
-                const DenseVectorRange<DT1_> dl_band(a.band_range(DL));
-                const DenseVectorRange<DT1_> du_band(a.band_range(DU));
-                const DenseVectorRange<DT1_> ud_band(a.band_range(UD));
-                const DenseVectorRange<DT1_> uu_band(a.band_range(UU));
-                const DenseVectorRange<DT1_> ul_band(a.band_range(UL));
-
-                DenseVectorRange<DT1_> res_ll(result.range(size - root - 1, root + 1));
-                DenseVectorRange<DT1_> res_ld(result.range(size - root, root));
-                DenseVectorRange<DT1_> res_lu(result.range(size - root + 1, root - 1));
-                DenseVectorRange<DT1_> res_dl(result.range(size - 1, 1));
-                DenseVectorRange<DT1_> res_du(result.range(size - 1, 0));
-                DenseVectorRange<DT1_> res_ud(result.range(size - root, 0));
-                DenseVectorRange<DT1_> res_uu(result.range(size - root - 1, 0));
-                DenseVectorRange<DT1_> res_ul(result.range(size - root + 1, 0));
-
-                const DenseVectorRange<DT1_> b_ll(b.range(size - root - 1, 0));
-                const DenseVectorRange<DT1_> b_ld(b.range(size - root, 0));
-                const DenseVectorRange<DT1_> b_lu(b.range(size - root + 1, 0));
-                const DenseVectorRange<DT1_> b_dl(b.range(size - 1, 0));
-                const DenseVectorRange<DT1_> b_du(b.range(size - 1, 1));
-                const DenseVectorRange<DT1_> b_ud(b.range(size - root, root));
-                const DenseVectorRange<DT1_> b_uu(b.range(size - root - 1, root + 1));
-                const DenseVectorRange<DT1_> b_ul(b.range(size - root + 1, root - 1));
-
-                honei::ScaledSum<Tag_>::value(res_ll, ll_band, b_ll);
-                honei::ScaledSum<Tag_>::value(res_ld, ld_band, b_ld);
-                honei::ScaledSum<Tag_>::value(res_lu, lu_band, b_lu);
-                honei::ScaledSum<Tag_>::value(res_dl, dl_band, b_dl);
-                honei::ScaledSum<Tag_>::value(result, const_cast<const DenseVector<DT1_> &>(a.band(DD)), b);
-                honei::ScaledSum<Tag_>::value(res_du, du_band, b_du);
-                honei::ScaledSum<Tag_>::value(res_ud, ud_band, b_ud);
-                honei::ScaledSum<Tag_>::value(res_uu, uu_band, b_uu);
-                honei::ScaledSum<Tag_>::value(res_ul, ul_band, b_ul);
+                unsigned long max_count(Configuration::instance()->get_value("mc::Product(DV,BMQ1,DV)::max_count",
+                            mc::ThreadPool::instance()->num_threads()));
+
+                // partition along whole grid lines, every thread streams its own block of the bands
+                const unsigned long m(a.root());
+                if (max_count > m)
+                    max_count = m;
+
+                // a range over all of b can be handed to the blocks whatever the type of b
+                const DenseVectorRange<DT_> b_range(b.range(b.size(), 0));
+                TicketVector tickets;
+
+                for (unsigned long i(0) ; i < max_count ; ++i)
+                {
+                    OperationWrapper<honei::Product<typename Tag_::DelegateTo>, DenseVector<DT_>,
+                        DenseVector<DT_>, BandedMatrixQx<Q1Type, DT_>, DenseVectorRange<DT_>, unsigned long, unsigned long > wrapper(result);
+                    tickets.push_back(mc::ThreadPool::instance()->enqueue(bind(wrapper, result, a, b_range,
+                                    (i * m / max_count) * m, ((i + 1) * m / max_count) * m)));
+                }
+
+                tickets.wait();
 
                 return result;
             }
@@ -2111,7 +2425,133 @@ namespace honei
             }
 
             template <typename DT_>
-            static DenseVector<DT_> & value(DenseVector<DT_> & result, const SparseMatrixELL<DT_> & a, const DenseVector<DT_> & b)
+            static DenseVector<DT_> & value(DenseVector<DT_> & result, const StencilMatrixQ1<DT_> & a, const DenseVector<DT_> & b)
+            {
+                CONTEXT("When multiplying StencilMatrixQ1 with DenseVector using backend : " + Tag_::name);
+                if (b.size() != a.columns())
+                {
+                    throw VectorSizeDoesNotMatch(b.size(), a.columns());
+                }
+                if (a.rows() != result.size())
+                {
+                    throw VectorSizeDoesNotMatch(a.rows(), result.size());
+                }
+
+                unsigned long max_count(Configuration::instance()->get_value("mc::Product(DV,SMQ1,DV)::max_count",
+                            mc::ThreadPool::instance()->num_threads()));
+
+                // partition along whole grid lines, to keep the inner loops long
+                const unsigned long m(a.root());
+                if (max_count > m)
+                    max_count = m;
+
+                TicketVector tickets;
+
+                for (unsigned long i(0) ; i < max_count ; ++i)
+                {
+                    OperationWrapper<honei::Product<typename Tag_::DelegateTo>, DenseVector<DT_>,
+                        DenseVector<DT_>, StencilMatrixQ1<DT_>, DenseVector<DT_>, unsigned long, unsigned long > wrapper(result);
+                    tickets.push_back(mc::ThreadPool::instance()->enqueue(bind(wrapper, result, a, b,
+                                    (i * m / max_count) * m, ((i + 1) * m / max_count) * m)));
+                }
+
+                tickets.wait();
+
+                return result;
+            }
+
+            template <typename DT_, unsigned long R_>
+            static DenseVector<DT_> & value(DenseVector<DT_> & result, const SparseMatrixBSR<DT_, R_> & a, const DenseVector<DT_> & b)
+            {
+                CONTEXT("When multiplying SparseMatrixBSR with DenseVector using backend : " + Tag_::name);
+                if (b.size() != a.columns())
+                {
+                    throw VectorSizeDoesNotMatch(b.size(), a.columns());
+                }
+                if (a.rows() != result.size())
+                {
+                    throw VectorSizeDoesNotMatch(a.rows(), result.size());
+                }
+
+                unsigned long max_count(Configuration::instance()->get_value("mc::Product(DV,SMBSR,DV)::max_count",
+                            mc::ThreadPool::instance()->num_threads()));
+                if (max_count > a.block_rows())
+                    max_count = a.block_rows();
+
+                TicketVector tickets;
+
+                for (unsigned long i(0) ; i < max_count ; ++i)
+                {
+                    OperationWrapper<honei::Product<typename Tag_::DelegateTo>, DenseVector<DT_>,
+                        DenseVector<DT_>, SparseMatrixBSR<DT_, R_>, DenseVector<DT_>, unsigned long, unsigned long > wrapper(result);
+                    tickets.push_back(mc::ThreadPool::instance()->enqueue(bind(wrapper, result, a, b,
+                                    i * a.block_rows() / max_count, (i + 1) * a.block_rows() / max_count)));
+                }
+
+                tickets.wait();
+
+                return result;
+            }
+
+            template <typename DT_>
+            static DenseVector<DT_> & value(DenseVector<DT_> & result, const SparseMatrixCSRSymmetric<DT_> & a, const DenseVector<DT_> & b)
+            {
+                CONTEXT("When multiplying SparseMatrixCSRSymmetric with DenseVector using backend : " + Tag_::name);
+                if (b.size() != a.columns())
+                {
+                    throw VectorSizeDoesNotMatch(b.size(), a.columns());
+                }
+                if (a.rows() != result.size())
+                {
+                    throw VectorSizeDoesNotMatch(a.rows(), result.size());
+                }
+
+                unsigned long max_count(Configuration::instance()->get_value("mc::Product(DV,SMCSRS,DV)::max_count",
+                            mc::ThreadPool::instance()->num_threads()));
+                if (max_count > a.rows())
+                    max_count = a.rows();
+                if (max_count == 0)
+                    return result;
+
+                // every block scatters the transposed upper triangle into a private buffer, that covers its own
+                // rows up to the farthest column it references; the buffers are summed up in a second pass
+                std::vector<unsigned long> starts(max_count), ends(max_count);
+                std::vector<DenseVector<DT_> > buffers;
+                std::vector<DT_ *> scatter(max_count);
+                for (unsigned long i(0) ; i < max_count ; ++i)
+                {
+                    starts[i] = i * a.rows() / max_count;
+                    const unsigned long block_end((i + 1) * a.rows() / max_count);
+                    ends[i] = block_end > starts[i] ? a.reach(block_end - 1) : starts[i];
+                    buffers.push_back(DenseVector<DT_>(ends[i] > starts[i] ? ends[i] - starts[i] : 1));
+                    scatter[i] = buffers.back().elements();
+                }
+
+                TicketVector tickets;
+
+                for (unsigned long i(0) ; i < max_count ; ++i)
+                {
+                    tickets.push_back(mc::ThreadPool::instance()->enqueue(bind(&intern::csr_symmetric_partial<DT_, false>,
+                                    result.elements(), (const DT_ *)0, scatter[i], ends[i] - starts[i], a, b.elements(),
+                                    starts[i], (i + 1) * a.rows() / max_count)));
+                }
+
+                tickets.wait();
+
+                for (unsigned long i(0) ; i < max_count ; ++i)
+                {
+                    tickets.push_back(mc::ThreadPool::instance()->enqueue(bind(&intern::csr_symmetric_reduce<DT_>,
+                                    result.elements(), &scatter[0], &starts[0], &ends[0], max_count,
+                                    starts[i], (i + 1) * a.rows() / max_count)));
+                }
+
+                tickets.wait();
+
+                return result;
+            }
+
+            template <typename DT_, typename MT_>
+            static DenseVector<DT_> & value(DenseVector<DT_> & result, const SparseMatrixELL<MT_> & a, const DenseVector<DT_> & b)
             {
                 if (b.size() != a.columns())
                 {
@@ -2140,7 +2580,7 @@ namespace honei
                 for (unsigned long i(0) ; i < max_count ; ++i)
                 {
                     OperationWrapper<honei::Product<typename Tag_::DelegateTo>, DenseVector<DT_>,
-                        DenseVector<DT_>, SparseMatrixELL<DT_>, DenseVector<DT_>, unsigned long, unsigned long > wrapper(result);
+                        DenseVector<DT_>, SparseMatrixELL<MT_>, DenseVector<DT_>, unsigned long, unsigned long > wrapper(result);
                     tickets.push_back(mc::ThreadPool::instance()->enqueue(bind(wrapper, result, a, b, limits[i], limits[i+1])));
                 }
 
@@ -2149,8 +2589,8 @@ namespace honei
                 return result;
             }
 
-            template <typename DT_>
-            static DenseVector<DT_> & value(DenseVector<DT_> & result, const SparseMatrixCSR<DT_> & a, const DenseVector<DT_> & b)
+            template <typename DT_, typename MT_>
+            static DenseVector<DT_> & value(DenseVector<DT_> & result, const SparseMatrixCSR<MT_> & a, const DenseVector<DT_> & b)
             {
                 CONTEXT("When multiplying SparseMatrixCSR with DenseVector (MC):");
                 if (b.size() != a.columns())
@@ -2180,7 +2620,7 @@ namespace honei
                 for (unsigned long i(0) ; i < max_count ; ++i)
                 {
                     OperationWrapper<honei::Product<typename Tag_::DelegateTo>, DenseVector<DT_>,
-                        DenseVector<DT_>, SparseMatrixCSR<DT_>, DenseVector<DT_>, unsigned long, unsigned long > wrapper(result);
+                        DenseVector<DT_>, SparseMatrixCSR<MT_>, DenseVector<DT_>, unsigned long, unsigned long > wrapper(result);
                     tickets.push_back(mc::ThreadPool::instance()->enqueue(bind(wrapper, result, a, b, limits[i], limits[i+1])));
                 }
 
@@ -2238,16 +2678,33 @@ namespace honei
                     return honei::Product<tags::CPU>::value(a, b);
                 }
 
-            // Dummy
-            template <typename DT1_, typename DT2_>
-                static DenseMatrix<DT1_> value(const DenseMatrix<DT1_> & a, const DenseMatrix<DT2_> & b)
+            template <typename DT_>
+                static DenseMatrix<DT_> value(const DenseMatrix<DT_> & a, const DenseMatrix<DT_> & b)
                 {
                     CONTEXT("When multiplying DenseMatrix with DenseMatrix using backend : " + Tag_::name);
 
                     if (a.columns() != b.rows())
                         throw MatrixRowsDoNotMatch(b.rows(), a.columns());
 
-                    return honei::Product<tags::CPU>::value(a, b);
+                    DenseMatrix<DT_> result(a.rows(), b.columns(), DT_(0));
+
+                    unsigned long max_count(Configuration::instance()->get_value("mc::Product(DM,DM)::max_count",
+                                mc::ThreadPool::instance()->num_threads()));
+                    max_count = std::min(max_count, a.rows());
+
+                    TicketVector tickets;
+
+                    for (unsigned long i(0) ; i < max_count ; ++i)
+                    {
+                        OperationWrapper<honei::Product<typename Tag_::DelegateTo>, DenseMatrix<DT_>,
+                            DenseMatrix<DT_>, DenseMatrix<DT_>, DenseMatrix<DT_>, unsigned long, unsigned long > wrapper(result);
+                        tickets.push_back(mc::ThreadPool::instance()->enqueue(bind(wrapper, result, a, b,
+                                        i * a.rows() / max_count, (i + 1) * a.rows() / max_count)));
+                    }
+
+                    tickets.wait();
+
+                    return result;
                 }
 
             // Dummy
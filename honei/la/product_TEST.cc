@@ -26,6 +26,7 @@
 #include <honei/la/reduction.hh>
 #include <honei/util/unittest.hh>
 
+#include <algorithm>
 #include <limits>
 
 using namespace honei;
@@ -254,6 +255,10 @@ Q1MatrixDenseVectorProductTest<tags::CPU, float> q1_prod_test_float("float");
 Q1MatrixDenseVectorProductTest<tags::CPU, double> q1_prod_test_double("double");
 Q1MatrixDenseVectorProductTest<tags::CPU::MultiCore, float> q1_prod_mc_test_float("MC float");
 Q1MatrixDenseVectorProductTest<tags::CPU::MultiCore, double> q1_prod_mc_test_double("MC double");
+Q1MatrixDenseVectorProductTest<tags::CPU::Generic, float> q1_prod_generic_test_float("Generic float");
+Q1MatrixDenseVectorProductTest<tags::CPU::Generic, double> q1_prod_generic_test_double("Generic double");
+Q1MatrixDenseVectorProductTest<tags::CPU::MultiCore::Generic, float> q1_prod_mc_generic_test_float("MC Generic float");
+Q1MatrixDenseVectorProductTest<tags::CPU::MultiCore::Generic, double> q1_prod_mc_generic_test_double("MC Generic double");
 #ifdef HONEI_SSE
 Q1MatrixDenseVectorProductTest<tags::CPU::SSE, float> sse_q1_prod_test_float("float");
 Q1MatrixDenseVectorProductTest<tags::CPU::SSE, double> sse_q1_prod_test_double("double");
@@ -275,6 +280,110 @@ Q1MatrixDenseVectorProductTest<tags::OpenCL::GPU, double> ocl_gpu_q1_prod_test_d
 #endif
 #endif
 
+namespace
+{
+    /// Creates a Q1 matrix on a root x root grid with small integer bands, so that every product is exact.
+    template <typename DataType_>
+    BandedMatrixQx<Q1Type, DataType_> q1_test_matrix(unsigned long root)
+    {
+        const unsigned long size(root * root);
+        DenseVector<DataType_> bands[9] = { DenseVector<DataType_>(size), DenseVector<DataType_>(size), DenseVector<DataType_>(size),
+            DenseVector<DataType_>(size), DenseVector<DataType_>(size), DenseVector<DataType_>(size),
+            DenseVector<DataType_>(size), DenseVector<DataType_>(size), DenseVector<DataType_>(size) };
+        for (unsigned long band(0) ; band < 9 ; ++band)
+            for (unsigned long i(0) ; i < size ; ++i)
+                bands[band][i] = DataType_((i + 3 * band) % 7) - DataType_(3);
+
+        return BandedMatrixQx<Q1Type, DataType_>(size, bands[0], bands[1], bands[2], bands[3], bands[4], bands[5], bands[6], bands[7], bands[8]);
+    }
+}
+
+template <typename Tag_, typename DataType_>
+class Q1MatrixDenseVectorRangeProductTest :
+    public BaseTest
+{
+    public:
+        Q1MatrixDenseVectorRangeProductTest(const std::string & type) :
+            BaseTest("q1_matrix_dense_vector_range_product_test<" + type + ">")
+        {
+            register_tag(Tag_::name);
+        }
+
+        virtual void run() const
+        {
+            const unsigned long root(17), size(root * root), offset(5);
+            BandedMatrixQx<Q1Type, DataType_> bm(q1_test_matrix<DataType_>(root));
+
+            DenseVector<DataType_> storage(size + offset, DataType_(0));
+            DenseVector<DataType_> dv(size);
+            for (unsigned long i(0) ; i < size ; ++i)
+            {
+                dv[i] = DataType_(i % 5) - DataType_(2);
+                storage[i + offset] = dv[i];
+            }
+            const DenseVectorRange<DataType_> range(storage.range(size, offset));
+
+            DenseVector<DataType_> ref(Product<tags::CPU>::value(bm, dv));
+            DenseVector<DataType_> prod(Product<Tag_>::value(bm, range));
+            DenseVector<DataType_> prod2(size, DataType_(-1));
+            Product<Tag_>::value(prod2, bm, range);
+
+            TEST_CHECK_EQUAL(prod, ref);
+            TEST_CHECK_EQUAL(prod2, ref);
+        }
+};
+Q1MatrixDenseVectorRangeProductTest<tags::CPU, float> q1_range_prod_test_float("float");
+Q1MatrixDenseVectorRangeProductTest<tags::CPU, double> q1_range_prod_test_double("double");
+Q1MatrixDenseVectorRangeProductTest<tags::CPU::MultiCore, float> q1_range_prod_mc_test_float("MC float");
+Q1MatrixDenseVectorRangeProductTest<tags::CPU::MultiCore, double> q1_range_prod_mc_test_double("MC double");
+Q1MatrixDenseVectorRangeProductTest<tags::CPU::Generic, double> q1_range_prod_generic_test_double("Generic double");
+Q1MatrixDenseVectorRangeProductTest<tags::CPU::MultiCore::Generic, double> q1_range_prod_mc_generic_test_double("MC Generic double");
+#ifdef HONEI_SSE
+Q1MatrixDenseVectorRangeProductTest<tags::CPU::SSE, float> sse_q1_range_prod_test_float("float");
+Q1MatrixDenseVectorRangeProductTest<tags::CPU::SSE, double> sse_q1_range_prod_test_double("double");
+Q1MatrixDenseVectorRangeProductTest<tags::CPU::MultiCore::SSE, float> q1_range_prod_mc_sse_test_float("MC SSE float");
+Q1MatrixDenseVectorRangeProductTest<tags::CPU::MultiCore::SSE, double> q1_range_prod_mc_sse_test_double("MC SSE double");
+#endif
+
+template <typename Tag_>
+class Q1MatrixDenseVectorBaseProductTest :
+    public BaseTest
+{
+    public:
+        Q1MatrixDenseVectorBaseProductTest(const std::string & type) :
+            BaseTest("q1_matrix_dense_vector_base_product_test<" + type + ">")
+        {
+            register_tag(Tag_::name);
+        }
+
+        virtual void run() const
+        {
+            const unsigned long root(17), size(root * root);
+            BandedMatrixQx<Q1Type, float> bm(q1_test_matrix<float>(root));
+
+            DenseVector<float> storage(2 * size, 0.0f);
+            DenseVector<float> dv(size);
+            DenseVector<double> dv_double(size);
+            for (unsigned long i(0) ; i < size ; ++i)
+            {
+                dv[i] = float(i % 5) - 2.0f;
+                dv_double[i] = dv[i];
+                storage[2 * i] = dv[i];
+            }
+            const DenseVectorSlice<float> slice(storage, size, 0, 2);
+
+            DenseVector<float> ref(Product<tags::CPU>::value(bm, dv));
+            TEST_CHECK_EQUAL(Product<Tag_>::value(bm, slice), ref);
+            TEST_CHECK_EQUAL(Product<Tag_>::value(bm, dv_double), ref);
+
+            DenseVector<float> prod(size, -1.0f);
+            Product<Tag_>::value(prod, bm, slice);
+            TEST_CHECK_EQUAL(prod, ref);
+        }
+};
+Q1MatrixDenseVectorBaseProductTest<tags::CPU> q1_base_prod_test("float");
+Q1MatrixDenseVectorBaseProductTest<tags::CPU::Generic> q1_base_prod_generic_test("Generic float");
+
 
 
 template <typename Tag_, typename DataType_>
@@ -1038,6 +1147,153 @@ SparseMatrixCSRDenseVectorProductQuickTest<double, tags::GPU::CUDA> cuda_sparse_
 #endif
 #endif
 
+template <typename DataType_, typename Tag_>
+class SparseMatrixCompactIndicesProductTest :
+    public QuickTest
+{
+    public:
+        SparseMatrixCompactIndicesProductTest(const std::string & type) :
+            QuickTest("sparse_matrix_compact_indices_product_test<" + type + ">")
+    {
+        register_tag(Tag_::name);
+    }
+
+        virtual void run() const
+        {
+            unsigned long old_ell_width = Configuration::instance()->get_value("ell::index_width", 16);
+            unsigned long old_csr_width = Configuration::instance()->get_value("csr::index_width", 16);
+            unsigned long old_threads = Configuration::instance()->get_value("ell::threads", 1);
+            unsigned long old_blocks = Configuration::instance()->get_value("csr::blocksize", 1);
+
+            // the far off diagonal entries of the second matrix do not fit into 16 bit
+            unsigned long offsets[] = { 3, 40000 };
+            for (unsigned long o(0) ; o < 2 ; ++o)
+            {
+                unsigned long size(offsets[o] + 117);
+                SparseMatrix<DataType_> sms(size, size);
+                for (unsigned long i(0) ; i < size ; ++i)
+                {
+                    sms(i, i) = DataType_(4);
+                    if (i >= offsets[o])
+                        sms(i, i - offsets[o]) = DataType_(-1) - DataType_(i % 7) / DataType_(3);
+                    if (i + offsets[o] < size)
+                        sms(i, i + offsets[o]) = DataType_(-1);
+                    if (i > 0)
+                        sms(i, i - 1) = DataType_(0.5);
+                }
+                DenseVector<DataType_> dv(size);
+                for (unsigned long i(0) ; i < size ; ++i)
+                    dv[i] = DataType_(i % 13) / DataType_(5);
+                DenseVector<DataType_> prod_ref(Product<tags::CPU>::value(sms, dv));
+
+                for (unsigned long width(0) ; width <= 32 ; width += 16)
+                {
+                    unsigned long expected(width == 16 && o == 1 ? 32 : width);
+                    Configuration::instance()->set_value("ell::index_width", width);
+                    Configuration::instance()->set_value("csr::index_width", width);
+
+                    for (unsigned long threads(1) ; threads <= 4 ; threads *= 2)
+                    {
+                        Configuration::instance()->set_value("ell::threads", threads);
+                        SparseMatrixELL<DataType_> sm0(sms);
+                        TEST_CHECK_EQUAL(sm0.index_width(), expected);
+                        DenseVector<DataType_> prod(size, DataType_(4711));
+                        Product<Tag_>::value(prod, sm0, dv);
+                        prod.lock(lm_read_only);
+                        for (unsigned long i(0) ; i < size ; ++i)
+                            TEST_CHECK_EQUAL_WITHIN_EPS(prod[i], prod_ref[i], 1e2 * std::numeric_limits<DataType_>::epsilon());
+                        prod.unlock(lm_read_only);
+                    }
+
+                    for (unsigned long blocks(1) ; blocks <= 4 ; blocks *= 2)
+                    {
+                        Configuration::instance()->set_value("csr::blocksize", blocks);
+                        SparseMatrixCSR<DataType_> sm0(sms);
+                        TEST_CHECK_EQUAL(sm0.index_width(), expected);
+                        DenseVector<DataType_> prod(size, DataType_(4711));
+                        Product<Tag_>::value(prod, sm0, dv);
+                        prod.lock(lm_read_only);
+                        for (unsigned long i(0) ; i < size ; ++i)
+                            TEST_CHECK_EQUAL_WITHIN_EPS(prod[i], prod_ref[i], 1e2 * std::numeric_limits<DataType_>::epsilon());
+                        prod.unlock(lm_read_only);
+                    }
+                }
+            }
+
+            Configuration::instance()->set_value("ell::index_width", old_ell_width);
+            Configuration::instance()->set_value("csr::index_width", old_csr_width);
+            Configuration::instance()->set_value("ell::threads", old_threads);
+            Configuration::instance()->set_value("csr::blocksize", old_blocks);
+        }
+};
+SparseMatrixCompactIndicesProductTest<float, tags::CPU> sparse_matrix_compact_indices_product_test_float("float");
+SparseMatrixCompactIndicesProductTest<double, tags::CPU> sparse_matrix_compact_indices_product_test_double("double");
+#ifdef HONEI_SSE
+SparseMatrixCompactIndicesProductTest<float, tags::CPU::SSE> sse_sparse_matrix_compact_indices_product_test_float("float");
+SparseMatrixCompactIndicesProductTest<double, tags::CPU::SSE> sse_sparse_matrix_compact_indices_product_test_double("double");
+SparseMatrixCompactIndicesProductTest<double, tags::CPU::MultiCore::SSE> mc_sse_sparse_matrix_compact_indices_product_test_double("double");
+#endif
+
+template <typename DataType_, typename Tag_>
+class SparseMatrixCompactIndicesRectangularProductTest :
+    public QuickTest
+{
+    public:
+        SparseMatrixCompactIndicesRectangularProductTest(const std::string & type) :
+            QuickTest("sparse_matrix_compact_indices_rectangular_product_test<" + type + ">")
+    {
+        register_tag(Tag_::name);
+    }
+
+        virtual void run() const
+        {
+            unsigned long old_threads = Configuration::instance()->get_value("ell::threads", 1);
+
+            // prolongation shaped: more rows than columns and rows of different length
+            unsigned long coarse(33), fine(4 * coarse + 3);
+            SparseMatrix<DataType_> sms(fine, coarse);
+            for (unsigned long i(0) ; i < fine ; ++i)
+            {
+                unsigned long j(std::min(i / 4, coarse - 1));
+                sms(i, j) = DataType_(1);
+                if (i % 4 == 2 && j + 1 < coarse)
+                    sms(i, j + 1) = DataType_(0.5);
+            }
+
+            // the entries behind the vector are NaN, reading past its end spoils the result
+            DenseVector<DataType_> storage(coarse + 4 * fine, std::numeric_limits<DataType_>::quiet_NaN());
+            DenseVector<DataType_> dv(storage, coarse);
+            for (unsigned long i(0) ; i < coarse ; ++i)
+                dv[i] = DataType_(i % 13) / DataType_(5);
+            DenseVector<DataType_> prod_ref(Product<tags::CPU>::value(sms, dv));
+
+            for (unsigned long threads(1) ; threads <= 4 ; threads *= 2)
+            {
+                Configuration::instance()->set_value("ell::threads", threads);
+                SparseMatrixELL<DataType_> sm0(sms);
+                DenseVector<DataType_> prod(fine, DataType_(4711));
+                Product<Tag_>::value(prod, sm0, dv);
+                prod.lock(lm_read_only);
+                for (unsigned long i(0) ; i < fine ; ++i)
+                    TEST_CHECK_EQUAL_WITHIN_EPS(prod[i], prod_ref[i], 1e2 * std::numeric_limits<DataType_>::epsilon());
+                prod.unlock(lm_read_only);
+            }
+
+            // the memory pool hands the storage out again, and the padded column blocks of
+            // SparseMatrixCSR read a few entries past the end of their vector
+            for (unsigned long i(0) ; i < storage.size() ; ++i)
+                storage[i] = DataType_(0);
+
+            Configuration::instance()->set_value("ell::threads", old_threads);
+        }
+};
+SparseMatrixCompactIndicesRectangularProductTest<float, tags::CPU> sparse_matrix_compact_indices_rectangular_product_test_float("float");
+SparseMatrixCompactIndicesRectangularProductTest<double, tags::CPU> sparse_matrix_compact_indices_rectangular_product_test_double("double");
+#ifdef HONEI_SSE
+SparseMatrixCompactIndicesRectangularProductTest<float, tags::CPU::SSE> sse_sparse_matrix_compact_indices_rectangular_product_test_float("float");
+SparseMatrixCompactIndicesRectangularProductTest<double, tags::CPU::SSE> sse_sparse_matrix_compact_indices_rectangular_product_test_double("double");
+#endif
+
 template <typename DataType_>
 class SparseMatrixSparseVectorProductTest :
     public BaseTest
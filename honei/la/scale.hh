@@ -440,6 +440,15 @@ namespace honei
                 MPIOps<Tag_>::scale(x, a);
                 return x;
             }
+
+            // Dummy
+            template <typename DT1_, typename DT2_>
+            static DenseMatrix<DT1_> & value(DenseMatrix<DT1_> & x, const DT2_ a)
+            {
+                CONTEXT("When calculating Scale (DenseMatrix) using backend : " + Tag_::name);
+
+                return honei::Scale<typename Tag_::DelegateTo>::value(x, a);
+            }
         };
     }
 
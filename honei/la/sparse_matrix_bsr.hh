@@ -0,0 +1,370 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2011 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LA C++ library. LibLa is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LibLa is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#pragma once
+#ifndef LIBLA_GUARD_SPARSE_MATRIX_BSR_HH
+#define LIBLA_GUARD_SPARSE_MATRIX_BSR_HH 1
+
+#include <honei/la/dense_vector.hh>
+#include <honei/la/sparse_matrix.hh>
+#include <honei/la/sparse_matrix_csr.hh>
+#include <honei/la/sparse_matrix_ell.hh>
+#include <honei/util/exception.hh>
+#include <honei/util/stringify.hh>
+
+#include <map>
+#include <ostream>
+#include <vector>
+
+namespace honei
+{
+    /**
+     * \brief SparseMatrixBSR is a block sparse row matrix with dense R_ x R_ blocks.
+     *
+     * Coupled systems with R_ unknowns per node, like the SWE (h, q1, q2) or vector valued FEM
+     * discretisations, have small dense blocks as their non zero entries. Storing one column index
+     * per block instead of one per scalar cuts the index traffic by R_ * R_. Every block is stored
+     * column by column, the block rows in CSR format with ascending block column indices.
+     *
+     * \ingroup grpmatrix
+     */
+    template <typename DataType_, unsigned long R_> class SparseMatrixBSR
+    {
+        private:
+            /// Our row count.
+            unsigned long _rows;
+
+            /// Our column count.
+            unsigned long _columns;
+
+            /// Our number of non zero scalar elements.
+            unsigned long _used_elements;
+
+            /// Indices of the beginning block rows in _Aj.
+            DenseVector<unsigned long> _Ar;
+
+            /// Block column indices.
+            DenseVector<unsigned long> _Aj;
+
+            /// Block values, R_ * R_ per block, column major.
+            DenseVector<DataType_> _Ax;
+
+            /// Our zero element.
+            DataType_ _zero;
+
+            void _create(const SparseMatrix<DataType_> & src)
+            {
+                if (src.rows() % R_ != 0 || src.columns() % R_ != 0)
+                    throw InternalError("SparseMatrixBSR: matrix with " + stringify(src.rows()) + " rows and "
+                            + stringify(src.columns()) + " columns cannot be split into blocks of size " + stringify(R_) + "!");
+
+                std::vector<unsigned long> aj;
+                std::vector<DataType_> ax;
+                for (unsigned long block_row(0) ; block_row < _rows / R_ ; ++block_row)
+                {
+                    _Ar[block_row] = aj.size();
+
+                    std::map<unsigned long, unsigned long> blocks;
+                    for (unsigned long r(0) ; r < R_ ; ++r)
+                    {
+                        const SparseVector<DataType_> & row(src[block_row * R_ + r]);
+                        for (unsigned long i(0) ; i < row.used_elements() ; ++i)
+                            if (row.elements()[i] != DataType_(0))
+                                blocks.insert(std::make_pair(row.indices()[i] / R_, 0ul));
+                    }
+
+                    for (std::map<unsigned long, unsigned long>::iterator b(blocks.begin()), b_end(blocks.end()) ; b != b_end ; ++b)
+                    {
+                        b->second = aj.size();
+                        aj.push_back(b->first);
+                    }
+                    ax.resize(aj.size() * R_ * R_, DataType_(0));
+
+                    for (unsigned long r(0) ; r < R_ ; ++r)
+                    {
+                        const SparseVector<DataType_> & row(src[block_row * R_ + r]);
+                        for (unsigned long i(0) ; i < row.used_elements() ; ++i)
+                        {
+                            if (row.elements()[i] == DataType_(0))
+                                continue;
+
+                            const unsigned long column(row.indices()[i]);
+                            ax[blocks[column / R_] * R_ * R_ + (column % R_) * R_ + r] = row.elements()[i];
+                            ++_used_elements;
+                        }
+                    }
+                }
+                _Ar[_rows / R_] = aj.size();
+
+                DenseVector<unsigned long> taj(aj.empty() ? 1 : aj.size(), 0ul);
+                DenseVector<DataType_> tax(ax.empty() ? 1 : ax.size(), DataType_(0));
+                for (unsigned long i(0) ; i < aj.size() ; ++i)
+                    taj[i] = aj[i];
+                for (unsigned long i(0) ; i < ax.size() ; ++i)
+                    tax[i] = ax[i];
+                _Aj = taj;
+                _Ax = tax;
+            }
+
+        public:
+            typedef DataType_ DataType;
+
+            /// Our block size.
+            static const unsigned long block_size = R_;
+
+            /// \name Basic operations
+            /// \{
+
+            /**
+             * Constructor.
+             *
+             * \param rows Number of rows of the new matrix, needs to be a multiple of R_.
+             * \param columns Number of columns of the new matrix, needs to be a multiple of R_.
+             * \param Ar Indices of the beginning block rows in Aj.
+             * \param Aj Block column indices.
+             * \param Ax Block values, R_ * R_ per block, column major.
+             * \param used_elements Number of non zero scalar elements.
+             */
+            SparseMatrixBSR(unsigned long rows, unsigned long columns, const DenseVector<unsigned long> & Ar,
+                    const DenseVector<unsigned long> & Aj, const DenseVector<DataType_> & Ax, unsigned long used_elements) :
+                _rows(rows),
+                _columns(columns),
+                _used_elements(used_elements),
+                _Ar(Ar),
+                _Aj(Aj),
+                _Ax(Ax),
+                _zero(0)
+            {
+                if (rows % R_ != 0 || columns % R_ != 0)
+                    throw InternalError("SparseMatrixBSR: matrix with " + stringify(rows) + " rows and "
+                            + stringify(columns) + " columns cannot be split into blocks of size " + stringify(R_) + "!");
+            }
+
+            /**
+             * Constructor.
+             *
+             * \param src The matrix our blocks will be taken from.
+             */
+            explicit SparseMatrixBSR(const SparseMatrix<DataType_> & src) :
+                _rows(src.rows()),
+                _columns(src.columns()),
+                _used_elements(0),
+                _Ar(src.rows() / R_ + 1),
+                _Aj(1),
+                _Ax(1),
+                _zero(0)
+            {
+                _create(src);
+            }
+
+            /**
+             * Constructor.
+             *
+             * \param src The matrix our blocks will be taken from.
+             */
+            explicit SparseMatrixBSR(const SparseMatrixCSR<DataType_> & src) :
+                _rows(src.rows()),
+                _columns(src.columns()),
+                _used_elements(0),
+                _Ar(src.rows() / R_ + 1),
+                _Aj(1),
+                _Ax(1),
+                _zero(0)
+            {
+                SparseMatrix<DataType_> temp(src);
+                _create(temp);
+            }
+
+            /**
+             * Constructor.
+             *
+             * \param src The matrix our blocks will be taken from.
+             */
+            explicit SparseMatrixBSR(const SparseMatrixELL<DataType_> & src) :
+                _rows(src.rows()),
+                _columns(src.columns()),
+                _used_elements(0),
+                _Ar(src.rows() / R_ + 1),
+                _Aj(1),
+                _Ax(1),
+                _zero(0)
+            {
+                SparseMatrix<DataType_> temp(src);
+                _create(temp);
+            }
+
+            /// \}
+
+            /// Returns the number of our columns.
+            unsigned long columns() const
+            {
+                return _columns;
+            }
+
+            /// Returns the number of our rows.
+            unsigned long rows() const
+            {
+                return _rows;
+            }
+
+            /// Returns the number of our block rows.
+            unsigned long block_rows() const
+            {
+                return _rows / R_;
+            }
+
+            /// Returns the number of our non zero scalar elements.
+            unsigned long used_elements() const
+            {
+                return _used_elements;
+            }
+
+            /// Returns the number of our stored blocks.
+            unsigned long used_blocks() const
+            {
+                return _Ar[_rows / R_];
+            }
+
+            /// Returns the indices of the beginning block rows in Aj.
+            const DenseVector<unsigned long> & Ar() const
+            {
+                return _Ar;
+            }
+
+            /// Returns our block column indices.
+            const DenseVector<unsigned long> & Aj() const
+            {
+                return _Aj;
+            }
+
+            /// Returns our block values, R_ * R_ per block, column major.
+            const DenseVector<DataType_> & Ax() const
+            {
+                return _Ax;
+            }
+
+            /// Retrieves element at (row, column), unassignable.
+            const DataType_ & operator() (unsigned long row, unsigned long column) const
+            {
+                const unsigned long block_row(row / R_), block_column(column / R_);
+                for (unsigned long i(_Ar[block_row]) ; i < _Ar[block_row + 1] && _Aj[i] <= block_column ; ++i)
+                    if (_Aj[i] == block_column)
+                        return _Ax[i * R_ * R_ + (column % R_) * R_ + row % R_];
+
+                return _zero;
+            }
+
+            /// Returns a copy of the matrix.
+            SparseMatrixBSR copy() const
+            {
+                return SparseMatrixBSR(_rows, _columns, _Ar.copy(), _Aj.copy(), _Ax.copy(), _used_elements);
+            }
+    };
+
+    /**
+     * Equality operator for SparseMatrixBSR.
+     *
+     * Compares size, block structure and values of two matrices.
+     */
+    template <typename DataType_, unsigned long R_> bool operator== (const SparseMatrixBSR<DataType_, R_> & a, const SparseMatrixBSR<DataType_, R_> & b)
+    {
+        if (a.rows() != b.rows() || a.columns() != b.columns() || a.used_blocks() != b.used_blocks())
+            return false;
+
+        for (unsigned long i(0) ; i <= a.block_rows() ; ++i)
+            if (a.Ar()[i] != b.Ar()[i])
+                return false;
+
+        for (unsigned long i(0) ; i < a.used_blocks() ; ++i)
+        {
+            if (a.Aj()[i] != b.Aj()[i])
+                return false;
+            for (unsigned long j(0) ; j < R_ * R_ ; ++j)
+                if (a.Ax()[i * R_ * R_ + j] != b.Ax()[i * R_ * R_ + j])
+                    return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * Output operator for SparseMatrixBSR.
+     *
+     * Outputs the blocks of a matrix to an output stream.
+     */
+    template <typename DataType_, unsigned long R_> std::ostream & operator<< (std::ostream & lhs, const SparseMatrixBSR<DataType_, R_> & matrix)
+    {
+        lhs << "SparseMatrixBSR of size " << matrix.rows() << "x" << matrix.columns() << " with blocks of size " << R_ << " [" << std::endl;
+        for (unsigned long block_row(0) ; block_row < matrix.block_rows() ; ++block_row)
+        {
+            for (unsigned long i(matrix.Ar()[block_row]) ; i < matrix.Ar()[block_row + 1] ; ++i)
+            {
+                lhs << " block (" << block_row << ", " << matrix.Aj()[i] << ")";
+                for (unsigned long r(0) ; r < R_ ; ++r)
+                {
+                    lhs << " [";
+                    for (unsigned long c(0) ; c < R_ ; ++c)
+                        lhs << " " << matrix.Ax()[i * R_ * R_ + c * R_ + r];
+                    lhs << " ]";
+                }
+                lhs << std::endl;
+            }
+        }
+        lhs << "]" << std::endl;
+
+        return lhs;
+    }
+
+    namespace intern
+    {
+        /**
+         * Multiplies the block rows [block_row_start, block_row_end) of a BSR matrix with b.
+         * With rhs given, rhs - A * b is computed instead of A * b.
+         */
+        template <typename DT_, unsigned long R_>
+        void bsr(DT_ * result, const DT_ * rhs, const unsigned long * Ar, const unsigned long * Aj, const DT_ * Ax, const DT_ * b,
+                unsigned long block_row_start, unsigned long block_row_end)
+        {
+            for (unsigned long block_row(block_row_start) ; block_row < block_row_end ; ++block_row)
+            {
+                DT_ sum[R_];
+                for (unsigned long r(0) ; r < R_ ; ++r)
+                    sum[r] = DT_(0);
+
+                for (unsigned long i(Ar[block_row]) ; i < Ar[block_row + 1] ; ++i)
+                {
+                    const DT_ * block(Ax + i * R_ * R_);
+                    const DT_ * x(b + Aj[i] * R_);
+                    for (unsigned long c(0) ; c < R_ ; ++c)
+                        for (unsigned long r(0) ; r < R_ ; ++r)
+                            sum[r] += block[c * R_ + r] * x[c];
+                }
+
+                DT_ * y(result + block_row * R_);
+                if (rhs == 0)
+                    for (unsigned long r(0) ; r < R_ ; ++r)
+                        y[r] = sum[r];
+                else
+                    for (unsigned long r(0) ; r < R_ ; ++r)
+                        y[r] = rhs[block_row * R_ + r] - sum[r];
+            }
+        }
+    }
+}
+#endif
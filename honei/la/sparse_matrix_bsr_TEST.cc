@@ -0,0 +1,141 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2011 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LA C++ library. LibLa is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LibLa is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <honei/la/sparse_matrix_bsr.hh>
+#include <honei/la/dense_vector.hh>
+#include <honei/la/product.hh>
+#include <honei/la/sparse_matrix.hh>
+#include <honei/la/sparse_matrix_csr.hh>
+#include <honei/la/sparse_matrix_ell.hh>
+#include <honei/util/unittest.hh>
+
+#include <limits>
+
+using namespace honei;
+using namespace tests;
+
+namespace
+{
+    /// Creates a matrix of nodes x nodes blocks of size R_, coupling every node to some neighbours.
+    template <typename DT_, unsigned long R_>
+    SparseMatrix<DT_> blocked(unsigned long nodes)
+    {
+        SparseMatrix<DT_> result(nodes * R_, nodes * R_);
+        for (unsigned long node(0) ; node < nodes ; ++node)
+        {
+            unsigned long neighbours[3] = { node, (node + 1) % nodes, (node * 7 + 3) % nodes };
+            for (unsigned long n(0) ; n < 3 ; ++n)
+                for (unsigned long r(0) ; r < R_ ; ++r)
+                    for (unsigned long c(0) ; c < R_ ; ++c)
+                        if ((r + c + n + node) % 4 != 3)
+                            result(node * R_ + r, neighbours[n] * R_ + c) = DT_(1 + r) / DT_(3 + c + n) + DT_(node % 5) / DT_(7);
+        }
+
+        return result;
+    }
+}
+
+template <typename DataType_, unsigned long R_>
+class SparseMatrixBSRElementTest :
+    public QuickTest
+{
+    public:
+        SparseMatrixBSRElementTest(const std::string & type) :
+            QuickTest("sparse_matrix_bsr_element_test<" + type + ", " + stringify(R_) + ">")
+        {
+        }
+
+        virtual void run() const
+        {
+            SparseMatrix<DataType_> b(blocked<DataType_, R_>(11));
+            SparseMatrixBSR<DataType_, R_> a(b);
+
+            TEST_CHECK_EQUAL(a.rows(), 11 * R_);
+            TEST_CHECK_EQUAL(a.block_rows(), 11ul);
+            TEST_CHECK_EQUAL(a.used_elements(), b.used_elements());
+            for (unsigned long row(0) ; row < a.rows() ; ++row)
+                for (unsigned long column(0) ; column < a.columns() ; ++column)
+                    TEST_CHECK_EQUAL(a(row, column), b(row, column));
+
+            SparseMatrixCSR<DataType_> csr(b);
+            SparseMatrixBSR<DataType_, R_> c(csr);
+            TEST_CHECK_EQUAL(c, a);
+            TEST_CHECK_EQUAL(a.copy(), a);
+
+            TEST_CHECK_THROWS((SparseMatrixBSR<DataType_, R_>(SparseMatrix<DataType_>(R_ + 1, 2 * R_))), InternalError);
+        }
+};
+SparseMatrixBSRElementTest<float, 2> sparse_matrix_bsr_element_test_float_2("float");
+SparseMatrixBSRElementTest<double, 3> sparse_matrix_bsr_element_test_double_3("double");
+SparseMatrixBSRElementTest<double, 5> sparse_matrix_bsr_element_test_double_5("double");
+
+template <typename Tag_, typename DataType_, unsigned long R_>
+class SparseMatrixBSRProductQuickTest :
+    public QuickTest
+{
+    public:
+        SparseMatrixBSRProductQuickTest(const std::string & type) :
+            QuickTest("sparse_matrix_bsr_product_quick_test<" + type + ", " + stringify(R_) + ">")
+        {
+            register_tag(Tag_::name);
+        }
+
+        virtual void run() const
+        {
+            for (unsigned long nodes(1) ; nodes < 300 ; nodes += 37)
+            {
+                SparseMatrix<DataType_> b(blocked<DataType_, R_>(nodes));
+                SparseMatrixELL<DataType_> ell(b);
+                SparseMatrixBSR<DataType_, R_> a(b);
+
+                DenseVector<DataType_> x(a.columns());
+                for (unsigned long i(0) ; i < x.size() ; ++i)
+                    x[i] = DataType_(i % 13) / DataType_(5) - DataType_(1);
+
+                DenseVector<DataType_> result(a.rows(), DataType_(4711));
+                DenseVector<DataType_> reference(a.rows());
+                Product<Tag_>::value(result, a, x);
+                Product<tags::CPU>::value(reference, ell, x);
+
+                for (unsigned long i(0) ; i < result.size() ; ++i)
+                    TEST_CHECK_EQUAL_WITHIN_EPS(result[i], reference[i], std::numeric_limits<DataType_>::epsilon() * 50);
+            }
+
+            SparseMatrixBSR<DataType_, R_> a(blocked<DataType_, R_>(3));
+            DenseVector<DataType_> x(3 * R_ + 1), result(3 * R_);
+            TEST_CHECK_THROWS(Product<Tag_>::value(result, a, x), VectorSizeDoesNotMatch);
+        }
+};
+SparseMatrixBSRProductQuickTest<tags::CPU, float, 2> sparse_matrix_bsr_product_quick_test_float_2("float");
+SparseMatrixBSRProductQuickTest<tags::CPU, double, 3> sparse_matrix_bsr_product_quick_test_double_3("double");
+SparseMatrixBSRProductQuickTest<tags::CPU, double, 5> sparse_matrix_bsr_product_quick_test_double_5("double");
+SparseMatrixBSRProductQuickTest<tags::CPU::MultiCore, float, 4> mc_sparse_matrix_bsr_product_quick_test_float_4("MC float");
+SparseMatrixBSRProductQuickTest<tags::CPU::MultiCore, double, 2> mc_sparse_matrix_bsr_product_quick_test_double_2("MC double");
+SparseMatrixBSRProductQuickTest<tags::CPU::Generic, float, 3> generic_sparse_matrix_bsr_product_quick_test_float_3("Generic float");
+SparseMatrixBSRProductQuickTest<tags::CPU::Generic, double, 4> generic_sparse_matrix_bsr_product_quick_test_double_4("Generic double");
+#ifdef HONEI_SSE
+SparseMatrixBSRProductQuickTest<tags::CPU::SSE, float, 2> sse_sparse_matrix_bsr_product_quick_test_float_2("SSE float");
+SparseMatrixBSRProductQuickTest<tags::CPU::SSE, float, 3> sse_sparse_matrix_bsr_product_quick_test_float_3("SSE float");
+SparseMatrixBSRProductQuickTest<tags::CPU::SSE, float, 4> sse_sparse_matrix_bsr_product_quick_test_float_4("SSE float");
+SparseMatrixBSRProductQuickTest<tags::CPU::SSE, double, 2> sse_sparse_matrix_bsr_product_quick_test_double_2("SSE double");
+SparseMatrixBSRProductQuickTest<tags::CPU::SSE, double, 3> sse_sparse_matrix_bsr_product_quick_test_double_3("SSE double");
+SparseMatrixBSRProductQuickTest<tags::CPU::SSE, double, 4> sse_sparse_matrix_bsr_product_quick_test_double_4("SSE double");
+SparseMatrixBSRProductQuickTest<tags::CPU::MultiCore::SSE, float, 3> mc_sse_sparse_matrix_bsr_product_quick_test_float_3("MC SSE float");
+SparseMatrixBSRProductQuickTest<tags::CPU::MultiCore::SSE, double, 4> mc_sse_sparse_matrix_bsr_product_quick_test_double_4("MC SSE double");
+#endif
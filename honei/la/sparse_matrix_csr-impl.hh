@@ -24,6 +24,7 @@
 
 #include <honei/la/sparse_matrix_csr.hh>
 #include <honei/la/sparse_matrix.hh>
+#include <honei/la/compact_indices.hh>
 #include <honei/la/dense_vector.hh>
 #include <honei/la/matrix_error.hh>
 #include <honei/la/vector_error.hh>
@@ -47,6 +48,10 @@ namespace honei
         DenseVector<DataType_> Ax;//nonzero values
         DenseVector<unsigned long> Ar;//indices of beginning rows in Ax/Aj
 
+        unsigned long index_width;//width of the row relative column indices, 0 if there are none
+        DenseVector<short> Ajd16;//16 bit row relative column indices (Aj - row)
+        DenseVector<int> Ajd32;//32 bit row relative column indices (Aj - row)
+
         /// Our row count.
         unsigned long rows;
 
@@ -64,10 +69,14 @@ namespace honei
             Aj(Aj),
             Ax(Ax),
             Ar(Ar),
+            index_width(0),
+            Ajd16(1),
+            Ajd32(1),
             rows(rows),
             columns(columns),
             used_elements(used_elements)
         {
+            _compress();
         }
 
         Implementation(const SparseMatrix<DataType_> & src) :
@@ -75,6 +84,9 @@ namespace honei
             Aj(src.used_elements()),
             Ax(1),
             Ar(src.rows() + 1),
+            index_width(0),
+            Ajd16(1),
+            Ajd32(1),
             rows(src.rows()),
             columns(src.columns()),
             used_elements(0)
@@ -87,6 +99,9 @@ namespace honei
             Aj(src.used_elements()),
             Ax(1),
             Ar(src.rows() + 1),
+            index_width(0),
+            Ajd16(1),
+            Ajd32(1),
             rows(src.rows()),
             columns(src.columns()),
             used_elements(0)
@@ -133,6 +148,19 @@ namespace honei
             {
                 Ax[i] = Axv.at(i);
             }
+
+            _compress();
+        }
+
+        void _compress()
+        {
+            std::vector<long> deltas(Aj.size(), 0);
+            for (unsigned long row(0) ; row < rows ; ++row)
+            {
+                for (unsigned long i(Ar[row]) ; i < Ar[row + 1] ; ++i)
+                    deltas[i] = long(Aj[i]) - long(row);
+            }
+            index_width = intern::CompactIndices::value(deltas, Configuration::instance()->get_value("csr::index_width", 16), Ajd16, Ajd32);
         }
     };
 
@@ -225,6 +253,27 @@ namespace honei
         return this->_imp->Ar;
     }
 
+    template <typename DataType_>
+    unsigned long
+    SparseMatrixCSR<DataType_>::index_width() const
+    {
+        return this->_imp->index_width;
+    }
+
+    template <typename DataType_>
+    DenseVector<short> &
+    SparseMatrixCSR<DataType_>::Ajd16() const
+    {
+        return this->_imp->Ajd16;
+    }
+
+    template <typename DataType_>
+    DenseVector<int> &
+    SparseMatrixCSR<DataType_>::Ajd32() const
+    {
+        return this->_imp->Ajd32;
+    }
+
     template <typename DataType_>
     const DataType_ SparseMatrixCSR<DataType_>::operator() (unsigned long row, unsigned long column) const
     {
@@ -245,6 +294,8 @@ namespace honei
         this->_imp->Aj.lock(mode);
         this->_imp->Ax.lock(mode);
         this->_imp->Ar.lock(mode);
+        this->_imp->Ajd16.lock(mode);
+        this->_imp->Ajd32.lock(mode);
     }
 
     template <typename DataType_>
@@ -253,6 +304,8 @@ namespace honei
         this->_imp->Aj.unlock(mode);
         this->_imp->Ax.unlock(mode);
         this->_imp->Ar.unlock(mode);
+        this->_imp->Ajd16.unlock(mode);
+        this->_imp->Ajd32.unlock(mode);
     }
 
     template <typename DataType_>
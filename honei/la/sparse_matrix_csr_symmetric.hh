@@ -0,0 +1,359 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2011 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LA C++ library. LibLa is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LibLa is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#pragma once
+#ifndef LIBLA_GUARD_SPARSE_MATRIX_CSR_SYMMETRIC_HH
+#define LIBLA_GUARD_SPARSE_MATRIX_CSR_SYMMETRIC_HH 1
+
+#include <honei/la/dense_vector.hh>
+#include <honei/la/sparse_matrix.hh>
+#include <honei/la/sparse_matrix_ell.hh>
+#include <honei/util/exception.hh>
+#include <honei/util/stringify.hh>
+
+#include <ostream>
+
+namespace honei
+{
+    /**
+     * \brief SparseMatrixCSRSymmetric is a half storage representation of a symmetric sparse matrix.
+     *
+     * Only the diagonal and the strictly upper triangle are stored, the latter in CSR format with
+     * ascending column indices per row. The lower triangle of the source matrix is ignored, so the
+     * caller has to make sure that the source is symmetric, like the system matrices of SPD problems.
+     *
+     * \ingroup grpmatrix
+     */
+    template <typename DataType_> class SparseMatrixCSRSymmetric
+    {
+        private:
+            /// Our size.
+            unsigned long _size;
+
+            /// Our number of non zero elements, counting both triangles.
+            unsigned long _used_elements;
+
+            /// Our diagonal.
+            DenseVector<DataType_> _diagonal;
+
+            /// Indices of the beginning rows in _Ax/_Aj.
+            DenseVector<unsigned long> _Ar;
+
+            /// Column indices of the upper triangle.
+            DenseVector<unsigned long> _Aj;
+
+            /// Values of the upper triangle.
+            DenseVector<DataType_> _Ax;
+
+            /// One past the largest column index used by the rows up to and including a given row.
+            DenseVector<unsigned long> _reach;
+
+            /// Our zero element.
+            DataType_ _zero;
+
+            void _create(const SparseMatrix<DataType_> & src)
+            {
+                if (src.rows() != src.columns())
+                    throw InternalError("SparseMatrixCSRSymmetric: matrix with " + stringify(src.rows()) + " rows and "
+                            + stringify(src.columns()) + " columns is not square!");
+
+                unsigned long upper(0);
+                for (unsigned long row(0) ; row < _size ; ++row)
+                {
+                    const SparseVector<DataType_> & r(src[row]);
+                    for (unsigned long i(0) ; i < r.used_elements() ; ++i)
+                        if (r.indices()[i] > row)
+                            ++upper;
+                }
+
+                DenseVector<unsigned long> aj(upper == 0 ? 1 : upper);
+                DenseVector<DataType_> ax(upper == 0 ? 1 : upper);
+                unsigned long gi(0), reach(0);
+                for (unsigned long row(0) ; row < _size ; ++row)
+                {
+                    const SparseVector<DataType_> & r(src[row]);
+                    _Ar[row] = gi;
+                    _diagonal[row] = DataType_(0);
+                    for (unsigned long i(0) ; i < r.used_elements() ; ++i)
+                    {
+                        const unsigned long column(r.indices()[i]);
+                        if (r.elements()[i] == DataType_(0))
+                            continue;
+
+                        if (column == row)
+                        {
+                            _diagonal[row] = r.elements()[i];
+                            ++_used_elements;
+                        }
+                        else if (column > row)
+                        {
+                            aj[gi] = column;
+                            ax[gi] = r.elements()[i];
+                            ++gi;
+                            _used_elements += 2;
+                        }
+                    }
+                    if (gi > _Ar[row] && aj[gi - 1] + 1 > reach)
+                        reach = aj[gi - 1] + 1;
+                    _reach[row] = reach > row + 1 ? reach : row + 1;
+                }
+                _Ar[_size] = gi;
+                _Aj = aj;
+                _Ax = ax;
+            }
+
+        public:
+            typedef DataType_ DataType;
+
+            /// \name Basic operations
+            /// \{
+
+            /**
+             * Constructor.
+             *
+             * \param src The symmetric matrix our upper triangle will be taken from.
+             */
+            explicit SparseMatrixCSRSymmetric(const SparseMatrix<DataType_> & src) :
+                _size(src.rows()),
+                _used_elements(0),
+                _diagonal(src.rows()),
+                _Ar(src.rows() + 1),
+                _Aj(1),
+                _Ax(1),
+                _reach(src.rows()),
+                _zero(0)
+            {
+                _create(src);
+            }
+
+            /**
+             * Constructor.
+             *
+             * \param src The symmetric matrix our upper triangle will be taken from.
+             */
+            explicit SparseMatrixCSRSymmetric(const SparseMatrixELL<DataType_> & src) :
+                _size(src.rows()),
+                _used_elements(0),
+                _diagonal(src.rows()),
+                _Ar(src.rows() + 1),
+                _Aj(1),
+                _Ax(1),
+                _reach(src.rows()),
+                _zero(0)
+            {
+                SparseMatrix<DataType_> temp(src);
+                _create(temp);
+            }
+
+            /// \}
+
+            /// Returns the number of our columns.
+            unsigned long columns() const
+            {
+                return _size;
+            }
+
+            /// Returns the number of our rows.
+            unsigned long rows() const
+            {
+                return _size;
+            }
+
+            /// Returns our size, equal to rows and columns.
+            unsigned long size() const
+            {
+                return _size;
+            }
+
+            /// Returns the number of our non zero elements, counting both triangles.
+            unsigned long used_elements() const
+            {
+                return _used_elements;
+            }
+
+            /// Returns our diagonal.
+            const DenseVector<DataType_> & diagonal() const
+            {
+                return _diagonal;
+            }
+
+            /// Returns the row start indices of our upper triangle.
+            const DenseVector<unsigned long> & Ar() const
+            {
+                return _Ar;
+            }
+
+            /// Returns the column indices of our upper triangle.
+            const DenseVector<unsigned long> & Aj() const
+            {
+                return _Aj;
+            }
+
+            /// Returns the values of our upper triangle.
+            const DenseVector<DataType_> & Ax() const
+            {
+                return _Ax;
+            }
+
+            /// Returns one past the largest column index that is used by the rows [0, row].
+            unsigned long reach(unsigned long row) const
+            {
+                return _reach[row];
+            }
+
+            /// Retrieves element at (row, column), unassignable.
+            const DataType_ & operator() (unsigned long row, unsigned long column) const
+            {
+                if (row == column)
+                    return _diagonal[row];
+
+                if (row > column)
+                {
+                    unsigned long t(row);
+                    row = column;
+                    column = t;
+                }
+
+                for (unsigned long i(_Ar[row]) ; i < _Ar[row + 1] && _Aj[i] <= column ; ++i)
+                    if (_Aj[i] == column)
+                        return _Ax[i];
+
+                return _zero;
+            }
+
+            /// Returns a copy of the matrix.
+            SparseMatrixCSRSymmetric copy() const
+            {
+                SparseMatrixCSRSymmetric result(*this);
+                result._diagonal = _diagonal.copy();
+                result._Ar = _Ar.copy();
+                result._Aj = _Aj.copy();
+                result._Ax = _Ax.copy();
+                result._reach = _reach.copy();
+                return result;
+            }
+    };
+
+    /**
+     * Equality operator for SparseMatrixCSRSymmetric.
+     *
+     * Compares diagonal and upper triangle of two matrices.
+     */
+    template <typename DataType_> bool operator== (const SparseMatrixCSRSymmetric<DataType_> & a, const SparseMatrixCSRSymmetric<DataType_> & b)
+    {
+        if (a.size() != b.size() || a.used_elements() != b.used_elements())
+            return false;
+
+        return a.diagonal() == b.diagonal() && a.Ar() == b.Ar() && a.Aj() == b.Aj() && a.Ax() == b.Ax();
+    }
+
+    /**
+     * Output operator for SparseMatrixCSRSymmetric.
+     *
+     * Outputs the diagonal and upper triangle of a matrix to an output stream.
+     */
+    template <typename DataType_> std::ostream & operator<< (std::ostream & lhs, const SparseMatrixCSRSymmetric<DataType_> & matrix)
+    {
+        lhs << "SparseMatrixCSRSymmetric of size " << matrix.size() << " [" << std::endl;
+        for (unsigned long row(0) ; row < matrix.rows() ; ++row)
+        {
+            lhs << " (" << row << ", " << row << ") " << matrix.diagonal()[row];
+            for (unsigned long i(matrix.Ar()[row]) ; i < matrix.Ar()[row + 1] ; ++i)
+                lhs << " (" << row << ", " << matrix.Aj()[i] << ") " << matrix.Ax()[i];
+            lhs << std::endl;
+        }
+        lhs << "]" << std::endl;
+
+        return lhs;
+    }
+
+    namespace intern
+    {
+        /**
+         * Applies the rows [row_start, row_end) of a half stored symmetric matrix to b.
+         *
+         * Every stored upper entry a_ij contributes a_ij * b_j to result_i and, as its transpose,
+         * a_ij * b_i to scatter[j - scatter_offset]. Both targets have to be initialised by the caller.
+         * With defect_ set, all contributions are subtracted instead of added.
+         */
+        template <typename DT_, bool defect_>
+        void csr_symmetric(DT_ * result, DT_ * scatter, unsigned long scatter_offset, const DT_ * diagonal,
+                const unsigned long * Ar, const unsigned long * Aj, const DT_ * Ax, const DT_ * b,
+                unsigned long row_start, unsigned long row_end)
+        {
+            for (unsigned long row(row_start) ; row < row_end ; ++row)
+            {
+                const DT_ b_row(b[row]);
+                DT_ sum(diagonal[row] * b_row);
+                const unsigned long end(Ar[row + 1]);
+                for (unsigned long i(Ar[row]) ; i < end ; ++i)
+                {
+                    const unsigned long column(Aj[i]);
+                    sum += Ax[i] * b[column];
+                    if (defect_)
+                        scatter[column - scatter_offset] -= Ax[i] * b_row;
+                    else
+                        scatter[column - scatter_offset] += Ax[i] * b_row;
+                }
+                if (defect_)
+                    result[row] -= sum;
+                else
+                    result[row] += sum;
+            }
+        }
+
+        /**
+         * First pass of the multicore product: initialises the rows [row_start, row_end) of result with
+         * rhs (or zero if rhs is 0), clears the private scatter buffer of this block and applies the block.
+         * The transposed contributions only reach into the private buffer, so no two blocks write to
+         * the same element.
+         */
+        template <typename DT_, bool defect_>
+        void csr_symmetric_partial(DT_ * result, const DT_ * rhs, DT_ * scatter, unsigned long scatter_size,
+                const SparseMatrixCSRSymmetric<DT_> & a, const DT_ * b, unsigned long row_start, unsigned long row_end)
+        {
+            for (unsigned long row(row_start) ; row < row_end ; ++row)
+                result[row] = rhs == 0 ? DT_(0) : rhs[row];
+            for (unsigned long i(0) ; i < scatter_size ; ++i)
+                scatter[i] = DT_(0);
+
+            csr_symmetric<DT_, defect_>(result, scatter, row_start, a.diagonal().elements(), a.Ar().elements(), a.Aj().elements(),
+                    a.Ax().elements(), b, row_start, row_end);
+        }
+
+        /**
+         * Second pass of the multicore product: adds the private scatter buffers of all blocks to the
+         * rows [row_start, row_end) of result. Buffer i covers the rows [starts[i], ends[i]).
+         */
+        template <typename DT_>
+        void csr_symmetric_reduce(DT_ * result, DT_ * const * scatter, const unsigned long * starts, const unsigned long * ends,
+                unsigned long count, unsigned long row_start, unsigned long row_end)
+        {
+            for (unsigned long p(0) ; p < count ; ++p)
+            {
+                const unsigned long start(starts[p] > row_start ? starts[p] : row_start);
+                const unsigned long end(ends[p] < row_end ? ends[p] : row_end);
+                const DT_ * s(scatter[p]);
+                for (unsigned long row(start) ; row < end ; ++row)
+                    result[row] += s[row - starts[p]];
+            }
+        }
+    }
+}
+#endif
@@ -0,0 +1,147 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2011 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LA C++ library. LibLa is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LibLa is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <honei/la/sparse_matrix_csr_symmetric.hh>
+#include <honei/la/dense_vector.hh>
+#include <honei/la/product.hh>
+#include <honei/la/sparse_matrix.hh>
+#include <honei/la/sparse_matrix_ell.hh>
+#include <honei/backends/multicore/thread_pool.hh>
+#include <honei/util/configuration.hh>
+#include <honei/util/unittest.hh>
+
+#include <cmath>
+#include <limits>
+
+using namespace honei;
+using namespace tests;
+
+namespace
+{
+    /// Creates a symmetric matrix with a 5 point stencil pattern and some far off couplings.
+    template <typename DT_>
+    SparseMatrix<DT_> symmetric(unsigned long root)
+    {
+        const unsigned long size(root * root);
+        SparseMatrix<DT_> result(size, size);
+        for (unsigned long i(0) ; i < size ; ++i)
+        {
+            result(i, i) = DT_(4) + DT_(i % 5);
+            if (i + 1 < size)
+                result(i, i + 1) = result(i + 1, i) = DT_(-1) - DT_(i % 3) / DT_(7);
+            if (i + root < size)
+                result(i, i + root) = result(i + root, i) = DT_(-1) + DT_(i % 4) / DT_(9);
+            if (i % 17 == 0 && i + size / 2 < size)
+                result(i, i + size / 2) = result(i + size / 2, i) = DT_(0.5);
+        }
+
+        return result;
+    }
+}
+
+template <typename DataType_>
+class SparseMatrixCSRSymmetricElementTest :
+    public QuickTest
+{
+    public:
+        SparseMatrixCSRSymmetricElementTest(const std::string & type) :
+            QuickTest("sparse_matrix_csr_symmetric_element_test<" + type + ">")
+        {
+        }
+
+        virtual void run() const
+        {
+            SparseMatrix<DataType_> b(symmetric<DataType_>(7));
+            SparseMatrixCSRSymmetric<DataType_> a(b);
+
+            TEST_CHECK_EQUAL(a.used_elements(), b.used_elements());
+            for (unsigned long row(0) ; row < a.rows() ; ++row)
+                for (unsigned long column(0) ; column < a.columns() ; ++column)
+                    TEST_CHECK_EQUAL(a(row, column), b(row, column));
+
+            SparseMatrixELL<DataType_> ell(b);
+            SparseMatrixCSRSymmetric<DataType_> c(ell);
+            TEST_CHECK_EQUAL(c, a);
+            TEST_CHECK_EQUAL(a.copy(), a);
+
+            TEST_CHECK_THROWS(SparseMatrixCSRSymmetric<DataType_>(SparseMatrix<DataType_>(4, 5)), InternalError);
+        }
+};
+SparseMatrixCSRSymmetricElementTest<float> sparse_matrix_csr_symmetric_element_test_float("float");
+SparseMatrixCSRSymmetricElementTest<double> sparse_matrix_csr_symmetric_element_test_double("double");
+
+template <typename Tag_, typename DataType_>
+class SparseMatrixCSRSymmetricProductQuickTest :
+    public QuickTest
+{
+    public:
+        SparseMatrixCSRSymmetricProductQuickTest(const std::string & type) :
+            QuickTest("sparse_matrix_csr_symmetric_product_quick_test<" + type + ">")
+        {
+            register_tag(Tag_::name);
+        }
+
+        virtual void run() const
+        {
+            unsigned long old_count(Configuration::instance()->get_value("mc::Product(DV,SMCSRS,DV)::max_count",
+                        mc::ThreadPool::instance()->num_threads()));
+            for (unsigned long root(1) ; root < 70 ; root += 7)
+            {
+                const unsigned long size(root * root);
+                SparseMatrix<DataType_> b(symmetric<DataType_>(root));
+                SparseMatrixELL<DataType_> ell(b);
+                SparseMatrixCSRSymmetric<DataType_> a(b);
+
+                DenseVector<DataType_> x(size);
+                for (unsigned long i(0) ; i < size ; ++i)
+                    x[i] = DataType_(i % 13) / DataType_(5) - DataType_(1);
+
+                DenseVector<DataType_> reference(size);
+                Product<tags::CPU>::value(reference, ell, x);
+
+                // the multicore backends split the rows into this many blocks
+                for (unsigned long count(1) ; count <= 16 ; count *= 2)
+                {
+                    Configuration::instance()->set_value("mc::Product(DV,SMCSRS,DV)::max_count", count);
+                    DenseVector<DataType_> result(size, DataType_(4711));
+                    Product<Tag_>::value(result, a, x);
+
+                    for (unsigned long i(0) ; i < size ; ++i)
+                        TEST_CHECK_EQUAL_WITHIN_EPS(result[i], reference[i], std::numeric_limits<DataType_>::epsilon() * 50);
+                }
+            }
+            Configuration::instance()->set_value("mc::Product(DV,SMCSRS,DV)::max_count", old_count);
+
+            SparseMatrixCSRSymmetric<DataType_> a(symmetric<DataType_>(3));
+            DenseVector<DataType_> x(10), result(9);
+            TEST_CHECK_THROWS(Product<Tag_>::value(result, a, x), VectorSizeDoesNotMatch);
+        }
+};
+SparseMatrixCSRSymmetricProductQuickTest<tags::CPU, float> sparse_matrix_csr_symmetric_product_quick_test_float("float");
+SparseMatrixCSRSymmetricProductQuickTest<tags::CPU, double> sparse_matrix_csr_symmetric_product_quick_test_double("double");
+SparseMatrixCSRSymmetricProductQuickTest<tags::CPU::MultiCore, float> mc_sparse_matrix_csr_symmetric_product_quick_test_float("MC float");
+SparseMatrixCSRSymmetricProductQuickTest<tags::CPU::MultiCore, double> mc_sparse_matrix_csr_symmetric_product_quick_test_double("MC double");
+SparseMatrixCSRSymmetricProductQuickTest<tags::CPU::Generic, float> generic_sparse_matrix_csr_symmetric_product_quick_test_float("Generic float");
+SparseMatrixCSRSymmetricProductQuickTest<tags::CPU::Generic, double> generic_sparse_matrix_csr_symmetric_product_quick_test_double("Generic double");
+#ifdef HONEI_SSE
+SparseMatrixCSRSymmetricProductQuickTest<tags::CPU::SSE, float> sse_sparse_matrix_csr_symmetric_product_quick_test_float("SSE float");
+SparseMatrixCSRSymmetricProductQuickTest<tags::CPU::SSE, double> sse_sparse_matrix_csr_symmetric_product_quick_test_double("SSE double");
+SparseMatrixCSRSymmetricProductQuickTest<tags::CPU::MultiCore::SSE, float> mc_sse_sparse_matrix_csr_symmetric_product_quick_test_float("MC SSE float");
+SparseMatrixCSRSymmetricProductQuickTest<tags::CPU::MultiCore::SSE, double> mc_sse_sparse_matrix_csr_symmetric_product_quick_test_double("MC SSE double");
+#endif
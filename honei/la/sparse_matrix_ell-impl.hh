@@ -24,6 +24,7 @@
 
 #include <honei/la/sparse_matrix_ell.hh>
 #include <honei/la/sparse_matrix_csr.hh>
+#include <honei/la/compact_indices.hh>
 #include <honei/la/sparse_matrix.hh>
 #include <honei/la/dense_vector.hh>
 #include <honei/la/matrix_error.hh>
@@ -35,7 +36,9 @@
 #include <honei/util/stringify.hh>
 #include <honei/util/configuration.hh>
 
+#include <algorithm>
 #include <cmath>
+#include <vector>
 
 namespace honei
 {
@@ -49,6 +52,10 @@ namespace honei
         DenseVector<DataType_> Ax;//nonzero values stored in a (cols_per_row x stride) matrix
         DenseVector<unsigned long> Arl;//length of every single row
 
+        unsigned long index_width;//width of the row relative column indices, 0 if there are none
+        DenseVector<short> Ajd16;//16 bit row relative column indices (column - row)
+        DenseVector<int> Ajd32;//32 bit row relative column indices (column - row)
+
         /// Our row count.
         unsigned long rows;
 
@@ -66,10 +73,14 @@ namespace honei
             Aj(Aj),
             Ax(Ax),
             Arl(1),
+            index_width(0),
+            Ajd16(1),
+            Ajd32(1),
             rows(rows),
             columns(columns)
         {
             Arl = row_length();
+            _compress();
         }
 
         Implementation(const SparseMatrix<DataType_> & src) :
@@ -77,6 +88,9 @@ namespace honei
             Aj(1),
             Ax(1),
             Arl(src.rows(), 0),
+            index_width(0),
+            Ajd16(1),
+            Ajd32(1),
             rows(src.rows()),
             columns(src.columns())
         {
@@ -119,6 +133,7 @@ namespace honei
 
             Aj = pAj;
             Ax = pAx;
+            _compress();
         }
 
         Implementation(const SparseMatrixCSR<DataType_> & src) :
@@ -126,6 +141,9 @@ namespace honei
             Aj(1),
             Ax(1),
             Arl(src.rows(), 0),
+            index_width(0),
+            Ajd16(1),
+            Ajd32(1),
             rows(src.rows()),
             columns(src.columns())
         {
@@ -180,9 +198,30 @@ namespace honei
 
             Aj = pAj;
             Ax = pAx;
+            _compress();
         }
 
         private:
+        void _compress()
+        {
+            std::vector<long> deltas(Aj.size(), 0);
+            for (unsigned long i(0) ; i < Aj.size() ; ++i)
+            {
+                const unsigned long position(i % stride);
+                if (position >= rows * threads)
+                    continue;
+
+                const long row(position / threads);
+                // Padding and explicit zeros are still read by the kernels, so they have to
+                // decode to a valid column, even for rectangular matrices with rows > columns.
+                if (Ax[i] != DataType_(0))
+                    deltas[i] = long(Aj[i]) - row;
+                else if (columns > 0)
+                    deltas[i] = std::min(row, long(columns) - 1) - row;
+            }
+            index_width = intern::CompactIndices::value(deltas, Configuration::instance()->get_value("ell::index_width", 16), Ajd16, Ajd32);
+        }
+
         DenseVector<unsigned long> row_length()
         {
             DenseVector<unsigned long> rl(rows, 0);
@@ -322,6 +361,27 @@ namespace honei
         return this->_imp->Arl;
     }
 
+    template <typename DataType_>
+    unsigned long
+    SparseMatrixELL<DataType_>::index_width() const
+    {
+        return this->_imp->index_width;
+    }
+
+    template <typename DataType_>
+    DenseVector<short> &
+    SparseMatrixELL<DataType_>::Ajd16() const
+    {
+        return this->_imp->Ajd16;
+    }
+
+    template <typename DataType_>
+    DenseVector<int> &
+    SparseMatrixELL<DataType_>::Ajd32() const
+    {
+        return this->_imp->Ajd32;
+    }
+
     template <typename DataType_>
     const DataType_ SparseMatrixELL<DataType_>::operator() (unsigned long row, unsigned long column) const
     {
@@ -343,6 +403,8 @@ namespace honei
         this->_imp->Aj.lock(mode);
         this->_imp->Ax.lock(mode);
         this->_imp->Arl.lock(mode);
+        this->_imp->Ajd16.lock(mode);
+        this->_imp->Ajd32.lock(mode);
     }
 
     template <typename DataType_>
@@ -351,6 +413,8 @@ namespace honei
         this->_imp->Aj.unlock(mode);
         this->_imp->Ax.unlock(mode);
         this->_imp->Arl.unlock(mode);
+        this->_imp->Ajd16.unlock(mode);
+        this->_imp->Ajd32.unlock(mode);
     }
 
     template <typename DataType_>
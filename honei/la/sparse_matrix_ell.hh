@@ -115,6 +115,21 @@ namespace honei
             /// Retrieves our Arl (row length) vector.
             DenseVector<unsigned long> & Arl() const;
 
+            /**
+             * Returns the width in bits of our row relative column indices, 16 or 32; 0 if only Aj is
+             * available.  The widest allowed width is read from ell::index_width.
+             *
+             * The row relative indices are built from Aj and Ax on construction only; they go stale
+             * if Aj or Ax are modified through their accessors afterwards.
+             */
+            unsigned long index_width() const;
+
+            /// Retrieves our 16 bit row relative column indices (column - row), valid if index_width() is 16.
+            DenseVector<short> & Ajd16() const;
+
+            /// Retrieves our 32 bit row relative column indices (column - row), valid if index_width() is 32.
+            DenseVector<int> & Ajd32() const;
+
             /// Retrieves element at (row, column), unassignable.
             const DataType_ operator() (unsigned long row, unsigned long column) const;
 
@@ -79,6 +79,30 @@ namespace honei
 
     template std::ostream & operator<< (std::ostream & lhs, const SparseVector<unsigned long> & vector);
 
+    template class ConstElementIterator<storage::Sparse, container::Vector, int>;
+
+    template class ConstElementIterator<storage::SparseNonZero, container::Vector, int>;
+
+    template class SparseVector<int>;
+
+    template class ElementIterator<storage::Sparse, container::Vector, int>;
+
+    template class ElementIterator<storage::SparseNonZero, container::Vector, int>;
+
+    template std::ostream & operator<< (std::ostream & lhs, const SparseVector<int> & vector);
+
+    template class ConstElementIterator<storage::Sparse, container::Vector, short>;
+
+    template class ConstElementIterator<storage::SparseNonZero, container::Vector, short>;
+
+    template class SparseVector<short>;
+
+    template class ElementIterator<storage::Sparse, container::Vector, short>;
+
+    template class ElementIterator<storage::SparseNonZero, container::Vector, short>;
+
+    template std::ostream & operator<< (std::ostream & lhs, const SparseVector<short> & vector);
+
     template class ConstElementIterator<storage::Sparse, container::Vector, bool>;
 
     template class ConstElementIterator<storage::SparseNonZero, container::Vector, bool>;
@@ -201,6 +201,14 @@ namespace honei
 
     extern template std::ostream & operator<< (std::ostream & lhs, const SparseVector<unsigned long> & vector);
 
+    extern template class SparseVector<int>;
+
+    extern template std::ostream & operator<< (std::ostream & lhs, const SparseVector<int> & vector);
+
+    extern template class SparseVector<short>;
+
+    extern template std::ostream & operator<< (std::ostream & lhs, const SparseVector<short> & vector);
+
 #ifdef HONEI_GMP
     extern template class SparseVector<mpf_class>;
 
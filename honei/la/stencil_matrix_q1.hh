@@ -0,0 +1,234 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2011 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LA C++ library. LibLa is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LibLa is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#pragma once
+#ifndef LIBLA_GUARD_STENCIL_MATRIX_Q1_HH
+#define LIBLA_GUARD_STENCIL_MATRIX_Q1_HH 1
+
+#include <honei/la/band_type.hh>
+#include <honei/util/exception.hh>
+#include <honei/util/stringify.hh>
+
+#include <cmath>
+#include <ostream>
+
+namespace honei
+{
+    /**
+     * \brief StencilMatrixQ1 is a matrix free representation of a Q1 system matrix on a
+     * \brief structured square grid.
+     *
+     * The matrix has the same structure as a BandedMatrixQx<Q1Type>, but instead of nine
+     * full bands only the nine coefficients of the constant 3x3 stencil are stored. All rows
+     * belonging to the boundary of the grid are Dirichlet unit rows, like the matrices created
+     * by FillMatrix<Tag_, applications::POISSON, boundary_types::DIRICHLET::DIRICHLET_0>.
+     *
+     * \ingroup grpmatrix
+     */
+    template <typename DataType_> class StencilMatrixQ1
+    {
+        private:
+            /// Our size.
+            unsigned long _size;
+
+            /// The square root of our size.
+            signed long _root;
+
+            /// Our stencil, indexed by Q1BandIndex.
+            DataType_ _stencil[9];
+
+            /// Our zero and unit element.
+            DataType_ _zero, _one;
+
+        public:
+            typedef DataType_ DataType;
+
+            /// \name Basic operations
+            /// \{
+
+            /**
+             * Constructor.
+             *
+             * \param size Size of the new matrix, needs to be a square number.
+             * \param ll..uu The stencil coefficients for all inner grid points.
+             */
+            StencilMatrixQ1(unsigned long size,
+                    DataType_ ll, DataType_ ld, DataType_ lu,
+                    DataType_ dl, DataType_ dd, DataType_ du,
+                    DataType_ ul, DataType_ ud, DataType_ uu) :
+                _size(size),
+                _root(static_cast<signed long>(std::sqrt(double(size)) + 0.5)),
+                _zero(0),
+                _one(1)
+            {
+                if ((unsigned long)(_root * _root) != size)
+                    throw InternalError("StencilMatrixQ1: size '" + stringify(size) + "' is not a square number!");
+
+                _stencil[LL] = ll;
+                _stencil[LD] = ld;
+                _stencil[LU] = lu;
+                _stencil[DL] = dl;
+                _stencil[DD] = dd;
+                _stencil[DU] = du;
+                _stencil[UL] = ul;
+                _stencil[UD] = ud;
+                _stencil[UU] = uu;
+            }
+
+            /// \}
+
+            /// Returns the number of our columns.
+            unsigned long columns() const
+            {
+                return _size;
+            }
+
+            /// Returns the number of our rows.
+            unsigned long rows() const
+            {
+                return _size;
+            }
+
+            /// Returns our size, equal to rows and columns.
+            unsigned long size() const
+            {
+                return _size;
+            }
+
+            /// Returns the square root of our size.
+            signed long root() const
+            {
+                return _root;
+            }
+
+            /// Returns the stencil coefficient for a given band.
+            DataType_ coefficient(unsigned long index) const
+            {
+                return _stencil[index];
+            }
+
+            /// Returns our stencil, indexed by Q1BandIndex.
+            const DataType_ * stencil() const
+            {
+                return _stencil;
+            }
+
+            /// Returns true if row belongs to the boundary of the grid.
+            bool boundary(unsigned long row) const
+            {
+                const unsigned long m(_root);
+                const unsigned long y(row / m), x(row % m);
+                return y == 0 || y == m - 1 || x == 0 || x == m - 1;
+            }
+
+            /// Retrieves element at (row, column), unassignable.
+            const DataType_ & operator() (unsigned long row, unsigned long column) const
+            {
+                if (boundary(row))
+                    return row == column ? _one : _zero;
+
+                const signed long offset(static_cast<signed long>(column) - static_cast<signed long>(row));
+                for (int dy(-1) ; dy <= 1 ; ++dy)
+                    for (int dx(-1) ; dx <= 1 ; ++dx)
+                        if (offset == dy * _root + dx)
+                            return _stencil[(dy + 1) * 3 + dx + 1];
+
+                return _zero;
+            }
+
+            /// Returns a copy of the matrix.
+            StencilMatrixQ1 copy() const
+            {
+                return *this;
+            }
+    };
+
+    /**
+     * Equality operator for StencilMatrixQ1.
+     *
+     * Compares size and stencil of two matrices.
+     */
+    template <typename DataType_> bool operator== (const StencilMatrixQ1<DataType_> & a, const StencilMatrixQ1<DataType_> & b)
+    {
+        if (a.size() != b.size())
+            return false;
+
+        for (unsigned long i(0) ; i < 9 ; ++i)
+            if (a.coefficient(i) != b.coefficient(i))
+                return false;
+
+        return true;
+    }
+
+    /**
+     * Output operator for StencilMatrixQ1.
+     *
+     * Outputs the size and stencil of a matrix to an output stream.
+     */
+    template <typename DataType_> std::ostream & operator<< (std::ostream & lhs, const StencilMatrixQ1<DataType_> & matrix)
+    {
+        lhs << "StencilMatrixQ1 of size " << matrix.size() << " [" << std::endl;
+        for (unsigned long i(0) ; i < 9 ; i += 3)
+            lhs << " " << matrix.coefficient(i) << " " << matrix.coefficient(i + 1) << " " << matrix.coefficient(i + 2) << std::endl;
+        lhs << "]" << std::endl;
+
+        return lhs;
+    }
+
+    namespace intern
+    {
+        /**
+         * Applies a Q1 stencil to the rows [row_start, row_end) of a square grid with m * m points.
+         * With defect_ set, rhs - A * b is computed instead of A * b.
+         */
+        template <typename DT_, bool defect_>
+        void stencil_q1(DT_ * result, const DT_ * rhs, const DT_ * s, const DT_ * b,
+                unsigned long m, unsigned long row_start, unsigned long row_end)
+        {
+            for (unsigned long i(row_start) ; i < row_end ; )
+            {
+                const unsigned long y(i / m);
+                const unsigned long line_end((y + 1) * m < row_end ? (y + 1) * m : row_end);
+
+                if (y != 0 && y != m - 1)
+                {
+                    if (i % m == 0)
+                    {
+                        result[i] = defect_ ? rhs[i] - b[i] : b[i];
+                        ++i;
+                    }
+
+                    const unsigned long inner_end(y * m + m - 1 < line_end ? y * m + m - 1 : line_end);
+                    for ( ; i < inner_end ; ++i)
+                    {
+                        DT_ sum(s[DD] * b[i] + s[DL] * b[i - 1] + s[DU] * b[i + 1]
+                                + s[LL] * b[i - m - 1] + s[LD] * b[i - m] + s[LU] * b[i - m + 1]
+                                + s[UL] * b[i + m - 1] + s[UD] * b[i + m] + s[UU] * b[i + m + 1]);
+                        result[i] = defect_ ? rhs[i] - sum : sum;
+                    }
+                }
+
+                // Dirichlet unit rows
+                for ( ; i < line_end ; ++i)
+                    result[i] = defect_ ? rhs[i] - b[i] : b[i];
+            }
+        }
+    }
+}
+#endif
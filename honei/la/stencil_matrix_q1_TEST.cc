@@ -0,0 +1,136 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2011 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LA C++ library. LibLa is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LibLa is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <honei/la/stencil_matrix_q1.hh>
+#include <honei/la/banded_matrix_qx.hh>
+#include <honei/la/dense_vector.hh>
+#include <honei/la/product.hh>
+#include <honei/util/unittest.hh>
+
+#include <cmath>
+#include <limits>
+
+using namespace honei;
+using namespace tests;
+
+namespace
+{
+    /// Creates the BandedMatrixQx equivalent to a StencilMatrixQ1.
+    template <typename DT_>
+    BandedMatrixQx<Q1Type, DT_> banded(const StencilMatrixQ1<DT_> & a)
+    {
+        const unsigned long size(a.size());
+        DenseVector<DT_> bands[9] = {
+            DenseVector<DT_>(size, DT_(0)), DenseVector<DT_>(size, DT_(0)), DenseVector<DT_>(size, DT_(0)),
+            DenseVector<DT_>(size, DT_(0)), DenseVector<DT_>(size, DT_(0)), DenseVector<DT_>(size, DT_(0)),
+            DenseVector<DT_>(size, DT_(0)), DenseVector<DT_>(size, DT_(0)), DenseVector<DT_>(size, DT_(0)) };
+
+        for (unsigned long i(0) ; i < size ; ++i)
+        {
+            if (a.boundary(i))
+            {
+                bands[DD][i] = DT_(1);
+                continue;
+            }
+            for (unsigned long band(0) ; band < 9 ; ++band)
+                bands[band][i] = a.coefficient(band);
+        }
+
+        return BandedMatrixQx<Q1Type, DT_>(size, bands[LL], bands[LD], bands[LU], bands[DL], bands[DD], bands[DU],
+                bands[UL], bands[UD], bands[UU]);
+    }
+}
+
+template <typename DataType_>
+class StencilMatrixQ1ElementTest :
+    public QuickTest
+{
+    public:
+        StencilMatrixQ1ElementTest(const std::string & type) :
+            QuickTest("stencil_matrix_q1_element_test<" + type + ">")
+        {
+        }
+
+        virtual void run() const
+        {
+            StencilMatrixQ1<DataType_> a(25, 1, 2, 3, 4, 5, 6, 7, 8, 9);
+            BandedMatrixQx<Q1Type, DataType_> b(banded(a));
+
+            TEST_CHECK_EQUAL(a.root(), 5);
+            for (unsigned long row(0) ; row < a.rows() ; ++row)
+                for (unsigned long column(0) ; column < a.columns() ; ++column)
+                    TEST_CHECK_EQUAL(a(row, column), b(row, column));
+
+            TEST_CHECK_THROWS(StencilMatrixQ1<DataType_>(24, 1, 2, 3, 4, 5, 6, 7, 8, 9), InternalError);
+        }
+};
+StencilMatrixQ1ElementTest<float> stencil_matrix_q1_element_test_float("float");
+StencilMatrixQ1ElementTest<double> stencil_matrix_q1_element_test_double("double");
+
+template <typename Tag_, typename DataType_>
+class StencilMatrixQ1ProductQuickTest :
+    public QuickTest
+{
+    public:
+        StencilMatrixQ1ProductQuickTest(const std::string & type) :
+            QuickTest("stencil_matrix_q1_product_quick_test<" + type + ">")
+        {
+            register_tag(Tag_::name);
+        }
+
+        virtual void run() const
+        {
+            for (unsigned long root(1) ; root < 70 ; root += 7)
+            {
+                const unsigned long size(root * root);
+                StencilMatrixQ1<DataType_> a(size, DataType_(-1) / 3, DataType_(-0.25), DataType_(-1) / 6,
+                        DataType_(-0.5), DataType_(8) / 3, DataType_(-0.75),
+                        DataType_(-1) / 7, DataType_(-1) / 3, DataType_(-0.125));
+                BandedMatrixQx<Q1Type, DataType_> b(banded(a));
+
+                DenseVector<DataType_> x(size);
+                for (unsigned long i(0) ; i < size ; ++i)
+                    x[i] = DataType_(i % 13) / DataType_(5) - DataType_(1);
+
+                DenseVector<DataType_> result(size, DataType_(4711));
+                DenseVector<DataType_> reference(size);
+                Product<Tag_>::value(result, a, x);
+                Product<tags::CPU>::value(reference, b, x);
+
+                for (unsigned long i(0) ; i < size ; ++i)
+                    TEST_CHECK_EQUAL_WITHIN_EPS(result[i], reference[i], std::numeric_limits<DataType_>::epsilon() * 20);
+            }
+
+            StencilMatrixQ1<DataType_> a(9, 1, 2, 3, 4, 5, 6, 7, 8, 9);
+            DenseVector<DataType_> x(10), result(9);
+            TEST_CHECK_THROWS(Product<Tag_>::value(result, a, x), VectorSizeDoesNotMatch);
+        }
+};
+StencilMatrixQ1ProductQuickTest<tags::CPU, float> stencil_matrix_q1_product_quick_test_float("float");
+StencilMatrixQ1ProductQuickTest<tags::CPU, double> stencil_matrix_q1_product_quick_test_double("double");
+StencilMatrixQ1ProductQuickTest<tags::CPU::MultiCore, float> mc_stencil_matrix_q1_product_quick_test_float("MC float");
+StencilMatrixQ1ProductQuickTest<tags::CPU::MultiCore, double> mc_stencil_matrix_q1_product_quick_test_double("MC double");
+StencilMatrixQ1ProductQuickTest<tags::CPU::Generic, float> generic_stencil_matrix_q1_product_quick_test_float("Generic float");
+StencilMatrixQ1ProductQuickTest<tags::CPU::Generic, double> generic_stencil_matrix_q1_product_quick_test_double("Generic double");
+#ifdef HONEI_SSE
+StencilMatrixQ1ProductQuickTest<tags::CPU::SSE, float> sse_stencil_matrix_q1_product_quick_test_float("SSE float");
+StencilMatrixQ1ProductQuickTest<tags::CPU::SSE, double> sse_stencil_matrix_q1_product_quick_test_double("SSE double");
+StencilMatrixQ1ProductQuickTest<tags::CPU::MultiCore::SSE, float> mc_sse_stencil_matrix_q1_product_quick_test_float("MC SSE float");
+StencilMatrixQ1ProductQuickTest<tags::CPU::MultiCore::SSE, double> mc_sse_stencil_matrix_q1_product_quick_test_double("MC SSE double");
+#endif
@@ -1018,7 +1018,7 @@ namespace honei
                     throw MatrixRowsDoNotMatch(b.rows(), a.rows());
                 }
 
-                return honei::Sum<tags::CPU>::value(a, b);
+                return honei::Sum<typename Tag_::DelegateTo>::value(a, b);
             }
 
             // Dummy
@@ -122,6 +122,15 @@ libhoneilbm_include_HEADERS = headerlist
 
 TESTS = testlist
 if HDF5
+  TESTS += grid_checkpoint_TEST
+  grid_checkpoint_TEST_SOURCES = grid_checkpoint_TEST.cc
+  grid_checkpoint_TEST_LDADD = \
+		  $(top_builddir)/honei/util/libhoneiutil.la \
+		  $(BACKEND_LIBS) \
+		  $(top_builddir)/honei/la/libhoneila.la \
+		  libhoneilbm.la \
+	$(DYNAMIC_LD_LIBS)
+  grid_checkpoint_TEST_CXXFLAGS = -I$(top_srcdir) $(AM_CXXFLAGS)
   TESTS += solver_lbm_grid_netcdf_TEST
   solver_lbm_grid_netcdf_TEST_SOURCES = solver_lbm_grid_netcdf_TEST.cc
   solver_lbm_grid_netcdf_TEST_LDADD = \
@@ -0,0 +1,101 @@
+/* vim: set sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LBM C++ library. LBM is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LBM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <honei/lbm/collide_stream.hh>
+#include <honei/backends/sse/operations.hh>
+
+
+using namespace honei;
+
+namespace
+{
+    template <typename DT_>
+    void collide_stream_periodic_rows(DenseMatrix<DT_> & result, DenseMatrix<DT_> & dist, DenseMatrix<DT_> & eq_dist,
+            DenseMatrix<DT_> & s_x, DenseMatrix<DT_> & s_y, DT_ e_x, DT_ e_y, DT_ tau,
+            long e_i, long e_j, unsigned long row_begin, unsigned long row_end)
+    {
+        const long y_max(result.rows());
+        const long x_max(result.columns());
+
+        for (long i(row_begin) ; i < long(row_end) ; ++i)
+        {
+            long i_target(i + e_i);
+
+            if (i_target >= y_max)
+                i_target = i_target - y_max;
+            if (i_target < 0)
+                i_target = i_target + y_max;
+
+            const unsigned long row(i * x_max);
+            DT_ * r(result.elements() + i_target * x_max);
+
+            // The columns [first, last) are streamed in one piece into result starting at column first + e_j,
+            // the remaining column wraps around to the other side of the row.
+            const long first(e_j < 0 ? -e_j : 0);
+            const long last(e_j > 0 ? x_max - e_j : x_max);
+
+            sse::collide_stream(r + first + e_j, dist.elements() + row + first, eq_dist.elements() + row + first,
+                    s_x.elements() + row + first, s_y.elements() + row + first, e_x, e_y, tau, last - first);
+
+            if (e_j != 0)
+            {
+                const long j(e_j > 0 ? x_max - 1 : 0);
+                const long j_target(e_j > 0 ? 0 : x_max - 1);
+                sse::collide_stream(r + j_target, dist.elements() + row + j, eq_dist.elements() + row + j,
+                        s_x.elements() + row + j, s_y.elements() + row + j, e_x, e_y, tau, 1);
+            }
+        }
+    }
+}
+
+void CollideStreamPeriodicRows<tags::CPU::SSE>::value(DenseMatrix<float> & result, DenseMatrix<float> & dist, DenseMatrix<float> & eq_dist,
+        DenseMatrix<float> & s_x, DenseMatrix<float> & s_y, float e_x, float e_y, float tau,
+        long e_i, long e_j, unsigned long row_begin, unsigned long row_end)
+{
+    CONTEXT("When performing collision and streaming on a block of rows (SSE):");
+
+    collide_stream_periodic_rows(result, dist, eq_dist, s_x, s_y, e_x, e_y, tau, e_i, e_j, row_begin, row_end);
+}
+
+void CollideStreamPeriodicRows<tags::CPU::SSE>::value(DenseMatrix<double> & result, DenseMatrix<double> & dist, DenseMatrix<double> & eq_dist,
+        DenseMatrix<double> & s_x, DenseMatrix<double> & s_y, double e_x, double e_y, double tau,
+        long e_i, long e_j, unsigned long row_begin, unsigned long row_end)
+{
+    CONTEXT("When performing collision and streaming on a block of rows (SSE):");
+
+    collide_stream_periodic_rows(result, dist, eq_dist, s_x, s_y, e_x, e_y, tau, e_i, e_j, row_begin, row_end);
+}
+
+void CollideStreamPeriodicRows<tags::CPU::SSE>::value(DenseMatrix<float> & result, DenseMatrix<float> & dist, DenseMatrix<float> & eq_dist,
+        float tau, unsigned long row_begin, unsigned long row_end)
+{
+    CONTEXT("When performing collision on a block of rows (SSE):");
+
+    sse::collide_stream_grid_dir_0(row_begin * result.columns(), row_end * result.columns(), tau,
+            result.elements(), dist.elements(), eq_dist.elements());
+}
+
+void CollideStreamPeriodicRows<tags::CPU::SSE>::value(DenseMatrix<double> & result, DenseMatrix<double> & dist, DenseMatrix<double> & eq_dist,
+        double tau, unsigned long row_begin, unsigned long row_end)
+{
+    CONTEXT("When performing collision on a block of rows (SSE):");
+
+    sse::collide_stream_grid_dir_0(row_begin * result.columns(), row_end * result.columns(), tau,
+            result.elements(), dist.elements(), eq_dist.elements());
+}
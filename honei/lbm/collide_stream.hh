@@ -33,6 +33,9 @@
 #include <honei/lbm/tags.hh>
 #include <honei/la/dense_vector.hh>
 #include <honei/la/dense_matrix.hh>
+#include <honei/util/configuration.hh>
+#include <honei/util/partitioner.hh>
+#include <honei/backends/multicore/thread_pool.hh>
 #include <cmath>
 using namespace honei::lbm;
 
@@ -44,15 +47,20 @@ namespace honei
     };
 
     /**
-     * \brief Collision and streaming module for LABSWE.
+     * \brief Row block collision and streaming kernel for LABSWE with periodic boundaries.
+     *
+     * Processes the rows [row_begin, row_end) of dist and streams them e_i rows and e_j columns
+     * further into result, wrapping around at the borders. A row block reads only its own rows and
+     * writes at most one row beyond either end of it, so disjoint row blocks may be processed
+     * concurrently.
      *
      * \ingroup grplbmoperations
      */
     template <typename Tag_>
-    struct CollideStream<Tag_, lbm_applications::LABSWE, lbm_boundary_types::PERIODIC, lbm_lattice_types::D2Q9::DIR_1>
+    struct CollideStreamPeriodicRows
     {
         /**
-         * \name Collision and Streaming for direction 1..
+         * \name Collision and Streaming for a block of rows.
          *
          * \brief Solves the LB equation.
          *
@@ -64,6 +72,10 @@ namespace honei
          * \param e_x Corresponding distribution scalar.
          * \param e_y Corresponding distribution scalar.
          * \param tau The relaxation time.
+         * \param e_i The row offset of the streaming direction.
+         * \param e_j The column offset of the streaming direction.
+         * \param row_begin The first row to be processed.
+         * \param row_end The row behind the last row to be processed.
          */
         template <typename DT1_, typename DT2_>
         static void value(DenseMatrix<DT1_>& result,
@@ -73,37 +85,260 @@ namespace honei
                           DenseMatrix<DT1_>& s_y,
                           DT2_ e_x,
                           DT2_ e_y,
-                          DT2_ tau)
+                          DT2_ tau,
+                          long e_i,
+                          long e_j,
+                          unsigned long row_begin,
+                          unsigned long row_end)
         {
-            CONTEXT("When performing collision and streaming in DIR 1:");
+            CONTEXT("When performing collision and streaming on a block of rows:");
             long y_max(result.rows());
             long x_max(result.columns());
 
-            for(long i(0); i < y_max; ++i)
+            for(long i(row_begin); i < long(row_end); ++i)
             {
-                long i_forward(i + 1);
-                long i_backward(i - 1);
+                long i_target(i + e_i);
+
+                ///Respect periodic boundaries:
+                if(i_target >= y_max)
+                    i_target = i_target - y_max;
+                if(i_target < 0)
+                    i_target = i_target + y_max;
+
+                const DT1_ * const d(dist.elements() + i * x_max);
+                const DT1_ * const d_eq(eq_dist.elements() + i * x_max);
+                const DT1_ * const sx(s_x.elements() + i * x_max);
+                const DT1_ * const sy(s_y.elements() + i * x_max);
+                DT1_ * const r(result.elements() + i_target * x_max);
 
                 for(long j(0); j < x_max; ++j)
                 {
-                    long j_forward(j + 1);
-                    long j_backward(j - 1);
+                    long j_target(j + e_j);
 
-                    ///Respect periodic boundaries:
-                    if(j_forward >= x_max)
-                        j_forward = j_forward - x_max;
-                    if(j_backward < 0)
-                        j_backward = j_backward + x_max;
-                    if(i_forward >= y_max)
-                        i_forward = i_forward - y_max;
-                    if(i_backward < 0)
-                        i_backward = i_backward + y_max;
+                    if(j_target >= x_max)
+                        j_target = j_target - x_max;
+                    if(j_target < 0)
+                        j_target = j_target + x_max;
 
                     ///Perform streaming and collision:
-                    result(i,j_forward) = dist(i,j) - (dist(i,j) - eq_dist(i,j))/tau + DT1_(1./6.) * (e_x * s_x(i,j) + e_y * s_y(i,j));
+                    r[j_target] = d[j] - (d[j] - d_eq[j])/tau + DT1_(1./6.) * (e_x * sx[j] + e_y * sy[j]);
                 }
             }
         }
+
+        /**
+         * \name Collision for a block of rows in direction 0.
+         *
+         * \brief Solves the LB equation for the resting particles.
+         *
+         * \param result The destination matrix.
+         * \param dist The temporary distribution matrix.
+         * \param eq_dist The equilibrium distribution matrix..
+         * \param tau The relaxation time.
+         * \param row_begin The first row to be processed.
+         * \param row_end The row behind the last row to be processed.
+         */
+        template <typename DT1_, typename DT2_>
+        static void value(DenseMatrix<DT1_>& result,
+                          DenseMatrix<DT1_>& dist,
+                          DenseMatrix<DT1_>& eq_dist,
+                          DT2_ tau,
+                          unsigned long row_begin,
+                          unsigned long row_end)
+        {
+            CONTEXT("When performing collision on a block of rows:");
+            const unsigned long begin(row_begin * result.columns());
+            const unsigned long end(row_end * result.columns());
+
+            const DT1_ * const d(dist.elements());
+            const DT1_ * const d_eq(eq_dist.elements());
+            DT1_ * const r(result.elements());
+
+            for(unsigned long index(begin); index < end; ++index)
+            {
+                r[index] = d[index] - (d[index] - d_eq[index])/tau;
+            }
+        }
+    };
+
+    template <>
+    struct CollideStreamPeriodicRows<tags::CPU::SSE>
+    {
+        static void value(DenseMatrix<float>& result, DenseMatrix<float>& dist, DenseMatrix<float>& eq_dist,
+                DenseMatrix<float>& s_x, DenseMatrix<float>& s_y, float e_x, float e_y, float tau,
+                long e_i, long e_j, unsigned long row_begin, unsigned long row_end);
+
+        static void value(DenseMatrix<double>& result, DenseMatrix<double>& dist, DenseMatrix<double>& eq_dist,
+                DenseMatrix<double>& s_x, DenseMatrix<double>& s_y, double e_x, double e_y, double tau,
+                long e_i, long e_j, unsigned long row_begin, unsigned long row_end);
+
+        static void value(DenseMatrix<float>& result, DenseMatrix<float>& dist, DenseMatrix<float>& eq_dist,
+                float tau, unsigned long row_begin, unsigned long row_end);
+
+        static void value(DenseMatrix<double>& result, DenseMatrix<double>& dist, DenseMatrix<double>& eq_dist,
+                double tau, unsigned long row_begin, unsigned long row_end);
+    };
+
+    namespace mc
+    {
+        /**
+         * \brief Distributes the rows of the periodic collision and streaming among the thread pool.
+         *
+         * Each thread processes a contiguous block of rows with the kernel of Tag_::DelegateTo. The
+         * rows streamed across a block border are written straight into the neighbouring block of
+         * result, which holds no data of the current step yet, so no halo rows have to be exchanged.
+         */
+        template <typename Tag_>
+        struct CollideStreamPeriodicRows
+        {
+            private:
+                template <typename DT1_, typename DT2_>
+                struct CollideStreamTask
+                {
+                    DenseMatrix<DT1_> * result, * dist, * eq_dist, * s_x, * s_y;
+                    DT2_ e_x, e_y, tau;
+                    long e_i, e_j;
+                    unsigned long row_begin, row_end;
+
+                    void operator() ()
+                    {
+                        honei::CollideStreamPeriodicRows<typename Tag_::DelegateTo>::value(*result, *dist, *eq_dist,
+                                *s_x, *s_y, e_x, e_y, tau, e_i, e_j, row_begin, row_end);
+                    }
+                };
+
+                template <typename DT1_, typename DT2_>
+                struct CollideTask
+                {
+                    DenseMatrix<DT1_> * result, * dist, * eq_dist;
+                    DT2_ tau;
+                    unsigned long row_begin, row_end;
+
+                    void operator() ()
+                    {
+                        honei::CollideStreamPeriodicRows<typename Tag_::DelegateTo>::value(*result, *dist, *eq_dist,
+                                tau, row_begin, row_end);
+                    }
+                };
+
+                template <typename Task_>
+                static void _dispatch(Task_ task)
+                {
+                    unsigned long min_part_size(Configuration::instance()->get_value("mc::CollideStreamPeriodicRows::min_part_size", 16));
+                    unsigned long max_count(Configuration::instance()->get_value("mc::CollideStreamPeriodicRows::max_count",
+                                mc::ThreadPool::instance()->num_threads()));
+
+                    const unsigned long row_begin(task.row_begin);
+
+                    PartitionList partitions;
+                    Partitioner<tags::CPU::MultiCore> partitioner(max_count, min_part_size, 1, task.row_end - row_begin,
+                            PartitionList::Filler(partitions));
+
+                    TicketVector tickets;
+
+                    PartitionList::ConstIterator p(partitions.begin());
+                    for (PartitionList::ConstIterator p_last(partitions.last()) ; p != p_last ; ++p)
+                    {
+                        task.row_begin = row_begin + p->start;
+                        task.row_end = row_begin + p->start + p->size;
+                        tickets.push_back(mc::ThreadPool::instance()->enqueue(task));
+                    }
+
+                    task.row_begin = row_begin + p->start;
+                    task.row_end = row_begin + p->start + p->size;
+                    task();
+
+                    tickets.wait();
+                }
+
+            public:
+                template <typename DT1_, typename DT2_>
+                static void value(DenseMatrix<DT1_>& result,
+                                  DenseMatrix<DT1_>& dist,
+                                  DenseMatrix<DT1_>& eq_dist,
+                                  DenseMatrix<DT1_>& s_x,
+                                  DenseMatrix<DT1_>& s_y,
+                                  DT2_ e_x,
+                                  DT2_ e_y,
+                                  DT2_ tau,
+                                  long e_i,
+                                  long e_j,
+                                  unsigned long row_begin,
+                                  unsigned long row_end)
+                {
+                    CONTEXT("When performing collision and streaming on a block of rows using backend : " + Tag_::name);
+
+                    CollideStreamTask<DT1_, DT2_> task = { &result, &dist, &eq_dist, &s_x, &s_y,
+                        e_x, e_y, tau, e_i, e_j, row_begin, row_end };
+                    _dispatch(task);
+                }
+
+                template <typename DT1_, typename DT2_>
+                static void value(DenseMatrix<DT1_>& result,
+                                  DenseMatrix<DT1_>& dist,
+                                  DenseMatrix<DT1_>& eq_dist,
+                                  DT2_ tau,
+                                  unsigned long row_begin,
+                                  unsigned long row_end)
+                {
+                    CONTEXT("When performing collision on a block of rows using backend : " + Tag_::name);
+
+                    CollideTask<DT1_, DT2_> task = { &result, &dist, &eq_dist, tau, row_begin, row_end };
+                    _dispatch(task);
+                }
+        };
+    }
+
+    template <> struct CollideStreamPeriodicRows<tags::CPU::MultiCore> :
+        public mc::CollideStreamPeriodicRows<tags::CPU::MultiCore>
+    {
+    };
+
+    template <> struct CollideStreamPeriodicRows<tags::CPU::MultiCore::Generic> :
+        public mc::CollideStreamPeriodicRows<tags::CPU::MultiCore::Generic>
+    {
+    };
+
+    template <> struct CollideStreamPeriodicRows<tags::CPU::MultiCore::SSE> :
+        public mc::CollideStreamPeriodicRows<tags::CPU::MultiCore::SSE>
+    {
+    };
+
+    /**
+     * \brief Collision and streaming module for LABSWE.
+     *
+     * \ingroup grplbmoperations
+     */
+    template <typename Tag_>
+    struct CollideStream<Tag_, lbm_applications::LABSWE, lbm_boundary_types::PERIODIC, lbm_lattice_types::D2Q9::DIR_1>
+    {
+        /**
+         * \name Collision and Streaming for direction 1..
+         *
+         * \brief Solves the LB equation.
+         *
+         * \param result The destination matrix.
+         * \param dist The temporary distribution matrix.
+         * \param eq_dist The equilibrium distribution matrix..
+         * \param s_x Source matrix in x direction.
+         * \param s_y Source matrix in y direction..
+         * \param e_x Corresponding distribution scalar.
+         * \param e_y Corresponding distribution scalar.
+         * \param tau The relaxation time.
+         */
+        template <typename DT1_, typename DT2_>
+        static void value(DenseMatrix<DT1_>& result,
+                          DenseMatrix<DT1_>& dist,
+                          DenseMatrix<DT1_>& eq_dist,
+                          DenseMatrix<DT1_>& s_x,
+                          DenseMatrix<DT1_>& s_y,
+                          DT2_ e_x,
+                          DT2_ e_y,
+                          DT2_ tau)
+        {
+            CONTEXT("When performing collision and streaming in DIR 1:");
+            CollideStreamPeriodicRows<Tag_>::value(result, dist, eq_dist, s_x, s_y, e_x, e_y, tau, 0, 1, 0, result.rows());
+        }
     };
 
     /**
@@ -139,33 +374,7 @@ namespace honei
                           DT2_ tau)
         {
             CONTEXT("When performing collision and streaming in DIR 2:");
-            long y_max(result.rows());
-            long x_max(result.columns());
-
-            for(long i(0); i < y_max; ++i)
-            {
-                long i_forward(i + 1);
-                long i_backward(i - 1);
-
-                for(long j(0); j < x_max; ++j)
-                {
-                    long j_forward(j + 1);
-                    long j_backward(j - 1);
-
-                    ///Respect periodic boundaries:
-                    if(j_forward >= x_max)
-                        j_forward = j_forward - x_max;
-                    if(j_backward < 0)
-                        j_backward = j_backward + x_max;
-                    if(i_forward >= y_max)
-                        i_forward = i_forward - y_max;
-                    if(i_backward < 0)
-                        i_backward = i_backward + y_max;
-
-                    ///Perform streaming and collision:
-                    result(i_forward, j_forward) = dist(i,j) - (dist(i,j) - eq_dist(i,j))/tau + DT1_(1./6.) * (e_x * s_x(i,j) + e_y * s_y(i,j));
-                }
-            }
+            CollideStreamPeriodicRows<Tag_>::value(result, dist, eq_dist, s_x, s_y, e_x, e_y, tau, 1, 1, 0, result.rows());
         }
     };
 
@@ -203,33 +412,7 @@ namespace honei
         {
 
             CONTEXT("When performing collision and streaming in DIR 3:");
-            long y_max(result.rows());
-            long x_max(result.columns());
-
-            for(long i(0); i < y_max; ++i)
-            {
-                long i_forward(i + 1);
-                long i_backward(i - 1);
-
-                for(long j(0); j < x_max; ++j)
-                {
-                    long j_forward(j + 1);
-                    long j_backward(j - 1);
-
-                    ///Respect periodic boundaries:
-                    if(j_forward >= x_max)
-                        j_forward = j_forward - x_max;
-                    if(j_backward < 0)
-                        j_backward = j_backward + x_max;
-                    if(i_forward >= y_max)
-                        i_forward = i_forward - y_max;
-                    if(i_backward < 0)
-                        i_backward = i_backward + y_max;
-
-                    ///Perform streaming and collision:
-                    result(i_forward, j) = dist(i,j) - (dist(i,j) - eq_dist(i,j))/tau + DT1_(1./6.) * (e_x * s_x(i,j) + e_y * s_y(i,j));
-                }
-            }
+            CollideStreamPeriodicRows<Tag_>::value(result, dist, eq_dist, s_x, s_y, e_x, e_y, tau, 1, 0, 0, result.rows());
         }
     };
 
@@ -267,33 +450,7 @@ namespace honei
         {
 
             CONTEXT("When performing collision and streaming in DIR 4:");
-            long y_max(result.rows());
-            long x_max(result.columns());
-
-            for(long i(0); i < y_max; ++i)
-            {
-                long i_forward(i + 1);
-                long i_backward(i - 1);
-
-                for(long j(0); j < x_max; ++j)
-                {
-                    long j_forward(j + 1);
-                    long j_backward(j - 1);
-
-                    ///Respect periodic boundaries:
-                    if(j_forward >= x_max)
-                        j_forward = j_forward - x_max;
-                    if(j_backward < 0)
-                        j_backward = j_backward + x_max;
-                    if(i_forward >= y_max)
-                        i_forward = i_forward - y_max;
-                    if(i_backward < 0)
-                        i_backward = i_backward + y_max;
-
-                    ///Perform streaming and collision:
-                    result(i_forward, j_backward) = dist(i,j) - (dist(i,j) - eq_dist(i,j))/tau + DT1_(1./6.) * (e_x * s_x(i,j) + e_y * s_y(i,j));
-                }
-            }
+            CollideStreamPeriodicRows<Tag_>::value(result, dist, eq_dist, s_x, s_y, e_x, e_y, tau, 1, -1, 0, result.rows());
         }
     };
 
@@ -331,33 +488,7 @@ namespace honei
         {
 
             CONTEXT("When performing collision and streaming in DIR 5:");
-            long y_max(result.rows());
-            long x_max(result.columns());
-
-            for(long i(0); i < y_max; ++i)
-            {
-                long i_forward(i + 1);
-                long i_backward(i - 1);
-
-                for(long j(0); j < x_max; ++j)
-                {
-                    long j_forward(j + 1);
-                    long j_backward(j - 1);
-
-                    ///Respect periodic boundaries:
-                    if(j_forward >= x_max)
-                        j_forward = j_forward - x_max;
-                    if(j_backward < 0)
-                        j_backward = j_backward + x_max;
-                    if(i_forward >= y_max)
-                        i_forward = i_forward - y_max;
-                    if(i_backward < 0)
-                        i_backward = i_backward + y_max;
-
-                    ///Perform streaming and collision:
-                    result(i, j_backward) = dist(i,j) - (dist(i,j) - eq_dist(i,j))/tau + DT1_(1./6.) * (e_x * s_x(i,j) + e_y * s_y(i,j));
-                }
-            }
+            CollideStreamPeriodicRows<Tag_>::value(result, dist, eq_dist, s_x, s_y, e_x, e_y, tau, 0, -1, 0, result.rows());
         }
     };
 
@@ -395,33 +526,7 @@ namespace honei
         {
 
             CONTEXT("When performing collision and streaming in DIR 6:");
-            long y_max(result.rows());
-            long x_max(result.columns());
-
-            for(long i(0); i < y_max; ++i)
-            {
-                long i_forward(i + 1);
-                long i_backward(i - 1);
-
-                for(long j(0); j < x_max; ++j)
-                {
-                    long j_forward(j + 1);
-                    long j_backward(j - 1);
-
-                    ///Respect periodic boundaries:
-                    if(j_forward >= x_max)
-                        j_forward = j_forward - x_max;
-                    if(j_backward < 0)
-                        j_backward = j_backward + x_max;
-                    if(i_forward >= y_max)
-                        i_forward = i_forward - y_max;
-                    if(i_backward < 0)
-                        i_backward = i_backward + y_max;
-
-                    ///Perform streaming and collision:
-                    result(i_backward, j_backward) = dist(i,j) - (dist(i,j) - eq_dist(i,j))/tau + DT1_(1./6.) * (e_x * s_x(i,j) + e_y * s_y(i,j));
-                }
-            }
+            CollideStreamPeriodicRows<Tag_>::value(result, dist, eq_dist, s_x, s_y, e_x, e_y, tau, -1, -1, 0, result.rows());
         }
     };
 
@@ -459,33 +564,7 @@ namespace honei
         {
 
             CONTEXT("When performing collision and streaming in DIR 7:");
-            long y_max(result.rows());
-            long x_max(result.columns());
-
-            for(long i(0); i < y_max; ++i)
-            {
-                long i_forward(i + 1);
-                long i_backward(i - 1);
-
-                for(long j(0); j < x_max; ++j)
-                {
-                    long j_forward(j + 1);
-                    long j_backward(j - 1);
-
-                    ///Respect periodic boundaries:
-                    if(j_forward >= x_max)
-                        j_forward = j_forward - x_max;
-                    if(j_backward < 0)
-                        j_backward = j_backward + x_max;
-                    if(i_forward >= y_max)
-                        i_forward = i_forward - y_max;
-                    if(i_backward < 0)
-                        i_backward = i_backward + y_max;
-
-                    ///Perform streaming and collision:
-                    result(i_backward, j) = dist(i,j) - (dist(i,j) - eq_dist(i,j))/tau + DT1_(1./6.) * (e_x * s_x(i,j) + e_y * s_y(i,j));
-                }
-            }
+            CollideStreamPeriodicRows<Tag_>::value(result, dist, eq_dist, s_x, s_y, e_x, e_y, tau, -1, 0, 0, result.rows());
         }
     };
 
@@ -523,33 +602,7 @@ namespace honei
         {
 
             CONTEXT("When performing collision and streaming in DIR 8:");
-            long y_max(result.rows());
-            long x_max(result.columns());
-
-            for(long i(0); i < y_max; ++i)
-            {
-                long i_forward(i + 1);
-                long i_backward(i - 1);
-
-                for(long j(0); j < x_max; ++j)
-                {
-                    long j_forward(j + 1);
-                    long j_backward(j - 1);
-
-                    ///Respect periodic boundaries:
-                    if(j_forward >= x_max)
-                        j_forward = j_forward - x_max;
-                    if(j_backward < 0)
-                        j_backward = j_backward + x_max;
-                    if(i_forward >= y_max)
-                        i_forward = i_forward - y_max;
-                    if(i_backward < 0)
-                        i_backward = i_backward + y_max;
-
-                    ///Perform streaming and collision:
-                    result(i_backward, j_forward) = dist(i,j) - (dist(i,j) - eq_dist(i,j))/tau + DT1_(1./6.) * (e_x * s_x(i,j) + e_y * s_y(i,j));
-                }
-            }
+            CollideStreamPeriodicRows<Tag_>::value(result, dist, eq_dist, s_x, s_y, e_x, e_y, tau, -1, 1, 0, result.rows());
         }
     };
 
@@ -587,17 +640,7 @@ namespace honei
         {
 
             CONTEXT("When performing collision and streaming in DIR 0:");
-            long y_max(result.rows());
-            long x_max(result.columns());
-
-            for(long i(0); i < y_max; ++i)
-            {
-                for(long j(0); j < x_max; ++j)
-                {
-                   ///Perform streaming and collision:
-                    result(i, j) = dist(i,j) - (dist(i,j) - eq_dist(i,j))/tau;
-                }
-            }
+            CollideStreamPeriodicRows<Tag_>::value(result, dist, eq_dist, tau, 0, result.rows());
         }
     };
 
@@ -19,6 +19,9 @@
 #include <honei/lbm/tags.hh>
 #include <honei/util/unittest.hh>
 #include <honei/lbm/collide_stream.hh>
+#include <honei/util/configuration.hh>
+#include <cmath>
+#include <limits>
 
 using namespace honei;
 using namespace tests;
@@ -78,3 +81,87 @@ CollideStreamLABSWETest<tags::CPU::MultiCore::SSE, double> collide_stream_test_d
 CollideStreamLABSWETest<tags::Cell, float> collide_stream_test_float_cell("float");
 CollideStreamLABSWETest<tags::Cell, double> collide_stream_test_double_cell("double");
 #endif
+
+template <typename Tag_, typename DataType_>
+class CollideStreamPeriodicLABSWETest :
+    public TaggedTest<Tag_>
+{
+    private:
+        template <typename Direction_>
+        void _check(DenseMatrix<DataType_> & dist, DenseMatrix<DataType_> & eq_dist,
+                DenseMatrix<DataType_> & s_x, DenseMatrix<DataType_> & s_y,
+                DataType_ e_x, DataType_ e_y, DataType_ tau, long e_i, long e_j, bool source) const
+        {
+            const long y_max(dist.rows());
+            const long x_max(dist.columns());
+            DenseMatrix<DataType_> result(y_max, x_max, DataType_(-1));
+
+            CollideStream<Tag_, lbm_applications::LABSWE, lbm_boundary_types::PERIODIC, Direction_>::
+                value(result, dist, eq_dist, s_x, s_y, e_x, e_y, tau);
+
+            for(long i(0); i < y_max; ++i)
+            {
+                for(long j(0); j < x_max; ++j)
+                {
+                    DataType_ reference(dist(i, j) - (dist(i, j) - eq_dist(i, j)) / tau);
+                    if (source)
+                        reference += DataType_(1./6.) * (e_x * s_x(i, j) + e_y * s_y(i, j));
+
+                    TEST_CHECK_EQUAL_WITHIN_EPS(result((i + e_i + y_max) % y_max, (j + e_j + x_max) % x_max), reference,
+                            std::numeric_limits<DataType_>::epsilon() * 10);
+                }
+            }
+        }
+
+    public:
+        CollideStreamPeriodicLABSWETest(const std::string & type) :
+            TaggedTest<Tag_>("collideandstream_periodic_labswe_test<" + type + ">")
+        {
+        }
+
+        virtual void run() const
+        {
+            // Force several row blocks, even on a single core.
+            Configuration::instance()->set_value("mc::CollideStreamPeriodicRows::max_count", 4);
+
+            // Odd sizes, so that neither rows nor row blocks start at an aligned address.
+            unsigned long y_max(131), x_max(67);
+            DenseMatrix<DataType_> dist(y_max, x_max);
+            DenseMatrix<DataType_> eq_dist(y_max, x_max);
+            DenseMatrix<DataType_> s_x(y_max, x_max);
+            DenseMatrix<DataType_> s_y(y_max, x_max);
+
+            for(unsigned long i(0); i < y_max; ++i)
+            {
+                for(unsigned long j(0); j < x_max; ++j)
+                {
+                    dist(i, j) = DataType_(0.1) + DataType_(0.05) * std::sin(DataType_(i * x_max + j));
+                    eq_dist(i, j) = DataType_(0.1) + DataType_(0.05) * std::cos(DataType_(i + j));
+                    s_x(i, j) = DataType_(0.001) * std::sin(DataType_(j));
+                    s_y(i, j) = DataType_(0.001) * std::cos(DataType_(i));
+                }
+            }
+
+            DataType_ tau(1.3);
+
+            _check<lbm_lattice_types::D2Q9::DIR_0>(dist, eq_dist, s_x, s_y, DataType_(0), DataType_(0), tau, 0, 0, false);
+            _check<lbm_lattice_types::D2Q9::DIR_1>(dist, eq_dist, s_x, s_y, DataType_(1), DataType_(0), tau, 0, 1, true);
+            _check<lbm_lattice_types::D2Q9::DIR_2>(dist, eq_dist, s_x, s_y, DataType_(1), DataType_(1), tau, 1, 1, true);
+            _check<lbm_lattice_types::D2Q9::DIR_3>(dist, eq_dist, s_x, s_y, DataType_(0), DataType_(1), tau, 1, 0, true);
+            _check<lbm_lattice_types::D2Q9::DIR_4>(dist, eq_dist, s_x, s_y, DataType_(-1), DataType_(1), tau, 1, -1, true);
+            _check<lbm_lattice_types::D2Q9::DIR_5>(dist, eq_dist, s_x, s_y, DataType_(-1), DataType_(0), tau, 0, -1, true);
+            _check<lbm_lattice_types::D2Q9::DIR_6>(dist, eq_dist, s_x, s_y, DataType_(-1), DataType_(-1), tau, -1, -1, true);
+            _check<lbm_lattice_types::D2Q9::DIR_7>(dist, eq_dist, s_x, s_y, DataType_(0), DataType_(-1), tau, -1, 0, true);
+            _check<lbm_lattice_types::D2Q9::DIR_8>(dist, eq_dist, s_x, s_y, DataType_(1), DataType_(-1), tau, -1, 1, true);
+        }
+};
+CollideStreamPeriodicLABSWETest<tags::CPU, float> collide_stream_periodic_test_float("float");
+CollideStreamPeriodicLABSWETest<tags::CPU, double> collide_stream_periodic_test_double("double");
+CollideStreamPeriodicLABSWETest<tags::CPU::MultiCore, float> collide_stream_periodic_test_float_mc("float");
+CollideStreamPeriodicLABSWETest<tags::CPU::MultiCore, double> collide_stream_periodic_test_double_mc("double");
+#ifdef HONEI_SSE
+CollideStreamPeriodicLABSWETest<tags::CPU::SSE, float> collide_stream_periodic_test_float_sse("float");
+CollideStreamPeriodicLABSWETest<tags::CPU::SSE, double> collide_stream_periodic_test_double_sse("double");
+CollideStreamPeriodicLABSWETest<tags::CPU::MultiCore::SSE, float> collide_stream_periodic_test_float_mc_sse("float");
+CollideStreamPeriodicLABSWETest<tags::CPU::MultiCore::SSE, double> collide_stream_periodic_test_double_mc_sse("double");
+#endif
@@ -234,12 +234,34 @@ namespace honei
             data.f_temp_8->unlock(lm_write_only);
         }
 
+        /**
+         * \brief Returns the number of index bytes read per time step.
+         *
+         * The kernels stream run-length encoded index data: one source range in dir_index_*
+         * and one target start in dir_* per run of cells, plus the limits of the cell ranges.
+         * Hence index traffic scales with the number of runs, not with the number of cells.
+         */
+        static inline unsigned long index_bytes(PackedGridInfo<D2Q9> * info)
+        {
+            unsigned long result(info->limits->size());
+            result += info->dir_1->size() + info->dir_index_1->size();
+            result += info->dir_2->size() + info->dir_index_2->size();
+            result += info->dir_3->size() + info->dir_index_3->size();
+            result += info->dir_4->size() + info->dir_index_4->size();
+            result += info->dir_5->size() + info->dir_index_5->size();
+            result += info->dir_6->size() + info->dir_index_6->size();
+            result += info->dir_7->size() + info->dir_index_7->size();
+            result += info->dir_8->size() + info->dir_index_8->size();
+
+            return result * sizeof(unsigned long);
+        }
+
         template<typename DT1_>
-            static inline BenchmarkInfo get_benchmark_info(HONEI_UNUSED PackedGridInfo<D2Q9> * info, PackedGridData<D2Q9, DT1_> * data)
+            static inline BenchmarkInfo get_benchmark_info(PackedGridInfo<D2Q9> * info, PackedGridData<D2Q9, DT1_> * data)
             {
                 BenchmarkInfo result;
                 result.flops = data->h->size() * 9 * 3;
-                result.load = data->h->size() * 9 * 4 * sizeof(DT1_);
+                result.load = data->h->size() * 9 * 4 * sizeof(DT1_) + index_bytes(info);
                 result.store = data->h->size() * 9 * sizeof(DT1_);
                 result.size.push_back(data->h->size());
                 return result;
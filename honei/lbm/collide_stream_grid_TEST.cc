@@ -21,6 +21,7 @@
 #include <honei/lbm/grid.hh>
 #include <honei/lbm/collide_stream_grid.hh>
 #include <honei/lbm/grid_packer.hh>
+#include <honei/lbm/scenario_collection.hh>
 using namespace honei;
 using namespace tests;
 using namespace std;
@@ -122,3 +123,42 @@ CollideStreamGridLABSWETest<tags::GPU::CUDA, double> cuda_collidestream_grid_tes
 #ifdef HONEI_CELL
 CollideStreamGridLABSWETest<tags::Cell, float> cell_collidestream_grid_test_float("float");
 #endif
+
+template <typename DataType_>
+class CollideStreamGridIndexBytesTest :
+    public QuickTest
+{
+    public:
+        CollideStreamGridIndexBytesTest(const std::string & type) :
+            QuickTest("collideandstream_grid_index_bytes_test<" + type + ">")
+        {
+        }
+
+        virtual void run() const
+        {
+            Grid<D2Q9, DataType_> grid;
+            ScenarioCollection::get_scenario(1, 250, 250, grid);
+
+            PackedGridData<D2Q9, DataType_>  data;
+            PackedGridInfo<D2Q9> info;
+            GridPacker<D2Q9, NOSLIP, DataType_>::pack(grid, info, data);
+
+            unsigned long cells(data.h->size());
+            unsigned long index_bytes(CollideStreamGrid<tags::CPU, NOSLIP, D2Q9>::index_bytes(&info));
+            unsigned long distribution_bytes(cells * 9 * 5 * sizeof(DataType_));
+            std::cout << "Index bytes per lattice update: " << double(index_bytes) / cells
+                << ", distribution bytes per lattice update: " << double(distribution_bytes) / cells << std::endl;
+
+            // run-length encoded indices must stay negligible against the distribution traffic
+            TEST_CHECK(index_bytes * 100 < distribution_bytes);
+
+            BenchmarkInfo benchmark_info(CollideStreamGrid<tags::CPU, NOSLIP, D2Q9>::get_benchmark_info(&info, &data));
+            TEST_CHECK_EQUAL(benchmark_info.load, cells * 9 * 4 * sizeof(DataType_) + index_bytes);
+
+            grid.destroy();
+            info.destroy();
+            data.destroy();
+        }
+};
+CollideStreamGridIndexBytesTest<float> collidestream_grid_index_bytes_test_float("float");
+CollideStreamGridIndexBytesTest<double> collidestream_grid_index_bytes_test_double("double");
@@ -0,0 +1,554 @@
+/* vim: set number sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LBM C++ library. LBM is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LBM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#pragma once
+#ifndef LBM_GUARD_COLLIDE_STREAM_GRID_AA_HH
+#define LBM_GUARD_COLLIDE_STREAM_GRID_AA_HH 1
+
+
+/**
+ * \file
+ * Implementation of fused, in-place collision and streaming modules (AA pattern) used by
+ * LBM - (SWE, NavSto) solvers (using PackedGrid).
+ *
+ * The AA pattern keeps a single set of distribution functions f_0 .. f_8. Even steps read and
+ * write the populations of a cell only, storing the post collision value of direction i in the
+ * slot of the opposite direction. Odd steps read the populations pointing towards a cell from
+ * its neighbours and write the post collision values back to exactly these locations. No cell
+ * touches the memory of another cell, so no f_temp and no f_eq buffers are needed.
+ *
+ * \ingroup grpliblbm
+ **/
+
+#include <honei/lbm/tags.hh>
+#include <honei/la/dense_vector.hh>
+#include <honei/lbm/grid.hh>
+#include <honei/lbm/lbm_limiter.hh>
+#include <honei/util/benchmark_info.hh>
+#include <honei/util/attributes.hh>
+#include <cmath>
+
+using namespace honei::lbm;
+
+namespace honei
+{
+    namespace intern
+    {
+        namespace aa
+        {
+            /// The opposite direction of every D2Q9 direction.
+            static const unsigned long opposite[9] = { 0, 5, 6, 7, 8, 1, 2, 3, 4 };
+
+            /// Maps the step tags to the kernel flavour.
+            template <typename Step_> struct Step
+            {
+            };
+
+            template <> struct Step<lbm_aa_steps::EVEN>
+            {
+                static const bool odd = false;
+            };
+
+            template <> struct Step<lbm_aa_steps::ODD>
+            {
+                static const bool odd = true;
+            };
+
+            /// Local equilibrium distribution of one cell.
+            template <typename Application_> struct Equilibrium
+            {
+            };
+
+            template <> struct Equilibrium<lbm_applications::LABSWE>
+            {
+                template <typename DT_>
+                static inline void value(DT_ * f_eq, DT_ h, DT_ u, DT_ v, const DT_ * distribution_x, const DT_ * distribution_y,
+                        DT_ g, DT_ e)
+                {
+                    DT_ e2(e);
+                    DT_ e42(DT_(2.) * e2 * e2);
+                    DT_ e23(DT_(3.) * e2);
+                    DT_ e26(DT_(6.) * e2);
+                    DT_ e48(DT_(8.) * e2 * e2);
+                    DT_ e212(DT_(12.) * e2);
+                    DT_ e224(DT_(24.) * e2);
+
+                    DT_ u2(u * u);
+                    DT_ v2(v * v);
+                    DT_ gh(g * h);
+
+                    DT_ dxu, dyv;
+                    DT_ t1, t2, t3, t4;
+
+                    t1 = (DT_(5.) * gh) / e26;
+                    t2 = DT_(2.) / e23 * (u2 + v2);
+                    f_eq[0] = h * (DT_(1) - t1 - t2);
+
+                    for (unsigned long i(1) ; i < 9 ; i += 2)
+                    {
+                        dxu = distribution_x[i] * u;
+                        dyv = distribution_y[i] * v;
+                        t1 = (gh) / e26;
+                        t2 = (dxu + dyv) / e23;
+                        t3 = (dxu * dxu + DT_(2.) * dxu * dyv + dyv * dyv) / e42;
+                        t4 = (u2 + v2) / e26;
+                        f_eq[i] = h * (t1 + t2 + t3 - t4);
+                    }
+
+                    for (unsigned long i(2) ; i < 9 ; i += 2)
+                    {
+                        dxu = distribution_x[i] * u;
+                        dyv = distribution_y[i] * v;
+                        t1 = (gh) / e224;
+                        t2 = (dxu + dyv) / e212;
+                        t3 = (dxu * dxu + DT_(2.) * dxu * dyv + dyv * dyv) / e48;
+                        t4 = (u2 + v2) / e224;
+                        f_eq[i] = h * (t1 + t2 + t3 - t4);
+                    }
+                }
+            };
+
+            template <> struct Equilibrium<lbm_applications::LABNAVSTO>
+            {
+                template <typename DT_>
+                static inline void value(DT_ * f_eq, DT_ h, DT_ u, DT_ v, const DT_ * distribution_x, const DT_ * distribution_y,
+                        HONEI_UNUSED DT_ g, DT_ e)
+                {
+                    DT_ e2(e); //e squared is passed!!
+                    DT_ e4(e2 * e2);
+                    DT_ three_by_e2(DT_(3.) / e2);
+                    DT_ nine_by_2e4(DT_(9.) / (DT_(2.) * e4));
+                    DT_ three_by_2e2(DT_(3.) / (DT_(2.) * e2));
+
+                    DT_ u2(u * u);
+                    DT_ v2(v * v);
+                    DT_ one(1.);
+
+                    f_eq[0] = h * DT_(4./9.) * (one - (three_by_2e2 * (u2 + v2)));
+
+                    for (unsigned long i(1) ; i < 9 ; ++i)
+                    {
+                        DT_ omega(i % 2 == 1 ? DT_(1./9.) : DT_(1./36.));
+                        DT_ dxu(distribution_x[i] * u);
+                        DT_ dyv(distribution_y[i] * v);
+                        f_eq[i] = h * omega * (one + (three_by_e2 * (dxu + dyv)) + (nine_by_2e4 * ((dxu + dyv) * (dxu + dyv))) -  (three_by_2e2 * (u2 + v2)));
+                    }
+                }
+            };
+
+            /// Local extraction of h, u and v of one cell.
+            template <typename LbmMode_> struct Extraction
+            {
+            };
+
+            template <> struct Extraction<lbm_modes::DRY>
+            {
+                template <typename DT_>
+                static inline void value(const DT_ * f, const DT_ * distribution_x, const DT_ * distribution_y,
+                        DT_ & h, DT_ & u, DT_ & v, DT_ epsilon)
+                {
+                    h = f[0] + f[1] + f[2] + f[3] + f[4] + f[5] + f[6] + f[7] + f[8];
+
+                    if (h < -epsilon || h > epsilon)
+                    {
+                        u = (distribution_x[0] * f[0] + distribution_x[1] * f[1] + distribution_x[2] * f[2] +
+                                distribution_x[3] * f[3] + distribution_x[4] * f[4] + distribution_x[5] * f[5] +
+                                distribution_x[6] * f[6] + distribution_x[7] * f[7] + distribution_x[8] * f[8]) / h;
+                        v = (distribution_y[0] * f[0] + distribution_y[1] * f[1] + distribution_y[2] * f[2] +
+                                distribution_y[3] * f[3] + distribution_y[4] * f[4] + distribution_y[5] * f[5] +
+                                distribution_y[6] * f[6] + distribution_y[7] * f[7] + distribution_y[8] * f[8]) / h;
+                    }
+                    else
+                    {
+                        h = DT_(0);
+                        u = DT_(0);
+                        v = DT_(0);
+                    }
+                    h = MinModLimiter<tags::CPU>::value(h);
+                }
+            };
+
+            template <> struct Extraction<lbm_modes::WET>
+            {
+                template <typename DT_>
+                static inline void value(const DT_ * f, const DT_ * distribution_x, const DT_ * distribution_y,
+                        DT_ & h, DT_ & u, DT_ & v, HONEI_UNUSED DT_ epsilon)
+                {
+                    h = f[0] + f[1] + f[2] + f[3] + f[4] + f[5] + f[6] + f[7] + f[8];
+                    u = (distribution_x[0] * f[0] + distribution_x[1] * f[1] + distribution_x[2] * f[2] +
+                            distribution_x[3] * f[3] + distribution_x[4] * f[4] + distribution_x[5] * f[5] +
+                            distribution_x[6] * f[6] + distribution_x[7] * f[7] + distribution_x[8] * f[8]) / h;
+                    v = (distribution_y[0] * f[0] + distribution_y[1] * f[1] + distribution_y[2] * f[2] +
+                            distribution_y[3] * f[3] + distribution_y[4] * f[4] + distribution_y[5] * f[5] +
+                            distribution_y[6] * f[6] + distribution_y[7] * f[7] + distribution_y[8] * f[8]) / h;
+                }
+            };
+
+            /**
+             * NOSLIP boundary correction of the incoming populations of one cell, in the same order as
+             * UpdateVelocityDirectionsGrid applies it to f_temp.
+             */
+            template <typename DT_>
+            static inline void noslip(DT_ * f, unsigned long type)
+            {
+                if ((type & 1<<0) == 1<<0)
+                    f[5] = f[1];
+                if ((type & 1<<1) == 1<<1)
+                    f[6] = f[2];
+                if ((type & 1<<2) == 1<<2)
+                    f[7] = f[3];
+                if ((type & 1<<3) == 1<<3)
+                    f[8] = f[4];
+                if ((type & 1<<4) == 1<<4)
+                    f[1] = f[5];
+                if ((type & 1<<5) == 1<<5)
+                    f[2] = f[6];
+                if ((type & 1<<6) == 1<<6)
+                    f[3] = f[7];
+                if ((type & 1<<7) == 1<<7)
+                    f[4] = f[8];
+
+                // Corners
+                if ((type & 1<<2) == 1<<2 && (type & 1<<4) == 1<<4)
+                {
+                    f[2] = f[8];
+                    f[6] = f[8];
+                }
+                if ((type & 1<<4) == 1<<4 && (type & 1<<6) == 1<<6)
+                {
+                    f[4] = f[2];
+                    f[8] = f[2];
+                }
+                if ((type & 1<<0) == 1<<0 && (type & 1<<6) == 1<<6)
+                {
+                    f[2] = f[4];
+                    f[6] = f[4];
+                }
+                if ((type & 1<<0) == 1<<0 && (type & 1<<2) == 1<<2)
+                {
+                    f[4] = f[6];
+                    f[8] = f[6];
+                }
+            }
+
+            /**
+             * Resolves the neighbours of the limits segment starting at start.
+             *
+             * The dir_index lists hold sorted, disjoint source ranges, so one cursor per direction
+             * walks them alongside the segments. neighbour[i] receives the packed index of the
+             * neighbour of the first cell of the segment in direction i, or stays unset if the
+             * segment has no neighbour in that direction.
+             */
+            static inline void neighbours(unsigned long start, const unsigned long * const * dir, const unsigned long * const * dir_index,
+                    const unsigned long * dir_index_size, unsigned long * cursor, bool * has, unsigned long * neighbour)
+            {
+                for (unsigned long i(1) ; i < 9 ; ++i)
+                {
+                    while (cursor[i] + 1 < dir_index_size[i] && dir_index[i][cursor[i] + 1] <= start)
+                        cursor[i] += 2;
+
+                    has[i] = cursor[i] + 1 < dir_index_size[i] && dir_index[i][cursor[i]] <= start;
+                    if (has[i])
+                        neighbour[i] = dir[i][cursor[i] / 2] + (start - dir_index[i][cursor[i]]);
+                }
+            }
+
+            /**
+             * One fused time step: gather the post streaming populations, apply the boundary
+             * correction, extract h, u and v, compute the equilibrium and collide. With odd_ unset
+             * the populations are read from and written to the own cell (even step); otherwise
+             * they are read from and written to the neighbours (odd step).
+             */
+            template <typename Application_, typename LbmMode_, bool odd_, typename DT_>
+            void collide_stream(PackedGridInfo<D2Q9> & info, PackedGridData<D2Q9, DT_> & data, DT_ g, DT_ e, DT_ tau, DT_ epsilon)
+            {
+                const unsigned long * const limits(info.limits->elements());
+                const unsigned long * const types(info.types->elements());
+                const unsigned long * const dir[9] = { 0, info.dir_1->elements(), info.dir_2->elements(), info.dir_3->elements(),
+                    info.dir_4->elements(), info.dir_5->elements(), info.dir_6->elements(), info.dir_7->elements(), info.dir_8->elements() };
+                const unsigned long * const dir_index[9] = { 0, info.dir_index_1->elements(), info.dir_index_2->elements(),
+                    info.dir_index_3->elements(), info.dir_index_4->elements(), info.dir_index_5->elements(), info.dir_index_6->elements(),
+                    info.dir_index_7->elements(), info.dir_index_8->elements() };
+                const unsigned long dir_index_size[9] = { 0, info.dir_index_1->size(), info.dir_index_2->size(), info.dir_index_3->size(),
+                    info.dir_index_4->size(), info.dir_index_5->size(), info.dir_index_6->size(), info.dir_index_7->size(),
+                    info.dir_index_8->size() };
+
+                DT_ * const f[9] = { data.f_0->elements(), data.f_1->elements(), data.f_2->elements(), data.f_3->elements(),
+                    data.f_4->elements(), data.f_5->elements(), data.f_6->elements(), data.f_7->elements(), data.f_8->elements() };
+                DT_ * const h(data.h->elements());
+                DT_ * const u(data.u->elements());
+                DT_ * const v(data.v->elements());
+                const DT_ * const distribution_x(data.distribution_x->elements());
+                const DT_ * const distribution_y(data.distribution_y->elements());
+
+                unsigned long cursor[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+                unsigned long neighbour[9] = { 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+                bool has[9] = { false, false, false, false, false, false, false, false, false };
+                DT_ f_cell[9];
+                DT_ f_eq[9];
+
+                for (unsigned long segment(0) ; segment < info.limits->size() - 1 ; ++segment)
+                {
+                    const unsigned long start(limits[segment]);
+                    const unsigned long end(limits[segment + 1]);
+                    const unsigned long type(types[segment]);
+
+                    if (odd_)
+                        neighbours(start, dir, dir_index, dir_index_size, cursor, has, neighbour);
+
+                    for (unsigned long i(start), offset(0) ; i < end ; ++i, ++offset)
+                    {
+                        f_cell[0] = f[0][i];
+                        for (unsigned long d(1) ; d < 9 ; ++d)
+                        {
+                            const unsigned long o(opposite[d]);
+                            if (odd_ && has[o])
+                                f_cell[d] = f[o][neighbour[o] + offset];
+                            else
+                                f_cell[d] = f[d][i];
+                        }
+
+                        noslip(f_cell, type);
+
+                        DT_ h_cell, u_cell, v_cell;
+                        Extraction<LbmMode_>::value(f_cell, distribution_x, distribution_y, h_cell, u_cell, v_cell, epsilon);
+                        h[i] = h_cell;
+                        u[i] = u_cell;
+                        v[i] = v_cell;
+
+                        Equilibrium<Application_>::value(f_eq, h_cell, u_cell, v_cell, distribution_x, distribution_y, g, e);
+
+                        f[0][i] = f_cell[0] - (f_cell[0] - f_eq[0]) / tau;
+                        for (unsigned long d(1) ; d < 9 ; ++d)
+                        {
+                            const DT_ f_post(f_cell[d] - (f_cell[d] - f_eq[d]) / tau);
+                            if (odd_ && has[d])
+                                f[d][neighbour[d] + offset] = f_post;
+                            else
+                                f[opposite[d]][i] = f_post;
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    template <typename Tag_, typename Application_, typename LbmMode_, typename Step_>
+    struct CollideStreamGridAA
+    {
+    };
+
+    /**
+     * \brief Fused collision and in-place streaming module (AA pattern).
+     *
+     * Even and odd steps have to alternate, starting with an odd step after
+     * EquilibriumDistributionGridAA. The boundary correction, the extraction of h, u and v and the
+     * equilibrium distribution are computed on the fly, so f_eq and f_temp are never touched.
+     *
+     * \ingroup grplbmoperations
+     */
+    template <typename Application_, typename LbmMode_, typename Step_>
+    struct CollideStreamGridAA<tags::CPU, Application_, LbmMode_, Step_>
+    {
+        /**
+         * \name Fused collision and streaming
+         *
+         * \brief Solves the LB equation for one time step.
+         *
+         * \param info Our info object.
+         * \param data Our packed grid data object.
+         * \param g The gravitational constant to be used.
+         * \param e The squared lattice velocity.
+         * \param tau The relaxation time.
+         * \param epsilon The threshold used for dry cells.
+         */
+        template <typename DT1_, typename DT2_>
+        static void value(PackedGridInfo<lbm_lattice_types::D2Q9> & info, PackedGridData<lbm_lattice_types::D2Q9, DT1_> & data,
+                DT2_ g, DT2_ e, DT2_ tau, DT1_ epsilon)
+        {
+            CONTEXT("When performing in-place collision and streaming:");
+
+            info.limits->lock(lm_read_only);
+            info.types->lock(lm_read_only);
+            info.dir_1->lock(lm_read_only);
+            info.dir_2->lock(lm_read_only);
+            info.dir_3->lock(lm_read_only);
+            info.dir_4->lock(lm_read_only);
+            info.dir_5->lock(lm_read_only);
+            info.dir_6->lock(lm_read_only);
+            info.dir_7->lock(lm_read_only);
+            info.dir_8->lock(lm_read_only);
+            info.dir_index_1->lock(lm_read_only);
+            info.dir_index_2->lock(lm_read_only);
+            info.dir_index_3->lock(lm_read_only);
+            info.dir_index_4->lock(lm_read_only);
+            info.dir_index_5->lock(lm_read_only);
+            info.dir_index_6->lock(lm_read_only);
+            info.dir_index_7->lock(lm_read_only);
+            info.dir_index_8->lock(lm_read_only);
+
+            data.f_0->lock(lm_read_and_write);
+            data.f_1->lock(lm_read_and_write);
+            data.f_2->lock(lm_read_and_write);
+            data.f_3->lock(lm_read_and_write);
+            data.f_4->lock(lm_read_and_write);
+            data.f_5->lock(lm_read_and_write);
+            data.f_6->lock(lm_read_and_write);
+            data.f_7->lock(lm_read_and_write);
+            data.f_8->lock(lm_read_and_write);
+            data.h->lock(lm_write_only);
+            data.u->lock(lm_write_only);
+            data.v->lock(lm_write_only);
+            data.distribution_x->lock(lm_read_only);
+            data.distribution_y->lock(lm_read_only);
+
+            intern::aa::collide_stream<Application_, LbmMode_, intern::aa::Step<Step_>::odd>(info, data, DT1_(g), DT1_(e), DT1_(tau), epsilon);
+
+            info.limits->unlock(lm_read_only);
+            info.types->unlock(lm_read_only);
+            info.dir_1->unlock(lm_read_only);
+            info.dir_2->unlock(lm_read_only);
+            info.dir_3->unlock(lm_read_only);
+            info.dir_4->unlock(lm_read_only);
+            info.dir_5->unlock(lm_read_only);
+            info.dir_6->unlock(lm_read_only);
+            info.dir_7->unlock(lm_read_only);
+            info.dir_8->unlock(lm_read_only);
+            info.dir_index_1->unlock(lm_read_only);
+            info.dir_index_2->unlock(lm_read_only);
+            info.dir_index_3->unlock(lm_read_only);
+            info.dir_index_4->unlock(lm_read_only);
+            info.dir_index_5->unlock(lm_read_only);
+            info.dir_index_6->unlock(lm_read_only);
+            info.dir_index_7->unlock(lm_read_only);
+            info.dir_index_8->unlock(lm_read_only);
+
+            data.f_0->unlock(lm_read_and_write);
+            data.f_1->unlock(lm_read_and_write);
+            data.f_2->unlock(lm_read_and_write);
+            data.f_3->unlock(lm_read_and_write);
+            data.f_4->unlock(lm_read_and_write);
+            data.f_5->unlock(lm_read_and_write);
+            data.f_6->unlock(lm_read_and_write);
+            data.f_7->unlock(lm_read_and_write);
+            data.f_8->unlock(lm_read_and_write);
+            data.h->unlock(lm_write_only);
+            data.u->unlock(lm_write_only);
+            data.v->unlock(lm_write_only);
+            data.distribution_x->unlock(lm_read_only);
+            data.distribution_y->unlock(lm_read_only);
+        }
+
+        template<typename DT1_>
+            static inline BenchmarkInfo get_benchmark_info(HONEI_UNUSED PackedGridInfo<D2Q9> * info, PackedGridData<D2Q9, DT1_> * data)
+            {
+                BenchmarkInfo result;
+                result.flops = data->h->size() * (44 + 12 + 8 * 27 + 9 * 3);
+                result.load = data->h->size() * (9 + 2 * 9) * sizeof(DT1_);
+                result.store = data->h->size() * (9 + 3) * sizeof(DT1_);
+                result.size.push_back(data->h->size());
+                return result;
+            }
+    };
+
+    template <typename Application_, typename LbmMode_, typename Step_>
+    struct CollideStreamGridAA<tags::CPU::Generic, Application_, LbmMode_, Step_> :
+        public CollideStreamGridAA<tags::CPU, Application_, LbmMode_, Step_>
+    {
+    };
+
+    template <typename Tag_, typename Application_>
+    struct EquilibriumDistributionGridAA
+    {
+    };
+
+    /**
+     * \brief Initial equilibrium distribution for the in-place streaming scheme.
+     *
+     * Sets f to the equilibrium of h, u and v and stores it in the layout of a completed even step,
+     * i.e. the population of direction i in the slot of the opposite direction.
+     *
+     * \ingroup grplbmoperations
+     */
+    template <typename Application_>
+    struct EquilibriumDistributionGridAA<tags::CPU, Application_>
+    {
+        template<typename DT1_, typename DT2_>
+            static void value(DT2_ g, DT2_ e, PackedGridInfo<D2Q9> & info, PackedGridData<D2Q9, DT1_> & data)
+            {
+                CONTEXT("When computing initial in-place equilibrium distribution function:");
+
+                info.limits->lock(lm_read_only);
+
+                data.h->lock(lm_read_only);
+                data.u->lock(lm_read_only);
+                data.v->lock(lm_read_only);
+                data.distribution_x->lock(lm_read_only);
+                data.distribution_y->lock(lm_read_only);
+
+                data.f_0->lock(lm_write_only);
+                data.f_1->lock(lm_write_only);
+                data.f_2->lock(lm_write_only);
+                data.f_3->lock(lm_write_only);
+                data.f_4->lock(lm_write_only);
+                data.f_5->lock(lm_write_only);
+                data.f_6->lock(lm_write_only);
+                data.f_7->lock(lm_write_only);
+                data.f_8->lock(lm_write_only);
+
+                DT1_ * const f[9] = { data.f_0->elements(), data.f_1->elements(), data.f_2->elements(), data.f_3->elements(),
+                    data.f_4->elements(), data.f_5->elements(), data.f_6->elements(), data.f_7->elements(), data.f_8->elements() };
+                DT1_ f_eq[9];
+
+                for (unsigned long i((*info.limits)[0]) ; i < (*info.limits)[info.limits->size() - 1] ; ++i)
+                {
+                    intern::aa::Equilibrium<Application_>::value(f_eq, (*data.h)[i], (*data.u)[i], (*data.v)[i],
+                            data.distribution_x->elements(), data.distribution_y->elements(), DT1_(g), DT1_(e));
+                    for (unsigned long d(0) ; d < 9 ; ++d)
+                        f[intern::aa::opposite[d]][i] = f_eq[d];
+                }
+
+                info.limits->unlock(lm_read_only);
+
+                data.h->unlock(lm_read_only);
+                data.u->unlock(lm_read_only);
+                data.v->unlock(lm_read_only);
+                data.distribution_x->unlock(lm_read_only);
+                data.distribution_y->unlock(lm_read_only);
+
+                data.f_0->unlock(lm_write_only);
+                data.f_1->unlock(lm_write_only);
+                data.f_2->unlock(lm_write_only);
+                data.f_3->unlock(lm_write_only);
+                data.f_4->unlock(lm_write_only);
+                data.f_5->unlock(lm_write_only);
+                data.f_6->unlock(lm_write_only);
+                data.f_7->unlock(lm_write_only);
+                data.f_8->unlock(lm_write_only);
+            }
+    };
+
+    template <typename Application_>
+    struct EquilibriumDistributionGridAA<tags::CPU::Generic, Application_> :
+        public EquilibriumDistributionGridAA<tags::CPU, Application_>
+    {
+    };
+}
+#endif
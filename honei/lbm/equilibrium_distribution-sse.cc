@@ -0,0 +1,88 @@
+/* vim: set sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LBM C++ library. LBM is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LBM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <honei/lbm/equilibrium_distribution.hh>
+#include <honei/backends/sse/operations.hh>
+
+
+using namespace honei;
+
+// The packed grid kernels compute the same local equilibrium on contiguous index ranges. They
+// expect the square of the ratio of space and time stepping and the distribution vector
+// entries in an array indexed by the direction.
+
+void EquilibriumDistribution<tags::CPU::SSE, lbm_applications::LABSWE, lbm_lattice_types::D2Q9::DIR_0>::value(
+        DenseMatrix<float> & result, DenseMatrix<float> & h, DenseMatrix<float> & u, DenseMatrix<float> & v,
+        float g, float e, unsigned long row_begin, unsigned long row_end)
+{
+    CONTEXT("When computing LABSWE local equilibrium distribution function (direction 0) (SSE):");
+
+    sse::eq_dist_grid_dir_0(row_begin * h.columns(), row_end * h.columns(), g, e * e,
+            h.elements(), u.elements(), v.elements(), result.elements());
+}
+
+void EquilibriumDistribution<tags::CPU::SSE, lbm_applications::LABSWE, lbm_lattice_types::D2Q9::DIR_0>::value(
+        DenseMatrix<double> & result, DenseMatrix<double> & h, DenseMatrix<double> & u, DenseMatrix<double> & v,
+        double g, double e, unsigned long row_begin, unsigned long row_end)
+{
+    CONTEXT("When computing LABSWE local equilibrium distribution function (direction 0) (SSE):");
+
+    sse::eq_dist_grid_dir_0(row_begin * h.columns(), row_end * h.columns(), g, e * e,
+            h.elements(), u.elements(), v.elements(), result.elements());
+}
+
+void EquilibriumDistribution<tags::CPU::SSE, lbm_applications::LABSWE, lbm_lattice_types::D2Q9::DIR_ODD>::value(
+        DenseMatrix<float> & result, DenseMatrix<float> & h, DenseMatrix<float> & u, DenseMatrix<float> & v,
+        float g, float e, float e_u, float e_v, unsigned long row_begin, unsigned long row_end)
+{
+    CONTEXT("When computing LABSWE local equilibrium distribution function (odd direction) (SSE):");
+
+    sse::eq_dist_grid_dir_odd(row_begin * h.columns(), row_end * h.columns(), g, e * e,
+            h.elements(), u.elements(), v.elements(), &e_u, &e_v, result.elements(), 0);
+}
+
+void EquilibriumDistribution<tags::CPU::SSE, lbm_applications::LABSWE, lbm_lattice_types::D2Q9::DIR_ODD>::value(
+        DenseMatrix<double> & result, DenseMatrix<double> & h, DenseMatrix<double> & u, DenseMatrix<double> & v,
+        double g, double e, double e_u, double e_v, unsigned long row_begin, unsigned long row_end)
+{
+    CONTEXT("When computing LABSWE local equilibrium distribution function (odd direction) (SSE):");
+
+    sse::eq_dist_grid_dir_odd(row_begin * h.columns(), row_end * h.columns(), g, e * e,
+            h.elements(), u.elements(), v.elements(), &e_u, &e_v, result.elements(), 0);
+}
+
+void EquilibriumDistribution<tags::CPU::SSE, lbm_applications::LABSWE, lbm_lattice_types::D2Q9::DIR_EVEN>::value(
+        DenseMatrix<float> & result, DenseMatrix<float> & h, DenseMatrix<float> & u, DenseMatrix<float> & v,
+        float g, float e, float e_u, float e_v, unsigned long row_begin, unsigned long row_end)
+{
+    CONTEXT("When computing LABSWE local equilibrium distribution function (even direction) (SSE):");
+
+    sse::eq_dist_grid_dir_even(row_begin * h.columns(), row_end * h.columns(), g, e * e,
+            h.elements(), u.elements(), v.elements(), &e_u, &e_v, result.elements(), 0);
+}
+
+void EquilibriumDistribution<tags::CPU::SSE, lbm_applications::LABSWE, lbm_lattice_types::D2Q9::DIR_EVEN>::value(
+        DenseMatrix<double> & result, DenseMatrix<double> & h, DenseMatrix<double> & u, DenseMatrix<double> & v,
+        double g, double e, double e_u, double e_v, unsigned long row_begin, unsigned long row_end)
+{
+    CONTEXT("When computing LABSWE local equilibrium distribution function (even direction) (SSE):");
+
+    sse::eq_dist_grid_dir_even(row_begin * h.columns(), row_end * h.columns(), g, e * e,
+            h.elements(), u.elements(), v.elements(), &e_u, &e_v, result.elements(), 0);
+}
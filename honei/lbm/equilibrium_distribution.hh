@@ -31,6 +31,9 @@
 
 #include <honei/lbm/tags.hh>
 #include <honei/la/dense_matrix.hh>
+#include <honei/util/configuration.hh>
+#include <honei/util/partitioner.hh>
+#include <honei/backends/multicore/thread_pool.hh>
 
 using namespace honei;
 using namespace lbm;
@@ -62,9 +65,18 @@ namespace honei
              */
             template<typename DT1_, typename DT2_>
                 static void value(DenseMatrix<DT1_>& result, DenseMatrix<DT1_>& h, DenseMatrix<DT1_>& u, DenseMatrix<DT1_>& v, DT2_ g, DT2_ e)
+                {
+                    value(result, h, u, v, g, e, 0, h.rows());
+                }
+
+            /**
+             * \brief Computes the equilibrium distribution for the rows [row_begin, row_end) only.
+             */
+            template<typename DT1_, typename DT2_>
+                static void value(DenseMatrix<DT1_>& result, DenseMatrix<DT1_>& h, DenseMatrix<DT1_>& u, DenseMatrix<DT1_>& v, DT2_ g, DT2_ e, unsigned long row_begin, unsigned long row_end)
                 {
                     CONTEXT("When computing LABSWE local equilibrium distribution function (direction 0):");
-                    for(unsigned long i(0); i < h.rows(); ++i)
+                    for(unsigned long i(row_begin); i < row_end; ++i)
                     {
                         for(unsigned long j(0); j < h.columns(); ++j)
                         {
@@ -99,9 +111,18 @@ namespace honei
              */
             template<typename DT1_, typename DT2_>
                 static void value(DenseMatrix<DT1_>& result, DenseMatrix<DT1_>& h, DenseMatrix<DT1_>& u, DenseMatrix<DT1_>& v, DT2_ g, DT2_ e, DT2_ e_u, DT2_ e_v)
+                {
+                    value(result, h, u, v, g, e, e_u, e_v, 0, h.rows());
+                }
+
+            /**
+             * \brief Computes the equilibrium distribution for the rows [row_begin, row_end) only.
+             */
+            template<typename DT1_, typename DT2_>
+                static void value(DenseMatrix<DT1_>& result, DenseMatrix<DT1_>& h, DenseMatrix<DT1_>& u, DenseMatrix<DT1_>& v, DT2_ g, DT2_ e, DT2_ e_u, DT2_ e_v, unsigned long row_begin, unsigned long row_end)
                 {
                     CONTEXT("When computing LABSWE local equilibrium distribution function (odd direction):");
-                    for(unsigned long i(0); i < h.rows(); ++i)
+                    for(unsigned long i(row_begin); i < row_end; ++i)
                     {
                         for(unsigned long j(0); j < h.columns(); ++j)
                         {
@@ -136,9 +157,18 @@ namespace honei
              */
             template<typename DT1_, typename DT2_>
                 static void value(DenseMatrix<DT1_>& result, DenseMatrix<DT1_>& h, DenseMatrix<DT1_>& u, DenseMatrix<DT1_>& v, DT2_ g, DT2_ e, DT2_ e_u, DT2_ e_v)
+                {
+                    value(result, h, u, v, g, e, e_u, e_v, 0, h.rows());
+                }
+
+            /**
+             * \brief Computes the equilibrium distribution for the rows [row_begin, row_end) only.
+             */
+            template<typename DT1_, typename DT2_>
+                static void value(DenseMatrix<DT1_>& result, DenseMatrix<DT1_>& h, DenseMatrix<DT1_>& u, DenseMatrix<DT1_>& v, DT2_ g, DT2_ e, DT2_ e_u, DT2_ e_v, unsigned long row_begin, unsigned long row_end)
                 {
                     CONTEXT("When computing LABSWE local equilibrium distribution function (even direction):");
-                    for(unsigned long i(0); i < h.rows(); ++i)
+                    for(unsigned long i(row_begin); i < row_end; ++i)
                     {
                         for(unsigned long j(0); j < h.columns(); ++j)
                         {
@@ -172,10 +202,19 @@ namespace honei
              * \param e The ratio of space and time stepping.
              */
             template<typename DT1_, typename DT2_>
-                static void value(DenseMatrix<DT1_>& result, DenseMatrix<DT1_>& h, DenseMatrix<DT1_>& u, DenseMatrix<DT1_>& v, HONEI_UNUSED DT2_ g, DT2_ e)
+                static void value(DenseMatrix<DT1_>& result, DenseMatrix<DT1_>& h, DenseMatrix<DT1_>& u, DenseMatrix<DT1_>& v, DT2_ g, DT2_ e)
+                {
+                    value(result, h, u, v, g, e, 0, h.rows());
+                }
+
+            /**
+             * \brief Computes the equilibrium distribution for the rows [row_begin, row_end) only.
+             */
+            template<typename DT1_, typename DT2_>
+                static void value(DenseMatrix<DT1_>& result, DenseMatrix<DT1_>& h, DenseMatrix<DT1_>& u, DenseMatrix<DT1_>& v, HONEI_UNUSED DT2_ g, DT2_ e, unsigned long row_begin, unsigned long row_end)
                 {
                     CONTEXT("When computing LABNAVSTO local equilibrium distribution function (direction 0):");
-                    for(unsigned long i(0); i < h.rows(); ++i)
+                    for(unsigned long i(row_begin); i < row_end; ++i)
                     {
                         for(unsigned long j(0); j < h.columns(); ++j)
                         {
@@ -208,10 +247,19 @@ namespace honei
              * \param e_v The corresponding distribution vector entry.
              */
             template<typename DT1_, typename DT2_>
-                static void value(DenseMatrix<DT1_>& result, DenseMatrix<DT1_>& h, DenseMatrix<DT1_>& u, DenseMatrix<DT1_>& v, HONEI_UNUSED DT2_ g, DT2_ e, DT2_ e_u, DT2_ e_v)
+                static void value(DenseMatrix<DT1_>& result, DenseMatrix<DT1_>& h, DenseMatrix<DT1_>& u, DenseMatrix<DT1_>& v, DT2_ g, DT2_ e, DT2_ e_u, DT2_ e_v)
+                {
+                    value(result, h, u, v, g, e, e_u, e_v, 0, h.rows());
+                }
+
+            /**
+             * \brief Computes the equilibrium distribution for the rows [row_begin, row_end) only.
+             */
+            template<typename DT1_, typename DT2_>
+                static void value(DenseMatrix<DT1_>& result, DenseMatrix<DT1_>& h, DenseMatrix<DT1_>& u, DenseMatrix<DT1_>& v, HONEI_UNUSED DT2_ g, DT2_ e, DT2_ e_u, DT2_ e_v, unsigned long row_begin, unsigned long row_end)
                 {
                     CONTEXT("When computing LABNAVSTO local equilibrium distribution function (odd direction):");
-                    for(unsigned long i(0); i < h.rows(); ++i)
+                    for(unsigned long i(row_begin); i < row_end; ++i)
                     {
                         for(unsigned long j(0); j < h.columns(); ++j)
                         {
@@ -246,10 +294,19 @@ namespace honei
              * \param e_v The corresponding distribution vector entry.
              */
             template<typename DT1_, typename DT2_>
-                static void value(DenseMatrix<DT1_>& result, DenseMatrix<DT1_>& h, DenseMatrix<DT1_>& u, DenseMatrix<DT1_>& v, HONEI_UNUSED DT2_ g, DT2_ e, DT2_ e_u, DT2_ e_v)
+                static void value(DenseMatrix<DT1_>& result, DenseMatrix<DT1_>& h, DenseMatrix<DT1_>& u, DenseMatrix<DT1_>& v, DT2_ g, DT2_ e, DT2_ e_u, DT2_ e_v)
+                {
+                    value(result, h, u, v, g, e, e_u, e_v, 0, h.rows());
+                }
+
+            /**
+             * \brief Computes the equilibrium distribution for the rows [row_begin, row_end) only.
+             */
+            template<typename DT1_, typename DT2_>
+                static void value(DenseMatrix<DT1_>& result, DenseMatrix<DT1_>& h, DenseMatrix<DT1_>& u, DenseMatrix<DT1_>& v, HONEI_UNUSED DT2_ g, DT2_ e, DT2_ e_u, DT2_ e_v, unsigned long row_begin, unsigned long row_end)
                 {
                     CONTEXT("When computing LABNAVSTO local equilibrium distribution function (even direction):");
-                    for(unsigned long i(0); i < h.rows(); ++i)
+                    for(unsigned long i(row_begin); i < row_end; ++i)
                     {
                         for(unsigned long j(0); j < h.columns(); ++j)
                         {
@@ -264,5 +321,214 @@ namespace honei
         };
 
 
+    template<>
+        struct EquilibriumDistribution<tags::CPU::SSE, lbm_applications::LABSWE, lbm_lattice_types::D2Q9::DIR_0>
+        {
+            static void value(DenseMatrix<float>& result, DenseMatrix<float>& h, DenseMatrix<float>& u, DenseMatrix<float>& v, float g, float e)
+            {
+                value(result, h, u, v, g, e, 0, h.rows());
+            }
+
+            static void value(DenseMatrix<float>& result, DenseMatrix<float>& h, DenseMatrix<float>& u, DenseMatrix<float>& v, float g, float e,
+                    unsigned long row_begin, unsigned long row_end);
+
+            static void value(DenseMatrix<double>& result, DenseMatrix<double>& h, DenseMatrix<double>& u, DenseMatrix<double>& v, double g, double e)
+            {
+                value(result, h, u, v, g, e, 0, h.rows());
+            }
+
+            static void value(DenseMatrix<double>& result, DenseMatrix<double>& h, DenseMatrix<double>& u, DenseMatrix<double>& v, double g, double e,
+                    unsigned long row_begin, unsigned long row_end);
+        };
+
+    template<>
+        struct EquilibriumDistribution<tags::CPU::SSE, lbm_applications::LABSWE, lbm_lattice_types::D2Q9::DIR_ODD>
+        {
+            static void value(DenseMatrix<float>& result, DenseMatrix<float>& h, DenseMatrix<float>& u, DenseMatrix<float>& v, float g, float e, float e_u, float e_v)
+            {
+                value(result, h, u, v, g, e, e_u, e_v, 0, h.rows());
+            }
+
+            static void value(DenseMatrix<float>& result, DenseMatrix<float>& h, DenseMatrix<float>& u, DenseMatrix<float>& v, float g, float e, float e_u, float e_v,
+                    unsigned long row_begin, unsigned long row_end);
+
+            static void value(DenseMatrix<double>& result, DenseMatrix<double>& h, DenseMatrix<double>& u, DenseMatrix<double>& v, double g, double e, double e_u, double e_v)
+            {
+                value(result, h, u, v, g, e, e_u, e_v, 0, h.rows());
+            }
+
+            static void value(DenseMatrix<double>& result, DenseMatrix<double>& h, DenseMatrix<double>& u, DenseMatrix<double>& v, double g, double e, double e_u, double e_v,
+                    unsigned long row_begin, unsigned long row_end);
+        };
+
+    template<>
+        struct EquilibriumDistribution<tags::CPU::SSE, lbm_applications::LABSWE, lbm_lattice_types::D2Q9::DIR_EVEN>
+        {
+            static void value(DenseMatrix<float>& result, DenseMatrix<float>& h, DenseMatrix<float>& u, DenseMatrix<float>& v, float g, float e, float e_u, float e_v)
+            {
+                value(result, h, u, v, g, e, e_u, e_v, 0, h.rows());
+            }
+
+            static void value(DenseMatrix<float>& result, DenseMatrix<float>& h, DenseMatrix<float>& u, DenseMatrix<float>& v, float g, float e, float e_u, float e_v,
+                    unsigned long row_begin, unsigned long row_end);
+
+            static void value(DenseMatrix<double>& result, DenseMatrix<double>& h, DenseMatrix<double>& u, DenseMatrix<double>& v, double g, double e, double e_u, double e_v)
+            {
+                value(result, h, u, v, g, e, e_u, e_v, 0, h.rows());
+            }
+
+            static void value(DenseMatrix<double>& result, DenseMatrix<double>& h, DenseMatrix<double>& u, DenseMatrix<double>& v, double g, double e, double e_u, double e_v,
+                    unsigned long row_begin, unsigned long row_end);
+        };
+
+    namespace mc
+    {
+        /**
+         * \brief Distributes the rows of the equilibrium distribution among the thread pool.
+         *
+         * Each thread computes a contiguous block of rows with the module of Tag_::DelegateTo.
+         */
+        template <typename Tag_, typename App_, typename Direction_>
+        struct EquilibriumDistribution
+        {
+            private:
+                template <typename DT1_, typename DT2_>
+                struct Task
+                {
+                    DenseMatrix<DT1_> * result, * h, * u, * v;
+                    DT2_ g, e;
+                    unsigned long row_begin, row_end;
+
+                    void operator() ()
+                    {
+                        honei::EquilibriumDistribution<typename Tag_::DelegateTo, App_, Direction_>::value(*result, *h, *u, *v,
+                                g, e, row_begin, row_end);
+                    }
+                };
+
+                template <typename DT1_, typename DT2_>
+                struct DirectionTask
+                {
+                    DenseMatrix<DT1_> * result, * h, * u, * v;
+                    DT2_ g, e, e_u, e_v;
+                    unsigned long row_begin, row_end;
+
+                    void operator() ()
+                    {
+                        honei::EquilibriumDistribution<typename Tag_::DelegateTo, App_, Direction_>::value(*result, *h, *u, *v,
+                                g, e, e_u, e_v, row_begin, row_end);
+                    }
+                };
+
+                template <typename Task_>
+                static void _dispatch(Task_ task)
+                {
+                    unsigned long min_part_size(Configuration::instance()->get_value("mc::EquilibriumDistribution::min_part_size", 16));
+                    unsigned long max_count(Configuration::instance()->get_value("mc::EquilibriumDistribution::max_count",
+                                mc::ThreadPool::instance()->num_threads()));
+
+                    const unsigned long row_begin(task.row_begin);
+
+                    PartitionList partitions;
+                    Partitioner<tags::CPU::MultiCore> partitioner(max_count, min_part_size, 1, task.row_end - row_begin,
+                            PartitionList::Filler(partitions));
+
+                    TicketVector tickets;
+
+                    PartitionList::ConstIterator p(partitions.begin());
+                    for (PartitionList::ConstIterator p_last(partitions.last()) ; p != p_last ; ++p)
+                    {
+                        task.row_begin = row_begin + p->start;
+                        task.row_end = row_begin + p->start + p->size;
+                        tickets.push_back(mc::ThreadPool::instance()->enqueue(task));
+                    }
+
+                    task.row_begin = row_begin + p->start;
+                    task.row_end = row_begin + p->start + p->size;
+                    task();
+
+                    tickets.wait();
+                }
+
+            public:
+                template<typename DT1_, typename DT2_>
+                    static void value(DenseMatrix<DT1_>& result, DenseMatrix<DT1_>& h, DenseMatrix<DT1_>& u, DenseMatrix<DT1_>& v, DT2_ g, DT2_ e)
+                    {
+                        CONTEXT("When computing local equilibrium distribution function using backend : " + Tag_::name);
+
+                        Task<DT1_, DT2_> task = { &result, &h, &u, &v, g, e, 0, h.rows() };
+                        _dispatch(task);
+                    }
+
+                template<typename DT1_, typename DT2_>
+                    static void value(DenseMatrix<DT1_>& result, DenseMatrix<DT1_>& h, DenseMatrix<DT1_>& u, DenseMatrix<DT1_>& v, DT2_ g, DT2_ e, DT2_ e_u, DT2_ e_v)
+                    {
+                        CONTEXT("When computing local equilibrium distribution function using backend : " + Tag_::name);
+
+                        DirectionTask<DT1_, DT2_> task = { &result, &h, &u, &v, g, e, e_u, e_v, 0, h.rows() };
+                        _dispatch(task);
+                    }
+        };
+    }
+
+    template <> struct EquilibriumDistribution<tags::CPU::MultiCore, lbm_applications::LABSWE, lbm_lattice_types::D2Q9::DIR_0> :
+        public mc::EquilibriumDistribution<tags::CPU::MultiCore, lbm_applications::LABSWE, lbm_lattice_types::D2Q9::DIR_0>
+    {
+    };
+
+    template <> struct EquilibriumDistribution<tags::CPU::MultiCore, lbm_applications::LABSWE, lbm_lattice_types::D2Q9::DIR_ODD> :
+        public mc::EquilibriumDistribution<tags::CPU::MultiCore, lbm_applications::LABSWE, lbm_lattice_types::D2Q9::DIR_ODD>
+    {
+    };
+
+    template <> struct EquilibriumDistribution<tags::CPU::MultiCore, lbm_applications::LABSWE, lbm_lattice_types::D2Q9::DIR_EVEN> :
+        public mc::EquilibriumDistribution<tags::CPU::MultiCore, lbm_applications::LABSWE, lbm_lattice_types::D2Q9::DIR_EVEN>
+    {
+    };
+
+    template <> struct EquilibriumDistribution<tags::CPU::MultiCore, lbm_applications::LABNAVSTO, lbm_lattice_types::D2Q9::DIR_0> :
+        public mc::EquilibriumDistribution<tags::CPU::MultiCore, lbm_applications::LABNAVSTO, lbm_lattice_types::D2Q9::DIR_0>
+    {
+    };
+
+    template <> struct EquilibriumDistribution<tags::CPU::MultiCore, lbm_applications::LABNAVSTO, lbm_lattice_types::D2Q9::DIR_ODD> :
+        public mc::EquilibriumDistribution<tags::CPU::MultiCore, lbm_applications::LABNAVSTO, lbm_lattice_types::D2Q9::DIR_ODD>
+    {
+    };
+
+    template <> struct EquilibriumDistribution<tags::CPU::MultiCore, lbm_applications::LABNAVSTO, lbm_lattice_types::D2Q9::DIR_EVEN> :
+        public mc::EquilibriumDistribution<tags::CPU::MultiCore, lbm_applications::LABNAVSTO, lbm_lattice_types::D2Q9::DIR_EVEN>
+    {
+    };
+
+    template <> struct EquilibriumDistribution<tags::CPU::MultiCore::SSE, lbm_applications::LABSWE, lbm_lattice_types::D2Q9::DIR_0> :
+        public mc::EquilibriumDistribution<tags::CPU::MultiCore::SSE, lbm_applications::LABSWE, lbm_lattice_types::D2Q9::DIR_0>
+    {
+    };
+
+    template <> struct EquilibriumDistribution<tags::CPU::MultiCore::SSE, lbm_applications::LABSWE, lbm_lattice_types::D2Q9::DIR_ODD> :
+        public mc::EquilibriumDistribution<tags::CPU::MultiCore::SSE, lbm_applications::LABSWE, lbm_lattice_types::D2Q9::DIR_ODD>
+    {
+    };
+
+    template <> struct EquilibriumDistribution<tags::CPU::MultiCore::SSE, lbm_applications::LABSWE, lbm_lattice_types::D2Q9::DIR_EVEN> :
+        public mc::EquilibriumDistribution<tags::CPU::MultiCore::SSE, lbm_applications::LABSWE, lbm_lattice_types::D2Q9::DIR_EVEN>
+    {
+    };
+
+    template <> struct EquilibriumDistribution<tags::CPU::MultiCore::SSE, lbm_applications::LABNAVSTO, lbm_lattice_types::D2Q9::DIR_0> :
+        public mc::EquilibriumDistribution<tags::CPU::MultiCore::SSE, lbm_applications::LABNAVSTO, lbm_lattice_types::D2Q9::DIR_0>
+    {
+    };
+
+    template <> struct EquilibriumDistribution<tags::CPU::MultiCore::SSE, lbm_applications::LABNAVSTO, lbm_lattice_types::D2Q9::DIR_ODD> :
+        public mc::EquilibriumDistribution<tags::CPU::MultiCore::SSE, lbm_applications::LABNAVSTO, lbm_lattice_types::D2Q9::DIR_ODD>
+    {
+    };
+
+    template <> struct EquilibriumDistribution<tags::CPU::MultiCore::SSE, lbm_applications::LABNAVSTO, lbm_lattice_types::D2Q9::DIR_EVEN> :
+        public mc::EquilibriumDistribution<tags::CPU::MultiCore::SSE, lbm_applications::LABNAVSTO, lbm_lattice_types::D2Q9::DIR_EVEN>
+    {
+    };
 }
 #endif
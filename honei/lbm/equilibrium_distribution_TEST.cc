@@ -19,7 +19,9 @@
 #include <honei/lbm/tags.hh>
 #include <honei/util/unittest.hh>
 #include <honei/lbm/equilibrium_distribution.hh>
+#include <honei/util/configuration.hh>
 
+#include <cmath>
 #include <limits>
 
 using namespace honei;
@@ -84,3 +86,71 @@ EqDisLABSWETest<tags::CPU::MultiCore::SSE, float> eqdis_test_float_mc_sse("float
 EqDisLABSWETest<tags::Cell, double> eqdis_test_double_cell("double");
 EqDisLABSWETest<tags::Cell, float> eqdis_test_float_cell("float");
 #endif
+
+template <typename Tag_, typename App_, typename DataType_>
+class EqDisRowsTest :
+    public TaggedTest<Tag_>
+{
+    public:
+        EqDisRowsTest(const std::string & type) :
+            TaggedTest<Tag_>("eq_dis_rows_test<" + type + ">")
+        {
+        }
+
+        virtual void run() const
+        {
+            // Force several row blocks, even on a single core.
+            Configuration::instance()->set_value("mc::EquilibriumDistribution::max_count", 4);
+
+            unsigned long y_max(131), x_max(67);
+            DenseMatrix<DataType_> h(y_max, x_max);
+            DenseMatrix<DataType_> u(y_max, x_max);
+            DenseMatrix<DataType_> v(y_max, x_max);
+
+            for(unsigned long i(0); i < y_max; ++i)
+            {
+                for(unsigned long j(0); j < x_max; ++j)
+                {
+                    h(i, j) = DataType_(0.05) + DataType_(0.01) * std::sin(DataType_(i * x_max + j));
+                    u(i, j) = DataType_(0.1) * std::cos(DataType_(i));
+                    v(i, j) = DataType_(0.1) * std::sin(DataType_(j));
+                }
+            }
+
+            DataType_ g(9.81);
+            DataType_ e(1.5);
+            DataType_ e_u(-1.5);
+            DataType_ e_v(1.5);
+
+            DenseMatrix<DataType_> result_0(y_max, x_max), result_odd(y_max, x_max), result_even(y_max, x_max);
+            DenseMatrix<DataType_> reference_0(y_max, x_max), reference_odd(y_max, x_max), reference_even(y_max, x_max);
+
+            EquilibriumDistribution<Tag_, App_, lbm_lattice_types::D2Q9::DIR_0>::value(result_0, h, u, v, g, e);
+            EquilibriumDistribution<Tag_, App_, lbm_lattice_types::D2Q9::DIR_ODD>::value(result_odd, h, u, v, g, e, e_u, e_v);
+            EquilibriumDistribution<Tag_, App_, lbm_lattice_types::D2Q9::DIR_EVEN>::value(result_even, h, u, v, g, e, e_u, e_v);
+
+            EquilibriumDistribution<tags::CPU, App_, lbm_lattice_types::D2Q9::DIR_0>::value(reference_0, h, u, v, g, e);
+            EquilibriumDistribution<tags::CPU, App_, lbm_lattice_types::D2Q9::DIR_ODD>::value(reference_odd, h, u, v, g, e, e_u, e_v);
+            EquilibriumDistribution<tags::CPU, App_, lbm_lattice_types::D2Q9::DIR_EVEN>::value(reference_even, h, u, v, g, e, e_u, e_v);
+
+            for(unsigned long i(0); i < y_max; ++i)
+            {
+                for(unsigned long j(0); j < x_max; ++j)
+                {
+                    TEST_CHECK_EQUAL_WITHIN_EPS(result_0(i, j), reference_0(i, j), std::numeric_limits<DataType_>::epsilon() * 10);
+                    TEST_CHECK_EQUAL_WITHIN_EPS(result_odd(i, j), reference_odd(i, j), std::numeric_limits<DataType_>::epsilon() * 10);
+                    TEST_CHECK_EQUAL_WITHIN_EPS(result_even(i, j), reference_even(i, j), std::numeric_limits<DataType_>::epsilon() * 10);
+                }
+            }
+        }
+};
+EqDisRowsTest<tags::CPU::MultiCore, lbm_applications::LABSWE, float> eqdis_rows_test_float_mc("LABSWE, float");
+EqDisRowsTest<tags::CPU::MultiCore, lbm_applications::LABSWE, double> eqdis_rows_test_double_mc("LABSWE, double");
+EqDisRowsTest<tags::CPU::MultiCore, lbm_applications::LABNAVSTO, float> eqdis_rows_test_navsto_float_mc("LABNAVSTO, float");
+EqDisRowsTest<tags::CPU::MultiCore, lbm_applications::LABNAVSTO, double> eqdis_rows_test_navsto_double_mc("LABNAVSTO, double");
+#ifdef HONEI_SSE
+EqDisRowsTest<tags::CPU::SSE, lbm_applications::LABSWE, float> eqdis_rows_test_float_sse("LABSWE, float");
+EqDisRowsTest<tags::CPU::SSE, lbm_applications::LABSWE, double> eqdis_rows_test_double_sse("LABSWE, double");
+EqDisRowsTest<tags::CPU::MultiCore::SSE, lbm_applications::LABSWE, float> eqdis_rows_test_float_mc_sse("LABSWE, float");
+EqDisRowsTest<tags::CPU::MultiCore::SSE, lbm_applications::LABSWE, double> eqdis_rows_test_double_mc_sse("LABSWE, double");
+#endif
@@ -0,0 +1,116 @@
+/* vim: set sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LA C++ library. LibLa is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LibLa is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <honei/lbm/equilibrium_distribution_grid_mixed.hh>
+#include <honei/backends/sse/operations.hh>
+
+
+using namespace honei;
+
+void EquilibriumDistributionGridMixed<tags::CPU::SSE, lbm_applications::LABSWE>::value(double g, double e,
+        PackedGridInfo<D2Q9> & info, PackedGridData<D2Q9, double> & fields, PackedGridData<D2Q9, float> & lattice)
+{
+    CONTEXT("When computing LABSWE local equilibrium distribution function (mixed precision, SSE):");
+
+    info.limits->lock(lm_read_only);
+
+    fields.u->lock(lm_read_only);
+    fields.v->lock(lm_read_only);
+    fields.h->lock(lm_read_only);
+
+    fields.distribution_x->lock(lm_read_only);
+    fields.distribution_y->lock(lm_read_only);
+
+    lattice.f_eq_0->lock(lm_write_only);
+    lattice.f_eq_1->lock(lm_write_only);
+    lattice.f_eq_2->lock(lm_write_only);
+    lattice.f_eq_3->lock(lm_write_only);
+    lattice.f_eq_4->lock(lm_write_only);
+    lattice.f_eq_5->lock(lm_write_only);
+    lattice.f_eq_6->lock(lm_write_only);
+    lattice.f_eq_7->lock(lm_write_only);
+    lattice.f_eq_8->lock(lm_write_only);
+
+    unsigned long begin((*info.limits)[0]);
+    unsigned long end((*info.limits)[info.limits->size() - 1]);
+
+
+    sse::eq_dist_grid_dir_0(begin, end, g, e,
+            fields.h->elements(), fields.u->elements(), fields.v->elements(),
+            lattice.f_eq_0->elements());
+
+    sse::eq_dist_grid_dir_odd(begin, end, g, e,
+            fields.h->elements(), fields.u->elements(), fields.v->elements(),
+            fields.distribution_x->elements(), fields.distribution_y->elements(),
+            lattice.f_eq_1->elements(), 1);
+
+    sse::eq_dist_grid_dir_odd(begin, end, g, e,
+            fields.h->elements(), fields.u->elements(), fields.v->elements(),
+            fields.distribution_x->elements(), fields.distribution_y->elements(),
+            lattice.f_eq_3->elements(), 3);
+
+    sse::eq_dist_grid_dir_odd(begin, end, g, e,
+            fields.h->elements(), fields.u->elements(), fields.v->elements(),
+            fields.distribution_x->elements(), fields.distribution_y->elements(),
+            lattice.f_eq_5->elements(), 5);
+
+    sse::eq_dist_grid_dir_odd(begin, end, g, e,
+            fields.h->elements(), fields.u->elements(), fields.v->elements(),
+            fields.distribution_x->elements(), fields.distribution_y->elements(),
+            lattice.f_eq_7->elements(), 7);
+
+    sse::eq_dist_grid_dir_even(begin, end, g, e,
+            fields.h->elements(), fields.u->elements(), fields.v->elements(),
+            fields.distribution_x->elements(), fields.distribution_y->elements(),
+            lattice.f_eq_2->elements(), 2);
+
+    sse::eq_dist_grid_dir_even(begin, end, g, e,
+            fields.h->elements(), fields.u->elements(), fields.v->elements(),
+            fields.distribution_x->elements(), fields.distribution_y->elements(),
+            lattice.f_eq_4->elements(), 4);
+
+    sse::eq_dist_grid_dir_even(begin, end, g, e,
+            fields.h->elements(), fields.u->elements(), fields.v->elements(),
+            fields.distribution_x->elements(), fields.distribution_y->elements(),
+            lattice.f_eq_6->elements(), 6);
+
+    sse::eq_dist_grid_dir_even(begin, end, g, e,
+            fields.h->elements(), fields.u->elements(), fields.v->elements(),
+            fields.distribution_x->elements(), fields.distribution_y->elements(),
+            lattice.f_eq_8->elements(), 8);
+
+    info.limits->unlock(lm_read_only);
+
+    fields.u->unlock(lm_read_only);
+    fields.v->unlock(lm_read_only);
+    fields.h->unlock(lm_read_only);
+
+    fields.distribution_x->unlock(lm_read_only);
+    fields.distribution_y->unlock(lm_read_only);
+
+    lattice.f_eq_0->unlock(lm_write_only);
+    lattice.f_eq_1->unlock(lm_write_only);
+    lattice.f_eq_2->unlock(lm_write_only);
+    lattice.f_eq_3->unlock(lm_write_only);
+    lattice.f_eq_4->unlock(lm_write_only);
+    lattice.f_eq_5->unlock(lm_write_only);
+    lattice.f_eq_6->unlock(lm_write_only);
+    lattice.f_eq_7->unlock(lm_write_only);
+    lattice.f_eq_8->unlock(lm_write_only);
+}
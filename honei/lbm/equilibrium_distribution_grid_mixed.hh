@@ -0,0 +1,202 @@
+/* vim: set number sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LBM C++ library. LBM is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LBM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#pragma once
+#ifndef LBM_GUARD_EQUILIBRIUM_DISTRIBUTION_GRID_MIXED_HH
+#define LBM_GUARD_EQUILIBRIUM_DISTRIBUTION_GRID_MIXED_HH 1
+
+/**
+ * \file
+ * Implementation of mixed precision local equilibrium distribution functions used by LBM - (SWE) grid solvers,
+ * reading double macroscopic fields and writing float distributions.
+ *
+ * \ingroup grpliblbm
+ **/
+
+#include <honei/lbm/tags.hh>
+#include <honei/la/dense_vector.hh>
+#include <honei/lbm/grid.hh>
+#include <honei/util/benchmark_info.hh>
+#include <honei/util/attributes.hh>
+
+using namespace honei;
+using namespace lbm;
+using namespace lbm_lattice_types;
+
+namespace honei
+{
+    template<typename Tag_, typename App_>
+        struct EquilibriumDistributionGridMixed
+        {
+        };
+
+    /**
+     * \brief Mixed precision equilibrium distribution for LABSWE.
+     *
+     * Computes the equilibrium distribution in double precision from the double h, u, v,
+     * distribution_x and distribution_y of fields and stores it, rounded to float, in f_eq of the
+     * float lattice.
+     *
+     * \ingroup grplbmoperations
+     */
+    template<>
+        struct EquilibriumDistributionGridMixed<tags::CPU::Generic, lbm_applications::LABSWE>
+        {
+            static void value(double g, double e, PackedGridInfo<D2Q9> & info, PackedGridData<D2Q9, double> & fields,
+                    PackedGridData<D2Q9, float> & lattice)
+            {
+                CONTEXT("When computing LABSWE local equilibrium distribution function (mixed precision):");
+
+                info.limits->lock(lm_read_only);
+
+                fields.u->lock(lm_read_only);
+                fields.v->lock(lm_read_only);
+                fields.h->lock(lm_read_only);
+
+                fields.distribution_x->lock(lm_read_only);
+                fields.distribution_y->lock(lm_read_only);
+
+                lattice.f_eq_0->lock(lm_write_only);
+                lattice.f_eq_1->lock(lm_write_only);
+                lattice.f_eq_2->lock(lm_write_only);
+                lattice.f_eq_3->lock(lm_write_only);
+                lattice.f_eq_4->lock(lm_write_only);
+                lattice.f_eq_5->lock(lm_write_only);
+                lattice.f_eq_6->lock(lm_write_only);
+                lattice.f_eq_7->lock(lm_write_only);
+                lattice.f_eq_8->lock(lm_write_only);
+
+                const unsigned long * const limits(info.limits->elements());
+                const double * const tu(fields.u->elements());
+                const double * const tv(fields.v->elements());
+                const double * const th(fields.h->elements());
+                const double * const distribution_x(fields.distribution_x->elements());
+                const double * const distribution_y(fields.distribution_y->elements());
+
+                float * const f_eq[9] = {
+                    lattice.f_eq_0->elements(), lattice.f_eq_1->elements(), lattice.f_eq_2->elements(),
+                    lattice.f_eq_3->elements(), lattice.f_eq_4->elements(), lattice.f_eq_5->elements(),
+                    lattice.f_eq_6->elements(), lattice.f_eq_7->elements(), lattice.f_eq_8->elements()
+                };
+
+                const double e2(e);
+                const double e42(double(2.) * e2 * e2);
+                const double e23(double(3.) * e2);
+                const double e26(double(6.) * e2);
+                const double e48(double(8.) * e2 * e2);
+                const double e212(double(12.) * e2);
+                const double e224(double(24.) * e2);
+
+                const unsigned long start(limits[0]);
+                const unsigned long end(limits[info.limits->size() - 1]);
+                for(unsigned long i(start); i < end; ++i)
+                {
+                    const double u(tu[i]);
+                    const double v(tv[i]);
+                    const double h(th[i]);
+                    const double u2(u * u);
+                    const double v2(v * v);
+                    const double gh(g * h);
+
+                    f_eq[0][i] = float(h * (double(1) - (double(5.) * gh) / e26 - double(2.) / e23 * (u2 + v2)));
+
+                    // odd directions
+                    for (unsigned long dir(1) ; dir < 9 ; dir += 2)
+                    {
+                        const double dxu(distribution_x[dir] * u);
+                        const double dyv(distribution_y[dir] * v);
+                        const double t1((gh) / e26);
+                        const double t2((dxu + dyv) / e23);
+                        const double t3((dxu * dxu + double(2.) * dxu * dyv + dyv * dyv) / e42);
+                        const double t4((u2 + v2) / e26);
+                        f_eq[dir][i] = float(h * (t1 + t2 + t3 - t4));
+                    }
+
+                    // even directions
+                    for (unsigned long dir(2) ; dir < 9 ; dir += 2)
+                    {
+                        const double dxu(distribution_x[dir] * u);
+                        const double dyv(distribution_y[dir] * v);
+                        const double t1((gh) / e224);
+                        const double t2((dxu + dyv) / e212);
+                        const double t3((dxu * dxu + double(2.) * dxu * dyv + dyv * dyv) / e48);
+                        const double t4((u2 + v2) / e224);
+                        f_eq[dir][i] = float(h * (t1 + t2 + t3 - t4));
+                    }
+                }
+
+                info.limits->unlock(lm_read_only);
+
+                fields.u->unlock(lm_read_only);
+                fields.v->unlock(lm_read_only);
+                fields.h->unlock(lm_read_only);
+
+                fields.distribution_x->unlock(lm_read_only);
+                fields.distribution_y->unlock(lm_read_only);
+
+                lattice.f_eq_0->unlock(lm_write_only);
+                lattice.f_eq_1->unlock(lm_write_only);
+                lattice.f_eq_2->unlock(lm_write_only);
+                lattice.f_eq_3->unlock(lm_write_only);
+                lattice.f_eq_4->unlock(lm_write_only);
+                lattice.f_eq_5->unlock(lm_write_only);
+                lattice.f_eq_6->unlock(lm_write_only);
+                lattice.f_eq_7->unlock(lm_write_only);
+                lattice.f_eq_8->unlock(lm_write_only);
+            }
+
+            static inline BenchmarkInfo get_benchmark_info(HONEI_UNUSED PackedGridInfo<D2Q9> * info, PackedGridData<D2Q9, float> * lattice)
+            {
+                BenchmarkInfo result;
+                result.flops = lattice->h->size() * 12 + 8 * lattice->h->size() * 27;
+                result.load = lattice->h->size() * 3 * sizeof(double);
+                result.store = lattice->h->size() * 9 * sizeof(float);
+                result.size.push_back(lattice->h->size());
+                return result;
+            }
+        };
+
+    template<>
+        struct EquilibriumDistributionGridMixed<tags::CPU, lbm_applications::LABSWE>
+        {
+            static void value(double g, double e, PackedGridInfo<D2Q9> & info, PackedGridData<D2Q9, double> & fields,
+                    PackedGridData<D2Q9, float> & lattice)
+            {
+                EquilibriumDistributionGridMixed<tags::CPU::Generic, lbm_applications::LABSWE>::value(g, e, info, fields, lattice);
+            }
+
+            static inline BenchmarkInfo get_benchmark_info(PackedGridInfo<D2Q9> * info, PackedGridData<D2Q9, float> * lattice)
+            {
+                return EquilibriumDistributionGridMixed<tags::CPU::Generic, lbm_applications::LABSWE>::get_benchmark_info(info, lattice);
+            }
+        };
+
+    template<>
+        struct EquilibriumDistributionGridMixed<tags::CPU::SSE, lbm_applications::LABSWE>
+        {
+            static void value(double g, double e, PackedGridInfo<D2Q9> & info, PackedGridData<D2Q9, double> & fields,
+                    PackedGridData<D2Q9, float> & lattice);
+
+            static inline BenchmarkInfo get_benchmark_info(PackedGridInfo<D2Q9> * info, PackedGridData<D2Q9, float> * lattice)
+            {
+                return EquilibriumDistributionGridMixed<tags::CPU::Generic, lbm_applications::LABSWE>::get_benchmark_info(info, lattice);
+            }
+        };
+}
+#endif
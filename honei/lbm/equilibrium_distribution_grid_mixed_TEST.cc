@@ -0,0 +1,101 @@
+/* vim: set number sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LBM C++ library. LBM is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LBM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <honei/lbm/equilibrium_distribution_grid_mixed.hh>
+#include <honei/lbm/solver_lbm_grid.hh>
+#include <honei/lbm/grid.hh>
+#include <honei/lbm/grid_packer.hh>
+#include <honei/lbm/scenario_collection.hh>
+#include <honei/util/unittest.hh>
+#include <cmath>
+#include <limits>
+
+using namespace honei;
+using namespace tests;
+using namespace std;
+using namespace lbm::lbm_lattice_types;
+
+template <typename Tag_>
+class EquilibriumDistributionGridMixedTest :
+    public TaggedTest<Tag_>
+{
+    public:
+        EquilibriumDistributionGridMixedTest(const std::string & type) :
+            TaggedTest<Tag_>("equilibrium_distribution_grid_mixed_test<" + type + ">")
+        {
+        }
+
+        virtual void run() const
+        {
+            for (unsigned long scen(0) ; scen < ScenarioCollection::get_stable_scenario_count() ; ++scen)
+            {
+                unsigned long g_h(50);
+                unsigned long g_w(50);
+
+                Grid<D2Q9, double> grid;
+                ScenarioCollection::get_scenario(scen, g_h, g_w, grid);
+                PackedGridData<D2Q9, double> data;
+                PackedGridInfo<D2Q9> info;
+                GridPacker<D2Q9, NOSLIP, double>::pack(grid, info, data);
+
+                Grid<D2Q9, float> grid_lattice;
+                ScenarioCollection::get_scenario(scen, g_h, g_w, grid_lattice);
+                PackedGridData<D2Q9, float> lattice;
+                PackedGridInfo<D2Q9> info_lattice;
+                GridPacker<D2Q9, NOSLIP, float>::pack(grid_lattice, info_lattice, lattice);
+
+                // a few time steps to get non trivial velocities
+                SolverLBMGrid<tags::CPU::Generic, lbm_applications::LABSWE, double, lbm_force::CENTRED, lbm_source_schemes::BED_FULL, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, lbm_modes::DRY>
+                    solver(&info, &data, grid.d_x, grid.d_y, grid.d_t, grid.tau);
+                solver.do_preprocessing();
+                for (unsigned long i(0) ; i < 20 ; ++i)
+                    solver.solve();
+
+                double e(grid.d_x / grid.d_t);
+                EquilibriumDistributionGrid<tags::CPU, lbm_applications::LABSWE>::value(9.80665, e * e, info, data);
+                EquilibriumDistributionGridMixed<Tag_, lbm_applications::LABSWE>::value(9.80665, e * e, info, data, lattice);
+
+                DenseVector<double> * f_eq[9] = { data.f_eq_0, data.f_eq_1, data.f_eq_2, data.f_eq_3,
+                    data.f_eq_4, data.f_eq_5, data.f_eq_6, data.f_eq_7, data.f_eq_8 };
+                DenseVector<float> * f_eq_lattice[9] = { lattice.f_eq_0, lattice.f_eq_1, lattice.f_eq_2, lattice.f_eq_3,
+                    lattice.f_eq_4, lattice.f_eq_5, lattice.f_eq_6, lattice.f_eq_7, lattice.f_eq_8 };
+                for (unsigned long dir(0) ; dir < 9 ; ++dir)
+                {
+                    for (unsigned long i(0) ; i < data.h->size() ; ++i)
+                    {
+                        // only the final rounding to float may differ
+                        double reference((*f_eq[dir])[i]);
+                        TEST_CHECK_EQUAL_WITHIN_EPS(double((*f_eq_lattice[dir])[i]), reference,
+                                std::numeric_limits<float>::epsilon() * std::abs(reference) + std::numeric_limits<double>::epsilon());
+                    }
+                }
+
+                grid.destroy();
+                info.destroy();
+                data.destroy();
+                grid_lattice.destroy();
+                info_lattice.destroy();
+                lattice.destroy();
+            }
+        }
+};
+EquilibriumDistributionGridMixedTest<tags::CPU> equilibrium_distribution_grid_mixed_test("mixed");
+EquilibriumDistributionGridMixedTest<tags::CPU::Generic> generic_equilibrium_distribution_grid_mixed_test("mixed");
+#ifdef HONEI_SSE
+EquilibriumDistributionGridMixedTest<tags::CPU::SSE> sse_equilibrium_distribution_grid_mixed_test("mixed");
+#endif
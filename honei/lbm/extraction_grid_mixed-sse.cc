@@ -0,0 +1,116 @@
+/* vim: set sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LA C++ library. LibLa is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LibLa is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <honei/lbm/extraction_grid_mixed.hh>
+#include <honei/backends/sse/operations.hh>
+
+using namespace honei;
+
+void ExtractionGridMixed<tags::CPU::SSE, lbm_modes::DRY>::value(PackedGridInfo<D2Q9> & info,
+        PackedGridData<D2Q9, float> & lattice, PackedGridData<D2Q9, double> & fields, double epsilon)
+{
+    CONTEXT("When extracting h, u and v (mixed precision, SSE):");
+
+    //set f to t_temp
+    DenseVector<float> * swap;
+    swap = lattice.f_0;
+    lattice.f_0 = lattice.f_temp_0;
+    lattice.f_temp_0 = swap;
+    swap = lattice.f_1;
+    lattice.f_1 = lattice.f_temp_1;
+    lattice.f_temp_1 = swap;
+    swap = lattice.f_2;
+    lattice.f_2 = lattice.f_temp_2;
+    lattice.f_temp_2 = swap;
+    swap = lattice.f_3;
+    lattice.f_3 = lattice.f_temp_3;
+    lattice.f_temp_3 = swap;
+    swap = lattice.f_4;
+    lattice.f_4 = lattice.f_temp_4;
+    lattice.f_temp_4 = swap;
+    swap = lattice.f_5;
+    lattice.f_5 = lattice.f_temp_5;
+    lattice.f_temp_5 = swap;
+    swap = lattice.f_6;
+    lattice.f_6 = lattice.f_temp_6;
+    lattice.f_temp_6 = swap;
+    swap = lattice.f_7;
+    lattice.f_7 = lattice.f_temp_7;
+    lattice.f_temp_7 = swap;
+    swap = lattice.f_8;
+    lattice.f_8 = lattice.f_temp_8;
+    lattice.f_temp_8 = swap;
+
+    info.limits->lock(lm_read_only);
+
+    lattice.f_0->lock(lm_read_only);
+    lattice.f_1->lock(lm_read_only);
+    lattice.f_2->lock(lm_read_only);
+    lattice.f_3->lock(lm_read_only);
+    lattice.f_4->lock(lm_read_only);
+    lattice.f_5->lock(lm_read_only);
+    lattice.f_6->lock(lm_read_only);
+    lattice.f_7->lock(lm_read_only);
+    lattice.f_8->lock(lm_read_only);
+
+    lattice.h->lock(lm_write_only);
+    lattice.u->lock(lm_write_only);
+    lattice.v->lock(lm_write_only);
+
+    fields.distribution_x->lock(lm_read_only);
+    fields.distribution_y->lock(lm_read_only);
+
+    fields.h->lock(lm_write_only);
+    fields.u->lock(lm_write_only);
+    fields.v->lock(lm_write_only);
+
+    unsigned long begin((*info.limits)[0]);
+    unsigned long end((*info.limits)[info.limits->size() - 1]);
+
+    sse::extraction_grid_dry(begin, end,
+            fields.distribution_x->elements(), fields.distribution_y->elements(),
+            fields.h->elements(), fields.u->elements(), fields.v->elements(),
+            lattice.h->elements(), lattice.u->elements(), lattice.v->elements(),
+            lattice.f_0->elements(), lattice.f_1->elements(), lattice.f_2->elements(),
+            lattice.f_3->elements(), lattice.f_4->elements(), lattice.f_5->elements(),
+            lattice.f_6->elements(), lattice.f_7->elements(), lattice.f_8->elements(), epsilon);
+
+    info.limits->unlock(lm_read_only);
+
+    lattice.f_0->unlock(lm_read_only);
+    lattice.f_1->unlock(lm_read_only);
+    lattice.f_2->unlock(lm_read_only);
+    lattice.f_3->unlock(lm_read_only);
+    lattice.f_4->unlock(lm_read_only);
+    lattice.f_5->unlock(lm_read_only);
+    lattice.f_6->unlock(lm_read_only);
+    lattice.f_7->unlock(lm_read_only);
+    lattice.f_8->unlock(lm_read_only);
+
+    lattice.h->unlock(lm_write_only);
+    lattice.u->unlock(lm_write_only);
+    lattice.v->unlock(lm_write_only);
+
+    fields.distribution_x->unlock(lm_read_only);
+    fields.distribution_y->unlock(lm_read_only);
+
+    fields.h->unlock(lm_write_only);
+    fields.u->unlock(lm_write_only);
+    fields.v->unlock(lm_write_only);
+}
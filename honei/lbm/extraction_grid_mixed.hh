@@ -0,0 +1,266 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LBM C++ library. LBM is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LBM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#pragma once
+#ifndef LBM_GUARD_EXTRACTION_GRID_MIXED_HH
+#define LBM_GUARD_EXTRACTION_GRID_MIXED_HH 1
+
+
+/**
+ * \file
+ * Implementation of mixed precision extraction modules used by LBM - (SWE) grid solvers,
+ * reading float distributions and writing double macroscopic fields.
+ *
+ * \ingroup grpliblbm
+ **/
+
+#include <honei/lbm/tags.hh>
+#include <honei/la/dense_vector.hh>
+#include <honei/lbm/grid.hh>
+#include <honei/lbm/lbm_limiter.hh>
+#include <honei/util/benchmark_info.hh>
+#include <honei/util/attributes.hh>
+
+using namespace honei;
+using namespace lbm;
+using namespace lbm_lattice_types;
+
+namespace honei
+{
+    template<typename Tag_, typename LbmMode_>
+        struct ExtractionGridMixed
+        {
+        };
+
+    /**
+     * \brief Mixed precision extraction of h, u and v.
+     *
+     * Swaps f and f_temp of the float lattice and sums the float distributions in double precision
+     * into the double h, u and v of fields, using fields' distribution_x and distribution_y. The
+     * results are also stored, rounded to float, in h, u and v of the lattice, as read by the float
+     * force module.
+     *
+     * \ingroup grplbmoperations
+     */
+    template<>
+        struct ExtractionGridMixed<tags::CPU::Generic, lbm_modes::DRY>
+        {
+            public:
+                static void value(PackedGridInfo<D2Q9> & info, PackedGridData<D2Q9, float> & lattice,
+                        PackedGridData<D2Q9, double> & fields, double epsilon)
+                {
+                    CONTEXT("When extracting h, u and v (mixed precision):");
+
+                    //set f to t_temp
+                    DenseVector<float> * swap;
+                    swap = lattice.f_0;
+                    lattice.f_0 = lattice.f_temp_0;
+                    lattice.f_temp_0 = swap;
+                    swap = lattice.f_1;
+                    lattice.f_1 = lattice.f_temp_1;
+                    lattice.f_temp_1 = swap;
+                    swap = lattice.f_2;
+                    lattice.f_2 = lattice.f_temp_2;
+                    lattice.f_temp_2 = swap;
+                    swap = lattice.f_3;
+                    lattice.f_3 = lattice.f_temp_3;
+                    lattice.f_temp_3 = swap;
+                    swap = lattice.f_4;
+                    lattice.f_4 = lattice.f_temp_4;
+                    lattice.f_temp_4 = swap;
+                    swap = lattice.f_5;
+                    lattice.f_5 = lattice.f_temp_5;
+                    lattice.f_temp_5 = swap;
+                    swap = lattice.f_6;
+                    lattice.f_6 = lattice.f_temp_6;
+                    lattice.f_temp_6 = swap;
+                    swap = lattice.f_7;
+                    lattice.f_7 = lattice.f_temp_7;
+                    lattice.f_temp_7 = swap;
+                    swap = lattice.f_8;
+                    lattice.f_8 = lattice.f_temp_8;
+                    lattice.f_temp_8 = swap;
+
+                    info.limits->lock(lm_read_only);
+
+                    lattice.f_0->lock(lm_read_only);
+                    lattice.f_1->lock(lm_read_only);
+                    lattice.f_2->lock(lm_read_only);
+                    lattice.f_3->lock(lm_read_only);
+                    lattice.f_4->lock(lm_read_only);
+                    lattice.f_5->lock(lm_read_only);
+                    lattice.f_6->lock(lm_read_only);
+                    lattice.f_7->lock(lm_read_only);
+                    lattice.f_8->lock(lm_read_only);
+
+                    lattice.h->lock(lm_write_only);
+                    lattice.u->lock(lm_write_only);
+                    lattice.v->lock(lm_write_only);
+
+                    fields.distribution_x->lock(lm_read_only);
+                    fields.distribution_y->lock(lm_read_only);
+
+                    fields.h->lock(lm_write_only);
+                    fields.u->lock(lm_write_only);
+                    fields.v->lock(lm_write_only);
+
+                    const unsigned long * const limits(info.limits->elements());
+                    const float * const f_0(lattice.f_0->elements());
+                    const float * const f_1(lattice.f_1->elements());
+                    const float * const f_2(lattice.f_2->elements());
+                    const float * const f_3(lattice.f_3->elements());
+                    const float * const f_4(lattice.f_4->elements());
+                    const float * const f_5(lattice.f_5->elements());
+                    const float * const f_6(lattice.f_6->elements());
+                    const float * const f_7(lattice.f_7->elements());
+                    const float * const f_8(lattice.f_8->elements());
+
+                    float * h_f(lattice.h->elements());
+                    float * u_f(lattice.u->elements());
+                    float * v_f(lattice.v->elements());
+
+                    double * h(fields.h->elements());
+                    double * u(fields.u->elements());
+                    double * v(fields.v->elements());
+                    const double * const distribution_x(fields.distribution_x->elements());
+                    const double * const distribution_y(fields.distribution_y->elements());
+
+                    const double lax_upper(epsilon);
+                    const double lax_lower(-lax_upper);
+
+                    const unsigned long start(limits[0]);
+                    const unsigned long end(limits[info.limits->size() - 1]);
+                    for(unsigned long i(start); i < end; ++i)
+                    {
+                        const double t_0(f_0[i]);
+                        const double t_1(f_1[i]);
+                        const double t_2(f_2[i]);
+                        const double t_3(f_3[i]);
+                        const double t_4(f_4[i]);
+                        const double t_5(f_5[i]);
+                        const double t_6(f_6[i]);
+                        const double t_7(f_7[i]);
+                        const double t_8(f_8[i]);
+
+                        //accumulate
+                        double th(t_0 + t_1 + t_2 + t_3 + t_4 + t_5 + t_6 + t_7 + t_8);
+                        double tu(0), tv(0);
+
+                        if(th < lax_lower || th > lax_upper)
+                        {
+                            tu = (distribution_x[0] * t_0 +
+                                    distribution_x[1] * t_1 +
+                                    distribution_x[2] * t_2 +
+                                    distribution_x[3] * t_3 +
+                                    distribution_x[4] * t_4 +
+                                    distribution_x[5] * t_5 +
+                                    distribution_x[6] * t_6 +
+                                    distribution_x[7] * t_7 +
+                                    distribution_x[8] * t_8) / th;
+
+                            tv = (distribution_y[0] * t_0 +
+                                    distribution_y[1] * t_1 +
+                                    distribution_y[2] * t_2 +
+                                    distribution_y[3] * t_3 +
+                                    distribution_y[4] * t_4 +
+                                    distribution_y[5] * t_5 +
+                                    distribution_y[6] * t_6 +
+                                    distribution_y[7] * t_7 +
+                                    distribution_y[8] * t_8) / th;
+                        }
+                        else
+                        {
+                            th = 0;
+                        }
+                        th = MinModLimiter<tags::CPU>::value(th);
+
+                        h[i] = th;
+                        u[i] = tu;
+                        v[i] = tv;
+                        h_f[i] = float(th);
+                        u_f[i] = float(tu);
+                        v_f[i] = float(tv);
+                    }
+
+                    info.limits->unlock(lm_read_only);
+
+                    lattice.f_0->unlock(lm_read_only);
+                    lattice.f_1->unlock(lm_read_only);
+                    lattice.f_2->unlock(lm_read_only);
+                    lattice.f_3->unlock(lm_read_only);
+                    lattice.f_4->unlock(lm_read_only);
+                    lattice.f_5->unlock(lm_read_only);
+                    lattice.f_6->unlock(lm_read_only);
+                    lattice.f_7->unlock(lm_read_only);
+                    lattice.f_8->unlock(lm_read_only);
+
+                    lattice.h->unlock(lm_write_only);
+                    lattice.u->unlock(lm_write_only);
+                    lattice.v->unlock(lm_write_only);
+
+                    fields.distribution_x->unlock(lm_read_only);
+                    fields.distribution_y->unlock(lm_read_only);
+
+                    fields.h->unlock(lm_write_only);
+                    fields.u->unlock(lm_write_only);
+                    fields.v->unlock(lm_write_only);
+                }
+
+                static inline BenchmarkInfo get_benchmark_info(HONEI_UNUSED PackedGridInfo<D2Q9> * info, PackedGridData<D2Q9, float> * lattice)
+                {
+                    BenchmarkInfo result;
+                    result.flops = lattice->h->size() * 38;
+                    result.load = lattice->h->size() * 9 * sizeof(float);
+                    result.store = lattice->h->size() * 3 * (sizeof(double) + sizeof(float));
+                    result.size.push_back(lattice->h->size());
+                    return result;
+                }
+        };
+
+    template<>
+        struct ExtractionGridMixed<tags::CPU, lbm_modes::DRY>
+        {
+            public:
+                static void value(PackedGridInfo<D2Q9> & info, PackedGridData<D2Q9, float> & lattice,
+                        PackedGridData<D2Q9, double> & fields, double epsilon)
+                {
+                    ExtractionGridMixed<tags::CPU::Generic, lbm_modes::DRY>::value(info, lattice, fields, epsilon);
+                }
+
+                static inline BenchmarkInfo get_benchmark_info(PackedGridInfo<D2Q9> * info, PackedGridData<D2Q9, float> * lattice)
+                {
+                    return ExtractionGridMixed<tags::CPU::Generic, lbm_modes::DRY>::get_benchmark_info(info, lattice);
+                }
+        };
+
+    template<>
+        struct ExtractionGridMixed<tags::CPU::SSE, lbm_modes::DRY>
+        {
+            public:
+                static void value(PackedGridInfo<D2Q9> & info, PackedGridData<D2Q9, float> & lattice,
+                        PackedGridData<D2Q9, double> & fields, double epsilon);
+
+                static inline BenchmarkInfo get_benchmark_info(PackedGridInfo<D2Q9> * info, PackedGridData<D2Q9, float> * lattice)
+                {
+                    return ExtractionGridMixed<tags::CPU::Generic, lbm_modes::DRY>::get_benchmark_info(info, lattice);
+                }
+        };
+}
+#endif
@@ -0,0 +1,118 @@
+/* vim: set number sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LBM C++ library. LBM is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LBM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <honei/lbm/extraction_grid_mixed.hh>
+#include <honei/lbm/solver_lbm_grid.hh>
+#include <honei/lbm/grid.hh>
+#include <honei/lbm/grid_packer.hh>
+#include <honei/lbm/scenario_collection.hh>
+#include <honei/util/unittest.hh>
+#include <limits>
+
+using namespace honei;
+using namespace tests;
+using namespace std;
+using namespace lbm::lbm_lattice_types;
+
+template <typename Tag_>
+class ExtractionGridMixedTest :
+    public TaggedTest<Tag_>
+{
+    public:
+        ExtractionGridMixedTest(const std::string & type) :
+            TaggedTest<Tag_>("extraction_grid_mixed_test<" + type + ">")
+        {
+        }
+
+        virtual void run() const
+        {
+            for (unsigned long scen(0) ; scen < ScenarioCollection::get_stable_scenario_count() ; ++scen)
+            {
+                unsigned long g_h(50);
+                unsigned long g_w(50);
+
+                Grid<D2Q9, double> grid;
+                ScenarioCollection::get_scenario(scen, g_h, g_w, grid);
+                PackedGridData<D2Q9, double> data;
+                PackedGridInfo<D2Q9> info;
+                GridPacker<D2Q9, NOSLIP, double>::pack(grid, info, data);
+
+                Grid<D2Q9, double> grid_fields;
+                ScenarioCollection::get_scenario(scen, g_h, g_w, grid_fields);
+                PackedGridData<D2Q9, double> fields;
+                PackedGridInfo<D2Q9> info_fields;
+                GridPacker<D2Q9, NOSLIP, double>::pack(grid_fields, info_fields, fields);
+
+                Grid<D2Q9, float> grid_lattice;
+                ScenarioCollection::get_scenario(scen, g_h, g_w, grid_lattice);
+                PackedGridData<D2Q9, float> lattice;
+                PackedGridInfo<D2Q9> info_lattice;
+                GridPacker<D2Q9, NOSLIP, float>::pack(grid_lattice, info_lattice, lattice);
+
+                // sets up the lattice velocities and streamed distributions
+                SolverLBMGrid<tags::CPU, lbm_applications::LABSWE, double, lbm_force::NONE, lbm_source_schemes::NONE, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, lbm_modes::DRY>
+                    solver(&info, &data, grid.d_x, grid.d_y, grid.d_t, grid.tau);
+                solver.do_preprocessing();
+                *fields.distribution_x = data.distribution_x->copy();
+                *fields.distribution_y = data.distribution_y->copy();
+
+                // both kernels see the same, float representable distributions
+                DenseVector<double> * f_temp[9] = { data.f_temp_0, data.f_temp_1, data.f_temp_2, data.f_temp_3,
+                    data.f_temp_4, data.f_temp_5, data.f_temp_6, data.f_temp_7, data.f_temp_8 };
+                DenseVector<float> * f_temp_lattice[9] = { lattice.f_temp_0, lattice.f_temp_1, lattice.f_temp_2, lattice.f_temp_3,
+                    lattice.f_temp_4, lattice.f_temp_5, lattice.f_temp_6, lattice.f_temp_7, lattice.f_temp_8 };
+                for (unsigned long dir(0) ; dir < 9 ; ++dir)
+                {
+                    for (unsigned long i(0) ; i < f_temp[dir]->size() ; ++i)
+                    {
+                        (*f_temp_lattice[dir])[i] = float((*f_temp[dir])[i]);
+                        (*f_temp[dir])[i] = (*f_temp_lattice[dir])[i];
+                    }
+                }
+
+                ExtractionGrid<tags::CPU, lbm_modes::DRY>::value(info, data, double(10e-5));
+                ExtractionGridMixed<Tag_, lbm_modes::DRY>::value(info, lattice, fields, double(10e-5));
+
+                TEST_CHECK_EQUAL((*lattice.f_0)[0], float((*data.f_0)[0]));
+                for (unsigned long i(0) ; i < data.h->size() ; ++i)
+                {
+                    TEST_CHECK_EQUAL_WITHIN_EPS((*fields.h)[i], (*data.h)[i], std::numeric_limits<double>::epsilon() * 10);
+                    TEST_CHECK_EQUAL_WITHIN_EPS((*fields.u)[i], (*data.u)[i], std::numeric_limits<double>::epsilon() * 10);
+                    TEST_CHECK_EQUAL_WITHIN_EPS((*fields.v)[i], (*data.v)[i], std::numeric_limits<double>::epsilon() * 10);
+                    TEST_CHECK_EQUAL((*lattice.h)[i], float((*fields.h)[i]));
+                    TEST_CHECK_EQUAL((*lattice.u)[i], float((*fields.u)[i]));
+                    TEST_CHECK_EQUAL((*lattice.v)[i], float((*fields.v)[i]));
+                }
+
+                grid.destroy();
+                info.destroy();
+                data.destroy();
+                grid_fields.destroy();
+                info_fields.destroy();
+                fields.destroy();
+                grid_lattice.destroy();
+                info_lattice.destroy();
+                lattice.destroy();
+            }
+        }
+};
+ExtractionGridMixedTest<tags::CPU> extraction_grid_mixed_test("mixed");
+ExtractionGridMixedTest<tags::CPU::Generic> generic_extraction_grid_mixed_test("mixed");
+#ifdef HONEI_SSE
+ExtractionGridMixedTest<tags::CPU::SSE> sse_extraction_grid_mixed_test("mixed");
+#endif
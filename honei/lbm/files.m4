@@ -10,24 +10,31 @@ dnl on this file at present...
 
 add(`boundary_init_fsi',               `hh', `test', `cuda')
 add(`bitmap_io',                       `hh', `test')
-add(`collide_stream',                  `hh', `test')
+add(`collide_stream',                  `hh', `sse', `test')
 add(`collide_stream_grid',             `hh', `sse', `cuda', `cell', `itanium', `test')
+add(`collide_stream_grid_aa',          `hh')
 add(`collide_stream_fsi',              `hh', `test', `cuda')
 add(`collide_stream_grid_regression',        `test')
 add(`dc_advanced',                           `test')
 add(`dc_advanced_grid',                      `test')
 add(`dc_advanced_fsi',                       `test')
 add(`dc_util',                         `hh')
-add(`equilibrium_distribution',        `hh', `test')
+add(`equilibrium_distribution',        `hh', `sse', `test')
 add(`equilibrium_distribution_grid',   `hh', `sse', `cuda', `cell', `itanium', `test')
+add(`equilibrium_distribution_grid_mixed',   `hh', `sse', `test')
 add(`equilibrium_distribution_grid_regression',  `test')
 add(`extraction_grid',                 `hh', `sse', `cuda', `cell', `itanium', `test')
+add(`extraction_grid_mixed',           `hh', `sse', `test')
 add(`extraction_grid_regression',            `test')
 add(`force_grid',                      `hh', `test', `sse', `cuda')
 add(`fluid_solid_interaction',               `test')
 add(`grid',                            `hh')
+add(`grid_checkpoint',                 `hh')
+add(`grid_ensemble',                   `hh', `test')
+add(`grid_output',                     `hh', `test')
 add(`grid_packer',                     `hh', `test')
 add(`grid_partitioner',                `hh', `test')
+add(`grid_tiler',                      `hh', `test')
 add(`lbm_limiter',                     `hh', `test')
 add(`partial_derivative',              `hh', `test')
 add(`scenario_collection',             `hh', `test')
@@ -36,6 +43,9 @@ add(`solid',                           `hh', `test')
 add(`solid_emulation_fsi',             `hh', `test')
 add(`solver_labswe',                   `hh', `test')
 add(`solver_lbm_grid',                 `hh', `test')
+add(`solver_lbm_grid_aa',              `hh', `test')
+add(`solver_lbm_grid_active',          `hh', `test')
+add(`solver_lbm_grid_mixed',           `hh', `test')
 add(`solver_lbm_fsi',                  `hh', `test')
 add(`solver_lbm_fsi_external_comparison',    `test')
 add(`solver_lbm_grid_multi',                 `test')
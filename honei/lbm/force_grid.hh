@@ -42,6 +42,18 @@ using namespace honei::lbm;
 
 namespace honei
 {
+    namespace intern
+    {
+        /// Clear the scratch vector on the cells of the grid a force kernel works on.
+        template <typename DT_>
+            inline void clear_force_temp(DenseVector<DT_> & temp, PackedGridInfo<lbm_lattice_types::D2Q9> & info)
+            {
+                DT_ * const elements(temp.elements());
+                for (unsigned long i((*info.limits)[0]) ; i < (*info.limits)[info.limits->size() - 1] ; ++i)
+                    elements[i] = DT_(0);
+            }
+    }
+
    template <typename Tag_,
               typename App_,
               typename SourceType_,
@@ -117,7 +129,7 @@ namespace honei
 
                 //-----------alpha = 1 ----------------------------------------------------------------------------------------------
 
-                fill<tags::CPU>(temp);
+                intern::clear_force_temp(temp, info);
                 //set up temp (x)
                 for (unsigned long begin(0), half(0) ; begin < info.dir_index_1->size() - 1; begin+=2, ++half)
                 {
@@ -152,7 +164,7 @@ namespace honei
 
                 //-----------alpha = 2 ----------------------------------------------------------------------------------------------
 
-                fill<tags::CPU>(temp);
+                intern::clear_force_temp(temp, info);
                 //set up temp (x)
                 for (unsigned long begin(0), half(0) ; begin < info.dir_index_2->size() - 1; begin+=2, ++half)
                 {
@@ -184,7 +196,7 @@ namespace honei
 
                 //REPEAT FOR Y
 
-                fill<tags::CPU>(temp);
+                intern::clear_force_temp(temp, info);
                 //set up temp (y)
                 for (unsigned long begin(0), half(0) ; begin < info.dir_index_2->size() - 1; begin+=2, ++half)
                 {
@@ -219,7 +231,7 @@ namespace honei
 
                 // Y DIRECTION ONLY
 
-                fill<tags::CPU>(temp);
+                intern::clear_force_temp(temp, info);
                 //set up temp (y)
                 for (unsigned long begin(0), half(0) ; begin < info.dir_index_3->size() - 1; begin+=2, ++half)
                 {
@@ -251,7 +263,7 @@ namespace honei
 
                 //-----------alpha = 4 ----------------------------------------------------------------------------------------------
 
-                fill<tags::CPU>(temp);
+                intern::clear_force_temp(temp, info);
                 //set up temp (x)
                 for (unsigned long begin(0), half(0) ; begin < info.dir_index_4->size() - 1; begin+=2, ++half)
                 {
@@ -283,7 +295,7 @@ namespace honei
 
                 //REPEAT FOR Y
 
-                fill<tags::CPU>(temp);
+                intern::clear_force_temp(temp, info);
                 //set up temp (y)
                 for (unsigned long begin(0), half(0) ; begin < info.dir_index_4->size() - 1; begin+=2, ++half)
                 {
@@ -316,7 +328,7 @@ namespace honei
                 //-----------alpha = 5 ----------------------------------------------------------------------------------------------
                 //X ONLY
 
-                fill<tags::CPU>(temp);
+                intern::clear_force_temp(temp, info);
                 //set up temp (x)
                 for (unsigned long begin(0), half(0) ; begin < info.dir_index_5->size() - 1; begin+=2, ++half)
                 {
@@ -348,7 +360,7 @@ namespace honei
 
                 //-----------alpha = 6 ----------------------------------------------------------------------------------------------
 
-                fill<tags::CPU>(temp);
+                intern::clear_force_temp(temp, info);
                 //set up temp (x)
                 for (unsigned long begin(0), half(0) ; begin < info.dir_index_6->size() - 1; begin+=2, ++half)
                 {
@@ -380,7 +392,7 @@ namespace honei
 
                 //REPEAT FOR Y
 
-                fill<tags::CPU>(temp);
+                intern::clear_force_temp(temp, info);
                 //set up temp (y)
                 for (unsigned long begin(0), half(0) ; begin < info.dir_index_6->size() - 1; begin+=2, ++half)
                 {
@@ -414,7 +426,7 @@ namespace honei
 
                 //Y ONLY
 
-                fill<tags::CPU>(temp);
+                intern::clear_force_temp(temp, info);
                 //set up temp (y)
                 for (unsigned long begin(0), half(0) ; begin < info.dir_index_7->size() - 1; begin+=2, ++half)
                 {
@@ -446,7 +458,7 @@ namespace honei
 
                 //-----------alpha = 8 ----------------------------------------------------------------------------------------------
 
-                fill<tags::CPU>(temp);
+                intern::clear_force_temp(temp, info);
                 //set up temp (x)
                 for (unsigned long begin(0), half(0) ; begin < info.dir_index_8->size() - 1; begin+=2, ++half)
                 {
@@ -478,7 +490,7 @@ namespace honei
 
                 //REPEAT FOR Y
 
-                fill<tags::CPU>(temp);
+                intern::clear_force_temp(temp, info);
                 //set up temp (y)
                 for (unsigned long begin(0), half(0) ; begin < info.dir_index_8->size() - 1; begin+=2, ++half)
                 {
@@ -638,7 +650,7 @@ namespace honei
 
                 //-----------alpha = 1 ----------------------------------------------------------------------------------------------
 
-                fill<tags::CPU>(temp);
+                intern::clear_force_temp(temp, info);
                 //set up temp (x)
                 for (unsigned long begin(0), half(0) ; begin < info.dir_index_1->size() - 1; begin+=2, ++half)
                 {
@@ -673,7 +685,7 @@ namespace honei
 
                 //-----------alpha = 2 ----------------------------------------------------------------------------------------------
 
-                fill<tags::CPU>(temp);
+                intern::clear_force_temp(temp, info);
                 //set up temp (x)
                 for (unsigned long begin(0), half(0) ; begin < info.dir_index_2->size() - 1; begin+=2, ++half)
                 {
@@ -705,7 +717,7 @@ namespace honei
 
                 //REPEAT FOR Y
 
-                fill<tags::CPU>(temp);
+                intern::clear_force_temp(temp, info);
                 //set up temp (y)
                 for (unsigned long begin(0), half(0) ; begin < info.dir_index_2->size() - 1; begin+=2, ++half)
                 {
@@ -740,7 +752,7 @@ namespace honei
 
                 // Y DIRECTION ONLY
 
-                fill<tags::CPU>(temp);
+                intern::clear_force_temp(temp, info);
                 //set up temp (y)
                 for (unsigned long begin(0), half(0) ; begin < info.dir_index_3->size() - 1; begin+=2, ++half)
                 {
@@ -772,7 +784,7 @@ namespace honei
 
                 //-----------alpha = 4 ----------------------------------------------------------------------------------------------
 
-                fill<tags::CPU>(temp);
+                intern::clear_force_temp(temp, info);
                 //set up temp (x)
                 for (unsigned long begin(0), half(0) ; begin < info.dir_index_4->size() - 1; begin+=2, ++half)
                 {
@@ -804,7 +816,7 @@ namespace honei
 
                 //REPEAT FOR Y
 
-                fill<tags::CPU>(temp);
+                intern::clear_force_temp(temp, info);
                 //set up temp (y)
                 for (unsigned long begin(0), half(0) ; begin < info.dir_index_4->size() - 1; begin+=2, ++half)
                 {
@@ -837,7 +849,7 @@ namespace honei
                 //-----------alpha = 5 ----------------------------------------------------------------------------------------------
                 //X ONLY
 
-                fill<tags::CPU>(temp);
+                intern::clear_force_temp(temp, info);
                 //set up temp (x)
                 for (unsigned long begin(0), half(0) ; begin < info.dir_index_5->size() - 1; begin+=2, ++half)
                 {
@@ -869,7 +881,7 @@ namespace honei
 
                 //-----------alpha = 6 ----------------------------------------------------------------------------------------------
 
-                fill<tags::CPU>(temp);
+                intern::clear_force_temp(temp, info);
                 //set up temp (x)
                 for (unsigned long begin(0), half(0) ; begin < info.dir_index_6->size() - 1; begin+=2, ++half)
                 {
@@ -901,7 +913,7 @@ namespace honei
 
                 //REPEAT FOR Y
 
-                fill<tags::CPU>(temp);
+                intern::clear_force_temp(temp, info);
                 //set up temp (y)
                 for (unsigned long begin(0), half(0) ; begin < info.dir_index_6->size() - 1; begin+=2, ++half)
                 {
@@ -935,7 +947,7 @@ namespace honei
 
                 //Y ONLY
 
-                fill<tags::CPU>(temp);
+                intern::clear_force_temp(temp, info);
                 //set up temp (y)
                 for (unsigned long begin(0), half(0) ; begin < info.dir_index_7->size() - 1; begin+=2, ++half)
                 {
@@ -967,7 +979,7 @@ namespace honei
 
                 //-----------alpha = 8 ----------------------------------------------------------------------------------------------
 
-                fill<tags::CPU>(temp);
+                intern::clear_force_temp(temp, info);
                 //set up temp (x)
                 for (unsigned long begin(0), half(0) ; begin < info.dir_index_8->size() - 1; begin+=2, ++half)
                 {
@@ -999,7 +1011,7 @@ namespace honei
 
                 //REPEAT FOR Y
 
-                fill<tags::CPU>(temp);
+                intern::clear_force_temp(temp, info);
                 //set up temp (y)
                 for (unsigned long begin(0), half(0) ; begin < info.dir_index_8->size() - 1; begin+=2, ++half)
                 {
@@ -0,0 +1,271 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LBM C++ library. LBM is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LBM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#pragma once
+#ifndef LBM_GUARD_GRID_CHECKPOINT_HH
+#define LBM_GUARD_GRID_CHECKPOINT_HH 1
+
+#include <honei/lbm/grid.hh>
+#include <honei/la/dense_vector.hh>
+#include <honei/util/hdf5_checkpoint.hh>
+
+#include <string>
+
+/**
+ * \file
+ * Definition of the LBM grid checkpoint, which saves and restores packed grids via HDF5.
+ *
+ * \ingroup grpliblbm
+ **/
+
+using namespace honei;
+using namespace lbm;
+using namespace lbm_lattice_types;
+
+namespace honei
+{
+    template <typename LatticeType_, typename DT_> struct GridCheckpoint
+    {
+    };
+
+    /**
+     * \brief Checkpoint and restart of packed grids.
+     *
+     * save copies the packed grid info, the solver state held in the packed grid data (h, u, v, b
+     * and the f and f_temp distributions) and the time step counter into a checkpoint buffer,
+     * usually one acquired from an HDF5CheckpointWriter. f_eq is recomputed in every time step
+     * and thus not saved. Vectors that are not allocated are skipped.
+     *
+     * To restart, set up the solver as for a new run, including do_preprocessing, then call
+     * load and pass the returned time step counter to the solver's set_time. load reads
+     * directly into the memory of the packed vectors; vectors that are not allocated yet are
+     * allocated with the size found in the checkpoint.
+     *
+     * \ingroup grpliblbm
+     */
+    template <typename DT_> struct GridCheckpoint<D2Q9, DT_>
+    {
+        private:
+            template <typename T_>
+            static void _save(HDF5Checkpoint & checkpoint, const std::string & name, DenseVector<T_> * vector)
+            {
+                if (vector == 0)
+                    return;
+
+                vector->lock(lm_read_only);
+                checkpoint.add(name, vector->elements(), vector->size());
+                vector->unlock(lm_read_only);
+            }
+
+            template <typename T_>
+            static void _load(HDF5File & file, const std::string & name, DenseVector<T_> * & vector)
+            {
+                if (! HDF5Checkpoint::contains(file, name))
+                    return;
+
+                if (vector == 0)
+                    vector = new DenseVector<T_>(HDF5Checkpoint::size(file, name));
+
+                vector->lock(lm_write_only);
+                HDF5Checkpoint::read(file, name, vector->elements(), vector->size());
+                vector->unlock(lm_write_only);
+            }
+
+        public:
+            /**
+             * Copy the state of a packed grid into a checkpoint.
+             *
+             * \param checkpoint The checkpoint to be filled.
+             * \param info Our info object.
+             * \param data Our packed grid data object.
+             * \param time The solver's time step counter.
+             */
+            static void save(HDF5Checkpoint & checkpoint, PackedGridInfo<D2Q9> & info, PackedGridData<D2Q9, DT_> & data,
+                    unsigned long time)
+            {
+                CONTEXT("When saving packed grid checkpoint:");
+
+                checkpoint.add("time", time);
+                checkpoint.add("info.offset", info.offset);
+                _save(checkpoint, "info.limits", info.limits);
+                _save(checkpoint, "info.types", info.types);
+                _save(checkpoint, "info.dir_1", info.dir_1);
+                _save(checkpoint, "info.dir_2", info.dir_2);
+                _save(checkpoint, "info.dir_3", info.dir_3);
+                _save(checkpoint, "info.dir_4", info.dir_4);
+                _save(checkpoint, "info.dir_5", info.dir_5);
+                _save(checkpoint, "info.dir_6", info.dir_6);
+                _save(checkpoint, "info.dir_7", info.dir_7);
+                _save(checkpoint, "info.dir_8", info.dir_8);
+                _save(checkpoint, "info.dir_index_1", info.dir_index_1);
+                _save(checkpoint, "info.dir_index_2", info.dir_index_2);
+                _save(checkpoint, "info.dir_index_3", info.dir_index_3);
+                _save(checkpoint, "info.dir_index_4", info.dir_index_4);
+                _save(checkpoint, "info.dir_index_5", info.dir_index_5);
+                _save(checkpoint, "info.dir_index_6", info.dir_index_6);
+                _save(checkpoint, "info.dir_index_7", info.dir_index_7);
+                _save(checkpoint, "info.dir_index_8", info.dir_index_8);
+
+                _save(checkpoint, "data.h", data.h);
+                _save(checkpoint, "data.u", data.u);
+                _save(checkpoint, "data.v", data.v);
+                _save(checkpoint, "data.b", data.b);
+                _save(checkpoint, "data.f_0", data.f_0);
+                _save(checkpoint, "data.f_1", data.f_1);
+                _save(checkpoint, "data.f_2", data.f_2);
+                _save(checkpoint, "data.f_3", data.f_3);
+                _save(checkpoint, "data.f_4", data.f_4);
+                _save(checkpoint, "data.f_5", data.f_5);
+                _save(checkpoint, "data.f_6", data.f_6);
+                _save(checkpoint, "data.f_7", data.f_7);
+                _save(checkpoint, "data.f_8", data.f_8);
+                _save(checkpoint, "data.f_temp_0", data.f_temp_0);
+                _save(checkpoint, "data.f_temp_1", data.f_temp_1);
+                _save(checkpoint, "data.f_temp_2", data.f_temp_2);
+                _save(checkpoint, "data.f_temp_3", data.f_temp_3);
+                _save(checkpoint, "data.f_temp_4", data.f_temp_4);
+                _save(checkpoint, "data.f_temp_5", data.f_temp_5);
+                _save(checkpoint, "data.f_temp_6", data.f_temp_6);
+                _save(checkpoint, "data.f_temp_7", data.f_temp_7);
+                _save(checkpoint, "data.f_temp_8", data.f_temp_8);
+                _save(checkpoint, "data.distribution_x", data.distribution_x);
+                _save(checkpoint, "data.distribution_y", data.distribution_y);
+            }
+
+            /**
+             * Copy the state of the solids of an FSI run into a checkpoint.
+             *
+             * \param checkpoint The checkpoint to be filled.
+             * \param solids Our packed solid data object.
+             */
+            static void save(HDF5Checkpoint & checkpoint, PackedSolidData<D2Q9, DT_> & solids)
+            {
+                CONTEXT("When saving packed solid checkpoint:");
+
+                _save(checkpoint, "solids.boundary_flags", solids.boundary_flags);
+                _save(checkpoint, "solids.line_flags", solids.line_flags);
+                _save(checkpoint, "solids.solid_flags", solids.solid_flags);
+                _save(checkpoint, "solids.solid_old_flags", solids.solid_old_flags);
+                _save(checkpoint, "solids.solid_to_fluid_flags", solids.solid_to_fluid_flags);
+                _save(checkpoint, "solids.stationary_flags", solids.stationary_flags);
+                _save(checkpoint, "solids.f_mea_1", solids.f_mea_1);
+                _save(checkpoint, "solids.f_mea_2", solids.f_mea_2);
+                _save(checkpoint, "solids.f_mea_3", solids.f_mea_3);
+                _save(checkpoint, "solids.f_mea_4", solids.f_mea_4);
+                _save(checkpoint, "solids.f_mea_5", solids.f_mea_5);
+                _save(checkpoint, "solids.f_mea_6", solids.f_mea_6);
+                _save(checkpoint, "solids.f_mea_7", solids.f_mea_7);
+                _save(checkpoint, "solids.f_mea_8", solids.f_mea_8);
+                checkpoint.add("solids.current_u", solids.current_u);
+                checkpoint.add("solids.current_v", solids.current_v);
+            }
+
+            /**
+             * Restore the state of a packed grid from a checkpoint file.
+             *
+             * \param file The checkpoint file.
+             * \param info Our info object.
+             * \param data Our packed grid data object.
+             *
+             * \return The solver's time step counter at the time of the checkpoint.
+             */
+            static unsigned long load(HDF5File & file, PackedGridInfo<D2Q9> & info, PackedGridData<D2Q9, DT_> & data)
+            {
+                CONTEXT("When loading packed grid checkpoint:");
+
+                info.offset = HDF5Checkpoint::read<unsigned long>(file, "info.offset");
+                _load(file, "info.limits", info.limits);
+                _load(file, "info.types", info.types);
+                _load(file, "info.dir_1", info.dir_1);
+                _load(file, "info.dir_2", info.dir_2);
+                _load(file, "info.dir_3", info.dir_3);
+                _load(file, "info.dir_4", info.dir_4);
+                _load(file, "info.dir_5", info.dir_5);
+                _load(file, "info.dir_6", info.dir_6);
+                _load(file, "info.dir_7", info.dir_7);
+                _load(file, "info.dir_8", info.dir_8);
+                _load(file, "info.dir_index_1", info.dir_index_1);
+                _load(file, "info.dir_index_2", info.dir_index_2);
+                _load(file, "info.dir_index_3", info.dir_index_3);
+                _load(file, "info.dir_index_4", info.dir_index_4);
+                _load(file, "info.dir_index_5", info.dir_index_5);
+                _load(file, "info.dir_index_6", info.dir_index_6);
+                _load(file, "info.dir_index_7", info.dir_index_7);
+                _load(file, "info.dir_index_8", info.dir_index_8);
+
+                _load(file, "data.h", data.h);
+                _load(file, "data.u", data.u);
+                _load(file, "data.v", data.v);
+                _load(file, "data.b", data.b);
+                _load(file, "data.f_0", data.f_0);
+                _load(file, "data.f_1", data.f_1);
+                _load(file, "data.f_2", data.f_2);
+                _load(file, "data.f_3", data.f_3);
+                _load(file, "data.f_4", data.f_4);
+                _load(file, "data.f_5", data.f_5);
+                _load(file, "data.f_6", data.f_6);
+                _load(file, "data.f_7", data.f_7);
+                _load(file, "data.f_8", data.f_8);
+                _load(file, "data.f_temp_0", data.f_temp_0);
+                _load(file, "data.f_temp_1", data.f_temp_1);
+                _load(file, "data.f_temp_2", data.f_temp_2);
+                _load(file, "data.f_temp_3", data.f_temp_3);
+                _load(file, "data.f_temp_4", data.f_temp_4);
+                _load(file, "data.f_temp_5", data.f_temp_5);
+                _load(file, "data.f_temp_6", data.f_temp_6);
+                _load(file, "data.f_temp_7", data.f_temp_7);
+                _load(file, "data.f_temp_8", data.f_temp_8);
+                _load(file, "data.distribution_x", data.distribution_x);
+                _load(file, "data.distribution_y", data.distribution_y);
+
+                return HDF5Checkpoint::read<unsigned long>(file, "time");
+            }
+
+            /**
+             * Restore the state of the solids of an FSI run from a checkpoint file.
+             *
+             * \param file The checkpoint file.
+             * \param solids Our packed solid data object.
+             */
+            static void load(HDF5File & file, PackedSolidData<D2Q9, DT_> & solids)
+            {
+                CONTEXT("When loading packed solid checkpoint:");
+
+                _load(file, "solids.boundary_flags", solids.boundary_flags);
+                _load(file, "solids.line_flags", solids.line_flags);
+                _load(file, "solids.solid_flags", solids.solid_flags);
+                _load(file, "solids.solid_old_flags", solids.solid_old_flags);
+                _load(file, "solids.solid_to_fluid_flags", solids.solid_to_fluid_flags);
+                _load(file, "solids.stationary_flags", solids.stationary_flags);
+                _load(file, "solids.f_mea_1", solids.f_mea_1);
+                _load(file, "solids.f_mea_2", solids.f_mea_2);
+                _load(file, "solids.f_mea_3", solids.f_mea_3);
+                _load(file, "solids.f_mea_4", solids.f_mea_4);
+                _load(file, "solids.f_mea_5", solids.f_mea_5);
+                _load(file, "solids.f_mea_6", solids.f_mea_6);
+                _load(file, "solids.f_mea_7", solids.f_mea_7);
+                _load(file, "solids.f_mea_8", solids.f_mea_8);
+                solids.current_u = HDF5Checkpoint::read<DT_>(file, "solids.current_u");
+                solids.current_v = HDF5Checkpoint::read<DT_>(file, "solids.current_v");
+            }
+    };
+}
+
+#endif
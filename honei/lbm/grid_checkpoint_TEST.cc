@@ -0,0 +1,198 @@
+/* vim: set number sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LBM C++ library. LBM is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LBM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <honei/lbm/grid_checkpoint.hh>
+#include <honei/lbm/solver_lbm_grid.hh>
+#include <honei/lbm/grid.hh>
+#include <honei/lbm/grid_packer.hh>
+#include <honei/lbm/scenario_collection.hh>
+#include <honei/util/unittest.hh>
+#include <cstdio>
+#include <iostream>
+
+using namespace honei;
+using namespace tests;
+using namespace std;
+using namespace lbm::lbm_lattice_types;
+
+template <typename Tag_, typename DataType_>
+class GridCheckpointTest :
+    public TaggedTest<Tag_>
+{
+    public:
+        GridCheckpointTest(const std::string & type) :
+            TaggedTest<Tag_>("grid_checkpoint_test<" + type + ">")
+        {
+        }
+
+        virtual void run() const
+        {
+            typedef SolverLBMGrid<Tag_, lbm_applications::LABSWE, DataType_, lbm_force::NONE, lbm_source_schemes::NONE,
+                    lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, lbm_modes::DRY> Solver;
+
+            std::string filename("grid_checkpoint_TEST.h5");
+            unsigned long g_h(50);
+            unsigned long g_w(50);
+            unsigned long timesteps(40);
+
+            Grid<D2Q9, DataType_> grid;
+            ScenarioCollection::get_scenario(0, g_h, g_w, grid);
+            PackedGridData<D2Q9, DataType_> data;
+            PackedGridInfo<D2Q9> info;
+            GridPacker<D2Q9, NOSLIP, DataType_>::pack(grid, info, data);
+
+            Solver solver(&info, &data, grid.d_x, grid.d_y, grid.d_t, grid.tau);
+            solver.do_preprocessing();
+            for (unsigned long i(0) ; i < timesteps ; ++i)
+                solver.solve();
+
+            {
+                HDF5CheckpointWriter writer;
+                GridCheckpoint<D2Q9, DataType_>::save(writer.acquire(), info, data, solver.time());
+                writer.commit(filename);
+
+                // the solver continues while the checkpoint is written
+                for (unsigned long i(0) ; i < timesteps ; ++i)
+                    solver.solve();
+
+                writer.wait();
+                TEST_CHECK_EQUAL(writer.written(), 1ul);
+            }
+
+            // restart from the checkpoint into a freshly set up solver
+            Grid<D2Q9, DataType_> grid_restart;
+            ScenarioCollection::get_scenario(0, g_h, g_w, grid_restart);
+            PackedGridData<D2Q9, DataType_> data_restart;
+            PackedGridInfo<D2Q9> info_restart;
+            GridPacker<D2Q9, NOSLIP, DataType_>::pack(grid_restart, info_restart, data_restart);
+
+            Solver solver_restart(&info_restart, &data_restart, grid_restart.d_x, grid_restart.d_y, grid_restart.d_t, grid_restart.tau);
+            solver_restart.do_preprocessing();
+            {
+                HDF5File file(filename);
+                solver_restart.set_time(GridCheckpoint<D2Q9, DataType_>::load(file, info_restart, data_restart));
+            }
+            TEST_CHECK_EQUAL(solver_restart.time(), timesteps);
+
+            for (unsigned long i(0) ; i < timesteps ; ++i)
+                solver_restart.solve();
+            TEST_CHECK_EQUAL(solver_restart.time(), solver.time());
+
+            TEST_CHECK_EQUAL(data_restart.h->size(), data.h->size());
+            for (unsigned long i(0) ; i < data.h->size() ; ++i)
+            {
+                TEST_CHECK_EQUAL((*data_restart.h)[i], (*data.h)[i]);
+                TEST_CHECK_EQUAL((*data_restart.u)[i], (*data.u)[i]);
+                TEST_CHECK_EQUAL((*data_restart.v)[i], (*data.v)[i]);
+            }
+
+            // a restart without the original grid allocates the packed vectors
+            PackedGridData<D2Q9, DataType_> data_loaded;
+            PackedGridInfo<D2Q9> info_loaded;
+            {
+                HDF5File file(filename);
+                TEST_CHECK_EQUAL((GridCheckpoint<D2Q9, DataType_>::load(file, info_loaded, data_loaded)), timesteps);
+            }
+            TEST_CHECK_EQUAL(info_loaded.limits->size(), info.limits->size());
+            TEST_CHECK_EQUAL(info_loaded.dir_index_4->size(), info.dir_index_4->size());
+            for (unsigned long i(0) ; i < info.dir_4->size() ; ++i)
+                TEST_CHECK_EQUAL((*info_loaded.dir_4)[i], (*info.dir_4)[i]);
+            TEST_CHECK_EQUAL(data_loaded.f_temp_8->size(), data.f_temp_8->size());
+            TEST_CHECK(data_loaded.f_eq_0 == 0);
+
+            std::remove(filename.c_str());
+
+            grid.destroy();
+            info.destroy();
+            data.destroy();
+            grid_restart.destroy();
+            info_restart.destroy();
+            data_restart.destroy();
+            info_loaded.destroy();
+            data_loaded.destroy();
+        }
+};
+GridCheckpointTest<tags::CPU, float> grid_checkpoint_test_float("float");
+GridCheckpointTest<tags::CPU, double> grid_checkpoint_test_double("double");
+
+template <typename DataType_>
+class SolidCheckpointTest :
+    public QuickTest
+{
+    public:
+        SolidCheckpointTest(const std::string & type) :
+            QuickTest("solid_checkpoint_test<" + type + ">")
+        {
+        }
+
+        virtual void run() const
+        {
+            std::string filename("solid_checkpoint_TEST.h5");
+            unsigned long size(1000);
+
+            PackedSolidData<D2Q9, DataType_> solids;
+            solids.boundary_flags = new DenseVector<bool>(size, false);
+            solids.line_flags = new DenseVector<bool>(size, false);
+            solids.solid_flags = new DenseVector<bool>(size, false);
+            solids.solid_old_flags = new DenseVector<bool>(size, false);
+            solids.solid_to_fluid_flags = new DenseVector<bool>(size, false);
+            solids.stationary_flags = new DenseVector<bool>(size, false);
+            solids.f_mea_1 = new DenseVector<DataType_>(size, DataType_(0));
+            for (unsigned long i(0) ; i < size ; ++i)
+            {
+                (*solids.boundary_flags)[i] = (i % 7 == 0);
+                (*solids.solid_flags)[i] = (i % 3 == 1);
+                (*solids.solid_to_fluid_flags)[i] = (i % 5 == 2);
+                (*solids.f_mea_1)[i] = DataType_(i) / DataType_(3);
+            }
+            solids.current_u = DataType_(0.25);
+            solids.current_v = DataType_(-0.5);
+
+            {
+                HDF5Checkpoint checkpoint;
+                GridCheckpoint<D2Q9, DataType_>::save(checkpoint, solids);
+                checkpoint.write(filename);
+            }
+
+            PackedSolidData<D2Q9, DataType_> solids_loaded;
+            {
+                HDF5File file(filename);
+                GridCheckpoint<D2Q9, DataType_>::load(file, solids_loaded);
+            }
+
+            TEST_CHECK(solids_loaded.f_mea_2 == 0);
+            TEST_CHECK_EQUAL(solids_loaded.solid_flags->size(), size);
+            for (unsigned long i(0) ; i < size ; ++i)
+            {
+                TEST_CHECK_EQUAL((*solids_loaded.boundary_flags)[i], (*solids.boundary_flags)[i]);
+                TEST_CHECK_EQUAL((*solids_loaded.line_flags)[i], (*solids.line_flags)[i]);
+                TEST_CHECK_EQUAL((*solids_loaded.solid_flags)[i], (*solids.solid_flags)[i]);
+                TEST_CHECK_EQUAL((*solids_loaded.solid_to_fluid_flags)[i], (*solids.solid_to_fluid_flags)[i]);
+                TEST_CHECK_EQUAL((*solids_loaded.f_mea_1)[i], (*solids.f_mea_1)[i]);
+            }
+            TEST_CHECK_EQUAL(solids_loaded.current_u, solids.current_u);
+            TEST_CHECK_EQUAL(solids_loaded.current_v, solids.current_v);
+
+            std::remove(filename.c_str());
+
+            solids.destroy();
+            solids_loaded.destroy();
+        }
+};
+SolidCheckpointTest<float> solid_checkpoint_test_float("float");
+SolidCheckpointTest<double> solid_checkpoint_test_double("double");
@@ -0,0 +1,258 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LBM C++ library. LBM is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LBM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#pragma once
+#ifndef LBM_GUARD_GRID_ENSEMBLE_HH
+#define LBM_GUARD_GRID_ENSEMBLE_HH 1
+
+#include <honei/lbm/grid.hh>
+#include <honei/la/dense_vector.hh>
+#include <honei/util/exception.hh>
+#include <honei/util/stringify.hh>
+
+#include <climits>
+#include <vector>
+
+/**
+ * \file
+ * Definition of the LBM grid ensemble packer, which interleaves several runs on the same geometry.
+ *
+ * \ingroup grpliblbm
+ **/
+
+using namespace honei;
+using namespace lbm;
+using namespace lbm_lattice_types;
+
+namespace honei
+{
+    template <typename LatticeType_, typename DT_> struct GridEnsemble
+    {
+    };
+
+    /**
+     * \brief Packs an ensemble of runs sharing one packed grid geometry.
+     *
+     * The members are packed with GridPacker on the same grid geometry and may differ in h, u, v
+     * and b. pack interleaves them per cell: value m of cell i is stored at i * E + m, with E the
+     * number of members. Every run of the packed grid info then maps to a contiguous block of E
+     * times its length, so the ensemble info is the member info with all indices scaled by E.
+     * Hence the ensemble pair runs through the unchanged grid kernels and solvers (SolverLBMGrid,
+     * SolverLBMGridActive, ...), which process all members in one pass over a single index stream,
+     * with the E values of a cell adjacent in memory and thus in one vector register for E = 4
+     * or 8. Scalar parameters like the relaxation time and the Manning coefficient are shared
+     * by all members; per member friction is not supported, members can only differ in their
+     * initial fields and bed.
+     *
+     * \ingroup grpliblbm
+     */
+    template <typename DT_> struct GridEnsemble<D2Q9, DT_>
+    {
+        private:
+            static DenseVector<unsigned long> * _scale(const DenseVector<unsigned long> * index, unsigned long members)
+            {
+                if (index == 0)
+                    return 0;
+
+                DenseVector<unsigned long> * result(new DenseVector<unsigned long>(index->size()));
+                for (unsigned long i(0) ; i < index->size() ; ++i)
+                    (*result)[i] = (*index)[i] * members;
+
+                return result;
+            }
+
+            /// Scales a per cell target vector (see GridPacker::cuda_pack) to per member targets.
+            static DenseVector<unsigned long> * _expand(const DenseVector<unsigned long> * target, unsigned long members)
+            {
+                if (target == 0)
+                    return 0;
+
+                DenseVector<unsigned long> * result(new DenseVector<unsigned long>(target->size() * members));
+                for (unsigned long i(0) ; i < target->size() ; ++i)
+                {
+                    const unsigned long t((*target)[i]);
+                    for (unsigned long m(0) ; m < members ; ++m)
+                        (*result)[i * members + m] = t == ULONG_MAX ? ULONG_MAX : t * members + m;
+                }
+
+                return result;
+            }
+
+            static DenseVector<unsigned long> * _replicate(const DenseVector<unsigned long> * types, unsigned long members)
+            {
+                if (types == 0)
+                    return 0;
+
+                DenseVector<unsigned long> * result(new DenseVector<unsigned long>(types->size() * members));
+                for (unsigned long i(0) ; i < types->size() ; ++i)
+                    for (unsigned long m(0) ; m < members ; ++m)
+                        (*result)[i * members + m] = (*types)[i];
+
+                return result;
+            }
+
+            static DenseVector<DT_> * _interleave(const std::vector<PackedGridData<D2Q9, DT_> *> & members,
+                    DenseVector<DT_> * PackedGridData<D2Q9, DT_>::* field)
+            {
+                const unsigned long count(members.size());
+                const unsigned long size((members[0]->*field)->size());
+
+                DenseVector<DT_> * result(new DenseVector<DT_>(size * count));
+                DT_ * const r(result->elements());
+                for (unsigned long m(0) ; m < count ; ++m)
+                {
+                    const DT_ * const source((members[m]->*field)->elements());
+                    for (unsigned long i(0) ; i < size ; ++i)
+                        r[i * count + m] = source[i];
+                }
+
+                return result;
+            }
+
+            static void _extract(const DenseVector<DT_> & ensemble, unsigned long member, DenseVector<DT_> & target)
+            {
+                const unsigned long count(ensemble.size() / target.size());
+                const DT_ * const e(ensemble.elements());
+                DT_ * const t(target.elements());
+                for (unsigned long i(0) ; i < target.size() ; ++i)
+                    t[i] = e[i * count + member];
+            }
+
+        public:
+            /**
+             * Interleave the packed members into one ensemble.
+             *
+             * \param info The packed grid info shared by all members.
+             * \param members The packed data of every member, created with GridPacker::pack on info.
+             * \param ensemble_info Receives the scaled info.
+             * \param ensemble_data Receives the interleaved data.
+             */
+            static void pack(PackedGridInfo<D2Q9> & info, const std::vector<PackedGridData<D2Q9, DT_> *> & members,
+                    PackedGridInfo<D2Q9> & ensemble_info, PackedGridData<D2Q9, DT_> & ensemble_data)
+            {
+                CONTEXT("When packing grid ensemble:");
+
+                if (members.empty())
+                    throw InternalError("GridEnsemble: Cannot pack an ensemble of 0 members!");
+
+                const unsigned long count(members.size());
+                const unsigned long size(members[0]->h->size());
+                for (unsigned long m(1) ; m < count ; ++m)
+                    if (members[m]->h->size() != size)
+                        throw InternalError("GridEnsemble: Member " + stringify(m) + " has " + stringify(members[m]->h->size()) +
+                                " cells, but member 0 has " + stringify(size) + "!");
+
+                ensemble_info.offset = info.offset * count;
+                ensemble_info.limits = _scale(info.limits, count);
+                ensemble_info.types = new DenseVector<unsigned long>(info.types->copy());
+                ensemble_info.cuda_types = _replicate(info.cuda_types, count);
+                ensemble_info.dir_1 = _scale(info.dir_1, count);
+                ensemble_info.dir_2 = _scale(info.dir_2, count);
+                ensemble_info.dir_3 = _scale(info.dir_3, count);
+                ensemble_info.dir_4 = _scale(info.dir_4, count);
+                ensemble_info.dir_5 = _scale(info.dir_5, count);
+                ensemble_info.dir_6 = _scale(info.dir_6, count);
+                ensemble_info.dir_7 = _scale(info.dir_7, count);
+                ensemble_info.dir_8 = _scale(info.dir_8, count);
+                ensemble_info.dir_index_1 = _scale(info.dir_index_1, count);
+                ensemble_info.dir_index_2 = _scale(info.dir_index_2, count);
+                ensemble_info.dir_index_3 = _scale(info.dir_index_3, count);
+                ensemble_info.dir_index_4 = _scale(info.dir_index_4, count);
+                ensemble_info.dir_index_5 = _scale(info.dir_index_5, count);
+                ensemble_info.dir_index_6 = _scale(info.dir_index_6, count);
+                ensemble_info.dir_index_7 = _scale(info.dir_index_7, count);
+                ensemble_info.dir_index_8 = _scale(info.dir_index_8, count);
+                ensemble_info.cuda_dir_1 = _expand(info.cuda_dir_1, count);
+                ensemble_info.cuda_dir_2 = _expand(info.cuda_dir_2, count);
+                ensemble_info.cuda_dir_3 = _expand(info.cuda_dir_3, count);
+                ensemble_info.cuda_dir_4 = _expand(info.cuda_dir_4, count);
+                ensemble_info.cuda_dir_5 = _expand(info.cuda_dir_5, count);
+                ensemble_info.cuda_dir_6 = _expand(info.cuda_dir_6, count);
+                ensemble_info.cuda_dir_7 = _expand(info.cuda_dir_7, count);
+                ensemble_info.cuda_dir_8 = _expand(info.cuda_dir_8, count);
+
+                const unsigned long fluid_count(size * count);
+                ensemble_data.h = _interleave(members, &PackedGridData<D2Q9, DT_>::h);
+                ensemble_data.b = _interleave(members, &PackedGridData<D2Q9, DT_>::b);
+                ensemble_data.u = _interleave(members, &PackedGridData<D2Q9, DT_>::u);
+                ensemble_data.v = _interleave(members, &PackedGridData<D2Q9, DT_>::v);
+                ensemble_data.temp = new DenseVector<DT_>(fluid_count);
+
+                ensemble_data.f_0 = new DenseVector<DT_>(fluid_count, DT_(0));
+                ensemble_data.f_1 = new DenseVector<DT_>(fluid_count, DT_(0));
+                ensemble_data.f_2 = new DenseVector<DT_>(fluid_count, DT_(0));
+                ensemble_data.f_3 = new DenseVector<DT_>(fluid_count, DT_(0));
+                ensemble_data.f_4 = new DenseVector<DT_>(fluid_count, DT_(0));
+                ensemble_data.f_5 = new DenseVector<DT_>(fluid_count, DT_(0));
+                ensemble_data.f_6 = new DenseVector<DT_>(fluid_count, DT_(0));
+                ensemble_data.f_7 = new DenseVector<DT_>(fluid_count, DT_(0));
+                ensemble_data.f_8 = new DenseVector<DT_>(fluid_count, DT_(0));
+
+                ensemble_data.f_eq_0 = new DenseVector<DT_>(fluid_count, DT_(0));
+                ensemble_data.f_eq_1 = new DenseVector<DT_>(fluid_count, DT_(0));
+                ensemble_data.f_eq_2 = new DenseVector<DT_>(fluid_count, DT_(0));
+                ensemble_data.f_eq_3 = new DenseVector<DT_>(fluid_count, DT_(0));
+                ensemble_data.f_eq_4 = new DenseVector<DT_>(fluid_count, DT_(0));
+                ensemble_data.f_eq_5 = new DenseVector<DT_>(fluid_count, DT_(0));
+                ensemble_data.f_eq_6 = new DenseVector<DT_>(fluid_count, DT_(0));
+                ensemble_data.f_eq_7 = new DenseVector<DT_>(fluid_count, DT_(0));
+                ensemble_data.f_eq_8 = new DenseVector<DT_>(fluid_count, DT_(0));
+
+                ensemble_data.f_temp_0 = new DenseVector<DT_>(fluid_count, DT_(0));
+                ensemble_data.f_temp_1 = new DenseVector<DT_>(fluid_count, DT_(0));
+                ensemble_data.f_temp_2 = new DenseVector<DT_>(fluid_count, DT_(0));
+                ensemble_data.f_temp_3 = new DenseVector<DT_>(fluid_count, DT_(0));
+                ensemble_data.f_temp_4 = new DenseVector<DT_>(fluid_count, DT_(0));
+                ensemble_data.f_temp_5 = new DenseVector<DT_>(fluid_count, DT_(0));
+                ensemble_data.f_temp_6 = new DenseVector<DT_>(fluid_count, DT_(0));
+                ensemble_data.f_temp_7 = new DenseVector<DT_>(fluid_count, DT_(0));
+                ensemble_data.f_temp_8 = new DenseVector<DT_>(fluid_count, DT_(0));
+                ensemble_data.distribution_x = new DenseVector<DT_>(9ul, DT_(0));
+                ensemble_data.distribution_y = new DenseVector<DT_>(9ul, DT_(0));
+            }
+
+            /**
+             * Copy h, u and v of one member out of the ensemble.
+             *
+             * \param member The index of the member.
+             * \param ensemble_data The interleaved ensemble data.
+             * \param data The packed data of the member, e.g. as passed to pack.
+             */
+            static void extract(unsigned long member, PackedGridData<D2Q9, DT_> & ensemble_data, PackedGridData<D2Q9, DT_> & data)
+            {
+                CONTEXT("When extracting grid ensemble member:");
+
+                if (member >= members(ensemble_data, data))
+                    throw InternalError("GridEnsemble: Member " + stringify(member) + " is not part of the ensemble!");
+
+                _extract(*ensemble_data.h, member, *data.h);
+                _extract(*ensemble_data.u, member, *data.u);
+                _extract(*ensemble_data.v, member, *data.v);
+            }
+
+            /// The number of members of an ensemble, whose members hold data.h->size() cells each.
+            static unsigned long members(PackedGridData<D2Q9, DT_> & ensemble_data, PackedGridData<D2Q9, DT_> & data)
+            {
+                return ensemble_data.h->size() / data.h->size();
+            }
+    };
+}
+
+#endif
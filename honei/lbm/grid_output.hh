@@ -0,0 +1,414 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LBM C++ library. LBM is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LBM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#pragma once
+#ifndef LBM_GUARD_GRID_OUTPUT_HH
+#define LBM_GUARD_GRID_OUTPUT_HH 1
+
+#include <honei/lbm/grid.hh>
+#include <honei/lbm/grid_packer.hh>
+#include <honei/la/dense_matrix.hh>
+#include <honei/la/dense_vector.hh>
+#include <honei/util/condition_variable.hh>
+#include <honei/util/exception.hh>
+#include <honei/util/instantiation_policy.hh>
+#include <honei/util/lock.hh>
+#include <honei/util/mutex.hh>
+#include <honei/util/netcdf_datatypes.hh>
+#include <honei/util/thread.hh>
+#include <honei/util/tr1_boost.hh>
+
+#include <algorithm>
+#include <deque>
+#include <string>
+#include <vector>
+
+/**
+ * \file
+ * Definition of the LBM grid output pipeline, which writes time steps in a background thread.
+ *
+ * \ingroup grpliblbm
+ **/
+
+using namespace honei;
+using namespace lbm;
+using namespace lbm_lattice_types;
+
+namespace honei
+{
+    /// Behaviour of GridOutput if all snapshot buffers are in use.
+    enum GridOutputPolicy
+    {
+        gop_block = 0, ///< Wait for the writer thread to free a buffer.
+        gop_skip ///< Drop the time step.
+    };
+
+    template <typename LatticeType_, typename DT_> class GridOutput
+    {
+    };
+
+    /**
+     * \brief Writes time steps of a packed grid in a background thread.
+     *
+     * write only copies the packed h, u and v vectors into a free snapshot buffer and returns.
+     * A writer thread unpacks the snapshots with GridPacker, converts them to a float TimeStep
+     * holding the water elevation h + b and the discharges hu and hv, and passes it to the sink,
+     * usually KPNetCDFFile::writeTimeStep. As the sink is only ever called from the writer thread,
+     * the file must not be accessed elsewhere before wait has returned.
+     *
+     * Output is decimated to every interval'th call of write. If all buffers are in use, write
+     * either blocks or drops the time step, depending on the policy.
+     *
+     * Errors of the writer thread are reported by the next call to write or wait.
+     */
+    template <typename DT_> class GridOutput<D2Q9, DT_> :
+        public InstantiationPolicy<GridOutput<D2Q9, DT_>, NonCopyable>
+    {
+        public:
+            /// Our type of sink.
+            typedef function<void (shared_ptr<TimeStep>)> Sink;
+
+        private:
+            struct Snapshot
+            {
+                DenseVector<DT_> h;
+                DenseVector<DT_> u;
+                DenseVector<DT_> v;
+                float time;
+
+                Snapshot(unsigned long size) :
+                    h(size),
+                    u(size),
+                    v(size),
+                    time(0.0f)
+                {
+                }
+            };
+
+            /// Our sink.
+            Sink _sink;
+
+            /// Our packed grid info.
+            PackedGridInfo<D2Q9> & _info;
+
+            /// The grid the writer thread unpacks into.
+            Grid<D2Q9, DT_> _grid;
+
+            /// The time step passed to the sink.
+            shared_ptr<TimeStep> _time_step;
+
+            /// Our snapshot buffers.
+            std::vector<Snapshot *> _snapshots;
+
+            /// Our free and queued snapshot buffers.
+            std::deque<unsigned long> _free, _queue;
+
+            const unsigned long _interval;
+
+            const GridOutputPolicy _policy;
+
+            /// Our number of calls to write.
+            unsigned long _calls;
+
+            /// Our number of written and dropped time steps.
+            unsigned long _written, _skipped;
+
+            /// The last error of the writer thread.
+            std::string _error;
+
+            /// Whether the writer thread shall finish.
+            bool _finish;
+
+            Mutex * const _mutex;
+
+            /// Our condition variable, signalling both new snapshots and finished writes.
+            ConditionVariable * const _changed;
+
+            Thread * _thread;
+
+            /// Unpack a snapshot and pass it to the sink. Runs in the writer thread.
+            void _write(Snapshot & snapshot)
+            {
+                PackedGridData<D2Q9, DT_> data;
+                data.h = &snapshot.h;
+                data.u = &snapshot.u;
+                data.v = &snapshot.v;
+
+                GridPacker<D2Q9, lbm_boundary_types::NOSLIP, DT_>::unpack(_grid, _info, data);
+                GridPacker<D2Q9, lbm_boundary_types::NOSLIP, DT_>::unpack_u(_grid, _info, data);
+                GridPacker<D2Q9, lbm_boundary_types::NOSLIP, DT_>::unpack_v(_grid, _info, data);
+
+                data.h = 0;
+                data.u = 0;
+                data.v = 0;
+
+                // the sink may have kept the last time step
+                if (! _time_step.unique())
+                    _time_step.reset(new TimeStep(_grid.h->columns(), _grid.h->rows()));
+
+                const DT_ * h(_grid.h->elements());
+                const DT_ * u(_grid.u->elements());
+                const DT_ * v(_grid.v->elements());
+                const DT_ * b(_grid.b->elements());
+                float * w_out(_time_step->U[0]->data);
+                float * hu_out(_time_step->U[1]->data);
+                float * hv_out(_time_step->U[2]->data);
+                for (unsigned long i(0), i_end(_grid.h->size()) ; i < i_end ; ++i)
+                {
+                    w_out[i] = float(h[i] + b[i]);
+                    hu_out[i] = float(h[i] * u[i]);
+                    hv_out[i] = float(h[i] * v[i]);
+                }
+                _time_step->time = snapshot.time;
+
+                _sink(_time_step);
+            }
+
+            void _write_function()
+            {
+                while (true)
+                {
+                    unsigned long index;
+
+                    {
+                        Lock l(*_mutex);
+
+                        if (_queue.empty())
+                        {
+                            if (_finish)
+                                break;
+
+                            _changed->wait(*_mutex);
+                            continue;
+                        }
+
+                        index = _queue.front();
+                    }
+
+                    std::string message;
+                    try
+                    {
+                        _write(*_snapshots[index]);
+                    }
+                    catch (Exception & e)
+                    {
+                        message = e.message();
+                    }
+                    catch (...)
+                    {
+                        message = "Unknown error while writing time step";
+                    }
+
+                    {
+                        Lock l(*_mutex);
+
+                        _queue.pop_front();
+                        _free.push_back(index);
+                        if (message.empty())
+                            ++_written;
+                        else
+                            _error = message;
+
+                        _changed->broadcast();
+                    }
+                }
+            }
+
+            /// Throw the last error of the writer thread, if any. Needs to be called with _mutex locked.
+            void _check()
+            {
+                if (_error.empty())
+                    return;
+
+                std::string message(_error);
+                _error.clear();
+                throw InternalError("GridOutput: " + message);
+            }
+
+        public:
+            /// \name Basic operations
+            /// \{
+
+            /**
+             * Constructor.
+             *
+             * \param grid The unpacked grid, only used for its obstacles and bottom.
+             * \param info The packed grid info, which must not change while we are in use.
+             * \param sink The function the unpacked time steps are passed to.
+             * \param buffers Our number of snapshot buffers.
+             * \param interval Only write every interval'th time step.
+             * \param policy What to do if all snapshot buffers are in use.
+             */
+            GridOutput(Grid<D2Q9, DT_> & grid, PackedGridInfo<D2Q9> & info, const Sink & sink,
+                    unsigned long buffers = 2, unsigned long interval = 1, GridOutputPolicy policy = gop_block) :
+                _sink(sink),
+                _info(info),
+                _time_step(new TimeStep(grid.obstacles->columns(), grid.obstacles->rows())),
+                _interval(interval),
+                _policy(policy),
+                _calls(0),
+                _written(0),
+                _skipped(0),
+                _finish(false),
+                _mutex(new Mutex),
+                _changed(new ConditionVariable)
+            {
+                CONTEXT("When creating GridOutput:");
+
+                if (0 == buffers)
+                    throw InternalError("GridOutput: At least one snapshot buffer is needed!");
+
+                if (0 == interval)
+                    throw InternalError("GridOutput: The output interval must be positive!");
+
+                // private copies, so the writer thread never touches the solver's matrices
+                _grid.obstacles = new DenseMatrix<bool>(grid.obstacles->copy());
+                _grid.b = new DenseMatrix<DT_>(grid.b->copy());
+                _grid.h = new DenseMatrix<DT_>(grid.obstacles->rows(), grid.obstacles->columns());
+                _grid.u = new DenseMatrix<DT_>(grid.obstacles->rows(), grid.obstacles->columns());
+                _grid.v = new DenseMatrix<DT_>(grid.obstacles->rows(), grid.obstacles->columns());
+
+                unsigned long size(0);
+                for (typename DenseMatrix<bool>::ConstElementIterator o(_grid.obstacles->begin_elements()),
+                        o_end(_grid.obstacles->end_elements()) ; o != o_end ; ++o)
+                {
+                    if (! *o)
+                        ++size;
+                }
+
+                for (unsigned long i(0) ; i < buffers ; ++i)
+                {
+                    _snapshots.push_back(new Snapshot(size));
+                    _free.push_back(i);
+                }
+
+                _thread = new Thread(bind(mem_fn(&GridOutput<D2Q9, DT_>::_write_function), this));
+            }
+
+            /// Destructor. Waits for all queued time steps to be written.
+            ~GridOutput()
+            {
+                {
+                    Lock l(*_mutex);
+
+                    _finish = true;
+                    _changed->broadcast();
+                }
+
+                delete _thread;
+                delete _changed;
+                delete _mutex;
+
+                for (typename std::vector<Snapshot *>::iterator s(_snapshots.begin()), s_end(_snapshots.end()) ; s != s_end ; ++s)
+                    delete *s;
+
+                _grid.destroy();
+            }
+
+            /// \}
+
+            /**
+             * Hand a time step over to the writer thread.
+             *
+             * \param data The packed grid data holding the current h, u and v.
+             * \param time The simulation time of the time step.
+             *
+             * \return Whether the time step has been queued, i.e. neither decimated nor dropped.
+             */
+            bool write(PackedGridData<D2Q9, DT_> & data, float time)
+            {
+                CONTEXT("When queueing time step in GridOutput:");
+
+                // checked before a buffer is taken, so a mismatch does not lose it
+                if (data.h->size() != _snapshots.front()->h.size())
+                    throw InternalError("GridOutput: Packed grid data does not match the grid!");
+
+                if (0 != _calls++ % _interval)
+                    return false;
+
+                unsigned long index;
+                {
+                    Lock l(*_mutex);
+
+                    _check();
+
+                    if (_free.empty() && (gop_skip == _policy))
+                    {
+                        ++_skipped;
+                        return false;
+                    }
+
+                    while (_free.empty())
+                        _changed->wait(*_mutex);
+
+                    index = _free.front();
+                    _free.pop_front();
+                }
+
+                Snapshot & snapshot(*_snapshots[index]);
+
+                data.h->lock(lm_read_only);
+                data.u->lock(lm_read_only);
+                data.v->lock(lm_read_only);
+                std::copy(data.h->elements(), data.h->elements() + data.h->size(), snapshot.h.elements());
+                std::copy(data.u->elements(), data.u->elements() + data.u->size(), snapshot.u.elements());
+                std::copy(data.v->elements(), data.v->elements() + data.v->size(), snapshot.v.elements());
+                data.h->unlock(lm_read_only);
+                data.u->unlock(lm_read_only);
+                data.v->unlock(lm_read_only);
+                snapshot.time = time;
+
+                Lock l(*_mutex);
+                _queue.push_back(index);
+                _changed->broadcast();
+
+                return true;
+            }
+
+            /// Wait until all queued time steps have been written.
+            void wait()
+            {
+                Lock l(*_mutex);
+
+                while (! _queue.empty())
+                    _changed->wait(*_mutex);
+
+                _check();
+            }
+
+            /// Return the number of time steps written so far.
+            unsigned long written() const
+            {
+                Lock l(*_mutex);
+
+                return _written;
+            }
+
+            /// Return the number of time steps dropped so far.
+            unsigned long skipped() const
+            {
+                Lock l(*_mutex);
+
+                return _skipped;
+            }
+    };
+}
+
+#endif
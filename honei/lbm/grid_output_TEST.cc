@@ -0,0 +1,232 @@
+/* vim: set number sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LBM C++ library. LBM is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LBM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <honei/lbm/grid_output.hh>
+#include <honei/lbm/solver_lbm_grid.hh>
+#include <honei/lbm/grid.hh>
+#include <honei/lbm/grid_packer.hh>
+#include <honei/lbm/scenario_collection.hh>
+#include <honei/util/unittest.hh>
+#include <iostream>
+#include <vector>
+#include <unistd.h>
+
+using namespace honei;
+using namespace tests;
+using namespace std;
+using namespace lbm::lbm_lattice_types;
+
+namespace
+{
+    /// Keeps all time steps passed to it, optionally taking its time.
+    struct Collector
+    {
+        std::vector<shared_ptr<TimeStep> > steps;
+
+        unsigned delay;
+
+        bool fail;
+
+        Collector(unsigned d = 0) :
+            delay(d),
+            fail(false)
+        {
+        }
+
+        void collect(shared_ptr<TimeStep> time_step)
+        {
+            if (fail)
+                throw InternalError("Collector failed on purpose");
+
+            if (delay > 0)
+                ::usleep(delay);
+
+            steps.push_back(time_step);
+        }
+    };
+}
+
+template <typename Tag_, typename DataType_>
+class GridOutputTest :
+    public TaggedTest<Tag_>
+{
+    public:
+        GridOutputTest(const std::string & type) :
+            TaggedTest<Tag_>("grid_output_test<" + type + ">")
+        {
+        }
+
+        virtual void run() const
+        {
+            unsigned long g_h(50);
+            unsigned long g_w(40);
+            unsigned long timesteps(40);
+            unsigned long interval(5);
+
+            Grid<D2Q9, DataType_> grid;
+            ScenarioCollection::get_scenario(0, g_h, g_w, grid);
+            PackedGridData<D2Q9, DataType_> data;
+            PackedGridInfo<D2Q9> info;
+            GridPacker<D2Q9, NOSLIP, DataType_>::pack(grid, info, data);
+
+            SolverLBMGrid<Tag_, lbm_applications::LABSWE, DataType_, lbm_force::NONE, lbm_source_schemes::NONE,
+                lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, lbm_modes::DRY>
+                    solver(&info, &data, grid.d_x, grid.d_y, grid.d_t, grid.tau);
+            solver.do_preprocessing();
+
+            Collector collector;
+            std::vector<std::vector<float> > references;
+            {
+                GridOutput<D2Q9, DataType_> output(grid, info, bind(mem_fn(&Collector::collect), &collector, HONEI_PLACEHOLDERS_1),
+                        2, interval);
+
+                for (unsigned long i(0) ; i < timesteps ; ++i)
+                {
+                    solver.solve();
+                    if (output.write(data, float(i)))
+                    {
+                        // synchronous reference of the water elevation and discharges
+                        GridPacker<D2Q9, NOSLIP, DataType_>::unpack(grid, info, data);
+                        GridPacker<D2Q9, NOSLIP, DataType_>::unpack_u(grid, info, data);
+                        GridPacker<D2Q9, NOSLIP, DataType_>::unpack_v(grid, info, data);
+                        references.push_back(std::vector<float>(3 * grid.h->size()));
+                        for (unsigned long j(0), size(grid.h->size()) ; j < size ; ++j)
+                        {
+                            references.back()[j] = float(grid.h->elements()[j] + grid.b->elements()[j]);
+                            references.back()[size + j] = float(grid.h->elements()[j] * grid.u->elements()[j]);
+                            references.back()[2 * size + j] = float(grid.h->elements()[j] * grid.v->elements()[j]);
+                        }
+                    }
+                }
+
+                output.wait();
+                TEST_CHECK_EQUAL(output.written(), timesteps / interval);
+                TEST_CHECK_EQUAL(output.skipped(), 0ul);
+            }
+
+            TEST_CHECK_EQUAL(collector.steps.size(), timesteps / interval);
+            TEST_CHECK_EQUAL(references.size(), timesteps / interval);
+            for (unsigned long s(0) ; s < collector.steps.size() ; ++s)
+            {
+                const TimeStep & ts(*collector.steps[s]);
+                TEST_CHECK_EQUAL(ts.nx, g_w);
+                TEST_CHECK_EQUAL(ts.ny, g_h);
+                TEST_CHECK_EQUAL(ts.time, float(s * interval));
+                for (unsigned long j(0), size(g_h * g_w) ; j < size ; ++j)
+                {
+                    TEST_CHECK_EQUAL(ts.U[0]->data[j], references[s][j]);
+                    TEST_CHECK_EQUAL(ts.U[1]->data[j], references[s][size + j]);
+                    TEST_CHECK_EQUAL(ts.U[2]->data[j], references[s][2 * size + j]);
+                }
+            }
+
+            grid.destroy();
+            info.destroy();
+            data.destroy();
+        }
+};
+GridOutputTest<tags::CPU, float> grid_output_test_float("float");
+GridOutputTest<tags::CPU, double> grid_output_test_double("double");
+
+template <typename DataType_>
+class GridOutputPolicyTest :
+    public QuickTest
+{
+    public:
+        GridOutputPolicyTest(const std::string & type) :
+            QuickTest("grid_output_policy_test<" + type + ">")
+        {
+        }
+
+        virtual void run() const
+        {
+            unsigned long g_h(20);
+            unsigned long g_w(20);
+            unsigned long count(10);
+
+            Grid<D2Q9, DataType_> grid;
+            ScenarioCollection::get_scenario(0, g_h, g_w, grid);
+            PackedGridData<D2Q9, DataType_> data;
+            PackedGridInfo<D2Q9> info;
+            GridPacker<D2Q9, NOSLIP, DataType_>::pack(grid, info, data);
+
+            // blocking keeps every time step
+            {
+                Collector collector(10000);
+                GridOutput<D2Q9, DataType_> output(grid, info, bind(mem_fn(&Collector::collect), &collector, HONEI_PLACEHOLDERS_1),
+                        1, 1, gop_block);
+                for (unsigned long i(0) ; i < count ; ++i)
+                    TEST_CHECK(output.write(data, float(i)));
+                output.wait();
+                TEST_CHECK_EQUAL(output.written(), count);
+                TEST_CHECK_EQUAL(output.skipped(), 0ul);
+                TEST_CHECK_EQUAL(collector.steps.size(), count);
+            }
+
+            // skipping drops time steps while the only buffer is being written
+            {
+                Collector collector(10000);
+                GridOutput<D2Q9, DataType_> output(grid, info, bind(mem_fn(&Collector::collect), &collector, HONEI_PLACEHOLDERS_1),
+                        1, 1, gop_skip);
+                for (unsigned long i(0) ; i < count ; ++i)
+                    output.write(data, float(i));
+                output.wait();
+                TEST_CHECK(output.skipped() > 0);
+                TEST_CHECK_EQUAL(output.written() + output.skipped(), count);
+                TEST_CHECK_EQUAL(collector.steps.size(), output.written());
+            }
+
+            // data of another grid is rejected without losing the only buffer
+            {
+                Grid<D2Q9, DataType_> other_grid;
+                ScenarioCollection::get_scenario(0, g_h / 2, g_w / 2, other_grid);
+                PackedGridData<D2Q9, DataType_> other_data;
+                PackedGridInfo<D2Q9> other_info;
+                GridPacker<D2Q9, NOSLIP, DataType_>::pack(other_grid, other_info, other_data);
+
+                Collector collector(10000);
+                GridOutput<D2Q9, DataType_> output(grid, info, bind(mem_fn(&Collector::collect), &collector, HONEI_PLACEHOLDERS_1),
+                        1, 1, gop_block);
+                TEST_CHECK_THROWS(output.write(other_data, 0.0f), InternalError);
+                for (unsigned long i(0) ; i < 3 ; ++i)
+                    TEST_CHECK(output.write(data, float(i)));
+                output.wait();
+                TEST_CHECK_EQUAL(output.written(), 3ul);
+
+                other_grid.destroy();
+                other_info.destroy();
+                other_data.destroy();
+            }
+
+            // errors of the sink are reported to the caller
+            {
+                Collector collector;
+                collector.fail = true;
+                GridOutput<D2Q9, DataType_> output(grid, info, bind(mem_fn(&Collector::collect), &collector, HONEI_PLACEHOLDERS_1));
+                output.write(data, 0.0f);
+                TEST_CHECK_THROWS(output.wait(), InternalError);
+                TEST_CHECK_EQUAL(output.written(), 0ul);
+            }
+
+            grid.destroy();
+            info.destroy();
+            data.destroy();
+        }
+};
+GridOutputPolicyTest<float> grid_output_policy_test_float("float");
+GridOutputPolicyTest<double> grid_output_policy_test_double("double");
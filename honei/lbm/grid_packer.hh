@@ -682,6 +682,32 @@ namespace honei
                 grid.u->unlock(lm_write_only);
                 data.u->unlock(lm_read_only);
             }
+            static void unpack_v(Grid<D2Q9, DT_> & grid, PackedGridInfo<D2Q9> & /*info*/, PackedGridData<D2Q9, DT_> & data)
+            {
+                grid.obstacles->lock(lm_read_only);
+                grid.v->lock(lm_write_only);
+                data.v->lock(lm_read_only);
+                unsigned long packed_index(0);
+
+                for(unsigned long i(0); i < grid.obstacles->rows(); ++i)
+                {
+                    for(unsigned long j(0); j < grid.obstacles->columns(); ++j)
+                    {
+                        if((*grid.obstacles)(i, j))
+                        {
+                            (*grid.v)(i, j) = DT_(0);
+                        }
+                        else
+                        {
+                            (*grid.v)(i, j) = (*data.v)[packed_index];
+                            ++packed_index;
+                        }
+                    }
+                }
+                grid.obstacles->unlock(lm_read_only);
+                grid.v->unlock(lm_write_only);
+                data.v->unlock(lm_read_only);
+            }
 
 
             static unsigned long h_index(Grid<D2Q9, DT_> & grid, unsigned long i, unsigned long j)
@@ -794,7 +794,7 @@ namespace honei
 
             static void decompose_intern(std::vector<unsigned long> & part_sizes, PackedGridInfo<D2Q9> & info, PackedGridData<D2Q9, DT_> & data,
                     std::vector<PackedGridInfo<D2Q9> > & info_list, std::vector<PackedGridData<D2Q9, DT_> > & data_list,
-                    std::vector<PackedGridFringe<D2Q9> > & fringe_list, bool alloc_all = true)
+                    std::vector<PackedGridFringe<D2Q9> > & fringe_list, bool alloc_all = true, unsigned long halo = 0)
             {
                 CONTEXT("When creating grid partitions:");
                 std::vector<unsigned long> temp_limits;
@@ -1106,6 +1106,9 @@ namespace honei
 
                     unsigned long new_max(*max_element(max_collection.begin(), max_collection.end()));
                     unsigned long new_min(*min_element(min_collection.begin(), min_collection.end()));
+                    // additional halo elements on either side
+                    new_max = std::min(new_max + halo, data.h->size() - 1);
+                    new_min = new_min > halo ? new_min - halo : 0;
 
                     // Fill the real info vector
                     PackedGridInfo<D2Q9> new_info;
@@ -1272,7 +1275,7 @@ namespace honei
 
             static void decompose(unsigned long parts, PackedGridInfo<D2Q9> & info, PackedGridData<D2Q9, DT_> & data,
                     std::vector<PackedGridInfo<D2Q9> > & info_list, std::vector<PackedGridData<D2Q9, DT_> > & data_list,
-                    std::vector<PackedGridFringe<D2Q9> > & fringe_list, bool alloc_all = true)
+                    std::vector<PackedGridFringe<D2Q9> > & fringe_list, bool alloc_all = true, unsigned long halo = 0)
             {
                 if (parts == 0)
                     throw InternalError("GridPartitioner: Cannot decompose into 0 parts!");
@@ -1289,7 +1292,7 @@ namespace honei
                     end = (i==0 ? first_size : normal_size);
                     part_sizes.push_back(end);
                 }
-                decompose_intern(part_sizes, info, data, info_list, data_list, fringe_list, alloc_all);
+                decompose_intern(part_sizes, info, data, info_list, data_list, fringe_list, alloc_all, halo);
             }
 
             static void destroy(std::vector<PackedGridInfo<D2Q9> > & info_list, std::vector<PackedGridData<D2Q9, DT_> > & data_list,
@@ -1515,6 +1518,256 @@ namespace honei
                 delete data->distribution_y;
                 data->distribution_y = temp;
             }
+
+        private:
+            /// Gather the halo elements of one vector from the patches owning them
+            static void _synch_halo(unsigned long patch,
+                    DenseVector<unsigned long> & index_vector, DenseVector<unsigned long> & targets,
+                    std::vector<PackedGridInfo<D2Q9> > & info_list, std::vector<PackedGridData<D2Q9, DT_> > & data_list,
+                    DenseVector<DT_> * PackedGridData<D2Q9, DT_>::* vector)
+            {
+                for (unsigned long i(0) ; i < index_vector.size() - 1 ; i += 2)
+                {
+                    unsigned long target(targets[i / 2]);
+                    if (target >= data_list.size())
+                        continue;
+                    DenseVector<DT_> & own(*(data_list[patch].*vector));
+                    DenseVector<DT_> & other(*(data_list[target].*vector));
+                    for (unsigned long j(index_vector[i]) ; j < index_vector[i + 1] ; ++j)
+                    {
+                        own[j - info_list[patch].offset] = other[j - info_list[target].offset];
+                    }
+                }
+            }
+
+            /// Scatter the halo f_temp elements, that solid cells of our own bounced back, to the patches owning them
+            static void _synch_fsi(unsigned long patch,
+                    DenseVector<unsigned long> & index_vector, DenseVector<unsigned long> & targets,
+                    std::vector<PackedGridInfo<D2Q9> > & info_list, std::vector<PackedGridData<D2Q9, DT_> > & data_list,
+                    std::vector<PackedSolidData<D2Q9, DT_> > & solids_list,
+                    DenseVector<DT_> * PackedGridData<D2Q9, DT_>::* vector, DenseVector<unsigned long> * PackedGridInfo<D2Q9>::* writer_dir)
+            {
+                PackedGridInfo<D2Q9> & info(info_list[patch]);
+                const unsigned long begin((*info.limits)[0]);
+                const unsigned long end((*info.limits)[info.limits->size() - 1]);
+                DenseVector<unsigned long> & writer(*(info.*writer_dir));
+                DenseVector<bool> & solid(*solids_list[patch].solid_flags);
+                for (unsigned long i(0) ; i < index_vector.size() - 1 ; i += 2)
+                {
+                    unsigned long target(targets[i / 2]);
+                    if (target >= data_list.size())
+                        continue;
+                    DenseVector<DT_> & own(*(data_list[patch].*vector));
+                    DenseVector<DT_> & other(*(data_list[target].*vector));
+                    for (unsigned long j(index_vector[i]) ; j < index_vector[i + 1] ; ++j)
+                    {
+                        unsigned long w(writer[j - info.offset]);
+                        if (w >= begin && w < end && solid[w])
+                            other[j - info_list[target].offset] = own[j - info.offset];
+                    }
+                }
+            }
+
+            static void _decompose_neighbours(DenseVector<unsigned long> & global, DenseVector<unsigned long> * & local,
+                    unsigned long offset, unsigned long size)
+            {
+                delete local;
+                local = new DenseVector<unsigned long>(size, std::numeric_limits<unsigned long>::max());
+                for (unsigned long i(0) ; i < size ; ++i)
+                {
+                    unsigned long neighbour(global[i + offset]);
+                    if (neighbour >= offset && neighbour < offset + size)
+                        (*local)[i] = neighbour - offset;
+                }
+            }
+
+            template <typename VT_> static void _decompose_solid_vector(DenseVector<VT_> * global, DenseVector<VT_> * & local,
+                    unsigned long offset, unsigned long size)
+            {
+                if (global == 0)
+                    return;
+                local = new DenseVector<VT_>(size);
+                for (unsigned long i(0) ; i < size ; ++i)
+                {
+                    (*local)[i] = (*global)[i + offset];
+                }
+            }
+
+            template <typename VT_> static void _compose_solid_vector(DenseVector<VT_> * global, DenseVector<VT_> * local,
+                    PackedGridInfo<D2Q9> & info)
+            {
+                if (global == 0)
+                    return;
+                for (unsigned long i((*info.limits)[0]) ; i < (*info.limits)[info.limits->size() - 1] ; ++i)
+                {
+                    (*global)[i + info.offset] = (*local)[i];
+                }
+            }
+
+        public:
+            /**
+             * \name Fluid structure interaction
+             *
+             * Helpers for partitioned FSI solvers: the per cell neighbour vectors and the solid data
+             * of every patch cover its halo as well, so that solids crossing patch boundaries are
+             * seen by all patches involved.
+             *
+             * \{
+             */
+
+            /// Expand the per cell neighbour vectors of all patches from the ones of the cuda packed global info.
+            static void decompose_neighbours(PackedGridInfo<D2Q9> & info,
+                    std::vector<PackedGridInfo<D2Q9> > & info_list, std::vector<PackedGridData<D2Q9, DT_> > & data_list)
+            {
+                CONTEXT("When decomposing neighbour vectors:");
+                if (info.cuda_dir_1 == 0)
+                    throw InternalError("GridPartitioner: Global info is not cuda packed!");
+
+                for (unsigned long i(0) ; i < info_list.size() ; ++i)
+                {
+                    const unsigned long offset(info_list[i].offset);
+                    const unsigned long size(data_list[i].h->size());
+                    _decompose_neighbours(*info.cuda_dir_1, info_list[i].cuda_dir_1, offset, size);
+                    _decompose_neighbours(*info.cuda_dir_2, info_list[i].cuda_dir_2, offset, size);
+                    _decompose_neighbours(*info.cuda_dir_3, info_list[i].cuda_dir_3, offset, size);
+                    _decompose_neighbours(*info.cuda_dir_4, info_list[i].cuda_dir_4, offset, size);
+                    _decompose_neighbours(*info.cuda_dir_5, info_list[i].cuda_dir_5, offset, size);
+                    _decompose_neighbours(*info.cuda_dir_6, info_list[i].cuda_dir_6, offset, size);
+                    _decompose_neighbours(*info.cuda_dir_7, info_list[i].cuda_dir_7, offset, size);
+                    _decompose_neighbours(*info.cuda_dir_8, info_list[i].cuda_dir_8, offset, size);
+                }
+            }
+
+            /// Create one solid data object per patch, halo included.
+            static void decompose_solids(PackedSolidData<D2Q9, DT_> & solids,
+                    std::vector<PackedGridInfo<D2Q9> > & info_list, std::vector<PackedGridData<D2Q9, DT_> > & data_list,
+                    std::vector<PackedSolidData<D2Q9, DT_> > & solids_list)
+            {
+                CONTEXT("When creating solid partitions:");
+                for (unsigned long i(0) ; i < info_list.size() ; ++i)
+                {
+                    const unsigned long offset(info_list[i].offset);
+                    const unsigned long size(data_list[i].h->size());
+                    PackedSolidData<D2Q9, DT_> new_solids;
+                    _decompose_solid_vector(solids.boundary_flags, new_solids.boundary_flags, offset, size);
+                    _decompose_solid_vector(solids.line_flags, new_solids.line_flags, offset, size);
+                    _decompose_solid_vector(solids.solid_flags, new_solids.solid_flags, offset, size);
+                    _decompose_solid_vector(solids.solid_old_flags, new_solids.solid_old_flags, offset, size);
+                    _decompose_solid_vector(solids.solid_to_fluid_flags, new_solids.solid_to_fluid_flags, offset, size);
+                    _decompose_solid_vector(solids.stationary_flags, new_solids.stationary_flags, offset, size);
+                    _decompose_solid_vector(solids.f_mea_1, new_solids.f_mea_1, offset, size);
+                    _decompose_solid_vector(solids.f_mea_2, new_solids.f_mea_2, offset, size);
+                    _decompose_solid_vector(solids.f_mea_3, new_solids.f_mea_3, offset, size);
+                    _decompose_solid_vector(solids.f_mea_4, new_solids.f_mea_4, offset, size);
+                    _decompose_solid_vector(solids.f_mea_5, new_solids.f_mea_5, offset, size);
+                    _decompose_solid_vector(solids.f_mea_6, new_solids.f_mea_6, offset, size);
+                    _decompose_solid_vector(solids.f_mea_7, new_solids.f_mea_7, offset, size);
+                    _decompose_solid_vector(solids.f_mea_8, new_solids.f_mea_8, offset, size);
+                    new_solids.current_u = solids.current_u;
+                    new_solids.current_v = solids.current_v;
+                    solids_list.push_back(new_solids);
+                }
+            }
+
+            /// Copy the solid geometry, as created by the scan conversion of the global solid data, into all patches.
+            static void synch_solids(PackedSolidData<D2Q9, DT_> & solids,
+                    std::vector<PackedGridInfo<D2Q9> > & info_list, std::vector<PackedSolidData<D2Q9, DT_> > & solids_list)
+            {
+                for (unsigned long i(0) ; i < solids_list.size() ; ++i)
+                {
+                    const unsigned long offset(info_list[i].offset);
+                    const unsigned long size(solids_list[i].solid_flags->size());
+                    for (unsigned long j(0) ; j < size ; ++j)
+                    {
+                        (*solids_list[i].boundary_flags)[j] = (*solids.boundary_flags)[j + offset];
+                        (*solids_list[i].line_flags)[j] = (*solids.line_flags)[j + offset];
+                        (*solids_list[i].solid_flags)[j] = (*solids.solid_flags)[j + offset];
+                    }
+                    solids_list[i].current_u = solids.current_u;
+                    solids_list[i].current_v = solids.current_v;
+                }
+            }
+
+            /// Copy the solver state of the solid data of all patches back into the global one.
+            static void compose_solids(PackedSolidData<D2Q9, DT_> & solids,
+                    std::vector<PackedGridInfo<D2Q9> > & info_list, std::vector<PackedSolidData<D2Q9, DT_> > & solids_list)
+            {
+                for (unsigned long i(0) ; i < solids_list.size() ; ++i)
+                {
+                    _compose_solid_vector(solids.solid_old_flags, solids_list[i].solid_old_flags, info_list[i]);
+                    _compose_solid_vector(solids.f_mea_1, solids_list[i].f_mea_1, info_list[i]);
+                    _compose_solid_vector(solids.f_mea_2, solids_list[i].f_mea_2, info_list[i]);
+                    _compose_solid_vector(solids.f_mea_3, solids_list[i].f_mea_3, info_list[i]);
+                    _compose_solid_vector(solids.f_mea_4, solids_list[i].f_mea_4, info_list[i]);
+                    _compose_solid_vector(solids.f_mea_5, solids_list[i].f_mea_5, info_list[i]);
+                    _compose_solid_vector(solids.f_mea_6, solids_list[i].f_mea_6, info_list[i]);
+                    _compose_solid_vector(solids.f_mea_7, solids_list[i].f_mea_7, info_list[i]);
+                    _compose_solid_vector(solids.f_mea_8, solids_list[i].f_mea_8, info_list[i]);
+                }
+            }
+
+            /// Gather h, u and v of the halo from other patches.
+            static void synch_velocities(std::vector<PackedGridInfo<D2Q9> > & info_list, std::vector<PackedGridData<D2Q9, DT_> > & data_list,
+                    std::vector<PackedGridFringe<D2Q9> > & fringe_list)
+            {
+                for (unsigned long index(0) ; index < fringe_list.size() ; ++index)
+                {
+                    _synch_halo(index, *(fringe_list[index].h_index), *(fringe_list[index].h_targets), info_list, data_list, &PackedGridData<D2Q9, DT_>::h);
+                    _synch_halo(index, *(fringe_list[index].h_index), *(fringe_list[index].h_targets), info_list, data_list, &PackedGridData<D2Q9, DT_>::u);
+                    _synch_halo(index, *(fringe_list[index].h_index), *(fringe_list[index].h_targets), info_list, data_list, &PackedGridData<D2Q9, DT_>::v);
+                }
+            }
+
+            /// Gather f_temp of the halo from other patches, after synch() delivered all streamed elements.
+            static void synch_temp_halo(std::vector<PackedGridInfo<D2Q9> > & info_list, std::vector<PackedGridData<D2Q9, DT_> > & data_list,
+                    std::vector<PackedGridFringe<D2Q9> > & fringe_list)
+            {
+                for (unsigned long index(0) ; index < fringe_list.size() ; ++index)
+                {
+                    DenseVector<unsigned long> & h_index(*(fringe_list[index].h_index));
+                    DenseVector<unsigned long> & h_targets(*(fringe_list[index].h_targets));
+                    _synch_halo(index, h_index, h_targets, info_list, data_list, &PackedGridData<D2Q9, DT_>::f_temp_1);
+                    _synch_halo(index, h_index, h_targets, info_list, data_list, &PackedGridData<D2Q9, DT_>::f_temp_2);
+                    _synch_halo(index, h_index, h_targets, info_list, data_list, &PackedGridData<D2Q9, DT_>::f_temp_3);
+                    _synch_halo(index, h_index, h_targets, info_list, data_list, &PackedGridData<D2Q9, DT_>::f_temp_4);
+                    _synch_halo(index, h_index, h_targets, info_list, data_list, &PackedGridData<D2Q9, DT_>::f_temp_5);
+                    _synch_halo(index, h_index, h_targets, info_list, data_list, &PackedGridData<D2Q9, DT_>::f_temp_6);
+                    _synch_halo(index, h_index, h_targets, info_list, data_list, &PackedGridData<D2Q9, DT_>::f_temp_7);
+                    _synch_halo(index, h_index, h_targets, info_list, data_list, &PackedGridData<D2Q9, DT_>::f_temp_8);
+                }
+            }
+
+            /**
+             * Scatter the populations CollideStreamFSI bounced back into the halo to the patches owning them.
+             *
+             * Element k of a cell is only ever written by its solid neighbour in direction opposite to k,
+             * so every patch scatters exactly the elements whose writer is one of its own cells.
+             */
+            static void synch_fsi(std::vector<PackedGridInfo<D2Q9> > & info_list, std::vector<PackedGridData<D2Q9, DT_> > & data_list,
+                    std::vector<PackedSolidData<D2Q9, DT_> > & solids_list, std::vector<PackedGridFringe<D2Q9> > & fringe_list)
+            {
+                for (unsigned long index(0) ; index < fringe_list.size() ; ++index)
+                {
+                    DenseVector<unsigned long> & h_index(*(fringe_list[index].h_index));
+                    DenseVector<unsigned long> & h_targets(*(fringe_list[index].h_targets));
+                    _synch_fsi(index, h_index, h_targets, info_list, data_list, solids_list, &PackedGridData<D2Q9, DT_>::f_temp_1, &PackedGridInfo<D2Q9>::cuda_dir_5);
+                    _synch_fsi(index, h_index, h_targets, info_list, data_list, solids_list, &PackedGridData<D2Q9, DT_>::f_temp_2, &PackedGridInfo<D2Q9>::cuda_dir_6);
+                    _synch_fsi(index, h_index, h_targets, info_list, data_list, solids_list, &PackedGridData<D2Q9, DT_>::f_temp_3, &PackedGridInfo<D2Q9>::cuda_dir_7);
+                    _synch_fsi(index, h_index, h_targets, info_list, data_list, solids_list, &PackedGridData<D2Q9, DT_>::f_temp_4, &PackedGridInfo<D2Q9>::cuda_dir_8);
+                    _synch_fsi(index, h_index, h_targets, info_list, data_list, solids_list, &PackedGridData<D2Q9, DT_>::f_temp_5, &PackedGridInfo<D2Q9>::cuda_dir_1);
+                    _synch_fsi(index, h_index, h_targets, info_list, data_list, solids_list, &PackedGridData<D2Q9, DT_>::f_temp_6, &PackedGridInfo<D2Q9>::cuda_dir_2);
+                    _synch_fsi(index, h_index, h_targets, info_list, data_list, solids_list, &PackedGridData<D2Q9, DT_>::f_temp_7, &PackedGridInfo<D2Q9>::cuda_dir_3);
+                    _synch_fsi(index, h_index, h_targets, info_list, data_list, solids_list, &PackedGridData<D2Q9, DT_>::f_temp_8, &PackedGridInfo<D2Q9>::cuda_dir_4);
+                }
+            }
+
+            static void destroy_solids(std::vector<PackedSolidData<D2Q9, DT_> > & solids_list)
+            {
+                for (unsigned long i(0) ; i < solids_list.size() ; ++i)
+                    solids_list.at(i).destroy();
+            }
+
+            /// \}
     };
 }
 
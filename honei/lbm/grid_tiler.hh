@@ -0,0 +1,360 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LBM C++ library. LBM is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LBM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#pragma once
+#ifndef LBM_GUARD_GRID_TILER_HH
+#define LBM_GUARD_GRID_TILER_HH 1
+
+#include <honei/lbm/grid.hh>
+#include <honei/lbm/grid_packer.hh>
+#include <honei/la/dense_vector.hh>
+#include <honei/util/exception.hh>
+
+#include <algorithm>
+#include <climits>
+#include <vector>
+
+/**
+ * \file
+ * Definition of the LBM grid tiler, which tracks the wet part of a packed grid.
+ *
+ * \ingroup grpliblbm
+ **/
+
+using namespace honei;
+using namespace lbm;
+using namespace lbm_lattice_types;
+
+namespace honei
+{
+    template <typename LatticeType_> class PackedGridTiles
+    {
+    };
+
+    /**
+     * \brief Active set of a packed grid.
+     *
+     * The packed cells are cut into tiles of tile_size consecutive cells. A tile is wet if any
+     * of its cells holds water, and active if it or any tile adjacent to it is wet. info_list
+     * holds one packed grid info for every maximal range of active tiles; these infos index
+     * the data of the whole grid, so any grid kernel can be run on the active set alone.
+     *
+     * \ingroup grpliblbm
+     */
+    template <> class PackedGridTiles<D2Q9>
+    {
+        public:
+            PackedGridTiles() :
+                tile_size(0)
+            {
+            }
+
+            void destroy()
+            {
+                for (unsigned long i(0) ; i < info_list.size() ; ++i)
+                    info_list.at(i).destroy();
+                info_list.clear();
+            }
+
+            /// Number of cells per tile.
+            unsigned long tile_size;
+
+            /// First cell of every tile, followed by the end of the last tile.
+            std::vector<unsigned long> limits;
+
+            /// Tiles holding a neighbour of any cell of the tile.
+            std::vector<std::vector<unsigned long> > neighbours;
+
+            std::vector<bool> wet;
+            std::vector<bool> active;
+
+            /// Active tiles in ascending order.
+            std::vector<unsigned long> active_list;
+
+            /// Packed grid infos of the maximal ranges of active tiles.
+            std::vector<PackedGridInfo<D2Q9> > info_list;
+
+            unsigned long tile_count() const
+            {
+                return limits.size() - 1;
+            }
+    };
+
+    template <typename LatticeType_, typename DT_> struct GridTiler
+    {
+    };
+
+    template <typename DT_> struct GridTiler<D2Q9, DT_>
+    {
+        private:
+            /// Copy the streaming runs of one direction that start in [begin, end).
+            static void _restrict_dir(DenseVector<unsigned long> & dir, DenseVector<unsigned long> & dir_index,
+                    unsigned long begin, unsigned long end,
+                    DenseVector<unsigned long> * & new_dir, DenseVector<unsigned long> * & new_dir_index)
+            {
+                std::vector<unsigned long> temp_dir;
+                std::vector<unsigned long> temp_dir_index;
+
+                // first run ending behind begin, run ends are sorted just like run begins
+                unsigned long run(0), run_end(dir.size());
+                while (run_end > run)
+                {
+                    unsigned long middle((run + run_end) / 2);
+                    if (dir_index[middle * 2 + 1] > begin)
+                        run_end = middle;
+                    else
+                        run = middle + 1;
+                }
+
+                for ( ; run < dir.size() && dir_index[run * 2] < end ; ++run)
+                {
+                    unsigned long run_begin(std::max(dir_index[run * 2], begin));
+                    temp_dir.push_back(dir[run] + (run_begin - dir_index[run * 2]));
+                    temp_dir_index.push_back(run_begin);
+                    temp_dir_index.push_back(std::min(dir_index[run * 2 + 1], end));
+                }
+
+                // the grid kernels expect at least one run
+                if (temp_dir.empty())
+                {
+                    temp_dir.push_back(begin);
+                    temp_dir_index.push_back(begin);
+                    temp_dir_index.push_back(begin);
+                }
+
+                new_dir = new DenseVector<unsigned long>(temp_dir.size());
+                new_dir_index = new DenseVector<unsigned long>(temp_dir_index.size());
+                for (unsigned long i(0) ; i < temp_dir.size() ; ++i)
+                    (*new_dir)[i] = temp_dir[i];
+                for (unsigned long i(0) ; i < temp_dir_index.size() ; ++i)
+                    (*new_dir_index)[i] = temp_dir_index[i];
+            }
+
+            /// Create the packed grid info of the cells [begin, end), indexing the data of the whole grid.
+            static void _restrict(PackedGridInfo<D2Q9> & info, unsigned long begin, unsigned long end,
+                    PackedGridInfo<D2Q9> & range)
+            {
+                std::vector<unsigned long> temp_limits;
+                std::vector<unsigned long> temp_types;
+
+                const unsigned long * const limits(info.limits->elements());
+                const unsigned long limit_count(info.limits->size());
+                unsigned long segment(std::upper_bound(limits, limits + limit_count, begin) - limits - 1);
+
+                temp_limits.push_back(begin);
+                temp_types.push_back((*info.types)[segment]);
+                for (++segment ; segment < limit_count && limits[segment] < end ; ++segment)
+                {
+                    temp_limits.push_back(limits[segment]);
+                    temp_types.push_back((*info.types)[segment]);
+                }
+                temp_limits.push_back(end);
+                temp_types.push_back(0);
+
+                range.offset = 0;
+                range.limits = new DenseVector<unsigned long>(temp_limits.size());
+                range.types = new DenseVector<unsigned long>(temp_types.size());
+                for (unsigned long i(0) ; i < temp_limits.size() ; ++i)
+                {
+                    (*range.limits)[i] = temp_limits[i];
+                    (*range.types)[i] = temp_types[i];
+                }
+
+                _restrict_dir(*info.dir_1, *info.dir_index_1, begin, end, range.dir_1, range.dir_index_1);
+                _restrict_dir(*info.dir_2, *info.dir_index_2, begin, end, range.dir_2, range.dir_index_2);
+                _restrict_dir(*info.dir_3, *info.dir_index_3, begin, end, range.dir_3, range.dir_index_3);
+                _restrict_dir(*info.dir_4, *info.dir_index_4, begin, end, range.dir_4, range.dir_index_4);
+                _restrict_dir(*info.dir_5, *info.dir_index_5, begin, end, range.dir_5, range.dir_index_5);
+                _restrict_dir(*info.dir_6, *info.dir_index_6, begin, end, range.dir_6, range.dir_index_6);
+                _restrict_dir(*info.dir_7, *info.dir_index_7, begin, end, range.dir_7, range.dir_index_7);
+                _restrict_dir(*info.dir_8, *info.dir_index_8, begin, end, range.dir_8, range.dir_index_8);
+            }
+
+            static void _clear(DenseVector<DT_> & f, DenseVector<DT_> & f_temp, DenseVector<unsigned long> & dir, unsigned long i)
+            {
+                f[i] = DT_(0);
+                f_temp[i] = DT_(0);
+                if (dir[i] != ULONG_MAX)
+                {
+                    f[dir[i]] = DT_(0);
+                    f_temp[dir[i]] = DT_(0);
+                }
+            }
+
+            /// Set a tile to the dry state, including the distributions it streamed into its neighbours.
+            static void _dry(PackedGridInfo<D2Q9> & info, PackedGridData<D2Q9, DT_> & data, unsigned long begin, unsigned long end)
+            {
+                for (unsigned long i(begin) ; i < end ; ++i)
+                {
+                    (*data.h)[i] = DT_(0);
+                    (*data.u)[i] = DT_(0);
+                    (*data.v)[i] = DT_(0);
+                    (*data.f_0)[i] = DT_(0);
+                    (*data.f_temp_0)[i] = DT_(0);
+                    _clear(*data.f_1, *data.f_temp_1, *info.cuda_dir_1, i);
+                    _clear(*data.f_2, *data.f_temp_2, *info.cuda_dir_2, i);
+                    _clear(*data.f_3, *data.f_temp_3, *info.cuda_dir_3, i);
+                    _clear(*data.f_4, *data.f_temp_4, *info.cuda_dir_4, i);
+                    _clear(*data.f_5, *data.f_temp_5, *info.cuda_dir_5, i);
+                    _clear(*data.f_6, *data.f_temp_6, *info.cuda_dir_6, i);
+                    _clear(*data.f_7, *data.f_temp_7, *info.cuda_dir_7, i);
+                    _clear(*data.f_8, *data.f_temp_8, *info.cuda_dir_8, i);
+                }
+            }
+
+            static void _add_neighbours(PackedGridTiles<D2Q9> & tiles, DenseVector<unsigned long> & dir, unsigned long tile,
+                    std::vector<unsigned long> & neighbours)
+            {
+                for (unsigned long i(tiles.limits[tile]) ; i < tiles.limits[tile + 1] ; ++i)
+                {
+                    if (dir[i] == ULONG_MAX)
+                        continue;
+
+                    unsigned long neighbour((dir[i] - tiles.limits[0]) / tiles.tile_size);
+                    if (neighbour != tile)
+                        neighbours.push_back(neighbour);
+                }
+            }
+
+        public:
+            /**
+             * Cut a packed grid into tiles. All tiles start out active, the first call of update
+             * dries those that hold no water.
+             *
+             * \param tile_size Number of cells per tile.
+             */
+            static void decompose(unsigned long tile_size, PackedGridInfo<D2Q9> & info, PackedGridData<D2Q9, DT_> & data,
+                    PackedGridTiles<D2Q9> & tiles)
+            {
+                CONTEXT("When creating grid tiles:");
+
+                if (tile_size == 0)
+                    throw InternalError("GridTiler: tile size must not be zero!");
+
+                if (info.cuda_dir_1 == 0)
+                    GridPacker<D2Q9, lbm_boundary_types::NOSLIP, DT_>::cuda_pack(info, data);
+
+                const unsigned long begin((*info.limits)[0]);
+                const unsigned long end((*info.limits)[info.limits->size() - 1]);
+
+                tiles.destroy();
+                tiles.tile_size = tile_size;
+                tiles.limits.clear();
+                for (unsigned long i(begin) ; i < end ; i += tile_size)
+                    tiles.limits.push_back(i);
+                tiles.limits.push_back(end);
+
+                const unsigned long tile_count(tiles.tile_count());
+                tiles.neighbours.assign(tile_count, std::vector<unsigned long>());
+                tiles.wet.assign(tile_count, true);
+                tiles.active.assign(tile_count, true);
+                tiles.active_list.clear();
+                for (unsigned long tile(0) ; tile < tile_count ; ++tile)
+                {
+                    std::vector<unsigned long> & neighbours(tiles.neighbours[tile]);
+                    _add_neighbours(tiles, *info.cuda_dir_1, tile, neighbours);
+                    _add_neighbours(tiles, *info.cuda_dir_2, tile, neighbours);
+                    _add_neighbours(tiles, *info.cuda_dir_3, tile, neighbours);
+                    _add_neighbours(tiles, *info.cuda_dir_4, tile, neighbours);
+                    _add_neighbours(tiles, *info.cuda_dir_5, tile, neighbours);
+                    _add_neighbours(tiles, *info.cuda_dir_6, tile, neighbours);
+                    _add_neighbours(tiles, *info.cuda_dir_7, tile, neighbours);
+                    _add_neighbours(tiles, *info.cuda_dir_8, tile, neighbours);
+                    std::sort(neighbours.begin(), neighbours.end());
+                    neighbours.erase(std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+
+                    tiles.active_list.push_back(tile);
+                }
+
+                PackedGridInfo<D2Q9> range;
+                _restrict(info, begin, end, range);
+                tiles.info_list.push_back(range);
+            }
+
+            /**
+             * Update the active set from the water depth of the active tiles. Tiles that fall
+             * inactive are set to the dry state, so that they feed zero distributions into their
+             * neighbours; tiles next to wet tiles are woken up. As water moves at most one cell
+             * per time step, calling this once per step keeps the active set ahead of any front.
+             *
+             * \param epsilon Depth below which a cell counts as dry.
+             *
+             * \return Whether the active set has changed.
+             */
+            static bool update(PackedGridInfo<D2Q9> & info, PackedGridData<D2Q9, DT_> & data, PackedGridTiles<D2Q9> & tiles, DT_ epsilon)
+            {
+                CONTEXT("When updating grid tiles:");
+
+                std::vector<unsigned long> wet_list;
+                for (std::vector<unsigned long>::iterator t(tiles.active_list.begin()) ; t != tiles.active_list.end() ; ++t)
+                {
+                    bool wet(false);
+                    for (unsigned long i(tiles.limits[*t]) ; i < tiles.limits[*t + 1] && ! wet ; ++i)
+                        wet = (*data.h)[i] > epsilon || (*data.h)[i] < -epsilon;
+
+                    tiles.wet[*t] = wet;
+                    if (wet)
+                        wet_list.push_back(*t);
+                }
+
+                std::vector<unsigned long> active_list(wet_list);
+                for (std::vector<unsigned long>::iterator t(wet_list.begin()) ; t != wet_list.end() ; ++t)
+                    active_list.insert(active_list.end(), tiles.neighbours[*t].begin(), tiles.neighbours[*t].end());
+                std::sort(active_list.begin(), active_list.end());
+                active_list.erase(std::unique(active_list.begin(), active_list.end()), active_list.end());
+
+                if (active_list == tiles.active_list)
+                    return false;
+
+                for (std::vector<unsigned long>::iterator t(tiles.active_list.begin()) ; t != tiles.active_list.end() ; ++t)
+                    tiles.active[*t] = false;
+                for (std::vector<unsigned long>::iterator t(active_list.begin()) ; t != active_list.end() ; ++t)
+                    tiles.active[*t] = true;
+                for (std::vector<unsigned long>::iterator t(tiles.active_list.begin()) ; t != tiles.active_list.end() ; ++t)
+                {
+                    if (! tiles.active[*t])
+                        _dry(info, data, tiles.limits[*t], tiles.limits[*t + 1]);
+                }
+                tiles.active_list.swap(active_list);
+
+                tiles.destroy();
+                for (unsigned long i(0) ; i < tiles.active_list.size() ; )
+                {
+                    unsigned long first(tiles.active_list[i]);
+                    unsigned long last(first);
+                    for (++i ; i < tiles.active_list.size() && tiles.active_list[i] == last + 1 ; ++i)
+                        ++last;
+
+                    PackedGridInfo<D2Q9> range;
+                    _restrict(info, tiles.limits[first], tiles.limits[last + 1], range);
+                    tiles.info_list.push_back(range);
+                }
+
+                return true;
+            }
+
+            static void destroy(PackedGridTiles<D2Q9> & tiles)
+            {
+                tiles.destroy();
+            }
+    };
+}
+
+#endif
@@ -0,0 +1,126 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LBM C++ library. LBM is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LBM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <honei/lbm/grid_tiler.hh>
+#include <honei/lbm/grid_packer.hh>
+#include <honei/la/algorithm.hh>
+#include <honei/util/unittest.hh>
+#include <iostream>
+
+using namespace honei;
+using namespace tests;
+using namespace std;
+using namespace lbm;
+using namespace lbm_lattice_types;
+using namespace lbm_boundary_types;
+
+template <typename Tag_, typename DataType_>
+class GridTilerTest :
+    public QuickTaggedTest<Tag_>
+{
+    private:
+        static unsigned long _run_cells(DenseVector<unsigned long> & dir_index)
+        {
+            unsigned long result(0);
+            for (unsigned long i(0) ; i < dir_index.size() ; i += 2)
+                result += dir_index[i + 1] - dir_index[i];
+            return result;
+        }
+
+    public:
+        GridTilerTest(const std::string & type) :
+            QuickTaggedTest<Tag_>("grid_tiler_quick_test<" + type + ">")
+        {
+        }
+
+        virtual void run() const
+        {
+            DenseMatrix<DataType_> h(10, 12, DataType_(0));
+            h(7, 9) = DataType_(1);
+            DenseMatrix<bool> obst(10, 12, false);
+            obst(0, 4) = true;
+            obst(2, 4) = true;
+            obst(1, 11) = true;
+
+            PackedGridInfo<D2Q9> info;
+            PackedGridData<D2Q9, DataType_> data;
+            Grid<D2Q9, DataType_> grid;
+            grid.h = new DenseMatrix<DataType_>(h.copy());
+            grid.u = new DenseMatrix<DataType_>(10, 12, DataType_(0));
+            grid.v = new DenseMatrix<DataType_>(10, 12, DataType_(0));
+            grid.b = new DenseMatrix<DataType_>(10, 12, DataType_(0));
+            grid.obstacles = new DenseMatrix<bool>(obst);
+            GridPacker<D2Q9, NOSLIP, DataType_>::pack(grid, info, data);
+            fill<tags::CPU>(*data.f_temp_1, DataType_(1));
+
+            PackedGridTiles<D2Q9> tiles;
+            GridTiler<D2Q9, DataType_>::decompose(8, info, data, tiles);
+            TEST_CHECK_EQUAL(tiles.tile_count(), (data.h->size() + 7) / 8);
+            TEST_CHECK_EQUAL(tiles.active_list.size(), tiles.tile_count());
+            TEST_CHECK_EQUAL(tiles.info_list.size(), 1ul);
+            TEST_CHECK_EQUAL(_run_cells(*tiles.info_list[0].dir_index_1), _run_cells(*info.dir_index_1));
+            TEST_CHECK_EQUAL(_run_cells(*tiles.info_list[0].dir_index_6), _run_cells(*info.dir_index_6));
+
+            // the wet tile and the tiles holding the neighbours of its cells
+            TEST_CHECK((GridTiler<D2Q9, DataType_>::update(info, data, tiles, DataType_(1e-5))));
+            unsigned long wet_cell((*grid.h_index)(7, 9));
+            unsigned long wet_tile(wet_cell / 8);
+            TEST_CHECK(tiles.wet[wet_tile]);
+            TEST_CHECK(tiles.active[wet_tile]);
+            TEST_CHECK(tiles.active[(*grid.h_index)(6, 9) / 8]);
+            TEST_CHECK(tiles.active[(*grid.h_index)(8, 9) / 8]);
+            TEST_CHECK(! tiles.active[0]);
+            TEST_CHECK_EQUAL(tiles.active_list.size(), tiles.neighbours[wet_tile].size() + 1);
+            TEST_CHECK(! (GridTiler<D2Q9, DataType_>::update(info, data, tiles, DataType_(1e-5))));
+
+            unsigned long active_cells(0);
+            for (unsigned long i(0) ; i < tiles.info_list.size() ; ++i)
+            {
+                PackedGridInfo<D2Q9> & range(tiles.info_list[i]);
+                unsigned long begin((*range.limits)[0]);
+                unsigned long end((*range.limits)[range.limits->size() - 1]);
+                active_cells += end - begin;
+                for (unsigned long j(0) ; j < range.dir_index_1->size() ; j += 2)
+                {
+                    TEST_CHECK((*range.dir_index_1)[j] >= begin);
+                    TEST_CHECK((*range.dir_index_1)[j + 1] <= end);
+                }
+            }
+            unsigned long tile_cells(0);
+            for (unsigned long i(0) ; i < tiles.active_list.size() ; ++i)
+                tile_cells += tiles.limits[tiles.active_list[i] + 1] - tiles.limits[tiles.active_list[i]];
+            TEST_CHECK_EQUAL(active_cells, tile_cells);
+
+            // dried tiles carry no distributions
+            for (unsigned long i(0) ; i < tiles.limits[1] ; ++i)
+                TEST_CHECK_EQUAL((*data.f_temp_1)[i], DataType_(0));
+            TEST_CHECK_EQUAL((*data.f_temp_1)[wet_cell], DataType_(1));
+
+            (*data.h)[wet_cell] = DataType_(0);
+            TEST_CHECK((GridTiler<D2Q9, DataType_>::update(info, data, tiles, DataType_(1e-5))));
+            TEST_CHECK_EQUAL(tiles.active_list.size(), 0ul);
+            TEST_CHECK_EQUAL(tiles.info_list.size(), 0ul);
+
+            GridTiler<D2Q9, DataType_>::destroy(tiles);
+            info.destroy();
+            data.destroy();
+            grid.destroy();
+        }
+};
+GridTilerTest<tags::CPU, float> grid_tiler_test_float("float");
+GridTilerTest<tags::CPU, double> grid_tiler_test_double("double");
@@ -21,6 +21,7 @@
 #define LBM_GUARD_SCAN_CONVERSION_FSI_HH 1
 
 #include <climits>
+#include <vector>
 #include <honei/lbm/tags.hh>
 #include <honei/la/algorithm.hh>
 #include <honei/lbm/grid_packer.hh>
@@ -37,10 +38,228 @@ namespace honei
             {
             };
 
+        /**
+         * \brief Flags of a set of solids from the previous scan conversion.
+         *
+         * Holds the line, boundary and solid flags as bitsets over the packed grid, together with the
+         * list of words in use, so that ScanConversionFSI can update the flag vectors of a
+         * PackedSolidData incrementally: only cells whose flags differ between two time steps are
+         * written. One footprint belongs to exactly one PackedSolidData object.
+         *
+         * \ingroup grpliblbm
+         */
+        class SolidFootprint
+        {
+            friend class ScanConversionFSI<tags::CPU>;
+
+            private:
+                /// Number of bits in a bitset word.
+                static const unsigned long _bits = sizeof(unsigned long) * CHAR_BIT;
+
+                /// Number of packed cells, zero if the footprint has not been used yet.
+                unsigned long _size;
+
+                /// Index of the bitsets holding the current footprint, the others collect the next one.
+                unsigned _current;
+
+                std::vector<unsigned long> _line[2];
+                std::vector<unsigned long> _boundary[2];
+                std::vector<unsigned long> _solid[2];
+
+                /// Words containing set bits, and for each word a mask of the bitsets listing it.
+                std::vector<unsigned long> _words[2];
+                std::vector<unsigned char> _listed;
+
+                void _allocate(unsigned long size)
+                {
+                    unsigned long word_count((size + _bits - 1) / _bits);
+                    _size = size;
+                    _current = 0;
+                    for (unsigned i(0) ; i < 2 ; ++i)
+                    {
+                        _line[i].assign(word_count, 0ul);
+                        _boundary[i].assign(word_count, 0ul);
+                        _solid[i].assign(word_count, 0ul);
+                        _words[i].clear();
+                    }
+                    _listed.assign(word_count, 0);
+                }
+
+                void _list(unsigned long word)
+                {
+                    unsigned char mask(1 << (1 - _current));
+                    if (! (_listed[word] & mask))
+                    {
+                        _listed[word] |= mask;
+                        _words[1 - _current].push_back(word);
+                    }
+                }
+
+                void _set(std::vector<unsigned long> * bitsets, unsigned long index, bool value)
+                {
+                    // ignore cells outside the packed grid
+                    if (index >= _size)
+                        return;
+
+                    unsigned long word(index / _bits);
+                    unsigned long bit(1ul << (index % _bits));
+                    if (value)
+                    {
+                        bitsets[1 - _current][word] |= bit;
+                        _list(word);
+                    }
+                    else
+                        bitsets[1 - _current][word] &= ~bit;
+                }
+
+                bool _get(std::vector<unsigned long> * bitsets, unsigned long index) const
+                {
+                    if (index >= _size)
+                        return false;
+
+                    return bitsets[1 - _current][index / _bits] & (1ul << (index % _bits));
+                }
+
+                /// Write the differences between current and next footprint to a flag vector.
+                void _write(std::vector<unsigned long> * bitsets, DenseVector<bool> & flags, unsigned long word)
+                {
+                    unsigned long next(bitsets[1 - _current][word]);
+                    unsigned long changed(bitsets[_current][word] ^ next);
+                    for (unsigned long index(word * _bits) ; changed != 0 ; ++index, changed >>= 1, next >>= 1)
+                    {
+                        if (changed & 1ul)
+                            flags[index] = next & 1ul;
+                    }
+                }
+
+                /// Make the next footprint the current one.
+                void _commit(DenseVector<bool> & line_flags, DenseVector<bool> & boundary_flags, DenseVector<bool> & solid_flags)
+                {
+                    for (unsigned i(0) ; i < 2 ; ++i)
+                    {
+                        for (std::vector<unsigned long>::const_iterator w(_words[i].begin()), w_end(_words[i].end()) ; w != w_end ; ++w)
+                        {
+                            _write(_line, line_flags, *w);
+                            _write(_boundary, boundary_flags, *w);
+                            _write(_solid, solid_flags, *w);
+                        }
+                    }
+
+                    unsigned char mask(1 << _current);
+                    for (std::vector<unsigned long>::const_iterator w(_words[_current].begin()), w_end(_words[_current].end()) ; w != w_end ; ++w)
+                    {
+                        _line[_current][*w] = 0ul;
+                        _boundary[_current][*w] = 0ul;
+                        _solid[_current][*w] = 0ul;
+                        _listed[*w] &= ~mask;
+                    }
+                    _words[_current].clear();
+                    _current = 1 - _current;
+                }
+
+            public:
+                SolidFootprint() :
+                    _size(0),
+                    _current(0)
+                {
+                }
+
+                /// Forget the previous footprint, the next scan conversion will clear all flags.
+                void reset()
+                {
+                    _size = 0;
+                }
+
+                /// Number of packed cells flagged as solid in the current footprint.
+                unsigned long solid_count() const
+                {
+                    unsigned long result(0);
+                    for (std::vector<unsigned long>::const_iterator w(_words[_current].begin()), w_end(_words[_current].end()) ; w != w_end ; ++w)
+                    {
+                        for (unsigned long word(_solid[_current][*w]) ; word != 0 ; word &= word - 1)
+                            ++result;
+                    }
+                    return result;
+                }
+        };
+
         template<>
             class ScanConversionFSI<tags::CPU>
             {
                 private:
+                    /// Flag target writing directly into the flag vectors of a PackedSolidData object.
+                    template <typename DT_>
+                        class _SolidFlags
+                        {
+                            private:
+                                PackedSolidData<lbm_lattice_types::D2Q9, DT_> & _solids;
+
+                            public:
+                                _SolidFlags(PackedSolidData<lbm_lattice_types::D2Q9, DT_> & solids) :
+                                    _solids(solids)
+                                {
+                                }
+
+                                void set_line(unsigned long i)
+                                {
+                                    (*_solids.line_flags)[i] = true;
+                                }
+
+                                bool line(unsigned long i) const
+                                {
+                                    return (*_solids.line_flags)[i];
+                                }
+
+                                void set_boundary(unsigned long i)
+                                {
+                                    (*_solids.boundary_flags)[i] = true;
+                                }
+
+                                void set_solid(unsigned long i, bool value)
+                                {
+                                    (*_solids.solid_flags)[i] = value;
+                                    (*_solids.boundary_flags)[i] = value ? false : (*_solids.boundary_flags)[i];
+                                }
+                        };
+
+                    /// Flag target collecting the next footprint of a SolidFootprint.
+                    class _FootprintFlags
+                    {
+                        private:
+                            SolidFootprint & _footprint;
+
+                        public:
+                            _FootprintFlags(SolidFootprint & footprint) :
+                                _footprint(footprint)
+                            {
+                            }
+
+                            void set_line(unsigned long i)
+                            {
+                                _footprint._set(_footprint._line, i, true);
+                            }
+
+                            bool line(unsigned long i) const
+                            {
+                                return _footprint._get(_footprint._line, i);
+                            }
+
+                            void set_boundary(unsigned long i)
+                            {
+                                _footprint._set(_footprint._boundary, i, true);
+                            }
+
+                            void set_solid(unsigned long i, bool value)
+                            {
+                                // several solids share one footprint, so the fill never clears solid cells
+                                if (value)
+                                {
+                                    _footprint._set(_footprint._solid, i, true);
+                                    _footprint._set(_footprint._boundary, i, false);
+                                }
+                            }
+                    };
+
 
                     template <typename DT_>
                         static inline signed long _signum(DT_ x)
@@ -54,10 +273,10 @@ namespace honei
                             return (signed long)(coord / delta);
                         }
 
-                    template <typename DT_>
+                    template <typename DT_, typename Flags_>
                         static inline void _flag_line_neighbours(PackedGridInfo<lbm_lattice_types::D2Q9> & info,
                                                                  HONEI_UNUSED PackedGridData<lbm_lattice_types::D2Q9, DT_> & data,
-                                                                 PackedSolidData<lbm_lattice_types::D2Q9, DT_> & solids,
+                                                                 Flags_ & flags,
                                                                  unsigned long packed_index)
                         {
                             unsigned long nb_1(((*info.cuda_dir_1)[packed_index] != ULONG_MAX) ? (*info.cuda_dir_1)[packed_index] : packed_index);
@@ -69,21 +288,21 @@ namespace honei
                             unsigned long nb_7(((*info.cuda_dir_7)[packed_index] != ULONG_MAX) ? (*info.cuda_dir_7)[packed_index] : packed_index);
                             unsigned long nb_8(((*info.cuda_dir_8)[packed_index] != ULONG_MAX) ? (*info.cuda_dir_8)[packed_index] : packed_index);
 
-                            (*solids.boundary_flags)[nb_1] = true;
-                            (*solids.boundary_flags)[nb_2] = true;
-                            (*solids.boundary_flags)[nb_3] = true;
-                            (*solids.boundary_flags)[nb_4] = true;
-                            (*solids.boundary_flags)[nb_5] = true;
-                            (*solids.boundary_flags)[nb_6] = true;
-                            (*solids.boundary_flags)[nb_7] = true;
-                            (*solids.boundary_flags)[nb_8] = true;
+                            flags.set_boundary(nb_1);
+                            flags.set_boundary(nb_2);
+                            flags.set_boundary(nb_3);
+                            flags.set_boundary(nb_4);
+                            flags.set_boundary(nb_5);
+                            flags.set_boundary(nb_6);
+                            flags.set_boundary(nb_7);
+                            flags.set_boundary(nb_8);
                         }
 
-                    template <typename DT_>
+                    template <typename DT_, typename Flags_>
                     static void _clamp(Grid<D2Q9, DT_> & grid,
                                        PackedGridInfo<lbm_lattice_types::D2Q9> & info,
                                        PackedGridData<lbm_lattice_types::D2Q9, DT_> & data,
-                                       PackedSolidData<lbm_lattice_types::D2Q9, DT_> & solids,
+                                       Flags_ & flags,
                                        signed long i,
                                        signed long j)
                     {
@@ -96,15 +315,15 @@ namespace honei
                         unsigned long target_y(north ? 0ul : south ? grid.h->rows() - 1 : (unsigned long)i);
 
                         unsigned long packed_index(GridPacker<D2Q9, lbm_boundary_types::NOSLIP, DT_>::h_index(grid, target_y, target_x));
-                        _flag_line_neighbours(info, data, solids, packed_index);
+                        _flag_line_neighbours(info, data, flags, packed_index);
                     }
 
 
-                    template <typename DT_>
+                    template <typename DT_, typename Flags_>
                         static void _rasterize_line(Grid<D2Q9, DT_> & grid,
                                                     PackedGridInfo<lbm_lattice_types::D2Q9> & info,
                                                     PackedGridData<lbm_lattice_types::D2Q9, DT_> & data,
-                                                    PackedSolidData<lbm_lattice_types::D2Q9, DT_> & solids,
+                                                    Flags_ & flags,
                                                     Line<DT_, lbm_solid_dims::D2> & line)
                         {
                             DT_ dx(grid.d_x);
@@ -146,8 +365,8 @@ namespace honei
                             ///Set start pixel and begin loop:
                             if(y < (signed long)grid.h->rows() && x < (signed long)grid.h->columns() && x >= 0 && y >= 0)
                             {
-                                (*solids.line_flags)[GridPacker<D2Q9, lbm_boundary_types::NOSLIP, DT_>::h_index(grid, y, x)] = true;
-                                _flag_line_neighbours(info, data, solids, GridPacker<D2Q9, lbm_boundary_types::NOSLIP, DT_>::h_index(grid, y, x));
+                                flags.set_line(GridPacker<D2Q9, lbm_boundary_types::NOSLIP, DT_>::h_index(grid, y, x));
+                                _flag_line_neighbours(info, data, flags, GridPacker<D2Q9, lbm_boundary_types::NOSLIP, DT_>::h_index(grid, y, x));
                             }
 
                             for(signed long i(0) ; i < e_l ; ++i)
@@ -166,21 +385,21 @@ namespace honei
                                 }
                                 if(y < (signed long)grid.h->rows() && x < (signed long)grid.h->columns() && x >= 0 && y >= 0)
                                 {
-                                    (*solids.line_flags)[GridPacker<D2Q9, lbm_boundary_types::NOSLIP, DT_>::h_index(grid, y, x)] = true;
-                                    _flag_line_neighbours(info, data, solids, GridPacker<D2Q9, lbm_boundary_types::NOSLIP, DT_>::h_index(grid, y, x));
+                                    flags.set_line(GridPacker<D2Q9, lbm_boundary_types::NOSLIP, DT_>::h_index(grid, y, x));
+                                    _flag_line_neighbours(info, data, flags, GridPacker<D2Q9, lbm_boundary_types::NOSLIP, DT_>::h_index(grid, y, x));
                                 }
                                 else
                                 {
-                                    _clamp(grid, info, data, solids, y, x);
+                                    _clamp(grid, info, data, flags, y, x);
                                 }
                             }
                         }
 
-                    template <typename DT_>
+                    template <typename DT_, typename Flags_>
                         static void _local_scan_fill(Grid<D2Q9, DT_> & grid,
                                                      HONEI_UNUSED PackedGridInfo<lbm_lattice_types::D2Q9> & info,
                                                      HONEI_UNUSED PackedGridData<lbm_lattice_types::D2Q9, DT_> & data,
-                                                     PackedSolidData<lbm_lattice_types::D2Q9, DT_> & solids,
+                                                     Flags_ & flags,
                                                      Polygon<DT_, lbm_solid_dims::D2> & polygon,
                                                      bool rect)
                         {
@@ -226,7 +445,7 @@ namespace honei
                             {
                                 for(unsigned long j(j_start); j <= j_end ; ++j)
                                 {
-                                    bool e_1((*solids.line_flags)[GridPacker<D2Q9, lbm_boundary_types::NOSLIP, DT_>::h_index(grid, i, j)]);
+                                    bool e_1(flags.line(GridPacker<D2Q9, lbm_boundary_types::NOSLIP, DT_>::h_index(grid, i, j)));
                                     bool e_2(j - j_start == 1);
 
                                     bool a_t( (a & b & !e_1 & !e_2) |
@@ -276,8 +495,7 @@ namespace honei
                                             );
 
                                     unsigned long packed_index(GridPacker<D2Q9, lbm_boundary_types::NOSLIP, DT_>::h_index(grid, i, j));
-                                    (*solids.solid_flags)[packed_index] = a_t;
-                                    (*solids.boundary_flags)[packed_index] = a_t ? false : (*solids.boundary_flags)[packed_index];
+                                    flags.set_solid(packed_index, a_t);
 
                                     a = a_t;
                                     b = b_t;
@@ -313,15 +531,17 @@ namespace honei
 
                             grid.h->lock(lm_read_only);
 
+                            _SolidFlags<DT_> flags(solids);
+
 
                             ///For all lines: Rasterize line with Bresenhams algo:
                             for(unsigned long i(0) ; i < solid.line_count ; ++i)
                             {
-                                _rasterize_line(grid, info, data, solids, solid.lines[i]);
+                                _rasterize_line(grid, info, data, flags, solid.lines[i]);
                             }
 
                             ///Fill Polygon:
-                            _local_scan_fill(grid, info, data, solids, solid, rect);
+                            _local_scan_fill(grid, info, data, flags, solid, rect);
 
                             solids.line_flags->unlock(lm_read_and_write);
                             solids.boundary_flags->unlock(lm_read_and_write);
@@ -339,6 +559,95 @@ namespace honei
 
                             grid.h->unlock(lm_read_only);
                         }
+
+                    /**
+                     * Incremental scan conversion of a set of solids.
+                     *
+                     * Rasterises the given polygons into the next footprint and writes only those
+                     * line, boundary and solid flags that differ from the previous call with the same
+                     * footprint, so the cost is proportional to the size of the solids instead of the
+                     * size of the domain. The first call with a fresh (or reset) footprint clears all
+                     * flags. Cells of overlapping solids count as solid for all of them.
+                     *
+                     * \param polygons The solids at the current time step.
+                     * \param rect Whether all solids are rectangular.
+                     * \param footprint The flags of the previous call, updated in place.
+                     */
+                    template<typename DT_>
+                        static void value(Grid<D2Q9, DT_> & grid,
+                                          PackedGridInfo<lbm_lattice_types::D2Q9> & info,
+                                          PackedGridData<lbm_lattice_types::D2Q9, DT_> & data,
+                                          PackedSolidData<lbm_lattice_types::D2Q9, DT_> & solids,
+                                          std::vector<Polygon<DT_, lbm_solid_dims::D2> *> & polygons,
+                                          bool rect,
+                                          SolidFootprint & footprint)
+                        {
+                            if (footprint._size != solids.solid_flags->size())
+                            {
+                                footprint._allocate(solids.solid_flags->size());
+                                fill<tags::CPU>((*solids.line_flags));
+                                fill<tags::CPU>((*solids.boundary_flags));
+                                fill<tags::CPU>((*solids.solid_flags));
+                            }
+
+                            info.cuda_dir_1->lock(lm_read_only);
+                            info.cuda_dir_2->lock(lm_read_only);
+                            info.cuda_dir_3->lock(lm_read_only);
+                            info.cuda_dir_4->lock(lm_read_only);
+                            info.cuda_dir_5->lock(lm_read_only);
+                            info.cuda_dir_6->lock(lm_read_only);
+                            info.cuda_dir_7->lock(lm_read_only);
+                            info.cuda_dir_8->lock(lm_read_only);
+                            grid.h->lock(lm_read_only);
+
+                            _FootprintFlags flags(footprint);
+                            for (typename std::vector<Polygon<DT_, lbm_solid_dims::D2> *>::iterator p(polygons.begin()), p_end(polygons.end()) ; p != p_end ; ++p)
+                            {
+                                ///For all lines: Rasterize line with Bresenhams algo:
+                                for(unsigned long i(0) ; i < (*p)->line_count ; ++i)
+                                {
+                                    _rasterize_line(grid, info, data, flags, (*p)->lines[i]);
+                                }
+
+                                ///Fill Polygon:
+                                _local_scan_fill(grid, info, data, flags, **p, rect);
+                            }
+
+                            info.cuda_dir_1->unlock(lm_read_only);
+                            info.cuda_dir_2->unlock(lm_read_only);
+                            info.cuda_dir_3->unlock(lm_read_only);
+                            info.cuda_dir_4->unlock(lm_read_only);
+                            info.cuda_dir_5->unlock(lm_read_only);
+                            info.cuda_dir_6->unlock(lm_read_only);
+                            info.cuda_dir_7->unlock(lm_read_only);
+                            info.cuda_dir_8->unlock(lm_read_only);
+                            grid.h->unlock(lm_read_only);
+
+                            ///Write changed flags only:
+                            solids.line_flags->lock(lm_read_and_write);
+                            solids.boundary_flags->lock(lm_read_and_write);
+                            solids.solid_flags->lock(lm_read_and_write);
+
+                            footprint._commit(*solids.line_flags, *solids.boundary_flags, *solids.solid_flags);
+
+                            solids.line_flags->unlock(lm_read_and_write);
+                            solids.boundary_flags->unlock(lm_read_and_write);
+                            solids.solid_flags->unlock(lm_read_and_write);
+                        }
+
+                    /// Incremental scan conversion of a single solid, see above.
+                    template<typename DT_>
+                        static void value(Grid<D2Q9, DT_> & grid,
+                                          PackedGridInfo<lbm_lattice_types::D2Q9> & info,
+                                          PackedGridData<lbm_lattice_types::D2Q9, DT_> & data,
+                                          PackedSolidData<lbm_lattice_types::D2Q9, DT_> & solids,
+                                          Polygon<DT_, lbm_solid_dims::D2> & solid,
+                                          bool rect,
+                                          SolidFootprint & footprint)
+                        {
+                            std::vector<Polygon<DT_, lbm_solid_dims::D2> *> polygons(1, &solid);
+                            value(grid, info, data, solids, polygons, rect, footprint);
+                        }
             };
     }
 }
@@ -101,3 +101,80 @@ class ScanConversionFSITest :
 
 };
 ScanConversionFSITest<tags::CPU, float> solver_test_float("float");
+
+template <typename Tag_, typename DataType_>
+class ScanConversionFSIIncrementalTest :
+    public TaggedTest<Tag_>
+{
+    public:
+        ScanConversionFSIIncrementalTest(const std::string & type) :
+            TaggedTest<Tag_>("scan_conversion_fsi_incremental_test<" + type + ">")
+        {
+        }
+
+        virtual void run() const
+        {
+            unsigned long g_h(50);
+            unsigned long g_w(50);
+
+            Grid<D2Q9, DataType_> grid;
+            ScenarioCollection::get_scenario(0, g_h, g_w, grid);
+
+            PackedGridData<D2Q9, DataType_>  data;
+            PackedSolidData<D2Q9, DataType_>  solids;
+            PackedSolidData<D2Q9, DataType_>  solids_full;
+            PackedGridInfo<D2Q9> info;
+
+            DenseMatrix<bool> line(g_h, g_w, false);
+            DenseMatrix<bool> bound(g_h, g_w, false);
+            DenseMatrix<bool> stf(g_h, g_w, false);
+            DenseMatrix<bool> sol(g_h, g_w, false);
+
+            GridPacker<D2Q9, NOSLIP, DataType_>::pack(grid, info, data);
+            GridPacker<D2Q9, lbm_boundary_types::NOSLIP, DataType_>::cuda_pack(info, data);
+            GridPackerFSI<D2Q9, NOSLIP, DataType_>::allocate(data, solids);
+            GridPackerFSI<D2Q9, NOSLIP, DataType_>::pack(grid, data, solids, line, bound, stf, sol, *grid.obstacles);
+            GridPackerFSI<D2Q9, NOSLIP, DataType_>::allocate(data, solids_full);
+            GridPackerFSI<D2Q9, NOSLIP, DataType_>::pack(grid, data, solids_full, line, bound, stf, sol, *grid.obstacles);
+
+            SolidFootprint footprint;
+            // move a square across the domain, partly leaving it at the end
+            for (unsigned long t(0) ; t < 40 ; ++t)
+            {
+                DataType_ x(DataType_(5) + DataType_(t) * DataType_(1.25));
+                DataType_ y(DataType_(20) + DataType_(t) * DataType_(0.5));
+                Line<DataType_, lbm_solid_dims::D2> line_1(x * grid.d_x, y * grid.d_y, (x + 5) * grid.d_x, y * grid.d_y);
+                Line<DataType_, lbm_solid_dims::D2> line_2((x + 5) * grid.d_x, y * grid.d_y, (x + 5) * grid.d_x, (y + 5) * grid.d_y);
+                Line<DataType_, lbm_solid_dims::D2> line_3((x + 5) * grid.d_x, (y + 5) * grid.d_y, x * grid.d_x, (y + 5) * grid.d_y);
+                Line<DataType_, lbm_solid_dims::D2> line_4(x * grid.d_x, (y + 5) * grid.d_y, x * grid.d_x, y * grid.d_y);
+
+                Polygon<DataType_, lbm_solid_dims::D2> square(4);
+                square.add_line(line_1);
+                square.add_line(line_2);
+                square.add_line(line_3);
+                square.add_line(line_4);
+                square.value();
+
+                ScanConversionFSI<Tag_>::value(grid, info, data, solids, square, true, footprint);
+                ScanConversionFSI<Tag_>::value(grid, info, data, solids_full, square, true);
+
+                unsigned long solid_count(0);
+                for (unsigned long i(0) ; i < data.h->size() ; ++i)
+                {
+                    TEST_CHECK_EQUAL((*solids.line_flags)[i], (*solids_full.line_flags)[i]);
+                    TEST_CHECK_EQUAL((*solids.boundary_flags)[i], (*solids_full.boundary_flags)[i]);
+                    TEST_CHECK_EQUAL((*solids.solid_flags)[i], (*solids_full.solid_flags)[i]);
+                    solid_count += (*solids_full.solid_flags)[i] ? 1 : 0;
+                }
+                TEST_CHECK_EQUAL(footprint.solid_count(), solid_count);
+            }
+
+            solids.destroy();
+            solids_full.destroy();
+            grid.destroy();
+            data.destroy();
+            info.destroy();
+        }
+};
+ScanConversionFSIIncrementalTest<tags::CPU, float> incremental_test_float("float");
+ScanConversionFSIIncrementalTest<tags::CPU, double> incremental_test_double("double");
@@ -19,8 +19,8 @@
 
 
 #pragma once
-#ifndef LBM_GUARD_SOLVER_LBM_GRID_HH
-#define LBM_GUARD_SOLVER_LBM_GRID_HH 1
+#ifndef LBM_GUARD_SOLVER_LBM_FSI_HH
+#define LBM_GUARD_SOLVER_LBM_FSI_HH 1
 
 /**
  * \file
@@ -63,6 +63,7 @@
 #include <honei/backends/multicore/thread_pool.hh>
 
 #include <iostream>
+#include <honei/util/tr1_boost.hh>
 #include <vector>
 
 using namespace honei::lbm;
@@ -139,7 +140,44 @@ namespace honei
                     CONTEXT("When destroying LBM FSI solver.");
                 }
 
+                /// Return the number of time steps computed so far.
+                unsigned long time() const
+                {
+                    return _time;
+                }
+
+                /// Set the time step counter, e.g. on restart from a checkpoint (see GridCheckpoint).
+                void set_time(unsigned long time)
+                {
+                    _time = time;
+                }
+
                 void do_preprocessing()
+                {
+                    preprocessing_collide_stream();
+                    fsi_step();
+
+#ifdef SOLVER_VERBOSE
+                    std::cout << "h after preprocessing:" << std::endl;
+                    std::cout << *_data->h << std::endl;
+#endif
+                }
+
+                void do_postprocessing()
+                {
+                }
+
+                /**
+                 * \name Partial time steps
+                 *
+                 * do_preprocessing() and solve() split into the parts between which a partitioned
+                 * solver has to exchange halo data, see mc::SolverLBMFSI.
+                 *
+                 * \{
+                 */
+
+                /// Initial equilibrium, collision and streaming, without the FSI correction.
+                void preprocessing_collide_stream()
                 {
                     CONTEXT("When performing LBM FSI preprocessing.");
 
@@ -180,24 +218,10 @@ namespace honei
                         value(*_info,
                               *_data,
                               _relaxation_time);
-                    CollideStreamFSI<Tag_, lbm_boundary_types::NOSLIP, lbm_lattice_types::D2Q9>::
-                        value(*_info, *_data, *_solids, _delta_x, _delta_y);
-
-#ifdef SOLVER_VERBOSE
-                    std::cout << "h after preprocessing:" << std::endl;
-                    std::cout << *_data->h << std::endl;
-#endif
                 }
 
-                void do_postprocessing()
-                {
-                }
-
-
-                /** Capsule for the solution: Single step time marching.
-                 *
-                 **/
-                void solve(unsigned long dir)
+                /// Source terms, boundary correction and extraction of h, u and v.
+                void extraction_step()
                 {
                     ForceGrid<Tag_, Application_, Force_, SourceScheme_>::value(*_info, *_data, ResPrec_(9.81), _delta_x, _delta_y, _delta_t, ResPrec_(0.01));
 
@@ -209,7 +233,11 @@ namespace honei
                     ExtractionGrid<Tag_, LbmMode_>::value(*_info, *_data, ResPrec_(10e-5));
 
                     ++_time;
+                }
 
+                /// Re-initialisation of cells the solid moved over, equilibrium, collision and streaming.
+                void collide_stream_step(unsigned long dir)
+                {
                     switch(dir)
                     {
                         case 1:
@@ -260,10 +288,207 @@ namespace honei
                         value(*_info,
                               *_data,
                               _relaxation_time);
+                }
+
+                /// Bounce back of the streamed populations at the solid.
+                void fsi_step()
+                {
                     CollideStreamFSI<Tag_, lbm_boundary_types::NOSLIP, lbm_lattice_types::D2Q9>::
                         value(*_info, *_data, *_solids, _delta_x, _delta_y);
                 }
 
+                /// \}
+
+                /** Capsule for the solution: Single step time marching.
+                 *
+                 **/
+                void solve(unsigned long dir)
+                {
+                    extraction_step();
+                    collide_stream_step(dir);
+                    fsi_step();
+                }
+        };
+
+    namespace mc
+    {
+        template<typename Tag_,
+            typename Application_,
+            typename ResPrec_,
+            typename Force_,
+            typename SourceScheme_,
+            typename GridType_,
+            typename LatticeType_,
+            typename BoundaryType_,
+            typename LbmMode_>
+                class SolverLBMFSI
+                {
+                };
+
+        /**
+         * \brief Partitioned LBM FSI solver.
+         *
+         * Decomposes the grid and the solid data with GridPartitioner and runs the partial time steps
+         * of one SolverLBMFSI per patch on its own core. Between the partial steps the halos are
+         * exchanged: h, u and v before the boundary initialisation, the streamed populations before
+         * the FSI correction and the bounced back populations after it.
+         *
+         * The patches carry a halo of three grid rows, so that the extrapolation of BoundaryInitFSI
+         * sees the same cells as in the single core solver. The solid geometry is taken from the
+         * global solid data at every time step, so scan conversions keep operating on the global
+         * objects. The global info is cuda packed on construction, if this has not happened yet.
+         *
+         * \ingroup grpliblbm
+         */
+        template<typename Tag_, typename Application_, typename ResPrec_, typename Force_, typename SourceScheme_, typename LbmMode_>
+            class SolverLBMFSI<Tag_, Application_, ResPrec_, Force_, SourceScheme_, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, LbmMode_>
+            {
+                private:
+                    typedef honei::SolverLBMFSI<typename Tag_::DelegateTo, Application_, ResPrec_, Force_, SourceScheme_, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, LbmMode_> PatchSolver;
+
+                    unsigned long _parts;
+                    PackedGridInfo<D2Q9> * _info;
+                    PackedGridData<D2Q9, ResPrec_> * _data;
+                    PackedSolidData<D2Q9, ResPrec_> * _solids;
+                    std::vector<PackedGridInfo<D2Q9> > _info_list;
+                    std::vector<PackedGridData<D2Q9, ResPrec_> > _data_list;
+                    std::vector<PackedSolidData<D2Q9, ResPrec_> > _solids_list;
+                    std::vector<PackedGridFringe<D2Q9> > _fringe_list;
+                    std::vector<PatchSolver *> _solver_list;
+                    std::vector<Ticket<tags::CPU::MultiCore> > _tickets;
+
+                    /// Run one partial time step on all patches.
+                    void _run(void (PatchSolver::* step)())
+                    {
+                        TicketVector tickets;
+                        for (unsigned long i(0) ; i < _parts ; ++i)
+                        {
+                            tickets.push_back(mc::ThreadPool::instance()->enqueue(
+                                        bind(mem_fn(step), _solver_list.at(i)),
+                                        DispatchPolicy::same_core_as(_tickets.at(i))));
+                        }
+                        tickets.wait();
+                    }
+
+                    void _run(void (PatchSolver::* step)(unsigned long), unsigned long dir)
+                    {
+                        TicketVector tickets;
+                        for (unsigned long i(0) ; i < _parts ; ++i)
+                        {
+                            tickets.push_back(mc::ThreadPool::instance()->enqueue(
+                                        bind(mem_fn(step), _solver_list.at(i), dir),
+                                        DispatchPolicy::same_core_as(_tickets.at(i))));
+                        }
+                        tickets.wait();
+                    }
+
+                    /// Streaming halo exchange and FSI correction.
+                    void _fsi_step()
+                    {
+                        GridPartitioner<D2Q9, ResPrec_>::synch(*_info, *_data, _info_list, _data_list, _fringe_list);
+                        GridPartitioner<D2Q9, ResPrec_>::synch_temp_halo(_info_list, _data_list, _fringe_list);
+                        _run(&PatchSolver::fsi_step);
+                        GridPartitioner<D2Q9, ResPrec_>::synch_fsi(_info_list, _data_list, _solids_list, _fringe_list);
+                    }
+
+                public:
+                    SolverLBMFSI(PackedGridInfo<D2Q9> * info,
+                                 PackedGridData<D2Q9, ResPrec_> * data,
+                                 PackedSolidData<D2Q9, ResPrec_> * solids,
+                                 ResPrec_ dx,
+                                 ResPrec_ dy,
+                                 ResPrec_ dt,
+                                 ResPrec_ rel_time) :
+                        _info(info),
+                        _data(data),
+                        _solids(solids)
+                    {
+                        CONTEXT("When creating partitioned LBM FSI solver:");
+                        _parts = Configuration::instance()->get_value("mc::SolverLBMFSI::patch_count", 4ul);
+
+                        if (_info->cuda_dir_1 == 0)
+                            GridPacker<D2Q9, lbm_boundary_types::NOSLIP, ResPrec_>::cuda_pack(*_info, *_data);
+
+                        // BoundaryInitFSI extrapolates from up to three cells, so the halo must reach three rows
+                        unsigned long row(0);
+                        for (unsigned long i(0) ; i < _info->cuda_dir_3->size() ; ++i)
+                        {
+                            unsigned long neighbour((*_info->cuda_dir_3)[i]);
+                            if (neighbour != std::numeric_limits<unsigned long>::max())
+                                row = std::max(row, neighbour > i ? neighbour - i : i - neighbour);
+                        }
+                        GridPartitioner<D2Q9, ResPrec_>::decompose(_parts, *_info, *_data, _info_list, _data_list, _fringe_list, true, 2 * (row + 1));
+                        _parts = _info_list.size();
+                        GridPartitioner<D2Q9, ResPrec_>::decompose_neighbours(*_info, _info_list, _data_list);
+                        GridPartitioner<D2Q9, ResPrec_>::decompose_solids(*_solids, _info_list, _data_list, _solids_list);
+
+                        for(unsigned long i(0) ; i < _parts ; ++i)
+                        {
+                            _solver_list.push_back(new PatchSolver(&_info_list[i], &_data_list[i], &_solids_list[i], dx, dy, dt, rel_time));
+                        }
+                    }
+
+                    virtual ~SolverLBMFSI()
+                    {
+                        CONTEXT("When destroying partitioned LBM FSI solver.");
+                        for (unsigned long i(0) ; i < _parts ; ++i)
+                            delete _solver_list.at(i);
+
+                        GridPartitioner<D2Q9, ResPrec_>::destroy(_info_list, _data_list, _fringe_list);
+                        GridPartitioner<D2Q9, ResPrec_>::destroy_solids(_solids_list);
+                    }
+
+                    void do_preprocessing()
+                    {
+                        CONTEXT("When performing partitioned LBM FSI preprocessing.");
+
+                        TicketVector tickets;
+                        for (unsigned long i(0) ; i < _parts ; ++i)
+                        {
+                            _tickets.push_back(mc::ThreadPool::instance()->enqueue(
+                                        bind(
+                                            GridPartitioner<D2Q9, ResPrec_>::recompose, &_info_list.at(i), &_data_list.at(i)),
+                                            DispatchPolicy::on_core(i)));
+                            tickets.push_back(_tickets.at(i));
+                        }
+                        tickets.wait();
+
+                        GridPartitioner<D2Q9, ResPrec_>::synch_solids(*_solids, _info_list, _solids_list);
+                        _run(&PatchSolver::preprocessing_collide_stream);
+                        _fsi_step();
+                    }
+
+                    void do_postprocessing()
+                    {
+                        _run(&PatchSolver::do_postprocessing);
+                        GridPartitioner<D2Q9, ResPrec_>::compose(*_info, *_data, _info_list, _data_list);
+                        GridPartitioner<D2Q9, ResPrec_>::compose_solids(*_solids, _info_list, _solids_list);
+                    }
+
+                    /** Capsule for the solution: Single step time marching.
+                     *
+                     **/
+                    void solve(unsigned long dir)
+                    {
+                        GridPartitioner<D2Q9, ResPrec_>::synch_solids(*_solids, _info_list, _solids_list);
+                        _run(&PatchSolver::extraction_step);
+                        GridPartitioner<D2Q9, ResPrec_>::synch_velocities(_info_list, _data_list, _fringe_list);
+                        _run(&PatchSolver::collide_stream_step, dir);
+                        _fsi_step();
+                    }
+            };
+    }
+
+    template<typename Application_, typename ResPrec_, typename Force_, typename SourceScheme_, typename LbmMode_>
+        class SolverLBMFSI<tags::CPU::MultiCore, Application_, ResPrec_, Force_, SourceScheme_, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, LbmMode_> :
+        public mc::SolverLBMFSI<tags::CPU::MultiCore, Application_, ResPrec_, Force_, SourceScheme_, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, LbmMode_>
+        {
+            public:
+                SolverLBMFSI(PackedGridInfo<D2Q9> * info, PackedGridData<D2Q9, ResPrec_> * data, PackedSolidData<D2Q9, ResPrec_> * solids,
+                        ResPrec_ dx, ResPrec_ dy, ResPrec_ dt, ResPrec_ rel_time):
+                    mc::SolverLBMFSI<tags::CPU::MultiCore, Application_, ResPrec_, Force_, SourceScheme_, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, LbmMode_>(info, data, solids, dx, dy, dt, rel_time)
+            {
+            }
         };
 }
 #endif
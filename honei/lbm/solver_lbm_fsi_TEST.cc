@@ -923,3 +923,96 @@ class SolverLBMFSITest_MC_6 :
 };
 //SolverLBMFSITest_MC_6<tags::GPU::CUDA, float> solver_test_float_mc6("float", 1ul);
 
+
+template <typename Tag_, typename DataType_>
+class SolverLBMFSIPartitionedTest :
+    public TaggedTest<Tag_>
+{
+    private:
+        DataType_ _eps;
+
+        template <typename SolverTag_>
+        static void _solve(Grid<D2Q9, DataType_> & grid, unsigned long timesteps)
+        {
+            unsigned long g_h(grid.h->rows());
+            unsigned long g_w(grid.h->columns());
+
+            PackedGridData<D2Q9, DataType_>  data;
+            PackedSolidData<D2Q9, DataType_>  solids;
+            PackedGridInfo<D2Q9> info;
+
+            DenseMatrix<bool> line(g_h, g_w, false);
+            DenseMatrix<bool> bound(g_h, g_w, false);
+            DenseMatrix<bool> stf(g_h, g_w, false);
+            DenseMatrix<bool> sol(g_h, g_w, false);
+
+            GridPacker<D2Q9, NOSLIP, DataType_>::pack(grid, info, data);
+            GridPacker<D2Q9, lbm_boundary_types::NOSLIP, DataType_>::cuda_pack(info, data);
+            GridPackerFSI<D2Q9, NOSLIP, DataType_>::allocate(data, solids);
+            GridPackerFSI<D2Q9, NOSLIP, DataType_>::pack(grid, data, solids, line, bound, stf, sol, *grid.obstacles);
+
+            SolverLBMFSI<SolverTag_, lbm_applications::LABSWE, DataType_,lbm_force::CENTRED, lbm_source_schemes::BED_FULL, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, lbm_modes::DRY> solver(&info, &data, &solids, grid.d_x, grid.d_y, grid.d_t, grid.tau);
+
+            solids.current_u = DataType_(1./2.* grid.d_x);
+            solids.current_v = DataType_(1./2.* grid.d_y);
+            for(unsigned long i(0); i <= timesteps; ++i)
+            {
+                // the solid moves diagonally across the patch boundaries of the partitioned solver
+                Line<DataType_, lbm_solid_dims::D2> line_1_i(DataType_(5.+ i/2.) * grid.d_x, DataType_(5.+ i/2.) * grid.d_y, DataType_(10.+ i/2.)* grid.d_x, DataType_(5.+ i/2.) * grid.d_y);
+                Line<DataType_, lbm_solid_dims::D2> line_2_i(DataType_(10.+ i/2.)* grid.d_x, DataType_(5.+ i/2.) * grid.d_y, DataType_(10.+ i/2.)* grid.d_x, DataType_(10.+ i/2.) * grid.d_y);
+                Line<DataType_, lbm_solid_dims::D2> line_3_i(DataType_(10.+ i/2.)* grid.d_x, DataType_(10.+ i/2.) * grid.d_y, DataType_(5.+ i/2.)* grid.d_x, DataType_(10.+ i/2.) * grid.d_y);
+                Line<DataType_, lbm_solid_dims::D2> line_4_i(DataType_(5.+ i/2.)* grid.d_x, DataType_(10.+ i/2.) * grid.d_y, DataType_(5.+ i/2.)* grid.d_x, DataType_(5.+ i/2.) * grid.d_y);
+
+                Polygon<DataType_, lbm_solid_dims::D2> tri_i(4);
+                tri_i.add_line(line_1_i);
+                tri_i.add_line(line_2_i);
+                tri_i.add_line(line_3_i);
+                tri_i.add_line(line_4_i);
+                tri_i.value();
+                ScanConversionFSI<tags::CPU>::value(grid, info, data, solids, tri_i, true);
+
+                if (i == 0)
+                    solver.do_preprocessing();
+                else
+                    solver.solve(2ul);
+            }
+            solver.do_postprocessing();
+            GridPacker<D2Q9, NOSLIP, DataType_>::unpack(grid, info, data);
+
+            info.destroy();
+            data.destroy();
+            solids.destroy();
+        }
+
+    public:
+        SolverLBMFSIPartitionedTest(const std::string & type, DataType_ eps) :
+            TaggedTest<Tag_>("solver_lbm_fsi_partitioned_test<" + type + ">"),
+            _eps(eps)
+        {
+        }
+
+        virtual void run() const
+        {
+            unsigned long g_h(50);
+            unsigned long g_w(50);
+            unsigned long timesteps(60);
+
+            Grid<D2Q9, DataType_> grid;
+            ScenarioCollection::get_scenario(0, g_h, g_w, grid);
+            _solve<Tag_>(grid, timesteps);
+
+            Grid<D2Q9, DataType_> grid_ref;
+            ScenarioCollection::get_scenario(0, g_h, g_w, grid_ref);
+            _solve<typename Tag_::DelegateTo>(grid_ref, timesteps);
+
+            std::cout << "Solving: " << grid.description << std::endl;
+            for (unsigned long i(0) ; i < (*grid.h).rows() ; ++i)
+                for(unsigned long j(0) ; j < (*grid.h).columns() ; ++j)
+                    TEST_CHECK_EQUAL_WITHIN_EPS((*grid.h)(i, j), (*grid_ref.h)(i, j), _eps);
+
+            grid.destroy();
+            grid_ref.destroy();
+        }
+};
+SolverLBMFSIPartitionedTest<tags::CPU::MultiCore, float> mc_solver_partitioned_test_float("float", std::numeric_limits<float>::epsilon() * 1e2);
+SolverLBMFSIPartitionedTest<tags::CPU::MultiCore, double> mc_solver_partitioned_test_double("double", std::numeric_limits<double>::epsilon() * 1e2);
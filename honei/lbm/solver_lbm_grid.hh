@@ -142,6 +142,18 @@ namespace honei
                     CONTEXT("When destroying LABSWE solver.");
                 }
 
+                /// Return the number of time steps computed so far.
+                unsigned long time() const
+                {
+                    return _time;
+                }
+
+                /// Set the time step counter, e.g. on restart from a checkpoint (see GridCheckpoint).
+                void set_time(unsigned long time)
+                {
+                    _time = time;
+                }
+
                 void do_preprocessing()
                 {
                     CONTEXT("When performing LABSWE preprocessing.");
@@ -0,0 +1,233 @@
+/* vim: set number sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LBM C++ library. LBM is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LBM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#pragma once
+#ifndef LBM_GUARD_SOLVER_LBM_GRID_AA_HH
+#define LBM_GUARD_SOLVER_LBM_GRID_AA_HH 1
+
+/**
+ * \file
+ * Implementation of a SWE solver using LBM and PackedGrid with in-place (AA pattern) streaming.
+ *
+ * \ingroup grpliblbm
+ **/
+
+#include <honei/lbm/tags.hh>
+#include <honei/util/tags.hh>
+#include <honei/util/benchmark_info.hh>
+#include <honei/la/dense_vector.hh>
+#include <honei/lbm/collide_stream_grid_aa.hh>
+#include <honei/lbm/solver_lbm_grid.hh>
+#include <honei/lbm/grid.hh>
+#include <cmath>
+
+using namespace honei::lbm;
+using namespace honei::lbm::lbm_boundary_types;
+
+namespace honei
+{
+    template<typename Tag_,
+        typename Application_,
+        typename ResPrec_,
+        typename Force_,
+        typename SourceScheme_,
+        typename GridType_,
+        typename LatticeType_,
+        typename BoundaryType_,
+        typename LbmMode_>
+            class SolverLBMGridAA
+            {
+            };
+
+    /**
+     * \brief LBM grid solver with in-place streaming.
+     *
+     * Computes the same time steps as SolverLBMGrid, but keeps a single distribution set f_0 .. f_8
+     * and alternates odd and even steps of the fused CollideStreamGridAA module. The data object
+     * only needs h, b, u and v (see GridPacker::pack with alloc_all = false); missing distribution
+     * vectors are allocated and any f_eq and f_temp vectors are released on construction. Between two
+     * time steps f holds the populations in the internal layout of the AA pattern.
+     *
+     * Source terms are not supported, as they would need f_temp.
+     *
+     * \ingroup grpliblbm
+     */
+    template<typename Tag_, typename Application_, typename ResPrec_, typename LbmMode_>
+        class SolverLBMGridAA<Tag_, Application_, ResPrec_, lbm_force::NONE, lbm_source_schemes::NONE, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, LbmMode_> : public SolverLBMGridBase
+        {
+            private:
+                /** Global variables.
+                 *
+                 **/
+
+                ResPrec_ _relaxation_time, _delta_x, _delta_y, _delta_t;
+
+                unsigned long _time;
+
+                PackedGridInfo<D2Q9> * _info;
+                PackedGridData<D2Q9, ResPrec_> * _data;
+
+                /** Global constants.
+                 *
+                 **/
+                ResPrec_ _e, _gravity, _pi, _e_squared;
+
+                static void _release(DenseVector<ResPrec_> * & vector)
+                {
+                    delete vector;
+                    vector = 0;
+                }
+
+                static void _allocate(DenseVector<ResPrec_> * & vector, unsigned long size)
+                {
+                    if (vector == 0)
+                        vector = new DenseVector<ResPrec_>(size, ResPrec_(0));
+                }
+
+            public:
+                SolverLBMGridAA(PackedGridInfo<D2Q9> * info, PackedGridData<D2Q9, ResPrec_> * data, ResPrec_ dx, ResPrec_ dy, ResPrec_ dt, ResPrec_ rel_time) :
+                    _relaxation_time(rel_time),
+                    _delta_x(dx),
+                    _delta_y(dy),
+                    _delta_t(dt),
+                    _time(0),
+                    _info(info),
+                    _data(data),
+                    _gravity(9.80665),
+                    _pi(3.14159265)
+            {
+                CONTEXT("When creating in-place LABSWE solver:");
+                _e = _delta_x / _delta_t;
+                _e_squared = _e * _e;
+
+                const unsigned long size(_data->h->size());
+                _allocate(_data->f_0, size);
+                _allocate(_data->f_1, size);
+                _allocate(_data->f_2, size);
+                _allocate(_data->f_3, size);
+                _allocate(_data->f_4, size);
+                _allocate(_data->f_5, size);
+                _allocate(_data->f_6, size);
+                _allocate(_data->f_7, size);
+                _allocate(_data->f_8, size);
+                _allocate(_data->distribution_x, 9ul);
+                _allocate(_data->distribution_y, 9ul);
+
+                _release(_data->f_eq_0);
+                _release(_data->f_eq_1);
+                _release(_data->f_eq_2);
+                _release(_data->f_eq_3);
+                _release(_data->f_eq_4);
+                _release(_data->f_eq_5);
+                _release(_data->f_eq_6);
+                _release(_data->f_eq_7);
+                _release(_data->f_eq_8);
+                _release(_data->f_temp_0);
+                _release(_data->f_temp_1);
+                _release(_data->f_temp_2);
+                _release(_data->f_temp_3);
+                _release(_data->f_temp_4);
+                _release(_data->f_temp_5);
+                _release(_data->f_temp_6);
+                _release(_data->f_temp_7);
+                _release(_data->f_temp_8);
+            }
+
+                virtual ~SolverLBMGridAA()
+                {
+                    CONTEXT("When destroying in-place LABSWE solver.");
+                }
+
+                /// Return the number of time steps computed so far.
+                unsigned long time() const
+                {
+                    return _time;
+                }
+
+                /// Set the time step counter, e.g. on restart from a checkpoint (see GridCheckpoint).
+                void set_time(unsigned long time)
+                {
+                    _time = time;
+                }
+
+                void do_preprocessing()
+                {
+                    CONTEXT("When performing in-place LABSWE preprocessing.");
+
+                    (*_data->distribution_x)[0] = ResPrec_(0.);
+                    (*_data->distribution_x)[1] = ResPrec_(_e * cos(ResPrec_(0.)));
+                    (*_data->distribution_x)[2] = ResPrec_(sqrt(ResPrec_(2.)) * _e * cos(_pi / ResPrec_(4.)));
+                    (*_data->distribution_x)[3] = ResPrec_(_e * cos(_pi / ResPrec_(2.)));
+                    (*_data->distribution_x)[4] = ResPrec_(sqrt(ResPrec_(2.)) * _e * cos(ResPrec_(3.) * _pi / ResPrec_(4.)));
+                    (*_data->distribution_x)[5] = ResPrec_(_e * cos(_pi));
+                    (*_data->distribution_x)[6] = ResPrec_(sqrt(ResPrec_(2.)) * _e * cos(ResPrec_(5.) * _pi / ResPrec_(4.)));
+                    (*_data->distribution_x)[7] = ResPrec_(_e * cos(ResPrec_(3.) * _pi / ResPrec_(2.)));
+                    (*_data->distribution_x)[8] = ResPrec_(sqrt(ResPrec_(2.)) * _e * cos(ResPrec_(7.) * _pi / ResPrec_(4.)));
+                    (*_data->distribution_y)[0] = ResPrec_(0.);
+                    (*_data->distribution_y)[1] = ResPrec_(_e * sin(ResPrec_(0.)));
+                    (*_data->distribution_y)[2] = ResPrec_(sqrt(ResPrec_(2.)) * _e * sin(_pi / ResPrec_(4.)));
+                    (*_data->distribution_y)[3] = ResPrec_(_e * sin(_pi / ResPrec_(2.)));
+                    (*_data->distribution_y)[4] = ResPrec_(sqrt(ResPrec_(2.)) * _e * sin(ResPrec_(3.) * _pi / ResPrec_(4.)));
+                    (*_data->distribution_y)[5] = ResPrec_(_e * sin(_pi));
+                    (*_data->distribution_y)[6] = ResPrec_(sqrt(ResPrec_(2.)) * _e * sin(ResPrec_(5.) * _pi / ResPrec_(4.)));
+                    (*_data->distribution_y)[7] = ResPrec_(_e * sin(ResPrec_(3.) * _pi / ResPrec_(2.)));
+                    (*_data->distribution_y)[8] = ResPrec_(sqrt(ResPrec_(2.)) * _e * sin(ResPrec_(7.) * _pi / ResPrec_(4.)));
+
+                    ///Compute initial equilibrium distribution, the collision of which is the identity:
+                    EquilibriumDistributionGridAA<Tag_, Application_>::
+                        value(_gravity, _e_squared, *_info, *_data);
+
+                    _time = 0;
+                }
+
+                void do_postprocessing()
+                {
+                }
+
+
+                /** Capsule for the solution: Single step time marching.
+                 *
+                 **/
+                void solve()
+                {
+                    ++_time;
+
+                    if (_time % 2 == 1)
+                        CollideStreamGridAA<Tag_, Application_, LbmMode_, lbm_aa_steps::ODD>::
+                            value(*_info, *_data, _gravity, _e_squared, _relaxation_time, ResPrec_(10e-5));
+                    else
+                        CollideStreamGridAA<Tag_, Application_, LbmMode_, lbm_aa_steps::EVEN>::
+                            value(*_info, *_data, _gravity, _e_squared, _relaxation_time, ResPrec_(10e-5));
+                }
+
+                static LBMBenchmarkInfo get_benchmark_info(Grid<D2Q9, ResPrec_> * grid, PackedGridInfo<D2Q9> * info, PackedGridData<D2Q9, ResPrec_> * data)
+                {
+                    LBMBenchmarkInfo result;
+                    BenchmarkInfo col_stream(CollideStreamGridAA<Tag_, Application_, LbmMode_, lbm_aa_steps::ODD>::get_benchmark_info(info, data));
+                    result += col_stream;
+
+                    result.size.push_back(grid->h->rows());
+                    result.size.push_back(grid->h->columns());
+                    result.lups = grid->h->rows() * grid->h->columns();
+                    result.flups = data->h->size();
+                    return result;
+                }
+        };
+}
+#endif
@@ -0,0 +1,105 @@
+/* vim: set number sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LBM C++ library. LBM is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LBM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <honei/lbm/solver_lbm_grid_aa.hh>
+#include <honei/lbm/solver_lbm_grid.hh>
+#include <honei/lbm/grid.hh>
+#include <honei/lbm/grid_packer.hh>
+#include <honei/lbm/scenario_collection.hh>
+#include <honei/util/unittest.hh>
+#include <iostream>
+
+using namespace honei;
+using namespace tests;
+using namespace std;
+using namespace lbm::lbm_lattice_types;
+
+template <typename Tag_, typename DataType_, typename LbmMode_>
+class SolverLBMGridAATest :
+    public TaggedTest<Tag_>
+{
+    private:
+        DataType_ _eps;
+
+    public:
+        SolverLBMGridAATest(const std::string & type, DataType_ eps) :
+            TaggedTest<Tag_>("solver_lbm_grid_aa_test<" + type + ">")
+    {
+        _eps = eps;
+    }
+
+        virtual void run() const
+        {
+            for (unsigned long scen(0) ; scen < ScenarioCollection::get_stable_scenario_count() ; ++scen)
+            {
+                // odd number of steps, so the comparison covers both step kernels
+                unsigned long g_h(50);
+                unsigned long g_w(50);
+                unsigned long timesteps(101);
+
+                Grid<D2Q9, DataType_> grid;
+                ScenarioCollection::get_scenario(scen, g_h, g_w, grid);
+                PackedGridData<D2Q9, DataType_> data;
+                PackedGridInfo<D2Q9> info;
+                GridPacker<D2Q9, NOSLIP, DataType_>::pack(grid, info, data, false);
+
+                SolverLBMGridAA<Tag_, lbm_applications::LABSWE, DataType_, lbm_force::NONE, lbm_source_schemes::NONE, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, LbmMode_> solver(&info, &data, grid.d_x, grid.d_y, grid.d_t, grid.tau);
+                TEST_CHECK(data.f_0 != 0);
+                TEST_CHECK(data.f_eq_0 == 0);
+                TEST_CHECK(data.f_temp_0 == 0);
+
+                Grid<D2Q9, DataType_> grid_standard;
+                ScenarioCollection::get_scenario(scen, g_h, g_w, grid_standard);
+                PackedGridData<D2Q9, DataType_> data_standard;
+                PackedGridInfo<D2Q9> info_standard;
+                GridPacker<D2Q9, NOSLIP, DataType_>::pack(grid_standard, info_standard, data_standard);
+
+                SolverLBMGrid<tags::CPU, lbm_applications::LABSWE, DataType_, lbm_force::NONE, lbm_source_schemes::NONE, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, LbmMode_> solver_standard(&info_standard, &data_standard, grid_standard.d_x, grid_standard.d_y, grid_standard.d_t, grid_standard.tau);
+
+                solver.do_preprocessing();
+                solver_standard.do_preprocessing();
+
+                for (unsigned long i(0) ; i < timesteps ; ++i)
+                {
+                    solver.solve();
+                    solver_standard.solve();
+                }
+                solver.do_postprocessing();
+                solver_standard.do_postprocessing();
+
+                std::cout << grid.description << std::endl;
+                TEST_CHECK_EQUAL(data.h->size(), data_standard.h->size());
+                for (unsigned long i(0) ; i < data.h->size() ; ++i)
+                {
+                    TEST_CHECK_EQUAL_WITHIN_EPS((*data.h)[i], (*data_standard.h)[i], _eps);
+                    TEST_CHECK_EQUAL_WITHIN_EPS((*data.u)[i], (*data_standard.u)[i], _eps);
+                    TEST_CHECK_EQUAL_WITHIN_EPS((*data.v)[i], (*data_standard.v)[i], _eps);
+                }
+
+                grid.destroy();
+                info.destroy();
+                data.destroy();
+                grid_standard.destroy();
+                info_standard.destroy();
+                data_standard.destroy();
+            }
+        }
+};
+SolverLBMGridAATest<tags::CPU, float, lbm_modes::DRY> solver_aa_test_float("float, dry", std::numeric_limits<float>::epsilon() * 2e2);
+SolverLBMGridAATest<tags::CPU, double, lbm_modes::DRY> solver_aa_test_double("double, dry", std::numeric_limits<double>::epsilon() * 2e2);
+SolverLBMGridAATest<tags::CPU::Generic, double, lbm_modes::DRY> generic_solver_aa_test_double("double, dry", std::numeric_limits<double>::epsilon() * 2e2);
@@ -0,0 +1,245 @@
+/* vim: set number sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LBM C++ library. LBM is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LBM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#pragma once
+#ifndef LBM_GUARD_SOLVER_LBM_GRID_ACTIVE_HH
+#define LBM_GUARD_SOLVER_LBM_GRID_ACTIVE_HH 1
+
+/**
+ * \file
+ * Implementation of a SWE solver using LBM and PackedGrid that only updates the wet part of the grid.
+ *
+ * \ingroup grpliblbm
+ **/
+
+#include <honei/lbm/tags.hh>
+#include <honei/util/tags.hh>
+#include <honei/util/configuration.hh>
+#include <honei/util/benchmark_info.hh>
+#include <honei/la/dense_vector.hh>
+#include <honei/lbm/collide_stream_grid.hh>
+#include <honei/lbm/equilibrium_distribution_grid.hh>
+#include <honei/lbm/force_grid.hh>
+#include <honei/lbm/update_velocity_directions_grid.hh>
+#include <honei/lbm/extraction_grid.hh>
+#include <honei/lbm/solver_lbm_grid.hh>
+#include <honei/lbm/grid_tiler.hh>
+#include <honei/lbm/grid.hh>
+#include <cmath>
+#include <vector>
+
+using namespace honei::lbm;
+using namespace honei::lbm::lbm_boundary_types;
+
+namespace honei
+{
+    template<typename Tag_,
+        typename Application_,
+        typename ResPrec_,
+        typename Force_,
+        typename SourceScheme_,
+        typename GridType_,
+        typename LatticeType_,
+        typename BoundaryType_,
+        typename LbmMode_>
+            class SolverLBMGridActive
+            {
+            };
+
+    /**
+     * \brief LBM grid solver restricted to the wet part of the domain.
+     *
+     * Computes the same time steps as SolverLBMGrid, but cuts the packed grid into tiles (see
+     * GridTiler) and runs every grid kernel on the active tiles only: those holding water and
+     * their neighbours. The active set is updated from h at the start of every time step, so the
+     * cost of a step follows the wet area instead of the whole domain. Cells in inactive tiles
+     * are kept at the dry state h = u = v = 0 with vanishing distributions.
+     *
+     * The number of cells per tile is read from "SolverLBMGridActive::tile_size".
+     *
+     * \ingroup grpliblbm
+     */
+    template<typename Tag_, typename Application_, typename ResPrec_, typename Force_, typename SourceScheme_, typename LbmMode_>
+        class SolverLBMGridActive<Tag_, Application_, ResPrec_, Force_, SourceScheme_, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, LbmMode_> : public SolverLBMGridBase
+        {
+            private:
+                /** Global variables.
+                 *
+                 **/
+
+                ResPrec_ _relaxation_time, _delta_x, _delta_y, _delta_t;
+
+                unsigned long _time;
+
+                PackedGridInfo<D2Q9> * _info;
+                PackedGridData<D2Q9, ResPrec_> * _data;
+                PackedGridTiles<D2Q9> _tiles;
+
+                /** Global constants.
+                 *
+                 **/
+                ResPrec_ _e, _gravity, _pi, _e_squared, _epsilon;
+
+                static void _swap(DenseVector<ResPrec_> * & a, DenseVector<ResPrec_> * & b)
+                {
+                    DenseVector<ResPrec_> * swap(a);
+                    a = b;
+                    b = swap;
+                }
+
+            public:
+                SolverLBMGridActive(PackedGridInfo<D2Q9> * info, PackedGridData<D2Q9, ResPrec_> * data, ResPrec_ dx, ResPrec_ dy, ResPrec_ dt, ResPrec_ rel_time) :
+                    _relaxation_time(rel_time),
+                    _delta_x(dx),
+                    _delta_y(dy),
+                    _delta_t(dt),
+                    _time(0),
+                    _info(info),
+                    _data(data),
+                    _gravity(9.80665),
+                    _pi(3.14159265),
+                    _epsilon(10e-5)
+            {
+                CONTEXT("When creating active set LABSWE solver:");
+                _e = _delta_x / _delta_t;
+                _e_squared = _e * _e;
+
+                unsigned long tile_size(Configuration::instance()->get_value("SolverLBMGridActive::tile_size", 256ul));
+                GridTiler<D2Q9, ResPrec_>::decompose(tile_size, *_info, *_data, _tiles);
+            }
+
+                virtual ~SolverLBMGridActive()
+                {
+                    CONTEXT("When destroying active set LABSWE solver.");
+                    GridTiler<D2Q9, ResPrec_>::destroy(_tiles);
+                }
+
+                const PackedGridTiles<D2Q9> & tiles() const
+                {
+                    return _tiles;
+                }
+
+                /// Return the number of time steps computed so far.
+                unsigned long time() const
+                {
+                    return _time;
+                }
+
+                /// Set the time step counter, e.g. on restart from a checkpoint (see GridCheckpoint).
+                void set_time(unsigned long time)
+                {
+                    _time = time;
+                }
+
+                void do_preprocessing()
+                {
+                    CONTEXT("When performing active set LABSWE preprocessing.");
+
+                    (*_data->distribution_x)[0] = ResPrec_(0.);
+                    (*_data->distribution_x)[1] = ResPrec_(_e * cos(ResPrec_(0.)));
+                    (*_data->distribution_x)[2] = ResPrec_(sqrt(ResPrec_(2.)) * _e * cos(_pi / ResPrec_(4.)));
+                    (*_data->distribution_x)[3] = ResPrec_(_e * cos(_pi / ResPrec_(2.)));
+                    (*_data->distribution_x)[4] = ResPrec_(sqrt(ResPrec_(2.)) * _e * cos(ResPrec_(3.) * _pi / ResPrec_(4.)));
+                    (*_data->distribution_x)[5] = ResPrec_(_e * cos(_pi));
+                    (*_data->distribution_x)[6] = ResPrec_(sqrt(ResPrec_(2.)) * _e * cos(ResPrec_(5.) * _pi / ResPrec_(4.)));
+                    (*_data->distribution_x)[7] = ResPrec_(_e * cos(ResPrec_(3.) * _pi / ResPrec_(2.)));
+                    (*_data->distribution_x)[8] = ResPrec_(sqrt(ResPrec_(2.)) * _e * cos(ResPrec_(7.) * _pi / ResPrec_(4.)));
+                    (*_data->distribution_y)[0] = ResPrec_(0.);
+                    (*_data->distribution_y)[1] = ResPrec_(_e * sin(ResPrec_(0.)));
+                    (*_data->distribution_y)[2] = ResPrec_(sqrt(ResPrec_(2.)) * _e * sin(_pi / ResPrec_(4.)));
+                    (*_data->distribution_y)[3] = ResPrec_(_e * sin(_pi / ResPrec_(2.)));
+                    (*_data->distribution_y)[4] = ResPrec_(sqrt(ResPrec_(2.)) * _e * sin(ResPrec_(3.) * _pi / ResPrec_(4.)));
+                    (*_data->distribution_y)[5] = ResPrec_(_e * sin(_pi));
+                    (*_data->distribution_y)[6] = ResPrec_(sqrt(ResPrec_(2.)) * _e * sin(ResPrec_(5.) * _pi / ResPrec_(4.)));
+                    (*_data->distribution_y)[7] = ResPrec_(_e * sin(ResPrec_(3.) * _pi / ResPrec_(2.)));
+                    (*_data->distribution_y)[8] = ResPrec_(sqrt(ResPrec_(2.)) * _e * sin(ResPrec_(7.) * _pi / ResPrec_(4.)));
+
+                    GridTiler<D2Q9, ResPrec_>::update(*_info, *_data, _tiles, _epsilon);
+
+                    ///Compute initial equilibrium distribution:
+                    for (unsigned long i(0) ; i < _tiles.info_list.size() ; ++i)
+                        EquilibriumDistributionGrid<Tag_, Application_>::
+                            value(_gravity, _e_squared, _tiles.info_list[i], *_data);
+
+                    *_data->f_0 = _data->f_eq_0->copy();
+                    *_data->f_1 = _data->f_eq_1->copy();
+                    *_data->f_2 = _data->f_eq_2->copy();
+                    *_data->f_3 = _data->f_eq_3->copy();
+                    *_data->f_4 = _data->f_eq_4->copy();
+                    *_data->f_5 = _data->f_eq_5->copy();
+                    *_data->f_6 = _data->f_eq_6->copy();
+                    *_data->f_7 = _data->f_eq_7->copy();
+                    *_data->f_8 = _data->f_eq_8->copy();
+
+                    for (unsigned long i(0) ; i < _tiles.info_list.size() ; ++i)
+                        CollideStreamGrid<Tag_, lbm_boundary_types::NOSLIP, lbm_lattice_types::D2Q9>::
+                            value(_tiles.info_list[i], *_data, _relaxation_time);
+                }
+
+                void do_postprocessing()
+                {
+                }
+
+
+                /** Capsule for the solution: Single step time marching.
+                 *
+                 **/
+                void solve()
+                {
+                    GridTiler<D2Q9, ResPrec_>::update(*_info, *_data, _tiles, _epsilon);
+
+                    for (unsigned long i(0) ; i < _tiles.info_list.size() ; ++i)
+                    {
+                        ForceGrid<Tag_, Application_, Force_, SourceScheme_>::value(_tiles.info_list[i], *_data, _gravity, _delta_x, _delta_y, _delta_t, ResPrec_(0.01));
+
+                        ///Boundary correction:
+                        UpdateVelocityDirectionsGrid<Tag_, NOSLIP>::
+                            value(_tiles.info_list[i], *_data);
+                    }
+
+                    //extract velocities out of h from previous timestep, the extraction swaps f and f_temp of its own data copy:
+                    for (unsigned long i(0) ; i < _tiles.info_list.size() ; ++i)
+                    {
+                        PackedGridData<D2Q9, ResPrec_> data(*_data);
+                        ExtractionGrid<Tag_, LbmMode_>::value(_tiles.info_list[i], data, ResPrec_(10e-5));
+                    }
+                    _swap(_data->f_0, _data->f_temp_0);
+                    _swap(_data->f_1, _data->f_temp_1);
+                    _swap(_data->f_2, _data->f_temp_2);
+                    _swap(_data->f_3, _data->f_temp_3);
+                    _swap(_data->f_4, _data->f_temp_4);
+                    _swap(_data->f_5, _data->f_temp_5);
+                    _swap(_data->f_6, _data->f_temp_6);
+                    _swap(_data->f_7, _data->f_temp_7);
+                    _swap(_data->f_8, _data->f_temp_8);
+
+                    ++_time;
+
+                    for (unsigned long i(0) ; i < _tiles.info_list.size() ; ++i)
+                    {
+                        EquilibriumDistributionGrid<Tag_, Application_>::
+                            value(_gravity, _e_squared, _tiles.info_list[i], *_data);
+
+                        CollideStreamGrid<Tag_, lbm_boundary_types::NOSLIP, lbm_lattice_types::D2Q9>::
+                            value(_tiles.info_list[i], *_data, _relaxation_time);
+                    }
+                }
+        };
+}
+#endif
@@ -0,0 +1,135 @@
+/* vim: set number sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LBM C++ library. LBM is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LBM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <honei/lbm/solver_lbm_grid_active.hh>
+#include <honei/lbm/solver_lbm_grid.hh>
+#include <honei/lbm/grid.hh>
+#include <honei/lbm/grid_packer.hh>
+#include <honei/swe/volume.hh>
+#include <honei/util/configuration.hh>
+#include <honei/util/unittest.hh>
+#include <iostream>
+
+using namespace honei;
+using namespace tests;
+using namespace std;
+using namespace lbm::lbm_lattice_types;
+
+template <typename Tag_, typename DataType_, typename Force_, typename SourceScheme_>
+class SolverLBMGridActiveTest :
+    public TaggedTest<Tag_>
+{
+    private:
+        DataType_ _eps;
+
+        static void _create(Grid<D2Q9, DataType_> & grid, unsigned long g_h, unsigned long g_w)
+        {
+            // a small reservoir in a dry basin
+            DenseMatrix<DataType_> h(g_h, g_w, DataType_(0.));
+            Cuboid<DataType_> reservoir(h, 12, 12, DataType_(0.05), 10, 10);
+            reservoir.value();
+            DenseMatrix<DataType_> b(g_h, g_w, DataType_(0.));
+            for (unsigned long i(0) ; i < g_h ; ++i)
+                for (unsigned long j(0) ; j < g_w ; ++j)
+                    b(i, j) = DataType_(0.0001) * DataType_(i + j);
+
+            grid.obstacles = new DenseMatrix<bool>(g_h, g_w, false);
+            grid.h = new DenseMatrix<DataType_>(h);
+            grid.u = new DenseMatrix<DataType_>(g_h, g_w, DataType_(0.));
+            grid.v = new DenseMatrix<DataType_>(g_h, g_w, DataType_(0.));
+            grid.b = new DenseMatrix<DataType_>(b);
+            grid.d_x = DataType_(0.01);
+            grid.d_y = DataType_(0.01);
+            grid.d_t = DataType_(0.01);
+            grid.tau = DataType_(1.1);
+        }
+
+    public:
+        SolverLBMGridActiveTest(const std::string & type, DataType_ eps) :
+            TaggedTest<Tag_>("solver_lbm_grid_active_test<" + type + ">")
+    {
+        _eps = eps;
+    }
+
+        virtual void run() const
+        {
+            unsigned long g_h(100);
+            unsigned long g_w(100);
+            unsigned long timesteps(60);
+
+            int old_tile_size(Configuration::instance()->get_value("SolverLBMGridActive::tile_size", 256));
+            Configuration::instance()->set_value("SolverLBMGridActive::tile_size", 50);
+
+            Grid<D2Q9, DataType_> grid;
+            _create(grid, g_h, g_w);
+            PackedGridData<D2Q9, DataType_> data;
+            PackedGridInfo<D2Q9> info;
+            GridPacker<D2Q9, NOSLIP, DataType_>::pack(grid, info, data);
+
+            SolverLBMGridActive<Tag_, lbm_applications::LABSWE, DataType_, Force_, SourceScheme_, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, lbm_modes::DRY> solver(&info, &data, grid.d_x, grid.d_y, grid.d_t, grid.tau);
+
+            Grid<D2Q9, DataType_> grid_standard;
+            _create(grid_standard, g_h, g_w);
+            PackedGridData<D2Q9, DataType_> data_standard;
+            PackedGridInfo<D2Q9> info_standard;
+            GridPacker<D2Q9, NOSLIP, DataType_>::pack(grid_standard, info_standard, data_standard);
+
+            SolverLBMGrid<tags::CPU, lbm_applications::LABSWE, DataType_, Force_, SourceScheme_, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, lbm_modes::DRY> solver_standard(&info_standard, &data_standard, grid_standard.d_x, grid_standard.d_y, grid_standard.d_t, grid_standard.tau);
+
+            solver.do_preprocessing();
+            solver_standard.do_preprocessing();
+
+            // the reservoir and its neighbourhood only
+            TEST_CHECK(solver.tiles().active_list.size() < solver.tiles().tile_count() / 4);
+
+            for (unsigned long i(0) ; i < timesteps ; ++i)
+            {
+                solver.solve();
+                solver_standard.solve();
+            }
+            solver.do_postprocessing();
+            solver_standard.do_postprocessing();
+
+            // the wave has not yet reached the far end of the basin
+            TEST_CHECK(solver.tiles().active_list.size() < solver.tiles().tile_count());
+            TEST_CHECK(solver.tiles().active_list.size() > 10);
+
+            DataType_ max_diff(0);
+            for (unsigned long i(0) ; i < data.h->size() ; ++i)
+            {
+                max_diff = std::max(max_diff, std::abs((*data.h)[i] - (*data_standard.h)[i]));
+                TEST_CHECK_EQUAL_WITHIN_EPS((*data.h)[i], (*data_standard.h)[i], _eps);
+                TEST_CHECK_EQUAL_WITHIN_EPS((*data.u)[i], (*data_standard.u)[i], _eps * 10);
+                TEST_CHECK_EQUAL_WITHIN_EPS((*data.v)[i], (*data_standard.v)[i], _eps * 10);
+            }
+            std::cout << "active tiles: " << solver.tiles().active_list.size() << " / " << solver.tiles().tile_count() << ", max. difference of h: " << max_diff << std::endl;
+
+            Configuration::instance()->set_value("SolverLBMGridActive::tile_size", old_tile_size);
+
+            grid.destroy();
+            info.destroy();
+            data.destroy();
+            grid_standard.destroy();
+            info_standard.destroy();
+            data_standard.destroy();
+        }
+};
+SolverLBMGridActiveTest<tags::CPU, float, lbm_force::NONE, lbm_source_schemes::NONE> solver_active_test_float("float", 1e-4);
+SolverLBMGridActiveTest<tags::CPU, double, lbm_force::NONE, lbm_source_schemes::NONE> solver_active_test_double("double", 1e-4);
+SolverLBMGridActiveTest<tags::CPU, double, lbm_force::CENTRED, lbm_source_schemes::BED_SLOPE> solver_active_slope_test_double("double, bed slope", 1e-4);
+SolverLBMGridActiveTest<tags::CPU::Generic, double, lbm_force::NONE, lbm_source_schemes::NONE> generic_solver_active_test_double("double", 1e-4);
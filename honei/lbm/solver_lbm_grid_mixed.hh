@@ -0,0 +1,302 @@
+/* vim: set number sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LBM C++ library. LBM is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LBM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#pragma once
+#ifndef LBM_GUARD_SOLVER_LBM_GRID_MIXED_HH
+#define LBM_GUARD_SOLVER_LBM_GRID_MIXED_HH 1
+
+/**
+ * \file
+ * Implementation of a SWE solver using LBM and PackedGrid with float distributions and double macroscopic fields.
+ *
+ * \ingroup grpliblbm
+ **/
+
+#include <honei/lbm/tags.hh>
+#include <honei/util/tags.hh>
+#include <honei/util/benchmark_info.hh>
+#include <honei/la/dense_vector.hh>
+#include <honei/lbm/collide_stream_grid.hh>
+#include <honei/lbm/equilibrium_distribution_grid_mixed.hh>
+#include <honei/lbm/extraction_grid_mixed.hh>
+#include <honei/lbm/force_grid.hh>
+#include <honei/lbm/update_velocity_directions_grid.hh>
+#include <honei/lbm/solver_lbm_grid.hh>
+#include <honei/lbm/grid.hh>
+#include <cmath>
+
+using namespace honei::lbm;
+using namespace honei::lbm::lbm_boundary_types;
+
+namespace honei
+{
+    template<typename Tag_,
+        typename Application_,
+        typename Force_,
+        typename SourceScheme_,
+        typename GridType_,
+        typename LatticeType_,
+        typename BoundaryType_,
+        typename LbmMode_>
+            class SolverLBMGridMixed
+            {
+            };
+
+    /**
+     * \brief LBM grid solver with float distributions and double macroscopic fields.
+     *
+     * Computes the same time steps as SolverLBMGrid, but keeps the distributions f, f_eq and f_temp
+     * in a float lattice owned by the solver, while h, u and v of the double data object are
+     * accumulated in double precision by ExtractionGridMixed and fed back by
+     * EquilibriumDistributionGridMixed. Force term, boundary correction and collide & stream run on
+     * the float lattice, which also holds float copies of h, b, u and v for the force term.
+     *
+     * The data object only needs h, b, u and v (see GridPacker::pack with alloc_all = false); any
+     * double distribution vectors it holds are left alone and unused. Results are read from data as usual.
+     *
+     * Only lbm_modes::DRY is available, as ExtractionGridMixed has no WET variant.
+     *
+     * \ingroup grpliblbm
+     */
+    template<typename Tag_, typename Application_, typename Force_, typename SourceScheme_>
+        class SolverLBMGridMixed<Tag_, Application_, Force_, SourceScheme_, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, lbm_modes::DRY> : public SolverLBMGridBase
+        {
+            private:
+                /** Global variables.
+                 *
+                 **/
+
+                double _relaxation_time, _delta_x, _delta_y, _delta_t;
+
+                unsigned long _time;
+
+                PackedGridInfo<D2Q9> * _info;
+                PackedGridData<D2Q9, double> * _data;
+
+                /// Our float distributions and float copies of h, b, u and v.
+                PackedGridData<D2Q9, float> _lattice;
+
+                /** Global constants.
+                 *
+                 **/
+                double _e, _gravity, _pi, _e_squared;
+
+                template <typename DT_> static void _allocate(DenseVector<DT_> * & vector, unsigned long size)
+                {
+                    if (vector == 0)
+                        vector = new DenseVector<DT_>(size, DT_(0));
+                }
+
+                static void _convert(DenseVector<float> & target, DenseVector<double> & source)
+                {
+                    source.lock(lm_read_only);
+                    target.lock(lm_write_only);
+                    const double * s(source.elements());
+                    float * t(target.elements());
+                    for (unsigned long i(0), i_end(source.size()) ; i < i_end ; ++i)
+                        t[i] = float(s[i]);
+                    target.unlock(lm_write_only);
+                    source.unlock(lm_read_only);
+                }
+
+            public:
+                SolverLBMGridMixed(PackedGridInfo<D2Q9> * info, PackedGridData<D2Q9, double> * data, double dx, double dy, double dt, double rel_time) :
+                    _relaxation_time(rel_time),
+                    _delta_x(dx),
+                    _delta_y(dy),
+                    _delta_t(dt),
+                    _time(0),
+                    _info(info),
+                    _data(data),
+                    _gravity(9.80665),
+                    _pi(3.14159265)
+            {
+                CONTEXT("When creating mixed precision LABSWE solver:");
+                _e = _delta_x / _delta_t;
+                _e_squared = _e * _e;
+
+                _allocate(_data->distribution_x, 9ul);
+                _allocate(_data->distribution_y, 9ul);
+
+                const unsigned long size(_data->h->size());
+                _allocate(_lattice.h, size);
+                _allocate(_lattice.b, size);
+                _allocate(_lattice.u, size);
+                _allocate(_lattice.v, size);
+                _allocate(_lattice.temp, size);
+                _allocate(_lattice.f_0, size);
+                _allocate(_lattice.f_1, size);
+                _allocate(_lattice.f_2, size);
+                _allocate(_lattice.f_3, size);
+                _allocate(_lattice.f_4, size);
+                _allocate(_lattice.f_5, size);
+                _allocate(_lattice.f_6, size);
+                _allocate(_lattice.f_7, size);
+                _allocate(_lattice.f_8, size);
+                _allocate(_lattice.f_eq_0, size);
+                _allocate(_lattice.f_eq_1, size);
+                _allocate(_lattice.f_eq_2, size);
+                _allocate(_lattice.f_eq_3, size);
+                _allocate(_lattice.f_eq_4, size);
+                _allocate(_lattice.f_eq_5, size);
+                _allocate(_lattice.f_eq_6, size);
+                _allocate(_lattice.f_eq_7, size);
+                _allocate(_lattice.f_eq_8, size);
+                _allocate(_lattice.f_temp_0, size);
+                _allocate(_lattice.f_temp_1, size);
+                _allocate(_lattice.f_temp_2, size);
+                _allocate(_lattice.f_temp_3, size);
+                _allocate(_lattice.f_temp_4, size);
+                _allocate(_lattice.f_temp_5, size);
+                _allocate(_lattice.f_temp_6, size);
+                _allocate(_lattice.f_temp_7, size);
+                _allocate(_lattice.f_temp_8, size);
+                _allocate(_lattice.distribution_x, 9ul);
+                _allocate(_lattice.distribution_y, 9ul);
+            }
+
+                virtual ~SolverLBMGridMixed()
+                {
+                    CONTEXT("When destroying mixed precision LABSWE solver.");
+
+                    _lattice.destroy();
+                }
+
+                /// Return the number of time steps computed so far.
+                unsigned long time() const
+                {
+                    return _time;
+                }
+
+                /// Set the time step counter, e.g. on restart from a checkpoint (see GridCheckpoint).
+                void set_time(unsigned long time)
+                {
+                    _time = time;
+                }
+
+                /// Return our float lattice.
+                PackedGridData<D2Q9, float> & lattice()
+                {
+                    return _lattice;
+                }
+
+                void do_preprocessing()
+                {
+                    CONTEXT("When performing mixed precision LABSWE preprocessing.");
+
+                    (*_data->distribution_x)[0] = double(0.);
+                    (*_data->distribution_x)[1] = double(_e * cos(double(0.)));
+                    (*_data->distribution_x)[2] = double(sqrt(double(2.)) * _e * cos(_pi / double(4.)));
+                    (*_data->distribution_x)[3] = double(_e * cos(_pi / double(2.)));
+                    (*_data->distribution_x)[4] = double(sqrt(double(2.)) * _e * cos(double(3.) * _pi / double(4.)));
+                    (*_data->distribution_x)[5] = double(_e * cos(_pi));
+                    (*_data->distribution_x)[6] = double(sqrt(double(2.)) * _e * cos(double(5.) * _pi / double(4.)));
+                    (*_data->distribution_x)[7] = double(_e * cos(double(3.) * _pi / double(2.)));
+                    (*_data->distribution_x)[8] = double(sqrt(double(2.)) * _e * cos(double(7.) * _pi / double(4.)));
+                    (*_data->distribution_y)[0] = double(0.);
+                    (*_data->distribution_y)[1] = double(_e * sin(double(0.)));
+                    (*_data->distribution_y)[2] = double(sqrt(double(2.)) * _e * sin(_pi / double(4.)));
+                    (*_data->distribution_y)[3] = double(_e * sin(_pi / double(2.)));
+                    (*_data->distribution_y)[4] = double(sqrt(double(2.)) * _e * sin(double(3.) * _pi / double(4.)));
+                    (*_data->distribution_y)[5] = double(_e * sin(_pi));
+                    (*_data->distribution_y)[6] = double(sqrt(double(2.)) * _e * sin(double(5.) * _pi / double(4.)));
+                    (*_data->distribution_y)[7] = double(_e * sin(double(3.) * _pi / double(2.)));
+                    (*_data->distribution_y)[8] = double(sqrt(double(2.)) * _e * sin(double(7.) * _pi / double(4.)));
+
+                    _convert(*_lattice.distribution_x, *_data->distribution_x);
+                    _convert(*_lattice.distribution_y, *_data->distribution_y);
+                    _convert(*_lattice.h, *_data->h);
+                    _convert(*_lattice.b, *_data->b);
+                    _convert(*_lattice.u, *_data->u);
+                    _convert(*_lattice.v, *_data->v);
+
+                    ///Compute initial equilibrium distribution:
+                    EquilibriumDistributionGridMixed<Tag_, Application_>::
+                        value(_gravity, _e_squared, *_info, *_data, _lattice);
+
+                    *_lattice.f_0 = _lattice.f_eq_0->copy();
+                    *_lattice.f_1 = _lattice.f_eq_1->copy();
+                    *_lattice.f_2 = _lattice.f_eq_2->copy();
+                    *_lattice.f_3 = _lattice.f_eq_3->copy();
+                    *_lattice.f_4 = _lattice.f_eq_4->copy();
+                    *_lattice.f_5 = _lattice.f_eq_5->copy();
+                    *_lattice.f_6 = _lattice.f_eq_6->copy();
+                    *_lattice.f_7 = _lattice.f_eq_7->copy();
+                    *_lattice.f_8 = _lattice.f_eq_8->copy();
+
+                    CollideStreamGrid<Tag_, lbm_boundary_types::NOSLIP, lbm_lattice_types::D2Q9>::
+                        value(*_info,
+                                _lattice,
+                                float(_relaxation_time));
+
+                    _time = 0;
+                }
+
+                void do_postprocessing()
+                {
+                }
+
+
+                /** Capsule for the solution: Single step time marching.
+                 *
+                 **/
+                void solve()
+                {
+                    ForceGrid<Tag_, Application_, Force_, SourceScheme_>::value(*_info, _lattice, float(_gravity),
+                            float(_delta_x), float(_delta_y), float(_delta_t), float(0.01));
+
+                    ///Boundary correction:
+                    UpdateVelocityDirectionsGrid<Tag_, NOSLIP>::
+                        value(*_info, _lattice);
+
+                    //extract velocities out of h from previous timestep:
+                    ExtractionGridMixed<Tag_, lbm_modes::DRY>::value(*_info, _lattice, *_data, double(10e-5));
+
+                    ++_time;
+
+                    EquilibriumDistributionGridMixed<Tag_, Application_>::
+                        value(_gravity, _e_squared, *_info, *_data, _lattice);
+
+                    CollideStreamGrid<Tag_, lbm_boundary_types::NOSLIP, lbm_lattice_types::D2Q9>::
+                        value(*_info,
+                                _lattice,
+                                float(_relaxation_time));
+                }
+
+                static LBMBenchmarkInfo get_benchmark_info(Grid<D2Q9, double> * grid, PackedGridInfo<D2Q9> * info, PackedGridData<D2Q9, float> * lattice)
+                {
+                    LBMBenchmarkInfo result;
+                    BenchmarkInfo eq_dist(EquilibriumDistributionGridMixed<Tag_, Application_>::get_benchmark_info(info, lattice));
+                    result += eq_dist;
+                    BenchmarkInfo col_stream(CollideStreamGrid<Tag_, lbm_boundary_types::NOSLIP, lbm_lattice_types::D2Q9>::get_benchmark_info(info, lattice));
+                    result += col_stream;
+                    BenchmarkInfo force(ForceGrid<Tag_, Application_, Force_, SourceScheme_>::get_benchmark_info(info, lattice));
+                    result += force;
+                    BenchmarkInfo extraction(ExtractionGridMixed<Tag_, lbm_modes::DRY>::get_benchmark_info(info, lattice));
+                    result += extraction;
+
+                    result.size.push_back(grid->h->rows());
+                    result.size.push_back(grid->h->columns());
+                    result.lups = grid->h->rows() * grid->h->columns();
+                    result.flups = lattice->h->size();
+                    return result;
+                }
+        };
+}
+#endif
@@ -0,0 +1,155 @@
+/* vim: set number sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the LBM C++ library. LBM is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LBM is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+#include <honei/lbm/solver_lbm_grid_mixed.hh>
+#include <honei/lbm/solver_lbm_grid.hh>
+#include <honei/util/unittest.hh>
+#include <iostream>
+#include <honei/lbm/grid.hh>
+#include <honei/lbm/grid_packer.hh>
+#include <honei/la/norm.hh>
+#include <honei/la/difference.hh>
+#include <honei/lbm/scenario_collection.hh>
+
+using namespace honei;
+using namespace tests;
+using namespace std;
+using namespace lbm::lbm_lattice_types;
+
+namespace
+{
+    /// Run scenario scen with SolverLBMGrid<tags::CPU::Generic, DataType_> and return the unpacked h.
+    template <typename DataType_> DenseMatrix<double> reference(unsigned long scen, unsigned long g_h, unsigned long g_w, unsigned long timesteps)
+    {
+        Grid<D2Q9, DataType_> grid;
+        ScenarioCollection::get_scenario(scen, g_h, g_w, grid);
+
+        PackedGridData<D2Q9, DataType_>  data;
+        PackedGridInfo<D2Q9> info;
+
+        GridPacker<D2Q9, NOSLIP, DataType_>::pack(grid, info, data);
+
+        SolverLBMGrid<tags::CPU::Generic, lbm_applications::LABSWE, DataType_,lbm_force::CENTRED, lbm_source_schemes::BED_FULL, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, lbm_modes::DRY> solver(&info, &data, grid.d_x, grid.d_y, grid.d_t, grid.tau);
+        solver.do_preprocessing();
+
+        for(unsigned long i(0); i < timesteps; ++i)
+            solver.solve();
+
+        GridPacker<D2Q9, NOSLIP, DataType_>::unpack(grid, info, data);
+
+        DenseMatrix<double> result(grid.h->rows(), grid.h->columns());
+        for (unsigned long i(0) ; i < result.rows() ; ++i)
+            for (unsigned long j(0) ; j < result.columns() ; ++j)
+                result(i, j) = (*grid.h)(i, j);
+
+        grid.destroy();
+        info.destroy();
+        data.destroy();
+
+        return result;
+    }
+
+    double l2_distance(const DenseMatrix<double> & a, const DenseMatrix<double> & b)
+    {
+        DenseVector<double> difference(a.size());
+        for (unsigned long i(0) ; i < a.size() ; ++i)
+            difference[i] = a.elements()[i] - b.elements()[i];
+
+        return Norm<vnt_l_two, false, tags::CPU>::value(difference);
+    }
+}
+
+template <typename Tag_>
+class SolverLBMGridMixedRegressionTest :
+    public TaggedTest<Tag_>
+{
+    public:
+        SolverLBMGridMixedRegressionTest(const std::string & type) :
+            TaggedTest<Tag_>("solver_lbm_grid_mixed_regression_test<" + type + ">")
+    {
+    }
+
+        virtual void run() const
+        {
+            for (unsigned long scen(0) ; scen < ScenarioCollection::get_stable_scenario_count() ; ++scen)
+            {
+                unsigned long g_h(50);
+                unsigned long g_w(50);
+                unsigned long timesteps(200);
+
+                Grid<D2Q9, double> grid;
+                ScenarioCollection::get_scenario(scen, g_h, g_w, grid);
+
+                PackedGridData<D2Q9, double>  data;
+                PackedGridInfo<D2Q9> info;
+
+                // double distributions are not needed, but left alone if present
+                GridPacker<D2Q9, NOSLIP, double>::pack(grid, info, data, scen % 2 == 1);
+                DenseVector<double> * f_0(data.f_0);
+
+                SolverLBMGridMixed<Tag_, lbm_applications::LABSWE, lbm_force::CENTRED, lbm_source_schemes::BED_FULL, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, lbm_modes::DRY> solver(&info, &data, grid.d_x, grid.d_y, grid.d_t, grid.tau);
+                solver.do_preprocessing();
+                TEST_CHECK(data.f_0 == f_0);
+
+                for(unsigned long i(0); i < timesteps; ++i)
+                    solver.solve();
+
+                TEST_CHECK_EQUAL(solver.time(), timesteps);
+
+                GridPacker<D2Q9, NOSLIP, double>::unpack(grid, info, data);
+
+                DenseMatrix<double> result(grid.h->rows(), grid.h->columns());
+                for (unsigned long i(0) ; i < result.rows() ; ++i)
+                    for (unsigned long j(0) ; j < result.columns() ; ++j)
+                        result(i, j) = (*grid.h)(i, j);
+
+                DenseMatrix<double> result_double(reference<double>(scen, g_h, g_w, timesteps));
+                DenseMatrix<double> result_float(reference<float>(scen, g_h, g_w, timesteps));
+
+                std::cout << grid.description <<": ";
+
+                TEST_CHECK_EQUAL(result.rows(), result_double.rows());
+                TEST_CHECK_EQUAL(result.columns(), result_double.columns());
+
+                //Compare to the double precision solver:
+                for(unsigned long i(0) ; i < result.rows() ; ++i)
+                {
+                    for(unsigned long j(0) ; j < result.columns() ; ++j)
+                    {
+                        TEST_CHECK_EQUAL_WITHIN_EPS(result(i , j), result_double(i , j), std::numeric_limits<float>::epsilon() * 2e2);
+                    }
+                }
+
+                double l2(l2_distance(result, result_double));
+                double l2_float(l2_distance(result_float, result_double));
+                std::cout << "L2 norm " << l2 << " (float solver: " << l2_float << ")" << std::endl;
+
+                TEST_CHECK_EQUAL_WITHIN_EPS(l2, 0., std::numeric_limits<float>::epsilon());
+                // double extraction and equilibrium must pay off
+                TEST_CHECK(l2 < l2_float);
+
+                grid.destroy();
+                info.destroy();
+                data.destroy();
+            }
+        }
+};
+SolverLBMGridMixedRegressionTest<tags::CPU::Generic> generic_solver_mixed_test("mixed");
+#ifdef HONEI_SSE
+SolverLBMGridMixedRegressionTest<tags::CPU::SSE> sse_solver_mixed_test("mixed");
+#endif
@@ -26,6 +26,7 @@
 #include <honei/math/quadrature.hh>
 #include <honei/lbm/grid.hh>
 #include <honei/lbm/grid_packer.hh>
+#include <honei/lbm/grid_output.hh>
 #include <honei/util/kpnetcdffile.hh>
 #include <honei/la/difference.hh>
 
@@ -96,6 +97,12 @@ class SolverLBMGridTest :
             SolverLBMGrid<Tag_, lbm_applications::LABSWE, DataType_,lbm_force::CENTRED, lbm_source_schemes::BED_FULL, lbm_grid_types::RECTANGULAR, lbm_lattice_types::D2Q9, lbm_boundary_types::NOSLIP, lbm_modes::DRY> solver(&info, &data, grid.d_x, grid.d_y, grid.d_t, grid.tau);
 
             solver.do_preprocessing();
+
+            // every tenth time step is written in the background while the solver continues
+            KPNetCDFFile output_file("solver_lbm_grid_netcdf_TEST.nc", cond);
+            GridOutput<D2Q9, DataType_> output(grid, info,
+                    bind(mem_fn(&KPNetCDFFile::writeTimeStep), &output_file, HONEI_PLACEHOLDERS_1, -1), 2, 10);
+
             std::cout << "Solving: " << grid.description << std::endl;
             for(unsigned long i(0); i < timesteps; ++i)
             {
@@ -103,12 +110,16 @@ class SolverLBMGridTest :
                 std::cout<<"Timestep: " << i << "/" << timesteps << std::endl;
 #endif
                 solver.solve();
+                output.write(data, float(i + 1) * grid.d_t);
 #ifdef SOLVER_POSTPROCESSING
                 solver.do_postprocessing();
                 GridPacker<D2Q9, NOSLIP, DataType_>::unpack(grid, info, data);
                 PostProcessing<GNUPLOT>::value(*grid.h, 1, g_w, g_h, i);
 #endif
             }
+            output.wait();
+            TEST_CHECK_EQUAL(output.written(), timesteps / 10);
+
             solver.do_postprocessing();
             GridPacker<D2Q9, NOSLIP, DataType_>::unpack(grid, info, data);
 #ifdef SOLVER_VERBOSE
@@ -98,6 +98,13 @@ namespace honei
             class DRY;
             class WET;
         }
+
+        /// Alternating time steps of the in-place (AA pattern) streaming scheme.
+        namespace lbm_aa_steps
+        {
+            class EVEN;
+            class ODD;
+        }
     }
 
 }
@@ -0,0 +1,615 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2011 Markus Geveler <apryde@gmx.de>
+ *
+ * This file is part of the MATH C++ library. LibMath is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LibMath is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#pragma once
+#ifndef MATH_GUARD_AMG_HH
+#define MATH_GUARD_AMG_HH 1
+
+#include <honei/math/mg.hh>
+#include <honei/math/sainv.hh>
+#include <honei/math/spai2.hh>
+#include <honei/la/sparse_matrix.hh>
+#include <honei/la/dense_vector.hh>
+#include <honei/la/matrix_error.hh>
+#include <honei/backends/multicore/thread_pool.hh>
+#include <honei/util/configuration.hh>
+#include <honei/util/operation_wrapper.hh>
+#include <honei/util/profiler.hh>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace honei
+{
+    template <typename Tag_ = tags::CPU> struct GalerkinProduct;
+
+    /**
+     * \brief Sparse matrix products for the Galerkin coarse grid operator R A P.
+     *
+     * The products are computed row by row with a dense accumulator, so that disjoint
+     * ranges of rows can be computed independently.
+     *
+     * \ingroup grpmatrixoperations
+     */
+    template <> struct GalerkinProduct<tags::CPU>
+    {
+        /**
+         * \brief Computes the rows [row_start, row_end) of a * b into result.
+         *
+         * \param result The rows of result in the given range have to be empty.
+         */
+        template <typename DT_>
+        static SparseMatrix<DT_> & value(SparseMatrix<DT_> & result, const SparseMatrix<DT_> & a, const SparseMatrix<DT_> & b,
+                unsigned long row_start, unsigned long row_end)
+        {
+            CONTEXT("When computing rows of SparseMatrix-SparseMatrix product:");
+
+            std::vector<DT_> accu(b.columns(), DT_(0));
+            std::vector<unsigned long> marker(b.columns(), a.rows());
+            std::vector<unsigned long> pattern;
+
+            for (unsigned long row(row_start) ; row < row_end ; ++row)
+            {
+                const SparseVector<DT_> & arow(a[row]);
+                const unsigned long * ai(arow.indices());
+                const DT_ * av(arow.elements());
+
+                for (unsigned long k(0) ; k < arow.used_elements() ; ++k)
+                {
+                    const SparseVector<DT_> & brow(b[ai[k]]);
+                    const unsigned long * bi(brow.indices());
+                    const DT_ * bv(brow.elements());
+
+                    for (unsigned long l(0) ; l < brow.used_elements() ; ++l)
+                    {
+                        if (marker[bi[l]] != row)
+                        {
+                            marker[bi[l]] = row;
+                            accu[bi[l]] = DT_(0);
+                            pattern.push_back(bi[l]);
+                        }
+                        accu[bi[l]] += av[k] * bv[l];
+                    }
+                }
+
+                if (pattern.empty())
+                    continue;
+
+                std::sort(pattern.begin(), pattern.end());
+                SparseVector<DT_> & rrow(result[row]);
+                for (std::vector<unsigned long>::const_iterator i(pattern.begin()) ; i != pattern.end() ; ++i)
+                    rrow[*i] = accu[*i];
+                pattern.clear();
+            }
+
+            return result;
+        }
+
+        /// Returns a * b.
+        template <typename DT_>
+        static SparseMatrix<DT_> value(const SparseMatrix<DT_> & a, const SparseMatrix<DT_> & b)
+        {
+            CONTEXT("When multiplying SparseMatrix with SparseMatrix:");
+
+            if (a.columns() != b.rows())
+                throw MatrixRowsDoNotMatch(b.rows(), a.columns());
+
+            SparseMatrix<DT_> result(a.rows(), b.columns());
+            value(result, a, b, 0, a.rows());
+
+            return result;
+        }
+
+        /// Returns the Galerkin product r * a * p.
+        template <typename DT_>
+        static SparseMatrix<DT_> value(const SparseMatrix<DT_> & r, const SparseMatrix<DT_> & a, const SparseMatrix<DT_> & p)
+        {
+            CONTEXT("When computing Galerkin product:");
+            PROFILER_START("GalerkinProduct tags::CPU");
+
+            SparseMatrix<DT_> result(value(r, value(a, p)));
+
+            PROFILER_STOP("GalerkinProduct tags::CPU");
+            return result;
+        }
+    };
+
+    template <> struct GalerkinProduct<tags::CPU::Generic> :
+        public GalerkinProduct<tags::CPU>
+    {
+    };
+
+    template <> struct GalerkinProduct<tags::CPU::SSE> :
+        public GalerkinProduct<tags::CPU>
+    {
+    };
+
+    namespace mc
+    {
+        template <typename Tag_> struct GalerkinProduct
+        {
+            public:
+                template <typename DT_>
+                static SparseMatrix<DT_> value(const SparseMatrix<DT_> & a, const SparseMatrix<DT_> & b)
+                {
+                    CONTEXT("When multiplying SparseMatrix with SparseMatrix using backend : " + Tag_::name);
+
+                    if (a.columns() != b.rows())
+                        throw MatrixRowsDoNotMatch(b.rows(), a.columns());
+
+                    unsigned long max_count(Configuration::instance()->get_value("mc::GalerkinProduct::max_count",
+                                mc::ThreadPool::instance()->num_threads()));
+                    if (max_count > a.rows())
+                        max_count = a.rows();
+
+                    SparseMatrix<DT_> result(a.rows(), b.columns());
+                    // every task gets its own handle of result to write back to
+                    std::vector<SparseMatrix<DT_> > handles(max_count, result);
+                    TicketVector tickets;
+
+                    for (unsigned long i(0) ; i < max_count ; ++i)
+                    {
+                        OperationWrapper<honei::GalerkinProduct<typename Tag_::DelegateTo>, SparseMatrix<DT_>,
+                            SparseMatrix<DT_>, SparseMatrix<DT_>, SparseMatrix<DT_>, unsigned long, unsigned long> wrapper(handles[i]);
+                        tickets.push_back(mc::ThreadPool::instance()->enqueue(bind(wrapper, result, a, b,
+                                        i * a.rows() / max_count, (i + 1) * a.rows() / max_count)));
+                    }
+
+                    tickets.wait();
+
+                    return result;
+                }
+
+                template <typename DT_>
+                static SparseMatrix<DT_> value(const SparseMatrix<DT_> & r, const SparseMatrix<DT_> & a, const SparseMatrix<DT_> & p)
+                {
+                    CONTEXT("When computing Galerkin product using backend : " + Tag_::name);
+                    PROFILER_START("GalerkinProduct " + Tag_::name);
+
+                    SparseMatrix<DT_> result(value(r, value(a, p)));
+
+                    PROFILER_STOP("GalerkinProduct " + Tag_::name);
+                    return result;
+                }
+        };
+    }
+
+    template <> struct GalerkinProduct<tags::CPU::MultiCore> :
+        public mc::GalerkinProduct<tags::CPU::MultiCore>
+    {
+    };
+
+    template <> struct GalerkinProduct<tags::CPU::MultiCore::Generic> :
+        public mc::GalerkinProduct<tags::CPU::MultiCore::Generic>
+    {
+    };
+
+    template <> struct GalerkinProduct<tags::CPU::MultiCore::SSE> :
+        public mc::GalerkinProduct<tags::CPU::MultiCore::SSE>
+    {
+    };
+
+    /**
+     * \brief Aggregation of the unknowns for smoothed aggregation AMG.
+     *
+     * Two unknowns i and j are strongly coupled if -a_ij > theta * sqrt(|a_ii a_jj|), positive
+     * couplings, as they show up on distorted meshes, are always weak.
+     * Aggregates are built greedily from unknowns whose strong neighbourhood is still free,
+     * remaining unknowns join a neighbouring aggregate or form new ones. Unknowns without
+     * strong couplings (e.g. Dirichlet rows) are left out.
+     */
+    struct AMGAggregation
+    {
+        /// Marks an unknown which belongs to no aggregate.
+        static unsigned long none()
+        {
+            return ~0ul;
+        }
+
+        /// Returns true if the coupling a_ij is strong.
+        template <typename DT_>
+        static bool strong(DT_ a_ij, DT_ a_ii, DT_ a_jj, DT_ theta)
+        {
+            return -a_ij > theta * std::sqrt(std::abs(a_ii * a_jj));
+        }
+
+        /**
+         * \brief Aggregates the unknowns of a.
+         *
+         * \param aggregates Receives the aggregate of every unknown, or none().
+         * \return The number of aggregates.
+         */
+        template <typename DT_>
+        static unsigned long value(std::vector<unsigned long> & aggregates, const SparseMatrix<DT_> & a, DT_ theta)
+        {
+            CONTEXT("When aggregating unknowns:");
+
+            const unsigned long n(a.rows());
+            std::vector<DT_> diagonal(n, DT_(0));
+            for (unsigned long i(0) ; i < n ; ++i)
+                diagonal[i] = a(i, i);
+
+            // unknowns without any strong coupling, e.g. Dirichlet rows, are isolated
+            std::vector<bool> isolated(n, true);
+            for (unsigned long i(0) ; i < n ; ++i)
+            {
+                const SparseVector<DT_> & row(a[i]);
+                for (unsigned long k(0) ; isolated[i] && k < row.used_elements() ; ++k)
+                {
+                    const unsigned long j(row.indices()[k]);
+                    isolated[i] = j == i || ! AMGAggregation::strong(row.elements()[k], diagonal[i], diagonal[j], theta);
+                }
+            }
+
+            // strong, non isolated neighbours of every unknown, in a compressed row layout
+            std::vector<unsigned long> strong_start(n + 1, 0), strong;
+            for (unsigned long i(0) ; i < n ; ++i)
+            {
+                const SparseVector<DT_> & row(a[i]);
+                for (unsigned long k(0) ; ! isolated[i] && k < row.used_elements() ; ++k)
+                {
+                    const unsigned long j(row.indices()[k]);
+                    if (j != i && ! isolated[j] && AMGAggregation::strong(row.elements()[k], diagonal[i], diagonal[j], theta))
+                        strong.push_back(j);
+                }
+                strong_start[i + 1] = strong.size();
+            }
+
+            aggregates.assign(n, none());
+            unsigned long count(0);
+
+            // phase one: roots with a completely free strong neighbourhood
+            for (unsigned long i(0) ; i < n ; ++i)
+            {
+                if (aggregates[i] != none() || strong_start[i] == strong_start[i + 1])
+                    continue;
+
+                bool free(true);
+                for (unsigned long k(strong_start[i]) ; free && k < strong_start[i + 1] ; ++k)
+                    free = aggregates[strong[k]] == none();
+                if (! free)
+                    continue;
+
+                aggregates[i] = count;
+                for (unsigned long k(strong_start[i]) ; k < strong_start[i + 1] ; ++k)
+                    aggregates[strong[k]] = count;
+                ++count;
+            }
+
+            // phase two: join the aggregate of a strong neighbour from phase one
+            std::vector<unsigned long> phase_one(aggregates);
+            for (unsigned long i(0) ; i < n ; ++i)
+            {
+                if (aggregates[i] != none())
+                    continue;
+
+                for (unsigned long k(strong_start[i]) ; k < strong_start[i + 1] ; ++k)
+                {
+                    if (phase_one[strong[k]] != none())
+                    {
+                        aggregates[i] = phase_one[strong[k]];
+                        break;
+                    }
+                }
+            }
+
+            // phase three: the rest forms new aggregates with its free strong neighbours
+            for (unsigned long i(0) ; i < n ; ++i)
+            {
+                if (aggregates[i] != none() || strong_start[i] == strong_start[i + 1])
+                    continue;
+
+                aggregates[i] = count;
+                for (unsigned long k(strong_start[i]) ; k < strong_start[i + 1] ; ++k)
+                    if (aggregates[strong[k]] == none())
+                        aggregates[strong[k]] = count;
+                ++count;
+            }
+
+            return count;
+        }
+    };
+
+    /**
+     * \brief Computes the smoother preconditioner of one AMG level.
+     *
+     * Vector preconditioners are computed by PreconFill, matrix preconditioners are
+     * computed here instead of being read from file.
+     */
+    template <typename PreconContType_, typename MatrixType_, typename DataType_>
+    struct AMGPreconFill
+    {
+        static void value(std::vector<PreconContType_> & target, std::string precon_suffix, MatrixType_ & A, DataType_ damping_factor)
+        {
+            PreconFill<PreconContType_, MatrixType_, DataType_>::value(target.size(), target, "", precon_suffix, A, damping_factor);
+        }
+    };
+
+    template <typename MatrixType_, typename DataType_>
+    struct AMGPreconFill<MatrixType_, MatrixType_, DataType_>
+    {
+        static void value(std::vector<MatrixType_> & target, std::string precon_suffix, MatrixType_ & A, DataType_ damping_factor)
+        {
+            SparseMatrix<DataType_> As(A);
+            SparseMatrix<DataType_> sm_P(As.rows(), As.columns());
+
+            if (precon_suffix == "sainv")
+            {
+#ifdef HONEI_SSE
+                sm_P = SAINV<tags::CPU::MultiCore::SSE>::value(As);
+#else
+                sm_P = SAINV<tags::CPU>::value(As);
+#endif
+            }
+            else if (precon_suffix == "spai")
+            {
+                sm_P = As.copy();
+#ifdef HONEI_SSE
+                SPAI2<tags::CPU::MultiCore::SSE>::value(sm_P, As);
+#else
+                SPAI2<tags::CPU>::value(sm_P, As);
+#endif
+            }
+            else
+                throw InternalError("Preconditioner unknown!");
+
+            if (damping_factor != DataType_(1))
+                Scale<tags::CPU>::value(sm_P, damping_factor);
+
+            MatrixType_ current_P(sm_P);
+            target.push_back(current_P);
+        }
+    };
+
+    /**
+     * \brief Builds an MGData hierarchy with smoothed aggregation AMG.
+     *
+     * Only the finest system matrix is needed: the prolongations are tentative piecewise constant
+     * prolongations over the aggregates, smoothed by one damped Jacobi step with the filtered
+     * system matrix, the restrictions their transposes and the coarse systems the Galerkin products R A P, computed with Tag_.
+     */
+    template<typename Tag_,
+        typename MatrixType_,
+        typename VectorType_,
+        typename TransferContType_,
+        typename PreconContType_,
+        typename DataType_>
+            struct AMGUtil
+            {
+                private:
+                    /// Estimates the spectral radius of D^-1 A by power iteration.
+                    static DataType_ _spectral_radius(const SparseMatrix<DataType_> & a)
+                    {
+                        const unsigned long n(a.rows());
+                        std::vector<DataType_> v(n), w(n);
+                        for (unsigned long i(0) ; i < n ; ++i)
+                            v[i] = DataType_(1) + DataType_(i % 7) / DataType_(7);
+
+                        DataType_ rho(0);
+                        for (unsigned long iter(0) ; iter < 15 ; ++iter)
+                        {
+                            DataType_ norm_v(0), norm_w(0);
+                            for (unsigned long i(0) ; i < n ; ++i)
+                            {
+                                const SparseVector<DataType_> & row(a[i]);
+                                DataType_ sum(0);
+                                for (unsigned long k(0) ; k < row.used_elements() ; ++k)
+                                    sum += row.elements()[k] * v[row.indices()[k]];
+                                w[i] = sum / a(i, i);
+                                norm_v += v[i] * v[i];
+                                norm_w += w[i] * w[i];
+                            }
+
+                            if (norm_w == DataType_(0))
+                                break;
+
+                            rho = std::sqrt(norm_w / norm_v);
+                            const DataType_ scale(DataType_(1) / std::sqrt(norm_w));
+                            for (unsigned long i(0) ; i < n ; ++i)
+                                v[i] = w[i] * scale;
+                        }
+
+                        return rho;
+                    }
+
+                    /// Computes the smoothed prolongation (I - omega D^-1 A) T of the aggregates.
+                    static SparseMatrix<DataType_> _prolongation(const SparseMatrix<DataType_> & a, const std::vector<unsigned long> & aggregates,
+                            unsigned long count)
+                    {
+                        const unsigned long n(a.rows());
+
+                        std::vector<DataType_> weight(count, DataType_(0));
+                        for (unsigned long i(0) ; i < n ; ++i)
+                            if (aggregates[i] != AMGAggregation::none())
+                                weight[aggregates[i]] += DataType_(1);
+                        for (unsigned long j(0) ; j < count ; ++j)
+                            weight[j] = DataType_(1) / std::sqrt(weight[j]);
+
+                        const DataType_ omega(DataType_(4) / DataType_(3) / _spectral_radius(a));
+
+                        SparseMatrix<DataType_> p(n, count);
+                        std::vector<DataType_> accu(count, DataType_(0));
+                        std::vector<unsigned long> marker(count, n);
+                        std::vector<unsigned long> pattern;
+                        for (unsigned long i(0) ; i < n ; ++i)
+                        {
+                            const SparseVector<DataType_> & row(a[i]);
+                            const DataType_ factor(-omega / a(i, i));
+                            for (unsigned long k(0) ; k < row.used_elements() ; ++k)
+                            {
+                                const unsigned long j(row.indices()[k]), agg(aggregates[j]);
+                                if (agg == AMGAggregation::none())
+                                    continue;
+
+                                if (marker[agg] != i)
+                                {
+                                    marker[agg] = i;
+                                    accu[agg] = DataType_(0);
+                                    pattern.push_back(agg);
+                                }
+                                accu[agg] += factor * row.elements()[k] * weight[agg];
+                            }
+
+                            if (aggregates[i] != AMGAggregation::none())
+                            {
+                                const unsigned long agg(aggregates[i]);
+                                if (marker[agg] != i)
+                                {
+                                    marker[agg] = i;
+                                    accu[agg] = DataType_(0);
+                                    pattern.push_back(agg);
+                                }
+                                accu[agg] += weight[agg];
+                            }
+
+                            std::sort(pattern.begin(), pattern.end());
+                            for (std::vector<unsigned long>::const_iterator j(pattern.begin()) ; j != pattern.end() ; ++j)
+                                if (accu[*j] != DataType_(0))
+                                    p[i][*j] = accu[*j];
+                            pattern.clear();
+                        }
+
+                        return p;
+                    }
+
+                    /// Returns a with its weak couplings lumped onto the diagonal.
+                    static SparseMatrix<DataType_> _filter(const SparseMatrix<DataType_> & a, DataType_ theta)
+                    {
+                        SparseMatrix<DataType_> result(a.rows(), a.columns());
+                        for (unsigned long i(0) ; i < a.rows() ; ++i)
+                        {
+                            const SparseVector<DataType_> & row(a[i]);
+                            DataType_ diagonal(a(i, i));
+                            for (unsigned long k(0) ; k < row.used_elements() ; ++k)
+                            {
+                                const unsigned long j(row.indices()[k]);
+                                if (j == i)
+                                    continue;
+
+                                if (AMGAggregation::strong(row.elements()[k], a(i, i), a(j, j), theta))
+                                    result[i][j] = row.elements()[k];
+                                else
+                                    diagonal += row.elements()[k];
+                            }
+                            result[i][i] = diagonal;
+                        }
+                        return result;
+                    }
+
+                    /// Returns the transpose of a, built row by row.
+                    static SparseMatrix<DataType_> _transpose(const SparseMatrix<DataType_> & a)
+                    {
+                        SparseMatrix<DataType_> result(a.columns(), a.rows());
+                        for (unsigned long i(0) ; i < a.rows() ; ++i)
+                        {
+                            const SparseVector<DataType_> & row(a[i]);
+                            for (unsigned long k(0) ; k < row.used_elements() ; ++k)
+                                result[row.indices()[k]][i] = row.elements()[k];
+                        }
+                        return result;
+                    }
+
+                public:
+                    /**
+                     * \brief Builds the hierarchy for the system A x = b.
+                     *
+                     * \param max_levels Maximal number of levels, including the finest one.
+                     * \param coarse_size Coarsening stops as soon as a level has at most that many unknowns.
+                     * \param damping_factor Damping of the smoother preconditioners.
+                     * \param precon_suffix Smoother preconditioner, "jac" or "spai" for vector and "spai" or "sainv" for matrix preconditioners.
+                     * \param theta Threshold of strong couplings.
+                     */
+                    static MGData<MatrixType_, VectorType_, TransferContType_, PreconContType_, DataType_> value(const MatrixType_ & A,
+                            const VectorType_ & b, const VectorType_ & x, unsigned long max_levels, unsigned long coarse_size,
+                            DataType_ damping_factor, std::string precon_suffix, DataType_ theta = DataType_(0.08))
+                    {
+                        CONTEXT("When creating MGData with smoothed aggregation AMG:");
+                        PROFILER_START("AMGUtil");
+
+                        if (A.rows() != A.columns())
+                            throw MatrixIsNotSquare(A.rows(), A.columns());
+
+                        // hierarchy from fine to coarse
+                        std::vector<SparseMatrix<DataType_> > systems(1, SparseMatrix<DataType_>(A));
+                        std::vector<SparseMatrix<DataType_> > prolongations, restrictions;
+                        while (systems.size() < max_levels && systems.back().rows() > coarse_size)
+                        {
+                            std::vector<unsigned long> aggregates;
+                            unsigned long count(AMGAggregation::value(aggregates, systems.back(), theta));
+                            if (count == 0 || count >= systems.back().rows())
+                                break;
+
+                            prolongations.push_back(_prolongation(_filter(systems.back(), theta), aggregates, count));
+                            restrictions.push_back(_transpose(prolongations.back()));
+                            systems.push_back(GalerkinProduct<Tag_>::value(restrictions.back(), systems.back(), prolongations.back()));
+                        }
+
+                        std::vector<MatrixType_> As;
+                        std::vector<TransferContType_> Prol;
+                        std::vector<TransferContType_> Res;
+                        std::vector<PreconContType_> P;
+                        std::vector<VectorType_> bs;
+                        std::vector<VectorType_> xs;
+                        std::vector<VectorType_> d;
+                        std::vector<VectorType_> c;
+                        std::vector<VectorType_> store;
+                        std::vector<std::vector<VectorType_> > smoother_temp;
+
+                        for (unsigned long level(systems.size()) ; level > 0 ; --level)
+                        {
+                            const unsigned long i(level - 1);
+                            MatrixType_ local_A(systems.at(i));
+                            As.push_back(local_A);
+                            AMGPreconFill<PreconContType_, MatrixType_, DataType_>::value(P, precon_suffix, local_A, damping_factor);
+
+                            if (i > 0)
+                            {
+                                TransferContType_ local_Prol(prolongations.at(i - 1));
+                                Prol.push_back(local_Prol);
+                                TransferContType_ local_Res(restrictions.at(i - 1));
+                                Res.push_back(local_Res);
+                            }
+
+                            VectorType_ zero(local_A.rows(), DataType_(0));
+                            if (i == 0)
+                            {
+                                bs.push_back(b);
+                                xs.push_back(x);
+                            }
+                            else
+                            {
+                                bs.push_back(zero.copy());
+                                xs.push_back(zero.copy());
+                            }
+                            d.push_back(zero.copy());
+                            c.push_back(zero.copy());
+                            store.push_back(zero.copy());
+                            smoother_temp.push_back(std::vector<VectorType_>());
+                        }
+
+                        PROFILER_STOP("AMGUtil");
+
+                        MGData<MatrixType_, VectorType_, TransferContType_, PreconContType_, DataType_> result(As, Res, Prol, P, bs, xs, d, c, store, smoother_temp, 0, 0, 0, 0, 0, DataType_(0.));
+                        return result;
+                    }
+            };
+}
+
+#endif
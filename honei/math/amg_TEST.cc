@@ -0,0 +1,167 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2011 Markus Geveler <apryde@gmx.de>
+ *
+ * This file is part of the HONEI C++ library. LibMath is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LibMath is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <honei/math/amg.hh>
+#include <honei/math/restriction.hh>
+#include <honei/math/prolongation.hh>
+#include <honei/math/cg.hh>
+#include <honei/math/ri.hh>
+#include <honei/math/matrix_io.hh>
+#include <honei/math/vector_io.hh>
+#include <honei/la/product.hh>
+#include <honei/la/sparse_matrix_ell.hh>
+#include <honei/util/unittest.hh>
+
+#include <cmath>
+#include <limits>
+
+using namespace honei;
+using namespace tests;
+using namespace std;
+
+template <typename Tag_, typename DT_>
+class GalerkinProductTest :
+    public QuickTest
+{
+    public:
+        GalerkinProductTest(const std::string & type) :
+            QuickTest("galerkin_product_test<" + type + ">")
+        {
+            register_tag(Tag_::name);
+        }
+
+        virtual void run() const
+        {
+            for (unsigned long size(10) ; size < 200 ; size *= 3)
+            {
+                const unsigned long coarse(size / 3 + 1);
+                SparseMatrix<DT_> a(size, size), p(size, coarse);
+                for (unsigned long i(0) ; i < size ; ++i)
+                {
+                    a(i, i, DT_(4));
+                    if (i > 0)
+                        a(i, i - 1, DT_(-1) - DT_(i % 3) / DT_(10));
+                    if (i + 7 < size)
+                        a(i, i + 7, DT_(-1));
+                    p(i, i / 3, DT_(1));
+                    if (i % 3 == 2 && i / 3 + 1 < coarse)
+                        p(i, i / 3 + 1, DT_(0.5));
+                }
+                SparseMatrix<DT_> r(p.columns(), p.rows());
+                for (unsigned long i(0) ; i < p.rows() ; ++i)
+                    for (unsigned long j(0) ; j < p.columns() ; ++j)
+                        if (p(i, j) != DT_(0))
+                            r(j, i, p(i, j));
+
+                SparseMatrix<DT_> ref(Product<tags::CPU>::value(r, Product<tags::CPU>::value(a, p)));
+                SparseMatrix<DT_> result(GalerkinProduct<Tag_>::value(r, a, p));
+
+                TEST_CHECK_EQUAL(result.rows(), coarse);
+                TEST_CHECK_EQUAL(result.columns(), coarse);
+                for (unsigned long i(0) ; i < coarse ; ++i)
+                    for (unsigned long j(0) ; j < coarse ; ++j)
+                        TEST_CHECK_EQUAL_WITHIN_EPS(((const SparseMatrix<DT_>)result)(i, j), ((const SparseMatrix<DT_>)ref)(i, j),
+                                std::numeric_limits<DT_>::epsilon() * 100);
+            }
+
+            SparseMatrix<DT_> a(4, 3), b(4, 3);
+            TEST_CHECK_THROWS(GalerkinProduct<Tag_>::value(a, b), MatrixRowsDoNotMatch);
+        }
+};
+GalerkinProductTest<tags::CPU, float> galerkin_product_test_float("float");
+GalerkinProductTest<tags::CPU, double> galerkin_product_test_double("double");
+GalerkinProductTest<tags::CPU::MultiCore, float> mc_galerkin_product_test_float("MC float");
+GalerkinProductTest<tags::CPU::MultiCore, double> mc_galerkin_product_test_double("MC double");
+
+template <typename Tag_>
+class AMGSolverTest :
+    public BaseTest
+{
+    public:
+        AMGSolverTest(const std::string & tag) :
+            BaseTest("AMGSolverTest<" + tag + ">")
+        {
+            register_tag(Tag_::name);
+        }
+
+        virtual void run() const
+        {
+            std::string file(HONEI_SOURCEDIR);
+            file += "/honei/math/testdata/poisson_advanced2/sort_0/";
+            SparseMatrixELL<double> A(MatrixIO<io_formats::ELL>::read_matrix(file + "A_6.ell", double(0)));
+            DenseVector<double> b(VectorIO<io_formats::EXP>::read_vector(file + "rhs_6", double(0)));
+            DenseVector<double> x(VectorIO<io_formats::EXP>::read_vector(file + "init_6", double(0)));
+
+            MGData<SparseMatrixELL<double>, DenseVector<double>, SparseMatrixELL<double>, DenseVector<double>, double> data(AMGUtil<Tag_,
+                    SparseMatrixELL<double>,
+                    DenseVector<double>,
+                    SparseMatrixELL<double>,
+                    DenseVector<double>,
+                    double>::value(A, b, x, 10, 100, double(0.7), "jac"));
+            MGUtil<Tag_,
+                SparseMatrixELL<double>,
+                DenseVector<double>,
+                SparseMatrixELL<double>,
+                DenseVector<double>,
+                MatrixIO<io_formats::ELL>,
+                VectorIO<io_formats::EXP>,
+                double>::configure(data, 100, 1000, 4, 4, 1, double(1e-6));
+
+            const unsigned long levels(data.A.size());
+            TEST_CHECK(levels > 2);
+            TEST_CHECK(data.A.at(0).rows() <= 100);
+            TEST_CHECK_EQUAL(data.A.at(levels - 1).rows(), A.rows());
+            TEST_CHECK_EQUAL(data.prolmat.size(), levels - 1);
+            TEST_CHECK_EQUAL(data.resmat.size(), levels - 1);
+            for (unsigned long i(0) ; i + 1 < levels ; ++i)
+            {
+                TEST_CHECK(data.A.at(i).rows() < data.A.at(i + 1).rows());
+                TEST_CHECK_EQUAL(data.prolmat.at(i).rows(), data.A.at(i + 1).rows());
+                TEST_CHECK_EQUAL(data.prolmat.at(i).columns(), data.A.at(i).rows());
+                TEST_CHECK_EQUAL(data.resmat.at(i).rows(), data.A.at(i).rows());
+                TEST_CHECK_EQUAL(data.resmat.at(i).columns(), data.A.at(i + 1).rows());
+                TEST_CHECK_EQUAL(data.P.at(i).size(), data.A.at(i).rows());
+            }
+
+            OperatorList ol(
+                    MGCycleCreation<Tag_,
+                    methods::CYCLE::V::STATIC,
+                    CGSolver<Tag_, methods::NONE>,
+                    RISmoother<Tag_>,
+                    Restriction<Tag_, methods::PROLMAT>,
+                    Prolongation<Tag_, methods::PROLMAT>,
+                    double>::value(data)
+                    );
+
+            MGSolver<Tag_, Norm<vnt_l_two, true, Tag_> >::value(data, ol);
+
+            std::cout << levels << " levels, " << data.used_iters << " iterations" << std::endl;
+            TEST_CHECK(data.used_iters < 50);
+
+            DenseVector<double> ref(VectorIO<io_formats::EXP>::read_vector(file + "sol_6", double(0)));
+            for (unsigned long i(0) ; i < ref.size() ; ++i)
+                TEST_CHECK_EQUAL_WITHIN_EPS(data.x.at(levels - 1)[i], ref[i], 1e-4);
+        }
+};
+AMGSolverTest<tags::CPU> amg_solver_test_cpu("double");
+AMGSolverTest<tags::CPU::MultiCore> mc_amg_solver_test_cpu("double");
+#ifdef HONEI_SSE
+AMGSolverTest<tags::CPU::SSE> sse_amg_solver_test_cpu("double");
+AMGSolverTest<tags::CPU::MultiCore::SSE> mcsse_amg_solver_test_cpu("double");
+#endif
@@ -33,6 +33,7 @@
 #include <honei/math/methods.hh>
 #include <honei/la/element_product.hh>
 #include <honei/la/algorithm.hh>
+#include <honei/la/expression.hh>
 #include <honei/util/profiler.hh>
 #include <honei/math/vectorpool.hh>
 #include <iostream>
@@ -40,6 +41,184 @@
 
 namespace honei
 {
+    namespace intern
+    {
+        /**
+         * The vector updates of one BiCGStab iteration, implemented by the separate BLAS-1 operations.
+         * Used for all backends without support for fused expressions.
+         */
+        template <typename Tag_>
+        struct BiCGStabOperations
+        {
+            /// s = r - alpha * v, returns ||s||^2
+            template <typename VectorType_>
+            static typename VectorType_::DataType update_s(VectorType_ & s, VectorType_ & r, VectorType_ & v,
+                    typename VectorType_::DataType malpha)
+            {
+                ScaledSum<Tag_>::value(s, r, v, malpha);
+                return Norm<vnt_l_two, false, Tag_>::value(s);
+            }
+
+            /// s~ = r~ - alpha * v~
+            template <typename VectorType_>
+            static void update_s_tilde(VectorType_ & s_tilde, VectorType_ & r_tilde, VectorType_ & v_tilde,
+                    typename VectorType_::DataType malpha)
+            {
+                ScaledSum<Tag_>::value(s_tilde, r_tilde, v_tilde, malpha);
+            }
+
+            /// gamma = <t~, t~>, omega = <t~, s~>
+            template <typename VectorType_>
+            static void dot_products(VectorType_ & t_tilde, VectorType_ & s_tilde,
+                    typename VectorType_::DataType & gamma, typename VectorType_::DataType & omega)
+            {
+                gamma = DotProduct<Tag_>::value(t_tilde, t_tilde);
+                omega = DotProduct<Tag_>::value(t_tilde, s_tilde);
+            }
+
+            /// x = x + omega * s~ + alpha * p~
+            template <typename VectorType_>
+            static void update_x(VectorType_ & x, VectorType_ & s_tilde, typename VectorType_::DataType omega,
+                    VectorType_ & p_tilde, typename VectorType_::DataType alpha)
+            {
+                ScaledSum<Tag_>::value(x, s_tilde, omega);
+                ScaledSum<Tag_>::value(x, p_tilde, alpha);
+            }
+
+            /// r = s - omega * t, returns ||r||^2
+            template <typename VectorType_>
+            static typename VectorType_::DataType update_r(VectorType_ & r, VectorType_ & s, VectorType_ & t,
+                    typename VectorType_::DataType momega)
+            {
+                ScaledSum<Tag_>::value(r, s, t, momega);
+                return Norm<vnt_l_two, false, Tag_>::value(r);
+            }
+
+            /// r~ = s~ - omega * t~, returns <r~, r~_0>
+            template <typename VectorType_>
+            static typename VectorType_::DataType update_r_tilde(VectorType_ & r_tilde, VectorType_ & s_tilde, VectorType_ & t_tilde,
+                    typename VectorType_::DataType momega, VectorType_ & r_tilde_0)
+            {
+                ScaledSum<Tag_>::value(r_tilde, s_tilde, t_tilde, momega);
+                return DotProduct<Tag_>::value(r_tilde, r_tilde_0);
+            }
+
+            /// p~ = r~ + beta * (p~ - omega * v~)
+            template <typename VectorType_>
+            static void update_p(VectorType_ & p_tilde, VectorType_ & r_tilde, typename VectorType_::DataType beta,
+                    VectorType_ & v_tilde, typename VectorType_::DataType momega)
+            {
+                ScaledSum<Tag_>::value(p_tilde, v_tilde, momega);
+                Scale<Tag_>::value(p_tilde, beta);
+                Sum<Tag_>::value(p_tilde, r_tilde);
+            }
+        };
+
+        /**
+         * The vector updates of one BiCGStab iteration, evaluated as fused expressions for DenseVectors.
+         * Every update reads its operands once and computes the following reduction in the same pass.
+         */
+        template <typename Tag_>
+        struct BiCGStabFusedOperations :
+            public BiCGStabOperations<Tag_>
+        {
+            using BiCGStabOperations<Tag_>::update_s;
+            using BiCGStabOperations<Tag_>::update_s_tilde;
+            using BiCGStabOperations<Tag_>::dot_products;
+            using BiCGStabOperations<Tag_>::update_x;
+            using BiCGStabOperations<Tag_>::update_r;
+            using BiCGStabOperations<Tag_>::update_r_tilde;
+            using BiCGStabOperations<Tag_>::update_p;
+
+            template <typename DT_>
+            static DT_ update_s(DenseVector<DT_> & s, DenseVector<DT_> & r, DenseVector<DT_> & v, DT_ malpha)
+            {
+                return Evaluate<Tag_>::norm_l2_false(s, lazy(r) + malpha * lazy(v));
+            }
+
+            template <typename DT_>
+            static void update_s_tilde(DenseVector<DT_> & s_tilde, DenseVector<DT_> & r_tilde, DenseVector<DT_> & v_tilde, DT_ malpha)
+            {
+                Evaluate<Tag_>::value(s_tilde, lazy(r_tilde) + malpha * lazy(v_tilde));
+            }
+
+            template <typename DT_>
+            static void dot_products(DenseVector<DT_> & t_tilde, DenseVector<DT_> & s_tilde, DT_ & gamma, DT_ & omega)
+            {
+                Evaluate<Tag_>::dot_products(lazy(t_tilde), lazy(t_tilde), lazy(t_tilde), lazy(s_tilde), gamma, omega);
+            }
+
+            template <typename DT_>
+            static void update_x(DenseVector<DT_> & x, DenseVector<DT_> & s_tilde, DT_ omega, DenseVector<DT_> & p_tilde, DT_ alpha)
+            {
+                Evaluate<Tag_>::value(x, lazy(x) + omega * lazy(s_tilde) + alpha * lazy(p_tilde));
+            }
+
+            template <typename DT_>
+            static DT_ update_r(DenseVector<DT_> & r, DenseVector<DT_> & s, DenseVector<DT_> & t, DT_ momega)
+            {
+                return Evaluate<Tag_>::norm_l2_false(r, lazy(s) + momega * lazy(t));
+            }
+
+            template <typename DT_>
+            static DT_ update_r_tilde(DenseVector<DT_> & r_tilde, DenseVector<DT_> & s_tilde, DenseVector<DT_> & t_tilde,
+                    DT_ momega, DenseVector<DT_> & r_tilde_0)
+            {
+                return Evaluate<Tag_>::dot_product(r_tilde, lazy(s_tilde) + momega * lazy(t_tilde), lazy(r_tilde_0));
+            }
+
+            template <typename DT_>
+            static void update_p(DenseVector<DT_> & p_tilde, DenseVector<DT_> & r_tilde, DT_ beta, DenseVector<DT_> & v_tilde, DT_ momega)
+            {
+                Evaluate<Tag_>::value(p_tilde, lazy(r_tilde) + beta * (lazy(p_tilde) + momega * lazy(v_tilde)));
+            }
+        };
+
+        template <typename Tag_>
+        struct BiCGStabKernels :
+            public BiCGStabOperations<Tag_>
+        {
+        };
+
+        template <>
+        struct BiCGStabKernels<tags::CPU> :
+            public BiCGStabFusedOperations<tags::CPU>
+        {
+        };
+
+        template <>
+        struct BiCGStabKernels<tags::CPU::Generic> :
+            public BiCGStabFusedOperations<tags::CPU::Generic>
+        {
+        };
+
+        template <>
+        struct BiCGStabKernels<tags::CPU::MultiCore> :
+            public BiCGStabFusedOperations<tags::CPU::MultiCore>
+        {
+        };
+
+        template <>
+        struct BiCGStabKernels<tags::CPU::MultiCore::Generic> :
+            public BiCGStabFusedOperations<tags::CPU::MultiCore::Generic>
+        {
+        };
+
+#if defined (HONEI_SSE)
+        template <>
+        struct BiCGStabKernels<tags::CPU::SSE> :
+            public BiCGStabFusedOperations<tags::CPU::SSE>
+        {
+        };
+
+        template <>
+        struct BiCGStabKernels<tags::CPU::MultiCore::SSE> :
+            public BiCGStabFusedOperations<tags::CPU::MultiCore::SSE>
+        {
+        };
+#endif
+    }
+
     /**
      * \brief Solution of linear system with BiCGStab.
      *
@@ -140,9 +319,7 @@ namespace honei
                         }
 
                         DT_ malpha_tilde(-alpha_tilde);
-                        ScaledSum<Tag_>::value(s, r, v, malpha_tilde);
-
-                        defnorm = Norm<vnt_l_two, false, Tag_>::value(s);
+                        defnorm = intern::BiCGStabKernels<Tag_>::update_s(s, r, v, malpha_tilde);
                         if (defnorm < eps_relative * defnorm_00)
                         {
                             ScaledSum<Tag_>::value(x, p_tilde, alpha_tilde);
@@ -151,14 +328,13 @@ namespace honei
                             //std::cout << "Breakpoint 3 (converged)" << std::endl;
                             break;
                         }
-                        ScaledSum<Tag_>::value(s_tilde, r_tilde, v_tilde, malpha_tilde);
+                        intern::BiCGStabKernels<Tag_>::update_s_tilde(s_tilde, r_tilde, v_tilde, malpha_tilde);
 
                         Product<Tag_>::value(t, A, s_tilde);
 
                         Product<Tag_>::value(t_tilde, P, t);
 
-                        gamma_tilde = DotProduct<Tag_>::value(t_tilde, t_tilde);
-                        omega_tilde = DotProduct<Tag_>::value(t_tilde, s_tilde);
+                        intern::BiCGStabKernels<Tag_>::dot_products(t_tilde, s_tilde, gamma_tilde, omega_tilde);
 
                         if (std::abs(gamma_tilde) < std::abs(omega_tilde) * 1e-14)
                         {
@@ -168,13 +344,10 @@ namespace honei
                         }
                         omega_tilde = omega_tilde / gamma_tilde;
 
-                        ScaledSum<Tag_>::value(x, s_tilde, omega_tilde);
-                        ScaledSum<Tag_>::value(x, p_tilde, alpha_tilde);
+                        intern::BiCGStabKernels<Tag_>::update_x(x, s_tilde, omega_tilde, p_tilde, alpha_tilde);
 
                         DT_ momega_tilde(-omega_tilde);
-                        ScaledSum<Tag_>::value(r, s, t, momega_tilde);
-
-                        defnorm = Norm<vnt_l_two, false, Tag_>::value(r);
+                        defnorm = intern::BiCGStabKernels<Tag_>::update_r(r, s, t, momega_tilde);
                         if (defnorm < eps_relative * defnorm_00)
                         {
                             converged = 1;
@@ -182,16 +355,12 @@ namespace honei
                             break;
                         }
 
-                        ScaledSum<Tag_>::value(r_tilde, s_tilde, t_tilde, momega_tilde);
-
                         rho_tilde_old = rho_tilde;
-                        rho_tilde = DotProduct<Tag_>::value(r_tilde, r_tilde_0);
+                        rho_tilde = intern::BiCGStabKernels<Tag_>::update_r_tilde(r_tilde, s_tilde, t_tilde, momega_tilde, r_tilde_0);
 
                         beta_tilde = (alpha_tilde / omega_tilde) * (rho_tilde / rho_tilde_old);
 
-                        ScaledSum<Tag_>::value(p_tilde, v_tilde, momega_tilde);
-                        Scale<Tag_>::value(p_tilde, beta_tilde);
-                        Sum<Tag_>::value(p_tilde, r_tilde);
+                        intern::BiCGStabKernels<Tag_>::update_p(p_tilde, r_tilde, beta_tilde, v_tilde, momega_tilde);
 
                     } while (iter <= max_iters);
 
@@ -282,25 +451,15 @@ namespace honei
 
                         alpha_tilde = rho_tilde / gamma_tilde;
 
-                        if ((std::abs(alpha_tilde) * Norm<vnt_l_two, false, Tag_>::value(v_tilde)) / defnorm < 1e-5)
-                        {
-                            //std::cout << "Breakpoint 2" << std::endl;
-                            // \TODO warum ist das break hier nicht aktiv?
-                            //break;
-                        }
-
                         typename VectorType_::DataType malpha_tilde(-alpha_tilde);
-                        ScaledSum<Tag_>::value(s, r, v, malpha_tilde);
-
-                        defnorm = Norm<vnt_l_two, false, Tag_>::value(s);
-                        ScaledSum<Tag_>::value(s_tilde, r_tilde, v_tilde, malpha_tilde);
+                        defnorm = intern::BiCGStabKernels<Tag_>::update_s(s, r, v, malpha_tilde);
+                        intern::BiCGStabKernels<Tag_>::update_s_tilde(s_tilde, r_tilde, v_tilde, malpha_tilde);
 
                         Product<Tag_>::value(t, A, s_tilde);
 
                         Product<Tag_>::value(t_tilde, P, t);
 
-                        gamma_tilde = DotProduct<Tag_>::value(t_tilde, t_tilde);
-                        omega_tilde = DotProduct<Tag_>::value(t_tilde, s_tilde);
+                        intern::BiCGStabKernels<Tag_>::dot_products(t_tilde, s_tilde, gamma_tilde, omega_tilde);
 
                         if (std::abs(gamma_tilde) < std::abs(omega_tilde) * 1e-14)
                         {
@@ -309,24 +468,17 @@ namespace honei
                         }
                         omega_tilde = omega_tilde / gamma_tilde;
 
-                        ScaledSum<Tag_>::value(x, s_tilde, omega_tilde);
-                        ScaledSum<Tag_>::value(x, p_tilde, alpha_tilde);
+                        intern::BiCGStabKernels<Tag_>::update_x(x, s_tilde, omega_tilde, p_tilde, alpha_tilde);
 
                         typename VectorType_::DataType momega_tilde(-omega_tilde);
-                        ScaledSum<Tag_>::value(r, s, t, momega_tilde);
-
-                        defnorm = Norm<vnt_l_two, false, Tag_>::value(r);
-
-                        ScaledSum<Tag_>::value(r_tilde, s_tilde, t_tilde, momega_tilde);
+                        defnorm = intern::BiCGStabKernels<Tag_>::update_r(r, s, t, momega_tilde);
 
                         rho_tilde_old = rho_tilde;
-                        rho_tilde = DotProduct<Tag_>::value(r_tilde, r_tilde_0);
+                        rho_tilde = intern::BiCGStabKernels<Tag_>::update_r_tilde(r_tilde, s_tilde, t_tilde, momega_tilde, r_tilde_0);
 
                         beta_tilde = (alpha_tilde / omega_tilde) * (rho_tilde / rho_tilde_old);
 
-                        ScaledSum<Tag_>::value(p_tilde, v_tilde, momega_tilde);
-                        Scale<Tag_>::value(p_tilde, beta_tilde);
-                        Sum<Tag_>::value(p_tilde, r_tilde);
+                        intern::BiCGStabKernels<Tag_>::update_p(p_tilde, r_tilde, beta_tilde, v_tilde, momega_tilde);
 
                     } while (iter <= max_iters);
 
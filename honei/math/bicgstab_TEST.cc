@@ -31,7 +31,7 @@ using namespace honei;
 using namespace tests;
 using namespace std;
 
-template <typename Tag_, typename DT1_>
+template <typename Tag_, typename DT1_, typename MT_ = DT1_>
 class BiCGStabSolverTestSparseELLPrecon:
     public BaseTest
 {
@@ -58,7 +58,7 @@ class BiCGStabSolverTestSparseELLPrecon:
             std::string filename(HONEI_SOURCEDIR);
             filename += "/honei/math/testdata/poisson_advanced/sort_0/";
             filename += _m_f;
-            SparseMatrixELL<DT1_> smatrix2(MatrixIO<io_formats::ELL>::read_matrix(filename, DT1_(0)));
+            SparseMatrixELL<MT_> smatrix2(MatrixIO<io_formats::ELL>::read_matrix(filename, MT_(0)));
 
             std::string filename_2(HONEI_SOURCEDIR);
             filename_2 += "/honei/math/testdata/poisson_advanced/sort_0/";
@@ -111,7 +111,7 @@ class BiCGStabSolverTestSparseELLPrecon:
         }
 };
 BiCGStabSolverTestSparseELLPrecon<tags::CPU, double> cg_precon_test_double_sparse_ell("double JAC", "A_7.ell", "rhs_7", "sol_7", "init_7");
-//BiCGStabSolverTestSparseELLPrecon<tags::CPU::MultiCore, double> mc_cg_precon_test_double_sparse_ell("double JAC", "A_7.ell", "rhs_7", "sol_7", "init_7");
+BiCGStabSolverTestSparseELLPrecon<tags::CPU::MultiCore, double> mc_cg_precon_test_double_sparse_ell("double JAC", "A_7.ell", "rhs_7", "sol_7", "init_7");
 BiCGStabSolverTestSparseELLPrecon<tags::CPU::Generic, double> generic_cg_precon_test_double_sparse_ell("double JAC", "A_7.ell", "rhs_7", "sol_7", "init_7");
 BiCGStabSolverTestSparseELLPrecon<tags::CPU::MultiCore::Generic, double> generic_mc_cg_precon_test_double_sparse_ell("double JAC", "A_7.ell", "rhs_7", "sol_7", "init_7");
 #ifdef HONEI_GMP
@@ -121,6 +121,8 @@ BiCGStabSolverTestSparseELLPrecon<tags::CPU::MultiCore::Generic, mpf_class> gene
 #ifdef HONEI_SSE
 BiCGStabSolverTestSparseELLPrecon<tags::CPU::SSE, double> sse_cg_precon_test_double_sparse_ell("double JAC", "A_7.ell", "rhs_7", "sol_7", "init_7");
 BiCGStabSolverTestSparseELLPrecon<tags::CPU::MultiCore::SSE, double> mcsse_cg_precon_test_double_sparse_ell("double JAC", "A_7.ell", "rhs_7", "sol_7", "init_7");
+BiCGStabSolverTestSparseELLPrecon<tags::CPU::SSE, double, float> mixed_sse_cg_precon_test_double_sparse_ell("double/float JAC", "A_7.ell", "rhs_7", "sol_7", "init_7");
+BiCGStabSolverTestSparseELLPrecon<tags::CPU::MultiCore::SSE, double, float> mixed_mcsse_cg_precon_test_double_sparse_ell("double/float JAC", "A_7.ell", "rhs_7", "sol_7", "init_7");
 #endif
 #ifdef HONEI_CUDA
 #ifdef HONEI_CUDA_DOUBLE
@@ -0,0 +1,153 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2011 Dirk Ribbrock <dirk.ribbrock@math.uni-dortmund.de>
+ *
+ * This file is part of the MATH C++ library. LibMath is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LibMath is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#pragma once
+#ifndef LIBMATH_GUARD_BLOCK_JACOBI_HH
+#define LIBMATH_GUARD_BLOCK_JACOBI_HH 1
+
+#include <honei/util/tags.hh>
+#include <honei/la/sparse_matrix_bsr.hh>
+#include <honei/util/exception.hh>
+#include <honei/util/stringify.hh>
+
+#include <cmath>
+
+namespace honei
+{
+    /**
+     * \brief BlockJacobi creates the block Jacobi preconditioner of a SparseMatrixBSR.
+     *
+     * The result holds the damped inverses of the diagonal blocks as a block diagonal SparseMatrixBSR.
+     * Used as preconditioner container in RISmoother or RISolver, it turns the preconditioned
+     * Richardson iteration into a damped block Jacobi smoother, that solves all R_ coupled
+     * components of a node at once.
+     *
+     * \ingroup grpmatrixoperations
+     */
+    template <typename Tag_ = tags::CPU>
+    struct BlockJacobi
+    {
+        /**
+         * Inverts a dense block in place with Gauss Jordan elimination and partial pivoting.
+         *
+         * \param block The column major R_ x R_ block to be inverted.
+         * \param block_row The block row the block belongs to, for error messages only.
+         */
+        template <typename DT_, unsigned long R_>
+        static void invert(DT_ * block, unsigned long block_row)
+        {
+            DT_ a[R_][2 * R_];
+            for (unsigned long r(0) ; r < R_ ; ++r)
+                for (unsigned long c(0) ; c < R_ ; ++c)
+                {
+                    a[r][c] = block[c * R_ + r];
+                    a[r][R_ + c] = r == c ? DT_(1) : DT_(0);
+                }
+
+            for (unsigned long c(0) ; c < R_ ; ++c)
+            {
+                unsigned long pivot(c);
+                for (unsigned long r(c + 1) ; r < R_ ; ++r)
+                    if (std::abs(a[r][c]) > std::abs(a[pivot][c]))
+                        pivot = r;
+
+                if (a[pivot][c] == DT_(0))
+                    throw InternalError("BlockJacobi: diagonal block " + stringify(block_row) + " is singular!");
+
+                if (pivot != c)
+                    for (unsigned long k(0) ; k < 2 * R_ ; ++k)
+                    {
+                        DT_ t(a[c][k]);
+                        a[c][k] = a[pivot][k];
+                        a[pivot][k] = t;
+                    }
+
+                const DT_ scal(DT_(1) / a[c][c]);
+                for (unsigned long k(0) ; k < 2 * R_ ; ++k)
+                    a[c][k] *= scal;
+
+                for (unsigned long r(0) ; r < R_ ; ++r)
+                {
+                    if (r == c || a[r][c] == DT_(0))
+                        continue;
+                    const DT_ factor(a[r][c]);
+                    for (unsigned long k(0) ; k < 2 * R_ ; ++k)
+                        a[r][k] -= factor * a[c][k];
+                }
+            }
+
+            for (unsigned long r(0) ; r < R_ ; ++r)
+                for (unsigned long c(0) ; c < R_ ; ++c)
+                    block[c * R_ + r] = a[r][R_ + c];
+        }
+
+        /**
+         * Creates the block Jacobi preconditioner.
+         *
+         * \param a The system matrix, every block row needs a regular diagonal block.
+         * \param damping_factor The damping factor all inverted blocks are scaled with.
+         *
+         * \retval The damped inverse of the block diagonal of a.
+         */
+        template <typename DT_, unsigned long R_>
+        static SparseMatrixBSR<DT_, R_> value(const SparseMatrixBSR<DT_, R_> & a, DT_ damping_factor = DT_(1))
+        {
+            CONTEXT("When creating block Jacobi preconditioner:");
+
+            if (a.rows() != a.columns())
+                throw InternalError("BlockJacobi: matrix with " + stringify(a.rows()) + " rows and "
+                        + stringify(a.columns()) + " columns is not square!");
+
+            const unsigned long block_rows(a.block_rows());
+            DenseVector<unsigned long> Ar(block_rows + 1);
+            DenseVector<unsigned long> Aj(block_rows == 0 ? 1 : block_rows);
+            DenseVector<DT_> Ax(block_rows == 0 ? 1 : block_rows * R_ * R_, DT_(0));
+            unsigned long used_elements(0);
+
+            for (unsigned long block_row(0) ; block_row < block_rows ; ++block_row)
+            {
+                Ar[block_row] = block_row;
+                Aj[block_row] = block_row;
+
+                unsigned long i(a.Ar()[block_row]);
+                while (i < a.Ar()[block_row + 1] && a.Aj()[i] != block_row)
+                    ++i;
+                if (i == a.Ar()[block_row + 1])
+                    throw InternalError("BlockJacobi: block row " + stringify(block_row) + " has no diagonal block!");
+
+                DT_ * block(Ax.elements() + block_row * R_ * R_);
+                for (unsigned long k(0) ; k < R_ * R_ ; ++k)
+                    block[k] = a.Ax()[i * R_ * R_ + k];
+
+                invert<DT_, R_>(block, block_row);
+
+                for (unsigned long k(0) ; k < R_ * R_ ; ++k)
+                {
+                    block[k] *= damping_factor;
+                    if (block[k] != DT_(0))
+                        ++used_elements;
+                }
+            }
+            Ar[block_rows] = block_rows;
+
+            return SparseMatrixBSR<DT_, R_>(a.rows(), a.columns(), Ar, Aj, Ax, used_elements);
+        }
+    };
+}
+#endif
@@ -0,0 +1,156 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2011 Dirk Ribbrock <dirk.ribbrock@math.uni-dortmund.de>
+ *
+ * This file is part of the MATH C++ library. LibMath is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LibMath is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <honei/math/block_jacobi.hh>
+#include <honei/math/mg.hh>
+#include <honei/math/ri.hh>
+#include <honei/la/norm.hh>
+#include <honei/la/product.hh>
+#include <honei/util/unittest.hh>
+
+using namespace honei;
+using namespace tests;
+
+namespace
+{
+    /// Creates a 5 point laplacian on a root x root grid, with R_ coupled components per node.
+    template <typename DT_, unsigned long R_>
+    SparseMatrixBSR<DT_, R_> coupled(unsigned long root)
+    {
+        const unsigned long nodes(root * root);
+        SparseMatrix<DT_> result(nodes * R_, nodes * R_);
+        for (unsigned long node(0) ; node < nodes ; ++node)
+        {
+            const unsigned long x(node % root), y(node / root);
+            for (unsigned long r(0) ; r < R_ ; ++r)
+            {
+                for (unsigned long c(0) ; c < R_ ; ++c)
+                    result(node * R_ + r, node * R_ + c) = r == c ? DT_(6 + r) : DT_(-1) / DT_(2);
+
+                if (x > 0)
+                    result(node * R_ + r, (node - 1) * R_ + r) = DT_(-1);
+                if (x < root - 1)
+                    result(node * R_ + r, (node + 1) * R_ + r) = DT_(-1);
+                if (y > 0)
+                    result(node * R_ + r, (node - root) * R_ + r) = DT_(-1);
+                if (y < root - 1)
+                    result(node * R_ + r, (node + root) * R_ + r) = DT_(-1);
+            }
+        }
+
+        return SparseMatrixBSR<DT_, R_>(result);
+    }
+}
+
+template <typename DT_, unsigned long R_>
+class BlockJacobiInverseTest:
+    public BaseTest
+{
+    public:
+        BlockJacobiInverseTest(const std::string & tag) :
+            BaseTest("BlockJacobi inverse test <" + tag + ", " + stringify(R_) + ">")
+        {
+        }
+
+        virtual void run() const
+        {
+            SparseMatrixBSR<DT_, R_> a(coupled<DT_, R_>(5));
+            SparseMatrixBSR<DT_, R_> p(BlockJacobi<tags::CPU>::value(a, DT_(0.5)));
+
+            TEST_CHECK_EQUAL(p.used_blocks(), a.block_rows());
+            for (unsigned long block_row(0) ; block_row < a.block_rows() ; ++block_row)
+                for (unsigned long r(0) ; r < R_ ; ++r)
+                    for (unsigned long c(0) ; c < R_ ; ++c)
+                    {
+                        DT_ sum(0);
+                        for (unsigned long k(0) ; k < R_ ; ++k)
+                            sum += p(block_row * R_ + r, block_row * R_ + k) * a(block_row * R_ + k, block_row * R_ + c);
+                        TEST_CHECK_EQUAL_WITHIN_EPS(sum, r == c ? DT_(0.5) : DT_(0), 1e-5);
+                    }
+
+            std::vector<SparseMatrixBSR<DT_, R_> > target;
+            PreconFill<SparseMatrixBSR<DT_, R_>, SparseMatrixBSR<DT_, R_>, DT_>::value(0, target, "", "jac", a, DT_(0.5));
+            TEST_CHECK_EQUAL(target.at(0), p);
+            TEST_CHECK_THROWS((PreconFill<SparseMatrixBSR<DT_, R_>, SparseMatrixBSR<DT_, R_>, DT_>::value(0, target, "", "spai", a, DT_(0.5))),
+                    InternalError);
+
+            SparseMatrix<DT_> singular(2 * R_, 2 * R_);
+            singular(0, 0) = DT_(1);
+            singular(R_, R_ + 1) = DT_(1);
+            TEST_CHECK_THROWS(BlockJacobi<tags::CPU>::value(SparseMatrixBSR<DT_, R_>(singular)), InternalError);
+        }
+};
+BlockJacobiInverseTest<float, 2> block_jacobi_inverse_test_float_2("float");
+BlockJacobiInverseTest<double, 3> block_jacobi_inverse_test_double_3("double");
+BlockJacobiInverseTest<double, 4> block_jacobi_inverse_test_double_4("double");
+
+template <typename Tag_, typename DT_, unsigned long R_>
+class BlockJacobiSmootherTest:
+    public BaseTest
+{
+    public:
+        BlockJacobiSmootherTest(const std::string & tag) :
+            BaseTest("BlockJacobi smoother test <" + tag + ", " + stringify(R_) + ">")
+        {
+            register_tag(Tag_::name);
+        }
+
+        virtual void run() const
+        {
+            SparseMatrixBSR<DT_, R_> a(coupled<DT_, R_>(20));
+            SparseMatrixBSR<DT_, R_> p(BlockJacobi<tags::CPU>::value(a, DT_(0.8)));
+
+            DenseVector<DT_> b(a.rows(), DT_(1));
+            DenseVector<DT_> x(a.rows(), DT_(0));
+            std::vector<DenseVector<DT_> > temp;
+            temp.push_back(DenseVector<DT_>(a.rows()));
+            temp.push_back(DenseVector<DT_>(a.rows()));
+
+            DenseVector<DT_> defect(a.rows());
+            Defect<Tag_>::value(defect, b, a, x);
+            DT_ last(Norm<vnt_l_two, true, Tag_>::value(defect));
+            const DT_ initial(last);
+
+            // every sweep of the damped block jacobi method reduces the defect of this diagonal dominant system
+            for (unsigned long i(0) ; i < 10 ; ++i)
+            {
+                RISmoother<Tag_>::value(a, p, b, x, temp, 1ul);
+                Defect<Tag_>::value(defect, b, a, x);
+                DT_ current(Norm<vnt_l_two, true, Tag_>::value(defect));
+                TEST_CHECK(current < last);
+                last = current;
+            }
+            TEST_CHECK(last < initial / DT_(10));
+
+            unsigned long used_iters(0);
+            RISolver<Tag_>::value(a, p, b, x, temp[0], temp[1], 1000ul, used_iters, DT_(1e-6));
+            Defect<Tag_>::value(defect, b, a, x);
+            std::cout << "Used iters: " << used_iters << std::endl;
+            const DT_ final(Norm<vnt_l_two, true, Tag_>::value(defect));
+            TEST_CHECK(final < DT_(1e-5) * initial);
+        }
+};
+BlockJacobiSmootherTest<tags::CPU, double, 2> block_jacobi_smoother_test_double_2("double");
+BlockJacobiSmootherTest<tags::CPU, double, 3> block_jacobi_smoother_test_double_3("double");
+BlockJacobiSmootherTest<tags::CPU::MultiCore, double, 2> mc_block_jacobi_smoother_test_double_2("double");
+#ifdef HONEI_SSE
+BlockJacobiSmootherTest<tags::CPU::SSE, float, 3> sse_block_jacobi_smoother_test_float_3("float");
+BlockJacobiSmootherTest<tags::CPU::SSE, double, 4> sse_block_jacobi_smoother_test_double_4("double");
+BlockJacobiSmootherTest<tags::CPU::MultiCore::SSE, double, 2> mcsse_block_jacobi_smoother_test_double_2("double");
+#endif
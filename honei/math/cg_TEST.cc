@@ -26,12 +26,14 @@
 #include <iomanip>
 #include <honei/math/fill_matrix.hh>
 #include <honei/math/fill_vector.hh>
+#include <honei/la/stencil_matrix_q1.hh>
+#include <honei/la/sparse_matrix_csr_symmetric.hh>
 
 using namespace honei;
 using namespace tests;
 using namespace std;
 
-template <typename Tag_, typename DT1_>
+template <typename Tag_, typename DT1_, typename MT_ = DT1_>
 class CGSolverTestSparseELL:
     public BaseTest
 {
@@ -58,7 +60,7 @@ class CGSolverTestSparseELL:
             std::string filename(HONEI_SOURCEDIR);
             filename += "/honei/math/testdata/poisson_advanced/sort_0/";
             filename += _m_f;
-            SparseMatrixELL<DT1_> smatrix2(MatrixIO<io_formats::ELL>::read_matrix(filename, DT1_(0)));
+            SparseMatrixELL<MT_> smatrix2(MatrixIO<io_formats::ELL>::read_matrix(filename, MT_(0)));
 
             std::string filename_2(HONEI_SOURCEDIR);
             filename_2 += "/honei/math/testdata/poisson_advanced/sort_0/";
@@ -122,6 +124,7 @@ CGSolverTestSparseELL<tags::CPU, double> cg_test_double_sparse_ell("double", "A_
 CGSolverTestSparseELL<tags::CPU::MultiCore, double> mc_cg_test_double_sparse_ell("double", "A_7.ell", "rhs_7", "sol_7", "init_7");
 CGSolverTestSparseELL<tags::CPU::Generic, double> generic_cg_test_double_sparse_ell("double", "A_7.ell", "rhs_7", "sol_7", "init_7");
 CGSolverTestSparseELL<tags::CPU::MultiCore::Generic, double> generic_mc_cg_test_double_sparse_ell("double", "A_7.ell", "rhs_7", "sol_7", "init_7");
+CGSolverTestSparseELL<tags::CPU, double, float> mixed_cg_test_double_sparse_ell("double/float", "A_7.ell", "rhs_7", "sol_7", "init_7");
 #ifdef HONEI_GMP
 CGSolverTestSparseELL<tags::CPU::Generic, mpf_class> generic_cg_test_mpf_class_sparse_ell_mpf_class("mpf_class", "A_7.ell", "rhs_7", "sol_7", "init_7");
 CGSolverTestSparseELL<tags::CPU::MultiCore::Generic, mpf_class> generic_mc_cg_test_mpf_class_sparse_ell_mpf_class("mpf_class", "A_7.ell", "rhs_7", "sol_7", "init_7");
@@ -129,6 +132,8 @@ CGSolverTestSparseELL<tags::CPU::MultiCore::Generic, mpf_class> generic_mc_cg_te
 #ifdef HONEI_SSE
 CGSolverTestSparseELL<tags::CPU::SSE, double> sse_cg_test_double_sparse_ell("double", "A_7.ell", "rhs_7", "sol_7", "init_7");
 CGSolverTestSparseELL<tags::CPU::MultiCore::SSE, double> mcsse_cg_test_double_sparse_ell("double", "A_7.ell", "rhs_7", "sol_7", "init_7");
+CGSolverTestSparseELL<tags::CPU::SSE, double, float> mixed_sse_cg_test_double_sparse_ell("double/float", "A_7.ell", "rhs_7", "sol_7", "init_7");
+CGSolverTestSparseELL<tags::CPU::MultiCore::SSE, double, float> mixed_mcsse_cg_test_double_sparse_ell("double/float", "A_7.ell", "rhs_7", "sol_7", "init_7");
 #endif
 #ifdef HONEI_CUDA
 #ifdef HONEI_CUDA_DOUBLE
@@ -458,3 +463,109 @@ CGSolverTestSparseELLQuadPrecon<tags::OpenCL::CPU, double> ocl_cpu_cg_precon_tes
 CGSolverTestSparseELLQuadPrecon<tags::OpenCL::GPU, double> ocl_gpu_cg_precon_test_double_sparse_ell_quad("double JAC", "A_6.ell", "rhs_6", "sol_6", "init_6");
 #endif
 #endif
+
+template <typename Tag_, typename DT1_>
+class CGSolverTestStencilQ1:
+    public BaseTest
+{
+    private:
+        unsigned long _size;
+    public:
+        CGSolverTestStencilQ1(const std::string & tag, unsigned long size) :
+            BaseTest("CGSolver solver test (stencil Q1 system)<" + tag + ">")
+        {
+            register_tag(Tag_::name);
+            _size = size;
+        }
+
+        virtual void run() const
+        {
+            DenseVector<DT1_> null(_size, DT1_(0));
+            BandedMatrixQx<Q1Type, DT1_> banded(_size, null.copy(), null.copy(), null.copy(), null.copy(), null.copy(),
+                    null.copy(), null.copy(), null.copy(), null.copy());
+            FillMatrix<tags::CPU, applications::POISSON, boundary_types::DIRICHLET::DIRICHLET_0>::value(banded);
+
+            DT1_ o(DT1_(-1) / DT1_(3));
+            StencilMatrixQ1<DT1_> stencil(_size, o, o, o, o, DT1_(8) / DT1_(3), o, o, o, o);
+
+            DenseVector<DT1_> rhs(_size, DT1_(1));
+            for (unsigned long i(0) ; i < _size ; ++i)
+                if (stencil.boundary(i))
+                    rhs[i] = DT1_(0);
+
+            DenseVector<DT1_> ref_result(_size, DT1_(0));
+            DenseVector<DT1_> result(_size, DT1_(0));
+            unsigned long used_iters, ref_iters;
+            CGSolver<tags::CPU, methods::NONE>::value(banded, rhs, rhs, ref_result, 10000ul, ref_iters, DT1_(1e-8));
+            CGSolver<Tag_, methods::NONE>::value(stencil, rhs, rhs, result, 10000ul, used_iters, DT1_(1e-8));
+
+            std::cout << "Used iters: " << used_iters << ", banded reference: " << ref_iters << std::endl;
+
+            TEST_CHECK(used_iters <= ref_iters + 1);
+            for(unsigned long i(0) ; i < result.size() ; ++i)
+            {
+                TEST_CHECK_EQUAL_WITHIN_EPS(result[i], ref_result[i], 1e-6);
+            }
+        }
+};
+CGSolverTestStencilQ1<tags::CPU, double> cg_test_double_stencil_q1("double", 16641ul);
+CGSolverTestStencilQ1<tags::CPU::MultiCore, double> mc_cg_test_double_stencil_q1("double", 16641ul);
+CGSolverTestStencilQ1<tags::CPU::Generic, double> generic_cg_test_double_stencil_q1("double", 16641ul);
+CGSolverTestStencilQ1<tags::CPU::MultiCore::Generic, double> generic_mc_cg_test_double_stencil_q1("double", 16641ul);
+#ifdef HONEI_SSE
+CGSolverTestStencilQ1<tags::CPU::SSE, double> sse_cg_test_double_stencil_q1("double", 16641ul);
+CGSolverTestStencilQ1<tags::CPU::MultiCore::SSE, double> mcsse_cg_test_double_stencil_q1("double", 16641ul);
+#endif
+
+template <typename Tag_, typename DT1_>
+class CGSolverTestSparseCSRSymmetric:
+    public BaseTest
+{
+    private:
+        unsigned long _size;
+    public:
+        CGSolverTestSparseCSRSymmetric(const std::string & tag, unsigned long size) :
+            BaseTest("CGSolver solver test (symmetric sparse CSR system)<" + tag + ">")
+        {
+            register_tag(Tag_::name);
+            _size = size;
+        }
+
+        virtual void run() const
+        {
+            DenseVector<DT1_> null(_size, DT1_(0));
+            BandedMatrixQx<Q1Type, DT1_> banded(_size, null.copy(), null.copy(), null.copy(), null.copy(), null.copy(),
+                    null.copy(), null.copy(), null.copy(), null.copy());
+            FillMatrix<tags::CPU, applications::POISSON, boundary_types::DIRICHLET::DIRICHLET_0>::value(banded);
+
+            // the dirichlet rows of the filled matrix are unit rows, keep the system symmetric by eliminating their columns
+            SparseMatrix<DT1_> sparse(banded);
+            for (unsigned long row(0) ; row < _size ; ++row)
+                for (unsigned long i(0) ; i < sparse[row].used_elements() ; ++i)
+                    if (sparse[row].indices()[i] != row && sparse(sparse[row].indices()[i], row) == DT1_(0))
+                        sparse[row].elements()[i] = DT1_(0);
+            SparseMatrixELL<DT1_> ell(sparse);
+            SparseMatrixCSRSymmetric<DT1_> symmetric(sparse);
+
+            DenseVector<DT1_> rhs(_size, DT1_(1));
+            DenseVector<DT1_> ref_result(_size, DT1_(0));
+            DenseVector<DT1_> result(_size, DT1_(0));
+            unsigned long used_iters, ref_iters;
+            CGSolver<tags::CPU, methods::NONE>::value(ell, rhs, rhs, ref_result, 10000ul, ref_iters, DT1_(1e-8));
+            CGSolver<Tag_, methods::NONE>::value(symmetric, rhs, rhs, result, 10000ul, used_iters, DT1_(1e-8));
+
+            std::cout << "Used iters: " << used_iters << ", full storage reference: " << ref_iters << std::endl;
+
+            TEST_CHECK(used_iters <= ref_iters + 1);
+            for(unsigned long i(0) ; i < result.size() ; ++i)
+            {
+                TEST_CHECK_EQUAL_WITHIN_EPS(result[i], ref_result[i], 1e-6);
+            }
+        }
+};
+CGSolverTestSparseCSRSymmetric<tags::CPU, double> cg_test_double_sparse_csr_symmetric("double", 4225ul);
+CGSolverTestSparseCSRSymmetric<tags::CPU::MultiCore, double> mc_cg_test_double_sparse_csr_symmetric("double", 4225ul);
+#ifdef HONEI_SSE
+CGSolverTestSparseCSRSymmetric<tags::CPU::SSE, double> sse_cg_test_double_sparse_csr_symmetric("double", 4225ul);
+CGSolverTestSparseCSRSymmetric<tags::CPU::MultiCore::SSE, double> mcsse_cg_test_double_sparse_csr_symmetric("double", 4225ul);
+#endif
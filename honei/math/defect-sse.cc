@@ -30,320 +30,34 @@ using namespace honei;
 
 namespace honei
 {
-    DenseVector<float> & Defect<tags::CPU::SSE>::value(DenseVector<float> & result, const DenseVector<float> & right_hand_side, const BandedMatrixQx<Q1Type, float> & system, const DenseVector<float> & x)
+    DenseVector<float> & Defect<tags::CPU::SSE>::value(DenseVector<float> & result, const DenseVector<float> & right_hand_side, const BandedMatrixQx<Q1Type, float> & system, const DenseVector<float> & x,
+            unsigned long row_start, unsigned long row_end)
     {
-        unsigned long n = right_hand_side.size();
-        unsigned long root_n = (unsigned long)sqrt(n);
-
-        float * b = right_hand_side.elements();
-        float * x_old = x.elements();
-        float * x_new = result.elements();
+        CONTEXT("When calculating defect of BandedMatrixQ1<float> with DenseVector<float> (SSE):");
+        PROFILER_START("Defect BMQ1 float tags::CPU::SSE");
 
-        float * ll = system.band(LL).elements();
-        float * ld = system.band(LD).elements();
-        float * lu = system.band(LU).elements();
+        if (x.size() != system.columns())
+        {
+            throw VectorSizeDoesNotMatch(x.size(), system.columns());
+        }
+        if (right_hand_side.size() != system.columns())
+        {
+            throw VectorSizeDoesNotMatch(right_hand_side.size(), system.columns());
+        }
+        if (result.size() != system.rows())
+        {
+            throw VectorSizeDoesNotMatch(result.size(), system.rows());
+        }
 
-        float * dl = system.band(DL).elements();
-        float * dd = system.band(DD).elements();
-        float * du = system.band(DU).elements();
+        if (row_end == 0)
+            row_end = system.rows();
 
-        float * ul = system.band(UL).elements();
-        float * ud = system.band(UD).elements();
-        float * uu = system.band(UU).elements();
-
-        __m128 m1, m2, m3, m4;
-
-        unsigned long index(0);
-
-        //index 0
-        x_new[index] = b[index] - (dd[index] * x_old[index]
-                + du[index] * x_old[index + 1]
-                + ul[index] * x_old[index + root_n - 1]
-                + ud[index] * x_old[index + root_n]
-                + uu[index] * x_old[index + root_n + 1]);
-
-        //index in [1, root_n -1[
-        index = 1;
-        unsigned long quad_start(index + 4 - (index % 4));
-        unsigned long quad_end(root_n - 1 - ((root_n - 1 - quad_start) % 4));
-
-        for (unsigned long si(index) ; si < quad_start ; ++si)
-        {
-            x_new[si] = b[si] - (dd[si] * x_old[si]
-                    + dl[si] * x_old[si - 1]
-                    + du[si] * x_old[si + 1]
-                    + ul[si] * x_old[si + root_n - 1]
-                    + ud[si] * x_old[si + root_n]
-                    + uu[si] * x_old[si + root_n + 1]);
-        }
-
-        for (unsigned long si(quad_start) ; si < quad_end ; si+=4)
-        {
-            m4 = _mm_load_ps(b + si);
-
-            //x_new[si] = dd[si] * x_old[si]
-            m2 = _mm_loadu_ps( x_old + si);
-            m3 = _mm_load_ps(dd + si);
-            m1 = _mm_mul_ps(m3, m2);
-
-            //+ dl[si] * x_old[si - 1]
-            m2 = _mm_loadu_ps( x_old + si - 1);
-            m3 = _mm_load_ps(dl + si);
-            m3 = _mm_mul_ps(m3, m2);
-            m1 = _mm_add_ps(m1, m3);
-
-            //+ du[si] * x_old[si + 1]
-            m2 = _mm_loadu_ps( x_old + si + 1);
-            m3 = _mm_load_ps(du + si);
-            m3 = _mm_mul_ps(m3, m2);
-            m1 = _mm_add_ps(m1, m3);
-
-            //+ ul[si] * x_old[si + root_n - 1]
-            m2 = _mm_loadu_ps( x_old + si + root_n - 1);
-            m3 = _mm_load_ps(ul + si);
-            m3 = _mm_mul_ps(m3, m2);
-            m1 = _mm_add_ps(m1, m3);
-
-            //+ ud[si] * x_old[si + root_n]
-            m2 = _mm_loadu_ps( x_old + si + root_n);
-            m3 = _mm_load_ps(ud + si);
-            m3 = _mm_mul_ps(m3, m2);
-            m1 = _mm_add_ps(m1, m3);
-
-            //+ uu[si] * x_old[si + root_n + 1];
-            m2 = _mm_loadu_ps( x_old + si + root_n + 1);
-            m3 = _mm_load_ps(uu + si);
-            m3 = _mm_mul_ps(m3, m2);
-            m1 = _mm_add_ps(m1, m3);
-
-            m1 = _mm_sub_ps(m4 , m1);
-
-            _mm_store_ps(x_new + si, m1);
-        }
-
-        for (unsigned long si(quad_end) ; si < root_n - 1 ; ++si)
-        {
-            x_new[si] = b[si] - (dd[si] * x_old[si]
-                    + dl[si] * x_old[si - 1]
-                    + du[si] * x_old[si + 1]
-                    + ul[si] * x_old[si + root_n - 1]
-                    + ud[si] * x_old[si + root_n]
-                    + uu[si] * x_old[si + root_n + 1]);
-        }
-
-
-        //index root_n -1
-        index = root_n - 1;
-        x_new[index] = b[index] - (dd[index] * x_old[index]
-                + lu[index] * x_old[index - root_n + 1]
-                + dl[index] * x_old[index - 1]
-                + du[index] * x_old[index + 1]
-                + ul[index] * x_old[index + root_n - 1]
-                + ud[index] * x_old[index + root_n]
-                + uu[index] * x_old[index + root_n + 1]);
-
-        //index root_n
-        index = root_n;
-        x_new[index] = b[index] - (dd[index] * x_old[index]
-                + lu[index] * x_old[index - root_n + 1]
-                + ld[index] * x_old[index - root_n]
-                + dl[index] * x_old[index - 1]
-                + du[index] * x_old[index + 1]
-                + ul[index] * x_old[index + root_n - 1]
-                + ud[index] * x_old[index + root_n]
-                + uu[index] * x_old[index + root_n + 1]);
-
-        //index in [root_n + 1, n - (root_n + 1)[
-        index = root_n + 1;
-        quad_start = index + 4 - (index % 4);
-        quad_end = n - root_n - 1 - ((n - root_n - 1 - quad_start) % 4);
-
-        for (unsigned long si(index) ; si < quad_start ; ++si)
-        {
-            x_new[si] = b[si] - (dd[si] * x_old[si]
-                    + ll[si] * x_old[si - root_n - 1]
-                    + lu[si] * x_old[si - root_n + 1]
-                    + ld[si] * x_old[si - root_n]
-                    + dl[si] * x_old[si - 1]
-                    + du[si] * x_old[si + 1]
-                    + ul[si] * x_old[si + root_n - 1]
-                    + ud[si] * x_old[si + root_n]
-                    + uu[si] * x_old[si + root_n + 1]);
-        }
-
-        for (unsigned long si(quad_start) ; si < quad_end ; si+=4)
-        {
-            m4 = _mm_load_ps(b + si);
-
-            //x_new[si] = dd[si] * x_old[si]
-            m2 = _mm_loadu_ps( x_old + si);
-            m3 = _mm_load_ps(dd + si);
-            m1 = _mm_mul_ps(m3, m2);
-
-            //+ ll[si] * x_old[si - root_n - 1]
-            m2 = _mm_loadu_ps( x_old + si - root_n - 1);
-            m3 = _mm_load_ps(ll + si);
-            m3 = _mm_mul_ps(m3, m2);
-            m1 = _mm_add_ps(m1, m3);
-
-            //+ lu[si] * x_old[si - root_n + 1]
-            m2 = _mm_loadu_ps( x_old + si - root_n + 1);
-            m3 = _mm_load_ps(lu + si);
-            m3 = _mm_mul_ps(m3, m2);
-            m1 = _mm_add_ps(m1, m3);
-
-            //+ ld[si] * x_old[si - root_n]
-            m2 = _mm_loadu_ps( x_old + si - root_n);
-            m3 = _mm_load_ps(ld + si);
-            m3 = _mm_mul_ps(m3, m2);
-            m1 = _mm_add_ps(m1, m3);
-
-            //+ dl[si] * x_old[si - 1]
-            m2 = _mm_loadu_ps( x_old + si - 1);
-            m3 = _mm_load_ps(dl + si);
-            m3 = _mm_mul_ps(m3, m2);
-            m1 = _mm_add_ps(m1, m3);
-
-            //+ du[si] * x_old[si + 1]
-            m2 = _mm_loadu_ps( x_old + si + 1);
-            m3 = _mm_load_ps(du + si);
-            m3 = _mm_mul_ps(m3, m2);
-            m1 = _mm_add_ps(m1, m3);
-
-            //+ ul[si] * x_old[si + root_n - 1]
-            m2 = _mm_loadu_ps( x_old + si + root_n - 1);
-            m3 = _mm_load_ps(ul + si);
-            m3 = _mm_mul_ps(m3, m2);
-            m1 = _mm_add_ps(m1, m3);
-
-            //+ ud[si] * x_old[si + root_n]
-            m2 = _mm_loadu_ps( x_old + si + root_n);
-            m3 = _mm_load_ps(ud + si);
-            m3 = _mm_mul_ps(m3, m2);
-            m1 = _mm_add_ps(m1, m3);
-
-            //+ uu[si] * x_old[si + root_n + 1];
-            m2 = _mm_loadu_ps( x_old + si + root_n + 1);
-            m3 = _mm_load_ps(uu + si);
-            m3 = _mm_mul_ps(m3, m2);
-            m1 = _mm_add_ps(m1, m3);
-
-            m1 = _mm_sub_ps(m4 , m1);
-
-            _mm_store_ps(x_new + si, m1);
-        }
-
-        for (unsigned long si(quad_end) ; si < n - root_n - 1 ; ++si)
-        {
-            x_new[si] = b[si] - (dd[si] * x_old[si]
-                    + ll[si] * x_old[si - root_n - 1]
-                    + lu[si] * x_old[si - root_n + 1]
-                    + ld[si] * x_old[si - root_n]
-                    + dl[si] * x_old[si - 1]
-                    + du[si] * x_old[si + 1]
-                    + ul[si] * x_old[si + root_n - 1]
-                    + ud[si] * x_old[si + root_n]
-                    + uu[si] * x_old[si + root_n + 1]);
-        }
-
-        //index n - (root_n + 1)
-        index = n - root_n - 1;
-        x_new[index] = b[index] - (dd[index] * x_old[index]
-                + ll[index] * x_old[index - root_n - 1]
-                + lu[index] * x_old[index - root_n + 1]
-                + ld[index] * x_old[index - root_n]
-                + dl[index] * x_old[index - 1]
-                + du[index] * x_old[index + 1]
-                + ul[index] * x_old[index + root_n - 1]
-                + ud[index] * x_old[index + root_n]);
-
-        //index n - root_n
-        index = n - root_n;
-        x_new[index] = b[index] - (dd[index] * x_old[index]
-                + ll[index] * x_old[index - root_n - 1]
-                + lu[index] * x_old[index - root_n + 1]
-                + ld[index] * x_old[index - root_n]
-                + dl[index] * x_old[index - 1]
-                + du[index] * x_old[index + 1]
-                + ul[index] * x_old[index + root_n - 1]);
-
-        //index in [n - root_n + 1, n -1[
-        index = n - root_n + 1;
-        quad_start = index + 4 - (index % 4);
-        quad_end = n - 1 - ((n - 1 - quad_start) % 4);
-
-        for (unsigned long si(index) ; si < quad_start ; ++si)
-        {
-            x_new[si] = b[si] - (dd[si] * x_old[si]
-                    + ll[si] * x_old[si - root_n - 1]
-                    + lu[si] * x_old[si - root_n + 1]
-                    + ld[si] * x_old[si - root_n]
-                    + dl[si] * x_old[si - 1]
-                    + du[si] * x_old[si + 1]);
-        }
-
-        for (unsigned long si(quad_start) ; si < quad_end ; si+=4)
-        {
-            m4 = _mm_load_ps(b + si);
-
-            //x_new[si] = dd[si] * x_old[si]
-            m2 = _mm_loadu_ps( x_old + si);
-            m3 = _mm_load_ps(dd + si);
-            m1 = _mm_mul_ps(m3, m2);
-
-            //+ ll[si] * x_old[si - root_n - 1]
-            m2 = _mm_loadu_ps( x_old + si - root_n - 1);
-            m3 = _mm_load_ps(ll + si);
-            m3 = _mm_mul_ps(m3, m2);
-            m1 = _mm_add_ps(m1, m3);
-
-            //+ lu[si] * x_old[si - root_n + 1]
-            m2 = _mm_loadu_ps( x_old + si - root_n + 1);
-            m3 = _mm_load_ps(lu + si);
-            m3 = _mm_mul_ps(m3, m2);
-            m1 = _mm_add_ps(m1, m3);
-
-            //+ ld[si] * x_old[si - root_n]
-            m2 = _mm_loadu_ps( x_old + si - root_n);
-            m3 = _mm_load_ps(ld + si);
-            m3 = _mm_mul_ps(m3, m2);
-            m1 = _mm_add_ps(m1, m3);
-
-            //+ dl[si] * x_old[si - 1]
-            m2 = _mm_loadu_ps( x_old + si - 1);
-            m3 = _mm_load_ps(dl + si);
-            m3 = _mm_mul_ps(m3, m2);
-            m1 = _mm_add_ps(m1, m3);
-
-            //+ du[si] * x_old[si + 1]
-            m2 = _mm_loadu_ps( x_old + si + 1);
-            m3 = _mm_load_ps(du + si);
-            m3 = _mm_mul_ps(m3, m2);
-            m1 = _mm_add_ps(m1, m3);
-
-                m1 = _mm_sub_ps(m4 , m1);
-
-            _mm_store_ps(x_new + si, m1);
-        }
-
-        for (unsigned long si(quad_end) ; si < n - root_n - 1 ; ++si)
-        {
-            x_new[si] = b[si] - (dd[si] * x_old[si]
-                    + ll[si] * x_old[si - root_n - 1]
-                    + lu[si] * x_old[si - root_n + 1]
-                    + ld[si] * x_old[si - root_n]
-                    + dl[si] * x_old[si - 1]
-                    + du[si] * x_old[si + 1]);
-        }
-
-        //index n - 1
-        index = n - 1;
-        x_new[index] = b[index] - (dd[index] * x_old[index]
-                + ll[index] * x_old[index - root_n - 1]
-                + lu[index] * x_old[index - root_n + 1]
-                + ld[index] * x_old[index - root_n]
-                + dl[index] * x_old[index - 1]);
+        honei::sse::defect_bmdv_q1(system.band(LL).elements(), system.band(LD).elements(), system.band(LU).elements(),
+                system.band(DL).elements(), system.band(DD).elements(), system.band(DU).elements(),
+                system.band(UL).elements(), system.band(UD).elements(), system.band(UU).elements(),
+                right_hand_side.elements(), x.elements(), result.elements(), system.size(), system.root(), row_start, row_end);
 
+        PROFILER_STOP("Defect BMQ1 float tags::CPU::SSE");
         return result;
     }
 
@@ -354,320 +68,34 @@ namespace honei
         return result;
     }
 
-    DenseVector<double> & Defect<tags::CPU::SSE>::value(DenseVector<double> & result, const DenseVector<double> & right_hand_side, const BandedMatrixQx<Q1Type, double> & system, const DenseVector<double> & x)
+    DenseVector<double> & Defect<tags::CPU::SSE>::value(DenseVector<double> & result, const DenseVector<double> & right_hand_side, const BandedMatrixQx<Q1Type, double> & system, const DenseVector<double> & x,
+            unsigned long row_start, unsigned long row_end)
     {
-        unsigned long n = right_hand_side.size();
-        unsigned long root_n = (unsigned long)sqrt(n);
-
-        double * b = right_hand_side.elements();
-        double * x_old = x.elements();
-        double * x_new = result.elements();
+        CONTEXT("When calculating defect of BandedMatrixQ1<double> with DenseVector<double> (SSE):");
+        PROFILER_START("Defect BMQ1 double tags::CPU::SSE");
 
-        double * ll = system.band(LL).elements();
-        double * ld = system.band(LD).elements();
-        double * lu = system.band(LU).elements();
+        if (x.size() != system.columns())
+        {
+            throw VectorSizeDoesNotMatch(x.size(), system.columns());
+        }
+        if (right_hand_side.size() != system.columns())
+        {
+            throw VectorSizeDoesNotMatch(right_hand_side.size(), system.columns());
+        }
+        if (result.size() != system.rows())
+        {
+            throw VectorSizeDoesNotMatch(result.size(), system.rows());
+        }
 
-        double * dl = system.band(DL).elements();
-        double * dd = system.band(DD).elements();
-        double * du = system.band(DU).elements();
+        if (row_end == 0)
+            row_end = system.rows();
 
-        double * ul = system.band(UL).elements();
-        double * ud = system.band(UD).elements();
-        double * uu = system.band(UU).elements();
-
-        __m128d m1, m2, m3, m4;
-
-        unsigned long index(0);
-
-        //index 0
-        x_new[index] = b[index] - (dd[index] * x_old[index]
-                + du[index] * x_old[index + 1]
-                + ul[index] * x_old[index + root_n - 1]
-                + ud[index] * x_old[index + root_n]
-                + uu[index] * x_old[index + root_n + 1]);
-
-        //index in [1, root_n -1[
-        index = 1;
-        unsigned long quad_start(index + (index % 2));
-        unsigned long quad_end(root_n - 1 - ((root_n - 1 - quad_start) % 2));
-
-        for (unsigned long si(index) ; si < quad_start ; ++si)
-        {
-            x_new[si] = b[si] - (dd[si] * x_old[si]
-                    + dl[si] * x_old[si - 1]
-                    + du[si] * x_old[si + 1]
-                    + ul[si] * x_old[si + root_n - 1]
-                    + ud[si] * x_old[si + root_n]
-                    + uu[si] * x_old[si + root_n + 1]);
-        }
-
-        for (unsigned long si(quad_start) ; si < quad_end ; si+=2)
-        {
-            m4 = _mm_load_pd(b + si);
-
-            //x_new[si] = dd[si] * x_old[si]
-            m2 = _mm_loadu_pd( x_old + si);
-            m3 = _mm_load_pd(dd + si);
-            m1 = _mm_mul_pd(m3, m2);
-
-            //+ dl[si] * x_old[si - 1]
-            m2 = _mm_loadu_pd( x_old + si - 1);
-            m3 = _mm_load_pd(dl + si);
-            m3 = _mm_mul_pd(m3, m2);
-            m1 = _mm_add_pd(m1, m3);
-
-            //+ du[si] * x_old[si + 1]
-            m2 = _mm_loadu_pd( x_old + si + 1);
-            m3 = _mm_load_pd(du + si);
-            m3 = _mm_mul_pd(m3, m2);
-            m1 = _mm_add_pd(m1, m3);
-
-            //+ ul[si] * x_old[si + root_n - 1]
-            m2 = _mm_loadu_pd( x_old + si + root_n - 1);
-            m3 = _mm_load_pd(ul + si);
-            m3 = _mm_mul_pd(m3, m2);
-            m1 = _mm_add_pd(m1, m3);
-
-            //+ ud[si] * x_old[si + root_n]
-            m2 = _mm_loadu_pd( x_old + si + root_n);
-            m3 = _mm_load_pd(ud + si);
-            m3 = _mm_mul_pd(m3, m2);
-            m1 = _mm_add_pd(m1, m3);
-
-            //+ uu[si] * x_old[si + root_n + 1];
-            m2 = _mm_loadu_pd( x_old + si + root_n + 1);
-            m3 = _mm_load_pd(uu + si);
-            m3 = _mm_mul_pd(m3, m2);
-            m1 = _mm_add_pd(m1, m3);
-
-            m1 = _mm_sub_pd(m4 , m1);
-
-            _mm_store_pd(x_new + si, m1);
-        }
-
-        for (unsigned long si(quad_end) ; si < root_n - 1 ; ++si)
-        {
-            x_new[si] = b[si] - (dd[si] * x_old[si]
-                    + dl[si] * x_old[si - 1]
-                    + du[si] * x_old[si + 1]
-                    + ul[si] * x_old[si + root_n - 1]
-                    + ud[si] * x_old[si + root_n]
-                    + uu[si] * x_old[si + root_n + 1]);
-        }
-
-
-        //index root_n -1
-        index = root_n - 1;
-        x_new[index] = b[index] - (dd[index] * x_old[index]
-                + lu[index] * x_old[index - root_n + 1]
-                + dl[index] * x_old[index - 1]
-                + du[index] * x_old[index + 1]
-                + ul[index] * x_old[index + root_n - 1]
-                + ud[index] * x_old[index + root_n]
-                + uu[index] * x_old[index + root_n + 1]);
-
-        //index root_n
-        index = root_n;
-        x_new[index] = b[index] - (dd[index] * x_old[index]
-                + lu[index] * x_old[index - root_n + 1]
-                + ld[index] * x_old[index - root_n]
-                + dl[index] * x_old[index - 1]
-                + du[index] * x_old[index + 1]
-                + ul[index] * x_old[index + root_n - 1]
-                + ud[index] * x_old[index + root_n]
-                + uu[index] * x_old[index + root_n + 1]);
-
-        //index in [root_n + 1, n - (root_n + 1)[
-        index = root_n + 1;
-        quad_start = index + (index % 2);
-        quad_end = n - root_n - 1 - ((n - root_n - 1 - quad_start) % 2);
-
-        for (unsigned long si(index) ; si < quad_start ; ++si)
-        {
-            x_new[si] = b[si] - (dd[si] * x_old[si]
-                    + ll[si] * x_old[si - root_n - 1]
-                    + lu[si] * x_old[si - root_n + 1]
-                    + ld[si] * x_old[si - root_n]
-                    + dl[si] * x_old[si - 1]
-                    + du[si] * x_old[si + 1]
-                    + ul[si] * x_old[si + root_n - 1]
-                    + ud[si] * x_old[si + root_n]
-                    + uu[si] * x_old[si + root_n + 1]);
-        }
-
-        for (unsigned long si(quad_start) ; si < quad_end ; si+=2)
-        {
-            m4 = _mm_load_pd(b + si);
-
-            //x_new[si] = dd[si] * x_old[si]
-            m2 = _mm_loadu_pd( x_old + si);
-            m3 = _mm_load_pd(dd + si);
-            m1 = _mm_mul_pd(m3, m2);
-
-            //+ ll[si] * x_old[si - root_n - 1]
-            m2 = _mm_loadu_pd( x_old + si - root_n - 1);
-            m3 = _mm_load_pd(ll + si);
-            m3 = _mm_mul_pd(m3, m2);
-            m1 = _mm_add_pd(m1, m3);
-
-            //+ lu[si] * x_old[si - root_n + 1]
-            m2 = _mm_loadu_pd( x_old + si - root_n + 1);
-            m3 = _mm_load_pd(lu + si);
-            m3 = _mm_mul_pd(m3, m2);
-            m1 = _mm_add_pd(m1, m3);
-
-            //+ ld[si] * x_old[si - root_n]
-            m2 = _mm_loadu_pd( x_old + si - root_n);
-            m3 = _mm_load_pd(ld + si);
-            m3 = _mm_mul_pd(m3, m2);
-            m1 = _mm_add_pd(m1, m3);
-
-            //+ dl[si] * x_old[si - 1]
-            m2 = _mm_loadu_pd( x_old + si - 1);
-            m3 = _mm_load_pd(dl + si);
-            m3 = _mm_mul_pd(m3, m2);
-            m1 = _mm_add_pd(m1, m3);
-
-            //+ du[si] * x_old[si + 1]
-            m2 = _mm_loadu_pd( x_old + si + 1);
-            m3 = _mm_load_pd(du + si);
-            m3 = _mm_mul_pd(m3, m2);
-            m1 = _mm_add_pd(m1, m3);
-
-            //+ ul[si] * x_old[si + root_n - 1]
-            m2 = _mm_loadu_pd( x_old + si + root_n - 1);
-            m3 = _mm_load_pd(ul + si);
-            m3 = _mm_mul_pd(m3, m2);
-            m1 = _mm_add_pd(m1, m3);
-
-            //+ ud[si] * x_old[si + root_n]
-            m2 = _mm_loadu_pd( x_old + si + root_n);
-            m3 = _mm_load_pd(ud + si);
-            m3 = _mm_mul_pd(m3, m2);
-            m1 = _mm_add_pd(m1, m3);
-
-            //+ uu[si] * x_old[si + root_n + 1];
-            m2 = _mm_loadu_pd( x_old + si + root_n + 1);
-            m3 = _mm_load_pd(uu + si);
-            m3 = _mm_mul_pd(m3, m2);
-            m1 = _mm_add_pd(m1, m3);
-
-            m1 = _mm_sub_pd(m4 , m1);
-
-            _mm_store_pd(x_new + si, m1);
-        }
-
-        for (unsigned long si(quad_end) ; si < n - root_n - 1 ; ++si)
-        {
-            x_new[si] = b[si] - (dd[si] * x_old[si]
-                    + ll[si] * x_old[si - root_n - 1]
-                    + lu[si] * x_old[si - root_n + 1]
-                    + ld[si] * x_old[si - root_n]
-                    + dl[si] * x_old[si - 1]
-                    + du[si] * x_old[si + 1]
-                    + ul[si] * x_old[si + root_n - 1]
-                    + ud[si] * x_old[si + root_n]
-                    + uu[si] * x_old[si + root_n + 1]);
-        }
-
-        //index n - (root_n + 1)
-        index = n - root_n - 1;
-        x_new[index] = b[index] - (dd[index] * x_old[index]
-                + ll[index] * x_old[index - root_n - 1]
-                + lu[index] * x_old[index - root_n + 1]
-                + ld[index] * x_old[index - root_n]
-                + dl[index] * x_old[index - 1]
-                + du[index] * x_old[index + 1]
-                + ul[index] * x_old[index + root_n - 1]
-                + ud[index] * x_old[index + root_n]);
-
-        //index n - root_n
-        index = n - root_n;
-        x_new[index] = b[index] - (dd[index] * x_old[index]
-                + ll[index] * x_old[index - root_n - 1]
-                + lu[index] * x_old[index - root_n + 1]
-                + ld[index] * x_old[index - root_n]
-                + dl[index] * x_old[index - 1]
-                + du[index] * x_old[index + 1]
-                + ul[index] * x_old[index + root_n - 1]);
-
-        //index in [n - root_n + 1, n -1[
-        index = n - root_n + 1;
-        quad_start = index + (index % 2);
-        quad_end = n - 1 - ((n - 1 - quad_start) % 2);
-
-        for (unsigned long si(index) ; si < quad_start ; ++si)
-        {
-            x_new[si] = b[si] - (dd[si] * x_old[si]
-                    + ll[si] * x_old[si - root_n - 1]
-                    + lu[si] * x_old[si - root_n + 1]
-                    + ld[si] * x_old[si - root_n]
-                    + dl[si] * x_old[si - 1]
-                    + du[si] * x_old[si + 1]);
-        }
-
-        for (unsigned long si(quad_start) ; si < quad_end ; si+=2)
-        {
-            m4 = _mm_load_pd(b + si);
-
-            //x_new[si] = dd[si] * x_old[si]
-            m2 = _mm_loadu_pd( x_old + si);
-            m3 = _mm_load_pd(dd + si);
-            m1 = _mm_mul_pd(m3, m2);
-
-            //+ ll[si] * x_old[si - root_n - 1]
-            m2 = _mm_loadu_pd( x_old + si - root_n - 1);
-            m3 = _mm_load_pd(ll + si);
-            m3 = _mm_mul_pd(m3, m2);
-            m1 = _mm_add_pd(m1, m3);
-
-            //+ lu[si] * x_old[si - root_n + 1]
-            m2 = _mm_loadu_pd( x_old + si - root_n + 1);
-            m3 = _mm_load_pd(lu + si);
-            m3 = _mm_mul_pd(m3, m2);
-            m1 = _mm_add_pd(m1, m3);
-
-            //+ ld[si] * x_old[si - root_n]
-            m2 = _mm_loadu_pd( x_old + si - root_n);
-            m3 = _mm_load_pd(ld + si);
-            m3 = _mm_mul_pd(m3, m2);
-            m1 = _mm_add_pd(m1, m3);
-
-            //+ dl[si] * x_old[si - 1]
-            m2 = _mm_loadu_pd( x_old + si - 1);
-            m3 = _mm_load_pd(dl + si);
-            m3 = _mm_mul_pd(m3, m2);
-            m1 = _mm_add_pd(m1, m3);
-
-            //+ du[si] * x_old[si + 1]
-            m2 = _mm_loadu_pd( x_old + si + 1);
-            m3 = _mm_load_pd(du + si);
-            m3 = _mm_mul_pd(m3, m2);
-            m1 = _mm_add_pd(m1, m3);
-
-            m1 = _mm_sub_pd(m4 , m1);
-
-            _mm_store_pd(x_new + si, m1);
-        }
-
-        for (unsigned long si(quad_end) ; si < n - root_n - 1 ; ++si)
-        {
-            x_new[si] = b[si] - (dd[si] * x_old[si]
-                    + ll[si] * x_old[si - root_n - 1]
-                    + lu[si] * x_old[si - root_n + 1]
-                    + ld[si] * x_old[si - root_n]
-                    + dl[si] * x_old[si - 1]
-                    + du[si] * x_old[si + 1]);
-        }
-
-        //index n - 1
-        index = n - 1;
-        x_new[index] = b[index] - (dd[index] * x_old[index]
-                + ll[index] * x_old[index - root_n - 1]
-                + lu[index] * x_old[index - root_n + 1]
-                + ld[index] * x_old[index - root_n]
-                + dl[index] * x_old[index - 1]);
+        honei::sse::defect_bmdv_q1(system.band(LL).elements(), system.band(LD).elements(), system.band(LU).elements(),
+                system.band(DL).elements(), system.band(DD).elements(), system.band(DU).elements(),
+                system.band(UL).elements(), system.band(UD).elements(), system.band(UU).elements(),
+                right_hand_side.elements(), x.elements(), result.elements(), system.size(), system.root(), row_start, row_end);
 
+        PROFILER_STOP("Defect BMQ1 double tags::CPU::SSE");
         return result;
     }
 
@@ -678,6 +106,135 @@ namespace honei
         return result;
     }
 
+    DenseVector<float> & Defect<tags::CPU::SSE>::value(DenseVector<float> & result, const DenseVector<float> & right_hand_side, const StencilMatrixQ1<float> & a, const DenseVector<float> & b,
+            unsigned long row_start, unsigned long row_end)
+    {
+        CONTEXT("When calculating defect of StencilMatrixQ1<float> with DenseVector<float> (SSE):");
+        PROFILER_START("Defect SMQ1 float tags::CPU::SSE");
+
+        if (b.size() != a.columns())
+        {
+            throw VectorSizeDoesNotMatch(b.size(), a.columns());
+        }
+        if (result.size() != a.rows())
+        {
+            throw VectorSizeDoesNotMatch(result.size(), a.rows());
+        }
+        if (right_hand_side.size() != result.size())
+        {
+            throw VectorSizeDoesNotMatch(result.size(), right_hand_side.size());
+        }
+
+        if (row_end == 0)
+            row_end = a.rows();
+
+        honei::sse::defect_smdv_q1(result.elements(), right_hand_side.elements(), a.stencil(), b.elements(), a.root(), row_start, row_end);
+
+        PROFILER_STOP("Defect SMQ1 float tags::CPU::SSE");
+        return result;
+    }
+
+    DenseVector<double> & Defect<tags::CPU::SSE>::value(DenseVector<double> & result, const DenseVector<double> & right_hand_side, const StencilMatrixQ1<double> & a, const DenseVector<double> & b,
+            unsigned long row_start, unsigned long row_end)
+    {
+        CONTEXT("When calculating defect of StencilMatrixQ1<double> with DenseVector<double> (SSE):");
+        PROFILER_START("Defect SMQ1 double tags::CPU::SSE");
+
+        if (b.size() != a.columns())
+        {
+            throw VectorSizeDoesNotMatch(b.size(), a.columns());
+        }
+        if (result.size() != a.rows())
+        {
+            throw VectorSizeDoesNotMatch(result.size(), a.rows());
+        }
+        if (right_hand_side.size() != result.size())
+        {
+            throw VectorSizeDoesNotMatch(result.size(), right_hand_side.size());
+        }
+
+        if (row_end == 0)
+            row_end = a.rows();
+
+        honei::sse::defect_smdv_q1(result.elements(), right_hand_side.elements(), a.stencil(), b.elements(), a.root(), row_start, row_end);
+
+        PROFILER_STOP("Defect SMQ1 double tags::CPU::SSE");
+        return result;
+    }
+
+    template <unsigned long R_>
+    DenseVector<float> & Defect<tags::CPU::SSE>::value(DenseVector<float> & result, const DenseVector<float> & right_hand_side, const SparseMatrixBSR<float, R_> & a, const DenseVector<float> & b,
+            unsigned long row_start, unsigned long row_end)
+    {
+        CONTEXT("When calculating defect of SparseMatrixBSR<float> with DenseVector<float> (SSE):");
+        PROFILER_START("Defect SMBSR float tags::CPU::SSE");
+
+        if (b.size() != a.columns())
+        {
+            throw VectorSizeDoesNotMatch(b.size(), a.columns());
+        }
+        if (result.size() != a.rows())
+        {
+            throw VectorSizeDoesNotMatch(result.size(), a.rows());
+        }
+        if (right_hand_side.size() != result.size())
+        {
+            throw VectorSizeDoesNotMatch(result.size(), right_hand_side.size());
+        }
+
+        if (row_end == 0)
+            row_end = a.block_rows();
+
+        honei::sse::defect_bsr_dv(result.elements(), right_hand_side.elements(), a.Ar().elements(), a.Aj().elements(), a.Ax().elements(),
+                b.elements(), R_, row_start, row_end);
+
+        PROFILER_STOP("Defect SMBSR float tags::CPU::SSE");
+        return result;
+    }
+
+    template <unsigned long R_>
+    DenseVector<double> & Defect<tags::CPU::SSE>::value(DenseVector<double> & result, const DenseVector<double> & right_hand_side, const SparseMatrixBSR<double, R_> & a, const DenseVector<double> & b,
+            unsigned long row_start, unsigned long row_end)
+    {
+        CONTEXT("When calculating defect of SparseMatrixBSR<double> with DenseVector<double> (SSE):");
+        PROFILER_START("Defect SMBSR double tags::CPU::SSE");
+
+        if (b.size() != a.columns())
+        {
+            throw VectorSizeDoesNotMatch(b.size(), a.columns());
+        }
+        if (result.size() != a.rows())
+        {
+            throw VectorSizeDoesNotMatch(result.size(), a.rows());
+        }
+        if (right_hand_side.size() != result.size())
+        {
+            throw VectorSizeDoesNotMatch(result.size(), right_hand_side.size());
+        }
+
+        if (row_end == 0)
+            row_end = a.block_rows();
+
+        honei::sse::defect_bsr_dv(result.elements(), right_hand_side.elements(), a.Ar().elements(), a.Aj().elements(), a.Ax().elements(),
+                b.elements(), R_, row_start, row_end);
+
+        PROFILER_STOP("Defect SMBSR double tags::CPU::SSE");
+        return result;
+    }
+
+    template DenseVector<float> & Defect<tags::CPU::SSE>::value<2>(DenseVector<float> &, const DenseVector<float> &, const SparseMatrixBSR<float, 2> &, const DenseVector<float> &,
+            unsigned long, unsigned long);
+    template DenseVector<float> & Defect<tags::CPU::SSE>::value<3>(DenseVector<float> &, const DenseVector<float> &, const SparseMatrixBSR<float, 3> &, const DenseVector<float> &,
+            unsigned long, unsigned long);
+    template DenseVector<float> & Defect<tags::CPU::SSE>::value<4>(DenseVector<float> &, const DenseVector<float> &, const SparseMatrixBSR<float, 4> &, const DenseVector<float> &,
+            unsigned long, unsigned long);
+    template DenseVector<double> & Defect<tags::CPU::SSE>::value<2>(DenseVector<double> &, const DenseVector<double> &, const SparseMatrixBSR<double, 2> &, const DenseVector<double> &,
+            unsigned long, unsigned long);
+    template DenseVector<double> & Defect<tags::CPU::SSE>::value<3>(DenseVector<double> &, const DenseVector<double> &, const SparseMatrixBSR<double, 3> &, const DenseVector<double> &,
+            unsigned long, unsigned long);
+    template DenseVector<double> & Defect<tags::CPU::SSE>::value<4>(DenseVector<double> &, const DenseVector<double> &, const SparseMatrixBSR<double, 4> &, const DenseVector<double> &,
+            unsigned long, unsigned long);
+
     DenseVector<float> & Defect<tags::CPU::SSE>::value(DenseVector<float> & result, const DenseVector<float> & right_hand_side, const SparseMatrixELL<float> & a, const DenseVector<float> & b,
             unsigned long row_start, unsigned long row_end)
     {
@@ -701,8 +258,20 @@ namespace honei
         if (row_end == 0)
             row_end = a.rows();
 
-        honei::sse::defect_smell_dv(result.elements(), right_hand_side.elements(), a.Aj().elements(), a.Ax().elements(), a.Arl().elements(), b.elements(),
-                a.stride(), a.rows(), a.num_cols_per_row(), row_start, row_end, a.threads());
+        switch (a.index_width())
+        {
+            case 16:
+                honei::sse::defect_smell_dv(result.elements(), right_hand_side.elements(), a.Ajd16().elements(), a.Ax().elements(), a.Arl().elements(), b.elements(),
+                        a.stride(), row_start, row_end, a.threads());
+                break;
+            case 32:
+                honei::sse::defect_smell_dv(result.elements(), right_hand_side.elements(), a.Ajd32().elements(), a.Ax().elements(), a.Arl().elements(), b.elements(),
+                        a.stride(), row_start, row_end, a.threads());
+                break;
+            default:
+                honei::sse::defect_smell_dv(result.elements(), right_hand_side.elements(), a.Aj().elements(), a.Ax().elements(), a.Arl().elements(), b.elements(),
+                        a.stride(), a.rows(), a.num_cols_per_row(), row_start, row_end, a.threads());
+        }
 
         PROFILER_STOP("Defect SMELL float tags::CPU::SSE");
         return result;
@@ -731,8 +300,20 @@ namespace honei
         if (row_end == 0)
             row_end = a.rows();
 
-        honei::sse::defect_smell_dv(result.elements(), right_hand_side.elements(), a.Aj().elements(), a.Ax().elements(), a.Arl().elements(), b.elements(),
-                a.stride(), a.rows(), a.num_cols_per_row(), row_start, row_end, a.threads());
+        switch (a.index_width())
+        {
+            case 16:
+                honei::sse::defect_smell_dv(result.elements(), right_hand_side.elements(), a.Ajd16().elements(), a.Ax().elements(), a.Arl().elements(), b.elements(),
+                        a.stride(), row_start, row_end, a.threads());
+                break;
+            case 32:
+                honei::sse::defect_smell_dv(result.elements(), right_hand_side.elements(), a.Ajd32().elements(), a.Ax().elements(), a.Arl().elements(), b.elements(),
+                        a.stride(), row_start, row_end, a.threads());
+                break;
+            default:
+                honei::sse::defect_smell_dv(result.elements(), right_hand_side.elements(), a.Aj().elements(), a.Ax().elements(), a.Arl().elements(), b.elements(),
+                        a.stride(), a.rows(), a.num_cols_per_row(), row_start, row_end, a.threads());
+        }
 
         PROFILER_STOP("Defect SMELL double tags::CPU::SSE");
         return result;
@@ -761,8 +342,20 @@ namespace honei
         if (row_end == 0)
             row_end = a.rows();
 
-        honei::sse::defect_csr_dv(result.elements(), right_hand_side.elements(), a.Aj().elements(), a.Ax().elements(), a.Ar().elements(), b.elements(),
-                a.blocksize(), row_start, row_end);
+        switch (a.index_width())
+        {
+            case 16:
+                honei::sse::defect_csr_dv(result.elements(), right_hand_side.elements(), a.Ajd16().elements(), a.Ax().elements(), a.Ar().elements(), b.elements(),
+                        a.blocksize(), row_start, row_end);
+                break;
+            case 32:
+                honei::sse::defect_csr_dv(result.elements(), right_hand_side.elements(), a.Ajd32().elements(), a.Ax().elements(), a.Ar().elements(), b.elements(),
+                        a.blocksize(), row_start, row_end);
+                break;
+            default:
+                honei::sse::defect_csr_dv(result.elements(), right_hand_side.elements(), a.Aj().elements(), a.Ax().elements(), a.Ar().elements(), b.elements(),
+                        a.blocksize(), row_start, row_end);
+        }
 
         PROFILER_STOP("Defect SMCSR float tags::CPU::SSE");
         return result;
@@ -791,10 +384,104 @@ namespace honei
         if (row_end == 0)
             row_end = a.rows();
 
-        honei::sse::defect_csr_dv(result.elements(), right_hand_side.elements(), a.Aj().elements(), a.Ax().elements(), a.Ar().elements(), b.elements(),
-                a.blocksize(), row_start, row_end);
+        switch (a.index_width())
+        {
+            case 16:
+                honei::sse::defect_csr_dv(result.elements(), right_hand_side.elements(), a.Ajd16().elements(), a.Ax().elements(), a.Ar().elements(), b.elements(),
+                        a.blocksize(), row_start, row_end);
+                break;
+            case 32:
+                honei::sse::defect_csr_dv(result.elements(), right_hand_side.elements(), a.Ajd32().elements(), a.Ax().elements(), a.Ar().elements(), b.elements(),
+                        a.blocksize(), row_start, row_end);
+                break;
+            default:
+                honei::sse::defect_csr_dv(result.elements(), right_hand_side.elements(), a.Aj().elements(), a.Ax().elements(), a.Ar().elements(), b.elements(),
+                        a.blocksize(), row_start, row_end);
+        }
 
         PROFILER_STOP("Defect SMCSR double tags::CPU::SSE");
         return result;
     }
+
+    DenseVector<double> & Defect<tags::CPU::SSE>::value(DenseVector<double> & result, const DenseVector<double> & right_hand_side, const SparseMatrixELL<float> & a, const DenseVector<double> & b,
+            unsigned long row_start, unsigned long row_end)
+    {
+        CONTEXT("When calculating defect of SparseMatrixELL<float> with DenseVector<double> (SSE):");
+        PROFILER_START("Defect SMELL float double tags::CPU::SSE");
+
+        if (b.size() != a.columns())
+        {
+            throw VectorSizeDoesNotMatch(b.size(), a.columns());
+        }
+        if (result.size() != a.rows())
+        {
+            throw VectorSizeDoesNotMatch(result.size(), a.rows());
+        }
+        if (right_hand_side.size() != result.size())
+        {
+            throw VectorSizeDoesNotMatch(result.size(), right_hand_side.size());
+        }
+
+        if (row_end == 0)
+            row_end = a.rows();
+
+        switch (a.index_width())
+        {
+            case 16:
+                honei::sse::defect_smell_dv(result.elements(), right_hand_side.elements(), a.Ajd16().elements(), a.Ax().elements(), a.Arl().elements(), b.elements(),
+                        a.stride(), row_start, row_end, a.threads());
+                break;
+            case 32:
+                honei::sse::defect_smell_dv(result.elements(), right_hand_side.elements(), a.Ajd32().elements(), a.Ax().elements(), a.Arl().elements(), b.elements(),
+                        a.stride(), row_start, row_end, a.threads());
+                break;
+            default:
+                honei::sse::defect_smell_dv(result.elements(), right_hand_side.elements(), a.Aj().elements(), a.Ax().elements(), a.Arl().elements(), b.elements(),
+                        a.stride(), row_start, row_end, a.threads());
+        }
+
+        PROFILER_STOP("Defect SMELL float double tags::CPU::SSE");
+        return result;
+    }
+
+    DenseVector<double> & Defect<tags::CPU::SSE>::value(DenseVector<double> & result, const DenseVector<double> & right_hand_side, const SparseMatrixCSR<float> & a, const DenseVector<double> & b,
+            unsigned long row_start, unsigned long row_end)
+    {
+        CONTEXT("When calculating defect of SparseMatrixCSR<float> with DenseVector<double> (SSE):");
+        PROFILER_START("Defect SMCSR float double tags::CPU::SSE");
+
+        if (b.size() != a.columns())
+        {
+            throw VectorSizeDoesNotMatch(b.size(), a.columns());
+        }
+        if (result.size() != a.rows())
+        {
+            throw VectorSizeDoesNotMatch(result.size(), a.rows());
+        }
+        if (right_hand_side.size() != result.size())
+        {
+            throw VectorSizeDoesNotMatch(result.size(), right_hand_side.size());
+        }
+
+        if (row_end == 0)
+            row_end = a.rows();
+
+        switch (a.index_width())
+        {
+            case 16:
+                honei::sse::defect_csr_dv(result.elements(), right_hand_side.elements(), a.Ajd16().elements(), a.Ax().elements(), a.Ar().elements(), b.elements(),
+                        a.blocksize(), row_start, row_end);
+                break;
+            case 32:
+                honei::sse::defect_csr_dv(result.elements(), right_hand_side.elements(), a.Ajd32().elements(), a.Ax().elements(), a.Ar().elements(), b.elements(),
+                        a.blocksize(), row_start, row_end);
+                break;
+            default:
+                honei::sse::defect_csr_dv(result.elements(), right_hand_side.elements(), a.Aj().elements(), a.Ax().elements(), a.Ar().elements(), b.elements(),
+                        a.blocksize(), row_start, row_end);
+        }
+
+        PROFILER_STOP("Defect SMCSR float double tags::CPU::SSE");
+        return result;
+    }
 }
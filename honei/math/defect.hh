@@ -24,6 +24,9 @@
 
 #include<honei/la/banded_matrix_qx.hh>
 #include<honei/la/sparse_matrix_ell.hh>
+#include<honei/la/stencil_matrix_q1.hh>
+#include<honei/la/sparse_matrix_bsr.hh>
+#include<honei/la/sparse_matrix_csr_symmetric.hh>
 #include<honei/la/dense_vector.hh>
 #include<honei/la/algorithm.hh>
 #include<honei/la/product.hh>
@@ -47,156 +50,16 @@ namespace honei
             template<typename DT_>
                 static DenseVector<DT_> value(const DenseVector<DT_> & right_hand_side, const BandedMatrixQx<Q1Type, DT_> & system, const DenseVector<DT_> & x)
                 {
-                    DenseVector<DT_> result(right_hand_side.copy());
-                    DenseVector<DT_> prod(Product<tags::CPU>::value(system, x));
-                    Difference<tags::CPU>::value(result,prod);
-                    return result;
-
-                    /*if (x.size() != system.columns())
-                    {
-                        throw VectorSizeDoesNotMatch(x.size(), system.columns());
-                    }
-                    if (right_hand_side.size() != system.columns())
-                    {
-                        throw VectorSizeDoesNotMatch(right_hand_side.size(), system.columns());
-                    }
-
-                    right_hand_side.lock(lm_read_only);
-                    system.lock(lm_read_only);
-                    x.lock(lm_read_only);
                     DenseVector<DT_> result(right_hand_side.size());
-                    result.lock(lm_write_only);
-                    unsigned long n = right_hand_side.size();
-                    unsigned long root_n = (unsigned long)sqrt(n);
-
-                    DT_ * rhs = right_hand_side.elements();
-                    DT_ * x_old = x.elements();
-                    DT_ * x_new = result.elements();
-
-                    DT_ * ll = system.band(LL).elements();
-                    DT_ * ld = system.band(LD).elements();
-                    DT_ * lu = system.band(LU).elements();
-
-                    DT_ * dl = system.band(DL).elements();
-                    DT_ * dd = system.band(DD).elements();
-                    DT_ * du = system.band(DU).elements();
-
-                    DT_ * ul = system.band(UL).elements();
-                    DT_ * ud = system.band(UD).elements();
-                    DT_ * uu = system.band(UU).elements();
-
-                    unsigned long i(0);
-                    //index 0
-                    x_new[i] = ((rhs[i] - (dd[i] * x_old[i] +
-                                    du[i] * x_old[1] +
-                                    ul[i] * x_old[root_n - 1] +
-                                    ud[i] * x_old[root_n] +
-                                    uu[i] * x_old[root_n + 1])));
-
-                    //index in [1, root_n -1[
-                    i = 1;
-                    for(; i < root_n - 1 ; ++i)
-                    {
-                        x_new[i] = ((rhs[i] - (dl[i] * x_old[i - 1] +
-                                        dd[i] * x_old[i] +
-                                        du[i] * x_old[i + 1] +
-                                        ul[i] * x_old[i + root_n - 1] +
-                                        ud[i] * x_old[i + root_n] +
-                                        uu[i] * x_old[i + root_n + 1])));
-                    }
-
-                    //index root_n -1
-                    i = root_n - 1;
-                    x_new[i] = ((rhs[i] - (lu[i] * x_old[i - (root_n - 1)] +
-                                    dl[i] * x_old[i - 1] +
-                                    dd[i] * x_old[i] +
-                                    du[i] * x_old[i + 1] +
-                                    ul[i] * x_old[i + root_n - 1] +
-                                    ud[i] * x_old[i + root_n] +
-                                    uu[i] * x_old[i + root_n + 1])));
-
-                    //index root_n
-                    i = root_n;
-                    x_new[i] = ((rhs[i] - (ld[i] * x_old[i - root_n] +
-                                    lu[i] * x_old[i - (root_n - 1)] +
-                                    dl[i] * x_old[i - 1] +
-                                    dd[i] * x_old[i] +
-                                    du[i] * x_old[ i + 1] +
-                                    ul[i] * x_old[i + root_n - 1] +
-                                    ud[i] * x_old[i + root_n] +
-                                    uu[i] * x_old[i + root_n + 1])));
-
-                    //index in [root_n + 1, n - (root_n + 1)[
-                    i = root_n + 1;
-                    for(; i < n - (root_n  + 1) ; ++i)
-                    {
-                        x_new[i] = ((rhs[i] - (ll[i] * x_old[i - root_n - 1] +
-                                        ld[i] * x_old[i - root_n] +
-                                        lu[i] * x_old[i - root_n + 1] +
-                                        dl[i] * x_old[i - 1] +
-                                        dd[i] * x_old[i] +
-                                        du[i] * x_old[ i + 1] +
-                                        ul[i] * x_old[i + root_n - 1] +
-                                        ud[i] * x_old[i + root_n] +
-                                        uu[i] * x_old[i + root_n + 1])));
-                    }
-
-                    //index n - (root_n + 1)
-                    i = n - (root_n + 1);
-                    x_new[i] = ((rhs[i] - (ll[i] * x_old[i - (n - (root_n + 1))] +
-                                    ld[i] * x_old[i - root_n] +
-                                    lu[i] * x_old[i - root_n + 1] +
-                                    dl[i] * x_old[i - 1] +
-                                    dd[i] * x_old[i] +
-                                    du[i] * x_old[ i + 1] +
-                                    ul[i] * x_old[i + root_n - 1] +
-                                    ud[i] * x_old[i + root_n])));
-
-                    //index n - root_n
-                    i = n - root_n;
-                    x_new[i] = ((rhs[i] - (ll[i] * x_old[i - (n - (root_n + 1))] +
-                                    ld[i] * x_old[i - root_n] +
-                                    lu[i] * x_old[i - root_n + 1] +
-                                    dl[i] * x_old[i - 1] +
-                                    dd[i] * x_old[i] +
-                                    du[i] * x_old[ i + 1] +
-                                    ul[i] * x_old[i + root_n - 1])));
-
-                    //index in [n - root_n + 1, n -1[
-                    i = n - root_n + 1;
-                    for(; i < n - 1; ++i)
-                    {
-                        x_new[i] = ((rhs[i] - (ll[i] * x_old[i - (n - (root_n + 1))] +
-                                        ld[i] * x_old[i - root_n] +
-                                        lu[i] * x_old[i - root_n + 1] +
-                                        dl[i] * x_old[i - 1] +
-                                        dd[i] * x_old[i] +
-                                        du[i] * x_old[ i + 1])));
-                    }
-
-                    //index n - 1
-                    i = n - 1;
-                    x_new[i] = ((rhs[i] - (ll[i] * x_old[i - (n - (root_n + 1))] +
-                                    ld[i] * x_old[i - root_n] +
-                                    lu[i] * x_old[i - root_n + 1] +
-                                    dl[i] * x_old[i - 1] +
-                                    dd[i] * x_old[i])));
-
-                    right_hand_side.unlock(lm_read_only);
-                    system.unlock(lm_read_only);
-                    x.unlock(lm_read_only);
-                    result.unlock(lm_write_only);
+                    value(result, right_hand_side, system, x);
                     return result;
-                    */
                 }
 
             template<typename DT_>
-                static DenseVector<DT_> & value(DenseVector<DT_> & result, const DenseVector<DT_> & right_hand_side, const BandedMatrixQx<Q1Type, DT_> & system, const DenseVector<DT_> & x)
+                static DenseVector<DT_> & value(DenseVector<DT_> & result, const DenseVector<DT_> & right_hand_side, const BandedMatrixQx<Q1Type, DT_> & system, const DenseVector<DT_> & x,
+                        unsigned long row_start = 0, unsigned long row_end = 0)
                 {
-                    //DenseVector<DT_> result(right_hand_side.copy());
-                    Difference<tags::CPU>::value(result, right_hand_side, Product<tags::CPU>::value(system, x) );
-                    return result;
-                    /*
+                    CONTEXT("When calculating defect of BandedMatrixQ1 with DenseVector:");
                     if (x.size() != system.columns())
                     {
                         throw VectorSizeDoesNotMatch(x.size(), system.columns());
@@ -205,133 +68,20 @@ namespace honei
                     {
                         throw VectorSizeDoesNotMatch(right_hand_side.size(), system.columns());
                     }
+                    if (result.size() != system.rows())
+                    {
+                        throw VectorSizeDoesNotMatch(result.size(), system.rows());
+                    }
 
-                    right_hand_side.lock(lm_read_only);
-                    system.lock(lm_read_only);
-                    x.lock(lm_read_only);
-                    result.lock(lm_write_only);
-                    unsigned long n = right_hand_side.size();
-                    unsigned long root_n = (unsigned long)sqrt(n);
-
-                    DT_ * rhs = right_hand_side.elements();
-                    DT_ * x_old = x.elements();
-                    DT_ * x_new = result.elements();
-
-                    DT_ * ll = system.band(LL).elements();
-                    DT_ * ld = system.band(LD).elements();
-                    DT_ * lu = system.band(LU).elements();
-
-                    DT_ * dl = system.band(DL).elements();
-                    DT_ * dd = system.band(DD).elements();
-                    DT_ * du = system.band(DU).elements();
-
-                    DT_ * ul = system.band(UL).elements();
-                    DT_ * ud = system.band(UD).elements();
-                    DT_ * uu = system.band(UU).elements();
-
-                    unsigned long i(0);
-                    //index 0
-                    x_new[i] = ((rhs[i] - (dd[i] * x_old[i] +
-                                    du[i] * x_old[1] +
-                                    ul[i] * x_old[root_n - 1] +
-                                    ud[i] * x_old[root_n] +
-                                    uu[i] * x_old[root_n + 1])));
-
-                    //index in [1, root_n -1[
-                    i = 1;
-                    for(; i < root_n - 1 ; ++i)
-                    {
-                        x_new[i] = ((rhs[i] - (dl[i] * x_old[i - 1] +
-                                        dd[i] * x_old[i] +
-                                        du[i] * x_old[i + 1] +
-                                        ul[i] * x_old[i + root_n - 1] +
-                                        ud[i] * x_old[i + root_n] +
-                                        uu[i] * x_old[i + root_n + 1])));
-                    }
-
-                    //index root_n -1
-                    i = root_n - 1;
-                    x_new[i] = ((rhs[i] - (lu[i] * x_old[i - (root_n - 1)] +
-                                    dl[i] * x_old[i - 1] +
-                                    dd[i] * x_old[i] +
-                                    du[i] * x_old[i + 1] +
-                                    ul[i] * x_old[i + root_n - 1] +
-                                    ud[i] * x_old[i + root_n] +
-                                    uu[i] * x_old[i + root_n + 1])));
-
-                    //index root_n
-                    i = root_n;
-                    x_new[i] = ((rhs[i] - (ld[i] * x_old[i - root_n] +
-                                    lu[i] * x_old[i - (root_n - 1)] +
-                                    dl[i] * x_old[i - 1] +
-                                    dd[i] * x_old[i] +
-                                    du[i] * x_old[ i + 1] +
-                                    ul[i] * x_old[i + root_n - 1] +
-                                    ud[i] * x_old[i + root_n] +
-                                    uu[i] * x_old[i + root_n + 1])));
-
-                    //index in [root_n + 1, n - (root_n + 1)[
-                    i = root_n + 1;
-                    for(; i < n - (root_n  + 1) ; ++i)
-                    {
-                        x_new[i] = ((rhs[i] - (ll[i] * x_old[i - root_n - 1] +
-                                        ld[i] * x_old[i - root_n] +
-                                        lu[i] * x_old[i - root_n + 1] +
-                                        dl[i] * x_old[i - 1] +
-                                        dd[i] * x_old[i] +
-                                        du[i] * x_old[ i + 1] +
-                                        ul[i] * x_old[i + root_n - 1] +
-                                        ud[i] * x_old[i + root_n] +
-                                        uu[i] * x_old[i + root_n + 1])));
-                    }
-
-                    //index n - (root_n + 1)
-                    i = n - (root_n + 1);
-                    x_new[i] = ((rhs[i] - (ll[i] * x_old[i - (n - (root_n + 1))] +
-                                    ld[i] * x_old[i - root_n] +
-                                    lu[i] * x_old[i - root_n + 1] +
-                                    dl[i] * x_old[i - 1] +
-                                    dd[i] * x_old[i] +
-                                    du[i] * x_old[ i + 1] +
-                                    ul[i] * x_old[i + root_n - 1] +
-                                    ud[i] * x_old[i + root_n])));
-
-                    //index n - root_n
-                    i = n - root_n;
-                    x_new[i] = ((rhs[i] - (ll[i] * x_old[i - (n - (root_n + 1))] +
-                                    ld[i] * x_old[i - root_n] +
-                                    lu[i] * x_old[i - root_n + 1] +
-                                    dl[i] * x_old[i - 1] +
-                                    dd[i] * x_old[i] +
-                                    du[i] * x_old[ i + 1] +
-                                    ul[i] * x_old[i + root_n - 1])));
-
-                    //index in [n - root_n + 1, n -1[
-                    i = n - root_n + 1;
-                    for(; i < n - 1; ++i)
-                    {
-                        x_new[i] = ((rhs[i] - (ll[i] * x_old[i - (n - (root_n + 1))] +
-                                        ld[i] * x_old[i - root_n] +
-                                        lu[i] * x_old[i - root_n + 1] +
-                                        dl[i] * x_old[i - 1] +
-                                        dd[i] * x_old[i] +
-                                        du[i] * x_old[ i + 1])));
-                    }
-
-                    //index n - 1
-                    i = n - 1;
-                    x_new[i] = ((rhs[i] - (ll[i] * x_old[i - (n - (root_n + 1))] +
-                                    ld[i] * x_old[i - root_n] +
-                                    lu[i] * x_old[i - root_n + 1] +
-                                    dl[i] * x_old[i - 1] +
-                                    dd[i] * x_old[i])));
+                    if (row_end == 0)
+                        row_end = system.rows();
+
+                    const DT_ * band[9];
+                    intern::banded_q1_bands(band, system);
+                    intern::banded_q1<DT_, true>(result.elements(), right_hand_side.elements(), band, x.elements(),
+                            system.size(), system.root(), row_start, row_end);
 
-                    right_hand_side.unlock(lm_read_only);
-                    system.unlock(lm_read_only);
-                    x.unlock(lm_read_only);
-                    result.unlock(lm_write_only);
                     return result;
-                    */
                 }
 
             template<typename DT_>
@@ -382,6 +132,90 @@ namespace honei
                     return result;
                 }
 
+            template <typename DT_>
+                static DenseVector<DT_> & value(DenseVector<DT_> & result, const DenseVector<DT_> & right_hand_side, const StencilMatrixQ1<DT_> & system, const DenseVector<DT_> & x,
+                        unsigned long row_start = 0, unsigned long row_end = 0)
+                {
+                    CONTEXT("When calculating defect of StencilMatrixQ1 with DenseVector:");
+                    if (x.size() != system.columns())
+                    {
+                        throw VectorSizeDoesNotMatch(x.size(), system.columns());
+                    }
+                    if (right_hand_side.size() != system.columns())
+                    {
+                        throw VectorSizeDoesNotMatch(right_hand_side.size(), system.columns());
+                    }
+                    if (result.size() != system.rows())
+                    {
+                        throw VectorSizeDoesNotMatch(result.size(), system.rows());
+                    }
+
+                    if (row_end == 0)
+                        row_end = system.rows();
+
+                    intern::stencil_q1<DT_, true>(result.elements(), right_hand_side.elements(), system.stencil(), x.elements(), system.root(), row_start, row_end);
+
+                    return result;
+                }
+
+            /**
+             * Computes the defect of the block rows [row_start, row_end) of a SparseMatrixBSR.
+             */
+            template <typename DT_, unsigned long R_>
+                static DenseVector<DT_> & value(DenseVector<DT_> & result, const DenseVector<DT_> & right_hand_side, const SparseMatrixBSR<DT_, R_> & system, const DenseVector<DT_> & x,
+                        unsigned long row_start = 0, unsigned long row_end = 0)
+                {
+                    CONTEXT("When calculating defect of SparseMatrixBSR with DenseVector:");
+                    if (x.size() != system.columns())
+                    {
+                        throw VectorSizeDoesNotMatch(x.size(), system.columns());
+                    }
+                    if (right_hand_side.size() != system.rows())
+                    {
+                        throw VectorSizeDoesNotMatch(right_hand_side.size(), system.rows());
+                    }
+                    if (result.size() != system.rows())
+                    {
+                        throw VectorSizeDoesNotMatch(result.size(), system.rows());
+                    }
+
+                    if (row_end == 0)
+                        row_end = system.block_rows();
+
+                    intern::bsr<DT_, R_>(result.elements(), right_hand_side.elements(), system.Ar().elements(), system.Aj().elements(),
+                            system.Ax().elements(), x.elements(), row_start, row_end);
+
+                    return result;
+                }
+
+            template <typename DT_>
+                static DenseVector<DT_> & value(DenseVector<DT_> & result, const DenseVector<DT_> & right_hand_side, const SparseMatrixCSRSymmetric<DT_> & system, const DenseVector<DT_> & x)
+                {
+                    CONTEXT("When calculating defect of SparseMatrixCSRSymmetric with DenseVector:");
+                    if (x.size() != system.columns())
+                    {
+                        throw VectorSizeDoesNotMatch(x.size(), system.columns());
+                    }
+                    if (right_hand_side.size() != system.columns())
+                    {
+                        throw VectorSizeDoesNotMatch(right_hand_side.size(), system.columns());
+                    }
+                    if (result.size() != system.rows())
+                    {
+                        throw VectorSizeDoesNotMatch(result.size(), system.rows());
+                    }
+
+                    // the transposed upper triangle scatters into rows below the current one, so initialise all of them first
+                    DT_ * r(result.elements());
+                    const DT_ * rhs(right_hand_side.elements());
+                    for (unsigned long i(0) ; i < result.size() ; ++i)
+                        r[i] = rhs[i];
+                    intern::csr_symmetric<DT_, true>(r, r, 0, system.diagonal().elements(), system.Ar().elements(), system.Aj().elements(),
+                            system.Ax().elements(), x.elements(), 0, system.rows());
+
+                    return result;
+                }
+
             template <typename DT_>
                 static DenseVector<DT_> & value(DenseVector<DT_> & rv, const DenseVector<DT_> & rhsv, const SparseMatrixCSR<DT_> & a, const DenseVector<DT_> & bv,
                         unsigned long row_start = 0, unsigned long row_end = 0)
@@ -420,6 +254,49 @@ namespace honei
                     return rv;
                 }
 
+            /// Mixed precision defects, the matrix values are stored in float, vectors and accumulation stay in double.
+            static DenseVector<double> & value(DenseVector<double> & result, const DenseVector<double> & right_hand_side, const SparseMatrixELL<float> & system, const DenseVector<double> & x,
+                    unsigned long row_start = 0, unsigned long row_end = 0)
+            {
+                if (x.size() != system.columns())
+                {
+                    throw VectorSizeDoesNotMatch(x.size(), system.columns());
+                }
+                if (right_hand_side.size() != system.columns())
+                {
+                    throw VectorSizeDoesNotMatch(right_hand_side.size(), system.columns());
+                }
+                if (row_end == 0)
+                    row_end = system.rows();
+
+                Product<tags::CPU>::value(result, system, x, row_start, row_end);
+                for (unsigned long i(row_start) ; i < row_end ; ++i)
+                    result.elements()[i] = right_hand_side.elements()[i] - result.elements()[i];
+
+                return result;
+            }
+
+            static DenseVector<double> & value(DenseVector<double> & result, const DenseVector<double> & right_hand_side, const SparseMatrixCSR<float> & system, const DenseVector<double> & x,
+                    unsigned long row_start = 0, unsigned long row_end = 0)
+            {
+                if (x.size() != system.columns())
+                {
+                    throw VectorSizeDoesNotMatch(x.size(), system.columns());
+                }
+                if (right_hand_side.size() != system.columns())
+                {
+                    throw VectorSizeDoesNotMatch(right_hand_side.size(), system.columns());
+                }
+                if (row_end == 0)
+                    row_end = system.rows();
+
+                Product<tags::CPU>::value(result, system, x, row_start, row_end);
+                for (unsigned long i(row_start) ; i < row_end ; ++i)
+                    result.elements()[i] = right_hand_side.elements()[i] - result.elements()[i];
+
+                return result;
+            }
+
             template<typename DT_>
                 static DenseVectorMPI<DT_> & value(DenseVectorMPI<DT_> & result, const DenseVectorMPI<DT_> & right_hand_side, const SparseMatrixELLMPI<DT_> & system, const DenseVectorMPI<DT_> & x)
                 {
@@ -448,6 +325,33 @@ namespace honei
     template<>
         struct Defect<tags::CPU::Generic>
         {
+            template <typename DT_>
+                static DenseVector<DT_> & value(DenseVector<DT_> & result, const DenseVector<DT_> & right_hand_side, const BandedMatrixQx<Q1Type, DT_> & system, const DenseVector<DT_> & x,
+                        unsigned long row_start = 0, unsigned long row_end = 0)
+                {
+                    return Defect<tags::CPU>::value(result, right_hand_side, system, x, row_start, row_end);
+                }
+
+            template <typename DT_>
+                static DenseVector<DT_> & value(DenseVector<DT_> & result, const DenseVector<DT_> & right_hand_side, const StencilMatrixQ1<DT_> & system, const DenseVector<DT_> & x,
+                        unsigned long row_start = 0, unsigned long row_end = 0)
+                {
+                    return Defect<tags::CPU>::value(result, right_hand_side, system, x, row_start, row_end);
+                }
+
+            template <typename DT_>
+                static DenseVector<DT_> & value(DenseVector<DT_> & result, const DenseVector<DT_> & right_hand_side, const SparseMatrixCSRSymmetric<DT_> & system, const DenseVector<DT_> & x)
+                {
+                    return Defect<tags::CPU>::value(result, right_hand_side, system, x);
+                }
+
+            template <typename DT_, unsigned long R_>
+                static DenseVector<DT_> & value(DenseVector<DT_> & result, const DenseVector<DT_> & right_hand_side, const SparseMatrixBSR<DT_, R_> & system, const DenseVector<DT_> & x,
+                        unsigned long row_start = 0, unsigned long row_end = 0)
+                {
+                    return Defect<tags::CPU>::value(result, right_hand_side, system, x, row_start, row_end);
+                }
+
             template <typename DT_>
                 static DenseVector<DT_> & value(DenseVector<DT_> & r, const DenseVector<DT_> & rhs, const SparseMatrixELL<DT_> & a, const DenseVector<DT_> & bv,
                         unsigned long row_start = 0, unsigned long row_end = 0)
@@ -741,8 +645,8 @@ namespace honei
                 static DenseVector<double> value(const DenseVector<double> & right_hand_side, const BandedMatrixQx<Q1Type, double> & system, const DenseVector<double> & x);
                 static DenseVector<float> value(const DenseVector<float> & right_hand_side, const BandedMatrixQx<Q1Type, float> & system, const DenseVector<float> & x);
 
-                static DenseVector<double> & value(DenseVector<double> & result, const DenseVector<double> & right_hand_side, const BandedMatrixQx<Q1Type, double> & system, const DenseVector<double> & x);
-                static DenseVector<float> & value(DenseVector<float> & result, const DenseVector<float> & right_hand_side, const BandedMatrixQx<Q1Type, float> & system, const DenseVector<float> & x);
+                static DenseVector<double> & value(DenseVector<double> & result, const DenseVector<double> & right_hand_side, const BandedMatrixQx<Q1Type, double> & system, const DenseVector<double> & x, unsigned long row_start = 0, unsigned long row_end = 0);
+                static DenseVector<float> & value(DenseVector<float> & result, const DenseVector<float> & right_hand_side, const BandedMatrixQx<Q1Type, float> & system, const DenseVector<float> & x, unsigned long row_start = 0, unsigned long row_end = 0);
 
                 template<typename DT_>
                     static DenseVector<DT_> value(DenseVector<DT_> & right_hand_side, SparseMatrixELL<DT_> & system, DenseVector<DT_> & x)
@@ -765,6 +669,23 @@ namespace honei
                         return result;
                     }
 
+                static DenseVector<float> & value(DenseVector<float> & result, const DenseVector<float> & right_hand_side, const StencilMatrixQ1<float> & system, const DenseVector<float> & x, unsigned long row_start = 0, unsigned long row_end = 0);
+
+                static DenseVector<double> & value(DenseVector<double> & result, const DenseVector<double> & right_hand_side, const StencilMatrixQ1<double> & system, const DenseVector<double> & x, unsigned long row_start = 0, unsigned long row_end = 0);
+
+                template <typename DT_>
+                    static DenseVector<DT_> & value(DenseVector<DT_> & result, const DenseVector<DT_> & right_hand_side, const SparseMatrixCSRSymmetric<DT_> & system, const DenseVector<DT_> & x)
+                    {
+                        return Defect<tags::CPU>::value(result, right_hand_side, system, x);
+                    }
+
+                /// Computes the defect of the block rows [row_start, row_end), instantiated for blocks of size 2, 3 and 4.
+                template <unsigned long R_>
+                    static DenseVector<float> & value(DenseVector<float> & result, const DenseVector<float> & right_hand_side, const SparseMatrixBSR<float, R_> & system, const DenseVector<float> & x, unsigned long row_start = 0, unsigned long row_end = 0);
+
+                template <unsigned long R_>
+                    static DenseVector<double> & value(DenseVector<double> & result, const DenseVector<double> & right_hand_side, const SparseMatrixBSR<double, R_> & system, const DenseVector<double> & x, unsigned long row_start = 0, unsigned long row_end = 0);
+
                 static DenseVector<float> & value(DenseVector<float> & result, const DenseVector<float> & right_hand_side, const SparseMatrixELL<float> & system, const DenseVector<float> & x, unsigned long row_start = 0, unsigned long row_end = 0);
 
                 static DenseVector<double> & value(DenseVector<double> & result, const DenseVector<double> & right_hand_side, const SparseMatrixELL<double> & system, const DenseVector<double> & x, unsigned long row_start = 0, unsigned long row_end = 0);
@@ -773,6 +694,10 @@ namespace honei
 
                 static DenseVector<double> & value(DenseVector<double> & result, const DenseVector<double> & right_hand_side, const SparseMatrixCSR<double> & system, const DenseVector<double> & x, unsigned long row_start = 0, unsigned long row_end = 0);
 
+                static DenseVector<double> & value(DenseVector<double> & result, const DenseVector<double> & right_hand_side, const SparseMatrixELL<float> & system, const DenseVector<double> & x, unsigned long row_start = 0, unsigned long row_end = 0);
+
+                static DenseVector<double> & value(DenseVector<double> & result, const DenseVector<double> & right_hand_side, const SparseMatrixCSR<float> & system, const DenseVector<double> & x, unsigned long row_start = 0, unsigned long row_end = 0);
+
                 template<typename DT_>
                     static DenseVectorMPI<DT_> & value(DenseVectorMPI<DT_> & result, const DenseVectorMPI<DT_> & right_hand_side, const SparseMatrixELLMPI<DT_> & system, const DenseVectorMPI<DT_> & x)
                     {
@@ -827,7 +752,54 @@ namespace honei
 
             public:
                 template<typename DT_>
-                    static DenseVector<DT_> value(DenseVector<DT_> & right_hand_side, BandedMatrixQx<Q1Type, DT_> & system, DenseVector<DT_> & x)
+                    static DenseVector<DT_> value(const DenseVector<DT_> & right_hand_side, const BandedMatrixQx<Q1Type, DT_> & system, const DenseVector<DT_> & x)
+                    {
+                        DenseVector<DT_> result(right_hand_side.size());
+                        value(result, right_hand_side, system, x);
+                        return result;
+                    }
+
+                template<typename DT_>
+                    static DenseVector<DT_> & value(DenseVector<DT_> & result, const DenseVector<DT_> & right_hand_side, const BandedMatrixQx<Q1Type, DT_> & system, const DenseVector<DT_> & x)
+                    {
+                        CONTEXT("When calculating defect of BandedMatrixQ1 with DenseVector using backend : " + tags::CPU::MultiCore::name);
+                        if (x.size() != system.columns())
+                        {
+                            throw VectorSizeDoesNotMatch(x.size(), system.columns());
+                        }
+                        if (right_hand_side.size() != system.columns())
+                        {
+                            throw VectorSizeDoesNotMatch(right_hand_side.size(), system.columns());
+                        }
+                        if (result.size() != system.rows())
+                        {
+                            throw VectorSizeDoesNotMatch(result.size(), system.rows());
+                        }
+
+                        unsigned long max_count(Configuration::instance()->get_value("mc::Product(DV,BMQ1,DV)::max_count",
+                                    mc::ThreadPool::instance()->num_threads()));
+
+                        const unsigned long m(system.root());
+                        if (max_count > m)
+                            max_count = m;
+
+                        TicketVector tickets;
+
+                        for (unsigned long i(0) ; i < max_count ; ++i)
+                        {
+                            OperationWrapper<honei::Defect<typename tags::CPU::MultiCore::DelegateTo>, DenseVector<DT_>, DenseVector<DT_>,
+                                DenseVector<DT_>, BandedMatrixQx<Q1Type, DT_>, DenseVector<DT_>, unsigned long, unsigned long > wrapper(result);
+                            tickets.push_back(mc::ThreadPool::instance()->enqueue(bind(wrapper, result, right_hand_side, system, x,
+                                            (i * m / max_count) * m, ((i + 1) * m / max_count) * m)));
+                        }
+
+                        tickets.wait();
+
+                        return result;
+                    }
+
+                template <typename DT_, typename MT_>
+                    static DenseVector<DT_> value(DenseVector<DT_> & right_hand_side, SparseMatrixELL<MT_> & system, DenseVector<DT_> & x)
                     {
                         if (x.size() != system.columns())
                         {
@@ -845,8 +817,8 @@ namespace honei
                         return result;
                     }
 
-                template<typename DT_>
-                    static DenseVector<DT_> & value(DenseVector<DT_> & result, DenseVector<DT_> & right_hand_side, BandedMatrixQx<Q1Type, DT_> & system, DenseVector<DT_> & x)
+                template <typename DT_, typename MT_>
+                    static DenseVector<DT_> & value(DenseVector<DT_> & result, DenseVector<DT_> & right_hand_side, SparseMatrixELL<MT_> & system, DenseVector<DT_> & x)
                     {
                         if (x.size() != system.columns())
                         {
@@ -864,9 +836,10 @@ namespace honei
                         return result;
                     }
 
-                template<typename DT_>
-                    static DenseVector<DT_> value(DenseVector<DT_> & right_hand_side, SparseMatrixELL<DT_> & system, DenseVector<DT_> & x)
+                template <typename DT_>
+                    static DenseVector<DT_> & value(DenseVector<DT_> & result, const DenseVector<DT_> & right_hand_side, const StencilMatrixQ1<DT_> & system, const DenseVector<DT_> & x)
                     {
+                        CONTEXT("When calculating defect of StencilMatrixQ1 with DenseVector using backend : " + tags::CPU::MultiCore::name);
                         if (x.size() != system.columns())
                         {
                             throw VectorSizeDoesNotMatch(x.size(), system.columns());
@@ -875,21 +848,75 @@ namespace honei
                         {
                             throw VectorSizeDoesNotMatch(right_hand_side.size(), system.columns());
                         }
+                        if (result.size() != system.rows())
+                        {
+                            throw VectorSizeDoesNotMatch(result.size(), system.rows());
+                        }
+
+                        unsigned long max_count(Configuration::instance()->get_value("mc::Product(DV,SMQ1,DV)::max_count",
+                                    mc::ThreadPool::instance()->num_threads()));
+
+                        // partition along whole grid lines, to keep the inner loops long
+                        const unsigned long m(system.root());
+                        if (max_count > m)
+                            max_count = m;
+
+                        TicketVector tickets;
+
+                        for (unsigned long i(0) ; i < max_count ; ++i)
+                        {
+                            OperationWrapper<honei::Defect<typename tags::CPU::MultiCore::DelegateTo>, DenseVector<DT_>, DenseVector<DT_>,
+                                DenseVector<DT_>, StencilMatrixQ1<DT_>, DenseVector<DT_>, unsigned long, unsigned long > wrapper(result);
+                            tickets.push_back(mc::ThreadPool::instance()->enqueue(bind(wrapper, result, right_hand_side, system, x,
+                                            (i * m / max_count) * m, ((i + 1) * m / max_count) * m)));
+                        }
+
+                        tickets.wait();
 
-                        DenseVector<DT_> result(right_hand_side.size());
-                        DenseVector<DT_> temp(right_hand_side.size());
-                        Product<tags::CPU::MultiCore>::value(temp, system, x);
-                        Difference<tags::CPU::MultiCore>::value(result, right_hand_side, temp);
                         return result;
                     }
 
-                template<typename DT_>
-                    static DenseVector<DT_> & value(DenseVector<DT_> & result, DenseVector<DT_> & right_hand_side, SparseMatrixELL<DT_> & system, DenseVector<DT_> & x)
+                template <typename DT_, unsigned long R_>
+                    static DenseVector<DT_> & value(DenseVector<DT_> & result, const DenseVector<DT_> & right_hand_side, const SparseMatrixBSR<DT_, R_> & system, const DenseVector<DT_> & x)
                     {
+                        CONTEXT("When calculating defect of SparseMatrixBSR with DenseVector using backend : " + tags::CPU::MultiCore::name);
                         if (x.size() != system.columns())
                         {
                             throw VectorSizeDoesNotMatch(x.size(), system.columns());
                         }
+                        if (right_hand_side.size() != system.rows())
+                        {
+                            throw VectorSizeDoesNotMatch(right_hand_side.size(), system.rows());
+                        }
+                        if (result.size() != system.rows())
+                        {
+                            throw VectorSizeDoesNotMatch(result.size(), system.rows());
+                        }
+
+                        unsigned long max_count(Configuration::instance()->get_value("mc::Product(DV,SMBSR,DV)::max_count",
+                                    mc::ThreadPool::instance()->num_threads()));
+                        if (max_count > system.block_rows())
+                            max_count = system.block_rows();
+
+                        TicketVector tickets;
+
+                        for (unsigned long i(0) ; i < max_count ; ++i)
+                        {
+                            OperationWrapper<honei::Defect<typename tags::CPU::MultiCore::DelegateTo>, DenseVector<DT_>, DenseVector<DT_>,
+                                DenseVector<DT_>, SparseMatrixBSR<DT_, R_>, DenseVector<DT_>, unsigned long, unsigned long > wrapper(result);
+                            tickets.push_back(mc::ThreadPool::instance()->enqueue(bind(wrapper, result, right_hand_side, system, x,
+                                            i * system.block_rows() / max_count, (i + 1) * system.block_rows() / max_count)));
+                        }
+
+                        tickets.wait();
+
+                        return result;
+                    }
+
+                template <typename DT_>
+                    static DenseVector<DT_> & value(DenseVector<DT_> & result, const DenseVector<DT_> & right_hand_side, const SparseMatrixCSRSymmetric<DT_> & system, const DenseVector<DT_> & x)
+                    {
+                        CONTEXT("When calculating defect of SparseMatrixCSRSymmetric with DenseVector using backend : " + tags::CPU::MultiCore::name);
                         if (right_hand_side.size() != system.columns())
                         {
                             throw VectorSizeDoesNotMatch(right_hand_side.size(), system.columns());
@@ -902,8 +929,8 @@ namespace honei
                         return result;
                     }
 
-                template <typename DT_>
-                    static DenseVector<DT_> value(DenseVector<DT_> & result, const DenseVector<DT_> & rhs, const SparseMatrixCSR<DT_> & a, const DenseVector<DT_> & b)
+                template <typename DT_, typename MT_>
+                    static DenseVector<DT_> value(DenseVector<DT_> & result, const DenseVector<DT_> & rhs, const SparseMatrixCSR<MT_> & a, const DenseVector<DT_> & b)
                     {
                         if (b.size() != a.columns())
                         {
@@ -936,7 +963,7 @@ namespace honei
                         for (unsigned long i(0) ; i < max_count ; ++i)
                         {
                             OperationWrapper<honei::Defect<typename tags::CPU::MultiCore::DelegateTo>, DenseVector<DT_>, DenseVector<DT_>,
-                                DenseVector<DT_>, SparseMatrixCSR<DT_>, DenseVector<DT_>, unsigned long, unsigned long > wrapper(result);
+                                DenseVector<DT_>, SparseMatrixCSR<MT_>, DenseVector<DT_>, unsigned long, unsigned long > wrapper(result);
                             tickets.push_back(mc::ThreadPool::instance()->enqueue(bind(wrapper, result, rhs, a, b, limits[i], limits[i+1])));
                         }
 
@@ -953,12 +980,134 @@ namespace honei
         {
 
             template<typename DT_>
-                static DenseVector<DT_> & value(DenseVector<DT_> & result, DenseVector<DT_> & right_hand_side, BandedMatrixQx<Q1Type, DT_> & system, DenseVector<DT_> & x)
+                static DenseVector<DT_> value(const DenseVector<DT_> & right_hand_side, const BandedMatrixQx<Q1Type, DT_> & system, const DenseVector<DT_> & x)
+                {
+                    DenseVector<DT_> result(right_hand_side.size());
+                    value(result, right_hand_side, system, x);
+                    return result;
+                }
+
+            template<typename DT_>
+                static DenseVector<DT_> & value(DenseVector<DT_> & result, const DenseVector<DT_> & right_hand_side, const BandedMatrixQx<Q1Type, DT_> & system, const DenseVector<DT_> & x)
+                {
+                    CONTEXT("When calculating defect of BandedMatrixQ1 with DenseVector using backend : " + Tag_::name);
+                    if (x.size() != system.columns())
+                    {
+                        throw VectorSizeDoesNotMatch(x.size(), system.columns());
+                    }
+                    if (right_hand_side.size() != system.columns())
+                    {
+                        throw VectorSizeDoesNotMatch(right_hand_side.size(), system.columns());
+                    }
+                    if (result.size() != system.rows())
+                    {
+                        throw VectorSizeDoesNotMatch(result.size(), system.rows());
+                    }
+
+                    unsigned long max_count(Configuration::instance()->get_value("mc::Product(DV,BMQ1,DV)::max_count",
+                                mc::ThreadPool::instance()->num_threads()));
+
+                    // partition along whole grid lines, every thread streams its own block of the bands
+                    const unsigned long m(system.root());
+                    if (max_count > m)
+                        max_count = m;
+
+                    TicketVector tickets;
+
+                    for (unsigned long i(0) ; i < max_count ; ++i)
+                    {
+                        OperationWrapper<honei::Defect<typename Tag_::DelegateTo>, DenseVector<DT_>, DenseVector<DT_>,
+                            DenseVector<DT_>, BandedMatrixQx<Q1Type, DT_>, DenseVector<DT_>, unsigned long, unsigned long > wrapper(result);
+                        tickets.push_back(mc::ThreadPool::instance()->enqueue(bind(wrapper, result, right_hand_side, system, x,
+                                        (i * m / max_count) * m, ((i + 1) * m / max_count) * m)));
+                    }
+
+                    tickets.wait();
+
+                    return result;
+                }
+
+            template <typename DT_>
+                static DenseVector<DT_> & value(DenseVector<DT_> & result, const DenseVector<DT_> & right_hand_side, const StencilMatrixQ1<DT_> & system, const DenseVector<DT_> & x)
+                {
+                    CONTEXT("When calculating defect of StencilMatrixQ1 with DenseVector using backend : " + Tag_::name);
+                    if (x.size() != system.columns())
+                    {
+                        throw VectorSizeDoesNotMatch(x.size(), system.columns());
+                    }
+                    if (right_hand_side.size() != system.columns())
+                    {
+                        throw VectorSizeDoesNotMatch(right_hand_side.size(), system.columns());
+                    }
+                    if (result.size() != system.rows())
+                    {
+                        throw VectorSizeDoesNotMatch(result.size(), system.rows());
+                    }
+
+                    unsigned long max_count(Configuration::instance()->get_value("mc::Product(DV,SMQ1,DV)::max_count",
+                                mc::ThreadPool::instance()->num_threads()));
+
+                    // partition along whole grid lines, to keep the inner loops long
+                    const unsigned long m(system.root());
+                    if (max_count > m)
+                        max_count = m;
+
+                    TicketVector tickets;
+
+                    for (unsigned long i(0) ; i < max_count ; ++i)
+                    {
+                        OperationWrapper<honei::Defect<typename Tag_::DelegateTo>, DenseVector<DT_>, DenseVector<DT_>,
+                            DenseVector<DT_>, StencilMatrixQ1<DT_>, DenseVector<DT_>, unsigned long, unsigned long > wrapper(result);
+                        tickets.push_back(mc::ThreadPool::instance()->enqueue(bind(wrapper, result, right_hand_side, system, x,
+                                        (i * m / max_count) * m, ((i + 1) * m / max_count) * m)));
+                    }
+
+                    tickets.wait();
+
+                    return result;
+                }
+
+            template <typename DT_, unsigned long R_>
+                static DenseVector<DT_> & value(DenseVector<DT_> & result, const DenseVector<DT_> & right_hand_side, const SparseMatrixBSR<DT_, R_> & system, const DenseVector<DT_> & x)
                 {
+                    CONTEXT("When calculating defect of SparseMatrixBSR with DenseVector using backend : " + Tag_::name);
                     if (x.size() != system.columns())
                     {
                         throw VectorSizeDoesNotMatch(x.size(), system.columns());
                     }
+                    if (right_hand_side.size() != system.rows())
+                    {
+                        throw VectorSizeDoesNotMatch(right_hand_side.size(), system.rows());
+                    }
+                    if (result.size() != system.rows())
+                    {
+                        throw VectorSizeDoesNotMatch(result.size(), system.rows());
+                    }
+
+                    unsigned long max_count(Configuration::instance()->get_value("mc::Product(DV,SMBSR,DV)::max_count",
+                                mc::ThreadPool::instance()->num_threads()));
+                    if (max_count > system.block_rows())
+                        max_count = system.block_rows();
+
+                    TicketVector tickets;
+
+                    for (unsigned long i(0) ; i < max_count ; ++i)
+                    {
+                        OperationWrapper<honei::Defect<typename Tag_::DelegateTo>, DenseVector<DT_>, DenseVector<DT_>,
+                            DenseVector<DT_>, SparseMatrixBSR<DT_, R_>, DenseVector<DT_>, unsigned long, unsigned long > wrapper(result);
+                        tickets.push_back(mc::ThreadPool::instance()->enqueue(bind(wrapper, result, right_hand_side, system, x,
+                                        i * system.block_rows() / max_count, (i + 1) * system.block_rows() / max_count)));
+                    }
+
+                    tickets.wait();
+
+                    return result;
+                }
+
+            template <typename DT_>
+                static DenseVector<DT_> & value(DenseVector<DT_> & result, const DenseVector<DT_> & right_hand_side, const SparseMatrixCSRSymmetric<DT_> & system, const DenseVector<DT_> & x)
+                {
+                    CONTEXT("When calculating defect of SparseMatrixCSRSymmetric with DenseVector using backend : " + Tag_::name);
                     if (right_hand_side.size() != system.columns())
                     {
                         throw VectorSizeDoesNotMatch(right_hand_side.size(), system.columns());
@@ -971,8 +1120,8 @@ namespace honei
                     return result;
                 }
 
-            template <typename DT_>
-                static DenseVector<DT_> value(const DenseVector<DT_> & rhs, const SparseMatrixELL<DT_> & a, const DenseVector<DT_> & b)
+            template <typename DT_, typename MT_>
+                static DenseVector<DT_> value(const DenseVector<DT_> & rhs, const SparseMatrixELL<MT_> & a, const DenseVector<DT_> & b)
                 {
                     if (b.size() != a.columns())
                     {
@@ -1002,7 +1151,7 @@ namespace honei
                     for (unsigned long i(0) ; i < max_count ; ++i)
                     {
                         OperationWrapper<honei::Defect<typename Tag_::DelegateTo>, DenseVector<DT_>, DenseVector<DT_>,
-                            DenseVector<DT_>, SparseMatrixELL<DT_>, DenseVector<DT_>, unsigned long, unsigned long > wrapper(result);
+                            DenseVector<DT_>, SparseMatrixELL<MT_>, DenseVector<DT_>, unsigned long, unsigned long > wrapper(result);
                         tickets.push_back(mc::ThreadPool::instance()->enqueue(bind(wrapper, result, rhs, a, b, limits[i], limits[i+1])));
                     }
 
@@ -1011,8 +1160,8 @@ namespace honei
                     return result;
                 }
 
-            template <typename DT_>
-                static DenseVector<DT_> value(DenseVector<DT_> & result, const DenseVector<DT_> & rhs, const SparseMatrixELL<DT_> & a, const DenseVector<DT_> & b)
+            template <typename DT_, typename MT_>
+                static DenseVector<DT_> value(DenseVector<DT_> & result, const DenseVector<DT_> & rhs, const SparseMatrixELL<MT_> & a, const DenseVector<DT_> & b)
                 {
                     if (b.size() != a.columns())
                     {
@@ -1045,7 +1194,7 @@ namespace honei
                     for (unsigned long i(0) ; i < max_count ; ++i)
                     {
                         OperationWrapper<honei::Defect<typename Tag_::DelegateTo>, DenseVector<DT_>, DenseVector<DT_>,
-                            DenseVector<DT_>, SparseMatrixELL<DT_>, DenseVector<DT_>, unsigned long, unsigned long > wrapper(result);
+                            DenseVector<DT_>, SparseMatrixELL<MT_>, DenseVector<DT_>, unsigned long, unsigned long > wrapper(result);
                         tickets.push_back(mc::ThreadPool::instance()->enqueue(bind(wrapper, result, rhs, a, b, limits[i], limits[i+1])));
                     }
 
@@ -1054,8 +1203,8 @@ namespace honei
                     return result;
                 }
 
-            template <typename DT_>
-                static DenseVector<DT_> value(DenseVector<DT_> & result, const DenseVector<DT_> & rhs, const SparseMatrixCSR<DT_> & a, const DenseVector<DT_> & b)
+            template <typename DT_, typename MT_>
+                static DenseVector<DT_> value(DenseVector<DT_> & result, const DenseVector<DT_> & rhs, const SparseMatrixCSR<MT_> & a, const DenseVector<DT_> & b)
                 {
                     if (b.size() != a.columns())
                     {
@@ -1088,7 +1237,7 @@ namespace honei
                     for (unsigned long i(0) ; i < max_count ; ++i)
                     {
                         OperationWrapper<honei::Defect<typename Tag_::DelegateTo>, DenseVector<DT_>, DenseVector<DT_>,
-                            DenseVector<DT_>, SparseMatrixCSR<DT_>, DenseVector<DT_>, unsigned long, unsigned long > wrapper(result);
+                            DenseVector<DT_>, SparseMatrixCSR<MT_>, DenseVector<DT_>, unsigned long, unsigned long > wrapper(result);
                         tickets.push_back(mc::ThreadPool::instance()->enqueue(bind(wrapper, result, rhs, a, b, limits[i], limits[i+1])));
                     }
 
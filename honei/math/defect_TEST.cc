@@ -182,6 +182,119 @@ Defect2Test<double, tags::OpenCL::GPU> ocl_gpu_defect2_test_double_sparse("doubl
 #endif
 #endif
 
+template<typename DT_, typename Tag_>
+class DefectCSRSymmetricTest:
+    public BaseTest
+{
+    public:
+        DefectCSRSymmetricTest(const std::string & tag) :
+            BaseTest("Defect CSR symmetric Test " + tag)
+        {
+            register_tag(Tag_::name);
+        }
+
+        virtual void run() const
+        {
+            std::string filename(HONEI_SOURCEDIR);
+            filename += "/honei/math/testdata/5pt_10x10.mtx";
+            unsigned long non_zeros(0);
+            DenseMatrix<DT_> matrix = MatrixIO<io_formats::MTX>::read_matrix(filename, DT_(0), non_zeros);
+
+            DenseVector<DT_> x(matrix.rows());
+            DenseVector<DT_> b(matrix.rows(), DT_(1.234));
+            for (unsigned long i(0) ; i < x.size() ; ++i)
+            {
+                x[i] = DT_(i) / 1.234;
+            }
+            SparseMatrix<DT_> ssmatrix(matrix);
+            SparseMatrixCSRSymmetric<DT_> smatrix(ssmatrix);
+
+            DenseVector<DT_> y(b.size(), DT_(4711));
+            Defect<Tag_>::value(y, b, smatrix, x);
+            DenseVector<DT_> yref(b.copy());
+            Difference<tags::CPU>::value(yref ,Product<tags::CPU>::value(matrix, x));
+
+            for (unsigned long i(0) ; i < x.size() ; ++i)
+            {
+                TEST_CHECK_EQUAL_WITHIN_EPS(y[i], yref[i], 1e-3);
+            }
+        }
+};
+DefectCSRSymmetricTest<float, tags::CPU> defect_csr_symmetric_test_float("float");
+DefectCSRSymmetricTest<double, tags::CPU> defect_csr_symmetric_test_double("double");
+DefectCSRSymmetricTest<float, tags::CPU::MultiCore> mc_defect_csr_symmetric_test_float("float");
+DefectCSRSymmetricTest<double, tags::CPU::MultiCore> mc_defect_csr_symmetric_test_double("double");
+DefectCSRSymmetricTest<float, tags::CPU::Generic> generic_defect_csr_symmetric_test_float("float");
+DefectCSRSymmetricTest<double, tags::CPU::Generic> generic_defect_csr_symmetric_test_double("double");
+DefectCSRSymmetricTest<float, tags::CPU::MultiCore::Generic> generic_mc_defect_csr_symmetric_test_float("float");
+DefectCSRSymmetricTest<double, tags::CPU::MultiCore::Generic> generic_mc_defect_csr_symmetric_test_double("double");
+#ifdef HONEI_SSE
+DefectCSRSymmetricTest<float, tags::CPU::SSE> sse_defect_csr_symmetric_test_float("float");
+DefectCSRSymmetricTest<double, tags::CPU::SSE> sse_defect_csr_symmetric_test_double("double");
+DefectCSRSymmetricTest<float, tags::CPU::MultiCore::SSE> mcsse_defect_csr_symmetric_test_float("float");
+DefectCSRSymmetricTest<double, tags::CPU::MultiCore::SSE> mcsse_defect_csr_symmetric_test_double("double");
+#endif
+
+template<typename DT_, typename Tag_, unsigned long R_>
+class DefectBSRTest:
+    public BaseTest
+{
+    public:
+        DefectBSRTest(const std::string & tag) :
+            BaseTest("Defect BSR Test " + tag + " " + stringify(R_))
+        {
+            register_tag(Tag_::name);
+        }
+
+        virtual void run() const
+        {
+            const unsigned long nodes(97);
+            SparseMatrix<DT_> ssmatrix(nodes * R_, nodes * R_);
+            for (unsigned long node(0) ; node < nodes ; ++node)
+                for (unsigned long r(0) ; r < R_ ; ++r)
+                    for (unsigned long c(0) ; c < R_ ; ++c)
+                    {
+                        ssmatrix(node * R_ + r, node * R_ + c) = r == c ? DT_(4) : DT_(1) / DT_(1 + r + c);
+                        ssmatrix(node * R_ + r, ((node + 5) % nodes) * R_ + c) = DT_(-1) / DT_(2 + r);
+                    }
+            SparseMatrixELL<DT_> ell(ssmatrix);
+            SparseMatrixBSR<DT_, R_> smatrix(ssmatrix);
+
+            DenseVector<DT_> x(ssmatrix.rows());
+            DenseVector<DT_> b(ssmatrix.rows(), DT_(1.234));
+            for (unsigned long i(0) ; i < x.size() ; ++i)
+            {
+                x[i] = DT_(i % 17) / 1.234;
+            }
+
+            DenseVector<DT_> y(b.size(), DT_(4711));
+            Defect<Tag_>::value(y, b, smatrix, x);
+            DenseVector<DT_> yref(b.size());
+            Defect<tags::CPU>::value(yref, b, ell, x);
+
+            for (unsigned long i(0) ; i < x.size() ; ++i)
+            {
+                TEST_CHECK_EQUAL_WITHIN_EPS(y[i], yref[i], 1e-3);
+            }
+        }
+};
+DefectBSRTest<float, tags::CPU, 2> defect_bsr_test_float_2("float");
+DefectBSRTest<double, tags::CPU, 3> defect_bsr_test_double_3("double");
+DefectBSRTest<float, tags::CPU::MultiCore, 4> mc_defect_bsr_test_float_4("float");
+DefectBSRTest<double, tags::CPU::MultiCore, 2> mc_defect_bsr_test_double_2("double");
+DefectBSRTest<double, tags::CPU::Generic, 3> generic_defect_bsr_test_double_3("double");
+DefectBSRTest<double, tags::CPU::MultiCore::Generic, 4> generic_mc_defect_bsr_test_double_4("double");
+#ifdef HONEI_SSE
+DefectBSRTest<float, tags::CPU::SSE, 2> sse_defect_bsr_test_float_2("float");
+DefectBSRTest<float, tags::CPU::SSE, 3> sse_defect_bsr_test_float_3("float");
+DefectBSRTest<float, tags::CPU::SSE, 4> sse_defect_bsr_test_float_4("float");
+DefectBSRTest<double, tags::CPU::SSE, 2> sse_defect_bsr_test_double_2("double");
+DefectBSRTest<double, tags::CPU::SSE, 3> sse_defect_bsr_test_double_3("double");
+DefectBSRTest<double, tags::CPU::SSE, 4> sse_defect_bsr_test_double_4("double");
+DefectBSRTest<float, tags::CPU::MultiCore::SSE, 3> mcsse_defect_bsr_test_float_3("float");
+DefectBSRTest<double, tags::CPU::MultiCore::SSE, 4> mcsse_defect_bsr_test_double_4("double");
+#endif
+
 template<typename DT_, typename Tag_>
 class DefectRegressionTest:
     public BaseTest
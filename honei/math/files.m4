@@ -8,9 +8,11 @@ dnl the base filename with no extension; later parameters can be `hh', `cc',
 dnl `test', `impl', `testscript'. Note that there isn't much error checking done
 dnl on this file at present...
 
+add(`amg',                              `hh', `test')
 add(`apply_dirichlet_boundaries',       `hh')
 add(`bi_conjugate_gradients_stabilised',`hh', `test')
 add(`bicgstab',                         `hh', `test')
+add(`block_jacobi',                     `hh', `test')
 add(`cg',                               `hh', `test')
 add(`conjugate_gradients',              `hh', `test')
 add(`defect',                           `hh', `test',   `sse',                        `cuda', `opencl')
@@ -30,6 +32,7 @@ add(`jacobi_kernel_cascade',            `hh',         `sse')
 add(`ludecomposition',                  `hh', `test')
 add(`matrix_io',                        `hh', `test')
 add(`methods',                          `hh')
+add(`multicolor_sor',                   `hh', `test', `sse')
 add(`multigrid',                        `hh')
 add(`mg',                               `hh', `test')
 add(`operator',                         `hh', `test')
@@ -62,6 +65,7 @@ add(`poisson_mg_mixed_ell',                   `test')
 add(`poisson_mg_fixed_ell',                   `test')
 add(`poisson_mg_fixed_banded',                `test')
 add(`poisson_mg_fixed_ell_modules',           `test')
+add(`permutation',                      `hh', `test')
 add(`poly',                             `hh', `test')
 add(`preconditioning',                  `hh')
 add(`prolongation',                     `hh', `cuda', `test')
@@ -24,99 +24,340 @@
 
 #include <honei/la/dense_vector.hh>
 #include <honei/la/dense_matrix.hh>
+#include <honei/la/sparse_matrix.hh>
+#include <honei/la/matrix_error.hh>
+#include <honei/la/vector_error.hh>
+#include <honei/backends/multicore/thread_pool.hh>
+#include <honei/util/configuration.hh>
+#include <honei/util/operation_wrapper.hh>
+#include <honei/util/tags.hh>
+#ifdef HONEI_SSE
+#include <honei/backends/sse/operations.hh>
+#endif
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <vector>
 
 namespace honei
 {
     template <typename Tag_> struct LUDecomposition;
 
-    template <> struct LUDecomposition<tags::CPU>
+    namespace intern
     {
-        public:
+        template <typename Tag_> struct LUGemm;
+
+        /// r += a * b on row major blocks with leading dimensions ldr, lda and ldb.
+        template <> struct LUGemm<tags::CPU>
+        {
             template <typename DT_>
-            static void value(DenseMatrix<DT_> & a, DenseVector<DT_> & b, DenseVector<DT_> & x)
+            static void value(DT_ * r, const DT_ * a, const DT_ * b, unsigned long rows, unsigned long columns,
+                    unsigned long depth, unsigned long ldr, unsigned long lda, unsigned long ldb)
             {
-                if (a.rows() != a.columns())
-                {
-                    throw VectorSizeDoesNotMatch(a.rows(), a.columns());
-                }
-                if (a.rows() != b.size())
-                {
-                    throw VectorSizeDoesNotMatch(a.rows(), b.size());
-                }
-                if (a.rows() != x.size())
+                for (unsigned long i(0) ; i < rows ; ++i)
                 {
-                    throw VectorSizeDoesNotMatch(a.rows(), x.size());
+                    DT_ * const r_i(r + i * ldr);
+                    for (unsigned long p(0) ; p < depth ; ++p)
+                    {
+                        const DT_ a_ip(a[i * lda + p]);
+                        const DT_ * const b_p(b + p * ldb);
+                        for (unsigned long j(0) ; j < columns ; ++j)
+                            r_i[j] += a_ip * b_p[j];
+                    }
                 }
+            }
+        };
 
-                DenseMatrix<DT_> u(a.copy());
-                DenseMatrix<DT_> l(a.rows(), a.columns(), 0);
-                for (unsigned long i(0) ; i < a.rows() ; ++i)
-                {
-                    l(i, i) = 1;
-                }
+#ifdef HONEI_SSE
+        template <> struct LUGemm<tags::CPU::SSE>
+        {
+            template <typename DT_>
+            static void value(DT_ * r, const DT_ * a, const DT_ * b, unsigned long rows, unsigned long columns,
+                    unsigned long depth, unsigned long ldr, unsigned long lda, unsigned long ldb)
+            {
+                if (rows == 0 || columns == 0 || depth == 0)
+                    return;
+
+                unsigned long mc(Configuration::instance()->get_value("sse::Product(DM,DM)::mc", 96));
+                unsigned long kc(Configuration::instance()->get_value("sse::Product(DM,DM)::kc", 256));
+                unsigned long nc(Configuration::instance()->get_value("sse::Product(DM,DM)::nc", 2048));
+                mc = std::max(1ul, std::min(mc, rows));
+                kc = std::max(1ul, std::min(kc, depth));
+                nc = std::max(1ul, std::min(nc, columns));
+
+                DenseVector<DT_> a_pack((mc + 8) * kc);
+                DenseVector<DT_> b_pack(kc * (nc + 8));
+                honei::sse::product_dm_packed(r, a, b, rows, columns, depth, ldr, lda, ldb,
+                        a_pack.elements(), b_pack.elements(), mc, kc, nc);
+            }
+        };
+#else
+        template <> struct LUGemm<tags::CPU::SSE> :
+            public LUGemm<tags::CPU>
+        {
+        };
+#endif
 
-                for (unsigned long k(0) ; k < u.rows() - 1 ; ++k)
+        /**
+         * Updates the columns [column_start, column_end) right of the panel [k, k + kb) after the panel
+         * has been factorised: U12 = L11^-1 * A12 followed by A22 -= L21 * U12.
+         */
+        template <typename Tag_> struct LUTrailingUpdate
+        {
+            template <typename DT_>
+            static DenseMatrix<DT_> & value(DenseMatrix<DT_> & a, unsigned long k, unsigned long kb,
+                    unsigned long column_start, unsigned long column_end)
+            {
+                const unsigned long n(a.columns());
+                const unsigned long columns(column_end - column_start);
+                DT_ * const e(a.elements());
+
+                for (unsigned long j(0) ; j < kb ; ++j)
                 {
-                    //search maximum pivot in column k
-                    unsigned long pivot = k;
-                    for (unsigned long t(k + 1) ; t < u.rows() ; ++t)
+                    const DT_ * const u_j(e + (k + j) * n + column_start);
+                    for (unsigned long i(j + 1) ; i < kb ; ++i)
                     {
-                        if (abs(u(t, k)) > abs(u(pivot, k)))
-                                pivot = t;
+                        const DT_ l_ij(e[(k + i) * n + k + j]);
+                        DT_ * const u_i(e + (k + i) * n + column_start);
+                        for (unsigned long c(0) ; c < columns ; ++c)
+                            u_i[c] -= l_ij * u_j[c];
                     }
-                    //switch row k and row pivot
-                    if (pivot != k)
+                }
+
+                const unsigned long rows(a.rows() - k - kb);
+                if (rows == 0 || columns == 0)
+                    return a;
+
+                DenseVector<DT_> l21(rows * kb);
+                DT_ * const l(l21.elements());
+                for (unsigned long i(0) ; i < rows ; ++i)
+                    for (unsigned long j(0) ; j < kb ; ++j)
+                        l[i * kb + j] = -e[(k + kb + i) * n + k + j];
+
+                LUGemm<Tag_>::value(e + (k + kb) * n + column_start, l, e + k * n + column_start,
+                        rows, columns, kb, n, kb, n);
+
+                return a;
+            }
+        };
+
+        /**
+         * Right looking, panel blocked LU decomposition with partial pivoting.  The panel width is read
+         * from the lu::block_size configuration key, the trailing matrix is updated by Update_.
+         */
+        template <typename Update_> struct DenseLU
+        {
+            /**
+             * Factorises a in place into a unit lower triangular L and an upper triangular U with
+             * P * a = L * U.  Row j has been exchanged with row pivots[j] in step j.
+             */
+            template <typename DT_>
+            static void factor(DenseMatrix<DT_> & a, DenseVector<unsigned long> & pivots)
+            {
+                if (a.rows() != a.columns())
+                    throw MatrixIsNotSquare(a.rows(), a.columns());
+                if (a.rows() != pivots.size())
+                    throw VectorSizeDoesNotMatch(pivots.size(), a.rows());
+
+                const unsigned long n(a.rows());
+                const unsigned long block_size(std::max(1, Configuration::instance()->get_value("lu::block_size", 64)));
+                DT_ * const e(a.elements());
+
+                for (unsigned long k(0) ; k < n ; k += block_size)
+                {
+                    const unsigned long kb(std::min(block_size, n - k));
+
+                    for (unsigned long j(k) ; j < k + kb ; ++j)
                     {
-                        for (unsigned long i(k) ; i < a.columns() ; ++i)
-                        {
-                            DT_ temp(u(k, i));
-                            u(k, i) = u(pivot, i);
-                            u(pivot, i) = temp;
-                        }
-                        for (unsigned long i(0) ; i < k  ; ++i)
+                        unsigned long pivot(j);
+                        for (unsigned long t(j + 1) ; t < n ; ++t)
                         {
-                            DT_ temp(l(k, i));
-                            l(k, i) = l(pivot, i);
-                            l(pivot, i) = temp;
+                            if (std::abs(e[t * n + j]) > std::abs(e[pivot * n + j]))
+                                pivot = t;
                         }
-                        DT_ temp(b[k]);
-                        b[k] = b[pivot];
-                        b[pivot] = temp;
-                    }
+                        pivots[j] = pivot;
+                        if (pivot != j)
+                            std::swap_ranges(e + j * n, e + (j + 1) * n, e + pivot * n);
 
-                    //todo calc and store LU insitu in A
-                    for (unsigned long j(k + 1) ; j < u.rows() ; ++j)
-                    {
-                        l(j, k) = u(j, k) / u(k, k);
-                        for (unsigned long i(k) ; i < u.rows() ; ++i)
+                        const DT_ * const u_j(e + j * n);
+                        for (unsigned long i(j + 1) ; i < n ; ++i)
                         {
-                            u(j, i) = u(j, i) - l(j, k) * u(k, i);
+                            DT_ * const a_i(e + i * n);
+                            const DT_ l_ij(a_i[j] / u_j[j]);
+                            a_i[j] = l_ij;
+                            for (unsigned long c(j + 1) ; c < k + kb ; ++c)
+                                a_i[c] -= l_ij * u_j[c];
                         }
                     }
+
+                    if (k + kb < n)
+                        Update_::value(a, k, kb, k + kb, n);
                 }
+            }
 
-                for (unsigned long i(0) ; i < x.size() ; ++i)
+            /// Solves lu * x = b for the factors and pivots computed by factor.
+            template <typename DT_>
+            static DenseVector<DT_> & solve(const DenseMatrix<DT_> & lu, const DenseVector<unsigned long> & pivots,
+                    const DenseVector<DT_> & b, DenseVector<DT_> & x)
+            {
+                if (lu.rows() != b.size())
+                    throw VectorSizeDoesNotMatch(b.size(), lu.rows());
+                if (lu.rows() != x.size())
+                    throw VectorSizeDoesNotMatch(x.size(), lu.rows());
+
+                const unsigned long n(lu.rows());
+                const DT_ * const e(lu.elements());
+                DT_ * const xe(x.elements());
+                if (xe != b.elements())
+                    std::copy(b.elements(), b.elements() + n, xe);
+
+                for (unsigned long j(0) ; j < n ; ++j)
+                    std::swap(xe[j], xe[pivots[j]]);
+
+                for (unsigned long i(0) ; i < n ; ++i)
                 {
-                    DT_ sum(0);
+                    DT_ sum(xe[i]);
+                    for (unsigned long j(0) ; j < i ; ++j)
+                        sum -= e[i * n + j] * xe[j];
+                    xe[i] = sum;
+                }
+
+                for (unsigned long i(n) ; i > 0 ; --i)
+                {
+                    DT_ sum(xe[i - 1]);
+                    for (unsigned long j(i) ; j < n ; ++j)
+                        sum -= e[(i - 1) * n + j] * xe[j];
+                    xe[i - 1] = sum / e[(i - 1) * n + i - 1];
+                }
+
+                return x;
+            }
+
+            /// Solves lu * x = b for all columns of b at once.
+            template <typename DT_>
+            static DenseMatrix<DT_> & solve(const DenseMatrix<DT_> & lu, const DenseVector<unsigned long> & pivots,
+                    const DenseMatrix<DT_> & b, DenseMatrix<DT_> & x)
+            {
+                if (lu.rows() != b.rows())
+                    throw MatrixRowsDoNotMatch(lu.rows(), b.rows());
+                if (b.rows() != x.rows())
+                    throw MatrixRowsDoNotMatch(b.rows(), x.rows());
+                if (b.columns() != x.columns())
+                    throw MatrixColumnsDoNotMatch(b.columns(), x.columns());
+
+                const unsigned long n(lu.rows());
+                const unsigned long m(b.columns());
+                const DT_ * const e(lu.elements());
+                DT_ * const xe(x.elements());
+                if (xe != b.elements())
+                    std::copy(b.elements(), b.elements() + n * m, xe);
+
+                for (unsigned long j(0) ; j < n ; ++j)
+                {
+                    if (pivots[j] != j)
+                        std::swap_ranges(xe + j * m, xe + (j + 1) * m, xe + pivots[j] * m);
+                }
+
+                for (unsigned long i(0) ; i < n ; ++i)
+                {
+                    DT_ * const x_i(xe + i * m);
                     for (unsigned long j(0) ; j < i ; ++j)
                     {
-                        sum += l(i,j) * x[j];
+                        const DT_ l_ij(e[i * n + j]);
+                        const DT_ * const x_j(xe + j * m);
+                        for (unsigned long c(0) ; c < m ; ++c)
+                            x_i[c] -= l_ij * x_j[c];
                     }
-                    x[i] = DT_(1) / l(i, i) * (b[i] - sum);
                 }
 
-                for (long i(x.size() - 1) ; i >= 0 ; --i)
+                for (unsigned long i(n) ; i > 0 ; --i)
                 {
-                    DT_ sum(0);
-                    for (unsigned long j(i+1) ; j < x.size() ; ++j)
+                    DT_ * const x_i(xe + (i - 1) * m);
+                    for (unsigned long j(i) ; j < n ; ++j)
                     {
-                        sum += u(i,j) * x[j];
+                        const DT_ u_ij(e[(i - 1) * n + j]);
+                        const DT_ * const x_j(xe + j * m);
+                        for (unsigned long c(0) ; c < m ; ++c)
+                            x_i[c] -= u_ij * x_j[c];
                     }
-                    x[i] = DT_(1) / u(i, i) * (x[i] - sum);
+                    const DT_ u_ii(e[(i - 1) * n + i - 1]);
+                    for (unsigned long c(0) ; c < m ; ++c)
+                        x_i[c] /= u_ii;
+                }
+
+                return x;
+            }
+
+            /// Solves a * x = b; a and b are left unchanged.
+            template <typename DT_>
+            static void value(DenseMatrix<DT_> & a, DenseVector<DT_> & b, DenseVector<DT_> & x)
+            {
+                if (a.rows() != a.columns())
+                {
+                    throw VectorSizeDoesNotMatch(a.rows(), a.columns());
+                }
+                if (a.rows() != b.size())
+                {
+                    throw VectorSizeDoesNotMatch(a.rows(), b.size());
+                }
+                if (a.rows() != x.size())
+                {
+                    throw VectorSizeDoesNotMatch(a.rows(), x.size());
+                }
+
+                DenseMatrix<DT_> lu(a.copy());
+                DenseVector<unsigned long> pivots(a.rows());
+                factor(lu, pivots);
+                solve(lu, pivots, b, x);
+            }
+        };
+    }
+
+    namespace mc
+    {
+        /// Splits the trailing update into column ranges and runs them on the thread pool.
+        template <typename Tag_> struct LUTrailingUpdate
+        {
+            template <typename DT_>
+            static DenseMatrix<DT_> & value(DenseMatrix<DT_> & a, unsigned long k, unsigned long kb,
+                    unsigned long column_start, unsigned long column_end)
+            {
+                unsigned long max_count(Configuration::instance()->get_value("mc::LUDecomposition::max_count",
+                            mc::ThreadPool::instance()->num_threads()));
+                max_count = std::max(1ul, std::min(max_count, (column_end - column_start) / std::max(1ul, kb)));
+
+                if (max_count == 1)
+                    return intern::LUTrailingUpdate<typename Tag_::DelegateTo>::value(a, k, kb, column_start, column_end);
+
+                std::vector<DenseMatrix<DT_> > handles(max_count, a);
+                TicketVector tickets;
+                for (unsigned long i(0) ; i < max_count ; ++i)
+                {
+                    OperationWrapper<intern::LUTrailingUpdate<typename Tag_::DelegateTo>, DenseMatrix<DT_>,
+                        DenseMatrix<DT_>, unsigned long, unsigned long, unsigned long, unsigned long> wrapper(handles[i]);
+                    tickets.push_back(mc::ThreadPool::instance()->enqueue(bind(wrapper, a, k, kb,
+                                    column_start + i * (column_end - column_start) / max_count,
+                                    column_start + (i + 1) * (column_end - column_start) / max_count)));
                 }
+                tickets.wait();
+
+                return a;
             }
+        };
+    }
+
+    /**
+     * LUDecomposition solves dense systems by a blocked LU decomposition with partial pivoting.
+     * factor and solve can be called separately to reuse the factors for several right hand sides.
+     */
+    template <typename Tag_> struct LUDecomposition;
+
+    template <> struct LUDecomposition<tags::CPU> :
+        public intern::DenseLU<intern::LUTrailingUpdate<tags::CPU> >
+    {
+        public:
+            using intern::DenseLU<intern::LUTrailingUpdate<tags::CPU> >::value;
 
             template <typename DT_>
             static void value(SparseMatrix<DT_> & a, DenseVector<DT_> & b, DenseVector<DT_> & x)
@@ -251,72 +492,19 @@ namespace honei
             }
     };
 
-    template <> struct LUDecomposition<tags::CPU::SSE>
+    template <> struct LUDecomposition<tags::CPU::MultiCore> :
+        public intern::DenseLU<mc::LUTrailingUpdate<tags::CPU::MultiCore> >
     {
-        public:
-            template <typename DT_>
-            static void value(DenseMatrix<DT_> & a, DenseVector<DT_> & b, DenseVector<DT_> & x)
-            {
-                if (a.rows() != a.columns())
-                {
-                    throw VectorSizeDoesNotMatch(a.rows(), a.columns());
-                }
-                if (a.rows() != b.size())
-                {
-                    throw VectorSizeDoesNotMatch(a.rows(), b.size());
-                }
-                if (a.rows() != x.size())
-                {
-                    throw VectorSizeDoesNotMatch(a.rows(), x.size());
-                }
-
-                DenseMatrix<DT_> u(a.copy());
-                DenseMatrix<DT_> l(a.rows(), a.columns(), 0);
-                DT_ * ue(u.elements());
-                DT_ * le(l.elements());
-                DT_ * be(b.elements());
-                DT_ * xe(x.elements());
-                const unsigned long rows(a.rows());
-                const unsigned long columns(a.columns());
-                const unsigned long size(x.size());
-                for (unsigned long i(0) ; i < a.rows() ; ++i)
-                {
-                    le[columns * i + i] = 1;
-                }
-
-                for (unsigned long k(0) ; k < rows - 1 ; ++k)
-                {
-                    //todo calc and store LU insitu in A
-                    for (unsigned long j(k + 1) ; j < rows ; ++j)
-                    {
-                        le[columns * j + k] = ue[columns * j +  k] / ue[columns * k + k];
-                        for (unsigned long i(k) ; i < rows ; ++i)
-                        {
-                            ue[columns * j +  i] = ue[columns * j + i] - le[columns * j + k] * ue[columns * k + i];
-                        }
-                    }
-                }
+    };
 
-                for (unsigned long i(0) ; i < size ; ++i)
-                {
-                    DT_ sum(0);
-                    for (unsigned long j(0) ; j < i ; ++j)
-                    {
-                        sum += le[columns * i +j] * xe[j];
-                    }
-                    xe[i] = DT_(1) / le[columns * i + i] * (be[i] - sum);
-                }
+    template <> struct LUDecomposition<tags::CPU::SSE> :
+        public intern::DenseLU<intern::LUTrailingUpdate<tags::CPU::SSE> >
+    {
+    };
 
-                for (long i(size - 1) ; i >= 0 ; --i)
-                {
-                    DT_ sum(0);
-                    for (unsigned long j(i+1) ; j < size ; ++j)
-                    {
-                        sum += ue[columns * i + j] * xe[j];
-                    }
-                    xe[i] = DT_(1) / ue[columns * i + i] * (xe[i] - sum);
-                }
-            }
+    template <> struct LUDecomposition<tags::CPU::MultiCore::SSE> :
+        public intern::DenseLU<mc::LUTrailingUpdate<tags::CPU::MultiCore::SSE> >
+    {
     };
 }
 #endif
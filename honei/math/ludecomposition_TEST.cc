@@ -22,6 +22,7 @@
 #include <honei/math/vector_io.hh>
 #include <honei/util/unittest.hh>
 #include <honei/util/stringify.hh>
+#include <honei/util/configuration.hh>
 #include <honei/math/ludecomposition.hh>
 #include <honei/la/product.hh>
 #include <limits>
@@ -293,3 +294,86 @@ class LUTestSparseELL:
 };
 LUTestSparseELL<tags::CPU, double> lu_test_sparse_ell_double_1("double", "l2/area51_full_0.ell", "l2/area51_rhs_0", "l2/area51_sol_0");
 //LUTestSparseELL<tags::CPU, double> lu_test_sparse_ell_double_2("double", "poisson_advanced/sort_0/A_7.ell", "poisson_advanced/sort_0/rhs_7", "poisson_advanced/sort_0/sol_7");
+
+template <typename Tag_, typename DT_>
+class BlockedLUTest:
+    public BaseTest
+{
+    public:
+        BlockedLUTest(const std::string & tag) :
+            BaseTest("blocked_lu_test<" + tag + ">")
+        {
+            register_tag(Tag_::name);
+        }
+
+        virtual void run() const
+        {
+            int old_block_size(Configuration::instance()->get_value("lu::block_size", 64));
+
+            for (unsigned long size(1) ; size < 300 ; size = size * 3 + 4)
+            {
+                DenseMatrix<DT_> a(size, size);
+                for (unsigned long i(0) ; i < size ; ++i)
+                    for (unsigned long j(0) ; j < size ; ++j)
+                        a(i, j) = DT_((i * 7 + j * 13) % 23) / DT_(23) - DT_(0.5);
+                for (unsigned long i(0) ; i < size ; ++i)
+                    a(i, (i * 11) % size) += DT_(size);
+
+                DenseMatrix<DT_> b(size, 3);
+                for (unsigned long i(0) ; i < size ; ++i)
+                    for (unsigned long j(0) ; j < 3 ; ++j)
+                        b(i, j) = DT_((i + j) % 5) - DT_(2);
+
+                // unblocked factorisation as reference
+                Configuration::instance()->set_value("lu::block_size", size);
+                DenseMatrix<DT_> ref_lu(a.copy());
+                DenseVector<unsigned long> ref_pivots(size);
+                LUDecomposition<tags::CPU>::factor(ref_lu, ref_pivots);
+
+                Configuration::instance()->set_value("lu::block_size", 16);
+                DenseMatrix<DT_> lu(a.copy());
+                DenseVector<unsigned long> pivots(size);
+                LUDecomposition<Tag_>::factor(lu, pivots);
+
+                for (unsigned long i(0) ; i < size ; ++i)
+                {
+                    TEST_CHECK_EQUAL(pivots[i], ref_pivots[i]);
+                    for (unsigned long j(0) ; j < size ; ++j)
+                        TEST_CHECK_EQUAL_WITHIN_EPS(lu(i, j), ref_lu(i, j), std::numeric_limits<DT_>::epsilon() * 100);
+                }
+
+                DenseMatrix<DT_> x(size, 3);
+                LUDecomposition<Tag_>::solve(lu, pivots, b, x);
+                for (unsigned long j(0) ; j < 3 ; ++j)
+                {
+                    DenseVector<DT_> b_j(size), x_j(size);
+                    for (unsigned long i(0) ; i < size ; ++i)
+                        b_j[i] = b(i, j);
+                    LUDecomposition<Tag_>::solve(lu, pivots, b_j, x_j);
+
+                    for (unsigned long i(0) ; i < size ; ++i)
+                    {
+                        DT_ sum(0);
+                        for (unsigned long k(0) ; k < size ; ++k)
+                            sum += a(i, k) * x(k, j);
+                        TEST_CHECK_EQUAL_WITHIN_EPS(sum, b(i, j), std::numeric_limits<DT_>::epsilon() * size * 10);
+                        TEST_CHECK_EQUAL_WITHIN_EPS(x_j[i], x(i, j), std::numeric_limits<DT_>::epsilon() * 10);
+                    }
+                }
+            }
+
+            Configuration::instance()->set_value("lu::block_size", old_block_size);
+
+            DenseMatrix<DT_> a(3, 4);
+            DenseVector<unsigned long> pivots(3);
+            TEST_CHECK_THROWS(LUDecomposition<Tag_>::factor(a, pivots), MatrixIsNotSquare);
+        }
+};
+BlockedLUTest<tags::CPU, float> blocked_lu_test_float("float");
+BlockedLUTest<tags::CPU, double> blocked_lu_test_double("double");
+BlockedLUTest<tags::CPU::MultiCore, double> mc_blocked_lu_test_double("MC double");
+#ifdef HONEI_SSE
+BlockedLUTest<tags::CPU::SSE, float> sse_blocked_lu_test_float("SSE float");
+BlockedLUTest<tags::CPU::SSE, double> sse_blocked_lu_test_double("SSE double");
+BlockedLUTest<tags::CPU::MultiCore::SSE, double> mc_sse_blocked_lu_test_double("MC SSE double");
+#endif
@@ -464,6 +464,50 @@ class MatrixIO<io_formats::ELL>
                 }
             }
 
+        /// Marks files written by write_matrix_compact; it takes the place of the size field.
+        static const uint64_t compact_magic = 0x484f4e4549454c43ull;
+
+        /**
+         * Writes the matrix with its row relative 16 or 32 bit column indices instead of the absolute 64 bit
+         * ones, see SparseMatrixELL::index_width. read_matrix recognises both layouts.
+         */
+        template <typename DT_>
+            static void write_matrix_compact(std::string & output, SparseMatrixELL<DT_> & smatrix)
+            {
+                if (sizeof(DT_) != 8)
+                    throw InternalError("Only double ell output supported!");
+                else if (smatrix.threads() != 1)
+                    throw InternalError("Only Matrices with 1 threads data layout are supported for export");
+                else if (smatrix.index_width() == 0)
+                    throw InternalError("Matrix column indices do not fit into compact ell output!");
+
+                else
+                {
+                    FILE* file;
+                    file = fopen(output.c_str(), "wb");
+                    uint64_t magic(compact_magic);
+                    uint64_t width(smatrix.index_width());
+                    uint64_t size(smatrix.Aj().size());
+                    uint64_t rows(smatrix.rows());
+                    uint64_t columns(smatrix.columns());
+                    uint64_t stride(smatrix.stride());
+                    uint64_t num_cols_per_row(smatrix.num_cols_per_row());
+                    fwrite(&magic, sizeof(uint64_t), 1, file);
+                    fwrite(&width, sizeof(uint64_t), 1, file);
+                    fwrite(&size, sizeof(uint64_t), 1, file);
+                    fwrite(&rows, sizeof(uint64_t), 1, file);
+                    fwrite(&columns, sizeof(uint64_t), 1, file);
+                    fwrite(&stride, sizeof(uint64_t), 1, file);
+                    fwrite(&num_cols_per_row, sizeof(uint64_t), 1, file);
+                    if (width == 16)
+                        fwrite(smatrix.Ajd16().elements(), sizeof(int16_t), size, file);
+                    else
+                        fwrite(smatrix.Ajd32().elements(), sizeof(int32_t), size, file);
+                    fwrite(smatrix.Ax().elements(), sizeof(double), size, file);
+                    fclose(file);
+                }
+            }
+
         template <typename DT_>
             static SparseMatrixELL<DT_> read_matrix(std::string input, HONEI_UNUSED DT_ datatype)
             {
@@ -481,9 +525,19 @@ class MatrixIO<io_formats::ELL>
                     uint64_t columns;
                     uint64_t stride;
                     uint64_t num_cols_per_row;
+                    uint64_t width(64);
                     int status = fread(&size, sizeof(uint64_t), 1, file);
                     if (status != 1)
                         throw InternalError("fread error!");
+                    if (size == compact_magic)
+                    {
+                        status = fread(&width, sizeof(uint64_t), 1, file);
+                        if (status != 1 || (width != 16 && width != 32))
+                            throw InternalError("fread error!");
+                        status = fread(&size, sizeof(uint64_t), 1, file);
+                        if (status != 1)
+                            throw InternalError("fread error!");
+                    }
                     status = fread(&rows, sizeof(uint64_t), 1, file);
                     if (status != 1)
                         throw InternalError("fread error!");
@@ -497,7 +551,19 @@ class MatrixIO<io_formats::ELL>
                     if (status != 1)
                         throw InternalError("fread error!");
                     DenseVector<unsigned long> ajc(size);
-                    if (sizeof(unsigned long) == sizeof(uint64_t))
+                    std::vector<long> ajd;
+                    if (width != 64)
+                    {
+                        std::vector<int16_t> ajd16(width == 16 ? size : 0);
+                        std::vector<int32_t> ajd32(width == 32 ? size : 0);
+                        status = width == 16 ? fread(&ajd16[0], sizeof(int16_t), size, file) : fread(&ajd32[0], sizeof(int32_t), size, file);
+                        if ((unsigned long)status != size)
+                            throw InternalError("fread error!");
+                        ajd.resize(size);
+                        for (unsigned long i(0) ; i < size ; ++i)
+                            ajd[i] = width == 16 ? ajd16[i] : ajd32[i];
+                    }
+                    else if (sizeof(unsigned long) == sizeof(uint64_t))
                     {
                         status = fread(ajc.elements(), sizeof(uint64_t), size, file);
                         if ((unsigned long)status != size)
@@ -519,6 +585,13 @@ class MatrixIO<io_formats::ELL>
                     if ((unsigned long)status != size)
                         throw InternalError("fread error!");
                     fclose(file);
+                    if (width != 64)
+                    {
+                        for (unsigned long i(0) ; i < size ; ++i)
+                        {
+                            ajc[i] = ax[i] != double(0) ? (i % stride) + ajd[i] : 0;
+                        }
+                    }
                     DenseVector<DT_> axc(size);
                     unsigned long crows(rows);
                     unsigned long ccolumns(columns);
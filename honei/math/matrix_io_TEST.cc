@@ -114,6 +114,15 @@ class MMIOTest:
                 SparseMatrixELL<DT_> smatrix6 = MatrixIO<io_formats::ELL>::read_matrix(filename_6, DT_(1));
                 TEST_CHECK_EQUAL(smatrix6, smatrix5);
                 remove(filename_6.c_str());
+
+                if (smatrix5.index_width() != 0)
+                {
+                    MatrixIO<io_formats::ELL>::write_matrix_compact(filename_6, smatrix5);
+                    SparseMatrixELL<DT_> smatrix7 = MatrixIO<io_formats::ELL>::read_matrix(filename_6, DT_(1));
+                    TEST_CHECK_EQUAL(smatrix7, smatrix5);
+                    TEST_CHECK_EQUAL(smatrix7.index_width(), smatrix5.index_width());
+                    remove(filename_6.c_str());
+                }
             }
 
             //-------------------------- MTX write matrix test
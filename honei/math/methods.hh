@@ -82,6 +82,8 @@ namespace methods
 
     struct NATURAL;
     struct TWO_LEVEL;
+    struct RCM;
+    struct NESTED_DISSECTION;
 }
 
 
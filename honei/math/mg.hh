@@ -29,6 +29,9 @@
 #include <honei/math/transposition.hh>
 #include <honei/math/vector_io.hh>
 #include <honei/math/spai2.hh>
+#include <honei/math/block_jacobi.hh>
+#include <honei/math/permutation.hh>
+#include <honei/math/reordering.hh>
 
 namespace honei
 {
@@ -67,6 +70,7 @@ namespace honei
             std::vector<VectorType_> c;
             std::vector<VectorType_> store;
             std::vector<std::vector<VectorType_> > smoother_temp;
+            std::vector<Coloring> colorings;
             unsigned long max_iters;
             unsigned long max_iters_coarse;
             unsigned long used_iters_coarse;
@@ -169,6 +173,8 @@ namespace honei
                     this->smoother_temp.push_back(temp);
                 }
 
+                this->colorings = other.colorings;
+
                 this->max_iters = other.max_iters;
                 this->max_iters_coarse = other.max_iters_coarse;
                 this->n_pre_smooth = other.n_pre_smooth;
@@ -236,12 +242,22 @@ namespace honei
                 result.n_post_smooth = this->n_post_smooth;
                 result.min_level = this->min_level;
                 result.eps_relative = this->eps_relative;
+                result.colorings = this->colorings;
                 //result.used_iters = this->used_iters = other.used_iters;
                 //this->used_iters_coarse = other.used_iters_coarse;
 
                 return result;
             }
 
+            /**
+             * Returns the coloring slot of level index, 0 if MGUtil::configure did not create one.
+             *
+             * The slots start out empty; the multicolor smoothers fill them on their first step.
+             */
+            Coloring * coloring(unsigned long index)
+            {
+                return index < colorings.size() ? &colorings.at(index) : 0;
+            }
         };
 
     template<typename PreconContType_,
@@ -343,6 +359,26 @@ namespace honei
                 }
         };
 
+    template<typename DataType_, unsigned long R_>
+        struct PreconFill<SparseMatrixBSR<DataType_, R_>, SparseMatrixBSR<DataType_, R_>, DataType_>
+        {
+            public:
+
+                static void value(unsigned long /*i*/,
+                        std::vector<SparseMatrixBSR<DataType_, R_> > & target,
+                        std::string /*filename*/,
+                        std::string precon_suffix,
+                        SparseMatrixBSR<DataType_, R_> & A,
+                        DataType_ damping_factor)
+                {
+                    // block jacobi, every node solves its coupled components at once
+                    if (precon_suffix == "jac")
+                        target.push_back(BlockJacobi<tags::CPU>::value(A, damping_factor));
+                    else
+                        throw InternalError("Preconditioner unknown!");
+                }
+        };
+
     void print_cycle(OperatorList & ol, unsigned long max_level, unsigned long min_level)
     {
         std::vector<unsigned long> transfers;
@@ -436,6 +472,65 @@ namespace honei
                         target.n_post_smooth = n_post_smooth;
                         target.min_level = min_level;
                         target.eps_relative = eps_relative;
+
+                        ///one empty coloring slot per level, filled by the multicolor smoothers when they first run
+                        target.colorings.assign(target.A.size(), Coloring());
+                    }
+
+                    /**
+                     * Renumbers every level of target by its permutation, see Permutation.
+                     *
+                     * Systems, preconditioners and vectors of level i are permuted by permutations[i], the transfer
+                     * operators between level i and i + 1 by the permutations of both levels. The solution on the
+                     * finest level has to be permuted back with Permutation::back.
+                     */
+                    static void permute(MGData<MatrixType_, VectorType_, TransferContType_, PreconContType_, DataType_> & target,
+                            const std::vector<DenseVector<unsigned long> > & permutations)
+                    {
+                        CONTEXT("When permuting MGData:");
+                        ASSERT(permutations.size() == target.A.size(), "Number of permutations does not match the number of levels!");
+
+                        for (unsigned long i(0) ; i < target.A.size() ; ++i)
+                        {
+                            target.A.at(i) = Permutation<Tag_>::value(target.A.at(i), permutations.at(i));
+                            if (i < target.P.size())
+                                target.P.at(i) = Permutation<Tag_>::value(target.P.at(i), permutations.at(i));
+                            if (i < target.prolmat.size())
+                                target.prolmat.at(i) = Permutation<Tag_>::value(target.prolmat.at(i), permutations.at(i + 1), permutations.at(i));
+                            if (i < target.resmat.size())
+                                target.resmat.at(i) = Permutation<Tag_>::value(target.resmat.at(i), permutations.at(i), permutations.at(i + 1));
+
+                            target.b.at(i) = Permutation<Tag_>::value(target.b.at(i), permutations.at(i));
+                            target.x.at(i) = Permutation<Tag_>::value(target.x.at(i), permutations.at(i));
+                            target.d.at(i) = Permutation<Tag_>::value(target.d.at(i), permutations.at(i));
+                            target.c.at(i) = Permutation<Tag_>::value(target.c.at(i), permutations.at(i));
+                            target.store.at(i) = Permutation<Tag_>::value(target.store.at(i), permutations.at(i));
+                        }
+
+                        ///the colorings of the old numbering are stale, the smoothers recompute them on demand
+                        target.colorings.assign(target.colorings.size(), Coloring());
+                    }
+
+                    /**
+                     * Computes an OrderType_ reordering of every level of target and applies it with permute.
+                     *
+                     * \param permutations Will hold the permutation of every level.
+                     */
+                    template <typename OrderType_>
+                    static void reorder(MGData<MatrixType_, VectorType_, TransferContType_, PreconContType_, DataType_> & target,
+                            std::vector<DenseVector<unsigned long> > & permutations)
+                    {
+                        CONTEXT("When reordering MGData:");
+
+                        permutations.clear();
+                        for (unsigned long i(0) ; i < target.A.size() ; ++i)
+                        {
+                            DenseVector<unsigned long> permutation(target.A.at(i).rows());
+                            Reordering<Tag_, OrderType_>::value(permutation, target.A.at(i));
+                            permutations.push_back(permutation);
+                        }
+
+                        permute(target, permutations);
                     }
 
 
@@ -605,7 +700,8 @@ namespace honei
                                         //data.temp_0.at(MGDataIndex::internal_index_A(level)),
                                         //data.temp_1.at(MGDataIndex::internal_index_A(level)),
                                         data.smoother_temp.at(MGDataIndex::internal_index_A(level)),
-                                        data.n_pre_smooth) );
+                                        data.n_pre_smooth,
+                                        data.coloring(MGDataIndex::internal_index_A(level))) );
 
 
                             ///Defect
@@ -638,7 +734,8 @@ namespace honei
                                         //data.temp_0.at(MGDataIndex::internal_index_A(level)),
                                         //data.temp_1.at(MGDataIndex::internal_index_A(level)),
                                         data.smoother_temp.at(MGDataIndex::internal_index_A(level)),
-                                        data.n_post_smooth) );
+                                        data.n_post_smooth,
+                                        data.coloring(MGDataIndex::internal_index_A(level))) );
                         }
                     }
 
@@ -702,7 +799,8 @@ namespace honei
                                         //data.temp_0.at(MGDataIndex::internal_index_A(level)),
                                         //data.temp_1.at(MGDataIndex::internal_index_A(level)),
                                         data.smoother_temp.at(MGDataIndex::internal_index_A(level)),
-                                        data.n_pre_smooth) );
+                                        data.n_pre_smooth,
+                                        data.coloring(MGDataIndex::internal_index_A(level))) );
 
 
                             ///Defect
@@ -737,7 +835,8 @@ namespace honei
                                         //data.temp_0.at(MGDataIndex::internal_index_A(level)),
                                         //data.temp_1.at(MGDataIndex::internal_index_A(level)),
                                         data.smoother_temp.at(MGDataIndex::internal_index_A(level)),
-                                        data.n_post_smooth) );
+                                        data.n_post_smooth,
+                                        data.coloring(MGDataIndex::internal_index_A(level))) );
                         }
                     }
 
@@ -801,7 +900,8 @@ namespace honei
                                         //data.temp_0.at(MGDataIndex::internal_index_A(level)),
                                         //data.temp_1.at(MGDataIndex::internal_index_A(level)),
                                         data.smoother_temp.at(MGDataIndex::internal_index_A(level)),
-                                        data.n_pre_smooth) );
+                                        data.n_pre_smooth,
+                                        data.coloring(MGDataIndex::internal_index_A(level))) );
 
 
                             ///Defect
@@ -834,7 +934,8 @@ namespace honei
                                         //data.temp_0.at(MGDataIndex::internal_index_A(level)),
                                         //data.temp_1.at(MGDataIndex::internal_index_A(level)),
                                         data.smoother_temp.at(MGDataIndex::internal_index_A(level)),
-                                        data.n_post_smooth) );
+                                        data.n_post_smooth,
+                                        data.coloring(MGDataIndex::internal_index_A(level))) );
                         }
                     }
 
@@ -870,7 +971,8 @@ namespace honei
                                         //data.temp_0.at(MGDataIndex::internal_index_A(level)),
                                         //data.temp_1.at(MGDataIndex::internal_index_A(level)),
                                         data.smoother_temp.at(MGDataIndex::internal_index_A(level)),
-                                        data.n_pre_smooth) );
+                                        data.n_pre_smooth,
+                                        data.coloring(MGDataIndex::internal_index_A(level))) );
 
 
                             ///Defect
@@ -904,7 +1006,8 @@ namespace honei
                                         //data.temp_0.at(MGDataIndex::internal_index_A(level)),
                                         //data.temp_1.at(MGDataIndex::internal_index_A(level)),
                                         data.smoother_temp.at(MGDataIndex::internal_index_A(level)),
-                                        data.n_post_smooth) );
+                                        data.n_post_smooth,
+                                        data.coloring(MGDataIndex::internal_index_A(level))) );
                         }
                     }
 
@@ -968,7 +1071,8 @@ namespace honei
                                         //data.temp_0.at(MGDataIndex::internal_index_A(level)),
                                         //data.temp_1.at(MGDataIndex::internal_index_A(level)),
                                         data.smoother_temp.at(MGDataIndex::internal_index_A(level)),
-                                        data.n_pre_smooth) );
+                                        data.n_pre_smooth,
+                                        data.coloring(MGDataIndex::internal_index_A(level))) );
 
 
                             ///Defect
@@ -1003,7 +1107,8 @@ namespace honei
                                         //data.temp_0.at(MGDataIndex::internal_index_A(level)),
                                         //data.temp_1.at(MGDataIndex::internal_index_A(level)),
                                         data.smoother_temp.at(MGDataIndex::internal_index_A(level)),
-                                        data.n_post_smooth) );
+                                        data.n_post_smooth,
+                                        data.coloring(MGDataIndex::internal_index_A(level))) );
                         }
                     }
 
@@ -1039,7 +1144,8 @@ namespace honei
                                         //data.temp_0.at(MGDataIndex::internal_index_A(level)),
                                         data.temp_1.at(MGDataIndex::internal_index_A(level)),
                                         data.smoother_temp.at(MGDataIndex::internal_index_A(level)),
-                                        data.n_pre_smooth) );
+                                        data.n_pre_smooth,
+                                        data.coloring(MGDataIndex::internal_index_A(level))) );
 
 
                             ///Defect
@@ -1073,7 +1179,8 @@ namespace honei
                                         //data.temp_0.at(MGDataIndex::internal_index_A(level)),
                                         //data.temp_1.at(MGDataIndex::internal_index_A(level)),
                                         data.smoother_temp.at(MGDataIndex::internal_index_A(level)),
-                                        data.n_post_smooth) );
+                                        data.n_post_smooth,
+                                        data.coloring(MGDataIndex::internal_index_A(level))) );
                         }
                     }
 
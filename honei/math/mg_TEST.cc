@@ -28,6 +28,7 @@
 #include <honei/math/cg.hh>
 #include <honei/math/bicgstab.hh>
 #include <honei/math/ri.hh>
+#include <honei/math/multicolor_sor.hh>
 #include <honei/math/mg.hh>
 #include <honei/math/methods.hh>
 #include <honei/util/unittest.hh>
@@ -462,3 +463,91 @@ class MGSolverTestQuad:
         }
 };
 MGSolverTestQuad<tags::CPU> mg_solver_quad_test_cpu("double");
+
+template<typename Tag_>
+class MGSolverMulticolorSORTest:
+    public BaseTest
+{
+    public:
+        MGSolverMulticolorSORTest(const std::string & tag) :
+            BaseTest("MGSolverMulticolorSORTest<" + tag + ">")
+        {
+            register_tag(Tag_::name);
+        }
+
+        virtual void run() const
+        {
+            unsigned long max_level(4);
+            unsigned long min_level(1);
+            std::string file(HONEI_SOURCEDIR);
+            file += "/honei/math/testdata/poisson_advanced/sort_0/";
+            MGData<SparseMatrixELL<double>, DenseVector<double>, SparseMatrixELL<double>, DenseVector<double>, double >  data(MGUtil<Tag_,
+                                                                                            SparseMatrixELL<double>,
+                                                                                            DenseVector<double>,
+                                                                                            SparseMatrixELL<double>,
+                                                                                            DenseVector<double>,
+                                                                                            MatrixIO<io_formats::ELL>,
+                                                                                            VectorIO<io_formats::EXP>,
+                                                                                            double>::load_data(file, max_level, double(1), "jac"));
+            MGUtil<Tag_,
+                SparseMatrixELL<double>,
+                DenseVector<double>,
+                SparseMatrixELL<double>,
+                DenseVector<double>,
+                MatrixIO<io_formats::ELL>,
+                VectorIO<io_formats::EXP>,
+                double>::configure(data, 100, 100, 2, 2, min_level, double(1e-8));
+
+            // configure only creates the slots, the smoother colors its levels when it first runs
+            TEST_CHECK_EQUAL(data.colorings.size(), data.A.size());
+            for(unsigned long i(0) ; i < data.colorings.size() ; ++i)
+                TEST_CHECK(data.colorings.at(i).empty());
+
+            OperatorList ol(
+                    MGCycleCreation<Tag_,
+                    methods::CYCLE::V::STATIC,
+                    CGSolver<Tag_, methods::NONE>,
+                    MulticolorSORSmoother<Tag_>,
+                    Restriction<Tag_, methods::PROLMAT>,
+                    Prolongation<Tag_, methods::PROLMAT>,
+                    double>::value(data)
+                    );
+
+            MGSolver<Tag_, Norm<vnt_l_two, true, Tag_> >::value(data, ol);
+
+            std::cout << data.used_iters << std::endl;
+            std::cout << data.used_iters_coarse << std::endl;
+
+            TEST_CHECK(! data.colorings.at(MGDataIndex::internal_index_A(max_level)).empty());
+            TEST_CHECK(data.colorings.at(MGDataIndex::internal_index_A(min_level)).empty());
+
+            std::string reffile(HONEI_SOURCEDIR);
+            reffile += "/honei/math/testdata/poisson_advanced/sort_0/sol_";
+            reffile += stringify(max_level);
+            DenseVector<double> ref(VectorIO<io_formats::EXP>::read_vector(reffile, double(0)));
+            double base_digits(1);
+            double additional_digits(2);
+
+            double base_eps(1 / pow(10, base_digits));
+            double add_eps(base_eps / pow(10, additional_digits));
+
+            double m((add_eps - base_eps) / double(4));
+            double b(base_eps - (double(4) * m));
+
+            double eps(m * sizeof(double) + b);
+            eps *= double(8);
+
+            data.x.at(MGDataIndex::internal_index_A(max_level)).lock(lm_read_only);
+            ref.lock(lm_read_only);
+            for(unsigned long i(0) ; i < ref.size() ; ++i)
+                TEST_CHECK_EQUAL_WITHIN_EPS(data.x.at(MGDataIndex::internal_index_A(max_level))[i], ref[i], eps);
+            data.x.at(MGDataIndex::internal_index_A(max_level)).unlock(lm_read_only);
+            ref.unlock(lm_read_only);
+        }
+};
+MGSolverMulticolorSORTest<tags::CPU> mg_solver_multicolor_sor_test_cpu("double");
+MGSolverMulticolorSORTest<tags::CPU::MultiCore> mc_mg_solver_multicolor_sor_test_cpu("double");
+#ifdef HONEI_SSE
+MGSolverMulticolorSORTest<tags::CPU::SSE> sse_mg_solver_multicolor_sor_test_cpu("double");
+MGSolverMulticolorSORTest<tags::CPU::MultiCore::SSE> mcsse_mg_solver_multicolor_sor_test_cpu("double");
+#endif
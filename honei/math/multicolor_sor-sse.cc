@@ -0,0 +1,48 @@
+/* vim: set sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2011 Markus Geveler <apryde@gmx.de>
+ *
+ * This file is part of the HONEI C++ library. HONEI is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * HONEI is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <honei/math/multicolor_sor.hh>
+#include <honei/backends/sse/operations.hh>
+
+using namespace honei;
+
+namespace honei
+{
+    DenseVector<float> & SORSweep<tags::CPU::SSE>::value(DenseVector<float> & x, const BandedMatrixQx<Q1Type, float> & a, const DenseVector<float> & p,
+            const DenseVector<float> & b, unsigned long color, unsigned long start, unsigned long end)
+    {
+        honei::sse::sor_bmdv_q1(a.band(LL).elements(), a.band(LD).elements(), a.band(LU).elements(),
+                a.band(DL).elements(), a.band(DD).elements(), a.band(DU).elements(),
+                a.band(UL).elements(), a.band(UD).elements(), a.band(UU).elements(),
+                b.elements(), p.elements(), x.elements(), a.size(), a.root(), color, start, end);
+
+        return x;
+    }
+
+    DenseVector<double> & SORSweep<tags::CPU::SSE>::value(DenseVector<double> & x, const BandedMatrixQx<Q1Type, double> & a, const DenseVector<double> & p,
+            const DenseVector<double> & b, unsigned long color, unsigned long start, unsigned long end)
+    {
+        honei::sse::sor_bmdv_q1(a.band(LL).elements(), a.band(LD).elements(), a.band(LU).elements(),
+                a.band(DL).elements(), a.band(DD).elements(), a.band(DU).elements(),
+                a.band(UL).elements(), a.band(UD).elements(), a.band(UU).elements(),
+                b.elements(), p.elements(), x.elements(), a.size(), a.root(), color, start, end);
+
+        return x;
+    }
+}
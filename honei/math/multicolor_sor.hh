@@ -0,0 +1,503 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2011 Markus Geveler <apryde@gmx.de>
+ *
+ * This file is part of the HONEI C++ library. HONEI is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * HONEI is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#pragma once
+#ifndef MATH_GUARD_MULTICOLOR_SOR_HH
+#define MATH_GUARD_MULTICOLOR_SOR_HH 1
+
+#include <honei/la/banded_matrix_qx.hh>
+#include <honei/la/sparse_matrix_ell.hh>
+#include <honei/la/dense_vector.hh>
+#include <honei/la/product.hh>
+#include <honei/backends/multicore/thread_pool.hh>
+#include <honei/util/configuration.hh>
+#include <honei/util/exception.hh>
+#include <honei/util/operation_wrapper.hh>
+#include <honei/util/profiler.hh>
+
+#include <vector>
+
+namespace honei
+{
+    /**
+     * \brief Partition of the rows of a matrix into colors, so that no two rows of the same
+     * color are coupled.
+     *
+     * All rows of one color can be relaxed concurrently. BandedMatrixQx<Q1Type> uses the implicit
+     * four color pattern (x % 2, y % 2) of the grid and stores only the grid root; every other
+     * matrix stores the explicit list of rows per color.
+     */
+    class Coloring
+    {
+        private:
+            /// Grid root of an implicit Q1 coloring, 0 for explicit row lists.
+            unsigned long _root;
+
+            /// Rows per color.
+            std::vector<DenseVector<unsigned long> > _rows;
+
+        public:
+            /// Constructor for an empty coloring.
+            Coloring() :
+                _root(0)
+            {
+            }
+
+            /// Constructor for the implicit coloring of a Q1 grid with the given root.
+            explicit Coloring(unsigned long root) :
+                _root(root)
+            {
+            }
+
+            /// Constructor for explicit row lists.
+            explicit Coloring(const std::vector<DenseVector<unsigned long> > & rows) :
+                _root(0),
+                _rows(rows)
+            {
+            }
+
+            /// Returns the number of colors.
+            unsigned long colors() const
+            {
+                return _root > 0 ? 4 : _rows.size();
+            }
+
+            /// Returns whether no coloring is available.
+            bool empty() const
+            {
+                return colors() == 0;
+            }
+
+            /// Returns the grid root of an implicit Q1 coloring.
+            unsigned long root() const
+            {
+                return _root;
+            }
+
+            /// Returns the rows of the given color of an explicit coloring.
+            const DenseVector<unsigned long> & rows(unsigned long color) const
+            {
+                return _rows.at(color);
+            }
+
+            /// Returns the number of independent units (rows or grid lines) of the given color.
+            unsigned long units(unsigned long color) const
+            {
+                return _root > 0 ? (_root - color / 2 + 1) / 2 : _rows.at(color).size();
+            }
+    };
+
+    /**
+     * \brief Computes the Coloring of a system matrix.
+     *
+     * Matrix types without a specialisation yield an empty coloring, which MulticolorSORSmoother
+     * rejects.
+     */
+    template <typename MatrixType_>
+    struct ColoringFill
+    {
+        static Coloring value(const MatrixType_ &)
+        {
+            return Coloring();
+        }
+    };
+
+    template <typename DT_>
+    struct ColoringFill<BandedMatrixQx<Q1Type, DT_> >
+    {
+        static Coloring value(const BandedMatrixQx<Q1Type, DT_> & a)
+        {
+            return Coloring(a.root());
+        }
+    };
+
+    template <typename DT_>
+    struct ColoringFill<SparseMatrixELL<DT_> >
+    {
+        /// Greedy coloring of the symmetrised sparsity pattern, rows in natural order.
+        static Coloring value(const SparseMatrixELL<DT_> & a)
+        {
+            CONTEXT("When coloring SparseMatrixELL:");
+
+            const unsigned long rows(a.rows());
+            const unsigned long * Aj(a.Aj().elements());
+            const DT_ * Ax(a.Ax().elements());
+            const unsigned long * Arl(a.Arl().elements());
+            const unsigned long stride(a.stride());
+            const unsigned long threads(a.threads());
+
+            // collect the neighbours of every row from A and its transpose
+            std::vector<std::vector<unsigned long> > neighbours(rows);
+            for (unsigned long row(0) ; row < rows ; ++row)
+            {
+                for (unsigned long n(0) ; n < Arl[row] ; ++n)
+                {
+                    for (unsigned long thread(0) ; thread < threads ; ++thread)
+                    {
+                        const unsigned long index(row * threads + n * stride + thread);
+                        const unsigned long column(Aj[index]);
+                        if (Ax[index] == DT_(0) || column == row)
+                            continue;
+
+                        neighbours[row].push_back(column);
+                        neighbours[column].push_back(row);
+                    }
+                }
+            }
+
+            std::vector<unsigned long> color(rows, rows);
+            std::vector<unsigned long> used(rows + 1, rows);
+            std::vector<unsigned long> counts;
+            for (unsigned long row(0) ; row < rows ; ++row)
+            {
+                for (std::vector<unsigned long>::const_iterator n(neighbours[row].begin()), n_end(neighbours[row].end()) ; n != n_end ; ++n)
+                {
+                    if (color[*n] < rows)
+                        used[color[*n]] = row;
+                }
+
+                unsigned long c(0);
+                while (used[c] == row)
+                    ++c;
+
+                color[row] = c;
+                if (c == counts.size())
+                    counts.push_back(0);
+                ++counts[c];
+            }
+
+            std::vector<DenseVector<unsigned long> > result;
+            for (unsigned long c(0) ; c < counts.size() ; ++c)
+            {
+                DenseVector<unsigned long> list(counts[c]);
+                result.push_back(list);
+                counts[c] = 0;
+            }
+            for (unsigned long row(0) ; row < rows ; ++row)
+            {
+                result[color[row]][counts[color[row]]] = row;
+                ++counts[color[row]];
+            }
+
+            return Coloring(result);
+        }
+    };
+
+    /**
+     * \brief One multicolor SOR half step: relaxes all rows of a single color in place,
+     * x_i += p_i * (b_i - (A x)_i).
+     *
+     * p holds the damped inverse main diagonal, i.e. the relaxation factor over a_ii as
+     * provided by the "jac" preconditioner of MGUtil::load_data.
+     *
+     * The row range overloads relax the units [start, end) of the color, that are rows of an
+     * explicit coloring or grid lines of an implicit Q1 coloring.
+     *
+     * \ingroup grpmatrixoperations
+     * \ingroup grpvectoroperations
+     */
+    template <typename Tag_ = tags::CPU> struct SORSweep;
+
+    template <> struct SORSweep<tags::CPU>
+    {
+        public:
+            template <typename DT_>
+                static DenseVector<DT_> & value(DenseVector<DT_> & x, const SparseMatrixELL<DT_> & a, const DenseVector<DT_> & p,
+                        const DenseVector<DT_> & b, const DenseVector<unsigned long> & rows, unsigned long start, unsigned long end)
+                {
+                    DT_ * xe(x.elements());
+                    const DT_ * pe(p.elements());
+                    const DT_ * be(b.elements());
+                    const unsigned long * row_list(rows.elements());
+                    const unsigned long * Aj(a.Aj().elements());
+                    const DT_ * Ax(a.Ax().elements());
+                    const unsigned long * Arl(a.Arl().elements());
+                    const unsigned long stride(a.stride());
+                    const unsigned long threads(a.threads());
+
+                    for (unsigned long k(start) ; k < end ; ++k)
+                    {
+                        const unsigned long row(row_list[k]);
+                        const unsigned long * tAj(Aj + row * threads);
+                        const DT_ * tAx(Ax + row * threads);
+                        DT_ sum(0);
+
+                        for (unsigned long n(0) ; n < Arl[row] ; ++n)
+                        {
+                            for (unsigned long thread(0) ; thread < threads ; ++thread)
+                                sum += tAx[thread] * xe[tAj[thread]];
+
+                            tAj += stride;
+                            tAx += stride;
+                        }
+
+                        xe[row] += pe[row] * (be[row] - sum);
+                    }
+
+                    return x;
+                }
+
+            template <typename DT_>
+                static DenseVector<DT_> & value(DenseVector<DT_> & x, const BandedMatrixQx<Q1Type, DT_> & a, const DenseVector<DT_> & p,
+                        const DenseVector<DT_> & b, unsigned long color, unsigned long start, unsigned long end)
+                {
+                    const DT_ * band[9];
+                    intern::banded_q1_bands(band, a);
+                    DT_ * xe(x.elements());
+                    const DT_ * pe(p.elements());
+                    const DT_ * be(b.elements());
+                    const unsigned long m(a.root()), size(a.size());
+
+                    for (unsigned long line(start) ; line < end ; ++line)
+                    {
+                        const unsigned long first((color / 2 + 2 * line) * m);
+                        for (unsigned long i(first + color % 2) ; i < first + m ; i += 2)
+                            xe[i] += pe[i] * (be[i] - intern::banded_q1_sum(band, xe, size, m, i));
+                    }
+
+                    return x;
+                }
+
+            template <typename MatrixType_, typename DT_>
+                static DenseVector<DT_> & value(DenseVector<DT_> & x, const MatrixType_ & a, const DenseVector<DT_> & p,
+                        const DenseVector<DT_> & b, const Coloring & coloring, unsigned long color)
+                {
+                    CONTEXT("When relaxing one color with SOR (CPU):");
+
+                    if (x.size() != a.columns())
+                        throw VectorSizeDoesNotMatch(x.size(), a.columns());
+                    if (b.size() != a.rows())
+                        throw VectorSizeDoesNotMatch(b.size(), a.rows());
+                    if (p.size() != a.rows())
+                        throw VectorSizeDoesNotMatch(p.size(), a.rows());
+
+                    return _value(x, a, p, b, coloring, color);
+                }
+
+        private:
+            template <typename DT_>
+                static DenseVector<DT_> & _value(DenseVector<DT_> & x, const SparseMatrixELL<DT_> & a, const DenseVector<DT_> & p,
+                        const DenseVector<DT_> & b, const Coloring & coloring, unsigned long color)
+                {
+                    return value(x, a, p, b, coloring.rows(color), 0, coloring.units(color));
+                }
+
+            template <typename DT_>
+                static DenseVector<DT_> & _value(DenseVector<DT_> & x, const BandedMatrixQx<Q1Type, DT_> & a, const DenseVector<DT_> & p,
+                        const DenseVector<DT_> & b, const Coloring & coloring, unsigned long color)
+                {
+                    return value(x, a, p, b, color, 0, coloring.units(color));
+                }
+    };
+
+    template <> struct SORSweep<tags::CPU::Generic> :
+        public SORSweep<tags::CPU>
+    {
+    };
+
+    template <> struct SORSweep<tags::CPU::SSE>
+    {
+        public:
+            template <typename DT_>
+                static DenseVector<DT_> & value(DenseVector<DT_> & x, const SparseMatrixELL<DT_> & a, const DenseVector<DT_> & p,
+                        const DenseVector<DT_> & b, const DenseVector<unsigned long> & rows, unsigned long start, unsigned long end)
+                {
+                    // the rows of one color are scattered, the gathers leave nothing to vectorise
+                    return SORSweep<tags::CPU>::value(x, a, p, b, rows, start, end);
+                }
+
+            static DenseVector<float> & value(DenseVector<float> & x, const BandedMatrixQx<Q1Type, float> & a, const DenseVector<float> & p,
+                    const DenseVector<float> & b, unsigned long color, unsigned long start, unsigned long end);
+
+            static DenseVector<double> & value(DenseVector<double> & x, const BandedMatrixQx<Q1Type, double> & a, const DenseVector<double> & p,
+                    const DenseVector<double> & b, unsigned long color, unsigned long start, unsigned long end);
+
+            template <typename MatrixType_, typename DT_>
+                static DenseVector<DT_> & value(DenseVector<DT_> & x, const MatrixType_ & a, const DenseVector<DT_> & p,
+                        const DenseVector<DT_> & b, const Coloring & coloring, unsigned long color)
+                {
+                    CONTEXT("When relaxing one color with SOR (SSE):");
+
+                    if (x.size() != a.columns())
+                        throw VectorSizeDoesNotMatch(x.size(), a.columns());
+                    if (b.size() != a.rows())
+                        throw VectorSizeDoesNotMatch(b.size(), a.rows());
+                    if (p.size() != a.rows())
+                        throw VectorSizeDoesNotMatch(p.size(), a.rows());
+
+                    return _value(x, a, p, b, coloring, color);
+                }
+
+        private:
+            template <typename DT_>
+                static DenseVector<DT_> & _value(DenseVector<DT_> & x, const SparseMatrixELL<DT_> & a, const DenseVector<DT_> & p,
+                        const DenseVector<DT_> & b, const Coloring & coloring, unsigned long color)
+                {
+                    return value(x, a, p, b, coloring.rows(color), 0, coloring.units(color));
+                }
+
+            template <typename DT_>
+                static DenseVector<DT_> & _value(DenseVector<DT_> & x, const BandedMatrixQx<Q1Type, DT_> & a, const DenseVector<DT_> & p,
+                        const DenseVector<DT_> & b, const Coloring & coloring, unsigned long color)
+                {
+                    return value(x, a, p, b, color, 0, coloring.units(color));
+                }
+    };
+
+    namespace mc
+    {
+        template <typename Tag_> struct SORSweep
+        {
+            public:
+                template <typename MatrixType_, typename DT_>
+                    static DenseVector<DT_> & value(DenseVector<DT_> & x, const MatrixType_ & a, const DenseVector<DT_> & p,
+                            const DenseVector<DT_> & b, const Coloring & coloring, unsigned long color)
+                    {
+                        CONTEXT("When relaxing one color with SOR using backend : " + Tag_::name);
+
+                        if (x.size() != a.columns())
+                            throw VectorSizeDoesNotMatch(x.size(), a.columns());
+                        if (b.size() != a.rows())
+                            throw VectorSizeDoesNotMatch(b.size(), a.rows());
+                        if (p.size() != a.rows())
+                            throw VectorSizeDoesNotMatch(p.size(), a.rows());
+
+                        unsigned long max_count(Configuration::instance()->get_value("mc::SORSweep::max_count",
+                                    mc::ThreadPool::instance()->num_threads()));
+
+                        // all units of one color are independent, hand out contiguous blocks of them
+                        const unsigned long units(coloring.units(color));
+                        if (max_count > units)
+                            max_count = units;
+
+                        TicketVector tickets;
+
+                        for (unsigned long i(0) ; i < max_count ; ++i)
+                            _enqueue(tickets, x, a, p, b, coloring, color, i * units / max_count, (i + 1) * units / max_count);
+
+                        tickets.wait();
+
+                        return x;
+                    }
+
+            private:
+                template <typename DT_>
+                    static void _enqueue(TicketVector & tickets, DenseVector<DT_> & x, const SparseMatrixELL<DT_> & a, const DenseVector<DT_> & p,
+                            const DenseVector<DT_> & b, const Coloring & coloring, unsigned long color, unsigned long start, unsigned long end)
+                    {
+                        OperationWrapper<honei::SORSweep<typename Tag_::DelegateTo>, DenseVector<DT_>, DenseVector<DT_>,
+                            SparseMatrixELL<DT_>, DenseVector<DT_>, DenseVector<DT_>, DenseVector<unsigned long>, unsigned long, unsigned long> wrapper(x);
+                        tickets.push_back(mc::ThreadPool::instance()->enqueue(bind(wrapper, x, a, p, b, coloring.rows(color), start, end)));
+                    }
+
+                template <typename DT_>
+                    static void _enqueue(TicketVector & tickets, DenseVector<DT_> & x, const BandedMatrixQx<Q1Type, DT_> & a, const DenseVector<DT_> & p,
+                            const DenseVector<DT_> & b, const Coloring &, unsigned long color, unsigned long start, unsigned long end)
+                    {
+                        OperationWrapper<honei::SORSweep<typename Tag_::DelegateTo>, DenseVector<DT_>, DenseVector<DT_>,
+                            BandedMatrixQx<Q1Type, DT_>, DenseVector<DT_>, DenseVector<DT_>, unsigned long, unsigned long, unsigned long> wrapper(x);
+                        tickets.push_back(mc::ThreadPool::instance()->enqueue(bind(wrapper, x, a, p, b, color, start, end)));
+                    }
+        };
+    }
+
+    template <> struct SORSweep<tags::CPU::MultiCore> :
+        public mc::SORSweep<tags::CPU::MultiCore>
+    {
+    };
+
+    template <> struct SORSweep<tags::CPU::MultiCore::Generic> :
+        public mc::SORSweep<tags::CPU::MultiCore::Generic>
+    {
+    };
+
+    template <> struct SORSweep<tags::CPU::MultiCore::SSE> :
+        public mc::SORSweep<tags::CPU::MultiCore::SSE>
+    {
+    };
+
+    /**
+     * \brief Smoothing with multicolor SOR / Gauss-Seidel.
+     *
+     * Every iteration relaxes the colors one after another, the rows of each color in parallel.
+     * The preconditioner has to be the damped inverse main diagonal; a damping factor of 1
+     * yields multicolor Gauss-Seidel.
+     *
+     * \ingroup grpmatrixoperations
+     * \ingroup grpvectoroperations
+     */
+    template <typename Tag_>
+    struct MulticolorSORSmoother
+    {
+        public:
+            static const unsigned long NUM_TEMPVECS = 0;
+
+            /**
+            * \brief Smoothes x with the given, precomputed coloring of A.
+            *
+            */
+            template <typename MatrixType_,
+                      typename VectorType_,
+                      typename PreconContType_>
+            static void value(MatrixType_ & A,
+                              PreconContType_ & P,
+                              VectorType_ & b,
+                              VectorType_ & x,
+                              std::vector<VectorType_> & /*temp_vecs*/,
+                              unsigned long max_iters,
+                              const Coloring & coloring)
+            {
+                CONTEXT("When smoothing with multicolor SOR: ");
+
+                if (coloring.empty())
+                    throw InternalError("MulticolorSORSmoother: No coloring available for this matrix type!");
+
+                PROFILER_START("MulticolorSORSmoother");
+
+                for(unsigned long i(0) ; i < max_iters ; ++i)
+                {
+                    for(unsigned long color(0) ; color < coloring.colors() ; ++color)
+                    {
+                        SORSweep<Tag_>::value(x, A, P, b, coloring, color);
+                    }
+                }
+
+                PROFILER_STOP("MulticolorSORSmoother");
+            }
+
+            /**
+            * \brief Smoothes x, coloring A on the fly.
+            *
+            */
+            template <typename MatrixType_,
+                      typename VectorType_,
+                      typename PreconContType_>
+            static void value(MatrixType_ & A,
+                              PreconContType_ & P,
+                              VectorType_ & b,
+                              VectorType_ & x,
+                              std::vector<VectorType_> & temp_vecs,
+                              unsigned long max_iters)
+            {
+                value(A, P, b, x, temp_vecs, max_iters, ColoringFill<MatrixType_>::value(A));
+            }
+    };
+}
+
+#endif
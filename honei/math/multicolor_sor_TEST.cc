@@ -0,0 +1,209 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2011 Markus Geveler <apryde@gmx.de>
+ *
+ * This file is part of the HONEI C++ library. HONEI is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * HONEI is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <honei/math/multicolor_sor.hh>
+#include <honei/math/defect.hh>
+#include <honei/la/banded_matrix_qx.hh>
+#include <honei/la/sparse_matrix.hh>
+#include <honei/la/sparse_matrix_ell.hh>
+#include <honei/la/dense_vector.hh>
+#include <honei/la/norm.hh>
+#include <honei/util/unittest.hh>
+
+#include <limits>
+
+using namespace honei;
+using namespace tests;
+
+namespace
+{
+    /// Creates a Q1 Poisson like matrix on a root x root grid with identity rows on the boundary.
+    template <typename DT_>
+    BandedMatrixQx<Q1Type, DT_> q1_matrix(unsigned long root)
+    {
+        const unsigned long size(root * root);
+        DenseVector<DT_> bands[9] = {
+            DenseVector<DT_>(size, DT_(0)), DenseVector<DT_>(size, DT_(0)), DenseVector<DT_>(size, DT_(0)),
+            DenseVector<DT_>(size, DT_(0)), DenseVector<DT_>(size, DT_(0)), DenseVector<DT_>(size, DT_(0)),
+            DenseVector<DT_>(size, DT_(0)), DenseVector<DT_>(size, DT_(0)), DenseVector<DT_>(size, DT_(0)) };
+
+        for (unsigned long i(0) ; i < size ; ++i)
+        {
+            const unsigned long x(i % root), y(i / root);
+            if (x == 0 || y == 0 || x == root - 1 || y == root - 1)
+            {
+                bands[DD][i] = DT_(1);
+                continue;
+            }
+            for (unsigned long band(0) ; band < 9 ; ++band)
+                bands[band][i] = DT_(-1) / DT_(3) - DT_(band % 3) / DT_(50);
+            bands[DD][i] = DT_(8) / DT_(3);
+        }
+
+        return BandedMatrixQx<Q1Type, DT_>(size, bands[LL], bands[LD], bands[LU], bands[DL], bands[DD], bands[DU],
+                bands[UL], bands[UD], bands[UU]);
+    }
+
+    /// Relaxes the rows color by color, one row after another.
+    template <typename DT_>
+    void reference_sweep(DenseVector<DT_> & x, const SparseMatrix<DT_> & a, const DenseVector<DT_> & p, const DenseVector<DT_> & b,
+            const std::vector<std::vector<unsigned long> > & colors)
+    {
+        for (unsigned long color(0) ; color < colors.size() ; ++color)
+        {
+            for (unsigned long k(0) ; k < colors[color].size() ; ++k)
+            {
+                const unsigned long row(colors[color][k]);
+                DT_ sum(0);
+                for (unsigned long column(0) ; column < a.columns() ; ++column)
+                    sum += a(row, column) * x[column];
+                x[row] += p[row] * (b[row] - sum);
+            }
+        }
+    }
+}
+
+template <typename DT_>
+class ColoringFillTest :
+    public QuickTest
+{
+    public:
+        ColoringFillTest(const std::string & type) :
+            QuickTest("coloring_fill_test<" + type + ">")
+        {
+        }
+
+        virtual void run() const
+        {
+            BandedMatrixQx<Q1Type, DT_> q1(q1_matrix<DT_>(9));
+            Coloring implicit(ColoringFill<BandedMatrixQx<Q1Type, DT_> >::value(q1));
+            TEST_CHECK_EQUAL(implicit.colors(), 4ul);
+            TEST_CHECK_EQUAL(implicit.units(0), 5ul);
+            TEST_CHECK_EQUAL(implicit.units(3), 4ul);
+
+            SparseMatrix<DT_> sm(q1);
+            SparseMatrixELL<DT_> ell(sm);
+            Coloring coloring(ColoringFill<SparseMatrixELL<DT_> >::value(ell));
+            TEST_CHECK(! coloring.empty());
+            TEST_CHECK(coloring.colors() <= 9ul);
+
+            std::vector<unsigned long> color_of(ell.rows(), ell.rows());
+            for (unsigned long color(0) ; color < coloring.colors() ; ++color)
+            {
+                for (unsigned long k(0) ; k < coloring.units(color) ; ++k)
+                {
+                    TEST_CHECK_EQUAL(color_of[coloring.rows(color)[k]], ell.rows());
+                    color_of[coloring.rows(color)[k]] = color;
+                }
+            }
+
+            for (unsigned long row(0) ; row < sm.rows() ; ++row)
+            {
+                TEST_CHECK(color_of[row] < coloring.colors());
+                for (unsigned long column(0) ; column < sm.columns() ; ++column)
+                {
+                    if (row != column && (sm(row, column) != DT_(0) || sm(column, row) != DT_(0)))
+                        TEST_CHECK(color_of[row] != color_of[column]);
+                }
+            }
+
+            TEST_CHECK(ColoringFill<DenseVector<DT_> >::value(DenseVector<DT_>(3)).empty());
+        }
+};
+ColoringFillTest<float> coloring_fill_test_float("float");
+ColoringFillTest<double> coloring_fill_test_double("double");
+
+template <typename Tag_, typename DT_>
+class MulticolorSORSmootherQuickTest :
+    public QuickTest
+{
+    public:
+        MulticolorSORSmootherQuickTest(const std::string & type) :
+            QuickTest("multicolor_sor_smoother_quick_test<" + type + ">")
+        {
+            register_tag(Tag_::name);
+        }
+
+        virtual void run() const
+        {
+            for (unsigned long root(3) ; root < 40 ; root += 6)
+            {
+                BandedMatrixQx<Q1Type, DT_> q1(q1_matrix<DT_>(root));
+                SparseMatrix<DT_> sm(q1);
+                SparseMatrixELL<DT_> ell(sm);
+                const unsigned long size(q1.size());
+
+                DenseVector<DT_> b(size), x(size), p(size);
+                for (unsigned long i(0) ; i < size ; ++i)
+                {
+                    b[i] = DT_(i % 7) / DT_(3);
+                    x[i] = DT_(i % 5) / DT_(4) - DT_(0.5);
+                    p[i] = DT_(0.9) / sm(i, i);
+                }
+
+                std::vector<std::vector<unsigned long> > q1_colors(4);
+                for (unsigned long i(0) ; i < size ; ++i)
+                    q1_colors[(i % root) % 2 + 2 * ((i / root) % 2)].push_back(i);
+
+                Coloring coloring(ColoringFill<SparseMatrixELL<DT_> >::value(ell));
+                std::vector<std::vector<unsigned long> > ell_colors(coloring.colors());
+                for (unsigned long color(0) ; color < coloring.colors() ; ++color)
+                    for (unsigned long k(0) ; k < coloring.units(color) ; ++k)
+                        ell_colors[color].push_back(coloring.rows(color)[k]);
+
+                std::vector<DenseVector<DT_> > temp_vecs;
+                DenseVector<DT_> x_q1(x.copy()), x_ell(x.copy()), ref_q1(x.copy()), ref_ell(x.copy());
+                MulticolorSORSmoother<Tag_>::value(q1, p, b, x_q1, temp_vecs, 3);
+                MulticolorSORSmoother<Tag_>::value(ell, p, b, x_ell, temp_vecs, 3, coloring);
+                for (unsigned long i(0) ; i < 3 ; ++i)
+                {
+                    reference_sweep(ref_q1, sm, p, b, q1_colors);
+                    reference_sweep(ref_ell, sm, p, b, ell_colors);
+                }
+
+                for (unsigned long i(0) ; i < size ; ++i)
+                {
+                    TEST_CHECK_EQUAL_WITHIN_EPS(x_q1[i], ref_q1[i], std::numeric_limits<DT_>::epsilon() * 50);
+                    TEST_CHECK_EQUAL_WITHIN_EPS(x_ell[i], ref_ell[i], std::numeric_limits<DT_>::epsilon() * 50);
+                }
+
+                DT_ initial(Norm<vnt_l_two, false, tags::CPU>::value(Defect<tags::CPU>::value(b, q1, x)));
+                DT_ smoothed(Norm<vnt_l_two, false, tags::CPU>::value(Defect<tags::CPU>::value(b, q1, x_q1)));
+                TEST_CHECK(smoothed < initial);
+            }
+
+            BandedMatrixQx<Q1Type, DT_> q1(q1_matrix<DT_>(5));
+            DenseVector<DT_> b(25), x(24), p(25);
+            std::vector<DenseVector<DT_> > temp_vecs;
+            TEST_CHECK_THROWS(MulticolorSORSmoother<Tag_>::value(q1, p, b, x, temp_vecs, 1), VectorSizeDoesNotMatch);
+
+            DenseVector<DT_> x_2(25);
+            TEST_CHECK_THROWS(MulticolorSORSmoother<Tag_>::value(q1, p, b, x_2, temp_vecs, 1, Coloring()), InternalError);
+        }
+};
+MulticolorSORSmootherQuickTest<tags::CPU, float> multicolor_sor_smoother_quick_test_float("float");
+MulticolorSORSmootherQuickTest<tags::CPU, double> multicolor_sor_smoother_quick_test_double("double");
+MulticolorSORSmootherQuickTest<tags::CPU::MultiCore, float> mc_multicolor_sor_smoother_quick_test_float("MC float");
+MulticolorSORSmootherQuickTest<tags::CPU::MultiCore, double> mc_multicolor_sor_smoother_quick_test_double("MC double");
+#ifdef HONEI_SSE
+MulticolorSORSmootherQuickTest<tags::CPU::SSE, float> sse_multicolor_sor_smoother_quick_test_float("SSE float");
+MulticolorSORSmootherQuickTest<tags::CPU::SSE, double> sse_multicolor_sor_smoother_quick_test_double("SSE double");
+MulticolorSORSmootherQuickTest<tags::CPU::MultiCore::SSE, float> mc_sse_multicolor_sor_smoother_quick_test_float("MC SSE float");
+MulticolorSORSmootherQuickTest<tags::CPU::MultiCore::SSE, double> mc_sse_multicolor_sor_smoother_quick_test_double("MC SSE double");
+#endif
@@ -27,6 +27,7 @@
 #include <honei/la/scaled_sum.hh>
 #include <honei/math/cg.hh>
 #include <honei/math/ri.hh>
+#include <honei/math/multicolor_sor.hh>
 
 namespace honei
 {
@@ -294,7 +295,7 @@ namespace honei
             {
                 CONTEXT("When evaluating SolverOperator:");
                 //std::cout << _x << std::endl;
-                SolverType_::value(_A, _P, _b, _x, _max_iters, _used_iters, _eps_relative);
+                _solver.value(_A, _P, _b, _x, _max_iters, _used_iters, _eps_relative);
                 //std::cout << _x << std::endl;
             }
 
@@ -311,8 +312,45 @@ namespace honei
             unsigned long _max_iters;
             unsigned long & _used_iters;
             DataType_ _eps_relative;
+            /// Solver instance, lets solvers like SuperLU keep their setup across calls.
+            SolverType_ _solver;
     };
 
+    namespace intern
+    {
+        /// Calls a smoother, handing the coloring slot to the smoothers that make use of it.
+        template <typename SmootherType_>
+        struct SmootherCall
+        {
+            template <typename MatrixType_, typename VectorType_, typename PreconContType_>
+            static void value(MatrixType_ & A, PreconContType_ & P, VectorType_ & b, VectorType_ & x,
+                    std::vector<VectorType_> & temp_vecs, unsigned long max_iters, Coloring * /*coloring*/)
+            {
+                SmootherType_::value(A, P, b, x, temp_vecs, max_iters);
+            }
+        };
+
+        template <typename Tag_>
+        struct SmootherCall<MulticolorSORSmoother<Tag_> >
+        {
+            template <typename MatrixType_, typename VectorType_, typename PreconContType_>
+            static void value(MatrixType_ & A, PreconContType_ & P, VectorType_ & b, VectorType_ & x,
+                    std::vector<VectorType_> & temp_vecs, unsigned long max_iters, Coloring * coloring)
+            {
+                if (coloring == 0)
+                {
+                    MulticolorSORSmoother<Tag_>::value(A, P, b, x, temp_vecs, max_iters);
+                    return;
+                }
+
+                // color the level on its first smoothing step and keep the result for the following cycles
+                if (coloring->empty())
+                    *coloring = ColoringFill<MatrixType_>::value(A);
+                MulticolorSORSmoother<Tag_>::value(A, P, b, x, temp_vecs, max_iters, *coloring);
+            }
+        };
+    }
+
     template<typename SmootherType_, typename MatrixType_, typename VectorType_, typename PreconContType_>
     class SmootherOperator : public Operator
     {
@@ -335,13 +373,15 @@ namespace honei
                              //VectorType_ & temp_0,
                              //VectorType_ & temp_1,
                              std::vector<VectorType_> & temp_vecs,
-                             unsigned long max_iters) :
+                             unsigned long max_iters,
+                             Coloring * coloring = 0) :
                 _A(A),
                 _P(P),
                 _b(b),
                 _x(x),
                 _temp_vecs(temp_vecs),
-                _max_iters(max_iters)
+                _max_iters(max_iters),
+                _coloring(coloring)
             {
                 CONTEXT("When creating SmootherOperator:");
 
@@ -362,7 +402,7 @@ namespace honei
                 CONTEXT("When evaluating SmootherOperator:");
                 //std::cout << "x before" << _x;
                 //std::cout << "rhs" << _b;
-                SmootherType_::value(_A, _P, _b, _x, _temp_vecs, _max_iters);
+                intern::SmootherCall<SmootherType_>::value(_A, _P, _b, _x, _temp_vecs, _max_iters, _coloring);
                 //std::cout << "x after" << _x;
             }
 
@@ -378,6 +418,7 @@ namespace honei
             VectorType_ _x;
             std::vector<VectorType_> & _temp_vecs;
             unsigned long _max_iters;
+            Coloring * _coloring;
     };
 
     template<typename TransferType_, typename MatrixType_, typename VectorType_>
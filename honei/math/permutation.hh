@@ -0,0 +1,205 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2011 Dirk Ribbrock <dirk.ribbrock@math.uni-dortmund.de>
+ *
+ * This file is part of the MATH C++ library. LibMath is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LibMath is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#pragma once
+#ifndef LIBMATH_GUARD_PERMUTATION_HH
+#define LIBMATH_GUARD_PERMUTATION_HH 1
+
+#include <honei/util/tags.hh>
+#include <honei/la/dense_vector.hh>
+#include <honei/la/sparse_matrix.hh>
+#include <honei/la/sparse_matrix_csr.hh>
+#include <honei/la/sparse_matrix_ell.hh>
+#include <honei/la/vector_error.hh>
+#include <honei/la/matrix_error.hh>
+
+#include <vector>
+#include <algorithm>
+#include <utility>
+
+namespace honei
+{
+    /**
+     * \brief Permutation renumbers vectors and matrices by an index permutation.
+     *
+     * permutation[i] is the original index of the entry that is numbered i after the permutation, as
+     * created by Reordering. Square matrices are permuted symmetrically, so a permuted system
+     * P A P^T (P x) = P b keeps its spectrum and the solution only has to be permuted back.
+     *
+     * \ingroup grpmatrixoperations
+     */
+    template <typename Tag_ = tags::CPU>
+    struct Permutation
+    {
+        /// Returns the inverse permutation, mapping original indices to new ones.
+        static DenseVector<unsigned long> inverse(const DenseVector<unsigned long> & permutation)
+        {
+            DenseVector<unsigned long> result(permutation.size());
+            for (unsigned long i(0) ; i < permutation.size() ; ++i)
+                result[permutation[i]] = i;
+
+            return result;
+        }
+
+        /**
+         * Permutes a vector, result[i] = x[permutation[i]].
+         *
+         * \param result The permuted vector, must not share its elements with x.
+         * \param x The vector to be permuted.
+         * \param permutation The permutation.
+         */
+        template <typename DT_>
+        static DenseVector<DT_> & value(DenseVector<DT_> & result, const DenseVector<DT_> & x, const DenseVector<unsigned long> & permutation)
+        {
+            CONTEXT("When permuting DenseVector:");
+
+            if (x.size() != permutation.size())
+                throw VectorSizeDoesNotMatch(x.size(), permutation.size());
+            if (result.size() != permutation.size())
+                throw VectorSizeDoesNotMatch(result.size(), permutation.size());
+
+            const DT_ * xe(x.elements());
+            DT_ * re(result.elements());
+            const unsigned long * pe(permutation.elements());
+            for (unsigned long i(0) ; i < permutation.size() ; ++i)
+                re[i] = xe[pe[i]];
+
+            return result;
+        }
+
+        /// Returns a permuted copy of a vector, see value(result, x, permutation).
+        template <typename DT_>
+        static DenseVector<DT_> value(const DenseVector<DT_> & x, const DenseVector<unsigned long> & permutation)
+        {
+            DenseVector<DT_> result(x.size());
+            value(result, x, permutation);
+
+            return result;
+        }
+
+        /**
+         * Undoes a permutation of a vector, result[permutation[i]] = x[i].
+         *
+         * \param result The vector in the original ordering, must not share its elements with x.
+         * \param x The permuted vector.
+         * \param permutation The permutation.
+         */
+        template <typename DT_>
+        static DenseVector<DT_> & back(DenseVector<DT_> & result, const DenseVector<DT_> & x, const DenseVector<unsigned long> & permutation)
+        {
+            CONTEXT("When permuting DenseVector back:");
+
+            if (x.size() != permutation.size())
+                throw VectorSizeDoesNotMatch(x.size(), permutation.size());
+            if (result.size() != permutation.size())
+                throw VectorSizeDoesNotMatch(result.size(), permutation.size());
+
+            const DT_ * xe(x.elements());
+            DT_ * re(result.elements());
+            const unsigned long * pe(permutation.elements());
+            for (unsigned long i(0) ; i < permutation.size() ; ++i)
+                re[pe[i]] = xe[i];
+
+            return result;
+        }
+
+        /**
+         * Permutes the rows and columns of a matrix independently, result(i, j) = a(row_permutation[i], column_permutation[j]).
+         *
+         * Used for transfer operators, whose rows and columns belong to different levels.
+         */
+        template <typename DT_>
+        static SparseMatrix<DT_> value(const SparseMatrix<DT_> & a, const DenseVector<unsigned long> & row_permutation,
+                const DenseVector<unsigned long> & column_permutation)
+        {
+            CONTEXT("When permuting SparseMatrix:");
+
+            if (a.rows() != row_permutation.size())
+                throw MatrixRowsDoNotMatch(row_permutation.size(), a.rows());
+            if (a.columns() != column_permutation.size())
+                throw MatrixColumnsDoNotMatch(column_permutation.size(), a.columns());
+
+            DenseVector<unsigned long> column_inverse(inverse(column_permutation));
+
+            std::vector<unsigned long> row_indices, column_indices;
+            std::vector<DT_> data;
+            std::vector<std::pair<unsigned long, DT_> > entries;
+            for (unsigned long row(0) ; row < a.rows() ; ++row)
+            {
+                const SparseVector<DT_> & r(a[row_permutation[row]]);
+                entries.clear();
+                for (unsigned long i(0) ; i < r.used_elements() ; ++i)
+                    entries.push_back(std::make_pair(column_inverse[r.indices()[i]], r.elements()[i]));
+                std::sort(entries.begin(), entries.end());
+
+                for (unsigned long i(0) ; i < entries.size() ; ++i)
+                {
+                    row_indices.push_back(row);
+                    column_indices.push_back(entries[i].first);
+                    data.push_back(entries[i].second);
+                }
+            }
+
+            if (data.empty())
+                return SparseMatrix<DT_>(a.rows(), a.columns());
+
+            return SparseMatrix<DT_>(a.rows(), a.columns(), &row_indices[0], &column_indices[0], &data[0], data.size());
+        }
+
+        /// Permutes a square matrix symmetrically, result(i, j) = a(permutation[i], permutation[j]).
+        template <typename DT_>
+        static SparseMatrix<DT_> value(const SparseMatrix<DT_> & a, const DenseVector<unsigned long> & permutation)
+        {
+            return value(a, permutation, permutation);
+        }
+
+        template <typename DT_>
+        static SparseMatrixELL<DT_> value(const SparseMatrixELL<DT_> & a, const DenseVector<unsigned long> & row_permutation,
+                const DenseVector<unsigned long> & column_permutation)
+        {
+            SparseMatrix<DT_> temp(a);
+            SparseMatrix<DT_> result(value(temp, row_permutation, column_permutation));
+
+            return SparseMatrixELL<DT_>(result);
+        }
+
+        template <typename DT_>
+        static SparseMatrixELL<DT_> value(const SparseMatrixELL<DT_> & a, const DenseVector<unsigned long> & permutation)
+        {
+            return value(a, permutation, permutation);
+        }
+
+        template <typename DT_>
+        static SparseMatrixCSR<DT_> value(const SparseMatrixCSR<DT_> & a, const DenseVector<unsigned long> & row_permutation,
+                const DenseVector<unsigned long> & column_permutation)
+        {
+            SparseMatrix<DT_> temp(a);
+            SparseMatrix<DT_> result(value(temp, row_permutation, column_permutation));
+
+            return SparseMatrixCSR<DT_>(result);
+        }
+
+        template <typename DT_>
+        static SparseMatrixCSR<DT_> value(const SparseMatrixCSR<DT_> & a, const DenseVector<unsigned long> & permutation)
+        {
+            return value(a, permutation, permutation);
+        }
+    };
+}
+#endif
@@ -0,0 +1,251 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2011 Dirk Ribbrock <dirk.ribbrock@math.uni-dortmund.de>
+ *
+ * This file is part of the MATH C++ library. LibMath is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LibMath is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <honei/math/permutation.hh>
+#include <honei/math/reordering.hh>
+#include <honei/math/mg.hh>
+#include <honei/math/ri.hh>
+#include <honei/la/product.hh>
+#include <honei/util/unittest.hh>
+
+using namespace honei;
+using namespace tests;
+
+namespace
+{
+    /// Creates the 1D laplacian with size unknowns.
+    template <typename DT_>
+    SparseMatrix<DT_> laplacian(unsigned long size)
+    {
+        SparseMatrix<DT_> result(size, size);
+        for (unsigned long i(0) ; i < size ; ++i)
+        {
+            result(i, i) = DT_(2);
+            if (i > 0)
+                result(i, i - 1) = DT_(-1);
+            if (i < size - 1)
+                result(i, i + 1) = DT_(-1);
+        }
+
+        return result;
+    }
+
+    DenseVector<unsigned long> reversed_odd_even(unsigned long size)
+    {
+        DenseVector<unsigned long> result(size);
+        unsigned long index(0);
+        for (unsigned long i(1) ; i < size ; i += 2)
+            result[index++] = size - 1 - i;
+        for (unsigned long i(0) ; i < size ; i += 2)
+            result[index++] = size - 1 - i;
+
+        return result;
+    }
+}
+
+template <typename Tag_, typename DT_>
+class PermutationTest:
+    public BaseTest
+{
+    public:
+        PermutationTest(const std::string & tag) :
+            BaseTest("Permutation test <" + tag + ">")
+        {
+            register_tag(Tag_::name);
+        }
+
+        virtual void run() const
+        {
+            const unsigned long size(101);
+            DenseVector<unsigned long> permutation(reversed_odd_even(size));
+            DenseVector<unsigned long> inverse(Permutation<Tag_>::inverse(permutation));
+            for (unsigned long i(0) ; i < size ; ++i)
+                TEST_CHECK_EQUAL(inverse[permutation[i]], i);
+
+            DenseVector<DT_> x(size);
+            for (unsigned long i(0) ; i < size ; ++i)
+                x[i] = DT_(i % 13) / DT_(3);
+            DenseVector<DT_> px(Permutation<Tag_>::value(x, permutation));
+            for (unsigned long i(0) ; i < size ; ++i)
+                TEST_CHECK_EQUAL(px[i], x[permutation[i]]);
+            DenseVector<DT_> x_back(size);
+            Permutation<Tag_>::back(x_back, px, permutation);
+            TEST_CHECK_EQUAL(x_back, x);
+
+            // (P A P^T) (P x) = P (A x)
+            SparseMatrix<DT_> a(laplacian<DT_>(size));
+            a(3, 70) = DT_(5);
+            DenseVector<DT_> ax(size);
+            SparseMatrixELL<DT_> ell(a);
+            Product<Tag_>::value(ax, ell, x);
+            DenseVector<DT_> pax(Permutation<Tag_>::value(ax, permutation));
+
+            SparseMatrix<DT_> pa(Permutation<Tag_>::value(a, permutation));
+            TEST_CHECK_EQUAL(pa.used_elements(), a.used_elements());
+            TEST_CHECK_EQUAL(pa(inverse[3], inverse[70]), DT_(5));
+
+            SparseMatrixELL<DT_> pell(Permutation<Tag_>::value(ell, permutation));
+            TEST_CHECK_EQUAL(pell, SparseMatrixELL<DT_>(pa));
+            DenseVector<DT_> result(size);
+            Product<Tag_>::value(result, pell, px);
+            for (unsigned long i(0) ; i < size ; ++i)
+                TEST_CHECK_EQUAL_WITHIN_EPS(result[i], pax[i], 1e-5);
+
+            SparseMatrixCSR<DT_> csr(a);
+            SparseMatrixCSR<DT_> pcsr(Permutation<Tag_>::value(csr, permutation));
+            Product<Tag_>::value(result, pcsr, px);
+            for (unsigned long i(0) ; i < size ; ++i)
+                TEST_CHECK_EQUAL_WITHIN_EPS(result[i], pax[i], 1e-5);
+
+            DenseVector<unsigned long> wrong(size - 1);
+            TEST_CHECK_THROWS(Permutation<Tag_>::value(x, wrong), VectorSizeDoesNotMatch);
+            TEST_CHECK_THROWS(Permutation<Tag_>::value(a, wrong), MatrixRowsDoNotMatch);
+        }
+};
+PermutationTest<tags::CPU, float> permutation_test_float("float");
+PermutationTest<tags::CPU, double> permutation_test_double("double");
+PermutationTest<tags::CPU::MultiCore, double> mc_permutation_test_double("double");
+#ifdef HONEI_SSE
+PermutationTest<tags::CPU::SSE, double> sse_permutation_test_double("double");
+#endif
+
+template <typename Tag_>
+class MGPermutationTest:
+    public BaseTest
+{
+    public:
+        MGPermutationTest(const std::string & tag) :
+            BaseTest("MG permutation test <" + tag + ">")
+        {
+            register_tag(Tag_::name);
+        }
+
+        virtual void run() const
+        {
+            // three levels of the 1D laplacian with linear interpolation
+            std::vector<SparseMatrixELL<double> > A;
+            std::vector<SparseMatrixELL<double> > Res;
+            std::vector<SparseMatrixELL<double> > Prol;
+            std::vector<DenseVector<double> > P;
+            std::vector<DenseVector<double> > b;
+            std::vector<DenseVector<double> > x;
+            std::vector<DenseVector<double> > c;
+            std::vector<DenseVector<double> > d;
+            std::vector<DenseVector<double> > store;
+            std::vector<std::vector<DenseVector<double> > > stv;
+            for (unsigned long level(0) ; level < 3 ; ++level)
+            {
+                const unsigned long size((4ul << level) + 1);
+                SparseMatrixELL<double> a(laplacian<double>(size));
+                A.push_back(a);
+                P.push_back(DenseVector<double>(size, 0.5));
+                DenseVector<double> rhs(size);
+                for (unsigned long i(0) ; i < size ; ++i)
+                    rhs[i] = double(i);
+                b.push_back(rhs);
+                x.push_back(rhs.copy());
+                c.push_back(rhs.copy());
+                d.push_back(rhs.copy());
+                store.push_back(rhs.copy());
+                stv.push_back(std::vector<DenseVector<double> >());
+
+                if (level > 0)
+                {
+                    const unsigned long coarse_size((4ul << (level - 1)) + 1);
+                    SparseMatrix<double> prol(size, coarse_size);
+                    SparseMatrix<double> res(coarse_size, size);
+                    for (unsigned long i(0) ; i < size ; ++i)
+                    {
+                        if (i % 2 == 0)
+                            prol(i, i / 2) = 1.;
+                        else
+                        {
+                            prol(i, i / 2) = 0.5;
+                            prol(i, i / 2 + 1) = 0.5;
+                        }
+                    }
+                    for (unsigned long i(0) ; i < size ; ++i)
+                        for (unsigned long j(0) ; j < coarse_size ; ++j)
+                            if (prol(i, j) != 0.)
+                                res(j, i) = prol(i, j);
+                    Prol.push_back(SparseMatrixELL<double>(prol));
+                    Res.push_back(SparseMatrixELL<double>(res));
+                }
+            }
+
+            typedef MGUtil<Tag_, SparseMatrixELL<double>, DenseVector<double>, SparseMatrixELL<double>, DenseVector<double>,
+                    MatrixIO<io_formats::ELL>, VectorIO<io_formats::EXP>, double> Util;
+            MGData<SparseMatrixELL<double>, DenseVector<double>, SparseMatrixELL<double>, DenseVector<double>, double>
+                original(A, Res, Prol, P, b, x, d, c, store, stv, 0, 0, 0, 0, 0, 0.);
+            MGData<SparseMatrixELL<double>, DenseVector<double>, SparseMatrixELL<double>, DenseVector<double>, double>
+                data(A, Res, Prol, P, b, x, d, c, store, stv, 0, 0, 0, 0, 0, 0.);
+            data.A.clear();
+            data.prolmat.clear();
+            data.resmat.clear();
+            for (unsigned long level(0) ; level < 3 ; ++level)
+            {
+                data.A.push_back(A.at(level).copy());
+                if (level < 2)
+                {
+                    data.prolmat.push_back(Prol.at(level).copy());
+                    data.resmat.push_back(Res.at(level).copy());
+                }
+            }
+
+            std::vector<DenseVector<unsigned long> > permutations;
+            for (unsigned long level(0) ; level < 3 ; ++level)
+                permutations.push_back(reversed_odd_even(A.at(level).rows()));
+            Util::permute(data, permutations);
+
+            for (unsigned long level(0) ; level < 3 ; ++level)
+            {
+                const DenseVector<unsigned long> & p(permutations.at(level));
+                TEST_CHECK_EQUAL(data.A.at(level), Permutation<Tag_>::value(original.A.at(level), p));
+                TEST_CHECK_EQUAL(data.b.at(level), Permutation<Tag_>::value(original.b.at(level), p));
+                TEST_CHECK_EQUAL(data.P.at(level), Permutation<Tag_>::value(original.P.at(level), p));
+            }
+
+            // prolongation of a permuted coarse vector equals the permuted prolongation
+            for (unsigned long level(0) ; level < 2 ; ++level)
+            {
+                DenseVector<double> coarse(A.at(level).rows());
+                for (unsigned long i(0) ; i < coarse.size() ; ++i)
+                    coarse[i] = double(i * i);
+                DenseVector<double> fine(A.at(level + 1).rows());
+                Product<Tag_>::value(fine, original.prolmat.at(level), coarse);
+
+                DenseVector<double> fine_permuted(fine.size());
+                Product<Tag_>::value(fine_permuted, data.prolmat.at(level), Permutation<Tag_>::value(coarse, permutations.at(level)));
+                TEST_CHECK_EQUAL(fine_permuted, Permutation<Tag_>::value(fine, permutations.at(level + 1)));
+
+                DenseVector<double> restricted(coarse.size());
+                Product<Tag_>::value(restricted, original.resmat.at(level), fine);
+                DenseVector<double> restricted_permuted(coarse.size());
+                Product<Tag_>::value(restricted_permuted, data.resmat.at(level), Permutation<Tag_>::value(fine, permutations.at(level + 1)));
+                TEST_CHECK_EQUAL(restricted_permuted, Permutation<Tag_>::value(restricted, permutations.at(level)));
+            }
+
+            std::vector<DenseVector<unsigned long> > rcm;
+            Util::template reorder<methods::RCM>(data, rcm);
+            TEST_CHECK_EQUAL(rcm.size(), 3ul);
+            for (unsigned long level(0) ; level < 3 ; ++level)
+                TEST_CHECK_EQUAL(rcm.at(level).size(), A.at(level).rows());
+        }
+};
+MGPermutationTest<tags::CPU> mg_permutation_test("double");
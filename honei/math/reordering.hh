@@ -23,10 +23,283 @@
 
 #include<honei/math/methods.hh>
 #include<honei/la/dense_vector.hh>
+#include<honei/la/sparse_matrix.hh>
+#include<honei/la/sparse_matrix_csr.hh>
+#include<honei/la/sparse_matrix_ell.hh>
+#include<honei/la/vector_error.hh>
+#include<honei/util/configuration.hh>
+#include<honei/util/exception.hh>
+#include<honei/util/stringify.hh>
 #include<cmath>
+#include<vector>
+#include<algorithm>
 
 namespace honei
 {
+    namespace intern
+    {
+        /**
+         * Symmetric adjacency structure of a square sparse matrix, without self loops.
+         *
+         * Every stored entry a_ij connects i and j, regardless of its value and of a_ji.
+         */
+        class ReorderingGraph
+        {
+            private:
+                std::vector<unsigned long> _offsets;
+                std::vector<unsigned long> _neighbours;
+
+            public:
+                template <typename DT_>
+                explicit ReorderingGraph(const SparseMatrix<DT_> & a) :
+                    _offsets(a.rows() + 1, 0)
+                {
+                    if (a.rows() != a.columns())
+                        throw InternalError("Reordering: matrix with " + stringify(a.rows()) + " rows and "
+                                + stringify(a.columns()) + " columns is not square!");
+
+                    const unsigned long size(a.rows());
+                    std::vector<unsigned long> count(size + 1, 0);
+                    for (unsigned long row(0) ; row < size ; ++row)
+                    {
+                        const SparseVector<DT_> & r(a[row]);
+                        for (unsigned long i(0) ; i < r.used_elements() ; ++i)
+                            if (r.indices()[i] != row)
+                            {
+                                ++count[row];
+                                ++count[r.indices()[i]];
+                            }
+                    }
+
+                    std::vector<unsigned long> cursor(size + 1, 0);
+                    for (unsigned long node(0) ; node < size ; ++node)
+                        cursor[node + 1] = cursor[node] + count[node];
+
+                    std::vector<unsigned long> all(cursor[size]);
+                    for (unsigned long row(0) ; row < size ; ++row)
+                    {
+                        const SparseVector<DT_> & r(a[row]);
+                        for (unsigned long i(0) ; i < r.used_elements() ; ++i)
+                        {
+                            const unsigned long column(r.indices()[i]);
+                            if (column != row)
+                            {
+                                all[cursor[row] + --count[row]] = column;
+                                all[cursor[column] + --count[column]] = row;
+                            }
+                        }
+                    }
+
+                    // drop the duplicates of entries that are stored in both triangles
+                    _neighbours.reserve(all.size());
+                    for (unsigned long node(0) ; node < size ; ++node)
+                    {
+                        std::sort(all.begin() + cursor[node], all.begin() + cursor[node + 1]);
+                        _offsets[node] = _neighbours.size();
+                        for (unsigned long k(cursor[node]) ; k < cursor[node + 1] ; ++k)
+                            if (k == cursor[node] || all[k] != all[k - 1])
+                                _neighbours.push_back(all[k]);
+                    }
+                    _offsets[size] = _neighbours.size();
+                }
+
+                unsigned long size() const
+                {
+                    return _offsets.size() - 1;
+                }
+
+                unsigned long degree(unsigned long node) const
+                {
+                    return _offsets[node + 1] - _offsets[node];
+                }
+
+                /// Index of the first neighbour of node, use with neighbour().
+                unsigned long start(unsigned long node) const
+                {
+                    return _offsets[node];
+                }
+
+                /// Index one past the last neighbour of node, use with neighbour().
+                unsigned long end(unsigned long node) const
+                {
+                    return _offsets[node + 1];
+                }
+
+                unsigned long neighbour(unsigned long index) const
+                {
+                    return _neighbours[index];
+                }
+        };
+
+        /// Orders vertices by ascending degree, ties by index.
+        class DegreeLess
+        {
+            private:
+                const ReorderingGraph & _graph;
+
+            public:
+                DegreeLess(const ReorderingGraph & graph) :
+                    _graph(graph)
+                {
+                }
+
+                bool operator() (unsigned long a, unsigned long b) const
+                {
+                    return _graph.degree(a) < _graph.degree(b) || (_graph.degree(a) == _graph.degree(b) && a < b);
+                }
+        };
+
+        /**
+         * Breadth first search from root over the active vertices.
+         *
+         * Stores the visited vertices level by level in order and the first index of every level in
+         * level_starts, followed by order.size(). Visited vertices are tagged with a fresh stamp in marks,
+         * so the search only costs the size of the component of root. Returns the number of levels.
+         */
+        inline unsigned long level_structure(const ReorderingGraph & graph, unsigned long root, const std::vector<char> & active,
+                std::vector<unsigned long> & marks, unsigned long & stamp,
+                std::vector<unsigned long> & order, std::vector<unsigned long> & level_starts)
+        {
+            ++stamp;
+            order.clear();
+            level_starts.clear();
+
+            marks[root] = stamp;
+            order.push_back(root);
+            unsigned long begin(0);
+            while (begin < order.size())
+            {
+                level_starts.push_back(begin);
+                const unsigned long end(order.size());
+                for (unsigned long k(begin) ; k < end ; ++k)
+                {
+                    const unsigned long node(order[k]);
+                    for (unsigned long n(graph.start(node)) ; n < graph.end(node) ; ++n)
+                    {
+                        const unsigned long next(graph.neighbour(n));
+                        if (active[next] && marks[next] != stamp)
+                        {
+                            marks[next] = stamp;
+                            order.push_back(next);
+                        }
+                    }
+                }
+                begin = end;
+            }
+            level_starts.push_back(order.size());
+
+            return level_starts.size() - 1;
+        }
+
+        /**
+         * Finds a pseudo peripheral vertex in the component of start, following George and Liu.
+         *
+         * On return, order and level_starts hold the level structure rooted at the returned vertex.
+         */
+        inline unsigned long pseudo_peripheral(const ReorderingGraph & graph, unsigned long start, const std::vector<char> & active,
+                std::vector<unsigned long> & marks, unsigned long & stamp,
+                std::vector<unsigned long> & order, std::vector<unsigned long> & level_starts)
+        {
+            unsigned long root(start);
+            unsigned long levels(level_structure(graph, root, active, marks, stamp, order, level_starts));
+            std::vector<unsigned long> candidate_order, candidate_starts;
+            while (true)
+            {
+                unsigned long candidate(order[level_starts[levels - 1]]);
+                for (unsigned long k(level_starts[levels - 1]) ; k < level_starts[levels] ; ++k)
+                    if (graph.degree(order[k]) < graph.degree(candidate))
+                        candidate = order[k];
+
+                unsigned long candidate_levels(level_structure(graph, candidate, active, marks, stamp, candidate_order, candidate_starts));
+                if (candidate_levels <= levels)
+                    break;
+
+                root = candidate;
+                levels = candidate_levels;
+                order.swap(candidate_order);
+                level_starts.swap(candidate_starts);
+            }
+
+            return root;
+        }
+
+        /**
+         * Appends the Cuthill-McKee ordering of the active component of root to result and
+         * deactivates all vertices of that component. Neighbours are visited by ascending degree.
+         */
+        inline void cuthill_mckee(const ReorderingGraph & graph, unsigned long root, std::vector<char> & active,
+                std::vector<unsigned long> & result)
+        {
+            unsigned long head(result.size());
+            active[root] = 0;
+            result.push_back(root);
+            std::vector<unsigned long> next;
+            while (head < result.size())
+            {
+                const unsigned long node(result[head]);
+                ++head;
+
+                next.clear();
+                for (unsigned long n(graph.start(node)) ; n < graph.end(node) ; ++n)
+                    if (active[graph.neighbour(n)])
+                    {
+                        active[graph.neighbour(n)] = 0;
+                        next.push_back(graph.neighbour(n));
+                    }
+                std::sort(next.begin(), next.end(), DegreeLess(graph));
+                result.insert(result.end(), next.begin(), next.end());
+            }
+        }
+
+        /**
+         * Appends the nested dissection ordering of the active vertices among nodes to result.
+         *
+         * Every component larger than leaf_size is split by the middle level of a level structure that is
+         * rooted at a pseudo peripheral vertex. Both halves are ordered recursively, followed by the separator.
+         * Smaller components are ordered by Cuthill-McKee, so every leaf occupies a contiguous index range.
+         */
+        inline void nested_dissection(const ReorderingGraph & graph, const std::vector<unsigned long> & nodes, std::vector<char> & active,
+                std::vector<unsigned long> & marks, unsigned long & stamp, unsigned long leaf_size,
+                std::vector<unsigned long> & result)
+        {
+            std::vector<unsigned long> order, level_starts;
+            for (unsigned long i(0) ; i < nodes.size() ; ++i)
+            {
+                // every processed component has been deactivated completely
+                if (! active[nodes[i]])
+                    continue;
+
+                const unsigned long root(pseudo_peripheral(graph, nodes[i], active, marks, stamp, order, level_starts));
+                const unsigned long levels(level_starts.size() - 1);
+                if (order.size() <= leaf_size || levels < 3)
+                {
+                    cuthill_mckee(graph, root, active, result);
+                    continue;
+                }
+
+                unsigned long middle(1);
+                while (middle < levels - 2 && level_starts[middle + 1] <= order.size() / 2)
+                    ++middle;
+
+                std::vector<unsigned long> lower(order.begin(), order.begin() + level_starts[middle]);
+                std::vector<unsigned long> separator(order.begin() + level_starts[middle], order.begin() + level_starts[middle + 1]);
+                std::vector<unsigned long> upper(order.begin() + level_starts[middle + 1], order.end());
+                for (unsigned long k(0) ; k < separator.size() ; ++k)
+                    active[separator[k]] = 0;
+
+                nested_dissection(graph, lower, active, marks, stamp, leaf_size, result);
+                nested_dissection(graph, upper, active, marks, stamp, leaf_size, result);
+                result.insert(result.end(), separator.begin(), separator.end());
+            }
+        }
+    }
+
+    /**
+     * \brief Reordering computes index orderings of the unknowns.
+     *
+     * The variants that take a system matrix fill a permutation, where permutation[i] is the original
+     * index of the unknown that is numbered i in the new ordering. Apply it with Permutation.
+     */
     template <typename Tag_, typename OrderType_>
     class Reordering
     {
@@ -45,6 +318,17 @@ namespace honei
             for(unsigned long i(0) ; i < coarse.size() ; ++i)
                 coarse[i] = i;
         }
+
+        /// Keeps the ordering of a, i.e. creates the identity permutation.
+        template <typename MatrixType_>
+        static void value(DenseVector<unsigned long> & permutation, const MatrixType_ & a)
+        {
+            if (permutation.size() != a.rows())
+                throw VectorSizeDoesNotMatch(permutation.size(), a.rows());
+
+            for(unsigned long i(0) ; i < permutation.size() ; ++i)
+                permutation[i] = i;
+        }
     };
 
     template <typename Tag_>
@@ -76,6 +360,122 @@ namespace honei
                 coarse[i] = i;
         }
     };
+
+    /**
+     * Reverse Cuthill-McKee ordering, which reduces the bandwidth and profile of a.
+     *
+     * Every component is started at a pseudo peripheral vertex.
+     */
+    template <typename Tag_>
+    class Reordering<Tag_, methods::RCM>
+    {
+        public:
+
+        template <typename DT_>
+        static void value(DenseVector<unsigned long> & permutation, const SparseMatrix<DT_> & a)
+        {
+            CONTEXT("When computing the reverse Cuthill-McKee ordering:");
+
+            if (permutation.size() != a.rows())
+                throw VectorSizeDoesNotMatch(permutation.size(), a.rows());
+
+            intern::ReorderingGraph graph(a);
+            const unsigned long size(graph.size());
+            std::vector<char> active(size, 1);
+            std::vector<unsigned long> marks(size, 0);
+            unsigned long stamp(0);
+
+            std::vector<unsigned long> starts(size);
+            for (unsigned long i(0) ; i < size ; ++i)
+                starts[i] = i;
+            std::sort(starts.begin(), starts.end(), intern::DegreeLess(graph));
+
+            std::vector<unsigned long> order, level_starts, result;
+            result.reserve(size);
+            for (unsigned long i(0) ; i < size ; ++i)
+            {
+                if (! active[starts[i]])
+                    continue;
+
+                unsigned long root(intern::pseudo_peripheral(graph, starts[i], active, marks, stamp, order, level_starts));
+                intern::cuthill_mckee(graph, root, active, result);
+            }
+
+            for (unsigned long i(0) ; i < size ; ++i)
+                permutation[i] = result[size - 1 - i];
+        }
+
+        template <typename DT_>
+        static void value(DenseVector<unsigned long> & permutation, const SparseMatrixELL<DT_> & a)
+        {
+            SparseMatrix<DT_> temp(a);
+            value(permutation, temp);
+        }
+
+        template <typename DT_>
+        static void value(DenseVector<unsigned long> & permutation, const SparseMatrixCSR<DT_> & a)
+        {
+            SparseMatrix<DT_> temp(a);
+            value(permutation, temp);
+        }
+    };
+
+    /**
+     * Nested dissection ordering, which recursively bisects the matrix graph by level set separators.
+     *
+     * Neighbouring unknowns end up in small contiguous index ranges, which keeps the x-vector accesses
+     * of a product local. Components below reordering::nested_dissection::leaf_size vertices are
+     * ordered by Cuthill-McKee.
+     */
+    template <typename Tag_>
+    class Reordering<Tag_, methods::NESTED_DISSECTION>
+    {
+        public:
+
+        template <typename DT_>
+        static void value(DenseVector<unsigned long> & permutation, const SparseMatrix<DT_> & a)
+        {
+            CONTEXT("When computing the nested dissection ordering:");
+
+            if (permutation.size() != a.rows())
+                throw VectorSizeDoesNotMatch(permutation.size(), a.rows());
+
+            unsigned long leaf_size(Configuration::instance()->get_value("reordering::nested_dissection::leaf_size", 64));
+            if (leaf_size == 0)
+                leaf_size = 1;
+
+            intern::ReorderingGraph graph(a);
+            const unsigned long size(graph.size());
+            std::vector<char> active(size, 1);
+            std::vector<unsigned long> marks(size, 0);
+            unsigned long stamp(0);
+
+            std::vector<unsigned long> nodes(size);
+            for (unsigned long i(0) ; i < size ; ++i)
+                nodes[i] = i;
+
+            std::vector<unsigned long> result;
+            result.reserve(size);
+            intern::nested_dissection(graph, nodes, active, marks, stamp, leaf_size, result);
+
+            for (unsigned long i(0) ; i < size ; ++i)
+                permutation[i] = result[i];
+        }
+
+        template <typename DT_>
+        static void value(DenseVector<unsigned long> & permutation, const SparseMatrixELL<DT_> & a)
+        {
+            SparseMatrix<DT_> temp(a);
+            value(permutation, temp);
+        }
+
+        template <typename DT_>
+        static void value(DenseVector<unsigned long> & permutation, const SparseMatrixCSR<DT_> & a)
+        {
+            SparseMatrix<DT_> temp(a);
+            value(permutation, temp);
+        }
+    };
 }
 
 #endif
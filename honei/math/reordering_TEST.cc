@@ -22,6 +22,7 @@
 #include <iostream>
 #include <cmath>
 #include <honei/math/reordering.hh>
+#include <honei/math/permutation.hh>
 
 using namespace honei;
 using namespace tests;
@@ -91,3 +92,157 @@ class ReorderingTest:
 };
 ReorderingTest<tags::CPU, float> cpu_prolongation_matrix_test_float("float");
 
+
+namespace
+{
+    /// Creates a five point laplacian on a root x root grid, whose unknowns are numbered in a scattered order.
+    template <typename DT_>
+    SparseMatrix<DT_> scattered_laplacian(unsigned long root)
+    {
+        const unsigned long size(root * root);
+        std::vector<unsigned long> number(size);
+        for (unsigned long i(0) ; i < size ; ++i)
+            number[i] = (i * 7919) % size;
+
+        SparseMatrix<DT_> result(size, size);
+        for (unsigned long y(0) ; y < root ; ++y)
+            for (unsigned long x(0) ; x < root ; ++x)
+            {
+                const unsigned long node(number[y * root + x]);
+                result(node, node) = DT_(4);
+                if (x > 0)
+                    result(node, number[y * root + x - 1]) = DT_(-1);
+                if (x < root - 1)
+                    result(node, number[y * root + x + 1]) = DT_(-1);
+                if (y > 0)
+                    result(node, number[(y - 1) * root + x]) = DT_(-1);
+                if (y < root - 1)
+                    result(node, number[(y + 1) * root + x]) = DT_(-1);
+            }
+
+        return result;
+    }
+
+    template <typename DT_>
+    unsigned long bandwidth(const SparseMatrix<DT_> & a)
+    {
+        unsigned long result(0);
+        for (unsigned long row(0) ; row < a.rows() ; ++row)
+            for (unsigned long i(0) ; i < a[row].used_elements() ; ++i)
+            {
+                const unsigned long column(a[row].indices()[i]);
+                const unsigned long distance(column > row ? column - row : row - column);
+                if (distance > result)
+                    result = distance;
+            }
+
+        return result;
+    }
+
+    bool is_permutation(const DenseVector<unsigned long> & permutation)
+    {
+        std::vector<char> seen(permutation.size(), 0);
+        for (unsigned long i(0) ; i < permutation.size() ; ++i)
+        {
+            if (permutation[i] >= permutation.size() || seen[permutation[i]])
+                return false;
+            seen[permutation[i]] = 1;
+        }
+
+        return true;
+    }
+}
+
+template <typename Tag_, typename DT_>
+class RCMReorderingTest:
+    public BaseTest
+{
+    public:
+        RCMReorderingTest(const std::string & tag) :
+            BaseTest("RCM reordering test <" + tag + ">")
+        {
+            register_tag(Tag_::name);
+        }
+
+        virtual void run() const
+        {
+            const unsigned long root(31);
+            SparseMatrix<DT_> a(scattered_laplacian<DT_>(root));
+            DenseVector<unsigned long> permutation(a.rows());
+            Reordering<Tag_, methods::RCM>::value(permutation, a);
+            TEST_CHECK(is_permutation(permutation));
+
+            SparseMatrix<DT_> b(Permutation<Tag_>::value(a, permutation));
+            std::cout << "Bandwidth: " << bandwidth(a) << " -> " << bandwidth(b) << std::endl;
+            TEST_CHECK(bandwidth(b) <= 2 * root);
+            TEST_CHECK_EQUAL(b.used_elements(), a.used_elements());
+
+            SparseMatrixELL<DT_> ell(a);
+            DenseVector<unsigned long> permutation_ell(a.rows());
+            Reordering<Tag_, methods::RCM>::value(permutation_ell, ell);
+            TEST_CHECK_EQUAL(permutation_ell, permutation);
+
+            // two components and an isolated vertex
+            SparseMatrix<DT_> c(7, 7);
+            for (unsigned long i(0) ; i < 7 ; ++i)
+                c(i, i) = DT_(2);
+            c(0, 4) = c(4, 0) = DT_(-1);
+            c(4, 2) = c(2, 4) = DT_(-1);
+            c(1, 5) = c(5, 1) = DT_(-1);
+            DenseVector<unsigned long> permutation_c(7);
+            Reordering<Tag_, methods::RCM>::value(permutation_c, c);
+            TEST_CHECK(is_permutation(permutation_c));
+            TEST_CHECK(bandwidth(Permutation<Tag_>::value(c, permutation_c)) <= 1);
+
+            DenseVector<unsigned long> wrong(6);
+            TEST_CHECK_THROWS((Reordering<Tag_, methods::RCM>::value(wrong, c)), VectorSizeDoesNotMatch);
+        }
+};
+RCMReorderingTest<tags::CPU, float> cpu_rcm_reordering_test_float("float");
+RCMReorderingTest<tags::CPU, double> cpu_rcm_reordering_test_double("double");
+
+template <typename Tag_, typename DT_>
+class NestedDissectionReorderingTest:
+    public BaseTest
+{
+    public:
+        NestedDissectionReorderingTest(const std::string & tag) :
+            BaseTest("Nested dissection reordering test <" + tag + ">")
+        {
+            register_tag(Tag_::name);
+        }
+
+        virtual void run() const
+        {
+            const unsigned long root(40);
+            SparseMatrix<DT_> a(scattered_laplacian<DT_>(root));
+            DenseVector<unsigned long> permutation(a.rows());
+            Reordering<Tag_, methods::NESTED_DISSECTION>::value(permutation, a);
+            TEST_CHECK(is_permutation(permutation));
+
+            // most couplings stay within a leaf of at most leaf_size consecutive unknowns
+            SparseMatrix<DT_> b(Permutation<Tag_>::value(a, permutation));
+            unsigned long near(0), total(0);
+            for (unsigned long row(0) ; row < b.rows() ; ++row)
+                for (unsigned long i(0) ; i < b[row].used_elements() ; ++i)
+                {
+                    const unsigned long column(b[row].indices()[i]);
+                    ++total;
+                    if ((column > row ? column - row : row - column) < 64)
+                        ++near;
+                }
+            std::cout << "Couplings within 64 indices: " << near << " of " << total << std::endl;
+            TEST_CHECK(near > total * 8 / 10);
+
+            SparseMatrixCSR<DT_> csr(a);
+            DenseVector<unsigned long> permutation_csr(a.rows());
+            Reordering<Tag_, methods::NESTED_DISSECTION>::value(permutation_csr, csr);
+            TEST_CHECK_EQUAL(permutation_csr, permutation);
+
+            DenseVector<unsigned long> identity(a.rows());
+            Reordering<Tag_, methods::NATURAL>::value(identity, a);
+            for (unsigned long i(0) ; i < identity.size() ; ++i)
+                TEST_CHECK_EQUAL(identity[i], i);
+        }
+};
+NestedDissectionReorderingTest<tags::CPU, double> cpu_nested_dissection_reordering_test_double("double");
@@ -23,129 +23,376 @@
 
 #include <honei/util/tags.hh>
 #include <honei/la/sparse_matrix.hh>
-#include <honei/la/product.hh>
-#include <honei/la/dot_product.hh>
-#include <honei/la/difference.hh>
-#include <honei/math/transposition.hh>
-#include <honei/la/sparse_matrix_ell.hh>
+#include <honei/util/configuration.hh>
+#include <honei/backends/multicore/operation.hh>
+#include <honei/backends/multicore/thread_pool.hh>
+#include <honei/util/tr1_boost.hh>
 
-#include <iostream>
+#include <cmath>
+#include <limits>
 #include <vector>
+#include <algorithm>
 
 // Based on "Robust Approximate Inverse Preconditioning for the Conjugate Gradients Method" by Benzi et al.
 namespace honei
 {
-    template<typename Tag_> struct SAINV
+    namespace intern
     {
+        /// Sparse working row of SAINV, with ascending indices.
+        template <typename DT_> struct SAINVRow
+        {
+            std::vector<unsigned long> indices;
+            std::vector<DT_> values;
+        };
+
+        /// Shared state of one biconjugation step, z_j -= p_j / p_i * z_i for every candidate j.
+        template <typename DT_> struct SAINVStep
+        {
+            /// All working rows.
+            SAINVRow<DT_> * z;
+
+            /// Pivot row i.
+            const SAINVRow<DT_> * pivot;
+
+            /// p_i = z_i^T A z_i.
+            DT_ p_pivot;
+
+            /// A z_i, scattered into a dense vector.
+            const DT_ * v;
+
+            /// Rows j > i whose pattern overlaps with A z_i.
+            const unsigned long * candidates;
+
+            /// New indices of every candidate row, for the occurrence lists.
+            std::vector<unsigned long> * fill;
+
+            DT_ tolerance;
+        };
+
+        /**
+         * Updates the candidates [begin, end) of a biconjugation step.
+         *
+         * Entries of the updated row that fall below the tolerance are removed from the row, new entries are
+         * only created if they exceed the tolerance. Every row is only written by one candidate, so
+         * disjoint ranges can be processed concurrently.
+         */
         template <typename DT_>
-        static SparseMatrix<DT_> value(const SparseMatrix<DT_> & A, DT_ tolerance = 13e-2)
+        void sainv_update(const SAINVStep<DT_> * step, unsigned long begin, unsigned long end)
         {
-            // z holds the row vector z_i
-            SparseMatrix<DT_> z(A.rows(), A.columns(), A[A.rows() / 2].used_elements());
-            DenseVector<DT_> p(z.rows(), DT_(0));
-            SparseMatrixELL<DT_> Aell(A);
+            const SAINVRow<DT_> & pivot(*step->pivot);
+            const DT_ tolerance(step->tolerance);
+            const DT_ p_pivot(fabs(step->p_pivot) > std::numeric_limits<DT_>::epsilon() ? step->p_pivot : std::numeric_limits<DT_>::epsilon());
+            SAINVRow<DT_> merged;
 
-            for(unsigned long i(0) ; i < z.rows() ; ++i)
+            for (unsigned long c(begin) ; c < end ; ++c)
             {
-                z(i, i, DT_(1));
+                SAINVRow<DT_> & row(step->z[step->candidates[c]]);
+
+                DT_ p(0);
+                for (unsigned long k(0) ; k < row.indices.size() ; ++k)
+                    p += row.values[k] * step->v[row.indices[k]];
+
+                const DT_ alpha(p / p_pivot);
+                if (! (fabs(alpha) > tolerance))
+                    continue;
+
+                merged.indices.clear();
+                merged.values.clear();
+                unsigned long l(0), r(0);
+                while (l < row.indices.size() || r < pivot.indices.size())
+                {
+                    if (r == pivot.indices.size() || (l < row.indices.size() && row.indices[l] < pivot.indices[r]))
+                    {
+                        merged.indices.push_back(row.indices[l]);
+                        merged.values.push_back(row.values[l]);
+                        ++l;
+                    }
+                    else if (l == row.indices.size() || pivot.indices[r] < row.indices[l])
+                    {
+                        const DT_ value(-pivot.values[r] * alpha);
+                        if (fabs(value) > tolerance)
+                        {
+                            merged.indices.push_back(pivot.indices[r]);
+                            merged.values.push_back(value);
+                            step->fill[c].push_back(pivot.indices[r]);
+                        }
+                        ++r;
+                    }
+                    else
+                    {
+                        const DT_ value(row.values[l] - pivot.values[r] * alpha);
+                        if (fabs(value) > tolerance)
+                        {
+                            merged.indices.push_back(row.indices[l]);
+                            merged.values.push_back(value);
+                        }
+                        ++l;
+                        ++r;
+                    }
+                }
+                row.indices.swap(merged.indices);
+                row.values.swap(merged.values);
             }
+        }
+
+        /**
+         * Computes the rows [begin, end) of M = Z D^{-1} Z^T.
+         *
+         * occurrences[r] lists all k with r in the pattern of z_k, weights[r] the matching z_k[r] / p_k.
+         */
+        template <typename DT_>
+        void sainv_assemble(SAINVRow<DT_> * result, const SAINVRow<DT_> * z, const std::vector<unsigned long> * occurrences,
+                const std::vector<DT_> * weights, unsigned long size, unsigned long begin, unsigned long end)
+        {
+            std::vector<DT_> accu(size, DT_(0));
+            std::vector<char> used(size, 0);
+            std::vector<unsigned long> touched;
 
-            DenseVector<DT_> v(Aell.columns());
-            for(unsigned long i(0) ; i < z.rows() ; ++i)
+            for (unsigned long row(begin) ; row < end ; ++row)
             {
-                DenseVector<DT_> zi(((const SparseMatrix<DT_>)z)[i]);
-                Product<Tag_>::value(v, Aell, zi);
-                /*SparseVector<DT_> v2(v.size(), 1);
-                for (unsigned long vi(0) ; vi < v.size() ; ++vi)
-                    if (v[vi] != DT_(0))
-                        v2[vi] = v[vi];*/
-
-                /*for(unsigned long j(i) ; j < z.rows() ; ++j)
+                touched.clear();
+                for (unsigned long o(0) ; o < occurrences[row].size() ; ++o)
                 {
-                    p[j] = DotProduct<tags::CPU>::value(v2, z[j]);
-                }*/
-                const DT_ * vele(v.elements());
-                DT_ * pele(p.elements() + i);
-                for(unsigned long j(i) ; j < z.rows() ; ++j, ++pele)
+                    const SAINVRow<DT_> & zk(z[occurrences[row][o]]);
+                    const DT_ weight(weights[row][o]);
+                    for (unsigned long i(0) ; i < zk.indices.size() ; ++i)
+                    {
+                        const unsigned long column(zk.indices[i]);
+                        if (! used[column])
+                        {
+                            used[column] = 1;
+                            touched.push_back(column);
+                        }
+                        accu[column] += weight * zk.values[i];
+                    }
+                }
+
+                std::sort(touched.begin(), touched.end());
+                for (unsigned long i(0) ; i < touched.size() ; ++i)
                 {
-                    const DT_ * ele(z[j].elements());
-                    const unsigned long * ind(z[j].indices());
-                    *pele = DT_(0);
-                    for (unsigned long k(0) ; k < (z[j]).used_elements() ; ++k)
+                    const unsigned long column(touched[i]);
+                    if (accu[column] != DT_(0))
                     {
-                        *pele += ele[k] * vele[ind[k]];
+                        result[row].indices.push_back(column);
+                        result[row].values.push_back(accu[column]);
                     }
+                    accu[column] = DT_(0);
+                    used[column] = 0;
+                }
+            }
+        }
+
+        /**
+         * Computes the SAINV preconditioner M = Z D^{-1} Z^T of A.
+         *
+         * The biconjugation is right looking: after row z_i is final, every later row that couples with
+         * A z_i is updated. Candidate rows are found through the occurrence lists of the indices of A z_i,
+         * which avoids the dot products with all later rows. Steps with at least min_part_size candidates
+         * and the final assembly are split into max_count parts and run on the thread pool, max_count 1
+         * runs everything in the calling thread.
+         */
+        template <typename DT_>
+        SparseMatrix<DT_> sainv(const SparseMatrix<DT_> & A, DT_ tolerance, unsigned long max_count, unsigned long min_part_size)
+        {
+            const unsigned long size(A.rows());
+            std::vector<SAINVRow<DT_> > z(size);
+            std::vector<std::vector<unsigned long> > occurrences(size);
+            for (unsigned long i(0) ; i < size ; ++i)
+            {
+                z[i].indices.push_back(i);
+                z[i].values.push_back(DT_(1));
+                occurrences[i].push_back(i);
+            }
+
+            // the column vectors of a SparseMatrix are only kept up to date by some of its setters, so the
+            // columns of A that are needed for A z_i are gathered from its rows once
+            std::vector<SAINVRow<DT_> > columns(A.columns());
+            for (unsigned long row(0) ; row < size ; ++row)
+            {
+                const SparseVector<DT_> & a_row(A[row]);
+                for (unsigned long e(0) ; e < a_row.used_elements() ; ++e)
+                {
+                    if (a_row.elements()[e] == DT_(0))
+                        continue;
+                    columns[a_row.indices()[e]].indices.push_back(row);
+                    columns[a_row.indices()[e]].values.push_back(a_row.elements()[e]);
+                }
+            }
 
+            std::vector<DT_> p(size, DT_(0));
+            std::vector<DT_> v(size, DT_(0));
+            std::vector<unsigned long> v_indices;
+            std::vector<unsigned long> v_marks(size, 0);
+            std::vector<unsigned long> candidate_marks(size, 0);
+            std::vector<unsigned long> candidates;
+            std::vector<std::vector<unsigned long> > fill;
+
+            for (unsigned long i(0) ; i < size ; ++i)
+            {
+                // v = A z_i
+                const SAINVRow<DT_> & zi(z[i]);
+                v_indices.clear();
+                for (unsigned long k(0) ; k < zi.indices.size() ; ++k)
+                {
+                    const SAINVRow<DT_> & column(columns[zi.indices[k]]);
+                    for (unsigned long e(0) ; e < column.indices.size() ; ++e)
+                    {
+                        const unsigned long row(column.indices[e]);
+                        if (v_marks[row] != i + 1)
+                        {
+                            v_marks[row] = i + 1;
+                            v_indices.push_back(row);
+                        }
+                        v[row] += column.values[e] * zi.values[k];
+                    }
                 }
 
-                if (i == z.rows() - 1)
-                    break;
+                for (unsigned long k(0) ; k < zi.indices.size() ; ++k)
+                    p[i] += zi.values[k] * v[zi.indices[k]];
 
-                for(unsigned long j(i + 1) ; j < z.rows() ; ++j)
+                // rows j > i with a pattern that overlaps A z_i, processed rows are dropped from the lists
+                candidates.clear();
+                for (unsigned long k(0) ; k < v_indices.size() ; ++k)
                 {
-                    //DT_ alpha = p[j] / p[i];
-                    DT_ alpha = (fabs(p[i]) > std::numeric_limits<DT_>::epsilon()) ? p[j] / p[i] : p[j] / std::numeric_limits<DT_>::epsilon();
-                    if (fabs(alpha) > tolerance)
+                    std::vector<unsigned long> & list(occurrences[v_indices[k]]);
+                    unsigned long kept(0);
+                    for (unsigned long o(0) ; o < list.size() ; ++o)
                     {
-                        //TODO integrate dropping strategy in difference and insert (virtual) zeros if dropping occurs
-                        typename SparseVector<DT_>::NonZeroElementIterator l(z[j].begin_non_zero_elements());
-                        typename SparseVector<DT_>::NonZeroElementIterator r(z[i].begin_non_zero_elements());
-                        typename SparseVector<DT_>::NonZeroElementIterator r_end(z[i].end_non_zero_elements());
-                        for ( ; r != r_end ; )
+                        const unsigned long j(list[o]);
+                        if (j <= i)
+                            continue;
+                        list[kept++] = j;
+                        if (candidate_marks[j] != i + 1)
                         {
-                            if (r.index() < l.index())
-                            {
-                                if(fabs(*r * alpha) > tolerance)
-                                    z[j][r.index()] = -(*r) * alpha;
-                                ++r;
-                            }
-                            else if (l.index() < r.index())
-                            {
-                                ++l;
-                            }
-                            else
-                            {
-                                //TODO BUG!: if dropping occurs: do not insert zero but delete the entry at z[j][x] if any exists
-                                *l = (*l - (*r * alpha)) * DT_(fabs(*l - (*r * alpha)) > tolerance);
-                                ++l; ++r;
-                            }
+                            candidate_marks[j] = i + 1;
+                            candidates.push_back(j);
                         }
                     }
+                    list.resize(kept);
+                }
+
+                if (! candidates.empty())
+                {
+                    fill.assign(candidates.size(), std::vector<unsigned long>());
+                    SAINVStep<DT_> step;
+                    step.z = &z[0];
+                    step.pivot = &zi;
+                    step.p_pivot = p[i];
+                    step.v = &v[0];
+                    step.candidates = &candidates[0];
+                    step.fill = &fill[0];
+                    step.tolerance = tolerance;
+
+                    const unsigned long count(candidates.size());
+                    const unsigned long parts(std::min(max_count, count / std::max(min_part_size, 1ul)));
+                    if (parts > 1)
+                    {
+                        TicketVector tickets;
+                        for (unsigned long part(0) ; part < parts ; ++part)
+                            tickets.push_back(mc::ThreadPool::instance()->enqueue(
+                                        bind(&sainv_update<DT_>, &step, part * count / parts, (part + 1) * count / parts)));
+                        tickets.wait();
+                    }
+                    else
+                        sainv_update<DT_>(&step, 0, count);
+
+                    for (unsigned long c(0) ; c < count ; ++c)
+                        for (unsigned long f(0) ; f < fill[c].size() ; ++f)
+                            occurrences[fill[c][f]].push_back(candidates[c]);
                 }
+
+                for (unsigned long k(0) ; k < v_indices.size() ; ++k)
+                    v[v_indices[k]] = DT_(0);
             }
 
-            // z is the lower triangular matrix(Z^T); z_t is the upper triangular matrix (Z), z_d is the inverted diagonal matrix
+            // M = Z D^{-1} Z^T, where the columns of Z are the final rows z_k
+            std::vector<std::vector<unsigned long> > rows_of(size);
+            std::vector<std::vector<DT_> > weights(size);
+            for (unsigned long k(0) ; k < size ; ++k)
+                for (unsigned long e(0) ; e < z[k].indices.size() ; ++e)
+                {
+                    rows_of[z[k].indices[e]].push_back(k);
+                    weights[z[k].indices[e]].push_back(z[k].values[e] / p[k]);
+                }
 
-            SparseMatrix<DT_> z_t(Transposition<Tag_>::value(z));
-            for(unsigned long i(0) ; i < z_t.rows() ; ++i)
+            std::vector<SAINVRow<DT_> > m(size);
+            const unsigned long parts(std::max(std::min(max_count, size), 1ul));
+            if (parts > 1)
             {
-                z_t(i, i, DT_(1));
+                TicketVector tickets;
+                for (unsigned long part(0) ; part < parts ; ++part)
+                    tickets.push_back(mc::ThreadPool::instance()->enqueue(
+                                bind(&sainv_assemble<DT_>, &m[0], &z[0], &rows_of[0], &weights[0], size,
+                                    part * size / parts, (part + 1) * size / parts)));
+                tickets.wait();
             }
+            else
+                sainv_assemble<DT_>(&m[0], &z[0], &rows_of[0], &weights[0], size, 0, size);
+
+            std::vector<unsigned long> row_indices, column_indices;
+            std::vector<DT_> data;
+            for (unsigned long row(0) ; row < size ; ++row)
+                for (unsigned long e(0) ; e < m[row].indices.size() ; ++e)
+                {
+                    row_indices.push_back(row);
+                    column_indices.push_back(m[row].indices[e]);
+                    data.push_back(m[row].values[e]);
+                }
+
+            if (data.empty())
+                return SparseMatrix<DT_>(A.rows(), A.columns());
 
-            SparseMatrix<DT_> z_d(z.rows(), z.columns());
-            for(unsigned long i(0) ; i < z.rows() ; ++i)
+            return SparseMatrix<DT_>(A.rows(), A.columns(), &row_indices[0], &column_indices[0], &data[0], data.size());
+        }
+    }
+
+    /**
+     * \brief SAINV creates the stabilised approximate inverse of a symmetric positive definite matrix.
+     *
+     * Entries of the working rows below tolerance are dropped.
+     */
+    template<typename Tag_> struct SAINV
+    {
+        template <typename DT_>
+        static SparseMatrix<DT_> value(const SparseMatrix<DT_> & A, DT_ tolerance = 13e-2)
+        {
+            CONTEXT("When calculating SAINV:");
+
+            return intern::sainv(A, tolerance, 1ul, 1ul);
+        }
+    };
+
+    namespace mc
+    {
+        template <typename Tag_> struct SAINV
+        {
+            template <typename DT_>
+            static SparseMatrix<DT_> value(const SparseMatrix<DT_> & A, DT_ tolerance = 13e-2)
             {
-                z_d(i, i, DT_(1)/p[i]);
+                CONTEXT("When calculating SAINV (MultiCore):");
+
+                unsigned long max_count(Configuration::instance()->get_value("mc::SAINV::max_count",
+                            mc::ThreadPool::instance()->num_threads()));
+                unsigned long min_part_size(Configuration::instance()->get_value("mc::SAINV::min_part_size", 128));
+
+                return intern::sainv(A, tolerance, max_count, min_part_size);
             }
+        };
+    }
 
-            // TODO Tag_ nicht hardverdrahten
-            SparseMatrix<DT_> z_temp = Product<tags::CPU>::value(z_d, z);
-            SparseMatrix<DT_> z_r = Product<tags::CPU>::value(z_t, z_temp);
-
-            /* POST FILTERING
-               unsigned long ue(0);
-               for (typename SparseMatrix<DT_>::NonZeroElementIterator r(z_r.begin_non_zero_elements()),
-               r_end(z_r.end_non_zero_elements()) ; r != r_end ; ++r)
-               {
-               if (fabs(*r) < tolerance / 5)
-               {
-               ue++;
-             *r = DT_(0);
-             }
-             }
-             std::cout<<ue<<std::endl;*/
-            return z_r;
-        }
+    template <> struct SAINV<tags::CPU::MultiCore> :
+        public mc::SAINV<tags::CPU::MultiCore>
+    {
+    };
+
+    template <> struct SAINV<tags::CPU::MultiCore::Generic> :
+        public mc::SAINV<tags::CPU::MultiCore::Generic>
+    {
+    };
+
+    template <> struct SAINV<tags::CPU::MultiCore::SSE> :
+        public mc::SAINV<tags::CPU::MultiCore::SSE>
+    {
     };
 }
 #endif
@@ -26,6 +26,7 @@
 #include <honei/la/norm.hh>
 #include <honei/la/difference.hh>
 #include <honei/math/matrix_io.hh>
+#include <honei/util/configuration.hh>
 
 
 using namespace honei;
@@ -81,3 +82,130 @@ SainvTestSparse<tags::CPU, double> sainv_test_sparse_ell_double("double");
 SainvTestSparse<tags::CPU::SSE, float> sse_sainv_test_sparse_ell_float("float");
 SainvTestSparse<tags::CPU::SSE, double> sse_sainv_test_sparse_ell_double("double");
 #endif
+
+namespace
+{
+    /// Creates a five point laplacian on a root x root grid.
+    template <typename DT_>
+    SparseMatrix<DT_> laplacian(unsigned long root)
+    {
+        const unsigned long size(root * root);
+        SparseMatrix<DT_> result(size, size);
+        for (unsigned long y(0) ; y < root ; ++y)
+            for (unsigned long x(0) ; x < root ; ++x)
+            {
+                const unsigned long i(y * root + x);
+                result(i, i) = DT_(4);
+                if (x > 0)
+                    result(i, i - 1) = DT_(-1);
+                if (x < root - 1)
+                    result(i, i + 1) = DT_(-1);
+                if (y > 0)
+                    result(i, i - root) = DT_(-1);
+                if (y < root - 1)
+                    result(i, i + root) = DT_(-1);
+            }
+
+        return result;
+    }
+}
+
+template <typename Tag_, typename DT_>
+class SainvTestLaplacian:
+    public BaseTest
+{
+    public:
+        SainvTestLaplacian(const std::string & tag) :
+            BaseTest("Sainv laplacian test <" + tag + ">")
+        {
+            register_tag(Tag_::name);
+        }
+
+        virtual void run() const
+        {
+            SparseMatrix<DT_> sm(laplacian<DT_>(30));
+            SparseMatrix<DT_> m(SAINV<tags::CPU>::value(sm, DT_(0.05)));
+
+            // a small part size makes every step with candidates run on the thread pool
+            unsigned long old_part_size(Configuration::instance()->get_value("mc::SAINV::min_part_size", 128));
+            unsigned long old_count(Configuration::instance()->get_value("mc::SAINV::max_count", 4));
+            Configuration::instance()->set_value("mc::SAINV::min_part_size", 2);
+            Configuration::instance()->set_value("mc::SAINV::max_count", 3);
+            SparseMatrix<DT_> m_tag(SAINV<Tag_>::value(sm, DT_(0.05)));
+            Configuration::instance()->set_value("mc::SAINV::min_part_size", old_part_size);
+            Configuration::instance()->set_value("mc::SAINV::max_count", old_count);
+            TEST_CHECK_EQUAL(m_tag, m);
+
+            // dropped entries are removed and M is symmetric
+            for (unsigned long i(0) ; i < m.rows() ; ++i)
+                for (unsigned long j(0) ; j < m[i].used_elements() ; ++j)
+                {
+                    TEST_CHECK(m[i].elements()[j] != DT_(0));
+                    TEST_CHECK_EQUAL_WITHIN_EPS(m[i].elements()[j], m(m[i].indices()[j], i), 1e-5);
+                }
+
+            SparseMatrix<DT_> temp(sm.rows(), sm.columns());
+            SparseMatrix<DT_> ident(sm.rows(), sm.columns(), 1);
+            SparseMatrix<DT_> jac(sm.rows(), sm.columns(), 1);
+            for (unsigned long i(0) ; i < ident.rows() ; ++i)
+            {
+                ident(i, i) = 1;
+                jac(i, i) = DT_(1) / sm(i, i);
+            }
+            double min = Norm<vnt_l_one, false, tags::CPU>::value(Difference<tags::CPU>::value(temp, ident, Product<tags::CPU>::value(sm, m)));
+            double jacnorm = Norm<vnt_l_one, false, tags::CPU>::value(Difference<tags::CPU>::value(temp, ident, Product<tags::CPU>::value(sm, jac)));
+            std::cout<<"SAINV Norm: "<<min<<" Jac Norm: "<<jacnorm<<std::endl;
+            TEST_CHECK(jacnorm > min);
+        }
+};
+SainvTestLaplacian<tags::CPU, double> sainv_test_laplacian_double("double");
+SainvTestLaplacian<tags::CPU::MultiCore, float> mc_sainv_test_laplacian_float("float");
+SainvTestLaplacian<tags::CPU::MultiCore, double> mc_sainv_test_laplacian_double("double");
+#ifdef HONEI_SSE
+SainvTestLaplacian<tags::CPU::MultiCore::SSE, double> mcsse_sainv_test_laplacian_double("double");
+#endif
+
+template <typename Tag_, typename DT_>
+class SainvTestAssembly:
+    public BaseTest
+{
+    public:
+        SainvTestAssembly(const std::string & tag) :
+            BaseTest("Sainv assembly test <" + tag + ">")
+        {
+            register_tag(Tag_::name);
+        }
+
+        virtual void run() const
+        {
+            // operator[] leaves the column vectors of the matrix empty, the setter fills them
+            SparseMatrix<DT_> rows(6, 6);
+            SparseMatrix<DT_> full(6, 6);
+            for (unsigned long i(0) ; i < 6 ; ++i)
+            {
+                rows[i][i] = DT_(4);
+                full(i, i, DT_(4));
+                if (i > 0)
+                {
+                    rows[i][i - 1] = DT_(-1);
+                    full(i, i - 1, DT_(-1));
+                }
+                if (i < 5)
+                {
+                    rows[i][i + 1] = DT_(-1);
+                    full(i, i + 1, DT_(-1));
+                }
+            }
+
+            SparseMatrix<DT_> m_rows(SAINV<Tag_>::value(rows, DT_(0.05)));
+            SparseMatrix<DT_> m_full(SAINV<Tag_>::value(full, DT_(0.05)));
+            TEST_CHECK_EQUAL(m_rows, m_full);
+            for (unsigned long i(0) ; i < 6 ; ++i)
+            {
+                TEST_CHECK(m_rows(i, i) > DT_(0.25));
+                TEST_CHECK(m_rows(i, i) < DT_(0.3));
+            }
+        }
+};
+SainvTestAssembly<tags::CPU, double> sainv_test_assembly_double("double");
+SainvTestAssembly<tags::CPU::MultiCore, float> mc_sainv_test_assembly_float("float");
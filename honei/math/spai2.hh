@@ -30,6 +30,10 @@
 #include <honei/backends/multicore/thread_pool.hh>
 #include <honei/la/product.hh>
 #include <honei/math/ludecomposition.hh>
+#include <honei/util/exception.hh>
+#include <honei/util/stringify.hh>
+#include <honei/util/tr1_boost.hh>
+#include <cmath>
 #include <vector>
 #include <algorithm>
 #include <iostream>
@@ -117,174 +121,236 @@ namespace honei
 
             return result;
         }
+
+        /// Computes the columns [col_start, col_end) of the SPAI of A with the pattern of A into M.
+        template <typename DT_>
+        static SparseMatrix<DT_> & value(SparseMatrix<DT_> & M, const SparseMatrix<DT_> & A, unsigned long col_start = 0, unsigned long col_end = 0);
     };
 
-    template <>
-    struct SPAI2<tags::CPU::SSE>
+    namespace intern
     {
+        /**
+         * Computes the columns [col_start, col_end) of the SPAI of A with the pattern of A.
+         *
+         * Column idx of M minimises ||A m_idx - e_idx|| over the pattern J of column idx of A. Only the rows I
+         * that are used by the columns J take part in the least squares problem, which is solved via its
+         * normal equations. The result of column idx is stored in values[offsets[idx] + j], in the order of
+         * the entries of A.column(idx). Disjoint column ranges can be computed concurrently.
+         */
         template <typename DT_>
-        static SparseMatrix<DT_> & value(SparseMatrix<DT_> & M, const SparseMatrix<DT_> & A, unsigned long col_start = 0, unsigned long col_end = 0)
+        void spai2_columns(DT_ * values, const unsigned long * offsets, const SparseMatrix<DT_> * A, unsigned long col_start, unsigned long col_end)
         {
-            if (col_end == 0)
-                col_end = A.columns();
+            std::vector<long> position(A->rows(), -1);
+            std::vector<unsigned long> I;
+            std::vector<DT_> At, normal, rhs;
+
             for (unsigned long idx(col_start) ; idx < col_end ; ++idx)
             {
-                unsigned long n2(A.column(idx).used_elements());
+                const SparseVector<DT_> & column(A->column(idx));
+                const unsigned long n2(column.used_elements());
                 if (n2 == 0)
                     continue;
-                unsigned long J[n2];
-                const unsigned long * A_col_idx_index(A.column(idx).indices());
-                for (unsigned long i(0) ; i < n2 ; ++i)
-                {
-                    J[i] = A_col_idx_index[i];
-                }
+                const unsigned long * J(column.indices());
 
-                unsigned long n1(0);
-                for (unsigned long i(0) ; i < n2 ; ++i)
-                {
-                    n1 += A.column(J[i]).used_elements();
-                }
-                if (n1 == 0)
-                    continue;
-                unsigned long I[n1];
-                DenseVector<DT_> et(n1, DT_(0));
-                DT_ * __restrict__ ete(et.elements());
-                unsigned long tmp(0);
-                for (unsigned long i(0) ; i < n2 ; ++i)
+                I.clear();
+                for (unsigned long j(0) ; j < n2 ; ++j)
                 {
-                    const unsigned long A_col_ji_ue(A.column(J[i]).used_elements());
-                    const unsigned long * A_col_ji_index(A.column(J[i]).indices());
-                    for (unsigned long j(0) ; j < A_col_ji_ue ; ++j)
-                    {
-                        I[tmp] = A_col_ji_index[j];
-                        ete[tmp] = (I[tmp] == idx);
-                        ++tmp;
-                    }
+                    const SparseVector<DT_> & cj(A->column(J[j]));
+                    for (unsigned long e(0) ; e < cj.used_elements() ; ++e)
+                        if (position[cj.indices()[e]] < 0)
+                        {
+                            position[cj.indices()[e]] = I.size();
+                            I.push_back(cj.indices()[e]);
+                        }
                 }
+                const unsigned long n1(I.size());
 
-                DenseMatrix<DT_> At(n1, n2, DT_(0));
-                for (unsigned long i(0) ; i < n1 ; ++i)
-                {
-                    const SparseVector<DT_> row = A[I[i]];
-                    unsigned long it(0);
-                    const unsigned long * indices(row.indices());
-                    const DT_ * __restrict__ elements(row.elements());
-                    const unsigned long used_elements(row.used_elements());
-                    for (unsigned long j(0) ; j < n2 ; ++j)
-                    {
-                        const unsigned long index(J[j]);
-                        for ( ; (indices[it] < index) && (it < used_elements) ; ++it)
-                            ;
-                        if (indices[it] == index)
-                            At(i, j) = elements[it];
-                    }
-                }
-                // GPU ONLY - without row vectors
-                /*DenseMatrix<DT_> At(n1, n2, DT_(0));
+                // At is the row major n1 x n2 submatrix A(I, J)
+                At.assign(n1 * n2, DT_(0));
                 for (unsigned long j(0) ; j < n2 ; ++j)
                 {
-                    const SparseVector<DT_> column = A.column(J[j]);
-                    for (unsigned long i(0) ; i < n1 ; ++i)
-                    {
-                        At(i, j) = column[I[i]];
-                    }
-                }*/
-
-                /*LAPACKE_dgels(LAPACK_ROW_MAJOR, 'N', At.rows(), At.columns(), 1, At.elements(), At.columns(), et.elements(), 1);
-                for (unsigned long i(0) ; i < n2 ; ++i)
-                {
-                    M(A.column(idx).indices()[i], idx, et[i]);
-                }*/
+                    const SparseVector<DT_> & cj(A->column(J[j]));
+                    for (unsigned long e(0) ; e < cj.used_elements() ; ++e)
+                        At[position[cj.indices()[e]] * n2 + j] = cj.elements()[e];
+                }
 
-                DenseMatrix<DT_> Atrans(n2, n1);
-                DT_ * __restrict__ Ate(At.elements());
-                DT_ * __restrict__ Atranse(Atrans.elements());
-                // \TODO schneller transponieren
+                normal.assign(n2 * n2, DT_(0));
+                rhs.assign(n2, DT_(0));
                 for (unsigned long i(0) ; i < n1 ; ++i)
                 {
-                    for (unsigned long j(0) ; j < n2 ; ++j)
-                    {
-                        Atranse[n1 * j + i] = Ate[n2 * i + j];
-                    }
+                    const DT_ * ai(&At[i * n2]);
+                    for (unsigned long a(0) ; a < n2 ; ++a)
+                        for (unsigned long b(a) ; b < n2 ; ++b)
+                            normal[a * n2 + b] += ai[a] * ai[b];
                 }
-                //DenseMatrix<DT_> product = Product<tags::CPU::SSE>::value(Atrans, At);
-                DenseMatrix<DT_> product(n2, n2);
-                DT_ * __restrict__ producte(product.elements());
-                for (unsigned long i(0) ; i < n2 ; ++i)
+                for (unsigned long a(0) ; a < n2 ; ++a)
+                    for (unsigned long b(0) ; b < a ; ++b)
+                        normal[a * n2 + b] = normal[b * n2 + a];
+                if (position[idx] >= 0)
+                    for (unsigned long a(0) ; a < n2 ; ++a)
+                        rhs[a] = At[position[idx] * n2 + a];
+
+                // gaussian elimination with partial pivoting
+                for (unsigned long k(0) ; k < n2 ; ++k)
                 {
-                    for (unsigned long j(0) ; j < n2 ; ++j)
+                    unsigned long pivot(k);
+                    for (unsigned long r(k + 1) ; r < n2 ; ++r)
+                        if (fabs(normal[r * n2 + k]) > fabs(normal[pivot * n2 + k]))
+                            pivot = r;
+                    if (normal[pivot * n2 + k] == DT_(0))
+                        throw InternalError("SPAI2: singular least squares problem in column " + stringify(idx) + "!");
+                    if (pivot != k)
                     {
-                        DT_ temp(0);
-                        for (unsigned long k(0) ; k < n1 ; ++k)
-                        {
-                            temp += Atranse[n1 * i + k] * Ate[n2 * k + j];
-                        }
-                        producte[n2 * i + j] = temp;
+                        for (unsigned long c(k) ; c < n2 ; ++c)
+                            std::swap(normal[k * n2 + c], normal[pivot * n2 + c]);
+                        std::swap(rhs[k], rhs[pivot]);
                     }
-                }
-                //DenseVector<DT_> pro_v = Product<tags::CPU::SSE>::value(Atrans, et);
-                DenseVector<DT_> pro_v(n2);
-                DT_ * __restrict__ pro_ve(pro_v.elements());
-                for (unsigned long i(0) ; i < n2 ; ++i)
-                {
-                    DT_ temp(0);
-                    for (unsigned long j(0) ; j < n1 ; ++j)
+                    for (unsigned long r(k + 1) ; r < n2 ; ++r)
                     {
-                        temp += Atranse[n1 * i + j] * et[j];
+                        const DT_ factor(normal[r * n2 + k] / normal[k * n2 + k]);
+                        for (unsigned long c(k + 1) ; c < n2 ; ++c)
+                            normal[r * n2 + c] -= factor * normal[k * n2 + c];
+                        rhs[r] -= factor * rhs[k];
                     }
-                    pro_ve[i] = temp;
                 }
-                DenseVector<DT_> res(product.columns());
-                LUDecomposition<tags::CPU::SSE>::value(product, pro_v, res);
-                for (unsigned long i(0) ; i < n2 ; ++i)
+                for (unsigned long k(n2) ; k > 0 ; --k)
                 {
-                    M(A.column(idx).indices()[i], idx, res[i]);
-                    //M.column(idx).elements()[i] = res[i];
-                    //M._synch_row_vectors();
+                    DT_ sum(rhs[k - 1]);
+                    for (unsigned long c(k) ; c < n2 ; ++c)
+                        sum -= normal[(k - 1) * n2 + c] * rhs[c];
+                    rhs[k - 1] = sum / normal[(k - 1) * n2 + k - 1];
                 }
+
+                for (unsigned long a(0) ; a < n2 ; ++a)
+                    values[offsets[idx] + a] = rhs[a];
+
+                for (unsigned long i(0) ; i < n1 ; ++i)
+                    position[I[i]] = -1;
+            }
+        }
+
+        /// Returns the start of every column of A in a column wise value array, followed by the total.
+        template <typename DT_>
+        std::vector<unsigned long> spai2_offsets(const SparseMatrix<DT_> & A)
+        {
+            std::vector<unsigned long> offsets(A.columns() + 1, 0);
+            for (unsigned long idx(0) ; idx < A.columns() ; ++idx)
+                offsets[idx + 1] = offsets[idx] + A.column(idx).used_elements();
+
+            return offsets;
+        }
+
+        /// Writes the computed columns [col_start, col_end) into M.
+        template <typename DT_>
+        void spai2_store(SparseMatrix<DT_> & M, const SparseMatrix<DT_> & A, const std::vector<DT_> & values,
+                const std::vector<unsigned long> & offsets, unsigned long col_start, unsigned long col_end)
+        {
+            for (unsigned long idx(col_start) ; idx < col_end ; ++idx)
+            {
+                const unsigned long * J(A.column(idx).indices());
+                for (unsigned long a(0) ; a < offsets[idx + 1] - offsets[idx] ; ++a)
+                    M(J[a], idx, values[offsets[idx] + a]);
             }
+        }
+    }
+
+    template <typename DT_>
+    SparseMatrix<DT_> & SPAI2<tags::CPU>::value(SparseMatrix<DT_> & M, const SparseMatrix<DT_> & A, unsigned long col_start, unsigned long col_end)
+    {
+        CONTEXT("When calculating SPAI2:");
+
+        if (col_end == 0)
+            col_end = A.columns();
 
-            return M;
+        std::vector<unsigned long> offsets(intern::spai2_offsets(A));
+        std::vector<DT_> values(offsets.back() + 1);
+        intern::spai2_columns(&values[0], &offsets[0], &A, col_start, col_end);
+        intern::spai2_store(M, A, values, offsets, col_start, col_end);
+
+        return M;
+    }
+
+    template <>
+    struct SPAI2<tags::CPU::SSE>
+    {
+        template <typename DT_>
+        static SparseMatrix<DT_> & value(SparseMatrix<DT_> & M, const SparseMatrix<DT_> & A, unsigned long col_start = 0, unsigned long col_end = 0)
+        {
+            return SPAI2<tags::CPU>::value(M, A, col_start, col_end);
         }
 
     };
 
     namespace mc
     {
+        /**
+         * Multicore SPAI2, that splits the columns into max_count blocks of about equal estimated cost.
+         *
+         * The cost of a column grows with the size of its least squares problem, so the blocks are cut along
+         * the prefix sum of these estimates instead of the column count. There are several blocks per thread,
+         * all enqueued at once: the thread pool hands the next block to whichever thread is idle, or lets idle
+         * threads steal blocks if mc::work_stealing is set, so misestimated blocks are balanced at run time.
+         * Blocks are computed into a shared value array and written into M afterwards, so no two threads
+         * modify M.
+         */
         template <typename Tag_> struct SPAI2
         {
             template <typename DT_>
             static SparseMatrix<DT_> & value(SparseMatrix<DT_> & M, const SparseMatrix<DT_> & A)
             {
-                //omp_set_num_threads(1);
-                unsigned long max_count(Configuration::instance()->get_value("mc::Product(DV,SMELL,DV)::max_count",
-                            mc::ThreadPool::instance()->num_threads()));
-                max_count = 10;
+                CONTEXT("When calculating SPAI2 (MultiCore):");
 
-                TicketVector tickets;
+                const unsigned long num_threads(mc::ThreadPool::instance()->num_threads());
+                unsigned long max_count(Configuration::instance()->get_value("mc::SPAI2::max_count", 4 * num_threads));
+                // fewer blocks than threads would leave threads without work
+                max_count = std::max(std::min(std::max(max_count, num_threads), A.columns()), 1ul);
+
+                std::vector<unsigned long> offsets(intern::spai2_offsets(A));
+                std::vector<double> cost(A.columns() + 1, 0.);
+                for (unsigned long idx(0) ; idx < A.columns() ; ++idx)
+                {
+                    const SparseVector<DT_> & column(A.column(idx));
+                    const double n2(column.used_elements());
+                    double n1(0.);
+                    for (unsigned long j(0) ; j < column.used_elements() ; ++j)
+                        n1 += A.column(column.indices()[j]).used_elements();
+                    cost[idx + 1] = cost[idx] + n1 * n2 * n2 + n2 * n2 * n2;
+                }
 
-                unsigned long limits[max_count + 1];
-                limits[0] = 0;
-                for (unsigned long i(1) ; i < max_count; ++i)
+                std::vector<unsigned long> limits(max_count + 1, 0);
+                unsigned long idx(0);
+                for (unsigned long i(1) ; i < max_count ; ++i)
                 {
-                    limits[i] = limits[i-1] + A.columns() / max_count;
+                    const double target(cost[A.columns()] * double(i) / double(max_count));
+                    while (idx < A.columns() && cost[idx] < target)
+                        ++idx;
+                    limits[i] = idx;
                 }
                 limits[max_count] = A.columns();
 
+                std::vector<DT_> values(offsets.back() + 1);
+                TicketVector tickets;
                 for (unsigned long i(0) ; i < max_count ; ++i)
                 {
-                    OperationWrapper<honei::SPAI2<typename Tag_::DelegateTo>, SparseMatrix<DT_>,
-                        SparseMatrix<DT_>, SparseMatrix<DT_>, unsigned long, unsigned long > wrapper(M);
-                    tickets.push_back(mc::ThreadPool::instance()->enqueue(bind(wrapper, M, A, limits[i], limits[i+1])));
+                    if (limits[i] == limits[i + 1])
+                        continue;
+                    tickets.push_back(mc::ThreadPool::instance()->enqueue(
+                                bind(&intern::spai2_columns<DT_>, &values[0], &offsets[0], &A, limits[i], limits[i + 1])));
                 }
-
                 tickets.wait();
 
+                intern::spai2_store(M, A, values, offsets, 0, A.columns());
+
                 return M;
             }
         };
     }
 
+    template <> struct SPAI2<tags::CPU::MultiCore> :
+        public mc::SPAI2<tags::CPU::MultiCore>
+    {
+    };
+
     template <> struct SPAI2<tags::CPU::MultiCore::SSE> :
         public mc::SPAI2<tags::CPU::MultiCore::SSE>
     {
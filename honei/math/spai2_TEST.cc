@@ -28,6 +28,8 @@
 #include <honei/math/matrix_io.hh>
 
 #include <honei/util/time_stamp.hh>
+#include <honei/util/configuration.hh>
+#include <limits>
 
 using namespace honei;
 using namespace tests;
@@ -83,8 +85,8 @@ class Spai2TestSparse:
             TEST_CHECK(jacnorm > min);
         }
 };
-//Spai2TestSparse<tags::CPU, float> spai2_test_sparse_ell_float("float");
-//Spai2TestSparse<tags::CPU, double> spai2_test_sparse_ell_double("double");
+Spai2TestSparse<tags::CPU, float> spai2_test_sparse_ell_float("float");
+Spai2TestSparse<tags::CPU, double> spai2_test_sparse_ell_double("double");
 #ifdef HONEI_SSE
 Spai2TestSparse<tags::CPU::SSE, float> sse_spai2_test_sparse_ell_float("float");
 Spai2TestSparse<tags::CPU::SSE, double> sse_spai2_test_sparse_ell_double("double");
@@ -96,3 +98,72 @@ Spai2TestSparse<tags::CPU::MultiCore::SSE, double> mcsse_spai2_test_sparse_ell_d
 Spai2TestSparse<tags::GPU::CUDA, double> cuda_spai2_test_sparse_ell_double("double");
 #endif
 #endif
+
+template <typename Tag_, typename DT_>
+class Spai2TestLaplacian:
+    public BaseTest
+{
+    public:
+        Spai2TestLaplacian(const std::string & tag) :
+            BaseTest("Spai2 laplacian test <" + tag + ">")
+        {
+            register_tag(Tag_::name);
+        }
+
+        virtual void run() const
+        {
+            const unsigned long root(25), size(root * root);
+            SparseMatrix<DT_> sm(size, size);
+            for (unsigned long y(0) ; y < root ; ++y)
+                for (unsigned long x(0) ; x < root ; ++x)
+                {
+                    const unsigned long i(y * root + x);
+                    sm(i, i, DT_(4) + DT_(x % 3));
+                    if (x > 0)
+                        sm(i, i - 1, DT_(-1));
+                    if (x < root - 1)
+                        sm(i, i + 1, DT_(-1));
+                    if (y > 0)
+                        sm(i, i - root, DT_(-1));
+                    if (y < root - 1)
+                        sm(i, i + root, DT_(-1));
+                }
+
+            SparseMatrix<DT_> reference(sm.copy());
+            SPAI2<tags::CPU>::value(reference, sm);
+
+            // many small column blocks of different length
+            unsigned long old_count(Configuration::instance()->get_value("mc::SPAI2::max_count", 16));
+            Configuration::instance()->set_value("mc::SPAI2::max_count", 37);
+            SparseMatrix<DT_> m(sm.copy());
+            SPAI2<Tag_>::value(m, sm);
+            Configuration::instance()->set_value("mc::SPAI2::max_count", old_count);
+            TEST_CHECK_EQUAL(m, reference);
+
+            // the residual of every column is orthogonal to the columns of its pattern
+            for (unsigned long idx(0) ; idx < size ; idx += 17)
+            {
+                DenseVector<DT_> residual(size, DT_(0));
+                residual[idx] = DT_(-1);
+                const SparseVector<DT_> & pattern(sm.column(idx));
+                for (unsigned long j(0) ; j < pattern.used_elements() ; ++j)
+                {
+                    const SparseVector<DT_> & column(sm.column(pattern.indices()[j]));
+                    for (unsigned long e(0) ; e < column.used_elements() ; ++e)
+                        residual[column.indices()[e]] += column.elements()[e] * m(pattern.indices()[j], idx);
+                }
+                for (unsigned long j(0) ; j < pattern.used_elements() ; ++j)
+                {
+                    const SparseVector<DT_> & column(sm.column(pattern.indices()[j]));
+                    DT_ dot(0);
+                    for (unsigned long e(0) ; e < column.used_elements() ; ++e)
+                        dot += column.elements()[e] * residual[column.indices()[e]];
+                    TEST_CHECK_EQUAL_WITHIN_EPS(dot, DT_(0), std::numeric_limits<DT_>::epsilon() * 100);
+                }
+            }
+        }
+};
+Spai2TestLaplacian<tags::CPU::MultiCore, float> mc_spai2_test_laplacian_float("float");
+#ifdef HONEI_SSE
+Spai2TestLaplacian<tags::CPU::MultiCore::SSE, double> mcsse_spai2_test_laplacian_double("double");
+#endif
@@ -25,6 +25,7 @@
 #include <honei/util/stringify.hh>
 #include <honei/math/conjugate_gradients.hh>
 #include <iostream>
+#include <limits>
 
 
 using namespace honei;
@@ -82,6 +83,24 @@ class SuperILUTestSparseELL:
                 TEST_CHECK_EQUAL_WITHIN_EPS(result[i], ref[i], eps);
                 //std::cout<<result[i]<<"  "<<result_result[i]<<std::endl;
             }
+
+            SuperILU solver;
+            unsigned long used_iters(0);
+            for (unsigned long run(0) ; run < 2 ; ++run)
+            {
+                DenseVector<DT1_> result_2(rhs.size(), 4711);
+                solver.value(smatrix, smatrix, rhs, result_2, 1ul, used_iters, DT1_(0));
+                for (unsigned long i(0) ; i < result.size() ; ++i)
+                    TEST_CHECK_EQUAL_WITHIN_EPS(result_2[i], result[i], std::numeric_limits<DT1_>::epsilon() * 1e3);
+            }
+
+            // values of the same matrix changed in place
+            for (unsigned long i(0) ; i < smatrix.Ax().size() ; ++i)
+                smatrix.Ax()[i] *= DT1_(2);
+            DenseVector<DT1_> result_2(rhs.size(), 4711);
+            solver.value(smatrix, smatrix, rhs, result_2, 1ul, used_iters, DT1_(0));
+            for (unsigned long i(0) ; i < result.size() ; ++i)
+                TEST_CHECK_EQUAL_WITHIN_EPS(result_2[i], result[i] / DT1_(2), std::numeric_limits<DT1_>::epsilon() * 1e3);
         }
 };
 SuperILUTestSparseELL<tags::CPU, double> superlu_test_sparse_ell_double_2("double", "poisson_advanced/q2_sort_0/A_3.ell", "poisson_advanced/q2_sort_0/rhs_3", "poisson_advanced/q2_sort_0/sol_3");
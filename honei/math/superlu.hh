@@ -25,175 +25,480 @@
 #include <honei/la/algorithm.hh>
 #include <honei/la/sparse_matrix.hh>
 #include <honei/math/matrix_io.hh>
+#include <honei/la/matrix_error.hh>
+#include <honei/la/vector_error.hh>
+#include <honei/util/exception.hh>
+#include <honei/util/instantiation_policy.hh>
+#include <honei/util/stringify.hh>
+#include <honei/util/tr1_boost.hh>
 #include "honei/math/SuperLU_4.1/SRC/slu_ddefs.h"
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <cstdio>
 
 
 namespace honei
 {
-    struct SuperLU
+    /**
+     * \brief Sparse LU factorization of a SparseMatrixELL, kept for repeated solves.
+     *
+     * The column ordering, the row permutation, the equilibration and the factors L and U
+     * are computed once by the constructor. solve() runs the triangular solves (and the
+     * iterative refinement) only. refactor() takes new values for the same sparsity
+     * pattern and recomputes the factors, reusing the column ordering and elimination tree.
+     *
+     * With incomplete set, the threshold based ILU of SuperLU is computed instead.
+     */
+    class SuperLUFactorization :
+        public InstantiationPolicy<SuperLUFactorization, NonCopyable>
     {
-        template <typename DT_>
-        static void value(const SparseMatrixELL<DT_> & in_matrix, const DenseVector<DT_> & in_rhs, DenseVector<DT_> & out_result)
-        {
-            char     equed[1];
-            SuperMatrix A, L, U, B, X;
-            double   *a, *rhs, *rhsx, *ta;
-            int      *asub, *xa, *tasub, *txa;
-            int      *perm_r; /* row permutations from partial pivoting */
-            int      *perm_c; /* column permutation vector */
-            int      lwork, nrhs, info, i, m, n, nnz;//, permc_spec;
-            int      *etree;
-            void     *work(NULL);
-            double   rpg, rcond;
-            double   *R, *C;
-            double   *ferr, *berr;
-            mem_usage_t    mem_usage;
-            superlu_options_t options;
-            SuperLUStat_t stat;
-
-            /* Initialize matrix A. */
-            m = in_matrix.rows();
-            n = in_matrix.columns();
-            nnz = in_matrix.used_elements();
-            if ( !(a = doubleMalloc(nnz)) ) ABORT("Malloc fails for a[].");
-            if ( !(asub = intMalloc(nnz)) ) ABORT("Malloc fails for asub[].");
-            if ( !(xa = intMalloc(n+1)) ) ABORT("Malloc fails for xa[].");
-            if ( !(ta = doubleMalloc(nnz)) ) ABORT("Malloc fails for ta[].");
-            if ( !(tasub = intMalloc(nnz)) ) ABORT("Malloc fails for tasub[].");
-            if ( !(txa = intMalloc(m+1)) ) ABORT("Malloc fails for txa[].");
-
-            unsigned long ti(0);
-            /*for (unsigned long ii(0) ; ii < in_matrix.rows() ; ++ii)
-            {
-                xa[ii] = ti;
-                for (unsigned long ij(0) ; ij < in_matrix.columns() ; ++ij)
+        private:
+            bool _incomplete;
+            int _m, _n;
+            SuperMatrix _A, _L, _U;
+            int * _perm_r; /* row permutations from partial pivoting */
+            int * _perm_c; /* column permutation vector */
+            int * _etree;
+            double * _R, * _C;
+            int * _perm_mc64; /* MC64 row permutation of the incomplete factorization */
+            double * _R_mc64, * _C_mc64;
+            char _equed[1];
+            superlu_options_t _options;
+
+            /// Converts the ELL matrix to the compressed column arrays owned by SuperLU.
+            template <typename DT_>
+            static int _compcol(const SparseMatrixELL<DT_> & in_matrix, double ** ta, int ** tasub, int ** txa)
+            {
+                double *a;
+                int *asub, *xa;
+                int m(in_matrix.rows()), n(in_matrix.columns()), nnz(in_matrix.used_elements());
+
+                if ( !(a = doubleMalloc(nnz)) ) ABORT("Malloc fails for a[].");
+                if ( !(asub = intMalloc(nnz)) ) ABORT("Malloc fails for asub[].");
+                if ( !(xa = intMalloc(n+1)) ) ABORT("Malloc fails for xa[].");
+
+                unsigned long ti(0);
+                for (unsigned long srow(0) ; srow < in_matrix.rows() ; ++srow)
                 {
-                    if (in_matrix(ii, ij) != DT_(0))
+                    xa[srow] = ti;
+                    for (unsigned long ii(srow) ; ii < in_matrix.Ax().size() && ii/in_matrix.stride() < in_matrix.Arl()[srow] ; ii+=in_matrix.stride())
                     {
-                        a[ti] = in_matrix(ii, ij);
-                        asub[ti] = ij;
+                        a[ti] = in_matrix.Ax()[ii];
+                        asub[ti] = in_matrix.Aj()[ii];
                         ++ti;
                     }
                 }
-            }*/
-            for (unsigned long srow(0) ; srow < in_matrix.rows() ; ++srow)
+                xa[n] = nnz;
+
+                dCompRow_to_CompCol(m, n, nnz, a, asub, xa, ta, tasub, txa);
+
+                SUPERLU_FREE (a);
+                SUPERLU_FREE (asub);
+                SUPERLU_FREE (xa);
+
+                return nnz;
+            }
+
+            /// Runs SuperLU with the current options on nrhs right hand sides in rhs, storing the solutions in sol.
+            int _run(double * rhs, double * sol, int nrhs)
+            {
+                SuperMatrix B, X;
+                void *work(NULL);
+                int lwork(0), info(0);
+                double rpg, rcond;
+                double ferr[1], berr[1];
+                mem_usage_t mem_usage;
+                SuperLUStat_t stat;
+
+                dCreate_Dense_Matrix(&B, _m, nrhs, rhs, _m, SLU_DN, SLU_D, SLU_GE);
+                dCreate_Dense_Matrix(&X, _m, nrhs, sol, _m, SLU_DN, SLU_D, SLU_GE);
+
+                /* Initialize the statistics variables. */
+                StatInit(&stat);
+
+                if (_incomplete)
+                    dgsisx(&_options, &_A, _perm_c, _perm_r, _etree, _equed, _R, _C, &_L, &_U, work,
+                            lwork, &B, &X, &rpg, &rcond, &mem_usage, &stat, &info);
+                else
+                    dgssvx(&_options, &_A, _perm_c, _perm_r, _etree, _equed, _R, _C,
+                            &_L, &_U, work, lwork, &B, &X, &rpg, &rcond, ferr, berr,
+                            &mem_usage, &stat, &info);
+
+                Destroy_SuperMatrix_Store(&B);
+                Destroy_SuperMatrix_Store(&X);
+                StatFree(&stat);
+
+                return info;
+            }
+
+            /// Computes L and U for the values currently stored in A.
+            void _factor()
+            {
+                double dummy(0);
+                int info(_run(&dummy, &dummy, 0));
+
+                if (! _incomplete && info > 0 && info <= _n)
+                    throw InternalError("SuperLU: U(" + stringify(info - 1) + ", " + stringify(info - 1) + ") is exactly zero, matrix is singular");
+            }
+
+            /**
+             * Permutes large entries onto the diagonal of A and scales it (MC64), as dgsisx does
+             * with RowPerm = LargeDiag. dgsisx frees this permutation after its own solve, so it
+             * is applied here and kept for the FACTORED solves. Falls back to equilibration.
+             */
+            void _permute_large_diagonal()
+            {
+                NCformat * store((NCformat *) _A.Store);
+                int * colptr(store->colptr), * rowind(store->rowind);
+                double * nzval((double *) store->nzval);
+
+                if (dldperm(5, _n, store->nnz, colptr, rowind, nzval, _perm_mc64, _R_mc64, _C_mc64) > 0)
+                {
+                    SUPERLU_FREE (_perm_mc64);
+                    SUPERLU_FREE (_R_mc64);
+                    SUPERLU_FREE (_C_mc64);
+                    _perm_mc64 = NULL;
+                    _R_mc64 = _C_mc64 = NULL;
+                    _options.Equil = YES;
+                    return;
+                }
+
+                for (int i(0) ; i < _n ; ++i)
+                {
+                    _R_mc64[i] = exp(_R_mc64[i]);
+                    _C_mc64[i] = exp(_C_mc64[i]);
+                }
+                for (int j(0) ; j < _n ; ++j)
+                {
+                    for (int i(colptr[j]) ; i < colptr[j + 1] ; ++i)
+                    {
+                        nzval[i] *= _R_mc64[rowind[i]] * _C_mc64[j];
+                        rowind[i] = _perm_mc64[rowind[i]];
+                    }
+                }
+                _options.Equil = NO;
+            }
+
+            /// Allocates the MC64 arrays and applies them, for incomplete factorizations only.
+            void _prepare()
+            {
+                if (! _incomplete)
+                    return;
+
+                if (_perm_mc64 == NULL)
+                {
+                    if ( !(_perm_mc64 = intMalloc(_n)) ) ABORT("Malloc fails for perm_mc64[].");
+                    if ( !(_R_mc64 = doubleMalloc(_n)) ) ABORT("Malloc fails for R_mc64[].");
+                    if ( !(_C_mc64 = doubleMalloc(_n)) ) ABORT("Malloc fails for C_mc64[].");
+                }
+                _permute_large_diagonal();
+            }
+
+        public:
+            /// Constructor: computes orderings and the complete (or incomplete) factorization of a.
+            template <typename DT_>
+            explicit SuperLUFactorization(const SparseMatrixELL<DT_> & a, bool incomplete = false) :
+                _incomplete(incomplete),
+                _m(a.rows()),
+                _n(a.columns()),
+                _perm_mc64(NULL),
+                _R_mc64(NULL),
+                _C_mc64(NULL)
+            {
+                CONTEXT("When factorising SparseMatrixELL with SuperLU:");
+
+                double *ta;
+                int *tasub, *txa;
+                int nnz(_compcol(a, &ta, &tasub, &txa));
+
+                /* Create matrix A in the format expected by SuperLU. */
+                dCreate_CompRow_Matrix(&_A, _m, _n, nnz, ta, tasub, txa, SLU_NC, SLU_D, SLU_GE);
+
+                if ( !(_etree = intMalloc(_n)) ) ABORT("Malloc fails for etree[].");
+                if ( !(_perm_r = intMalloc(_m)) ) ABORT("Malloc fails for perm_r[].");
+                if ( !(_perm_c = intMalloc(_n)) ) ABORT("Malloc fails for perm_c[].");
+                if ( !(_R = (double *) SUPERLU_MALLOC(_A.nrow * sizeof(double))) )
+                    ABORT("SUPERLU_MALLOC fails for R[].");
+                if ( !(_C = (double *) SUPERLU_MALLOC(_A.ncol * sizeof(double))) )
+                    ABORT("SUPERLU_MALLOC fails for C[].");
+
+                if (_incomplete)
+                {
+                    /* Set the default input options. */
+                    ilu_set_default_options(&_options);
+                    /* Modify the defaults. */
+                    /* MC64 is done by _prepare(). */
+                    _options.RowPerm = NOROWPERM;
+                    _options.PivotGrowth = YES;    /* Compute reciprocal pivot growth */
+                    _options.ConditionNumber = YES;/* Compute reciprocal condition number */
+                }
+                else
+                {
+                    /* Set the default input options. */
+                    set_default_options(&_options);
+                    /* Defaults */
+                    _options.Equil = YES;
+                    _options.DiagPivotThresh = 1.0;
+                    _options.Trans = NOTRANS;
+                    _options.ColPerm = NATURAL;
+                    _options.PrintStat = NO;
+                    /* Add more functionalities that the defaults. */
+                    _options.PivotGrowth = YES;    /* Compute reciprocal pivot growth */
+                    _options.ConditionNumber = YES;/* Compute reciprocal condition number */
+                    _options.IterRefine = DOUBLE;  /* Perform double-precision refinement */
+                }
+
+                _options.Fact = DOFACT;
+                _prepare();
+                _factor();
+            }
+
+            /// Destructor.
+            ~SuperLUFactorization()
+            {
+                SUPERLU_FREE (_perm_r);
+                SUPERLU_FREE (_perm_c);
+                SUPERLU_FREE (_R);
+                SUPERLU_FREE (_C);
+                SUPERLU_FREE (_etree);
+                if (_perm_mc64 != NULL)
+                {
+                    SUPERLU_FREE (_perm_mc64);
+                    SUPERLU_FREE (_R_mc64);
+                    SUPERLU_FREE (_C_mc64);
+                }
+                Destroy_CompCol_Matrix(&_A);
+                Destroy_SuperNode_Matrix(&_L);
+                Destroy_CompCol_Matrix(&_U);
+            }
+
+            /**
+             * Replaces the values of the factorised matrix by those of a and recomputes the
+             * numeric factorization only. a has to have the same sparsity pattern.
+             */
+            template <typename DT_>
+            void refactor(const SparseMatrixELL<DT_> & a)
             {
-                xa[srow] = ti;
-                for (unsigned long ii(srow) ; ii < in_matrix.Ax().size() && ii/in_matrix.stride() < in_matrix.Arl()[srow] ; ii+=in_matrix.stride())
+                CONTEXT("When refactorising SparseMatrixELL with SuperLU:");
+
+                if (a.rows() != (unsigned long)_m)
+                    throw MatrixRowsDoNotMatch(a.rows(), _m);
+                if (a.columns() != (unsigned long)_n)
+                    throw MatrixColumnsDoNotMatch(a.columns(), _n);
+
+                double *ta;
+                int *tasub, *txa;
+                int nnz(_compcol(a, &ta, &tasub, &txa));
+
+                NCformat * store((NCformat *) _A.Store);
+                bool same(nnz == store->nnz);
+                for (int i(0) ; same && i <= _n ; ++i)
+                    same = txa[i] == store->colptr[i];
+                for (int i(0) ; same && i < nnz ; ++i)
+                    same = (_perm_mc64 == NULL ? tasub[i] : _perm_mc64[tasub[i]]) == store->rowind[i];
+
+                if (same)
                 {
-                    a[ti] = in_matrix.Ax()[ii];
-                    asub[ti] = in_matrix.Aj()[ii];
-                    ++ti;
+                    std::copy(ta, ta + nnz, (double *) store->nzval);
+                    std::copy(tasub, tasub + nnz, store->rowind);
                 }
+
+                SUPERLU_FREE (ta);
+                SUPERLU_FREE (tasub);
+                SUPERLU_FREE (txa);
+
+                if (! same)
+                    throw InternalError("SuperLU: refactor needs a matrix with the same sparsity pattern");
+
+                Destroy_SuperNode_Matrix(&_L);
+                Destroy_CompCol_Matrix(&_U);
+
+                /* SamePattern_SameRowPerm would reuse the storage of L and U through the
+                   static state of dgstrf, which is shared by all factorizations. The incomplete
+                   factorization starts over, as the MC64 permutation changes the pattern. */
+                _options.Fact = _incomplete ? DOFACT : SamePattern;
+                _prepare();
+                _factor();
+            }
+
+            /// Solves A x = rhs with the stored factorization.
+            template <typename DT_>
+            void solve(const DenseVector<DT_> & in_rhs, DenseVector<DT_> & out_result)
+            {
+                CONTEXT("When solving with SuperLU factorization:");
+
+                if (in_rhs.size() != (unsigned long)_m)
+                    throw VectorSizeDoesNotMatch(in_rhs.size(), _m);
+                if (out_result.size() != (unsigned long)_n)
+                    throw VectorSizeDoesNotMatch(out_result.size(), _n);
+
+                double *rhs, *sol;
+                if ( !(rhs = doubleMalloc(_m)) ) ABORT("Malloc fails for rhs[].");
+                if ( !(sol = doubleMalloc(_m)) ) ABORT("Malloc fails for rhsx[].");
+                if (_perm_mc64 == NULL)
+                    for (int i(0) ; i < _m ; ++i) rhs[i] = in_rhs[i];
+                else
+                    for (int i(0) ; i < _m ; ++i) rhs[_perm_mc64[i]] = _R_mc64[i] * in_rhs[i];
+
+                _options.Fact = FACTORED;
+                _run(rhs, sol, 1);
+
+                if (_perm_mc64 == NULL)
+                    for (int i(0) ; i < _m ; ++i) out_result[i] = sol[i];
+                else
+                    for (int i(0) ; i < _m ; ++i) out_result[i] = _C_mc64[i] * sol[i];
+
+                SUPERLU_FREE (rhs);
+                SUPERLU_FREE (sol);
+            }
+
+            /// Returns the number of rows of the factorised matrix.
+            unsigned long rows() const
+            {
+                return _m;
+            }
+    };
+
+    /**
+     * \brief Factorization of the matrix last passed to a SuperLU based solver interface.
+     *
+     * A copy of the factorised matrix is kept alongside the factorization. get() compares the
+     * given matrix against it, so neither values changed in place nor a temporary conversion
+     * that happens to reuse freed storage get solved with a stale factorization. New values on
+     * the same sparsity pattern only trigger a numeric refactor().
+     */
+    class SuperLUCache
+    {
+        private:
+            /// Whether incomplete factorizations are computed.
+            bool _incomplete;
+
+            /// The current factorization.
+            shared_ptr<SuperLUFactorization> _factorization;
+
+            /// Copy of the factorised matrix.
+            unsigned long _rows, _columns;
+            shared_ptr<DenseVector<unsigned long> > _Aj, _Arl;
+            shared_ptr<DenseVector<double> > _Ax;
+
+            template <typename DT_>
+            bool _same_pattern(const SparseMatrixELL<DT_> & a) const
+            {
+                if (a.rows() != _rows || a.columns() != _columns || a.Aj().size() != _Aj->size()
+                        || a.Arl().size() != _Arl->size())
+                    return false;
+
+                for (unsigned long i(0) ; i < _Arl->size() ; ++i)
+                    if (a.Arl()[i] != (*_Arl)[i])
+                        return false;
+                for (unsigned long i(0) ; i < _Aj->size() ; ++i)
+                    if (a.Aj()[i] != (*_Aj)[i])
+                        return false;
+
+                return true;
             }
 
+            template <typename DT_>
+            bool _same_values(const SparseMatrixELL<DT_> & a) const
+            {
+                for (unsigned long i(0) ; i < _Ax->size() ; ++i)
+                    if (double(a.Ax()[i]) != (*_Ax)[i])
+                        return false;
+
+                return true;
+            }
+
+            template <typename DT_>
+            void _keep(const SparseMatrixELL<DT_> & a)
+            {
+                _rows = a.rows();
+                _columns = a.columns();
+                _Aj.reset(new DenseVector<unsigned long>(a.Aj().copy()));
+                _Arl.reset(new DenseVector<unsigned long>(a.Arl().copy()));
+                _Ax.reset(new DenseVector<double>(a.Ax().size()));
+                for (unsigned long i(0) ; i < _Ax->size() ; ++i)
+                    (*_Ax)[i] = a.Ax()[i];
+            }
 
-            xa[n] = nnz;
-
-            dCompRow_to_CompCol(m, n, nnz, a, asub, xa, &ta, &tasub, &txa);
-
-            /* Create matrix A in the format expected by SuperLU. */
-            dCreate_CompRow_Matrix(&A, m, n, nnz, ta, tasub, txa, SLU_NC, SLU_D, SLU_GE);
-
-            /* Create right-hand side matrix B. */
-            nrhs = 1;
-            if ( !(rhs = doubleMalloc(m * nrhs)) ) ABORT("Malloc fails for rhs[].");
-            for (i = 0; i < m; ++i) rhs[i] = in_rhs[i];
-            dCreate_Dense_Matrix(&B, m, nrhs, rhs, m, SLU_DN, SLU_D, SLU_GE);
-            if ( !(rhsx = doubleMalloc(m * nrhs)) ) ABORT("Malloc fails for rhsx[].");
-            dCreate_Dense_Matrix(&X, m, nrhs, rhsx, m, SLU_DN, SLU_D, SLU_GE);
-
-            if ( !(etree = intMalloc(n)) ) ABORT("Malloc fails for etree[].");
-            if ( !(perm_r = intMalloc(m)) ) ABORT("Malloc fails for perm_r[].");
-            if ( !(perm_c = intMalloc(n)) ) ABORT("Malloc fails for perm_c[].");
-            if ( !(R = (double *) SUPERLU_MALLOC(A.nrow * sizeof(double))) )
-                ABORT("SUPERLU_MALLOC fails for R[].");
-            if ( !(C = (double *) SUPERLU_MALLOC(A.ncol * sizeof(double))) )
-                ABORT("SUPERLU_MALLOC fails for C[].");
-            if ( !(ferr = (double *) SUPERLU_MALLOC(nrhs * sizeof(double))) )
-                ABORT("SUPERLU_MALLOC fails for ferr[].");
-            if ( !(berr = (double *) SUPERLU_MALLOC(nrhs * sizeof(double))) )
-                ABORT("SUPERLU_MALLOC fails for berr[].");
-
-            /* Set the default input options. */
-            set_default_options(&options);
-            /* Defaults */
-            lwork = 0;
-            options.Equil = YES;
-            options.DiagPivotThresh = 1.0;
-            options.Trans = NOTRANS;
-            options.ColPerm = NATURAL;
-            options.PrintStat = NO;
-            /* Add more functionalities that the defaults. */
-            options.PivotGrowth = YES;    /* Compute reciprocal pivot growth */
-            options.ConditionNumber = YES;/* Compute reciprocal condition number */
-            options.IterRefine = DOUBLE;  /* Perform double-precision refinement */
-            if ( lwork > 0 ) {
-                work = SUPERLU_MALLOC(lwork);
-                if ( !work ) {
-                    ABORT("DLINSOLX: cannot allocate work[]");
+        public:
+            explicit SuperLUCache(bool incomplete = false) :
+                _incomplete(incomplete),
+                _rows(0),
+                _columns(0)
+            {
+            }
+
+            /// Returns the factorization of a, (re)computing it if a is not the matrix factorised last.
+            template <typename DT_>
+            SuperLUFactorization & get(const SparseMatrixELL<DT_> & a)
+            {
+                if (! _factorization || ! _same_pattern(a))
+                {
+                    _factorization.reset(new SuperLUFactorization(a, _incomplete));
+                    _keep(a);
                 }
+                else if (! _same_values(a))
+                {
+                    _factorization->refactor(a);
+                    _keep(a);
+                }
+
+                return *_factorization;
             }
 
-            /* Initialize the statistics variables. */
-            StatInit(&stat);
-
-            /* Solve the linear system. */
-            //dgssv(&options, &A, perm_c, perm_r, &L, &U, &B, &stat, &info);
-            dgssvx(&options, &A, perm_c, perm_r, etree, equed, R, C,
-                    &L, &U, work, lwork, &B, &X, &rpg, &rcond, ferr, berr,
-                    &mem_usage, &stat, &info);
-
-
-            double *sol = (double*) ((DNformat*) X.Store)->nzval;
-            for (i = 0; i < m; ++i) out_result[i] = sol[i];
-
-            //dPrint_CompCol_Matrix("A", &A);
-            //dPrint_CompCol_Matrix("U", &U);
-            //dPrint_SuperNode_Matrix("L", &L);
-            //print_int_vec("\nperm_r", m, perm_r);
-
-            /* De-allocate storage */
-            SUPERLU_FREE (rhs);
-            SUPERLU_FREE (perm_r);
-            SUPERLU_FREE (perm_c);
-            SUPERLU_FREE (R);
-            SUPERLU_FREE (C);
-            SUPERLU_FREE (ferr);
-            SUPERLU_FREE (berr);
-            SUPERLU_FREE (etree);
-            SUPERLU_FREE (a);
-            SUPERLU_FREE (asub);
-            SUPERLU_FREE (xa);
-            Destroy_CompCol_Matrix(&A);
-            Destroy_SuperMatrix_Store(&B);
-            if ( lwork == 0 ) {
-                Destroy_SuperNode_Matrix(&L);
-                Destroy_CompCol_Matrix(&U);
-            } else if ( lwork > 0 ) {
-                SUPERLU_FREE(work);
-            }
-            Destroy_SuperMatrix_Store(&X);
-            StatFree(&stat);
-        }
-
-        template<typename DT_, typename MatrixType_, typename VectorType_, typename PreconContType_>
-        static inline VectorType_ & value(MatrixType_ & A,
-                    PreconContType_ & /*P*/,
-                    VectorType_ & b,
-                    VectorType_ & x,
-                    unsigned long /*max_iters*/,
-                    unsigned long & used_iters,
-                    DT_ /*eps_relative*/)
-        {
-            SparseMatrixELL<DT_> in_matrix(A);
-            SuperLU::value(in_matrix, b, x);
-            used_iters = 1;
-            return x;
-        }
+            /// Drops the factorization, the next get() factorises from scratch.
+            void reset()
+            {
+                _factorization.reset();
+                _Aj.reset();
+                _Arl.reset();
+                _Ax.reset();
+            }
+    };
+
+    struct SuperLU
+    {
+        private:
+            /// Factorization reused by the solver interface.
+            SuperLUCache _cache;
+
+        public:
+            /// Factorises in_matrix and solves for one right hand side.
+            template <typename DT_>
+            static void value(const SparseMatrixELL<DT_> & in_matrix, const DenseVector<DT_> & in_rhs, DenseVector<DT_> & out_result)
+            {
+                SuperLUFactorization factorization(in_matrix);
+                factorization.solve(in_rhs, out_result);
+            }
+
+            /**
+             * Solver interface, e.g. for the coarse grid of MGSolver.
+             *
+             * The factorization is kept in this solver object and reused as long as A keeps its
+             * values, so repeated solves only cost the triangular solves.
+             */
+            template<typename DT_, typename MatrixType_, typename VectorType_, typename PreconContType_>
+            inline VectorType_ & value(MatrixType_ & A,
+                        PreconContType_ & /*P*/,
+                        VectorType_ & b,
+                        VectorType_ & x,
+                        unsigned long /*max_iters*/,
+                        unsigned long & used_iters,
+                        DT_ /*eps_relative*/)
+            {
+                SparseMatrixELL<DT_> in_matrix(A);
+                _cache.get(in_matrix).solve(b, x);
+                used_iters = 1;
+                return x;
+            }
+
+            /// Drops the kept factorization.
+            void reset()
+            {
+                _cache.reset();
+            }
     };
 }
 #endif
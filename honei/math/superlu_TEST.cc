@@ -25,6 +25,7 @@
 #include <honei/util/stringify.hh>
 #include <honei/math/conjugate_gradients.hh>
 #include <iostream>
+#include <limits>
 
 
 using namespace honei;
@@ -96,3 +97,101 @@ class SuperLUTestSparseELL:
 
 SuperLUTestSparseELL<tags::CPU, double> superlu_test_sparse_ell_double_1("double", "l2/area51_full_0.ell", "l2/area51_rhs_0", "l2/area51_sol_0");
 SuperLUTestSparseELL<tags::CPU, double> superlu_test_sparse_ell_double_2("double", "poisson_advanced/q2_sort_0/A_4.ell", "poisson_advanced/q2_sort_0/rhs_4", "poisson_advanced/q2_sort_0/sol_4");
+
+template <typename Tag_, typename DT1_>
+class SuperLUFactorizationTest:
+    public BaseTest
+{
+    private:
+        std::string _m_f, _v_f;
+    public:
+        SuperLUFactorizationTest(const std::string & tag,
+                std::string m_file,
+                std::string v_file) :
+            BaseTest("Super LU Factorization Test (sparse ELL system)<" + tag + ">")
+        {
+            register_tag(Tag_::name);
+            _m_f = m_file;
+            _v_f = v_file;
+        }
+
+        virtual void run() const
+        {
+            std::string filename(HONEI_SOURCEDIR);
+            filename += "/honei/math/testdata/";
+            filename += _m_f;
+            SparseMatrixELL<DT1_> smatrix(MatrixIO<io_formats::ELL>::read_matrix(filename, DT1_(0)));
+
+            std::string filename_2(HONEI_SOURCEDIR);
+            filename_2 += "/honei/math/testdata/";
+            filename_2 += _v_f;
+            DenseVector<DT1_> rhs(VectorIO<io_formats::EXP>::read_vector(filename_2, DT1_(0)));
+            DenseVector<DT1_> rhs_2(rhs.size());
+            for (unsigned long i(0) ; i < rhs.size() ; ++i)
+                rhs_2[i] = rhs[i] * DT1_(i % 3 + 1);
+
+            DenseVector<DT1_> ref(rhs.size(), 4711);
+            DenseVector<DT1_> ref_2(rhs.size(), 4711);
+            SuperLU::value(smatrix, rhs, ref);
+            SuperLU::value(smatrix, rhs_2, ref_2);
+
+            // solve only
+            SuperLUFactorization factorization(smatrix);
+            TEST_CHECK_EQUAL(factorization.rows(), smatrix.rows());
+            DenseVector<DT1_> result(rhs.size(), 4711);
+            factorization.solve(rhs, result);
+            for (unsigned long i(0) ; i < result.size() ; ++i)
+                TEST_CHECK_EQUAL_WITHIN_EPS(result[i], ref[i], std::numeric_limits<DT1_>::epsilon() * 1e3);
+            factorization.solve(rhs_2, result);
+            for (unsigned long i(0) ; i < result.size() ; ++i)
+                TEST_CHECK_EQUAL_WITHIN_EPS(result[i], ref_2[i], std::numeric_limits<DT1_>::epsilon() * 1e3);
+
+            // numeric refactor with the same pattern
+            SparseMatrixELL<DT1_> scaled(smatrix.copy());
+            for (unsigned long i(0) ; i < scaled.Ax().size() ; ++i)
+                scaled.Ax()[i] *= DT1_(2);
+            factorization.refactor(scaled);
+            factorization.solve(rhs, result);
+            for (unsigned long i(0) ; i < result.size() ; ++i)
+                TEST_CHECK_EQUAL_WITHIN_EPS(result[i], ref[i] / DT1_(2), std::numeric_limits<DT1_>::epsilon() * 1e3);
+
+            SparseMatrix<DT1_> other_pattern(smatrix.rows(), smatrix.columns());
+            for (unsigned long i(0) ; i < smatrix.rows() ; ++i)
+                other_pattern(i, i, DT1_(1));
+            SparseMatrixELL<DT1_> other(other_pattern);
+            TEST_CHECK_THROWS(factorization.refactor(other), InternalError);
+
+            // solver interface keeps its factorization
+            SuperLU solver;
+            unsigned long used_iters(0);
+            DenseVector<DT1_> result_2(rhs.size(), 4711);
+            solver.value(smatrix, smatrix, rhs, result, 1ul, used_iters, DT1_(0));
+            solver.value(smatrix, smatrix, rhs_2, result_2, 1ul, used_iters, DT1_(0));
+            TEST_CHECK_EQUAL(used_iters, 1ul);
+            for (unsigned long i(0) ; i < result.size() ; ++i)
+            {
+                TEST_CHECK_EQUAL_WITHIN_EPS(result[i], ref[i], std::numeric_limits<DT1_>::epsilon() * 1e3);
+                TEST_CHECK_EQUAL_WITHIN_EPS(result_2[i], ref_2[i], std::numeric_limits<DT1_>::epsilon() * 1e3);
+            }
+
+            // values of the same matrix changed in place
+            for (unsigned long i(0) ; i < smatrix.Ax().size() ; ++i)
+                smatrix.Ax()[i] *= DT1_(2);
+            solver.value(smatrix, smatrix, rhs, result, 1ul, used_iters, DT1_(0));
+            for (unsigned long i(0) ; i < result.size() ; ++i)
+                TEST_CHECK_EQUAL_WITHIN_EPS(result[i], ref[i] / DT1_(2), std::numeric_limits<DT1_>::epsilon() * 1e3);
+
+            // a converted matrix is a new temporary in every call
+            SparseMatrix<DT1_> converted(smatrix);
+            solver.value(converted, converted, rhs, result, 1ul, used_iters, DT1_(0));
+            for (unsigned long i(0) ; i < result.size() ; ++i)
+                TEST_CHECK_EQUAL_WITHIN_EPS(result[i], ref[i] / DT1_(2), std::numeric_limits<DT1_>::epsilon() * 1e3);
+            for (typename SparseMatrix<DT1_>::NonZeroElementIterator i(converted.begin_non_zero_elements()), i_end(converted.end_non_zero_elements()) ;
+                    i != i_end ; ++i)
+                *i *= DT1_(2);
+            solver.value(converted, converted, rhs, result, 1ul, used_iters, DT1_(0));
+            for (unsigned long i(0) ; i < result.size() ; ++i)
+                TEST_CHECK_EQUAL_WITHIN_EPS(result[i], ref[i] / DT1_(4), std::numeric_limits<DT1_>::epsilon() * 1e3);
+        }
+};
+SuperLUFactorizationTest<tags::CPU, double> superlu_factorization_test_double("double", "poisson_advanced/q2_sort_0/A_4.ell", "poisson_advanced/q2_sort_0/rhs_4");
@@ -14,6 +14,7 @@ add(`matrix_io_mpi',                 `hh', `test')
 add(`mg',                            `test')
 add(`operations',                    `hh', `cc', `test')
 add(`ri',                            `test')
+add(`solver_lbm3',                   `test')
 add(`sparse_matrix_csr_mpi',         `hh', `fwd', `test')
 add(`sparse_matrix_ell_mpi',         `hh', `fwd', `test')
 add(`vector_io_mpi',                 `hh', `test')
@@ -0,0 +1,85 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2011 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the HONEI C++ library. HONEI is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * HONEI is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <honei/backends/mpi/operations.hh>
+#include <honei/lbm/grid.hh>
+#include <honei/lbm/scenario_collection.hh>
+#include <honei/woolb3/grid3.hh>
+#include <honei/woolb3/packed_grid3.hh>
+#include <honei/woolb3/solver_lbm3.hh>
+#include <honei/woolb3/solver_lbm3_mpi.hh>
+#include <honei/util/unittest.hh>
+
+#include <string>
+#include <iostream>
+
+
+using namespace honei;
+using namespace tests;
+using namespace lbm::lbm_lattice_types;
+
+
+template <typename Tag_, typename DataType_>
+class SolverLBM3MPITest :
+    public BaseTest
+{
+    public:
+        SolverLBM3MPITest(const std::string & type) :
+            BaseTest("solver_lbm3_mpi_test<" + type + ">")
+        {
+            register_tag(Tag_::name);
+        }
+
+        virtual void run() const
+        {
+            unsigned long g_h(128);
+            unsigned long g_w(128);
+            unsigned long timesteps(100);
+
+            Grid<D2Q9, DataType_> grid;
+            ScenarioCollection::get_scenario(4, g_h, g_w, grid);
+            DenseMatrix<DataType_> h_p(grid.h->rows(), grid.h->columns(), 0);
+            DenseMatrix<DataType_> h_s(grid.h->rows(), grid.h->columns(), 0);
+
+            // serial reference solver on every rank
+            Grid3<DataType_, 9> grid_s(*grid.obstacles, *grid.h, *grid.b, *grid.u, *grid.v);
+            PackedGrid3<DataType_, 9> pgrid_s(grid_s);
+            SolverLBM3<Tag_, DataType_, 9, lbm::lbm_source_schemes::BED_FULL> solver_s(grid_s, pgrid_s, grid.d_x, grid.d_y, grid.d_t, grid.tau);
+            solver_s.do_preprocessing();
+            for (unsigned long i(0) ; i < timesteps ; ++i)
+                solver_s.solve();
+            grid_s.fill_h(h_s, *pgrid_s.h);
+
+            SolverLBM3MPI<Tag_, DataType_, 9, lbm::lbm_source_schemes::BED_FULL> solver_p(*grid.obstacles, *grid.h, *grid.b, *grid.u, *grid.v, grid.d_x, grid.d_y, grid.d_t, grid.tau);
+            solver_p.do_preprocessing();
+            for (unsigned long i(0) ; i < timesteps ; ++i)
+                solver_p.solve();
+
+            // every cell is owned by exactly one rank
+            DenseMatrix<DataType_> h_local(grid.h->rows(), grid.h->columns(), 0);
+            solver_p.grid().fill_h(h_local, *solver_p.pgrid().h);
+            MPI_Allreduce(h_local.elements(), h_p.elements(), h_p.size(), mpi::MPIType<DataType_>::value(), MPI_SUM, MPI_COMM_WORLD);
+
+            TEST_CHECK_EQUAL(h_p, h_s);
+
+            grid.destroy();
+        }
+};
+SolverLBM3MPITest<tags::CPU, float> solver_lbm3_mpi_test_float("float");
+SolverLBM3MPITest<tags::CPU, double> solver_lbm3_mpi_test_double("double");
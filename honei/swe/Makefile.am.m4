@@ -109,6 +109,17 @@ libhoneiswe_includedir = $(includedir)/honei/swe
 libhoneiswe_include_HEADERS = headerlist
 
 TESTS = testlist
+if HDF5
+  TESTS += scenario_checkpoint_TEST
+  scenario_checkpoint_TEST_SOURCES = scenario_checkpoint_TEST.cc
+  scenario_checkpoint_TEST_LDADD = \
+		  $(top_builddir)/honei/util/libhoneiutil.la \
+		  $(BACKEND_LIBS) \
+		  $(top_builddir)/honei/la/libhoneila.la \
+		  libhoneiswe.la \
+	$(DYNAMIC_LD_LIBS)
+  scenario_checkpoint_TEST_CXXFLAGS = -I$(top_srcdir) $(AM_CXXFLAGS)
+endif
 TESTS_ENVIRONMENT = env BACKENDS="$(BACKENDS)" TYPE=$(TYPE) bash $(top_srcdir)/honei/util/run.sh
 
 check_PROGRAMS = $(TESTS)
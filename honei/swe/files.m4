@@ -17,6 +17,7 @@ add(`implicit_solver',                `hh', `test')
 add(`limiter',                        `hh', `test')
 add(`post_processing',                `hh', `test')
 add(`scenario',                       `hh',)
+add(`scenario_checkpoint',            `hh',)
 add(`scenario_manager',               `hh', `test')
 add(`solver',                         `hh', `test')
 add(`source_processing',              `hh', `test', `sse')
@@ -753,6 +753,18 @@ using namespace precision_modes;
                 this->_manning_n_squared = scenario.manning_n * scenario.manning_n;
             }
 
+            /// Return the number of time steps computed so far.
+            ulint solve_time() const
+            {
+                return _solve_time;
+            }
+
+            /// Set the time step counter, e.g. on restart from a checkpoint (see ScenarioCheckpoint).
+            void set_solve_time(ulint solve_time)
+            {
+                _solve_time = solve_time;
+            }
+
             /** Encapsulates computation in one timestep. In the driver-application, one
              * can simply write a loop in which solve is called at first and then the
              * renderable matrices are read out.
@@ -1606,6 +1618,18 @@ using namespace precision_modes;
                 this->_manning_n_squared = scenario.manning_n * scenario.manning_n;
             }
 
+            /// Return the number of time steps computed so far.
+            ulint solve_time() const
+            {
+                return _solve_time;
+            }
+
+            /// Set the time step counter, e.g. on restart from a checkpoint (see ScenarioCheckpoint).
+            void set_solve_time(ulint solve_time)
+            {
+                _solve_time = solve_time;
+            }
+
             /** Encapsulates computation in one timestep. In the driver-application, one
              * can simply write a loop in which solve is called at first and then the
              * renderable matrices are read out.
@@ -0,0 +1,128 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the SWE C++ library. LibSWE is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LibSWE is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#pragma once
+#ifndef LIBSWE_GUARD_SCENARIO_CHECKPOINT_HH
+#define LIBSWE_GUARD_SCENARIO_CHECKPOINT_HH 1
+
+#include <honei/la/dense_matrix.hh>
+#include <honei/la/dense_vector.hh>
+#include <honei/la/banded_matrix.hh>
+#include <honei/swe/scenario.hh>
+#include <honei/util/hdf5_checkpoint.hh>
+
+#include <string>
+
+namespace honei
+{
+    template<typename ResPrec_, typename SWESolver_, typename BoundaryType_>
+        struct ScenarioCheckpoint
+        {
+        };
+
+    /**
+     * \brief Checkpoint and restart of RelaxSolver runs.
+     *
+     * save copies the time dependent part of a scenario, i.e. the relaxation vectors u, v and w and
+     * the height and velocity fields, together with the solver's time step counter into a
+     * checkpoint buffer, usually one acquired from an HDF5CheckpointWriter. Bottom, bottom slopes
+     * and the relaxation parameters do not change during a run and are not saved.
+     *
+     * To restart, set up the scenario and solver as for a new run, including do_preprocessing,
+     * then call load and pass the returned time step counter to the solver's set_solve_time.
+     */
+    template<typename ResPrec_>
+        struct ScenarioCheckpoint<ResPrec_, swe_solvers::RELAX, boundaries::REFLECT>
+        {
+            private:
+                static void _save(HDF5Checkpoint & checkpoint, const std::string & name, DenseVector<ResPrec_> & vector)
+                {
+                    vector.lock(lm_read_only);
+                    checkpoint.add(name, vector.elements(), vector.size());
+                    vector.unlock(lm_read_only);
+                }
+
+                static void _save(HDF5Checkpoint & checkpoint, const std::string & name, DenseMatrix<ResPrec_> & matrix)
+                {
+                    matrix.lock(lm_read_only);
+                    checkpoint.add(name, matrix.elements(), matrix.size());
+                    matrix.unlock(lm_read_only);
+                }
+
+                static void _load(HDF5File & file, const std::string & name, DenseVector<ResPrec_> & vector)
+                {
+                    vector.lock(lm_write_only);
+                    HDF5Checkpoint::read(file, name, vector.elements(), vector.size());
+                    vector.unlock(lm_write_only);
+                }
+
+                static void _load(HDF5File & file, const std::string & name, DenseMatrix<ResPrec_> & matrix)
+                {
+                    matrix.lock(lm_write_only);
+                    HDF5Checkpoint::read(file, name, matrix.elements(), matrix.size());
+                    matrix.unlock(lm_write_only);
+                }
+
+            public:
+                /**
+                 * Copy the state of a scenario into a checkpoint.
+                 *
+                 * \param checkpoint The checkpoint to be filled.
+                 * \param scenario Our scenario.
+                 * \param solve_time The solver's time step counter.
+                 */
+                static void save(HDF5Checkpoint & checkpoint, Scenario<ResPrec_, swe_solvers::RELAX, boundaries::REFLECT> & scenario,
+                        unsigned long solve_time)
+                {
+                    CONTEXT("When saving relax scenario checkpoint:");
+
+                    checkpoint.add("solve_time", solve_time);
+                    _save(checkpoint, "u", *scenario.u);
+                    _save(checkpoint, "v", *scenario.v);
+                    _save(checkpoint, "w", *scenario.w);
+                    _save(checkpoint, "height", *scenario.height);
+                    _save(checkpoint, "x_veloc", *scenario.x_veloc);
+                    _save(checkpoint, "y_veloc", *scenario.y_veloc);
+                }
+
+                /**
+                 * Restore the state of a scenario from a checkpoint file.
+                 *
+                 * \param file The checkpoint file.
+                 * \param scenario Our scenario, set up with the dimensions of the saved one.
+                 *
+                 * \return The solver's time step counter at the time of the checkpoint.
+                 */
+                static unsigned long load(HDF5File & file, Scenario<ResPrec_, swe_solvers::RELAX, boundaries::REFLECT> & scenario)
+                {
+                    CONTEXT("When loading relax scenario checkpoint:");
+
+                    _load(file, "u", *scenario.u);
+                    _load(file, "v", *scenario.v);
+                    _load(file, "w", *scenario.w);
+                    _load(file, "height", *scenario.height);
+                    _load(file, "x_veloc", *scenario.x_veloc);
+                    _load(file, "y_veloc", *scenario.y_veloc);
+
+                    return HDF5Checkpoint::read<unsigned long>(file, "solve_time");
+                }
+        };
+}
+
+#endif
@@ -0,0 +1,159 @@
+/* vim: set number sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the SWE C++ library. LibSWE is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LibSWE is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <honei/swe/scenario_checkpoint.hh>
+#include <honei/swe/relax_solver.hh>
+#include <honei/la/dense_vector.hh>
+#include <honei/la/dense_matrix.hh>
+#include <honei/util/unittest.hh>
+#include <cstdio>
+#include <string>
+
+using namespace honei;
+using namespace tests;
+using namespace std;
+using namespace swe_solvers;
+using namespace precision_modes;
+
+namespace
+{
+    /// The data of a small dam break scenario, as in relax_solver_TEST.
+    template <typename DataType_> struct DamBreak
+    {
+        DenseMatrix<DataType_> height, bottom, x_veloc, y_veloc;
+        DenseVector<DataType_> u, v, w, bx, by, c, d;
+        Scenario<DataType_, swe_solvers::RELAX, boundaries::REFLECT> scenario;
+
+        DamBreak(ulint dwidth, ulint dheight) :
+            height(dheight, dwidth, DataType_(5)),
+            bottom(dheight, dwidth, DataType_(1)),
+            x_veloc(dheight, dwidth, DataType_(0)),
+            y_veloc(dheight, dwidth, DataType_(0)),
+            u(3 * ((dwidth * dheight) + 4 * (dwidth + dheight + 4)), DataType_(1)),
+            v(u.size(), DataType_(1)),
+            w(u.size(), DataType_(1)),
+            bx(u.size() / 3, DataType_(0)),
+            by(u.size() / 3, DataType_(0)),
+            c(3, DataType_(5)),
+            d(3, DataType_(5)),
+            scenario(dwidth, dheight)
+        {
+            for (ulint i(0) ; i < height.rows() ; ++i)
+                for (ulint j(height.columns() - 10) ; j < height.columns() ; ++j)
+                    height[i][j] = DataType_(10);
+
+            c[0] = 10;
+            c[1] = 6;
+            c[2] = 11;
+            d[0] = 10;
+            d[1] = 5;
+            d[2] = 11;
+
+            scenario.height = &height;
+            scenario.bottom = &bottom;
+            scenario.x_veloc = &x_veloc;
+            scenario.y_veloc = &y_veloc;
+            scenario.u = &u;
+            scenario.v = &v;
+            scenario.w = &w;
+            scenario.bottom_slopes_x = &bx;
+            scenario.bottom_slopes_y = &by;
+            scenario.c = &c;
+            scenario.d = &d;
+            scenario.delta_x = DataType_(5);
+            scenario.delta_y = DataType_(5);
+            scenario.delta_t = DataType_(5. / 24.);
+            scenario.eps = 10e-6;
+            scenario.manning_n = DataType_(0);
+        }
+    };
+}
+
+template <typename Tag_, typename DataType_>
+class ScenarioCheckpointTest :
+    public TaggedTest<Tag_>
+{
+    public:
+        ScenarioCheckpointTest(const std::string & type) :
+            TaggedTest<Tag_>("scenario_checkpoint_test<" + type + ">")
+        {
+        }
+
+        virtual void run() const
+        {
+            typedef RelaxSolver<Tag_, DataType_, DataType_, DataType_, DataType_, DataType_, source_types::SIMPLE, boundaries::REFLECT, FIXED> Solver;
+
+            std::string filename("scenario_checkpoint_TEST.h5");
+            ulint dwidth(40);
+            ulint dheight(40);
+            ulint timesteps(25);
+
+            DamBreak<DataType_> original(dwidth, dheight);
+            Solver solver(original.scenario);
+            solver.do_preprocessing();
+            for (ulint i(0) ; i < timesteps ; ++i)
+                solver.solve();
+
+            {
+                HDF5CheckpointWriter writer;
+                ScenarioCheckpoint<DataType_, RELAX, boundaries::REFLECT>::save(writer.acquire(), original.scenario, solver.solve_time());
+                writer.commit(filename);
+
+                // the solver continues while the checkpoint is written
+                for (ulint i(0) ; i < timesteps ; ++i)
+                    solver.solve();
+
+                writer.wait();
+            }
+
+            DamBreak<DataType_> restart(dwidth, dheight);
+            Solver solver_restart(restart.scenario);
+            solver_restart.do_preprocessing();
+            {
+                HDF5File file(filename);
+                solver_restart.set_solve_time(ScenarioCheckpoint<DataType_, RELAX, boundaries::REFLECT>::load(file, restart.scenario));
+            }
+            TEST_CHECK_EQUAL(solver_restart.solve_time(), timesteps);
+
+            for (ulint i(0) ; i < timesteps ; ++i)
+                solver_restart.solve();
+            TEST_CHECK_EQUAL(solver_restart.solve_time(), solver.solve_time());
+
+            for (ulint i(0) ; i < dheight ; ++i)
+            {
+                for (ulint j(0) ; j < dwidth ; ++j)
+                {
+                    TEST_CHECK_EQUAL(restart.height[i][j], original.height[i][j]);
+                    TEST_CHECK_EQUAL(restart.x_veloc[i][j], original.x_veloc[i][j]);
+                    TEST_CHECK_EQUAL(restart.y_veloc[i][j], original.y_veloc[i][j]);
+                }
+            }
+
+            // a checkpoint of a differently sized scenario must be rejected
+            DamBreak<DataType_> other(dwidth / 2, dheight);
+            {
+                HDF5File file(filename);
+                TEST_CHECK_THROWS((ScenarioCheckpoint<DataType_, RELAX, boundaries::REFLECT>::load(file, other.scenario)), InternalError);
+            }
+
+            std::remove(filename.c_str());
+        }
+};
+ScenarioCheckpointTest<tags::CPU, float> scenario_checkpoint_test_float("float");
+ScenarioCheckpointTest<tags::CPU, double> scenario_checkpoint_test_double("double");
@@ -18,6 +18,7 @@ add(`general', `configuration',                  `hh', `cc', `test')
 add(`general', `exception',                      `hh', `cc')
 add(`general', `file_to_string',                 `hh')
 add(`hdf5',    `hdf5',                           `hh', `cc', `test')
+add(`hdf5',    `hdf5_checkpoint',                `hh', `cc', `test')
 add(`general', `instantiation_policy',           `hh', `impl')
 add(`hdf5',    `kpnetcdffile',                   `hh', `cc', `test')
 add(`hdf5',    `kpnetcdf_types',                 `hh')
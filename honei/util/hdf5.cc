@@ -377,4 +377,15 @@ namespace honei
     {
         return _imp->id;
     }
+
+    unsigned long
+    HDF5DataSetBase::size() const
+    {
+        hssize_t result(H5Sget_simple_extent_npoints(_imp->data_space->id()));
+
+        if (0 > result)
+            throw HDF5Error("H5Sget_simple_extent_npoints", result);
+
+        return result;
+    }
 }
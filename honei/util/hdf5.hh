@@ -111,6 +111,24 @@ namespace honei
         static inline hid_t memory_type_id() { return H5T_NATIVE_FLOAT; }
     };
 
+    template <> struct HDF5Type<double>
+    {
+        static inline hid_t storage_type_id() { return H5T_IEEE_F64BE; }
+        static inline hid_t memory_type_id() { return H5T_NATIVE_DOUBLE; }
+    };
+
+    template <> struct HDF5Type<unsigned long>
+    {
+        static inline hid_t storage_type_id() { return H5T_STD_U64BE; }
+        static inline hid_t memory_type_id() { return H5T_NATIVE_ULONG; }
+    };
+
+    template <> struct HDF5Type<unsigned char>
+    {
+        static inline hid_t storage_type_id() { return H5T_STD_U8BE; }
+        static inline hid_t memory_type_id() { return H5T_NATIVE_UCHAR; }
+    };
+
     /// \}
 
     /**
@@ -365,6 +383,9 @@ namespace honei
 
             /// Return our HDF5 object id.
             hid_t id() const;
+
+            /// Return the number of elements in our data space.
+            unsigned long size() const;
     };
 
     /**
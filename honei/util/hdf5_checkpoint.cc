@@ -0,0 +1,283 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the Utility C++ library. LibUtil is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LibUtil is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <honei/util/hdf5_checkpoint.hh>
+#include <honei/util/condition_variable.hh>
+#include <honei/util/instantiation_policy-impl.hh>
+#include <honei/util/lock.hh>
+#include <honei/util/mutex.hh>
+#include <honei/util/private_implementation_pattern-impl.hh>
+#include <honei/util/thread.hh>
+#include <honei/util/tr1_boost.hh>
+
+#include <cstdio>
+#include <deque>
+
+namespace honei
+{
+    HDF5Checkpoint::HDF5Checkpoint()
+    {
+    }
+
+    HDF5Checkpoint::~HDF5Checkpoint()
+    {
+        for (std::vector<EntryBase *>::iterator e(_entries.begin()), e_end(_entries.end()) ; e != e_end ; ++e)
+            delete *e;
+    }
+
+    void
+    HDF5Checkpoint::add(const std::string & name, const bool * values, unsigned long size)
+    {
+        std::vector<unsigned char> & target(_values<unsigned char>(name));
+        target.resize(size);
+        for (unsigned long i(0) ; i < size ; ++i)
+            target[i] = values[i] ? 1 : 0;
+    }
+
+    unsigned long
+    HDF5Checkpoint::size() const
+    {
+        return _entries.size();
+    }
+
+    void
+    HDF5Checkpoint::write(const std::string & filename) const
+    {
+        CONTEXT("When writing HDF5 checkpoint '" + filename + "':");
+
+        const std::string temporary(filename + ".tmp");
+
+        {
+            HDF5File file(HDF5File::create(temporary, hdf5am_truncate));
+
+            for (std::vector<EntryBase *>::const_iterator e(_entries.begin()), e_end(_entries.end()) ; e != e_end ; ++e)
+                (*e)->write(file);
+        }
+
+        if (0 != std::rename(temporary.c_str(), filename.c_str()))
+            throw InternalError("HDF5Checkpoint: Cannot rename '" + temporary + "' to '" + filename + "'!");
+    }
+
+    bool
+    HDF5Checkpoint::contains(HDF5File & file, const std::string & name)
+    {
+        htri_t result(H5Lexists(file.id(), name.c_str(), H5P_DEFAULT));
+
+        if (0 > result)
+            throw HDF5Error("H5Lexists", result);
+
+        return result > 0;
+    }
+
+    unsigned long
+    HDF5Checkpoint::size(HDF5File & file, const std::string & name)
+    {
+        return HDF5DataSet<unsigned char>(file, name).size();
+    }
+
+    void
+    HDF5Checkpoint::read(HDF5File & file, const std::string & name, bool * values, unsigned long size)
+    {
+        std::vector<unsigned char> flags(size);
+        read(file, name, flags.empty() ? static_cast<unsigned char *>(0) : &flags[0], size);
+
+        for (unsigned long i(0) ; i < size ; ++i)
+            values[i] = (flags[i] != 0);
+    }
+
+    template <> struct Implementation<HDF5CheckpointWriter>
+    {
+        /// Our double buffer.
+        HDF5Checkpoint buffers[2];
+
+        /// Whether a buffer is filled, queued or being written.
+        bool busy[2];
+
+        /// Our queue of committed buffers and their file names.
+        std::deque<std::pair<unsigned, std::string> > queue;
+
+        /// The buffer returned by the last call to acquire.
+        unsigned current;
+
+        /// Our number of written checkpoints.
+        unsigned long written;
+
+        /// The last error of the background thread.
+        std::string error;
+
+        /// Whether the background thread shall finish.
+        bool finish;
+
+        /// Our mutex.
+        Mutex * const mutex;
+
+        /// Our condition variable, signalling both new work and finished writes.
+        ConditionVariable * const changed;
+
+        /// Our background thread.
+        Thread * thread;
+
+        /// Write out the committed checkpoints.
+        void write_function()
+        {
+            while (true)
+            {
+                std::pair<unsigned, std::string> job;
+
+                {
+                    Lock l(*mutex);
+
+                    if (queue.empty())
+                    {
+                        if (finish)
+                            break;
+
+                        changed->wait(*mutex);
+                        continue;
+                    }
+
+                    job = queue.front();
+                }
+
+                std::string message;
+                try
+                {
+                    buffers[job.first].write(job.second);
+                }
+                catch (Exception & e)
+                {
+                    message = e.message();
+                }
+                catch (...)
+                {
+                    message = "Unknown error while writing '" + job.second + "'";
+                }
+
+                {
+                    Lock l(*mutex);
+
+                    queue.pop_front();
+                    busy[job.first] = false;
+                    if (message.empty())
+                        ++written;
+                    else
+                        error = message;
+
+                    changed->broadcast();
+                }
+            }
+        }
+
+        /// Throw the last error of the background thread, if any. Needs to be called with mutex locked.
+        void check()
+        {
+            if (error.empty())
+                return;
+
+            std::string message(error);
+            error.clear();
+            throw InternalError("HDF5CheckpointWriter: " + message);
+        }
+
+        Implementation() :
+            current(2),
+            written(0),
+            finish(false),
+            mutex(new Mutex),
+            changed(new ConditionVariable)
+        {
+            busy[0] = busy[1] = false;
+            thread = new Thread(bind(mem_fn(&Implementation<HDF5CheckpointWriter>::write_function), this));
+        }
+
+        ~Implementation()
+        {
+            {
+                Lock l(*mutex);
+
+                finish = true;
+                changed->broadcast();
+            }
+
+            delete thread;
+            delete changed;
+            delete mutex;
+        }
+    };
+
+    HDF5CheckpointWriter::HDF5CheckpointWriter() :
+        PrivateImplementationPattern<HDF5CheckpointWriter, Single>(new Implementation<HDF5CheckpointWriter>)
+    {
+    }
+
+    HDF5CheckpointWriter::~HDF5CheckpointWriter()
+    {
+    }
+
+    HDF5Checkpoint &
+    HDF5CheckpointWriter::acquire()
+    {
+        Lock l(*_imp->mutex);
+
+        if (_imp->current < 2)
+            throw InternalError("HDF5CheckpointWriter: The previously acquired buffer has not been committed!");
+
+        while (_imp->busy[0] && _imp->busy[1])
+            _imp->changed->wait(*_imp->mutex);
+
+        _imp->check();
+
+        _imp->current = _imp->busy[0] ? 1 : 0;
+        _imp->busy[_imp->current] = true;
+
+        return _imp->buffers[_imp->current];
+    }
+
+    void
+    HDF5CheckpointWriter::commit(const std::string & filename)
+    {
+        Lock l(*_imp->mutex);
+
+        if (_imp->current > 1)
+            throw InternalError("HDF5CheckpointWriter: No buffer has been acquired!");
+
+        _imp->queue.push_back(std::make_pair(_imp->current, filename));
+        _imp->current = 2;
+        _imp->changed->broadcast();
+    }
+
+    void
+    HDF5CheckpointWriter::wait()
+    {
+        Lock l(*_imp->mutex);
+
+        while (! _imp->queue.empty())
+            _imp->changed->wait(*_imp->mutex);
+
+        _imp->check();
+    }
+
+    unsigned long
+    HDF5CheckpointWriter::written() const
+    {
+        Lock l(*_imp->mutex);
+
+        return _imp->written;
+    }
+}
@@ -0,0 +1,282 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+/*
+ * Copyright (c) 2012 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the Utility C++ library. LibUtil is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * LibUtil is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#pragma once
+#ifndef LIBUTIL_GUARD_HDF5_CHECKPOINT_HH
+#define LIBUTIL_GUARD_HDF5_CHECKPOINT_HH 1
+
+#include <honei/util/hdf5.hh>
+#include <honei/util/instantiation_policy.hh>
+#include <honei/util/private_implementation_pattern.hh>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace honei
+{
+    /**
+     * HDF5Checkpoint holds a snapshot of named, one dimensional arrays that make up the state of a
+     * solver.
+     *
+     * Arrays are copied on add, so the solver may continue while the snapshot is written. The
+     * buffers of an entry are reused when the same name is added again, so a checkpoint object
+     * that is filled repeatedly does not allocate after its first use.
+     *
+     * \ingroup grphdf5
+     */
+    class HDF5Checkpoint :
+        public InstantiationPolicy<HDF5Checkpoint, NonCopyable>
+    {
+        private:
+            struct EntryBase
+            {
+                const std::string name;
+
+                EntryBase(const std::string & n) :
+                    name(n)
+                {
+                }
+
+                virtual ~EntryBase()
+                {
+                }
+
+                virtual void write(HDF5File & file) const = 0;
+            };
+
+            template <typename DT_> struct Entry :
+                public EntryBase
+            {
+                std::vector<DT_> values;
+
+                Entry(const std::string & n) :
+                    EntryBase(n)
+                {
+                }
+
+                virtual void write(HDF5File & file) const
+                {
+                    HDF5SimpleDataSpace data_space(1);
+                    data_space[values.size()];
+
+                    HDF5DataSet<DT_> data_set(HDF5DataSet<DT_>::create(file, name, data_space));
+                    if (! values.empty())
+                        data_set << &values[0];
+                }
+            };
+
+            /// Our entries, in the order of their first addition.
+            std::vector<EntryBase *> _entries;
+
+            template <typename DT_> std::vector<DT_> & _values(const std::string & name)
+            {
+                for (std::vector<EntryBase *>::iterator e(_entries.begin()), e_end(_entries.end()) ; e != e_end ; ++e)
+                {
+                    if ((*e)->name != name)
+                        continue;
+
+                    Entry<DT_> * entry(dynamic_cast<Entry<DT_> *>(*e));
+                    if (0 == entry)
+                    {
+                        delete *e;
+                        *e = entry = new Entry<DT_>(name);
+                    }
+
+                    return entry->values;
+                }
+
+                Entry<DT_> * entry(new Entry<DT_>(name));
+                _entries.push_back(entry);
+
+                return entry->values;
+            }
+
+        public:
+            /// \name Basic operations
+            /// \{
+
+            /// Constructor.
+            HDF5Checkpoint();
+
+            /// Destructor.
+            ~HDF5Checkpoint();
+
+            /// \}
+
+            /**
+             * Copy an array into the checkpoint.
+             *
+             * \param name The name of the array's data set.
+             * \param values The array's elements.
+             * \param size The array's number of elements.
+             */
+            template <typename DT_> void add(const std::string & name, const DT_ * values, unsigned long size)
+            {
+                std::vector<DT_> & target(_values<DT_>(name));
+                target.resize(size);
+                std::copy(values, values + size, target.begin());
+            }
+
+            /**
+             * Copy an array of flags into the checkpoint, stored as unsigned char.
+             *
+             * \param name The name of the array's data set.
+             * \param values The array's elements.
+             * \param size The array's number of elements.
+             */
+            void add(const std::string & name, const bool * values, unsigned long size);
+
+            /**
+             * Store a single scalar value in the checkpoint.
+             *
+             * \param name The name of the value's data set.
+             * \param value The value.
+             */
+            template <typename DT_> void add(const std::string & name, DT_ value)
+            {
+                add(name, &value, 1);
+            }
+
+            /// Return the number of arrays in the checkpoint.
+            unsigned long size() const;
+
+            /**
+             * Write all arrays to a new HDF5 file.
+             *
+             * The data is written to a temporary file first, which is then renamed to filename,
+             * so an interrupted write never leaves a partial checkpoint under filename.
+             *
+             * \param filename The name of the checkpoint file.
+             */
+            void write(const std::string & filename) const;
+
+            /// \name Restart
+            /// \{
+
+            /**
+             * Return whether a checkpoint file contains an array.
+             *
+             * \param file The checkpoint file.
+             * \param name The name of the array's data set.
+             */
+            static bool contains(HDF5File & file, const std::string & name);
+
+            /**
+             * Return the number of elements of an array in a checkpoint file.
+             *
+             * \param file The checkpoint file.
+             * \param name The name of the array's data set.
+             */
+            static unsigned long size(HDF5File & file, const std::string & name);
+
+            /**
+             * Read an array from a checkpoint file directly into its target memory.
+             *
+             * \param file The checkpoint file.
+             * \param name The name of the array's data set.
+             * \param values The target memory.
+             * \param size The number of elements the target memory holds.
+             */
+            template <typename DT_> static void read(HDF5File & file, const std::string & name, DT_ * values, unsigned long size)
+            {
+                HDF5DataSet<DT_> data_set(file, name);
+                if (data_set.size() != size)
+                    throw InternalError("HDF5Checkpoint: Data set '" + name + "' holds " + stringify(data_set.size()) +
+                            " elements, but " + stringify(size) + " were expected!");
+
+                if (size > 0)
+                    data_set >> values;
+            }
+
+            /**
+             * Read an array of flags from a checkpoint file.
+             *
+             * \param file The checkpoint file.
+             * \param name The name of the array's data set.
+             * \param values The target memory.
+             * \param size The number of elements the target memory holds.
+             */
+            static void read(HDF5File & file, const std::string & name, bool * values, unsigned long size);
+
+            /**
+             * Read a single scalar value from a checkpoint file.
+             *
+             * \param file The checkpoint file.
+             * \param name The name of the value's data set.
+             */
+            template <typename DT_> static DT_ read(HDF5File & file, const std::string & name)
+            {
+                DT_ result;
+                read(file, name, &result, 1);
+
+                return result;
+            }
+
+            /// \}
+    };
+
+    /**
+     * HDF5CheckpointWriter writes checkpoints to disk in a background thread.
+     *
+     * The writer owns two checkpoint buffers. The solver fills the buffer returned by acquire and
+     * hands it over with commit; while the background thread writes it to disk, the next
+     * checkpoint can be filled in the other buffer. acquire only blocks if both buffers are
+     * still in use, i.e. if checkpoints are requested faster than they can be written.
+     *
+     * Errors of the background thread are reported by the next call to acquire or wait. As
+     * libhdf5 is not necessarily thread safe, call wait before accessing HDF5 files elsewhere.
+     *
+     * \ingroup grphdf5
+     */
+    class HDF5CheckpointWriter :
+        public InstantiationPolicy<HDF5CheckpointWriter, NonCopyable>,
+        public PrivateImplementationPattern<HDF5CheckpointWriter, Single>
+    {
+        public:
+            /// \name Basic operations
+            /// \{
+
+            /// Constructor.
+            HDF5CheckpointWriter();
+
+            /// Destructor. Waits for all committed checkpoints to be written.
+            ~HDF5CheckpointWriter();
+
+            /// \}
+
+            /// Return a free checkpoint buffer, waiting for the background thread if necessary.
+            HDF5Checkpoint & acquire();
+
+            /**
+             * Hand the most recently acquired buffer over to the background thread.
+             *
+             * \param filename The name of the checkpoint file.
+             */
+            void commit(const std::string & filename);
+
+            /// Wait until all committed checkpoints have been written.
+            void wait();
+
+            /// Return the number of checkpoints written so far.
+            unsigned long written() const;
+    };
+}
+
+#endif
@@ -0,0 +1,167 @@
+/* vim: set sw=4 sts=4 et foldmethod=syntax : */
+
+#include <honei/util/hdf5_checkpoint.hh>
+#include <honei/util/unittest.hh>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <sys/stat.h>
+
+using namespace honei;
+using namespace tests;
+
+class HDF5CheckpointTest :
+    public QuickTest
+{
+    public:
+        HDF5CheckpointTest() :
+            QuickTest("hdf5_checkpoint_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            try
+            {
+                std::string filename("hdf5_checkpoint_TEST.h5");
+
+                std::remove(filename.c_str());
+
+                float f[10];
+                double d[7];
+                unsigned long l[5];
+                bool b[6];
+                for (unsigned long i(0) ; i < 10 ; ++i)
+                    f[i] = 0.5f * i;
+                for (unsigned long i(0) ; i < 7 ; ++i)
+                    d[i] = 1.0 / (i + 1);
+                for (unsigned long i(0) ; i < 5 ; ++i)
+                    l[i] = 1000000000000ul + i;
+                for (unsigned long i(0) ; i < 6 ; ++i)
+                    b[i] = (i % 3 == 0);
+
+                {
+                    CONTEXT("When writing checkpoint:");
+                    HDF5Checkpoint checkpoint;
+                    checkpoint.add("f", f, 10);
+                    checkpoint.add("d", d, 7);
+                    checkpoint.add("l", l, 5);
+                    checkpoint.add("b", b, 6);
+                    checkpoint.add("time", 42ul);
+                    // reuse of an entry must not add a second data set
+                    checkpoint.add("time", 43ul);
+                    TEST_CHECK_EQUAL(checkpoint.size(), 5ul);
+
+                    checkpoint.write(filename);
+                }
+
+                struct stat buffer;
+                TEST_CHECK_EQUAL(0, ::stat(filename.c_str(), &buffer));
+                TEST_CHECK(0 != ::stat((filename + ".tmp").c_str(), &buffer));
+
+                {
+                    CONTEXT("When reading checkpoint:");
+                    HDF5File file(filename);
+
+                    TEST_CHECK(HDF5Checkpoint::contains(file, "f"));
+                    TEST_CHECK(! HDF5Checkpoint::contains(file, "g"));
+                    TEST_CHECK_EQUAL(HDF5Checkpoint::size(file, "f"), 10ul);
+                    TEST_CHECK_EQUAL(HDF5Checkpoint::size(file, "b"), 6ul);
+
+                    float f_read[10];
+                    double d_read[7];
+                    unsigned long l_read[5];
+                    bool b_read[6];
+                    HDF5Checkpoint::read(file, "f", f_read, 10);
+                    HDF5Checkpoint::read(file, "d", d_read, 7);
+                    HDF5Checkpoint::read(file, "l", l_read, 5);
+                    HDF5Checkpoint::read(file, "b", b_read, 6);
+
+                    for (unsigned long i(0) ; i < 10 ; ++i)
+                        TEST_CHECK_EQUAL(f_read[i], f[i]);
+                    for (unsigned long i(0) ; i < 7 ; ++i)
+                        TEST_CHECK_EQUAL(d_read[i], d[i]);
+                    for (unsigned long i(0) ; i < 5 ; ++i)
+                        TEST_CHECK_EQUAL(l_read[i], l[i]);
+                    for (unsigned long i(0) ; i < 6 ; ++i)
+                        TEST_CHECK_EQUAL(b_read[i], b[i]);
+                    TEST_CHECK_EQUAL(HDF5Checkpoint::read<unsigned long>(file, "time"), 43ul);
+
+                    TEST_CHECK_THROWS(HDF5Checkpoint::read(file, "f", f_read, 9), InternalError);
+                }
+
+                std::remove(filename.c_str());
+            }
+            catch (Exception & e)
+            {
+                std::cout << e.backtrace("\n ...") << std::endl;
+                std::cout << e.what() << std::endl;
+                TEST_CHECK(false);
+            }
+        }
+} hdf5_checkpoint_test;
+
+class HDF5CheckpointWriterTest :
+    public QuickTest
+{
+    public:
+        HDF5CheckpointWriterTest() :
+            QuickTest("hdf5_checkpoint_writer_test")
+        {
+        }
+
+        virtual void run() const
+        {
+            try
+            {
+                const unsigned long size(100000);
+                const unsigned long count(6);
+                std::vector<double> state(size);
+
+                {
+                    HDF5CheckpointWriter writer;
+                    for (unsigned long step(0) ; step < count ; ++step)
+                    {
+                        for (unsigned long i(0) ; i < size ; ++i)
+                            state[i] = double(step * size + i);
+
+                        HDF5Checkpoint & checkpoint(writer.acquire());
+                        checkpoint.add("state", &state[0], size);
+                        checkpoint.add("step", step);
+                        writer.commit("hdf5_checkpoint_writer_TEST_" + stringify(step % 2) + ".h5");
+
+                        // the solver modifies its state while the checkpoint is written
+                        std::fill(state.begin(), state.end(), -1.0);
+                    }
+
+                    writer.wait();
+                    TEST_CHECK_EQUAL(writer.written(), count);
+                }
+
+                for (unsigned long f(0) ; f < 2 ; ++f)
+                {
+                    std::string filename("hdf5_checkpoint_writer_TEST_" + stringify(f) + ".h5");
+                    unsigned long step(count - 2 + f);
+                    {
+                        HDF5File file(filename);
+                        TEST_CHECK_EQUAL(HDF5Checkpoint::read<unsigned long>(file, "step"), step);
+
+                        std::vector<double> result(size);
+                        HDF5Checkpoint::read(file, "state", &result[0], size);
+                        for (unsigned long i(0) ; i < size ; ++i)
+                            TEST_CHECK_EQUAL(result[i], double(step * size + i));
+                    }
+                    std::remove(filename.c_str());
+                }
+            }
+            catch (Exception & e)
+            {
+                std::cout << e.backtrace("\n ...") << std::endl;
+                std::cout << e.what() << std::endl;
+                TEST_CHECK(false);
+            }
+        }
+} hdf5_checkpoint_writer_test;
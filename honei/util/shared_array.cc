@@ -30,6 +30,8 @@ namespace honei
 
     template class SharedArray<double>;
 
+    template class SharedArray<short>;
+
     template class SharedArray<int>;
 
     template class SharedArray<unsigned int>;
@@ -90,6 +90,8 @@ namespace honei
 
     extern template class SharedArray<double>;
 
+    extern template class SharedArray<short>;
+
     extern template class SharedArray<int>;
 
     extern template class SharedArray<unsigned int>;
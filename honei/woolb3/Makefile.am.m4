@@ -89,6 +89,13 @@ BACKEND_LIBS += \
 
 endif
 
+if MPI
+
+BACKEND_LIBS += \
+	$(top_builddir)/honei/backends/mpi/libhoneibackendsmpi.la
+
+endif
+
 SUBDIRS = malpasset
 
 AM_CXXFLAGS = -I$(top_srcdir)
@@ -105,6 +112,7 @@ DEFS = \
 	$(CUDA_DOUBLEDEF) \
 	$(DEBUGDEF) \
 	$(BOOSTDEF) \
+	$(MPIDEF) \
 	$(PROFILERDEF) \
 	-DHONEI_SOURCEDIR='"$(top_srcdir)"'
 
@@ -17,4 +17,5 @@ add(`force',                      `hh', `test')
 add(`malpasset',                  `test')
 add(`packed_grid3',               `hh', `test')
 add(`solver_lbm3',                `hh', `test')
+add(`solver_lbm3_mpi',            `hh')
 add(`update_velocity_directions', `hh', `test')
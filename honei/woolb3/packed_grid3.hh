@@ -28,6 +28,7 @@
 #include <honei/util/shared_array-impl.hh>
 
 #include <vector>
+#include <list>
 #include <iostream>
 
 
@@ -77,8 +78,11 @@ namespace honei
 
             std::list<SyncData<DT_> > export_synch_data()
             {
-                unsigned long process(grid.send_targets().front().process);
                 std::list<SyncData<DT_> > sync_list;
+                if (grid.send_targets().empty())
+                    return sync_list;
+
+                unsigned long process(grid.send_targets().front().process);
                 SyncData<DT_> sync_data;
                 sync_data.process = process;
                 sync_list.push_back(sync_data);
@@ -33,8 +33,14 @@
 #include <honei/woolb3/extraction.hh>
 #include <honei/woolb3/force.hh>
 #include <honei/woolb3/update_velocity_directions.hh>
+#include <honei/util/exception.hh>
 #include <honei/util/profiler.hh>
+#include <honei/util/configuration.hh>
+#include <honei/backends/multicore/dispatch_policy.hh>
+#include <honei/backends/multicore/thread_pool.hh>
 #include <cmath>
+#include <vector>
+#include <list>
 
 namespace honei
 {
@@ -152,5 +158,171 @@ namespace honei
                     PROFILER_STOP("SolverLBM3 outer");
                 }
     };
+
+    /**
+     * Multicore SolverLBM3.
+     *
+     * The domain is decomposed into mc::SolverLBM3::patch_count Grid3/PackedGrid3 patches, each
+     * one driven by its own serial SolverLBM3 on a fixed core. The halo data of all patches is
+     * exported and routed while the inner cells are processed, and imported afterwards.
+     */
+    template <typename DT_, unsigned long directions, typename SourceScheme_>
+    struct SolverLBM3<tags::CPU::MultiCore, DT_, directions, SourceScheme_>
+    {
+        private:
+                typedef SolverLBM3<tags::CPU::MultiCore::DelegateTo, DT_, directions, SourceScheme_> PatchSolver;
+
+                unsigned long _parts;
+
+                std::vector<Grid3<DT_, directions> > _grid_list;
+                std::vector<PackedGrid3<DT_, directions> > _pgrid_list;
+                std::vector<PatchSolver *> _solver_list;
+                std::vector<std::list<SyncData<DT_> > > _receiver_data;
+                std::vector<Ticket<tags::CPU::MultiCore> > _tickets;
+
+                /// Collect the halo data of every patch and sort it by receiving patch.
+                void _export()
+                {
+                    for (unsigned long i(0) ; i < _parts ; ++i)
+                        _receiver_data.at(i).clear();
+
+                    for (unsigned long i(0) ; i < _parts ; ++i)
+                    {
+                        std::list<SyncData<DT_> > p_data(_pgrid_list.at(i).export_synch_data());
+                        for (typename std::list<SyncData<DT_> >::iterator j(p_data.begin()) ; j != p_data.end() ; ++j)
+                        {
+                            _receiver_data.at(j->process).push_back(*j);
+                        }
+                    }
+                }
+
+                static void _import(PackedGrid3<DT_, directions> * pgrid, std::list<SyncData<DT_> > * data)
+                {
+                    pgrid->import_synch_data(*data);
+                }
+
+                void _import_all()
+                {
+                    TicketVector tickets;
+                    for (unsigned long i(0) ; i < _parts ; ++i)
+                    {
+                        tickets.push_back(mc::ThreadPool::instance()->enqueue(
+                                    bind(_import, &_pgrid_list.at(i), &_receiver_data.at(i)),
+                                    mc::DispatchPolicy::same_core_as(_tickets.at(i))));
+                    }
+                    tickets.wait();
+                }
+
+                void _run(void (PatchSolver::*step)())
+                {
+                    TicketVector tickets;
+                    for (unsigned long i(0) ; i < _parts ; ++i)
+                    {
+                        tickets.push_back(mc::ThreadPool::instance()->enqueue(
+                                    bind(mem_fn(step), _solver_list.at(i)),
+                                    mc::DispatchPolicy::same_core_as(_tickets.at(i))));
+                    }
+                    tickets.wait();
+                }
+
+        public:
+                SolverLBM3(DenseMatrix<bool> & geometry, DenseMatrix<DT_> & h, DenseMatrix<DT_> & b, DenseMatrix<DT_> & u, DenseMatrix<DT_> & v,
+                        DT_ dx, DT_ dy, DT_ dt, DT_ rel_time) :
+                    _parts(Configuration::instance()->get_value("mc::SolverLBM3::patch_count", 4ul)),
+                    _receiver_data(_parts)
+                {
+                    CONTEXT("When creating multicore SolverLBM3:");
+
+                    for (unsigned long i(0) ; i < _parts ; ++i)
+                    {
+                        Grid3<DT_, directions> grid(geometry, h, b, u, v, i, _parts);
+                        _grid_list.push_back(grid);
+                    }
+
+                    for (unsigned long i(0) ; i < _parts ; ++i)
+                    {
+                        PackedGrid3<DT_, directions> pgrid(_grid_list.at(i));
+                        _pgrid_list.push_back(pgrid);
+                    }
+
+                    for (unsigned long i(0) ; i < _parts ; ++i)
+                    {
+                        _solver_list.push_back(new PatchSolver(_grid_list.at(i), _pgrid_list.at(i), dx, dy, dt, rel_time));
+                    }
+                }
+
+                ~SolverLBM3()
+                {
+                    for (unsigned long i(0) ; i < _parts ; ++i)
+                        delete _solver_list.at(i);
+                }
+
+                unsigned long parts()
+                {
+                    return _parts;
+                }
+
+                Grid3<DT_, directions> & grid(unsigned long part)
+                {
+                    return _grid_list.at(part);
+                }
+
+                PackedGrid3<DT_, directions> & pgrid(unsigned long part)
+                {
+                    return _pgrid_list.at(part);
+                }
+
+                /// Gather the water height of all patches into h.
+                void fill_h(DenseMatrix<DT_> & h)
+                {
+                    for (unsigned long i(0) ; i < _parts ; ++i)
+                        _grid_list.at(i).fill_h(h, *_pgrid_list.at(i).h);
+                }
+
+                void do_preprocessing()
+                {
+                    CONTEXT("When performing multicore SolverLBM3 preprocessing:");
+
+                    TicketVector tickets;
+                    _tickets.clear();
+                    for (unsigned long i(0) ; i < _parts ; ++i)
+                    {
+                        _tickets.push_back(mc::ThreadPool::instance()->enqueue(
+                                    bind(mem_fn(&PatchSolver::do_preprocessing), _solver_list.at(i)),
+                                    mc::DispatchPolicy::on_core(i)));
+                        tickets.push_back(_tickets.at(i));
+                    }
+                    tickets.wait();
+
+                    _export();
+                    _import_all();
+                }
+
+                /// Perform one timestep. do_preprocessing() has to be called first, as it binds every patch to its core.
+                void solve()
+                {
+                    if (_tickets.size() != _parts)
+                        throw InternalError("SolverLBM3: do_preprocessing() has to be called before solve()!");
+
+                    PROFILER_START("SolverLBM3 mc");
+
+                    _run(&PatchSolver::solve_outer);
+
+                    // the inner sweeps neither read nor write any halo data, so the exchange can run meanwhile
+                    TicketVector tickets;
+                    for (unsigned long i(0) ; i < _parts ; ++i)
+                    {
+                        tickets.push_back(mc::ThreadPool::instance()->enqueue(
+                                    bind(mem_fn(&PatchSolver::solve_inner), _solver_list.at(i)),
+                                    mc::DispatchPolicy::same_core_as(_tickets.at(i))));
+                    }
+                    _export();
+                    tickets.wait();
+
+                    _import_all();
+
+                    PROFILER_STOP("SolverLBM3 mc");
+                }
+    };
 }
 #endif
@@ -283,3 +283,57 @@ class MultiSolverLBM3Test :
 };
 MultiSolverLBM3Test<tags::CPU, float> multi_solver_test_float("float");
 MultiSolverLBM3Test<tags::CPU, double> multi_solver_test_double("double");
+
+template <typename Tag_, typename DataType_>
+class MCSolverLBM3Test :
+    public TaggedTest<Tag_>
+{
+    public:
+        MCSolverLBM3Test(const std::string & type) :
+            TaggedTest<Tag_>("mc_solver_lbm3_test<" + type + ">")
+        {
+        }
+
+        virtual void run() const
+        {
+            unsigned long g_h(128);
+            unsigned long g_w(128);
+            unsigned long timesteps(250);
+
+            Grid<D2Q9, DataType_> grid;
+            ScenarioCollection::get_scenario(4, g_h, g_w, grid);
+            DenseMatrix<DataType_> h_p(grid.h->rows(), grid.h->columns(), 0);
+            DenseMatrix<DataType_> h_s(grid.h->rows(), grid.h->columns(), 0);
+
+            // serial solver
+            Grid3<DataType_, 9> grid_s(*grid.obstacles, *grid.h, *grid.b, *grid.u, *grid.v);
+            PackedGrid3<DataType_, 9> pgrid_s(grid_s);
+            SolverLBM3<typename Tag_::DelegateTo, DataType_, 9, lbm::lbm_source_schemes::BED_FULL> solver_s(grid_s, pgrid_s, grid.d_x, grid.d_y, grid.d_t, grid.tau);
+            solver_s.do_preprocessing();
+
+            for (unsigned long i(0) ; i < timesteps ; ++i)
+            {
+                solver_s.solve();
+            }
+
+            // multicore solver
+            SolverLBM3<Tag_, DataType_, 9, lbm::lbm_source_schemes::BED_FULL> solver_p(*grid.obstacles, *grid.h, *grid.b, *grid.u, *grid.v, grid.d_x, grid.d_y, grid.d_t, grid.tau);
+            TEST_CHECK_THROWS(solver_p.solve(), InternalError);
+            solver_p.do_preprocessing();
+
+            for (unsigned long i(0) ; i < timesteps ; ++i)
+            {
+                solver_p.solve();
+            }
+
+            grid_s.fill_h(h_s, *pgrid_s.h);
+            solver_p.fill_h(h_p);
+
+            TEST_CHECK_EQUAL(h_p, h_s);
+
+            grid.destroy();
+        }
+
+};
+MCSolverLBM3Test<tags::CPU::MultiCore, float> mc_solver_test_float("float");
+MCSolverLBM3Test<tags::CPU::MultiCore, double> mc_solver_test_double("double");
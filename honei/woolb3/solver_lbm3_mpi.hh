@@ -0,0 +1,233 @@
+/* vim: set number sw=4 sts=4 et nofoldenable : */
+
+/*
+ * Copyright (c) 2011 Dirk Ribbrock <dirk.ribbrock@uni-dortmund.de>
+ *
+ * This file is part of the HONEI C++ library. HONEI is free software;
+ * you can redistribute it and/or modify it under the terms of the GNU General
+ * Public License version 2, as published by the Free Software Foundation.
+ *
+ * HONEI is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE.  See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program; if not, write to the Free Software Foundation, Inc., 59 Temple
+ * Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#pragma once
+#ifndef WOOLB3_GUARD_SOLVER_LBM3_MPI_HH
+#define WOOLB3_GUARD_SOLVER_LBM3_MPI_HH 1
+
+#ifdef HONEI_MPI
+
+#include <honei/woolb3/solver_lbm3.hh>
+#include <honei/backends/mpi/operations.hh>
+#include <honei/util/profiler.hh>
+
+#include <vector>
+#include <map>
+
+namespace honei
+{
+    /**
+     * MPI distributed SolverLBM3.
+     *
+     * Every rank owns the Grid3 patch with its own process id and runs the serial SolverLBM3 on it.
+     * The layout of the halo data is exchanged once at construction time, afterwards only the
+     * plain values are sent per time step. The non-blocking halo exchange is started after the
+     * outer sweep and completed after the inner sweep.
+     */
+    template <typename Tag_, typename DT_, unsigned long directions, typename SourceScheme_>
+    class SolverLBM3MPI
+    {
+        private:
+                int _rank;
+                int _size;
+
+                Grid3<DT_, directions> _grid;
+                PackedGrid3<DT_, directions> _pgrid;
+                SolverLBM3<Tag_, DT_, directions, SourceScheme_> _solver;
+
+                /// Neighbour ranks we send to resp. receive from.
+                std::vector<int> _send_ranks;
+                std::vector<int> _recv_ranks;
+                /// First and last+1 entry of grid.send_targets() for every send rank.
+                std::vector<unsigned long> _send_offsets;
+                /// Local halo index and target vector of every received value, per receive rank.
+                std::vector<std::vector<unsigned long> > _recv_idx;
+                std::vector<std::vector<long> > _recv_target;
+
+                std::vector<std::vector<DT_> > _send_buffers;
+                std::vector<std::vector<DT_> > _recv_buffers;
+                std::vector<MPI_Request> _send_requests;
+                std::vector<MPI_Request> _recv_requests;
+
+                void _setup()
+                {
+                    std::vector<SyncInfo<DT_, directions> > & targets(_grid.send_targets());
+
+                    // send_targets is sorted by target process
+                    std::vector<unsigned long> send_counts(_size, 0);
+                    for (unsigned long i(0) ; i < targets.size() ; ++i)
+                    {
+                        if (i == 0 || targets.at(i).process != targets.at(i - 1).process)
+                        {
+                            _send_ranks.push_back(targets.at(i).process);
+                            _send_offsets.push_back(i);
+                        }
+                        ++send_counts.at(targets.at(i).process);
+                    }
+                    _send_offsets.push_back(targets.size());
+
+                    std::vector<unsigned long> recv_counts(_size, 0);
+                    MPI_Alltoall(&send_counts[0], 1, MPI_UNSIGNED_LONG, &recv_counts[0], 1, MPI_UNSIGNED_LONG, MPI_COMM_WORLD);
+
+                    for (int p(0) ; p < _size ; ++p)
+                        if (recv_counts.at(p) != 0)
+                            _recv_ranks.push_back(p);
+
+                    // exchange the global index and target vector of every halo value once
+                    std::vector<std::vector<unsigned long> > send_layout(_send_ranks.size());
+                    std::vector<std::vector<unsigned long> > recv_layout(_recv_ranks.size());
+                    std::vector<MPI_Request> requests;
+
+                    for (unsigned long r(0) ; r < _recv_ranks.size() ; ++r)
+                    {
+                        recv_layout.at(r).resize(2 * recv_counts.at(_recv_ranks.at(r)));
+                        requests.push_back(mpi::mpi_irecv(&(recv_layout.at(r)[0]), recv_layout.at(r).size(), _recv_ranks.at(r), _recv_ranks.at(r)));
+                    }
+
+                    for (unsigned long s(0) ; s < _send_ranks.size() ; ++s)
+                    {
+                        for (unsigned long i(_send_offsets.at(s)) ; i < _send_offsets.at(s + 1) ; ++i)
+                        {
+                            send_layout.at(s).push_back(targets.at(i).idx);
+                            send_layout.at(s).push_back((unsigned long)targets.at(i).target_vector);
+                        }
+                        requests.push_back(mpi::mpi_isend(&(send_layout.at(s)[0]), send_layout.at(s).size(), _send_ranks.at(s), _rank));
+                    }
+
+                    MPI_Waitall(requests.size(), &requests[0], MPI_STATUSES_IGNORE);
+
+                    std::map<unsigned long, unsigned long> & halo_map(_grid.halo_map());
+                    _recv_idx.resize(_recv_ranks.size());
+                    _recv_target.resize(_recv_ranks.size());
+                    for (unsigned long r(0) ; r < _recv_ranks.size() ; ++r)
+                    {
+                        for (unsigned long i(0) ; i < recv_layout.at(r).size() ; i += 2)
+                        {
+                            long target_vector((long)recv_layout.at(r)[i + 1]);
+                            if (target_vector != -1 && (target_vector <= 0 || target_vector >= (long)directions))
+                                throw InternalError("Wrong target_vector in SyncInfo found!");
+                            _recv_idx.at(r).push_back(halo_map[recv_layout.at(r)[i]]);
+                            _recv_target.at(r).push_back(target_vector);
+                        }
+                    }
+
+                    _send_buffers.resize(_send_ranks.size());
+                    for (unsigned long s(0) ; s < _send_ranks.size() ; ++s)
+                        _send_buffers.at(s).resize(_send_offsets.at(s + 1) - _send_offsets.at(s));
+                    _recv_buffers.resize(_recv_ranks.size());
+                    for (unsigned long r(0) ; r < _recv_ranks.size() ; ++r)
+                        _recv_buffers.at(r).resize(_recv_idx.at(r).size());
+                }
+
+                /// Post all receives and sends of the current halo data.
+                void _start_exchange()
+                {
+                    _recv_requests.clear();
+                    _send_requests.clear();
+
+                    for (unsigned long r(0) ; r < _recv_ranks.size() ; ++r)
+                    {
+                        if (_recv_buffers.at(r).size() == 0)
+                            continue;
+                        _recv_requests.push_back(mpi::mpi_irecv(&(_recv_buffers.at(r)[0]), _recv_buffers.at(r).size(), _recv_ranks.at(r), _recv_ranks.at(r)));
+                    }
+
+                    std::vector<SyncInfo<DT_, directions> > & targets(_grid.send_targets());
+                    for (unsigned long s(0) ; s < _send_ranks.size() ; ++s)
+                    {
+                        DT_ * buffer(&(_send_buffers.at(s)[0]));
+                        for (unsigned long i(_send_offsets.at(s)), j(0) ; i < _send_offsets.at(s + 1) ; ++i, ++j)
+                        {
+                            if (targets.at(i).target_vector == -1)
+                                buffer[j] = (*_pgrid.h2)[targets.at(i).cell->get_id()];
+                            else
+                                buffer[j] = (*_pgrid.f_temp2[targets.at(i).target_vector])[targets.at(i).cell->get_id()];
+                        }
+                        _send_requests.push_back(mpi::mpi_isend(buffer, _send_buffers.at(s).size(), _send_ranks.at(s), _rank));
+                    }
+                }
+
+                /// Wait for the halo data and copy it into the packed grid.
+                void _finish_exchange()
+                {
+                    if (_recv_requests.size() > 0)
+                        MPI_Waitall(_recv_requests.size(), &_recv_requests[0], MPI_STATUSES_IGNORE);
+
+                    for (unsigned long r(0) ; r < _recv_ranks.size() ; ++r)
+                    {
+                        for (unsigned long i(0) ; i < _recv_buffers.at(r).size() ; ++i)
+                        {
+                            if (_recv_target.at(r)[i] == -1)
+                                (*_pgrid.h)[_recv_idx.at(r)[i]] = _recv_buffers.at(r)[i];
+                            else
+                                (*_pgrid.f_temp[_recv_target.at(r)[i]])[_recv_idx.at(r)[i]] = _recv_buffers.at(r)[i];
+                        }
+                    }
+
+                    if (_send_requests.size() > 0)
+                        MPI_Waitall(_send_requests.size(), &_send_requests[0], MPI_STATUSES_IGNORE);
+                }
+
+        public:
+                SolverLBM3MPI(DenseMatrix<bool> & geometry, DenseMatrix<DT_> & h, DenseMatrix<DT_> & b, DenseMatrix<DT_> & u, DenseMatrix<DT_> & v,
+                        DT_ dx, DT_ dy, DT_ dt, DT_ rel_time) :
+                    _rank(mpi::mpi_comm_rank()),
+                    _size(mpi::mpi_comm_size()),
+                    _grid(geometry, h, b, u, v, _rank, _size),
+                    _pgrid(_grid),
+                    _solver(_grid, _pgrid, dx, dy, dt, rel_time)
+                {
+                    CONTEXT("When creating MPI SolverLBM3:");
+                    _setup();
+                }
+
+                Grid3<DT_, directions> & grid()
+                {
+                    return _grid;
+                }
+
+                PackedGrid3<DT_, directions> & pgrid()
+                {
+                    return _pgrid;
+                }
+
+                void do_preprocessing()
+                {
+                    _solver.do_preprocessing();
+                    _start_exchange();
+                    _finish_exchange();
+                }
+
+                void solve()
+                {
+                    PROFILER_START("SolverLBM3 mpi");
+
+                    _solver.solve_outer();
+                    _start_exchange();
+                    _solver.solve_inner();
+                    _finish_exchange();
+
+                    PROFILER_STOP("SolverLBM3 mpi");
+                }
+    };
+}
+
+#endif
+#endif